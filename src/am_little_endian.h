@@ -0,0 +1,109 @@
+#ifndef __AM_LITTLE_ENDIAN_H__
+#define __AM_LITTLE_ENDIAN_H__
+
+#include <cerrno>
+#include <unistd.h>
+
+#include "am_string.h"
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Helpers of the binary files (indexed capture, sensor state checkpoint, binary output format):
+// integers are stored little endian with a fixed number of bytes, or with a variable number of
+// bytes in the binary output format, whatever the host byte order.
+//
+// -------------------------------------------------------------------------------------------------//
+
+// Append the 'nbBytes' low bytes of 'value' to 'buffer', least significant byte first.
+inline void amAppendLittleEndian
+(
+    amString           &buffer,
+    unsigned long long  value,
+    size_t              nbBytes
+)
+{
+    for ( size_t counter = 0; counter < nbBytes; ++counter )
+    {
+        buffer.push_back( ( char ) ( value & 0xFF ) );
+        value >>= 8;
+    }
+}
+
+// Read an unsigned integer of 'nbBytes' bytes, least significant byte first.
+inline unsigned long long amReadLittleEndian
+(
+    const char *data,
+    size_t      nbBytes
+)
+{
+    unsigned long long result = 0;
+    for ( size_t counter = nbBytes; counter > 0; --counter )
+    {
+        result = ( result << 8 ) | ( unsigned char ) data[ counter - 1 ];
+    }
+    return result;
+}
+
+// Append 'value' with as few bytes as needed: 7 bits per byte, least significant bits first, bit 7
+// set in all bytes but the last one (values below 128 take one byte).
+inline void amAppendVarint
+(
+    amString           &buffer,
+    unsigned long long  value
+)
+{
+    while ( value >= 0x80 )
+    {
+        buffer.push_back( ( char ) ( ( value & 0x7F ) | 0x80 ) );
+        value >>= 7;
+    }
+    buffer.push_back( ( char ) value );
+}
+
+// Signed values are mapped to unsigned ones before amAppendVarint(): 0, -1, 1, -2, ... become
+// 0, 1, 2, 3, ... so that small negative values stay short as well.
+inline unsigned long long amZigZagEncode
+(
+    long long value
+)
+{
+    return ( ( unsigned long long ) value << 1 ) ^ ( unsigned long long ) ( value >> 63 );
+}
+
+inline long long amZigZagDecode
+(
+    unsigned long long value
+)
+{
+    return ( long long ) ( value >> 1 ) ^ -( long long ) ( value & 1 );
+}
+
+// Write 'length' bytes completely (write() may write less than requested and is restarted when
+// interrupted by a signal). Returns false on error, errno tells why.
+inline bool amWriteAll
+(
+    int         fileDescriptor,
+    const char *data,
+    size_t      length
+)
+{
+    ssize_t nbWritten = 0;
+
+    while ( length > 0 )
+    {
+        nbWritten = ::write( fileDescriptor, data, length );
+        if ( nbWritten < 0 )
+        {
+            if ( errno == EINTR )
+            {
+                continue;
+            }
+            return false;
+        }
+        data   += nbWritten;
+        length -= nbWritten;
+    }
+    return true;
+}
+
+#endif // __AM_LITTLE_ENDIAN_H__
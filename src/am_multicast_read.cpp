@@ -1,7 +1,13 @@
+#include <errno.h>
+#include <string.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <netdb.h>
+#include <poll.h>
+#include <time.h>
 #include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/time.h>
 
 #include <iostream>
 
@@ -17,8 +23,26 @@ amMulticastRead::amMulticastRead
     void
 )
 {
-    connectionUp = false;
-    socketID      = -1;
+    connectionUp      = false;
+    socketID          = -1;
+    receiveBufferSize = 0;
+    droppedCount      = 0;
+    kernelTimeStamps  = false;
+}
+
+// ------------------------------------------------------------------------------------------------------
+//
+// Current time in microseconds since 1970, for datagrams without a kernel receive time.
+//
+// ------------------------------------------------------------------------------------------------------
+static long long getCurrentTime
+(
+    void
+)
+{
+    struct timeval tv;
+    gettimeofday( &tv, NULL );
+    return ( long long ) tv.tv_sec * 1000000 + tv.tv_usec;
 }
 
 
@@ -52,6 +76,160 @@ size_t amMulticastRead::read
     return nbBytes;
 }
 
+// ------------------------------------------------------------------------------------------------------
+//
+// Wait at most 'timeOutMS' milliseconds (-1: no limit) for a datagram to arrive.
+//
+// Return 1 if data can be read, 0 on time out, -1 on error (errno is set).
+//
+// ------------------------------------------------------------------------------------------------------
+int amMulticastRead::waitForData
+(
+    int timeOutMS
+)
+{
+    int result = -1;
+    if ( connectionUp && ( socketID > 0 ) )
+    {
+        struct pollfd socketPoll;
+        socketPoll.fd      = socketID;
+        socketPoll.events  = POLLIN;
+        socketPoll.revents = 0;
+        result = poll( &socketPoll, 1, timeOutMS );
+        if ( result > 0 )
+        {
+            result = 1;
+        }
+    }
+    return result;
+}
+
+// ------------------------------------------------------------------------------------------------------
+//
+// Read up to 'maxCount' datagrams with a single system call.
+// Datagram i is written to buffer + i * bufferSize, its length to lengths[ i ] and, if 'receiveTimes'
+// is not NULL, the time it arrived (microseconds since 1970) to receiveTimes[ i ]: the kernel time
+// stamp if the socket provides it (SO_TIMESTAMPNS), else the time the call returned.
+// If 'senderAddresses' is not NULL, the IPv4 address of the sender (host byte order, 0 if unknown)
+// is written to senderAddresses[ i ].
+// The call blocks until at least one datagram is available and then returns whatever else is queued.
+//
+// Return the number of datagrams read, -1 on error (errno is set).
+//
+// ------------------------------------------------------------------------------------------------------
+int amMulticastRead::readBatch
+(
+    BYTE         *buffer,
+    size_t        bufferSize,
+    size_t       *lengths,
+    long long    *receiveTimes,
+    int           maxCount,
+    unsigned int *senderAddresses
+)
+{
+    int       nbMessages = 0;
+    long long returnTime = 0;
+    if ( connectionUp && ( socketID > 0 ) && ( bufferSize > 0 ) && ( buffer != NULL ) && ( lengths != NULL ) && ( maxCount > 0 ) )
+    {
+#ifdef __linux__
+        struct mmsghdr     messages[ C_MC_BATCH_SIZE ];
+        struct iovec       ioVectors[ C_MC_BATCH_SIZE ];
+        struct sockaddr_in senders[ C_MC_BATCH_SIZE ];
+        char               controlBuffers[ C_MC_BATCH_SIZE ][ CMSG_SPACE( sizeof( unsigned int ) ) + CMSG_SPACE( sizeof( struct timespec ) ) ];
+
+        if ( maxCount > C_MC_BATCH_SIZE )
+        {
+            maxCount = C_MC_BATCH_SIZE;
+        }
+
+        bzero( ( void * ) messages, maxCount * sizeof( struct mmsghdr ) );
+        for ( int counter = 0; counter < maxCount; ++counter )
+        {
+            ioVectors[ counter ].iov_base                 = ( void * ) ( buffer + counter * bufferSize );
+            ioVectors[ counter ].iov_len                  = bufferSize;
+            messages[ counter ].msg_hdr.msg_iov           = &( ioVectors[ counter ] );
+            messages[ counter ].msg_hdr.msg_iovlen        = 1;
+            messages[ counter ].msg_hdr.msg_control       = controlBuffers[ counter ];
+            messages[ counter ].msg_hdr.msg_controllen    = sizeof( controlBuffers[ counter ] );
+            if ( senderAddresses != NULL )
+            {
+                messages[ counter ].msg_hdr.msg_name    = &( senders[ counter ] );
+                messages[ counter ].msg_hdr.msg_namelen = sizeof( senders[ counter ] );
+            }
+        }
+
+        nbMessages = recvmmsg( socketID, messages, maxCount, MSG_WAITFORONE, NULL );
+        for ( int counter = 0; counter < nbMessages; ++counter )
+        {
+            lengths[ counter ] = messages[ counter ].msg_len;
+            if ( senderAddresses != NULL )
+            {
+                senderAddresses[ counter ] = 0;
+                if ( ( messages[ counter ].msg_hdr.msg_namelen >= sizeof( struct sockaddr_in ) ) && ( senders[ counter ].sin_family == AF_INET ) )
+                {
+                    senderAddresses[ counter ] = ntohl( senders[ counter ].sin_addr.s_addr );
+                }
+            }
+            if ( receiveTimes != NULL )
+            {
+                receiveTimes[ counter ] = 0;
+            }
+            for ( struct cmsghdr *cmsg = CMSG_FIRSTHDR( &( messages[ counter ].msg_hdr ) ); cmsg != NULL; cmsg = CMSG_NXTHDR( &( messages[ counter ].msg_hdr ), cmsg ) )
+            {
+                if ( ( cmsg->cmsg_level == SOL_SOCKET ) && ( cmsg->cmsg_type == SO_RXQ_OVFL ) )
+                {
+                    unsigned int kernelDropCount = 0;
+                    memcpy( &kernelDropCount, CMSG_DATA( cmsg ), sizeof( kernelDropCount ) );
+                    if ( kernelDropCount > droppedCount )
+                    {
+                        droppedCount = kernelDropCount;
+                    }
+                }
+#ifdef SCM_TIMESTAMPNS
+                else if ( ( cmsg->cmsg_level == SOL_SOCKET ) && ( cmsg->cmsg_type == SCM_TIMESTAMPNS ) && ( receiveTimes != NULL ) )
+                {
+                    struct timespec kernelTime;
+                    memcpy( &kernelTime, CMSG_DATA( cmsg ), sizeof( kernelTime ) );
+                    receiveTimes[ counter ] = ( long long ) kernelTime.tv_sec * 1000000 + kernelTime.tv_nsec / 1000;
+                }
+#endif
+            }
+            if ( ( receiveTimes != NULL ) && ( receiveTimes[ counter ] == 0 ) )
+            {
+                if ( returnTime == 0 )
+                {
+                    returnTime = getCurrentTime();
+                }
+                receiveTimes[ counter ] = returnTime;
+            }
+        }
+#else
+        // No recvmmsg: fall back to one datagram per call.
+        struct sockaddr_in sender;
+        socklen_t          senderLength = sizeof( sender );
+        ssize_t            nbBytes      = recvfrom( socketID, ( void * ) buffer, bufferSize, 0, ( struct sockaddr * ) &sender, &senderLength );
+        if ( nbBytes < 0 )
+        {
+            nbMessages = -1;
+        }
+        else
+        {
+            lengths[ 0 ] = nbBytes;
+            nbMessages   = 1;
+            if ( senderAddresses != NULL )
+            {
+                senderAddresses[ 0 ] = ( ( senderLength >= sizeof( sender ) ) && ( sender.sin_family == AF_INET ) ) ? ntohl( sender.sin_addr.s_addr ) : 0;
+            }
+            if ( receiveTimes != NULL )
+            {
+                receiveTimes[ 0 ] = getCurrentTime();
+            }
+        }
+#endif
+    }
+    return nbMessages;
+}
+
 bool amMulticastRead::determineIPAddress
 (
     amString       &ipAddress,
@@ -229,6 +407,41 @@ int amMulticastRead::connect
         }
     }
 
+    if ( ( errorCode == 0 ) && ( receiveBufferSize > 0 ) )
+    {
+        // Enlarge the kernel receive queue so that bursts from several bridges are not dropped.
+        int resSetSockopt = setsockopt( socketID, SOL_SOCKET, SO_RCVBUF, ( char * ) &receiveBufferSize, sizeof( receiveBufferSize ) );
+        if ( resSetSockopt < 0 )
+        {
+            errorCode     = E_SOCKET_SET_OPT_FAIL;
+            strerror_r( errno, auxErrorMessage, C_BUFFER_SIZE );
+            errorMessage += "Setting of socket receive buffer size failed:\n    ";
+            errorMessage += auxErrorMessage;
+            errorMessage += ".\n";
+        }
+    }
+
+#ifdef SO_RXQ_OVFL
+    if ( errorCode == 0 )
+    {
+        // Ask the kernel to report the number of dropped datagrams with every datagram.
+        // Not all kernels support this, so failing is not an error.
+        int enable = 1;
+        setsockopt( socketID, SOL_SOCKET, SO_RXQ_OVFL, ( char * ) &enable, sizeof( enable ) );
+        droppedCount = 0;
+    }
+#endif
+
+#ifdef SO_TIMESTAMPNS
+    if ( errorCode == 0 )
+    {
+        // Ask the kernel for the arrival time of every datagram, so the time stamps do not depend on
+        // how long the datagrams waited in the receive queue. Without it readBatch() takes the time itself.
+        int enable = 1;
+        kernelTimeStamps = ( setsockopt( socketID, SOL_SOCKET, SO_TIMESTAMPNS, ( char * ) &enable, sizeof( enable ) ) == 0 );
+    }
+#endif
+
     if ( errorCode == 0 )
     {
         // Bind to the proper port number with the IP address
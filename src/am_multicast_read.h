@@ -1,6 +1,8 @@
 #ifndef __AM_MULTI_CAST_READ_H__
 #define __AM_MULTI_CAST_READ_H__
 
+#include <stddef.h>
+
 class amString;
 
 class amMulticastRead
@@ -8,8 +10,11 @@ class amMulticastRead
 
     private:
 
-        int  socketID;
-        bool connectionUp;
+        int          socketID;
+        int          receiveBufferSize;
+        bool         connectionUp;
+        unsigned int droppedCount;
+        bool         kernelTimeStamps;
 
         bool determineIPAddress( amString &ipAddress, const amString &interface );
 
@@ -22,7 +27,18 @@ class amMulticastRead
         inline bool isUp( void ) const { return connectionUp; }
         void close( void );
 
+        inline int  getReceiveBufferSize( void ) const { return receiveBufferSize; }
+        inline void setReceiveBufferSize( int value )  { receiveBufferSize = value; }
+
+        // Number of datagrams the kernel dropped on this socket because the receive queue was full.
+        inline unsigned int getDroppedCount( void ) const { return droppedCount; }
+
+        // The datagrams carry the time the kernel received them (see readBatch()).
+        inline bool hasKernelTimeStamps( void ) const { return kernelTimeStamps; }
+
         size_t read( unsigned char *buffer, size_t bufferSize );
+        int    readBatch( unsigned char *buffer, size_t bufferSize, size_t *lengths, long long *receiveTimes, int maxCount, unsigned int *senderAddresses = NULL );
+        int    waitForData( int timeOutMS );
         int connect( const amString &interface, const amString &ipAddress, int portNo, int timeOutSec, amString &errorMessage );
 
 };
@@ -1,17 +1,33 @@
+#include <time.h>
 #include <unistd.h>
 #include <arpa/inet.h>
+#include <sys/uio.h>
 
 #include "am_string.h"
 #include "ant_constants.h"
 #include "am_multicast_write.h"
 
+static long long getMonotonicMS
+(
+    void
+)
+{
+    struct timespec now;
+    clock_gettime( CLOCK_MONOTONIC_COARSE, &now );
+    return ( long long ) now.tv_sec * 1000 + now.tv_nsec / 1000000;
+}
+
 amMulticastWrite::amMulticastWrite
 (
     void
 )
 {
-    connectionUp = false;
-    socketID      = -1;
+    connectionUp   = false;
+    socketID       = -1;
+    datagramSize   = 0;
+    maxDelayMS     = 0;
+    nbDatagrams    = 0;
+    pendingSinceMS = 0;
     bzero( ( char * ) &groupSock, sizeof( groupSock ) );
 }
 
@@ -23,6 +39,8 @@ void amMulticastWrite::close
 {
     if ( connectionUp )
     {
+        amString errorMessage;
+        flush( errorMessage );
         if ( socketID > 0 )
         {
             ::close( socketID );
@@ -45,6 +63,8 @@ size_t amMulticastWrite::write
     if ( connectionUp && ( socketID > 0 ) && !buffer.empty() )
     {
         size_t bufferSize = ( length < 0 ) ? buffer.size() : length;
+
+        flush( errorMessage );   // Keep the order of the messages.
         if ( sendto( socketID, buffer.c_str(), bufferSize, 0, ( struct sockaddr * ) &groupSock, sizeof( groupSock ) ) < 0 )
         {
             errorCode     = E_MC_WRITE_FAIL;
@@ -58,6 +78,191 @@ size_t amMulticastWrite::write
     return errorCode;
 }
 
+// -------------------------------------------------------------------------------------------------//
+//
+// Pack the output records into datagrams of up to 'maxDatagramSize' bytes (records are separated by
+// new lines and never split), which are sent in batches with a single system call.
+// A record waits at most 'maxDelay' milliseconds. 'maxDatagramSize' = 0 switches coalescing off.
+//
+// -------------------------------------------------------------------------------------------------//
+void amMulticastWrite::setCoalescing
+(
+    size_t       maxDatagramSize,
+    unsigned int maxDelay
+)
+{
+    datagramSize = maxDatagramSize;
+    maxDelayMS   = maxDelay;
+    nbDatagrams  = 0;
+    datagrams.resize( C_MC_BATCH_SIZE * datagramSize );
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Return the number of milliseconds until the pending records have to be sent (-1: none pending).
+//
+// -------------------------------------------------------------------------------------------------//
+int amMulticastWrite::getRemainingDelayMS
+(
+    void
+) const
+{
+    int result = -1;
+    if ( nbDatagrams > 0 )
+    {
+        long long remaining = pendingSinceMS + maxDelayMS - getMonotonicMS();
+        result = ( remaining > 0 ) ? ( int ) remaining : 0;
+    }
+    return result;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Send a record followed by a new line. Without coalescing the record is sent as a single datagram
+// (without copying it), otherwise it is added to the pending datagrams.
+//
+// -------------------------------------------------------------------------------------------------//
+size_t amMulticastWrite::writeLine
+(
+    const amString &buffer,
+    int             errorCode,
+    amString       &errorMessage
+)
+{
+    errorCode = E_EMPTY_MESSAGE;
+    if ( connectionUp && ( socketID > 0 ) && !buffer.empty() && ( buffer.size() < datagramSize ) )
+    {
+        size_t lineLength = buffer.size() + 1;
+        if ( ( nbDatagrams == 0 ) || ( datagramLengths[ nbDatagrams - 1 ] + lineLength > datagramSize ) )
+        {
+            if ( nbDatagrams == C_MC_BATCH_SIZE )
+            {
+                errorCode = sendDatagrams( errorMessage );
+            }
+            if ( nbDatagrams == 0 )
+            {
+                pendingSinceMS = getMonotonicMS();
+            }
+            datagramLengths[ nbDatagrams++ ] = 0;
+        }
+
+        char *datagram = &( datagrams[ ( nbDatagrams - 1 ) * datagramSize ] );
+        memcpy( datagram + datagramLengths[ nbDatagrams - 1 ], buffer.c_str(), buffer.size() );
+        datagram[ datagramLengths[ nbDatagrams - 1 ] + buffer.size() ] = '\n';
+        datagramLengths[ nbDatagrams - 1 ] += lineLength;
+
+        if ( getMonotonicMS() - pendingSinceMS >= maxDelayMS )
+        {
+            errorCode = sendDatagrams( errorMessage );
+        }
+        else if ( errorCode == E_EMPTY_MESSAGE )
+        {
+            errorCode = 0;
+        }
+    }
+    else if ( connectionUp && ( socketID > 0 ) && !buffer.empty() )
+    {
+        struct iovec  parts[ 2 ];
+        struct msghdr message;
+
+        flush( errorMessage );   // Keep the order of the messages.
+
+        parts[ 0 ].iov_base = ( void * ) buffer.c_str();
+        parts[ 0 ].iov_len  = buffer.size();
+        parts[ 1 ].iov_base = ( void * ) "\n";
+        parts[ 1 ].iov_len  = 1;
+
+        bzero( ( char * ) &message, sizeof( message ) );
+        message.msg_name    = ( void * ) &groupSock;
+        message.msg_namelen = sizeof( groupSock );
+        message.msg_iov     = parts;
+        message.msg_iovlen  = 2;
+
+        if ( sendmsg( socketID, &message, 0 ) < 0 )
+        {
+            errorCode     = E_MC_WRITE_FAIL;
+            errorMessage += "Sending message via multicast failed.\n";
+        }
+        else
+        {
+            errorCode = 0;
+        }
+    }
+    return errorCode;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Send all pending records.
+//
+// -------------------------------------------------------------------------------------------------//
+int amMulticastWrite::flush
+(
+    amString &errorMessage
+)
+{
+    int errorCode = 0;
+    if ( nbDatagrams > 0 )
+    {
+        errorCode = sendDatagrams( errorMessage );
+    }
+    return errorCode;
+}
+
+int amMulticastWrite::sendDatagrams
+(
+    amString &errorMessage
+)
+{
+    int errorCode = 0;
+    int nbSent    = 0;
+
+#ifdef __linux__
+    struct mmsghdr messages[ C_MC_BATCH_SIZE ];
+    struct iovec   ioVectors[ C_MC_BATCH_SIZE ];
+
+    bzero( ( void * ) messages, nbDatagrams * sizeof( struct mmsghdr ) );
+    for ( int counter = 0; counter < nbDatagrams; ++counter )
+    {
+        ioVectors[ counter ].iov_base           = ( void * ) &( datagrams[ counter * datagramSize ] );
+        ioVectors[ counter ].iov_len            = datagramLengths[ counter ];
+        messages[ counter ].msg_hdr.msg_name    = ( void * ) &groupSock;
+        messages[ counter ].msg_hdr.msg_namelen = sizeof( groupSock );
+        messages[ counter ].msg_hdr.msg_iov     = &( ioVectors[ counter ] );
+        messages[ counter ].msg_hdr.msg_iovlen  = 1;
+    }
+
+    // sendmmsg may send fewer datagrams than requested.
+    while ( ( errorCode == 0 ) && ( nbSent < nbDatagrams ) )
+    {
+        int result = sendmmsg( socketID, messages + nbSent, nbDatagrams - nbSent, 0 );
+        if ( result < 0 )
+        {
+            errorCode = E_MC_WRITE_FAIL;
+        }
+        else
+        {
+            nbSent += result;
+        }
+    }
+#else
+    for ( ; ( errorCode == 0 ) && ( nbSent < nbDatagrams ); ++nbSent )
+    {
+        if ( sendto( socketID, &( datagrams[ nbSent * datagramSize ] ), datagramLengths[ nbSent ], 0, ( struct sockaddr * ) &groupSock, sizeof( groupSock ) ) < 0 )
+        {
+            errorCode = E_MC_WRITE_FAIL;
+        }
+    }
+#endif
+
+    if ( errorCode != 0 )
+    {
+        errorMessage += "Sending message via multicast failed.\n";
+    }
+    nbDatagrams = 0;
+    return errorCode;
+}
+
 int amMulticastWrite::connect
 (
     const amString &ipAddress,
@@ -67,7 +272,7 @@ int amMulticastWrite::connect
 {
     int errorCode = 0;
 
-    if ( !ipAddress.empty() )
+    if ( ipAddress.empty() )
     {   
         errorCode     = E_MC_NO_IP_ADDRESS;
         errorMessage += "Creating multicast connection for writing failed. No IP Address.\n";
@@ -2,6 +2,9 @@
 #define __AM_MULTI_CAST_WRITE_H__
 
 #include <netdb.h>
+#include <vector>
+
+#include "ant_constants.h"
 
 class amString;
 
@@ -13,7 +16,17 @@ class amMulticastWrite
         int  socketID;
         bool connectionUp;
 
+        // Coalescing: records are collected in up to C_MC_BATCH_SIZE datagrams of at most
+        // datagramSize bytes each which are sent together.
+        size_t            datagramSize;
+        unsigned int      maxDelayMS;
+        std::vector<char> datagrams;
+        size_t            datagramLengths[ C_MC_BATCH_SIZE ];
+        int               nbDatagrams;
+        long long         pendingSinceMS;
+
         bool determineIPAddress( amString &ipAddress, const amString &interface );
+        int  sendDatagrams( amString &errorMessage );
 
         struct sockaddr_in groupSock;
 
@@ -25,8 +38,15 @@ class amMulticastWrite
 
         inline bool isUp( void ) const { return connectionUp; }
 
+        void setCoalescing( size_t maxDatagramSize, unsigned int maxDelay );
+        inline bool isCoalescing( void ) const { return datagramSize > 0; }
+        inline bool hasPending( void ) const   { return nbDatagrams > 0; }
+        int getRemainingDelayMS( void ) const;
+
         void   close( void );
         size_t write( const amString &buffer, int errorCode, amString &errorMessage, int length = -1 );
+        size_t writeLine( const amString &buffer, int errorCode, amString &errorMessage );
+        int    flush( amString &errorMessage );
         int connect( const amString &ipAddress, int portNo, amString &errorMessage );
 
 };
@@ -0,0 +1,295 @@
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "am_string.h"
+#include "am_output_writer.h"
+
+static long long getMonotonicMS
+(
+    void
+)
+{
+    struct timespec now;
+    clock_gettime( CLOCK_MONOTONIC_COARSE, &now );
+    return ( long long ) now.tv_sec * 1000 + now.tv_nsec / 1000000;
+}
+
+amOutputWriter::amOutputWriter
+(
+    void
+) : queue( C_OUTPUT_QUEUE_SIZE )
+{
+    fileDescriptor = -1;
+    maxBytes       = C_DEFAULT_OUTPUT_BUFFER_SIZE;
+    maxRecords     = C_DEFAULT_OUTPUT_MAX_RECORDS;
+    maxDelayMS     = C_DEFAULT_OUTPUT_MAX_DELAY_MS;
+    flushOnIdle    = C_DEFAULT_OUTPUT_FLUSH_ON_IDLE;
+    useThread      = C_DEFAULT_OUTPUT_USE_THREAD;
+    threadRunning  = false;
+    stopRequested  = 0;
+    pendingRecords = 0;
+    pendingSinceMS = 0;
+}
+
+amOutputWriter::~amOutputWriter
+(
+    void
+)
+{
+    close();
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Start writing to the file descriptor (and start the writer thread if requested).
+//
+// -------------------------------------------------------------------------------------------------//
+int amOutputWriter::open
+(
+    int       outputFileDescriptor,
+    amString &errorMessage
+)
+{
+    int errorCode = 0;
+
+    close();
+    fileDescriptor = outputFileDescriptor;
+    pending.reserve( maxBytes + C_BUFFER_SIZE );
+
+    if ( useThread )
+    {
+        __atomic_store_n( &stopRequested, 0, __ATOMIC_RELAXED );
+        if ( pthread_create( &writerThread, NULL, writerThreadMain, this ) != 0 )
+        {
+            errorCode     = E_THREAD_CREATE_FAIL;
+            errorMessage += "Creating the output writer thread failed.\n";
+        }
+        else
+        {
+            threadRunning = true;
+        }
+    }
+
+    return errorCode;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Write all pending output and stop the writer thread.
+//
+// -------------------------------------------------------------------------------------------------//
+void amOutputWriter::close
+(
+    void
+)
+{
+    if ( fileDescriptor >= 0 )
+    {
+        flush();
+        if ( threadRunning )
+        {
+            __atomic_store_n( &stopRequested, 1, __ATOMIC_RELEASE );
+            pthread_join( writerThread, NULL );
+            threadRunning = false;
+        }
+        fileDescriptor = -1;
+    }
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Add a record (a new line is appended) and write the pending records if one of the
+// flush conditions is met.
+//
+// -------------------------------------------------------------------------------------------------//
+void amOutputWriter::writeLine
+(
+    const amString &line
+)
+{
+    if ( pendingRecords == 0 )
+    {
+        pendingSinceMS = ( maxDelayMS > 0 ) ? getMonotonicMS() : 0;
+    }
+    pending.append( line );
+    pending.push_back( '\n' );
+    recordAdded();
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Add a record which brings its own framing (binary output, see option '-E').
+//
+// -------------------------------------------------------------------------------------------------//
+void amOutputWriter::write
+(
+    const amString &data
+)
+{
+    if ( pendingRecords == 0 )
+    {
+        pendingSinceMS = ( maxDelayMS > 0 ) ? getMonotonicMS() : 0;
+    }
+    pending.append( data );
+    recordAdded();
+}
+
+void amOutputWriter::recordAdded
+(
+    void
+)
+{
+    ++pendingRecords;
+
+    if ( ( pending.size() >= maxBytes ) ||
+         ( ( maxRecords > 0 ) && ( pendingRecords >= maxRecords ) ) ||
+         ( ( maxDelayMS > 0 ) && ( getMonotonicMS() - pendingSinceMS >= maxDelayMS ) ) )
+    {
+        submit();
+    }
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Tell the writer that no more input is waiting, i.e. that the next read will block.
+//
+// -------------------------------------------------------------------------------------------------//
+void amOutputWriter::idle
+(
+    void
+)
+{
+    if ( flushOnIdle && ( pendingRecords > 0 ) )
+    {
+        submit();
+    }
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Write all pending records and wait until the writer thread has written them.
+//
+// -------------------------------------------------------------------------------------------------//
+void amOutputWriter::flush
+(
+    void
+)
+{
+    long waitTime = C_MIN_WAIT_NS;
+
+    if ( pendingRecords > 0 )
+    {
+        submit();
+    }
+    while ( threadRunning && !queue.isEmpty() )
+    {
+        amWaitNS( waitTime );
+    }
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Write the pending records, or hand them over to the writer thread.
+// The pending buffer is swapped with an empty queue slot, so neither side copies or allocates.
+//
+// -------------------------------------------------------------------------------------------------//
+void amOutputWriter::submit
+(
+    void
+)
+{
+    long         waitTime = C_MIN_WAIT_NS;
+    std::string *chunk    = NULL;
+
+    if ( threadRunning )
+    {
+        // Queue full: wait for the writer thread.
+        while ( ( chunk = queue.getBack() ) == NULL )
+        {
+            amWaitNS( waitTime );
+        }
+        pending.swap( *chunk );
+        queue.push();
+    }
+    else
+    {
+        writeAll( pending.data(), pending.size() );
+    }
+    pending.clear();
+    pendingRecords = 0;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Write a buffer completely (write() may write less than requested, e.g. on pipes).
+//
+// -------------------------------------------------------------------------------------------------//
+void amOutputWriter::writeAll
+(
+    const char *data,
+    size_t      length
+)
+{
+    ssize_t nbWritten = 0;
+
+    while ( length > 0 )
+    {
+        nbWritten = ::write( fileDescriptor, data, length );
+        if ( nbWritten < 0 )
+        {
+            if ( errno != EINTR )
+            {
+                break;
+            }
+        }
+        else
+        {
+            data   += nbWritten;
+            length -= nbWritten;
+        }
+    }
+}
+
+void *amOutputWriter::writerThreadMain
+(
+    void *writer
+)
+{
+    ( ( amOutputWriter * ) writer )->runWriterThread();
+    return NULL;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Main loop of the writer thread: write the queued chunks in order until stopped.
+//
+// -------------------------------------------------------------------------------------------------//
+void amOutputWriter::runWriterThread
+(
+    void
+)
+{
+    long         waitTime = C_MIN_WAIT_NS;
+    std::string *chunk    = NULL;
+
+    while ( true )
+    {
+        chunk = queue.getFront();
+        if ( chunk != NULL )
+        {
+            writeAll( chunk->data(), chunk->size() );
+            chunk->clear();
+            queue.pop();
+            waitTime = C_MIN_WAIT_NS;
+        }
+        else if ( __atomic_load_n( &stopRequested, __ATOMIC_ACQUIRE ) != 0 )
+        {
+            break;
+        }
+        else
+        {
+            amWaitNS( waitTime );
+        }
+    }
+}
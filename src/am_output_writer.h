@@ -0,0 +1,76 @@
+#ifndef __AM_OUTPUT_WRITER_H__
+#define __AM_OUTPUT_WRITER_H__
+
+#include <stddef.h>
+#include <pthread.h>
+#include <string>
+
+#include "ant_constants.h"
+#include "am_spsc_queue.h"
+
+class amString;
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Buffered writer for the output records (one line each).
+// Records are collected and written with a single write() when one of the flush conditions is met:
+// too many pending bytes or records, the oldest pending record is too old, or the input is idle.
+// Optionally the writes are done by a separate thread which is fed by a single producer/single
+// consumer lock-free queue of chunks, so a slow reader of stdout does not hold up the input.
+//
+// -------------------------------------------------------------------------------------------------//
+class amOutputWriter
+{
+
+    private:
+
+        int          fileDescriptor;
+        size_t       maxBytes;
+        unsigned int maxRecords;
+        unsigned int maxDelayMS;
+        bool         flushOnIdle;
+        bool         useThread;
+        bool         threadRunning;
+        int          stopRequested;
+
+        std::string  pending;
+        unsigned int pendingRecords;
+        long long    pendingSinceMS;
+
+        amSpscQueue<std::string> queue;
+        pthread_t                writerThread;
+
+        static void *writerThreadMain( void *writer );
+        void runWriterThread( void );
+        void writeAll( const char *data, size_t length );
+        void submit( void );
+        void recordAdded( void );
+
+
+    public:
+
+        amOutputWriter( void );
+        ~amOutputWriter( void );
+
+        inline size_t       getMaxBytes( void ) const    { return maxBytes; }
+        inline void         setMaxBytes( size_t value )  { maxBytes = value; }
+        inline unsigned int getMaxRecords( void ) const  { return maxRecords; }
+        inline void         setMaxRecords( unsigned int value ) { maxRecords = value; }
+        inline unsigned int getMaxDelayMS( void ) const  { return maxDelayMS; }
+        inline void         setMaxDelayMS( unsigned int value ) { maxDelayMS = value; }
+        inline bool         getFlushOnIdle( void ) const { return flushOnIdle; }
+        inline void         setFlushOnIdle( bool value ) { flushOnIdle = value; }
+        inline bool         getUseThread( void ) const   { return useThread; }
+        inline void         setUseThread( bool value )   { useThread = value; }
+
+        int  open( int outputFileDescriptor, amString &errorMessage );
+        void close( void );
+
+        void writeLine( const amString &line );
+        void write    ( const amString &data );
+        void idle( void );
+        void flush( void );
+
+};
+
+#endif // __AM_OUTPUT_WRITER_H__
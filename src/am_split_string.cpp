@@ -11,7 +11,7 @@ amSplitString::amSplitString
 
 amSplitString::amSplitString
 (
-    const amString &text
+    const amStringView &text
 )
 {
     init();
@@ -25,14 +25,14 @@ void amSplitString::init
 {
     curWordNo   = 0;
 
-    separators.clear();
-    separators += '\t';
-    separators += ' ';
+    separators.reset();
+    separators.set( ( BYTE ) '\t' );
+    separators.set( ( BYTE ) ' ' );
 
-    terminals.clear();
-    terminals  += '\0';
-    terminals  += '\n';
-    terminals  += '\r';
+    terminals.reset();
+    terminals.set( ( BYTE ) '\0' );
+    terminals.set( ( BYTE ) '\n' );
+    terminals.set( ( BYTE ) '\r' );
 }
 
 bool amSplitString::isSeparator
@@ -40,7 +40,7 @@ bool amSplitString::isSeparator
     char testChar
 ) const
 {
-    return separators.contains( testChar );
+    return separators[ ( BYTE ) testChar ];
 }
 
 bool amSplitString::isTerminal
@@ -48,7 +48,7 @@ bool amSplitString::isTerminal
     char testChar
 ) const
 {
-    return terminals.contains( testChar );
+    return terminals[ ( BYTE ) testChar ];
 }
 
 void amSplitString::addSeparator
@@ -56,10 +56,7 @@ void amSplitString::addSeparator
     char newSeparator
 )
 {
-    if ( !isSeparator( newSeparator ) )
-    {
-        separators += newSeparator;
-    }
+    separators.set( ( BYTE ) newSeparator );
 }
 
 void amSplitString::addTerminal
@@ -67,10 +64,7 @@ void amSplitString::addTerminal
     char newTerminal
 )
 {
-    if ( !isTerminal( newTerminal ) )
-    {
-        terminals += newTerminal;
-    }
+    terminals.set( ( BYTE ) newTerminal );
 }
 
 void amSplitString::removeSeparator
@@ -78,7 +72,7 @@ void amSplitString::removeSeparator
     char obsoleteSeparator
 )
 {
-    separators.removeFromString( obsoleteSeparator );
+    separators.reset( ( BYTE ) obsoleteSeparator );
 }
 
 void amSplitString::removeTerminal
@@ -86,80 +80,99 @@ void amSplitString::removeTerminal
     char obsoleteTerminal
 )
 {
-    terminals.removeFromString( obsoleteTerminal );
+    terminals.reset( ( BYTE ) obsoleteTerminal );
 }
 
-
+// -------------------------------------------------------------------------------------------------//
+//
+// Split the text into words (views into 'text').
+// The text ends at its first terminal character.
+//
+// -------------------------------------------------------------------------------------------------//
 size_t amSplitString::split
 (
-    const amString &text,
-    const amString &additionalSeparators,
-    const amString &additionalTermnials
+    const amStringView &text,
+    const amStringView &additionalSeparators,
+    const amStringView &additionalTerminals
 )
 {
-    amString                 word;
-    amString::const_iterator tPtr = text.begin();
+    characterSet        allSeparators = separators;
+    characterSet        allTerminals  = terminals;
+    const characterSet &curSeparators = additionalSeparators.empty() ? separators : allSeparators;
+    const characterSet &curTerminals  = additionalTerminals.empty()  ? terminals  : allTerminals;
+    const char         *tPtr          = text.begin();
+    const char         *textEnd       = text.end();
+    const char         *wordStart     = NULL;
 
     words.clear();
+    ownWords.clear();
     curWordNo = 0;
 
-    while ( !isTerminal( *tPtr ) && !additionalTermnials.contains( *tPtr ) && ( tPtr != text.end() ) )
+    for ( const char *aPtr = additionalSeparators.begin(); aPtr != additionalSeparators.end(); ++aPtr )
+    {
+        allSeparators.set( ( BYTE ) *aPtr );
+    }
+    for ( const char *aPtr = additionalTerminals.begin(); aPtr != additionalTerminals.end(); ++aPtr )
+    {
+        allTerminals.set( ( BYTE ) *aPtr );
+    }
+
+    for ( ; ( tPtr != textEnd ) && !curTerminals[ ( BYTE ) *tPtr ]; ++tPtr )
     {
-        if ( isSeparator( *tPtr ) || additionalSeparators.contains( *tPtr ) )
+        if ( curSeparators[ ( BYTE ) *tPtr ] )
         {
-            if ( !word.empty() )
+            if ( wordStart != NULL )
             {
-                words.push_back( word );
-                word.clear();
+                words.push_back( amStringView( wordStart, tPtr - wordStart ) );
+                wordStart = NULL;
             }
         }
-        else
+        else if ( wordStart == NULL )
         {
-            word += *tPtr;
+            wordStart = tPtr;
         }
-        ++tPtr;
     }
-    if ( !word.empty() )
+    if ( wordStart != NULL )
     {
-        words.push_back( word );
+        words.push_back( amStringView( wordStart, tPtr - wordStart ) );
     }
 
     return words.size();
 }
 
-const amString amSplitString::getWord
+amStringView amSplitString::getWord
 (
     size_t index
 ) const
 {
-    return index < words.size() ? words[ index ] : amString( "" );
+    return index < words.size() ? words[ index ] : amStringView();
 }
 
-const amString amSplitString::operator[]
+amStringView amSplitString::operator[]
 (
     size_t index
 ) const
 {
-    return index < words.size() ? words[ index ] : amString( "" );
+    return index < words.size() ? words[ index ] : amStringView();
 }
 
-const amString amSplitString::front
+amStringView amSplitString::front
 (
     void
 ) const
 {
-    return words.size() ? words.front() : amString( "" );
+    return words.size() ? words.front() : amStringView();
 }
 
-const amString amSplitString::back
+amStringView amSplitString::back
 (
     void
 ) const
 {
-    return words.size() ? words.back() : amString( "" );
+    return words.size() ? words.back() : amStringView();
 }
 
-const amString amSplitString::getNextWord
+amStringView amSplitString::getNextWord
 (
     void
 )
@@ -168,20 +181,34 @@ const amString amSplitString::getNextWord
     {
         return words[ curWordNo++ ];
     }
-    return amString( "" );
+    return amStringView();
 }
 
 void amSplitString::push_back
 (
-    const amString &word
+    const amStringView &word
 )
 {
     if ( !word.empty() )
     {
-        words.push_back( word );
+        // The elements of a deque stay where they are when more are added.
+        ownWords.push_back( word );
+        words.push_back( ownWords.back() );
     }
 }
 
+void amSplitString::swap
+(
+    amSplitString &other
+)
+{
+    words.swap( other.words );
+    ownWords.swap( other.ownWords );
+    std::swap( terminals, other.terminals );
+    std::swap( separators, other.separators );
+    std::swap( curWordNo, other.curWordNo );
+}
+
 amString amSplitString::concatenate
 (
     int  start,
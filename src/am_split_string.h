@@ -1,50 +1,72 @@
 #ifndef __AM_SPLIT_STRING_H__
 #define __AM_SPLIT_STRING_H__
 
+#include <bitset>
+#include <deque>
 #include <fstream>
 #include <ostream>
 #include <vector>
 
 #include "am_string.h"
-
+#include "am_string_view.h"
+
+const size_t C_NB_CHARACTERS = 256;
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Split a text into words.
+// split() does not copy anything: it records where the words are in the text, and the words are
+// returned as views into it, so the text must not change or go away while the words are used.
+// Separators and terminals are looked up in tables with a bit per character.
+// Words added with push_back() are copies kept by the object itself.
+//
+// -------------------------------------------------------------------------------------------------//
 class amSplitString
 {
 
     private:
 
-        std::vector<amString> words;
-        amString              terminals;
-        amString              separators;
-        size_t                curWordNo;
+        typedef std::bitset<C_NB_CHARACTERS> characterSet;
+
+        std::vector<amStringView> words;
+        std::deque<amString>      ownWords;     // Storage of the words added with push_back().
+        characterSet              terminals;
+        characterSet              separators;
+        size_t                    curWordNo;
 
         void init       ( void );
         bool isTerminal ( char ) const;
         bool isSeparator( char ) const;
 
+        // Not copyable: the words could point into the storage of the original.
+        amSplitString( const amSplitString & );
+        amSplitString &operator=( const amSplitString & );
+
 
     public:
 
         amSplitString( void );
-        amSplitString( const amString & );
+        amSplitString( const amStringView & );
         ~amSplitString( void ) {};
 
-        inline void removeAllTerminals( void )  { terminals.clear(); }
-        inline void removeAllSeparators( void ) { separators.clear(); }
-        inline void clear( void ) { words.clear(); }
+        inline void removeAllTerminals( void )  { terminals.reset(); }
+        inline void removeAllSeparators( void ) { separators.reset(); }
+        inline void clear( void ) { words.clear(); ownWords.clear(); curWordNo = 0; }
 
         void addTerminal( char );
         void addSeparator( char );
         void removeTerminal( char );
         void removeSeparator( char );
-        void push_back( const amString &word );
+        void push_back( const amStringView &word );
+        void swap( amSplitString &other );
 
-        size_t split( const amString &text, const amString &additionalTermnials = "", const amString &additionalSeparators = "" );
+        size_t split( const amStringView &text, const amStringView &additionalSeparators = "", const amStringView &additionalTerminals = "" );
 
-        const amString getWord( size_t index ) const;
-        const amString operator[]( size_t index ) const;
-        const amString getNextWord( void );
-        const amString front( void ) const;
-        const amString back( void ) const;
+        amStringView getWord( size_t index ) const;
+        amStringView operator[]( size_t index ) const;
+        amStringView getNextWord( void );
+        amStringView front( void ) const;
+        amStringView back( void ) const;
 
         amString concatenate( int start, int end = -1, char link = ' ' ) const;
 
@@ -55,4 +77,3 @@ class amSplitString
 extern std::ostream &operator<<( std::ostream &, const amSplitString & );
 
 #endif // __AM_SPLIT_STRING_H__
-
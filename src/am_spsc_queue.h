@@ -0,0 +1,88 @@
+#ifndef __AM_SPSC_QUEUE_H__
+#define __AM_SPSC_QUEUE_H__
+
+#include <time.h>
+#include <vector>
+
+#include "ant_constants.h"
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Wait a little before polling again (used while a queue is empty or full).
+// The waiting time doubles with every call, up to C_MAX_WAIT_NS.
+//
+// -------------------------------------------------------------------------------------------------//
+inline void amWaitNS
+(
+    long &waitTime
+)
+{
+    struct timespec delay;
+    delay.tv_sec  = 0;
+    delay.tv_nsec = waitTime;
+    nanosleep( &delay, NULL );
+    waitTime = ( 2 * waitTime < C_MAX_WAIT_NS ) ? 2 * waitTime : C_MAX_WAIT_NS;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Single producer/single consumer lock-free ring of slots.
+// The slots are allocated once and re-used: the producer fills the slot returned by getBack() and
+// publishes it with push(), the consumer works on the slot returned by getFront() and releases it
+// with pop(). Buffers kept in the slots (e.g. strings) keep their capacity, so nothing is allocated
+// once the queue has warmed up.
+//
+// -------------------------------------------------------------------------------------------------//
+template <class T> class amSpscQueue
+{
+
+    private:
+
+        std::vector<T> slots;
+        unsigned int   mask;
+        unsigned int   head;   // Next slot to be read (only advanced by the consumer).
+        unsigned int   tail;   // Next slot to be written (only advanced by the producer).
+
+
+    public:
+
+        amSpscQueue( unsigned int capacity = 1 ) : mask( 0 ), head( 0 ), tail( 0 ) { resize( capacity ); }
+        ~amSpscQueue( void ) {}
+
+        // The number of slots is rounded up to a power of 2. Only call while no thread uses the queue.
+        void resize( unsigned int capacity )
+        {
+            unsigned int size = 1;
+            while ( size < capacity )
+            {
+                size *= 2;
+            }
+            slots.resize( size );
+            mask = size - 1;
+            head = tail = 0;
+        }
+
+        inline unsigned int getCapacity( void ) const { return mask + 1; }
+
+        // Producer: the next free slot, or NULL if the queue is full.
+        inline T *getBack( void )
+        {
+            return ( tail - __atomic_load_n( &head, __ATOMIC_ACQUIRE ) > mask ) ? NULL : &( slots[ tail & mask ] );
+        }
+        inline void push( void ) { __atomic_store_n( &tail, tail + 1, __ATOMIC_RELEASE ); }
+
+        // Consumer: the oldest filled slot, or NULL if the queue is empty.
+        inline T *getFront( void )
+        {
+            return ( __atomic_load_n( &tail, __ATOMIC_ACQUIRE ) == head ) ? NULL : &( slots[ head & mask ] );
+        }
+        inline void pop( void ) { __atomic_store_n( &head, head + 1, __ATOMIC_RELEASE ); }
+
+        inline bool isEmpty( void ) const
+        {
+            return __atomic_load_n( &tail, __ATOMIC_ACQUIRE ) == __atomic_load_n( &head, __ATOMIC_ACQUIRE );
+        }
+
+};
+
+#endif // __AM_SPSC_QUEUE_H__
@@ -1,8 +1,63 @@
 #include <sstream>
 #include <iomanip>
 #include <iostream>
+#include <stdio.h>
+#if __cplusplus >= 201703L
+#include <charconv>
+#endif
 
 #include "am_string.h"
+#include "am_string_view.h"
+
+// Large enough for any int and for doubles printed with the precisions used for the output.
+const size_t C_NUMBER_BUFFER_SIZE = 64;
+
+static const char C_DIGIT_PAIRS[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+static const char C_HEX_DIGITS[] = "0123456789ABCDEF";
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Write the decimal digits of number so that they end right before 'last'.
+// Returns a pointer to the first digit.
+//
+// -------------------------------------------------------------------------------------------------//
+template <class T>
+static char *uintToChars
+(
+    char *last,
+    T     number
+)
+{
+    unsigned int pairNo = 0;
+    while ( number >= 100 )
+    {
+        pairNo  = 2 * ( number % 100 );
+        number /= 100;
+        *--last = C_DIGIT_PAIRS[ pairNo + 1 ];
+        *--last = C_DIGIT_PAIRS[ pairNo ];
+    }
+    if ( number >= 10 )
+    {
+        *--last = C_DIGIT_PAIRS[ 2 * number + 1 ];
+        *--last = C_DIGIT_PAIRS[ 2 * number ];
+    }
+    else
+    {
+        *--last = ( char ) ( '0' + number );
+    }
+    return last;
+}
 
 amString::amString
 (
@@ -30,9 +85,7 @@ amString::amString
     int number
 ) : std::string()
 {
-    std::stringstream auxStream;
-    auxStream << number;
-    assign( auxStream.str() );
+    appendNumber( number );
 }
 
 amString::amString
@@ -40,9 +93,7 @@ amString::amString
     unsigned int number
 ) : std::string()
 {
-    std::stringstream auxStream;
-    auxStream << number;
-    assign( auxStream.str() );
+    appendNumber( number );
 }
 
 amString::amString
@@ -50,10 +101,7 @@ amString::amString
     BYTE number
 ) : std::string()
 {
-    std::stringstream auxStream;
-    auxStream << std::hex << std::setfill( '0' );
-    auxStream << "0x" << std::uppercase << std::setw( 2 ) << static_cast<unsigned>( number );
-    assign( auxStream.str() );
+    appendHex( number );
 }
 
 amString::amString
@@ -62,11 +110,8 @@ amString::amString
     BYTE number2
 ) : std::string()
 {
-    std::stringstream auxStream;
-    auxStream << std::hex << std::setfill( '0' ) << "0x" << std::uppercase;
-    auxStream << std::setw( 2 ) << static_cast<unsigned>( number1 );
-    auxStream << std::setw( 2 ) << static_cast<unsigned>( number2 );
-    assign( auxStream.str() );
+    BYTE numbers[ 2 ] = { number1, number2 };
+    appendHex( numbers, 2 );
 }
 
 amString::amString
@@ -76,12 +121,8 @@ amString::amString
     BYTE number3
 ) : std::string()
 {
-    std::stringstream auxStream;
-    auxStream << std::hex << std::setfill( '0' ) << "0x" << std::uppercase;
-    auxStream << std::setw( 2 ) << static_cast<unsigned>( number1 );
-    auxStream << std::setw( 2 ) << static_cast<unsigned>( number2 );
-    auxStream << std::setw( 2 ) << static_cast<unsigned>( number3 );
-    assign( auxStream.str() );
+    BYTE numbers[ 3 ] = { number1, number2, number3 };
+    appendHex( numbers, 3 );
 }
 
 amString::amString
@@ -92,13 +133,8 @@ amString::amString
     BYTE number4
 ) : std::string()
 {
-    std::stringstream auxStream;
-    auxStream << std::hex << std::setfill( '0' ) << "0x" << std::uppercase;
-    auxStream << std::setw( 2 ) << static_cast<unsigned>( number1 );
-    auxStream << std::setw( 2 ) << static_cast<unsigned>( number2 );
-    auxStream << std::setw( 2 ) << static_cast<unsigned>( number3 );
-    auxStream << std::setw( 2 ) << static_cast<unsigned>( number4 );
-    assign( auxStream.str() );
+    BYTE numbers[ 4 ] = { number1, number2, number3, number4 };
+    appendHex( numbers, 4 );
 }
 
 amString::amString
@@ -107,10 +143,189 @@ amString::amString
     size_t precision
 ) : std::string()
 {
-    std::stringstream auxStream;
-    auxStream.precision( precision );
-    auxStream << std::fixed << number;
-    assign( auxStream.str() );
+    appendNumber( number, precision );
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Append a (signed) integer in decimal notation.
+//
+// -------------------------------------------------------------------------------------------------//
+amString &amString::appendNumber
+(
+    int number
+)
+{
+    char          buffer[ C_NUMBER_BUFFER_SIZE ];
+    char         *last  = buffer + C_NUMBER_BUFFER_SIZE;
+    unsigned int  value = ( number < 0 ) ? 0U - ( unsigned int ) number : ( unsigned int ) number;
+    char         *first = uintToChars( last, value );
+    if ( number < 0 )
+    {
+        *--first = '-';
+    }
+    append( first, last - first );
+    return *this;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Append an unsigned integer in decimal notation.
+//
+// -------------------------------------------------------------------------------------------------//
+amString &amString::appendNumber
+(
+    unsigned int number
+)
+{
+    char  buffer[ C_NUMBER_BUFFER_SIZE ];
+    char *last  = buffer + C_NUMBER_BUFFER_SIZE;
+    char *first = uintToChars( last, number );
+    append( first, last - first );
+    return *this;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Append a floating point number in fixed notation with 'precision' digits after the decimal dot
+// (same result as std::fixed with std::setprecision, i.e. printf's "%.*f").
+//
+// -------------------------------------------------------------------------------------------------//
+amString &amString::appendNumber
+(
+    double number,
+    size_t precision
+)
+{
+    char buffer[ C_NUMBER_BUFFER_SIZE ];
+    int  length = -1;
+
+#if __cplusplus >= 201703L
+    std::to_chars_result result = std::to_chars( buffer, buffer + C_NUMBER_BUFFER_SIZE, number, std::chars_format::fixed, ( int ) precision );
+    if ( result.ec == std::errc() )
+    {
+        length = result.ptr - buffer;
+    }
+#else
+    length = snprintf( buffer, C_NUMBER_BUFFER_SIZE, "%.*f", ( int ) precision, number );
+    if ( length >= ( int ) C_NUMBER_BUFFER_SIZE )
+    {
+        length = -1;
+    }
+#endif
+
+    if ( length >= 0 )
+    {
+        append( buffer, length );
+    }
+    else
+    {
+        // Very large numbers or precisions.
+        std::stringstream auxStream;
+        auxStream.precision( precision );
+        auxStream << std::fixed << number;
+        append( auxStream.str() );
+    }
+    return *this;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Append the fixed point number value / 10^scaleDigits (e.g. a time in microseconds with
+// scaleDigits = 6) with 'precision' digits after the decimal dot, rounded half away from zero.
+// Digits beyond the scale are zeros.
+//
+// -------------------------------------------------------------------------------------------------//
+amString &amString::appendFixedPoint
+(
+    long long    value,
+    unsigned int scaleDigits,
+    size_t       precision
+)
+{
+    char               buffer[ C_NUMBER_BUFFER_SIZE ];
+    char              *last          = buffer + C_NUMBER_BUFFER_SIZE;
+    char              *first         = last;
+    unsigned long long magnitude     = ( value < 0 ) ? 0ULL - ( unsigned long long ) value : ( unsigned long long ) value;
+    unsigned long long fraction      = 0;
+    unsigned long long fractionScale = 1;
+    unsigned int       decimals      = ( precision < scaleDigits ) ? ( unsigned int ) precision : scaleDigits;
+
+    for ( unsigned int counter = decimals; counter < scaleDigits; ++counter )
+    {
+        fractionScale *= 10;
+    }
+    magnitude     = ( magnitude + fractionScale / 2 ) / fractionScale;
+    fractionScale = 1;
+    for ( unsigned int counter = 0; counter < decimals; ++counter )
+    {
+        fractionScale *= 10;
+    }
+
+    if ( decimals > 0 )
+    {
+        fraction = magnitude % fractionScale;
+        for ( unsigned int counter = 0; counter < decimals; ++counter )
+        {
+            *--first  = ( char ) ( '0' + fraction % 10 );
+            fraction /= 10;
+        }
+        *--first = '.';
+    }
+    first = uintToChars( first, magnitude / fractionScale );
+    if ( value < 0 )
+    {
+        *--first = '-';
+    }
+    append( first, last - first );
+
+    if ( precision > decimals )
+    {
+        if ( decimals == 0 )
+        {
+            push_back( '.' );
+        }
+        append( precision - decimals, '0' );
+    }
+    return *this;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Append a byte in hexadecimal notation (e.g. "0x0A").
+//
+// -------------------------------------------------------------------------------------------------//
+amString &amString::appendHex
+(
+    BYTE number
+)
+{
+    return appendHex( &number, 1 );
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Append 'count' bytes as one hexadecimal number (e.g. "0x0A1B" for 0x0A and 0x1B).
+//
+// -------------------------------------------------------------------------------------------------//
+amString &amString::appendHex
+(
+    const BYTE *numbers,
+    size_t      count
+)
+{
+    char   buffer[ C_NUMBER_BUFFER_SIZE ];
+    size_t length = 2;
+
+    buffer[ 0 ] = '0';
+    buffer[ 1 ] = 'x';
+    for ( size_t counter = 0; ( counter < count ) && ( length + 2 <= C_NUMBER_BUFFER_SIZE ); ++counter )
+    {
+        buffer[ length++ ] = C_HEX_DIGITS[ numbers[ counter ] >> 4 ];
+        buffer[ length++ ] = C_HEX_DIGITS[ numbers[ counter ] & 0x0F ];
+    }
+    append( buffer, length );
+    return *this;
 }
 
 amString::amString
@@ -169,34 +384,13 @@ void amString::removeFromString
     }
 }
 
+// The number tests and conversions are shared with amStringView.
 unsigned int amString::toHex
 (
     void
 ) const
 {
-    unsigned int result = 0;
-    if ( isHex() )
-    {
-        std::string::const_iterator tPtr = begin();
-        tPtr += 2;   // "0x"
-        for ( ; tPtr != end(); ++tPtr )
-        {
-            result *= 16;
-            if ( ( *tPtr >= '0' ) || ( *tPtr <= '9' ) )
-            {
-                result += ( *tPtr - '0' );
-            }
-            else if ( ( *tPtr >= 'A' ) || ( *tPtr <= 'F' ) )
-            {
-                result += ( *tPtr - 'A' + 10 );
-            }
-            else
-            {
-                result += ( *tPtr - 'a' + 10 );
-            }
-        }
-    }
-    return result;
+    return amStringView( *this ).toHex();
 }
 
 int amString::toInt
@@ -204,12 +398,7 @@ int amString::toInt
     void
 ) const
 {
-    int result = 0;
-    if ( isInteger() )
-    {
-        result = atoi( c_str() );
-    }
-    return result;
+    return amStringView( *this ).toInt();
 }
 
 unsigned int amString::toUInt
@@ -217,12 +406,7 @@ unsigned int amString::toUInt
     void
 ) const
 {
-    unsigned int result = 0;
-    if ( isUnsignedInteger() )
-    {
-        result = ( unsigned int ) atoi( c_str() );
-    }
-    return result;
+    return amStringView( *this ).toUInt();
 }
 
 double amString::toDouble
@@ -230,112 +414,63 @@ double amString::toDouble
     void
 ) const
 {
-    double result = 0;
-    if ( isDouble() )
-    {
-        result = atof( c_str() );
-    }
-    return result;
+    return amStringView( *this ).toDouble();
 }
 
-bool amString::isUnsignedInteger
+bool amString::parseInt
 (
-    void
+    int &value
 ) const
 {
-    std::string::const_iterator tPtr   = begin();
-    bool                        result = isUnsignedInteger( tPtr );
-    return result;
+    return amStringView( *this ).parseInt( value );
 }
-bool amString::isUnsignedInteger
+
+bool amString::parseUInt
 (
-    std::string::const_iterator &tPtr
+    unsigned int &value
 ) const
 {
-    bool result = false;
-    if ( tPtr != end() )
-    {
-        for ( ; ( tPtr != end() ); ++tPtr )
-        {
-            if ( ( *tPtr >= '0' ) && ( *tPtr <= '9' ) )
-            {
-                result = true;
-            }
-            else
-            {
-                break;
-            }
-        }
-    }
-    return result;
+    return amStringView( *this ).parseUInt( value );
 }
 
-bool amString::isInteger
+bool amString::parseDouble
 (
-    void
+    double &value
 ) const
 {
-    std::string::const_iterator tPtr   = begin();
-    bool                        result = isInteger( tPtr );
-    result &= ( tPtr == end() );
-    return result;
+    return amStringView( *this ).parseDouble( value );
 }
 
-bool amString::isInteger
+bool amString::parseMicroseconds
 (
-    std::string::const_iterator &tPtr
+    long long &value
 ) const
 {
-    bool result = false;
-    if ( tPtr != end() )
-    {
-        if ( ( *tPtr == '-' ) || ( *tPtr == '+' ) )
-        {
-             ++tPtr;
-        }
-        if ( tPtr != end() )
-        {
-            result = isUnsignedInteger( tPtr );
-        }
-    }
-    return result;
+    return amStringView( *this ).parseMicroseconds( value );
 }
 
-bool amString::isDouble
+bool amString::isUnsignedInteger
 (
     void
 ) const
 {
-    bool                        result = false;
-    std::string::const_iterator tPtr   = begin();
-    result = isDouble( tPtr );
-    if ( result && ( tPtr != end() ) && ( ( toupper( *tPtr ) == 'E' ) || ( toupper( *tPtr ) == 'G' ) ) )
-    {
-        ++tPtr;
-        result = isInteger( tPtr );
-    }
-    result &= ( tPtr == end() );
-    return result;
+    return amStringView( *this ).isUnsignedInteger();
+}
+
+bool amString::isInteger
+(
+    void
+) const
+{
+    return amStringView( *this ).isInteger();
 }
 
 bool amString::isDouble
 (
-    std::string::const_iterator &tPtr
+    void
 ) const
 {
-    bool result = isInteger( tPtr );
-    if ( result && ( tPtr != end() ) )
-    {
-        if ( *tPtr == '.' )
-        {
-            ++tPtr;
-            if ( tPtr != end() )
-            {
-                result = isUnsignedInteger( tPtr );
-            }
-        }
-    }
-    return result;
+    return amStringView( *this ).isDouble();
 }
 
 bool amString::isHex
@@ -343,31 +478,7 @@ bool amString::isHex
     void
 ) const
 {
-    bool                        result = false;
-    std::string::const_iterator tPtr   = begin();
-    if ( ( tPtr != end() ) && ( length() <= 10 ) ) // 0xFEDCBA98
-    {
-        if ( *tPtr == '0' )
-        {
-            ++tPtr;
-            if ( tPtr != end() )
-            {
-                if ( ( *tPtr == 'X' ) || ( *tPtr == 'x' ) )
-                {
-                    ++tPtr;
-                    if ( tPtr != end() )
-                    {
-                        result = true;
-                        for ( ; result && ( tPtr != end() ); ++tPtr )
-                        {
-                            result = ( ( ( *tPtr >= '0' ) && ( *tPtr <= '9' ) ) || ( ( *tPtr >= 'A' ) && ( *tPtr <= 'F' ) ) || ( ( *tPtr >= 'a' ) && ( *tPtr <= 'f' ) ) );
-                        }
-                    }
-                }
-            }
-        }
-    }
-    return result;
+    return amStringView( *this ).isHex();
 }
 
 void amString::toUpper
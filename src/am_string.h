@@ -10,13 +10,6 @@ const size_t C_DBL_RECISION = 6;
 class amString : public std::string
 {
 
-    private:
-
-        bool isDouble( std::string::const_iterator &tPtr ) const;
-        bool isInteger( std::string::const_iterator &tPtr ) const;
-        bool isUnsignedInteger( std::string::const_iterator &tPtr ) const;
-
-
     public:
 
         amString( void );
@@ -32,6 +25,15 @@ class amString : public std::string
         explicit amString( double number, size_t precision = C_DBL_RECISION );
         virtual ~amString( void ) {};
 
+        // Append numbers in the same format as the corresponding constructors,
+        // but without building a temporary string or stream.
+        amString &appendNumber( int number );
+        amString &appendNumber( unsigned int number );
+        amString &appendNumber( double number, size_t precision = C_DBL_RECISION );
+        amString &appendFixedPoint( long long value, unsigned int scaleDigits, size_t precision );
+        amString &appendHex   ( BYTE number );
+        amString &appendHex   ( const BYTE *numbers, size_t count );
+
         bool contains        ( char testChar ) const;
         bool contains        ( const amString &text ) const;
         bool startsWith      ( const std::string &prefix ) const;
@@ -43,6 +45,11 @@ class amString : public std::string
         double       toDouble( void ) const;
         unsigned int toHex( void ) const;
 
+        bool parseInt         ( int &value ) const;
+        bool parseUInt        ( unsigned int &value ) const;
+        bool parseDouble      ( double &value ) const;
+        bool parseMicroseconds( long long &value ) const;
+
         void toUpper( void );
         void toLower( void );
 
@@ -0,0 +1,537 @@
+#include <stdlib.h>
+#include <limits.h>
+#include <ctype.h>
+#include <math.h>
+#if __cplusplus >= 201703L
+#include <charconv>
+#endif
+
+#include "am_string_view.h"
+
+bool amStringView::equals
+(
+    const char *text,
+    size_t      length
+) const
+{
+    return ( count == length ) && ( memcmp( start, text, length ) == 0 );
+}
+
+bool amStringView::contains
+(
+    char testChar
+) const
+{
+    return ( count > 0 ) && ( memchr( start, testChar, count ) != NULL );
+}
+
+bool amStringView::contains
+(
+    const amStringView &text
+) const
+{
+    bool result = ( text.count == 0 );
+    for ( size_t position = 0; !result && ( position + text.count <= count ); ++position )
+    {
+        result = ( memcmp( start + position, text.start, text.count ) == 0 );
+    }
+    return result;
+}
+
+bool amStringView::startsWith
+(
+    const amStringView &prefix
+) const
+{
+    size_t length = ( prefix.count < count ) ? prefix.count : count;
+    return ( memcmp( start, prefix.start, length ) == 0 ) && ( prefix.count <= count );
+}
+
+bool amStringView::startsWith
+(
+    char prefix
+) const
+{
+    return ( count > 0 ) && ( start[ 0 ] == prefix );
+}
+
+unsigned int amStringView::toHex
+(
+    void
+) const
+{
+    unsigned int result = 0;
+    if ( isHex() )
+    {
+        const char *tPtr = start;
+        tPtr += 2;   // "0x"
+        for ( ; tPtr != end(); ++tPtr )
+        {
+            result *= 16;
+            if ( ( *tPtr >= '0' ) && ( *tPtr <= '9' ) )
+            {
+                result += ( *tPtr - '0' );
+            }
+            else if ( ( *tPtr >= 'A' ) && ( *tPtr <= 'F' ) )
+            {
+                result += ( *tPtr - 'A' + 10 );
+            }
+            else
+            {
+                result += ( *tPtr - 'a' + 10 );
+            }
+        }
+    }
+    return result;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Number parsing.
+// The text is scanned once, without the C library (so without locale lookups), and failures are
+// reported through the return value. The parse*() methods accept the whole text or nothing, the
+// to*() methods return 0 for invalid text and give the same results as atoi()/atof() did before.
+//
+// -------------------------------------------------------------------------------------------------//
+
+// Scan the decimal digits starting at tPtr. Values above C_MAX_SCANNED_VALUE are kept at
+// C_MAX_SCANNED_VALUE + 1, so overflow can be detected without wrapping around.
+static const unsigned long long C_MAX_SCANNED_VALUE = 0x7FFFFFFFFFFFFFFFULL;
+
+static const char *scanDigits
+(
+    const char         *tPtr,
+    const char         *last,
+    unsigned long long &value
+)
+{
+    value = 0;
+    for ( ; ( tPtr != last ) && ( *tPtr >= '0' ) && ( *tPtr <= '9' ); ++tPtr )
+    {
+        if ( value <= C_MAX_SCANNED_VALUE )
+        {
+            value = 10 * value + ( *tPtr - '0' );
+            if ( value > C_MAX_SCANNED_VALUE )
+            {
+                value = C_MAX_SCANNED_VALUE + 1;
+            }
+        }
+    }
+    return tPtr;
+}
+
+// Powers of ten which are exact doubles.
+static const double C_EXACT_POWERS_OF_10[] =
+{
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+static const int                C_MAX_EXACT_POWER_OF_10 = 22;
+static const unsigned long long C_MAX_EXACT_MANTISSA    = 1ULL << 53;
+static const unsigned long long C_MAX_SCANNED_EXPONENT  = 100000;
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Scan a floating point number "[+-]<digits>[.[<digits>]][(e|E)[+-]<digits>]" starting at first and
+// return the end of what was scanned (first if it is not a number). A dot without digits behind it
+// ends the number. mantissaEnd is set to the end of the number without the exponent.
+// The value is exact (correctly rounded) when the digits fit into a double and the power of ten is
+// exact as well, which covers the numbers written by the semi-cooked output. Anything else is
+// converted from the scanned text by std::from_chars(), which does not look at the locale; numbers
+// out of the range of a double give infinity or 0 like atof() did.
+//
+// -------------------------------------------------------------------------------------------------//
+static const char *scanDouble
+(
+    const char  *first,
+    const char  *last,
+    double      &value,
+    const char *&mantissaEnd
+)
+{
+    const char         *tPtr     = first;
+    unsigned long long  mantissa = 0;
+    int                 exponent = 0;
+    int                 nbDigits = 0;       // Significant digits of the mantissa
+    int                 hugeExp  = 0;       // Sign of an exponent too large to be added to 'exponent'
+    bool                negative = false;
+    bool                exact    = true;
+    bool                dotLast  = false;
+
+    mantissaEnd = first;
+    if ( ( tPtr != last ) && ( ( *tPtr == '-' ) || ( *tPtr == '+' ) ) )
+    {
+        negative = ( *tPtr == '-' );
+        ++tPtr;
+    }
+    if ( ( tPtr == last ) || ( *tPtr < '0' ) || ( *tPtr > '9' ) )
+    {
+        return first;
+    }
+
+    for ( ; ( tPtr != last ) && ( *tPtr >= '0' ) && ( *tPtr <= '9' ); ++tPtr )
+    {
+        nbDigits += ( ( nbDigits > 0 ) || ( *tPtr != '0' ) ) ? 1 : 0;
+        exact     = exact && ( mantissa < C_MAX_EXACT_MANTISSA / 10 );
+        mantissa  = 10 * mantissa + ( *tPtr - '0' );
+    }
+    if ( ( tPtr != last ) && ( *tPtr == '.' ) )
+    {
+        dotLast = true;
+        for ( ++tPtr; ( tPtr != last ) && ( *tPtr >= '0' ) && ( *tPtr <= '9' ); ++tPtr )
+        {
+            nbDigits += ( ( nbDigits > 0 ) || ( *tPtr != '0' ) ) ? 1 : 0;
+            exact     = exact && ( mantissa < C_MAX_EXACT_MANTISSA / 10 );
+            mantissa  = 10 * mantissa + ( *tPtr - '0' );
+            dotLast   = false;
+            --exponent;
+        }
+    }
+    mantissaEnd = tPtr;
+
+    if ( !dotLast && ( tPtr != last ) && ( ( *tPtr == 'e' ) || ( *tPtr == 'E' ) ) )
+    {
+        const char         *exponentStart = tPtr + 1;
+        unsigned long long  exponentValue = 0;
+        bool                negativeExp   = false;
+
+        if ( ( exponentStart != last ) && ( ( *exponentStart == '-' ) || ( *exponentStart == '+' ) ) )
+        {
+            negativeExp = ( *exponentStart == '-' );
+            ++exponentStart;
+        }
+        tPtr = scanDigits( exponentStart, last, exponentValue );
+        if ( tPtr == exponentStart )
+        {
+            // Not an exponent: the number ends before the 'e'.
+            tPtr = mantissaEnd;
+        }
+        else if ( exponentValue > ( unsigned long long ) C_MAX_EXACT_POWER_OF_10 )
+        {
+            exact = false;
+            if ( exponentValue < C_MAX_SCANNED_EXPONENT )
+            {
+                exponent += negativeExp ? -( int ) exponentValue : ( int ) exponentValue;
+            }
+            else
+            {
+                hugeExp = negativeExp ? -1 : 1;
+            }
+        }
+        else
+        {
+            exponent += negativeExp ? -( int ) exponentValue : ( int ) exponentValue;
+        }
+    }
+
+    if ( exact && ( exponent >= -C_MAX_EXACT_POWER_OF_10 ) && ( exponent <= C_MAX_EXACT_POWER_OF_10 ) )
+    {
+        value = ( exponent < 0 ) ? ( double ) mantissa / C_EXACT_POWERS_OF_10[ -exponent ] : ( double ) mantissa * C_EXACT_POWERS_OF_10[ exponent ];
+        value = negative ? -value : value;
+    }
+    else
+    {
+#if __cplusplus >= 201703L
+        const char *numberStart = ( *first == '+' ) ? first + 1 : first;
+        if ( std::from_chars( numberStart, tPtr, value ).ec == std::errc::result_out_of_range )
+        {
+            // Decimal exponent of the first significant digit: above 0 the number is too large.
+            bool tooLarge = ( hugeExp != 0 ) ? ( hugeExp > 0 ) : ( nbDigits - 1 + exponent > 0 );
+            value = tooLarge ? HUGE_VAL : 0.0;
+            value = negative ? -value : value;
+        }
+#else
+        std::string text( first, tPtr );
+        value = strtod( text.c_str(), NULL );
+#endif
+    }
+    return tPtr;
+}
+
+bool amStringView::parseUInt
+(
+    unsigned int &value
+) const
+{
+    unsigned long long result = 0;
+    const char        *tPtr   = scanDigits( start, end(), result );
+    bool               valid  = ( tPtr != start ) && ( tPtr == end() ) && ( result <= UINT_MAX );
+    if ( valid )
+    {
+        value = ( unsigned int ) result;
+    }
+    return valid;
+}
+
+bool amStringView::parseInt
+(
+    int &value
+) const
+{
+    unsigned long long result   = 0;
+    const char        *first    = start;
+    const char        *tPtr     = NULL;
+    bool               negative = false;
+    bool               valid    = false;
+
+    if ( ( first != end() ) && ( ( *first == '-' ) || ( *first == '+' ) ) )
+    {
+        negative = ( *first == '-' );
+        ++first;
+    }
+    tPtr  = scanDigits( first, end(), result );
+    valid = ( tPtr != first ) && ( tPtr == end() ) && ( result <= ( negative ? ( unsigned long long ) INT_MAX + 1 : ( unsigned long long ) INT_MAX ) );
+    if ( valid )
+    {
+        value = negative ? ( int ) ( 0 - result ) : ( int ) result;
+    }
+    return valid;
+}
+
+bool amStringView::parseDouble
+(
+    double &value
+) const
+{
+    double      result      = 0;
+    const char *mantissaEnd = NULL;
+    const char *tPtr        = scanDouble( start, end(), result, mantissaEnd );
+    bool        valid       = ( tPtr != start ) && ( tPtr == end() );
+    if ( valid )
+    {
+        value = result;
+    }
+    return valid;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Parse a time stamp "<seconds>[.<fraction>]" (e.g. "1461920331.123456") as a whole number of
+// microseconds. Digits of the fraction beyond the microseconds are cut off.
+//
+// -------------------------------------------------------------------------------------------------//
+bool amStringView::parseMicroseconds
+(
+    long long &value
+) const
+{
+    unsigned long long seconds      = 0;
+    long long          microseconds = 0;
+    long long          scale        = 100000;
+    const char        *tPtr         = scanDigits( start, end(), seconds );
+    bool               valid        = ( tPtr != start ) && ( seconds <= C_MAX_SCANNED_VALUE / 1000000 );
+
+    if ( valid && ( tPtr != end() ) && ( *tPtr == '.' ) )
+    {
+        for ( ++tPtr; ( tPtr != end() ) && ( *tPtr >= '0' ) && ( *tPtr <= '9' ); ++tPtr )
+        {
+            microseconds += scale * ( *tPtr - '0' );
+            scale        /= 10;
+        }
+    }
+    valid = valid && ( tPtr == end() );
+    if ( valid )
+    {
+        value = ( long long ) seconds * 1000000 + microseconds;
+    }
+    return valid;
+}
+
+// atoi() semantics: the leading sign and digits, as a long cut down to an int.
+int amStringView::toInt
+(
+    void
+) const
+{
+    unsigned long long result   = 0;
+    const char        *first    = start;
+    const char        *tPtr     = NULL;
+    bool               negative = false;
+
+    if ( ( first != end() ) && ( ( *first == '-' ) || ( *first == '+' ) ) )
+    {
+        negative = ( *first == '-' );
+        ++first;
+    }
+    tPtr = scanDigits( first, end(), result );
+    if ( ( tPtr == first ) || ( tPtr != end() ) )
+    {
+        return 0;
+    }
+    if ( negative )
+    {
+        return ( int ) ( ( result > C_MAX_SCANNED_VALUE ) ? LONG_MIN : -( long ) result );
+    }
+    return ( int ) ( ( result > C_MAX_SCANNED_VALUE ) ? LONG_MAX : ( long ) result );
+}
+
+// Like atoi(), the digits at the start of the text count, whatever follows them.
+unsigned int amStringView::toUInt
+(
+    void
+) const
+{
+    unsigned long long result = 0;
+    scanDigits( start, end(), result );
+    return ( unsigned int ) ( int ) ( ( result > C_MAX_SCANNED_VALUE ) ? LONG_MAX : ( long ) result );
+}
+
+// The exponent may also be given as 'G', which is accepted but (like atof() did) ignored.
+double amStringView::toDouble
+(
+    void
+) const
+{
+    double      result      = 0;
+    const char *mantissaEnd = NULL;
+    const char *tPtr        = scanDouble( start, end(), result, mantissaEnd );
+
+    if ( ( tPtr == mantissaEnd ) && ( tPtr != end() ) && ( ( *tPtr == 'G' ) || ( *tPtr == 'g' ) ) && ( *( tPtr - 1 ) != '.' ) )
+    {
+        tPtr = amStringView( tPtr + 1, end() - tPtr - 1 ).isInteger() ? end() : tPtr;
+    }
+    return ( ( tPtr != start ) && ( tPtr == end() ) ) ? result : 0;
+}
+
+bool amStringView::isUnsignedInteger
+(
+    void
+) const
+{
+    const char *tPtr   = start;
+    bool        result = isUnsignedInteger( tPtr );
+    return result;
+}
+
+bool amStringView::isUnsignedInteger
+(
+    const char *&tPtr
+) const
+{
+    bool result = false;
+    if ( tPtr != end() )
+    {
+        for ( ; ( tPtr != end() ); ++tPtr )
+        {
+            if ( ( *tPtr >= '0' ) && ( *tPtr <= '9' ) )
+            {
+                result = true;
+            }
+            else
+            {
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+bool amStringView::isInteger
+(
+    void
+) const
+{
+    const char *tPtr   = start;
+    bool        result = isInteger( tPtr );
+    result &= ( tPtr == end() );
+    return result;
+}
+
+bool amStringView::isInteger
+(
+    const char *&tPtr
+) const
+{
+    bool result = false;
+    if ( tPtr != end() )
+    {
+        if ( ( *tPtr == '-' ) || ( *tPtr == '+' ) )
+        {
+             ++tPtr;
+        }
+        if ( tPtr != end() )
+        {
+            result = isUnsignedInteger( tPtr );
+        }
+    }
+    return result;
+}
+
+bool amStringView::isDouble
+(
+    void
+) const
+{
+    bool        result = false;
+    const char *tPtr   = start;
+    result = isDouble( tPtr );
+    if ( result && ( tPtr != end() ) && ( ( toupper( *tPtr ) == 'E' ) || ( toupper( *tPtr ) == 'G' ) ) )
+    {
+        ++tPtr;
+        result = isInteger( tPtr );
+    }
+    result &= ( tPtr == end() );
+    return result;
+}
+
+bool amStringView::isDouble
+(
+    const char *&tPtr
+) const
+{
+    bool result = isInteger( tPtr );
+    if ( result && ( tPtr != end() ) )
+    {
+        if ( *tPtr == '.' )
+        {
+            ++tPtr;
+            if ( tPtr != end() )
+            {
+                result = isUnsignedInteger( tPtr );
+            }
+        }
+    }
+    return result;
+}
+
+bool amStringView::isHex
+(
+    void
+) const
+{
+    bool        result = false;
+    const char *tPtr   = start;
+    if ( ( tPtr != end() ) && ( count <= 10 ) ) // 0xFEDCBA98
+    {
+        if ( *tPtr == '0' )
+        {
+            ++tPtr;
+            if ( tPtr != end() )
+            {
+                if ( ( *tPtr == 'X' ) || ( *tPtr == 'x' ) )
+                {
+                    ++tPtr;
+                    if ( tPtr != end() )
+                    {
+                        result = true;
+                        for ( ; result && ( tPtr != end() ); ++tPtr )
+                        {
+                            result = ( ( ( *tPtr >= '0' ) && ( *tPtr <= '9' ) ) || ( ( *tPtr >= 'A' ) && ( *tPtr <= 'F' ) ) || ( ( *tPtr >= 'a' ) && ( *tPtr <= 'f' ) ) );
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return result;
+}
+
+std::ostream &operator<<
+(
+    std::ostream       &ostr,
+    const amStringView &text
+)
+{
+    ostr.write( text.data(), text.size() );
+    return ostr;
+}
@@ -0,0 +1,90 @@
+#ifndef __AM_STRING_VIEW_H__
+#define __AM_STRING_VIEW_H__
+
+#include <string.h>
+#include <ostream>
+
+#include "am_string.h"
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Read-only view of a sequence of characters owned by someone else (e.g. a word of a line split by
+// amSplitString). Nothing is copied or allocated; the viewed text must outlive the view.
+// The tests and conversions give the same results as the amString methods with the same names.
+//
+// -------------------------------------------------------------------------------------------------//
+class amStringView
+{
+
+    private:
+
+        const char *start;
+        size_t      count;
+
+        bool isDouble         ( const char *&tPtr ) const;
+        bool isInteger        ( const char *&tPtr ) const;
+        bool isUnsignedInteger( const char *&tPtr ) const;
+
+
+    public:
+
+        amStringView( void ) : start( "" ), count( 0 ) {}
+        amStringView( const char *text, size_t length ) : start( text ), count( length ) {}
+        amStringView( const char *text ) : start( text ), count( strlen( text ) ) {}
+        amStringView( const std::string &text ) : start( text.data() ), count( text.size() ) {}
+
+        inline const char *data  ( void ) const { return start; }
+        inline const char *begin ( void ) const { return start; }
+        inline const char *end   ( void ) const { return start + count; }
+        inline size_t      size  ( void ) const { return count; }
+        inline size_t      length( void ) const { return count; }
+        inline bool        empty ( void ) const { return count == 0; }
+
+        // Like std::string, the character right behind the text is a '\0'.
+        inline char operator[]( size_t index ) const { return ( index < count ) ? start[ index ] : '\0'; }
+
+        inline amStringView substr( size_t position, size_t length = std::string::npos ) const
+        {
+            position = ( position < count ) ? position : count;
+            return amStringView( start + position, ( length < count - position ) ? length : count - position );
+        }
+
+        inline operator amString( void ) const { return amString( std::string( start, count ) ); }
+
+        bool equals    ( const char *text, size_t length ) const;
+        bool contains  ( char testChar ) const;
+        bool contains  ( const amStringView &text ) const;
+        bool startsWith( const amStringView &prefix ) const;
+        bool startsWith( char testChar ) const;
+
+        int          toInt( void ) const;
+        unsigned int toUInt( void ) const;
+        double       toDouble( void ) const;
+        unsigned int toHex( void ) const;
+
+        // Strict conversions: the whole text must be a number in range, otherwise false is returned
+        // and value is left alone.
+        bool parseInt         ( int &value ) const;
+        bool parseUInt        ( unsigned int &value ) const;
+        bool parseDouble      ( double &value ) const;
+        bool parseMicroseconds( long long &value ) const;
+
+        bool isDouble( void ) const;
+        bool isHex( void ) const;
+        bool isInteger( void ) const;
+        bool isUnsignedInteger( void ) const;
+
+};
+
+inline bool operator==( const amStringView &left, const amStringView &right ) { return left.equals( right.data(), right.size() ); }
+inline bool operator==( const amStringView &left, const char *right )         { return left.equals( right, strlen( right ) ); }
+inline bool operator==( const amStringView &left, const std::string &right )  { return left.equals( right.data(), right.size() ); }
+inline bool operator==( const std::string &left, const amStringView &right )  { return right.equals( left.data(), left.size() ); }
+inline bool operator!=( const amStringView &left, const amStringView &right ) { return !( left == right ); }
+inline bool operator!=( const amStringView &left, const char *right )         { return !( left == right ); }
+inline bool operator!=( const amStringView &left, const std::string &right )  { return !( left == right ); }
+inline bool operator!=( const std::string &left, const amStringView &right )  { return !( left == right ); }
+
+extern std::ostream &operator<<( std::ostream &, const amStringView & );
+
+#endif // __AM_STRING_VIEW_H__
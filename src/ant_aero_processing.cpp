@@ -19,7 +19,9 @@
 antAeroProcessing::antAeroProcessing
 (
     void
-) : antProcessing()
+) : antProcessing(),
+    airSpeedMultiplierTable( sensorStates, &antSensorState::airSpeedMultiplier, SS_AIR_SPEED_MULTIPLIER ),
+    rhoCalibrationTable( sensorStates, &antSensorState::rhoCalibration, SS_RHO_CALIBRATION )
 {
     setCurrentDeviceType( "AERO" );
     resetRhoDefault();
@@ -54,13 +56,13 @@ bool antAeroProcessing::appendAeroSensor
 
         if ( rhoCalibrationTable.count( sensorID ) == 0 )
         {
-            rhoCalibrationTable.insert( std::pair<amString, double>( sensorID, 0 ) );
+            rhoCalibrationTable.insert( sensorID, 0 );
         }
         rhoCalibrationTable[ sensorID ] = calibrationRho;
 
         if ( airSpeedMultiplierTable.count( sensorID ) == 0 )
         {
-            airSpeedMultiplierTable.insert( std::pair<amString, double>( sensorID, 0 ) );
+            airSpeedMultiplierTable.insert( sensorID, 0 );
         }
         airSpeedMultiplierTable[ sensorID ] = airSpeedMultiplier;
     }
@@ -69,12 +71,12 @@ bool antAeroProcessing::appendAeroSensor
 
 double antAeroProcessing::getCalibrationRho
 (
-    const amString &sensorID
+    const antSensorHandle &sensorID
 )
 {
     if ( rhoCalibrationTable.count( sensorID ) == 0 )
     {
-        rhoCalibrationTable.insert( std::pair<amString, double>( sensorID, calibrationRhoDefault ) );
+        rhoCalibrationTable.insert( sensorID, calibrationRhoDefault );
     }
     double calibrationRho = rhoCalibrationTable[ sensorID ];
     return calibrationRho;
@@ -82,12 +84,12 @@ double antAeroProcessing::getCalibrationRho
 
 double antAeroProcessing::getAirSpeedMultiplier
 (
-    const amString &sensorID
+    const antSensorHandle &sensorID
 )
 {
     if ( airSpeedMultiplierTable.count( sensorID ) == 0 )
     {
-        airSpeedMultiplierTable.insert( std::pair<amString, double>( sensorID, airSpeedMultiplierDefault ) );
+        airSpeedMultiplierTable.insert( sensorID, airSpeedMultiplierDefault );
     }
     double airSpeedMultiplier = airSpeedMultiplierTable[ sensorID ];
     return airSpeedMultiplier;
@@ -104,55 +106,44 @@ double antAeroProcessing::getAirSpeedMultiplier
 //-------------------------------------------------------------------------------------------------//
 amDeviceType antAeroProcessing::processAeroSensor
 (
-    const amString &deviceIDNo,
+    unsigned int    deviceIDNo,
     const amString &timeStampBuffer,
     BYTE            payLoad[]
 )
 {
-    amDeviceType result      = OTHER_DEVICE;
-    amString  sensorID       = amString( C_AERO_DEVICE_HEAD ) + deviceIDNo;
-    unsigned int dataPage    = 0;
-    unsigned int airSpeedRaw = 0;
-    unsigned int yawAngleRaw = 0;
+    amDeviceType    result   = OTHER_DEVICE;
+    antSensorHandle sensorID = sensorStates.intern( C_AERO_DEVICE_HEAD, deviceIDNo );
+    unsigned int    dataPage = 0;
+    antAeroRecord   record   = antAeroRecord();
 
     if ( isRegisteredDevice( sensorID ) )
     {
-        result      = AERO_SENSOR;
-        dataPage    = byte2UInt( payLoad[ 0 ] );
-        yawAngleRaw = byte2UInt( payLoad[ 5 ], payLoad[ 4 ] );
-        airSpeedRaw = byte2UInt( payLoad[ 7 ], payLoad[ 6 ] );
+        result             = AERO_SENSOR;
+        dataPage           = byte2UInt( payLoad[ 0 ] );
+        record.yawAngleRaw = byte2UInt( payLoad[ 5 ], payLoad[ 4 ] );
+        record.airSpeedRaw = byte2UInt( payLoad[ 7 ], payLoad[ 6 ] );
 
         if ( diagnostics )
         {
             appendDiagnosticsLine( "Data Page", payLoad[ 0 ], dataPage );
-            appendDiagnosticsLine( "Raw Yaw", payLoad[ 5 ], payLoad[ 4 ], yawAngleRaw );
-            appendDiagnosticsLine( "Raw Air Speed", payLoad[ 7 ], payLoad[ 6 ], airSpeedRaw );
+            appendDiagnosticsLine( "Raw Yaw", payLoad[ 5 ], payLoad[ 4 ], record.yawAngleRaw );
+            appendDiagnosticsLine( "Raw Air Speed", payLoad[ 7 ], payLoad[ 6 ], record.airSpeedRaw );
         }
     }
 
     if ( result == AERO_SENSOR )
     {
-        double calibrationRho     = getCalibrationRho( sensorID );
-        double airSpeedMultiplier = getAirSpeedMultiplier( sensorID );
-
-        createOutputHeader( sensorID, timeStampBuffer );
-        createAEROResultString( airSpeedRaw, yawAngleRaw, calibrationRho, airSpeedMultiplier, rho );
-        appendOutputFooter( getVersion() );
+        outputAeroRecord( sensorID, timeStampBuffer, getVersion(), record );
     }
 
     if ( result == OTHER_DEVICE )
     {
         bool commonPage   = false;
         bool outputPageNo = true;
-        createOutputHeader( sensorID, timeStampBuffer );
         if ( commonPage )
         {
-            commonPage = processCommonPages( sensorID, payLoad, outputPageNo );
-            if ( commonPage )
-            {
-                appendOutputFooter( getVersion() );
-            }
-            else
+            commonPage = processCommonPages( sensorID, timeStampBuffer, getVersion(), payLoad, outputPageNo );
+            if ( !commonPage )
             {
                 result = OTHER_DEVICE;
             }
@@ -162,7 +153,7 @@ amDeviceType antAeroProcessing::processAeroSensor
             resetOutBuffer();
             if ( outputUnknown )
             {
-                int deviceIDNoAsInt = deviceIDNo.toInt();
+                int deviceIDNoAsInt = ( int ) deviceIDNo;
                 createUnknownDeviceTypeString( C_AERO_TYPE, deviceIDNoAsInt, timeStampBuffer, payLoad );
             }
         }
@@ -190,16 +181,15 @@ amDeviceType antAeroProcessing::processAeroSensorSemiCooked
     {
         amSplitString words;
         unsigned int  nbWords      = words.split( inputBuffer );
-        unsigned int  airSpeedRaw  = 0;
-        unsigned int  yawAngleRaw  = 0;
         unsigned int  counter      = 0;
         unsigned int  startCounter = 0;
         bool          commonPage   = false;
         bool          outputPageNo = true;
-        amString   curVersion      = getVersion();
-        amString   sensorID;
-        amString   timeStampBuffer;
-        amString   semiCookedString;
+        antAeroRecord record       = antAeroRecord();
+        amString      curVersion   = getVersion();
+        amString      sensorID;
+        amString      timeStampBuffer;
+        amString      semiCookedString;
 
         if ( nbWords > 4 )
         {
@@ -214,14 +204,14 @@ amDeviceType antAeroProcessing::processAeroSensorSemiCooked
             }
             if ( isRegisteredDevice( sensorID ) && ( semiCookedString == C_SEMI_COOKED_SYMBOL_AS_STRING ) && isAeroSensor( sensorID ) )
             {
-                startCounter = counter;
-                result       = AERO_SENSOR;
-                airSpeedRaw  = ( unsigned int ) words[ counter++ ].toInt();          // 3
-                yawAngleRaw  = ( unsigned int ) words[ counter++ ].toInt();          // 4
+                startCounter       = counter;
+                result             = AERO_SENSOR;
+                record.airSpeedRaw = ( unsigned int ) words[ counter++ ].toInt();    // 3
+                record.yawAngleRaw = ( unsigned int ) words[ counter++ ].toInt();    // 4
                 if ( diagnostics )
                 {
-                    appendDiagnosticsLine( "Raw Air Speed", airSpeedRaw );
-                    appendDiagnosticsLine( "Raw Yaw Angle (signed)", yawAngleRaw );
+                    appendDiagnosticsLine( "Raw Air Speed", record.airSpeedRaw );
+                    appendDiagnosticsLine( "Raw Yaw Angle (signed)", record.yawAngleRaw );
                 }
             }
         }
@@ -236,13 +226,9 @@ amDeviceType antAeroProcessing::processAeroSensorSemiCooked
                     appendDiagnosticsLine( "Version", curVersion );
                 }
             }
-            double calibrationRho     = getCalibrationRho( sensorID );
-            double airSpeedMultiplier = getAirSpeedMultiplier( sensorID );
-
-            createOutputHeader( sensorID, timeStampBuffer );
             if ( commonPage )
             {
-                commonPage = processCommonPagesSemiCooked( words, startCounter, outputPageNo );
+                commonPage = processCommonPagesSemiCooked( words, startCounter, curVersion, outputPageNo );
                 if ( !commonPage )
                 {
                     result = OTHER_DEVICE;
@@ -250,9 +236,8 @@ amDeviceType antAeroProcessing::processAeroSensorSemiCooked
             }
             else
             {
-                createAEROResultString( airSpeedRaw, yawAngleRaw, calibrationRho, airSpeedMultiplier, rho );
+                outputAeroRecord( sensorID, timeStampBuffer, curVersion, record );
             }
-            appendOutputFooter( curVersion );
         }
         else
         {
@@ -276,7 +261,7 @@ amDeviceType antAeroProcessing::processAeroSensorSemiCooked
 //
 // Parameters:
 //    int             deviceType        IN   Device type (SPCAD, SPEED, CADENCE, HRM, AERO, POWER).
-//    const amString &deviceID          IN   Device ID (number).
+//    unsigned int    deviceID          IN   Device ID (number).
 //    const amString &timeStampBuffer   IN   Time stamp.
 //    BYTE            payLoad[]         IN   Array of bytes with the data to be converted.
 //
@@ -288,7 +273,7 @@ amDeviceType antAeroProcessing::processAeroSensorSemiCooked
 amDeviceType antAeroProcessing::processSensor
 (
     int             deviceType,
-    const amString &deviceIDNo,
+    unsigned int    deviceIDNo,
     const amString &timeStampBuffer,
     BYTE            payLoad[]
 )
@@ -301,7 +286,7 @@ amDeviceType antAeroProcessing::processSensor
     }
     else if ( outputUnknown )
     {
-        int deviceIDNoAsInt = deviceIDNo.toInt();
+        int deviceIDNoAsInt = ( int ) deviceIDNo;
         createUnknownDeviceTypeString( deviceType, deviceIDNoAsInt, timeStampBuffer, payLoad );
     }
     else
@@ -359,8 +344,8 @@ void antAeroProcessing::setRho
 
 bool antAeroProcessing::setCalibrationRho
 (
-    const amString &sensorID,
-    double          value
+    const antSensorHandle &sensorID,
+    double                 value
 )
 {
     bool result = ( rhoCalibrationTable.count( sensorID ) > 0 );
@@ -373,8 +358,8 @@ bool antAeroProcessing::setCalibrationRho
 
 bool antAeroProcessing::setAirSpeedMultiplier
 (
-    const amString &sensorID,
-    double          value
+    const antSensorHandle &sensorID,
+    double                 value
 )
 {
     bool result = ( airSpeedMultiplierTable.count( sensorID ) > 0 );
@@ -590,7 +575,7 @@ double antAeroProcessing::computeAirSpeed
 
 double antAeroProcessing::getCorrectionFactor
 (
-    const amString &sensorID
+    const antSensorHandle &sensorID
 )
 {
     double correctionFactor = 1.0;
@@ -610,48 +595,23 @@ double antAeroProcessing::getCorrectionFactor
     return correctionFactor;
 }
 
-void antAeroProcessing::createAEROResultString
+void antAeroProcessing::outputAeroRecord
 (
-    unsigned int airSpeedRaw,
-    unsigned int yawAngleRaw,
-    double       calibrationRho,
-    double       airSpeedMultiplier,
-    double       currentRho
+    const antSensorHandle &sensorID,
+    const amString        &timeStampBuffer,
+    const amString        &versionString,
+    antAeroRecord         &record
 )
 {
-    if ( semiCookedOut )
+    record.calibrationRho     = getCalibrationRho( sensorID );
+    record.airSpeedMultiplier = getAirSpeedMultiplier( sensorID );
+    record.currentRho         = rho;
+    if ( !semiCookedOut )
     {
-        if ( outputAsJSON )
-        {
-            appendJSONItem( "raw air speed", airSpeedRaw );
-            appendJSONItem( "raw yaw angle", yawAngleRaw );
-        }
-        else
-        {
-            appendOutput( airSpeedRaw );
-            appendOutput( yawAngleRaw );
-        }
-    }
-    else
-    {
-        double airSpeed = computeAirSpeed( airSpeedRaw, calibrationRho, airSpeedMultiplier, currentRho );
-        double yawAngle = computeYawAngle( yawAngleRaw );
-        if ( outputAsJSON )
-        {
-            appendJSONItem( "air speed",               airSpeed,           getValuePrecision() );
-            appendJSONItem( "yaw angle",               yawAngle,           getValuePrecision() );
-            appendJSONItem( "calibration air density", calibrationRho,     getValuePrecision() );
-            appendJSONItem( "air speed multiplier",    airSpeedMultiplier, getValuePrecision() );
-            appendJSONItem( "current air density",     currentRho,         getValuePrecision() );
-        }
-        else
-        {
-            appendOutput( airSpeed,           getValuePrecision() );
-            appendOutput( yawAngle,           getValuePrecision() );
-            appendOutput( calibrationRho,     getValuePrecision() );
-            appendOutput( airSpeedMultiplier, getValuePrecision() );
-            appendOutput( currentRho,         getValuePrecision() );
-        }
+        record.airSpeed = computeAirSpeed( record.airSpeedRaw, record.calibrationRho, record.airSpeedMultiplier, record.currentRho );
+        record.yawAngle = computeYawAngle( record.yawAngleRaw );
     }
+
+    outputRecord( antRecordContext( sensorID, timeStampBuffer, versionString ), record );
 }
 
@@ -13,8 +13,8 @@ class antAeroProcessing : virtual public antProcessing
         double airSpeedMultiplierDefault;
         double calibrationRhoDefault;
 
-        std::map<amString, double> airSpeedMultiplierTable;
-        std::map<amString, double> rhoCalibrationTable;
+        antSensorField<double> airSpeedMultiplierTable;
+        antSensorField<double> rhoCalibrationTable;
 
         void   resetRhoDefault               ( void ) { rhoDefault                = C_RHO_DEFAULT; }
         void   resetCalibrationRhoDefault    ( void ) { calibrationRhoDefault     = C_CALIBRATION_RHO_DEFAULT; }
@@ -23,7 +23,7 @@ class antAeroProcessing : virtual public antProcessing
         double computeYawAngle( int yawAngleSignedRaw );
         double computeAirSpeed( unsigned int airSpeedUnsignedRaw, double calibrationRho, double airSpeedMultiplier, double currentRho );
         double computeAirSpeed( int airSpeedSignedRaw, double calibrationRho, double airSpeedMultiplier, double currentRho );
-        double getCorrectionFactor( const amString &sensorID );
+        double getCorrectionFactor( const antSensorHandle &sensorID );
 
 
     protected:
@@ -31,11 +31,13 @@ class antAeroProcessing : virtual public antProcessing
         double convertAirspeed( int );
         double convertYaw( int, int );
 
-        amDeviceType processAeroSensor( const amString &deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
+        amDeviceType processAeroSensor( unsigned int deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
         amDeviceType processAeroSensorSemiCooked( const amString &inputBuffer );
 
-        double getCalibrationRho( const amString &sensorID );
-        double getAirSpeedMultiplier( const amString &sensorID );
+        double getCalibrationRho( const antSensorHandle &sensorID );
+        double getAirSpeedMultiplier( const antSensorHandle &sensorID );
+
+        void outputAeroRecord( const antSensorHandle &sensorID, const amString &timeStampBuffer, const amString &versionString, antAeroRecord &record );
 
         virtual void readDeviceFileLine( const char *line );
 
@@ -52,17 +54,16 @@ class antAeroProcessing : virtual public antProcessing
         void setRho( double value );
         void setRhoDefault( double value ) { rhoDefault = value; }
 
-        bool setCalibrationRho( const amString &sensorID, double value );
+        bool setCalibrationRho( const antSensorHandle &sensorID, double value );
         void setCalibrationRhoDefault( double value ) { calibrationRhoDefault = value; }
 
-        bool setAirSpeedMultiplier( const amString &sensorID, double value );
+        bool setAirSpeedMultiplier( const antSensorHandle &sensorID, double value );
         void setAirSpeedMultiplierDefault( double value ) { airSpeedMultiplierDefault = value; }
 
-        void createAEROResultString( unsigned int airSpeedRaw, unsigned int yawAngleRaw, double calibrationRho, double airSpeedMultiplier, double currentRho );
-
-        virtual amDeviceType processSensor( int deviceType, const amString &deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
+        virtual amDeviceType processSensor( int deviceType, unsigned int deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
         virtual amDeviceType processSensorSemiCooked( const amString &inputBuffer );
         virtual void reset( void );
+        virtual antProcessing *createWorker( void ) const { return new antAeroProcessing; }
 
 };
 
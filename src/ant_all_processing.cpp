@@ -33,6 +33,7 @@ antAllProcessing::antAllProcessing
     antSpeedOnlyProcessing()
 {
     setCurrentDeviceType( "ALL" );
+    getDispatch();
     reset();
 }
 
@@ -130,7 +131,7 @@ void antAllProcessing::readDeviceFileLine
 //
 // Parameters:
 //    int             deviceType        IN   Device type (SPCAD, SPEED, CADENCE, HRM, AERO, POWER).
-//    const amString &deviceID          IN   Device ID (number).
+//    unsigned int    deviceID          IN   Device ID (number).
 //    const amString &timeStampBuffer   IN   Time stamp.
 //    BYTE            payLoad[]         IN   Array of bytes with the data to be converted.
 //
@@ -142,50 +143,26 @@ void antAllProcessing::readDeviceFileLine
 amDeviceType antAllProcessing::processSensor
 (
     int             deviceType,
-    const amString &deviceIDNo,
+    unsigned int    deviceIDNo,
     const amString &timeStampBuffer,
     BYTE            payLoad[]
 )
 {
-    amDeviceType result = OTHER_DEVICE;
+    amDeviceType                                     result  = OTHER_DEVICE;
+    antDeviceDispatch<antAllProcessing>::binaryHandler handler = getDispatch().getHandler( deviceType );
 
-    switch ( deviceType )
+    if ( handler != NULL )
+    {
+        result = handler( *this, deviceType, deviceIDNo, timeStampBuffer, payLoad );
+    }
+    else if ( outputUnknown )
+    {
+        int deviceIDNoAsInt = ( int ) deviceIDNo;
+        createUnknownDeviceTypeString( deviceType, deviceIDNoAsInt, timeStampBuffer, payLoad );
+    }
+    else
     {
-        case C_AERO_TYPE  : result = antAeroProcessing::processSensor( deviceType, deviceIDNo, timeStampBuffer, payLoad );
-                            break;
-        case C_AUDIO_TYPE : result = antAudioProcessing::processSensor( deviceType, deviceIDNo, timeStampBuffer, payLoad );
-                            break;
-        case C_BLDPR_TYPE : result = antBloodPressureProcessing::processSensor( deviceType, deviceIDNo, timeStampBuffer, payLoad );
-                            break;
-        case C_CAD_TYPE   : result = antCadenceOnlyProcessing::processSensor( deviceType, deviceIDNo, timeStampBuffer, payLoad );
-                            break;
-        case C_ENV_TYPE   : result = antEnvironmentProcessing::processSensor( deviceType, deviceIDNo, timeStampBuffer, payLoad );
-                            break;
-        case C_HRM_TYPE   : result = antHRMProcessing::processSensor( deviceType, deviceIDNo, timeStampBuffer, payLoad );
-                            break;
-        case C_MSSDM_TYPE : result = antMultiSportProcessing::processSensor( deviceType, deviceIDNo, timeStampBuffer, payLoad );
-                            break;
-        case C_POWER_TYPE : result = antPowerProcessing::processSensor( deviceType, deviceIDNo, timeStampBuffer, payLoad );
-                            break;
-        case C_SBSDM_TYPE : result = antStrideSpeedDistProcessing::processSensor( deviceType, deviceIDNo, timeStampBuffer, payLoad );
-                            break;
-        case C_SPCAD_TYPE : result = antSpcadProcessing::processSensor( deviceType, deviceIDNo, timeStampBuffer, payLoad );
-                            break;
-        case C_SPEED_TYPE : result = antSpeedOnlyProcessing::processSensor( deviceType, deviceIDNo, timeStampBuffer, payLoad );
-                            break;
-        case C_WEIGHT_TYPE: result = antWeightProcessing::processSensor( deviceType, deviceIDNo, timeStampBuffer, payLoad );
-                            break;
-        default           : result = OTHER_DEVICE;
-                            if ( outputUnknown )
-                            {
-                                int deviceIDNoAsInt = deviceIDNo.toInt();
-                                createUnknownDeviceTypeString( deviceType, deviceIDNoAsInt, timeStampBuffer, payLoad );
-                            }
-                            else
-                            {
-                                resetOutBuffer();
-                            }
-                            break;
+        resetOutBuffer();
     }
 
     return result;
@@ -200,82 +177,10 @@ amDeviceType antAllProcessing::processSensorSemiCooked
 
     if ( !inputBuffer.empty() )
     {
-        switch ( inputBuffer[ 0 ] )
+        antDeviceDispatch<antAllProcessing>::semiCookedHandler handler = getDispatch().getHandler( inputBuffer.c_str(), inputBuffer.size() );
+        if ( handler != NULL )
         {
-            case 'A': // Aero Sensor  or  Audio Control
-                      if ( isAeroSensor( inputBuffer ) )
-                      {
-                          result = antAeroProcessing::processSensorSemiCooked( inputBuffer );
-                      }
-                      else if ( isAudioSensor( inputBuffer ) )
-                      {
-                          result = antAudioProcessing::processSensorSemiCooked( inputBuffer );
-                      }
-                      break;
-            case 'B': // Blood Pressure Sensor or Bridge
-                      if ( isBloodPressureSensor( inputBuffer ) )
-                      {
-                          result = antBloodPressureProcessing::processSensorSemiCooked( inputBuffer );
-                      }
-                      break;
-            case 'C': // Cadence-Only Sensor
-                      if ( isCadenceOnlySensor( inputBuffer ) )
-                      {
-                          result = antCadenceOnlyProcessing::processSensorSemiCooked( inputBuffer );
-                      }
-                      break;
-            case 'E': // Environmental Sensor
-                      if ( isEnvironmentSensor( inputBuffer ) )
-                      {
-                          result = antEnvironmentProcessing::processSensorSemiCooked( inputBuffer );
-                      }
-                      break;
-            case 'H': // Heart Rate Sensor
-                      if ( isHeartRateSensor( inputBuffer ) )
-                      {
-                          result = antHRMProcessing::processSensorSemiCooked( inputBuffer );
-                      }
-                      break;
-            case 'M': // Multi-Sports Speed and Distance Sensor
-                      if ( isMultiSportSensor( inputBuffer ) )
-                      {
-                          result = antMultiSportProcessing::processSensorSemiCooked( inputBuffer );
-                      }
-                      break;
-            case 'P': // Power Meter or Power Meter Related Message
-                      if ( isPowerMeterRelated( inputBuffer ) )
-                      {
-                          result = antPowerProcessing::processSensorSemiCooked( inputBuffer );
-                      }
-                      break;
-            case 'S': // Speed-and-Candence Sensor  or  Speed-Only Sensor  or  Stride-Based Speed-and-Distance Sensor
-                      if ( isSpeedAndCadenceSensor( inputBuffer ) )
-                      {
-                          result = antSpcadProcessing::processSensorSemiCooked( inputBuffer );
-                      }
-                      else if ( isSpeedOnlySensor( inputBuffer ) )
-                      {
-                          result = antSpeedOnlyProcessing::processSensorSemiCooked( inputBuffer );
-                      }
-                      else if ( isStrideSpeedSensor( inputBuffer ) )
-                      {
-                          result = antStrideSpeedDistProcessing::processSensorSemiCooked( inputBuffer );
-                      }
-                      break;
-            case 'T': // Previously unrecognized Sensor Type
-                      if ( inputBuffer.startsWith( C_UNKNOWN_TYPE_HEAD ) )
-                      {
-                          result = processUndefinedSensorType( inputBuffer );
-                      }
-                      break;
-            case 'W': // Weight Scale
-                      if ( isWeightScaleSensor( inputBuffer ) )
-                      {
-                          result = antWeightProcessing::processSensorSemiCooked( inputBuffer );
-                      }
-                      break;
-            default : // Unrecognized Sensor Type
-                      break;
+            result = handler( *this, inputBuffer );
         }
 
         if ( result == OTHER_DEVICE )
@@ -291,6 +196,59 @@ amDeviceType antAllProcessing::processSensorSemiCooked
     return result;
 }
 
+//---------------------------------------------------------------------------------------------------
+//
+// createDispatch
+//
+// Build the device type dispatch table of all profiles.
+// A new profile registers its device type and the head(s) of its semi-cooked sensor IDs here.
+//
+//---------------------------------------------------------------------------------------------------
+antDeviceDispatch<antAllProcessing> antAllProcessing::createDispatch
+(
+    void
+)
+{
+    antDeviceDispatch<antAllProcessing> dispatch;
+
+    dispatch.addProfile<antAeroProcessing>           ( C_AERO_TYPE,   C_AERO_DEVICE_HEAD     );
+    dispatch.addProfile<antAudioProcessing>          ( C_AUDIO_TYPE,  C_AUDIO_DEVICE_HEAD    );
+    dispatch.addProfile<antBloodPressureProcessing>  ( C_BLDPR_TYPE,  C_BLDPR_DEVICE_HEAD    );
+    dispatch.addProfile<antCadenceOnlyProcessing>    ( C_CAD_TYPE,    C_CAD_DEVICE_HEAD      );
+    dispatch.addProfile<antEnvironmentProcessing>    ( C_ENV_TYPE,    C_ENV_DEVICE_HEAD      );
+    dispatch.addProfile<antHRMProcessing>            ( C_HRM_TYPE,    C_HEART_RATE_DEVICE_ID );
+    dispatch.addProfile<antMultiSportProcessing>     ( C_MSSDM_TYPE,  C_MSSDM_DEVICE_HEAD    );
+    dispatch.addProfile<antPowerProcessing>          ( C_POWER_TYPE,  C_POWER_DEVICE_HEAD    );
+    dispatch.addProfile<antSpcadProcessing>          ( C_SPCAD_TYPE,  C_SPCAD_DEVICE_HEAD    );
+    dispatch.addProfile<antSpeedOnlyProcessing>      ( C_SPEED_TYPE,  C_SPEED_DEVICE_HEAD    );
+    dispatch.addProfile<antStrideSpeedDistProcessing>( C_SBSDM_TYPE,  C_SBSDM_DEVICE_HEAD    );
+    dispatch.addProfile<antWeightProcessing>         ( C_WEIGHT_TYPE, C_WEIGHT_DEVICE_HEAD   );
+
+    dispatch.addHead( C_SPEED_OBSOLETE_HEAD, antDispatchSensorSemiCooked<antAllProcessing, antSpeedOnlyProcessing> );
+    dispatch.addHead( C_UNKNOWN_TYPE_HEAD,   dispatchUndefinedSensorType );
+
+    return dispatch;
+}
+
+// The table is shared by all processors (and decode threads) and never changes once it is built.
+const antDeviceDispatch<antAllProcessing> &antAllProcessing::getDispatch
+(
+    void
+)
+{
+    static const antDeviceDispatch<antAllProcessing> dispatch = createDispatch();
+    return dispatch;
+}
+
+amDeviceType antAllProcessing::dispatchUndefinedSensorType
+(
+    antAllProcessing &processor,
+    const amString   &inputBuffer
+)
+{
+    return processor.processUndefinedSensorType( inputBuffer );
+}
+
 // ------------------------------------------------------------------------------------------------------
 //
 // processUndefinedSensorType
@@ -384,7 +342,7 @@ amDeviceType antAllProcessing::processUndefinedSensorType
                 appendDiagnosticsLine( "payLoad", counter, payLoad[ counter ] );
             }
         }
-        result = processSensor( deviceType, deviceIDNo, timeStampBuffer, payLoad );
+        result = processSensor( deviceType, deviceIDNo.toUInt(), timeStampBuffer, payLoad );
     }
     else
     {
@@ -2,6 +2,7 @@
 #define __ANT_ALL_PROCESSING_H__
 
 #include "ant_processing.h"
+#include "ant_device_dispatch.h"
 #include "ant_all_processing.h"
 #include "ant_hrm_processing.h"
 #include "ant_aero_processing.h"
@@ -38,6 +39,10 @@ class antAllProcessing : virtual public antAeroProcessing,
 
         amDeviceType processUndefinedSensorType( const amString &inputBuffer );
 
+        static amDeviceType dispatchUndefinedSensorType( antAllProcessing &processor, const amString &inputBuffer );
+        static antDeviceDispatch<antAllProcessing> createDispatch( void );
+        static const antDeviceDispatch<antAllProcessing> &getDispatch( void );
+
 
     public:
 
@@ -46,12 +51,13 @@ class antAllProcessing : virtual public antAeroProcessing,
 
         virtual void readDeviceFileLine( const char *line );
 
-        amDeviceType processSensor( int deviceType, const amString &deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
+        amDeviceType processSensor( int deviceType, unsigned int deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
         amDeviceType processSensorSemiCooked( const amString &inputBuffer );
 
         amDeviceType updateSensorSemiCooked( const amString &inputBuffer );
 
         virtual void reset( void );
+        virtual antProcessing *createWorker( void ) const { return new antAllProcessing; }
 
 };
 
@@ -0,0 +1,595 @@
+// -------------------------------------------------------------------------------------------------//
+//
+// Heap allocation check of the decoder (make alloc-check).
+// Replaces the global operator new and delete and, with glibc, malloc(), calloc(), realloc() and
+// free() by versions which count the allocations and the bytes allocated while a packet is
+// decoded. The packets of an ANT+ capture file are decoded in-process, packet by packet, through
+// antProcessing::decodeFrame() (i.e. ant2txtLine()) in every output mode, and the counts are
+// reported per packet, by device type and output mode.
+//
+// The file is decoded twice by the same processor: the first (cold) pass includes the allocations
+// made for the state of sensors seen for the first time, the second (warm) pass shows what every
+// packet of a known sensor costs. With a budget file (-b) the warm pass is checked against it, the
+// exit code is 1 if any profile allocates more than its budget.
+//
+// Budget file: one budget per line, "<profile> <mode> <allocations per packet> <bytes per packet>",
+// '*' matches all profiles or modes, every matching line is checked. '#' starts a comment.
+//
+// -------------------------------------------------------------------------------------------------//
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "ant_all_processing.h"
+
+const char         C_ALLOC_PROGRAM_NAME[]    = "ant2txt_alloc_check";
+const char         C_ALLOC_OPTION_STRING[]   = "b:f:ho:";
+const char         C_ALLOC_DEFAULT_FILE[]    = "../test/testfile.ant";
+const long long    C_ALLOC_START_TIME        = 1500000000000000LL;   // Receive time of the first packet (us).
+const long long    C_ALLOC_PACKET_PERIOD     = 100000;               // Like the test mode (-x): 0.1 s per packet.
+const int          C_ALLOC_PAYLOAD_OFFSET    = 7;                    // Of the payload in an 'A','N' frame.
+const char         C_ALLOC_ALL[]             = "*";
+const char         C_ALLOC_BRIDGE_PROFILE[]  = "bridge";
+const char         C_ALLOC_OTHER_PROFILE[]   = "other";
+const char         C_ALLOC_UNKNOWN_PROFILE[] = "unknown";
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Allocation counters. Only allocations made while 'countAllocations' is set are counted (the
+// harness is single threaded, the processor runs without threads).
+//
+// -------------------------------------------------------------------------------------------------//
+static bool               countAllocations = false;
+static unsigned long long nbAllocations    = 0;
+static unsigned long long nbBytesAllocated = 0;
+
+static inline void countAllocation
+(
+    size_t size
+)
+{
+    if ( countAllocations )
+    {
+        ++nbAllocations;
+        nbBytesAllocated += size;
+    }
+}
+
+#ifdef __GLIBC__
+extern "C"
+{
+    void *__libc_malloc ( size_t size );
+    void *__libc_calloc ( size_t count, size_t size );
+    void *__libc_realloc( void *pointer, size_t size );
+    void  __libc_free   ( void *pointer );
+
+    void *malloc
+    (
+        size_t size
+    )
+    {
+        countAllocation( size );
+        return __libc_malloc( size );
+    }
+
+    void *calloc
+    (
+        size_t count,
+        size_t size
+    )
+    {
+        countAllocation( count * size );
+        return __libc_calloc( count, size );
+    }
+
+    void *realloc
+    (
+        void   *pointer,
+        size_t  size
+    )
+    {
+        countAllocation( size );
+        return __libc_realloc( pointer, size );
+    }
+
+    void free
+    (
+        void *pointer
+    )
+    {
+        __libc_free( pointer );
+    }
+}
+#define ALLOC_RAW_MALLOC __libc_malloc
+#define ALLOC_RAW_FREE   __libc_free
+#else
+// Without glibc only operator new is counted.
+#define ALLOC_RAW_MALLOC std::malloc
+#define ALLOC_RAW_FREE   std::free
+#endif
+
+static void *allocate
+(
+    size_t size
+)
+{
+    void *pointer = NULL;
+
+    countAllocation( size );
+    pointer = ALLOC_RAW_MALLOC( ( size == 0 ) ? 1 : size );
+    if ( pointer == NULL )
+    {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void *operator new
+(
+    size_t size
+)
+{
+    return allocate( size );
+}
+
+void *operator new[]
+(
+    size_t size
+)
+{
+    return allocate( size );
+}
+
+void operator delete
+(
+    void *pointer
+) throw()
+{
+    ALLOC_RAW_FREE( pointer );
+}
+
+void operator delete[]
+(
+    void *pointer
+) throw()
+{
+    ALLOC_RAW_FREE( pointer );
+}
+
+enum allocMode
+{
+    ALLOC_SEMI_COOKED,
+    ALLOC_COOKED,
+    ALLOC_JSON,
+    ALLOC_RAW,
+    ALLOC_DIAGNOSTICS
+};
+
+const char  *C_ALLOC_MODE_NAMES[] = { "semi", "cooked", "json", "raw", "diag" };
+const size_t C_NB_ALLOC_MODES     = sizeof( C_ALLOC_MODE_NAMES ) / sizeof( C_ALLOC_MODE_NAMES[ 0 ] );
+
+struct allocProfile
+{
+    const char *name;
+    BYTE        deviceType;
+};
+
+// Same names as the profiles of the benchmark (ant2txt_bench).
+static const allocProfile C_ALLOC_PROFILES[] =
+{
+    { "power",   C_POWER_TYPE  },
+    { "hrm",     C_HRM_TYPE    },
+    { "spcad",   C_SPCAD_TYPE  },
+    { "speed",   C_SPEED_TYPE  },
+    { "cadence", C_CAD_TYPE    },
+    { "sbsdm",   C_SBSDM_TYPE  },
+    { "aero",    C_AERO_TYPE   },
+    { "mssdm",   C_MSSDM_TYPE  },
+    { "audio",   C_AUDIO_TYPE  },
+    { "bldpr",   C_BLDPR_TYPE  },
+    { "env",     C_ENV_TYPE    },
+    { "weight",  C_WEIGHT_TYPE }
+};
+
+const size_t C_NB_ALLOC_PROFILES = sizeof( C_ALLOC_PROFILES ) / sizeof( C_ALLOC_PROFILES[ 0 ] );
+
+struct allocFrame
+{
+    size_t       start;
+    int          nbBytes;
+    std::string  profile;
+};
+
+struct allocCounts
+{
+    unsigned long long nbPackets;
+    unsigned long long nbAllocations;
+    unsigned long long nbBytes;
+    unsigned long long maxAllocations;   // Most allocations of a single packet.
+};
+
+struct allocResult
+{
+    std::string profile;
+    allocCounts passes[ 2 ];             // Cold and warm pass.
+};
+
+struct allocBudget
+{
+    std::string profile;
+    std::string mode;
+    double      maxAllocations;          // Per packet.
+    double      maxBytes;                // Per packet.
+};
+
+// -------------------------------------------------------------------------------------------------//
+//
+// The profile a frame is counted under: the device type of ANT+ broadcasts with an extended
+// message flag (like antDecodePipeline::dispatchFrame() finds it), "bridge" for the query
+// responses of the bridges, "other" for everything else.
+//
+// -------------------------------------------------------------------------------------------------//
+static std::string getFrameProfile
+(
+    const BYTE *line,
+    int         nbBytes
+)
+{
+    int payLoadSize = nbBytes - C_ALLOC_PAYLOAD_OFFSET;
+    int flagOffset  = 0;
+
+    if ( ( nbBytes > 2 ) && ( line[ 2 ] == C_QUERY_RESP ) )
+    {
+        return C_ALLOC_BRIDGE_PROFILE;
+    }
+    payLoadSize = ( payLoadSize < 0 ) ? 0 : ( ( payLoadSize > C_ANT_PAY_LOAD_COUNT ) ? C_ANT_PAY_LOAD_COUNT : payLoadSize );
+    flagOffset  = C_ALLOC_PAYLOAD_OFFSET + payLoadSize;
+    if ( ( nbBytes > flagOffset + 3 ) && ( line[ 2 ] == C_ANT_ASYNC_MSG ) && ( ( line[ flagOffset ] & 0x80 ) != 0 ) )
+    {
+        for ( size_t counter = 0; counter < C_NB_ALLOC_PROFILES; ++counter )
+        {
+            if ( C_ALLOC_PROFILES[ counter ].deviceType == line[ flagOffset + 3 ] )
+            {
+                return C_ALLOC_PROFILES[ counter ].name;
+            }
+        }
+        return C_ALLOC_UNKNOWN_PROFILE;
+    }
+    return C_ALLOC_OTHER_PROFILE;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Read a capture file and split it into frames like antProcessing::readAntFromBuffer() does: a
+// frame starts with 'A','N' and ends where the next 'A','N' starts.
+//
+// -------------------------------------------------------------------------------------------------//
+static bool readFrames
+(
+    const std::string       &fileName,
+    std::vector<BYTE>       &data,
+    std::vector<allocFrame> &frames
+)
+{
+    std::ifstream inStream( fileName.c_str(), std::ios::in | std::ios::binary );
+    size_t        position = 0;
+    size_t        next     = 0;
+    allocFrame    frame;
+
+    if ( !inStream.is_open() )
+    {
+        return false;
+    }
+    data.assign( std::istreambuf_iterator<char>( inStream ), std::istreambuf_iterator<char>() );
+
+    while ( ( position + 1 < data.size() ) && !( ( data[ position ] == 'A' ) && ( data[ position + 1 ] == 'N' ) ) )
+    {
+        ++position;
+    }
+    while ( position + 1 < data.size() )
+    {
+        next = position + 2;
+        while ( ( next + 1 < data.size() ) && !( ( data[ next ] == 'A' ) && ( data[ next + 1 ] == 'N' ) ) )
+        {
+            ++next;
+        }
+        if ( next + 1 >= data.size() )
+        {
+            next = data.size();
+        }
+        if ( next - position < ( size_t ) C_BUFFER_SIZE )
+        {
+            frame.start   = position;
+            frame.nbBytes = next - position;
+            frame.profile = getFrameProfile( &( data[ position ] ), frame.nbBytes );
+            frames.push_back( frame );
+        }
+        position = next;
+    }
+    return true;
+}
+
+static allocResult &getResult
+(
+    std::vector<allocResult> &results,
+    const std::string        &profile
+)
+{
+    for ( size_t counter = 0; counter < results.size(); ++counter )
+    {
+        if ( results[ counter ].profile == profile )
+        {
+            return results[ counter ];
+        }
+    }
+    results.push_back( allocResult() );
+    memset( results.back().passes, 0, sizeof( results.back().passes ) );
+    results.back().profile = profile;
+    return results.back();
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Decode the frames twice with a new processor in output mode 'mode', count the allocations of
+// every packet. 'results' must hold an entry for every profile of the frames.
+//
+// -------------------------------------------------------------------------------------------------//
+static void runCheck
+(
+    const std::vector<BYTE>       &data,
+    const std::vector<allocFrame> &frames,
+    int                            mode,
+    std::vector<allocResult>      &results
+)
+{
+    antAllProcessing   processor;
+    amString           output;
+    amString           message;
+    std::vector<BYTE>  line( C_BUFFER_SIZE, 0 );
+    long long          receiveTime = C_ALLOC_START_TIME;
+
+    processor.setProgramName( C_ALLOC_PROGRAM_NAME );
+    processor.setWriteStdout( false );
+    processor.setSemiCookedOut( mode == ALLOC_SEMI_COOKED );
+    processor.setOutputAsJSON( mode == ALLOC_JSON );
+    processor.setOutputRaw( mode == ALLOC_RAW );
+    processor.setDiagnostics( mode == ALLOC_DIAGNOSTICS );
+
+    for ( int passNo = 0; passNo < 2; ++passNo )
+    {
+        for ( size_t frameNo = 0; frameNo < frames.size(); ++frameNo )
+        {
+            const allocFrame &frame  = frames[ frameNo ];
+            allocCounts      &counts = getResult( results, frame.profile ).passes[ passNo ];
+
+            memcpy( &( line[ 0 ] ), &( data[ frame.start ] ), frame.nbBytes );
+
+            nbAllocations    = 0;
+            nbBytesAllocated = 0;
+            countAllocations = true;
+            processor.decodeFrame( &( line[ 0 ] ), frame.nbBytes, receiveTime, output, message );
+            countAllocations = false;
+
+            ++counts.nbPackets;
+            counts.nbAllocations  += nbAllocations;
+            counts.nbBytes        += nbBytesAllocated;
+            counts.maxAllocations  = ( nbAllocations > counts.maxAllocations ) ? nbAllocations : counts.maxAllocations;
+
+            memset( &( line[ 0 ] ), 0, frame.nbBytes );
+            output.clear();
+            message.clear();
+            receiveTime += C_ALLOC_PACKET_PERIOD;
+        }
+    }
+}
+
+static double perPacket
+(
+    unsigned long long value,
+    unsigned long long nbPackets
+)
+{
+    return ( nbPackets == 0 ) ? 0.0 : ( double ) value / nbPackets;
+}
+
+static bool readBudgets
+(
+    const std::string        &fileName,
+    std::vector<allocBudget> &budgets
+)
+{
+    std::ifstream inStream( fileName.c_str() );
+    std::string   line;
+    allocBudget   budget;
+
+    if ( !inStream.is_open() )
+    {
+        return false;
+    }
+    while ( std::getline( inStream, line ) )
+    {
+        if ( line.find( C_COMMENT_SYMBOL ) != std::string::npos )
+        {
+            line.erase( line.find( C_COMMENT_SYMBOL ) );
+        }
+        std::istringstream fields( line );
+        if ( fields >> budget.profile )
+        {
+            if ( !( fields >> budget.mode >> budget.maxAllocations >> budget.maxBytes ) )
+            {
+                std::cerr << "Invalid budget \"" << line << "\" in " << fileName << "." << std::endl;
+                return false;
+            }
+            budgets.push_back( budget );
+        }
+    }
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Check the warm pass of a profile against the budgets. Returns the number of budgets exceeded.
+//
+// -------------------------------------------------------------------------------------------------//
+static unsigned int checkBudgets
+(
+    const std::vector<allocBudget> &budgets,
+    const allocResult              &result,
+    const char                     *mode
+)
+{
+    const allocCounts &warm       = result.passes[ 1 ];
+    double             allocs     = perPacket( warm.nbAllocations, warm.nbPackets );
+    double             bytes      = perPacket( warm.nbBytes, warm.nbPackets );
+    unsigned int       nbExceeded = 0;
+
+    for ( size_t counter = 0; counter < budgets.size(); ++counter )
+    {
+        const allocBudget &budget = budgets[ counter ];
+        if ( ( ( budget.profile == C_ALLOC_ALL ) || ( budget.profile == result.profile ) ) &&
+             ( ( budget.mode == C_ALLOC_ALL ) || ( budget.mode == mode ) ) &&
+             ( ( allocs > budget.maxAllocations ) || ( bytes > budget.maxBytes ) ) )
+        {
+            printf( "%-8s %-7s over budget: %.2f allocations/packet (budget %.2f), %.1f bytes/packet (budget %.1f).\n",
+                    result.profile.c_str(), mode, allocs, budget.maxAllocations, bytes, budget.maxBytes );
+            ++nbExceeded;
+        }
+    }
+    return nbExceeded;
+}
+
+static void help
+(
+    void
+)
+{
+    std::cout << "Usage: " << C_ALLOC_PROGRAM_NAME << " [-f <file>] [-b <budget file>] [-o <modes>]" << std::endl;
+    std::cout << "    -f <file>: ANT+ capture file to decode. Default: " << C_ALLOC_DEFAULT_FILE << "." << std::endl;
+    std::cout << "    -b <budget file>: Fail if the warm pass of a profile exceeds its budget." << std::endl;
+    std::cout << "       Lines \"<profile> <mode> <allocations per packet> <bytes per packet>\", '*': all profiles or modes." << std::endl;
+    std::cout << "    -o <modes>: Comma separated output modes. Default: all:";
+    for ( size_t counter = 0; counter < C_NB_ALLOC_MODES; ++counter )
+    {
+        std::cout << " " << C_ALLOC_MODE_NAMES[ counter ];
+    }
+    std::cout << "." << std::endl;
+    std::cout << "    -h: Show this help." << std::endl;
+}
+
+int main
+(
+    int   argc,
+    char *argv[]
+)
+{
+    std::vector<BYTE>        data;
+    std::vector<allocFrame>  frames;
+    std::vector<allocBudget> budgets;
+    std::vector<int>         modes;
+    std::string              fileName   = C_ALLOC_DEFAULT_FILE;
+    std::string              budgetFile;
+    std::string              modeList;
+    std::string              item;
+    unsigned int             nbExceeded = 0;
+    int                      option     = 0;
+
+    while ( ( option = getopt( argc, argv, C_ALLOC_OPTION_STRING ) ) != -1 )
+    {
+        switch ( option )
+        {
+            case 'f':
+                 fileName = optarg;
+                 break;
+            case 'b':
+                 budgetFile = optarg;
+                 break;
+            case 'o':
+                 modeList = optarg;
+                 break;
+            case 'h':
+                 help();
+                 return 0;
+            default:
+                 help();
+                 return E_BAD_OPTION;
+        }
+    }
+
+    if ( modeList.empty() )
+    {
+        for ( size_t counter = 0; counter < C_NB_ALLOC_MODES; ++counter )
+        {
+            modes.push_back( counter );
+        }
+    }
+    else
+    {
+        std::istringstream items( modeList );
+        while ( std::getline( items, item, ',' ) )
+        {
+            size_t modeNo = 0;
+            while ( ( modeNo < C_NB_ALLOC_MODES ) && ( item != C_ALLOC_MODE_NAMES[ modeNo ] ) )
+            {
+                ++modeNo;
+            }
+            if ( modeNo == C_NB_ALLOC_MODES )
+            {
+                std::cerr << "Unknown output mode \"" << item << "\"." << std::endl;
+                return E_BAD_PARAMETER_VALUE;
+            }
+            modes.push_back( modeNo );
+        }
+    }
+    if ( !readFrames( fileName, data, frames ) )
+    {
+        std::cerr << "Could not read \"" << fileName << "\"." << std::endl;
+        return E_READ_FILE_NOT_OPEN;
+    }
+    if ( !budgetFile.empty() && !readBudgets( budgetFile, budgets ) )
+    {
+        std::cerr << "Could not read the budgets of \"" << budgetFile << "\"." << std::endl;
+        return E_READ_FILE_NOT_OPEN;
+    }
+    if ( frames.empty() || modes.empty() )
+    {
+        help();
+        return E_BAD_OPTION;
+    }
+
+    printf( "%u packets of %s, heap allocations per packet (cold: first pass, warm: second pass).\n", ( unsigned int ) frames.size(), fileName.c_str() );
+    printf( "%-8s %-7s %8s %12s %12s %12s %12s %10s\n", "profile", "mode", "packets", "cold allocs", "cold bytes", "warm allocs", "warm bytes", "warm max" );
+    for ( size_t modeNo = 0; modeNo < modes.size(); ++modeNo )
+    {
+        std::vector<allocResult> results;
+        const char              *mode = C_ALLOC_MODE_NAMES[ modes[ modeNo ] ];
+
+        runCheck( data, frames, modes[ modeNo ], results );
+        for ( size_t counter = 0; counter < results.size(); ++counter )
+        {
+            const allocCounts &cold = results[ counter ].passes[ 0 ];
+            const allocCounts &warm = results[ counter ].passes[ 1 ];
+            printf( "%-8s %-7s %8llu %12.2f %12.1f %12.2f %12.1f %10llu\n", results[ counter ].profile.c_str(), mode, warm.nbPackets,
+                    perPacket( cold.nbAllocations, cold.nbPackets ), perPacket( cold.nbBytes, cold.nbPackets ),
+                    perPacket( warm.nbAllocations, warm.nbPackets ), perPacket( warm.nbBytes, warm.nbPackets ), warm.maxAllocations );
+        }
+        for ( size_t counter = 0; counter < results.size(); ++counter )
+        {
+            nbExceeded += checkBudgets( budgets, results[ counter ], mode );
+        }
+        fflush( stdout );
+    }
+
+    if ( nbExceeded > 0 )
+    {
+        printf( "%u allocation budgets exceeded.\n", nbExceeded );
+        return 1;
+    }
+    return 0;
+}
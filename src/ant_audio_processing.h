@@ -8,9 +8,11 @@ class antAudioProcessing : virtual public antProcessing
 
     protected:
 
-        amDeviceType processAudioControl( const amString &deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
+        amDeviceType processAudioControl( unsigned int deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
         amDeviceType processAudioControlSemiCooked( const amString &inputBuffer );
 
+        void outputAudioRecord( const antSensorHandle &sensorID, const amString &timeStampBuffer, const amString &versionString, unsigned int dataPage, antAudioPage1Record &page1, antAudioPage16Record &page16 );
+
         virtual void readDeviceFileLine( const char *line );
 
         bool appendAudioSensor( const amString & );
@@ -23,12 +25,11 @@ class antAudioProcessing : virtual public antProcessing
 
         bool isAudioSensor( const amString &deviceID );
 
-        virtual amDeviceType processSensor( int deviceType, const amString &deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
+        virtual amDeviceType processSensor( int deviceType, unsigned int deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
         virtual amDeviceType processSensorSemiCooked( const amString &inputBuffer );
 
-        amDeviceType createAudioControlString( unsigned int dataPage, unsigned int data1, unsigned int data2, unsigned int data3, unsigned int data4 );
-
         virtual void reset( void );
+        virtual antProcessing *createWorker( void ) const { return new antAudioProcessing; }
 
 };
 
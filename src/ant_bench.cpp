@@ -0,0 +1,616 @@
+// -------------------------------------------------------------------------------------------------//
+//
+// Decoder benchmark (make bench).
+// Synthesizes ANT+ packets as sent by the bridges ("AN" frames) for a number of sensors of every
+// device type and decodes them in-process, packet by packet, through antProcessing::decodeFrame()
+// (i.e. ant2txtLine()) in every output mode. Reports the throughput, the decode time per packet
+// (p50, p99, p99.9) and the number of bytes output.
+//
+// The packets are generated before the clock starts, the time of a packet includes the
+// clock_gettime() calls around it (some 20 to 50 ns).
+//
+// -------------------------------------------------------------------------------------------------//
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "ant_all_processing.h"
+
+const char         C_BENCH_PROGRAM_NAME[]     = "ant2txt_bench";
+const char         C_BENCH_OPTION_STRING[]    = "hm:n:o:p:s:w:";
+const unsigned int C_BENCH_DEFAULT_PACKETS    = 100000;
+const unsigned int C_BENCH_DEFAULT_SENSORS    = 8;
+const unsigned int C_BENCH_DEFAULT_WARM_UP    = 1000;
+const size_t       C_BENCH_FRAME_SIZE         = 24;
+const BYTE         C_BENCH_PAYLOAD_LENGTH     = 0x11;
+const BYTE         C_BENCH_TRANS_TYPE         = 0x05;
+const unsigned int C_BENCH_FIRST_DEVICE_ID    = 1000;
+const long long    C_BENCH_START_TIME         = 1500000000000000LL;   // Receive time of the first packet (us).
+const long long    C_BENCH_SENSOR_PERIOD      = 250000;               // Every sensor sends 4 packets per second.
+
+typedef void ( *benchPayloadFill )( BYTE *payload, BYTE page, unsigned int eventNo );
+
+static inline void putLittleEndian16
+(
+    BYTE         *bytes,
+    unsigned int  value
+)
+{
+    bytes[ 0 ] = ( BYTE ) ( value & 0xFF );
+    bytes[ 1 ] = ( BYTE ) ( ( value >> 8 ) & 0xFF );
+}
+
+static inline void putBigEndian16
+(
+    BYTE         *bytes,
+    unsigned int  value
+)
+{
+    bytes[ 0 ] = ( BYTE ) ( ( value >> 8 ) & 0xFF );
+    bytes[ 1 ] = ( BYTE ) ( value & 0xFF );
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Payloads of the data pages: event counts, times and accumulated values advance with every event,
+// so the decoders compute real values instead of taking their "no new event" shortcuts.
+//
+// -------------------------------------------------------------------------------------------------//
+static void fillPower
+(
+    BYTE         *payload,
+    BYTE          page,
+    unsigned int  eventNo
+)
+{
+    payload[ 0 ] = page;
+    payload[ 1 ] = ( BYTE ) eventNo;
+    switch ( page )
+    {
+        case 0x10:   // Standard power only: 200 W at 90 rpm.
+             payload[ 2 ] = 0xFF;
+             payload[ 3 ] = 90;
+             putLittleEndian16( payload + 4, eventNo * 200 );
+             putLittleEndian16( payload + 6, 200 );
+             break;
+        case 0x11:   // Wheel torque: 20 Nm, wheel period 1300 / 2048 s.
+             payload[ 2 ] = ( BYTE ) eventNo;
+             payload[ 3 ] = 0xFF;
+             putLittleEndian16( payload + 4, eventNo * 1300 );
+             putLittleEndian16( payload + 6, eventNo * 32 * 20 );
+             break;
+        case 0x12:   // Crank torque: 30 Nm, crank period 1365 / 2048 s.
+             payload[ 2 ] = ( BYTE ) eventNo;
+             payload[ 3 ] = 90;
+             putLittleEndian16( payload + 4, eventNo * 1365 );
+             putLittleEndian16( payload + 6, eventNo * 32 * 30 );
+             break;
+        case 0x20:   // Crank torque frequency (big-endian): slope 30 Nm/Hz, 100 torque ticks per event.
+             putBigEndian16( payload + 2, 300 );
+             putBigEndian16( payload + 4, eventNo * 1333 );
+             putBigEndian16( payload + 6, eventNo * 100 );
+             break;
+        default:
+             memset( payload + 2, 0xFF, 6 );
+             break;
+    }
+}
+
+static void fillHeartRate
+(
+    BYTE         *payload,
+    BYTE          page,
+    unsigned int  eventNo
+)
+{
+    // The page toggle bit changes every 4 packets. 120 bpm: a beat every 512 / 1024 s.
+    payload[ 0 ] = page | ( ( ( eventNo / 4 ) & 1 ) << 7 );
+    payload[ 1 ] = 0xFF;
+    putLittleEndian16( payload + 2, ( eventNo - 1 ) * 512 );
+    putLittleEndian16( payload + 4, eventNo * 512 );
+    payload[ 6 ] = ( BYTE ) eventNo;
+    payload[ 7 ] = 120;
+}
+
+static void fillSpeedAndCadence
+(
+    BYTE         *payload,
+    BYTE          page,
+    unsigned int  eventNo
+)
+{
+    // No data pages: cadence event time and count, speed event time and count.
+    putLittleEndian16( payload + 0, eventNo * 683 );
+    putLittleEndian16( payload + 2, eventNo );
+    putLittleEndian16( payload + 4, eventNo * 512 );
+    putLittleEndian16( payload + 6, eventNo );
+}
+
+static void fillSpeedOrCadence
+(
+    BYTE         *payload,
+    BYTE          page,
+    unsigned int  eventNo
+)
+{
+    payload[ 0 ] = page | ( ( ( eventNo / 4 ) & 1 ) << 7 );
+    payload[ 1 ] = 0xFF;
+    payload[ 2 ] = 0xFF;
+    payload[ 3 ] = 0xFF;
+    putLittleEndian16( payload + 4, eventNo * 512 );
+    putLittleEndian16( payload + 6, eventNo );
+}
+
+static void fillStride
+(
+    BYTE         *payload,
+    BYTE          page,
+    unsigned int  eventNo
+)
+{
+    // 1 m per event at 3.5 m/s.
+    payload[ 0 ] = page;
+    payload[ 1 ] = 0;
+    payload[ 2 ] = ( BYTE ) ( eventNo / 4 );
+    payload[ 3 ] = ( BYTE ) eventNo;
+    payload[ 4 ] = 0x03;
+    payload[ 5 ] = 0x80;
+    payload[ 6 ] = ( BYTE ) eventNo;
+    payload[ 7 ] = 0;
+}
+
+static void fillCounters
+(
+    BYTE         *payload,
+    BYTE          page,
+    unsigned int  eventNo
+)
+{
+    payload[ 0 ] = page;
+    for ( unsigned int counter = 1; counter < C_ANT_PAYLOAD_LENGTH; ++counter )
+    {
+        payload[ counter ] = ( BYTE ) ( eventNo * counter );
+    }
+}
+
+struct benchProfile
+{
+    const char       *name;
+    BYTE              deviceType;
+    const char       *pages;        // Default page mix: hex page numbers, sent in turn.
+    benchPayloadFill  fill;
+};
+
+static const benchProfile C_BENCH_PROFILES[] =
+{
+    { "power",   C_POWER_TYPE,  "10,11,12,20", fillPower },
+    { "hrm",     C_HRM_TYPE,    "00,04",       fillHeartRate },
+    { "spcad",   C_SPCAD_TYPE,  "00",          fillSpeedAndCadence },
+    { "speed",   C_SPEED_TYPE,  "00",          fillSpeedOrCadence },
+    { "cadence", C_CAD_TYPE,    "00",          fillSpeedOrCadence },
+    { "sbsdm",   C_SBSDM_TYPE,  "01",          fillStride },
+    { "aero",    C_AERO_TYPE,   "01",          fillCounters },
+    { "mssdm",   C_MSSDM_TYPE,  "01",          fillCounters },
+    { "audio",   C_AUDIO_TYPE,  "01",          fillCounters },
+    { "bldpr",   C_BLDPR_TYPE,  "01",          fillCounters },
+    { "env",     C_ENV_TYPE,    "01",          fillCounters },
+    { "weight",  C_WEIGHT_TYPE, "01",          fillCounters }
+};
+
+const size_t C_NB_BENCH_PROFILES = sizeof( C_BENCH_PROFILES ) / sizeof( C_BENCH_PROFILES[ 0 ] );
+
+enum benchMode
+{
+    BENCH_SEMI_COOKED,
+    BENCH_COOKED,
+    BENCH_JSON,
+    BENCH_RAW,
+    BENCH_DIAGNOSTICS
+};
+
+static const char *C_BENCH_MODE_NAMES[] = { "semi", "cooked", "json", "raw", "diag" };
+
+const size_t C_NB_BENCH_MODES = sizeof( C_BENCH_MODE_NAMES ) / sizeof( C_BENCH_MODE_NAMES[ 0 ] );
+
+// A profile selected for a run, with its page mix.
+struct benchTraffic
+{
+    const benchProfile *profile;
+    std::vector<BYTE>   pages;
+};
+
+struct benchResult
+{
+    double             seconds;
+    unsigned long long nbBytes;
+    long long          p50;
+    long long          p99;
+    long long          p999;
+};
+
+static long long nowNanoseconds
+(
+    void
+)
+{
+    struct timespec now;
+    clock_gettime( CLOCK_MONOTONIC, &now );
+    return ( long long ) now.tv_sec * 1000000000LL + now.tv_nsec;
+}
+
+static bool parsePages
+(
+    const std::string &text,
+    std::vector<BYTE> &pages
+)
+{
+    size_t       begin = 0;
+    size_t       end   = 0;
+    char        *last  = NULL;
+    unsigned int page  = 0;
+
+    pages.clear();
+    while ( begin <= text.size() )
+    {
+        end  = text.find( ',', begin );
+        end  = ( end == std::string::npos ) ? text.size() : end;
+        page = strtoul( text.substr( begin, end - begin ).c_str(), &last, 16 );
+        if ( ( end == begin ) || ( *last != 0 ) || ( page > 0xFF ) )
+        {
+            return false;
+        }
+        pages.push_back( ( BYTE ) page );
+        begin = end + 1;
+    }
+    return !pages.empty();
+}
+
+static const benchProfile *findProfile
+(
+    const std::string &name
+)
+{
+    for ( size_t counter = 0; counter < C_NB_BENCH_PROFILES; ++counter )
+    {
+        if ( name == C_BENCH_PROFILES[ counter ].name )
+        {
+            return &( C_BENCH_PROFILES[ counter ] );
+        }
+    }
+    return NULL;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Generate 'nbPackets' frames: the sensors of all profiles of 'traffic' send in turn, every sensor
+// cycles through the page mix of its profile.
+//
+// -------------------------------------------------------------------------------------------------//
+static void generateFrames
+(
+    const std::vector<benchTraffic> &traffic,
+    unsigned int                     nbSensors,
+    unsigned int                     nbPackets,
+    std::vector<BYTE>               &frames
+)
+{
+    unsigned int nbStreams = traffic.size() * nbSensors;
+    unsigned int streamNo  = 0;
+    unsigned int eventNo   = 0;
+    unsigned int deviceID  = 0;
+    BYTE        *frame     = NULL;
+
+    frames.assign( ( size_t ) nbPackets * C_BENCH_FRAME_SIZE, 0 );
+    for ( unsigned int packetNo = 0; packetNo < nbPackets; ++packetNo )
+    {
+        const benchTraffic &stream = traffic[ ( packetNo % nbStreams ) / nbSensors ];
+
+        streamNo  = packetNo % nbStreams;
+        eventNo   = packetNo / nbStreams + 1;
+        deviceID  = C_BENCH_FIRST_DEVICE_ID + streamNo % nbSensors;
+        frame     = &( frames[ ( size_t ) packetNo * C_BENCH_FRAME_SIZE ] );
+
+        frame[ 0 ]  = 'A';
+        frame[ 1 ]  = 'N';
+        frame[ 2 ]  = 0x12;
+        frame[ 3 ]  = ( BYTE ) packetNo;
+        frame[ 4 ]  = C_BENCH_PAYLOAD_LENGTH;
+        frame[ 5 ]  = 0x4E;
+        frame[ 6 ]  = ( BYTE ) ( streamNo & 0x07 );
+        stream.profile->fill( frame + 7, stream.pages[ eventNo % stream.pages.size() ], eventNo );
+        frame[ 15 ] = 0xC0;
+        putLittleEndian16( frame + 16, deviceID );
+        frame[ 18 ] = stream.profile->deviceType;
+        frame[ 19 ] = C_BENCH_TRANS_TYPE;
+        frame[ 20 ] = 0x20;
+        frame[ 21 ] = 0xD0;   // RSSI
+        frame[ 22 ] = 0xFB;
+        frame[ 23 ] = 0x00;
+    }
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Decode the frames with a new processor in output mode 'mode'.
+//
+// -------------------------------------------------------------------------------------------------//
+static void runBench
+(
+    const std::vector<BYTE> &frames,
+    unsigned int             nbWarmUp,
+    int                      mode,
+    unsigned int             nbStreams,
+    benchResult             &result
+)
+{
+    antAllProcessing       processor;
+    amString               output;
+    amString               message;
+    size_t                 nbPackets  = frames.size() / C_BENCH_FRAME_SIZE;
+    std::vector<long long> latencies( nbPackets, 0 );
+    long long              receiveTime = C_BENCH_START_TIME;
+    long long              start       = 0;
+    long long              before      = 0;
+    size_t                 position    = 0;
+    size_t                 length      = 0;
+
+    processor.setProgramName( C_BENCH_PROGRAM_NAME );
+    processor.setWriteStdout( false );
+    processor.setSemiCookedOut( mode == BENCH_SEMI_COOKED );
+    processor.setOutputAsJSON( mode == BENCH_JSON );
+    processor.setOutputRaw( mode == BENCH_RAW );
+    processor.setDiagnostics( mode == BENCH_DIAGNOSTICS );
+
+    result.nbBytes = 0;
+    for ( size_t packetNo = 0; packetNo < nbWarmUp + nbPackets; ++packetNo )
+    {
+        const BYTE *frame = &( frames[ ( packetNo % nbPackets ) * C_BENCH_FRAME_SIZE ] );
+
+        if ( packetNo == nbWarmUp )
+        {
+            start = nowNanoseconds();
+        }
+        before = nowNanoseconds();
+        processor.decodeFrame( frame, C_BENCH_FRAME_SIZE, receiveTime, output, message );
+        if ( packetNo >= nbWarmUp )
+        {
+            latencies[ packetNo - nbWarmUp ] = nowNanoseconds() - before;
+
+            // The captured output is made of pieces: kind (1 byte), length, text.
+            for ( position = 0; position + 1 + sizeof( length ) <= output.size(); position += length )
+            {
+                memcpy( &length, output.data() + position + 1, sizeof( length ) );
+                position       += 1 + sizeof( length );
+                result.nbBytes += length;
+            }
+        }
+        output.clear();
+        message.clear();
+        receiveTime += C_BENCH_SENSOR_PERIOD / nbStreams;
+    }
+    result.seconds = ( nowNanoseconds() - start ) * 1.0E-9;
+
+    std::sort( latencies.begin(), latencies.end() );
+    result.p50  = latencies[ nbPackets / 2 ];
+    result.p99  = latencies[ ( nbPackets * 99 ) / 100 ];
+    result.p999 = latencies[ ( nbPackets * 999 ) / 1000 ];
+}
+
+static void help
+(
+    void
+)
+{
+    std::cout << "Usage: " << C_BENCH_PROGRAM_NAME << " [-n <packets>] [-s <sensors>] [-p <profiles>] [-o <modes>] [-m <profile>=<pages>] [-w <packets>]" << std::endl;
+    std::cout << "    -n <packets>: Decode <packets> packets per profile and output mode. Default: " << C_BENCH_DEFAULT_PACKETS << "." << std::endl;
+    std::cout << "    -s <sensors>: Number of sensors of every profile. Default: " << C_BENCH_DEFAULT_SENSORS << "." << std::endl;
+    std::cout << "    -p <profiles>: Comma separated profiles. Default: all:" << std::endl;
+    std::cout << "       ";
+    for ( size_t counter = 0; counter < C_NB_BENCH_PROFILES; ++counter )
+    {
+        std::cout << " " << C_BENCH_PROFILES[ counter ].name << " (pages " << C_BENCH_PROFILES[ counter ].pages << ")";
+    }
+    std::cout << std::endl;
+    std::cout << "       With several profiles a last run (\"mixed\") sends the packets of all of them in turn." << std::endl;
+    std::cout << "    -o <modes>: Comma separated output modes. Default: all: semi (-S), cooked, json (-J), raw (-r), diag (-D)." << std::endl;
+    std::cout << "    -m <profile>=<pages>: Page mix of a profile, comma separated hex page numbers sent in turn (e.g. power=10,10,12)." << std::endl;
+    std::cout << "    -w <packets>: Decode <packets> packets before the clock starts. Default: " << C_BENCH_DEFAULT_WARM_UP << "." << std::endl;
+}
+
+static bool splitList
+(
+    const std::string        &text,
+    std::vector<std::string> &items
+)
+{
+    size_t begin = 0;
+    size_t end   = 0;
+
+    items.clear();
+    while ( begin <= text.size() )
+    {
+        end = text.find( ',', begin );
+        end = ( end == std::string::npos ) ? text.size() : end;
+        if ( end == begin )
+        {
+            return false;
+        }
+        items.push_back( text.substr( begin, end - begin ) );
+        begin = end + 1;
+    }
+    return true;
+}
+
+static void printResult
+(
+    const char        *profileName,
+    const char        *modeName,
+    unsigned int       nbPackets,
+    const benchResult &result
+)
+{
+    printf( "%-8s %-7s %10u %12.0f %10lld %10lld %10lld %12llu %8.1f\n",
+            profileName,
+            modeName,
+            nbPackets,
+            nbPackets / result.seconds,
+            result.p50,
+            result.p99,
+            result.p999,
+            result.nbBytes,
+            ( double ) result.nbBytes / nbPackets );
+}
+
+int main
+(
+    int   argc,
+    char *argv[]
+)
+{
+    std::vector<benchTraffic> traffic;
+    std::vector<benchTraffic> selected;
+    std::vector<int>          modes;
+    std::vector<std::string>  items;
+    std::vector<BYTE>         frames;
+    benchResult               result;
+    unsigned int              nbPackets = C_BENCH_DEFAULT_PACKETS;
+    unsigned int              nbSensors = C_BENCH_DEFAULT_SENSORS;
+    unsigned int              nbWarmUp  = C_BENCH_DEFAULT_WARM_UP;
+    std::string               profileList;
+    std::string               modeList;
+    std::string               text;
+    size_t                    separator = 0;
+    int                       option    = 0;
+
+    for ( size_t counter = 0; counter < C_NB_BENCH_PROFILES; ++counter )
+    {
+        traffic.push_back( benchTraffic() );
+        traffic.back().profile = &( C_BENCH_PROFILES[ counter ] );
+        parsePages( C_BENCH_PROFILES[ counter ].pages, traffic.back().pages );
+    }
+
+    while ( ( option = getopt( argc, argv, C_BENCH_OPTION_STRING ) ) != -1 )
+    {
+        switch ( option )
+        {
+            case 'n':
+                 nbPackets = strtoul( optarg, NULL, 10 );
+                 break;
+            case 's':
+                 nbSensors = strtoul( optarg, NULL, 10 );
+                 break;
+            case 'w':
+                 nbWarmUp = strtoul( optarg, NULL, 10 );
+                 break;
+            case 'p':
+                 profileList = optarg;
+                 break;
+            case 'o':
+                 modeList = optarg;
+                 break;
+            case 'm':
+                 text      = optarg;
+                 separator = text.find( '=' );
+                 if ( ( separator == std::string::npos ) || ( findProfile( text.substr( 0, separator ) ) == NULL ) ||
+                      !parsePages( text.substr( separator + 1 ), traffic[ findProfile( text.substr( 0, separator ) ) - C_BENCH_PROFILES ].pages ) )
+                 {
+                     std::cerr << "Invalid page mix \"" << optarg << "\"." << std::endl;
+                     return E_BAD_PARAMETER_VALUE;
+                 }
+                 break;
+            case 'h':
+                 help();
+                 return 0;
+            default:
+                 help();
+                 return E_BAD_OPTION;
+        }
+    }
+    if ( ( nbPackets == 0 ) || ( nbSensors == 0 ) || ( nbSensors > 0xFFFF - C_BENCH_FIRST_DEVICE_ID ) )
+    {
+        std::cerr << "The number of packets and of sensors must be positive (at most " << 0xFFFF - C_BENCH_FIRST_DEVICE_ID << " sensors)." << std::endl;
+        return E_BAD_PARAMETER_VALUE;
+    }
+
+    if ( profileList.empty() )
+    {
+        selected = traffic;
+    }
+    else if ( splitList( profileList, items ) )
+    {
+        for ( size_t counter = 0; counter < items.size(); ++counter )
+        {
+            if ( findProfile( items[ counter ] ) == NULL )
+            {
+                std::cerr << "Unknown profile \"" << items[ counter ] << "\"." << std::endl;
+                return E_BAD_PARAMETER_VALUE;
+            }
+            selected.push_back( traffic[ findProfile( items[ counter ] ) - C_BENCH_PROFILES ] );
+        }
+    }
+
+    if ( modeList.empty() )
+    {
+        for ( size_t counter = 0; counter < C_NB_BENCH_MODES; ++counter )
+        {
+            modes.push_back( counter );
+        }
+    }
+    else if ( splitList( modeList, items ) )
+    {
+        for ( size_t counter = 0; counter < items.size(); ++counter )
+        {
+            size_t modeNo = 0;
+            while ( ( modeNo < C_NB_BENCH_MODES ) && ( items[ counter ] != C_BENCH_MODE_NAMES[ modeNo ] ) )
+            {
+                ++modeNo;
+            }
+            if ( modeNo == C_NB_BENCH_MODES )
+            {
+                std::cerr << "Unknown output mode \"" << items[ counter ] << "\"." << std::endl;
+                return E_BAD_PARAMETER_VALUE;
+            }
+            modes.push_back( modeNo );
+        }
+    }
+    if ( selected.empty() || modes.empty() )
+    {
+        help();
+        return E_BAD_OPTION;
+    }
+
+    printf( "%u packets per run, %u sensors per profile, latencies in ns.\n", nbPackets, nbSensors );
+    printf( "%-8s %-7s %10s %12s %10s %10s %10s %12s %8s\n", "profile", "mode", "packets", "packets/s", "p50", "p99", "p99.9", "bytes", "b/packet" );
+    for ( size_t profileNo = 0; profileNo <= selected.size(); ++profileNo )
+    {
+        std::vector<benchTraffic> runTraffic;
+
+        if ( profileNo < selected.size() )
+        {
+            runTraffic.push_back( selected[ profileNo ] );
+        }
+        else if ( selected.size() > 1 )
+        {
+            runTraffic = selected;
+        }
+        else
+        {
+            break;
+        }
+
+        generateFrames( runTraffic, nbSensors, nbPackets, frames );
+        for ( size_t modeNo = 0; modeNo < modes.size(); ++modeNo )
+        {
+            runBench( frames, nbWarmUp, modes[ modeNo ], runTraffic.size() * nbSensors, result );
+            printResult( ( runTraffic.size() == 1 ) ? runTraffic[ 0 ].profile->name : "mixed", C_BENCH_MODE_NAMES[ modes[ modeNo ] ], nbPackets, result );
+            fflush( stdout );
+        }
+    }
+    return 0;
+}
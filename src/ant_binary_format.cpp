@@ -0,0 +1,1033 @@
+#include <cstddef>
+#include <cstring>
+
+#include "am_little_endian.h"
+#include "ant_constants.h"
+#include "ant_binary_format.h"
+
+const char         C_BINARY_MAGIC[]          = "ANTB";
+const size_t       C_BINARY_MAGIC_LENGTH     = 4;
+const unsigned int C_BINARY_FORMAT_VERSION   = 2;
+const unsigned int C_BINARY_FLAG_SEMI_COOKED = 0x01;
+const unsigned int C_BINARY_FLAG_JSON_TEXT   = 0x02;
+const unsigned int C_BINARY_PAGE_IN_RECORD   = 0x100;   // See antBinaryRecordType::dataPage
+const char         C_BLOCK_DEFINITION        = 'D';
+const char         C_BLOCK_RECORD            = 'R';
+const char         C_BLOCK_TEXT              = 'T';
+const size_t       C_MAX_NAME_LENGTH         = 255;
+const unsigned int C_MAX_REPEATED_DOUBLES    = 64;      // Bits of the mask of the repeated doubles
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Layout of the records: the fields of the structs of ant_records.h written to a stream.
+//
+// -------------------------------------------------------------------------------------------------//
+struct antBinaryField
+{
+    const char *name;
+    char        wireType;       // 'u', 'i', '?' or 'd', see ant_binary_format.h
+    char        memberType;     // 'u': unsigned int, 'i': int, 'c': unsigned char, 'd': double, 'b': bool
+    size_t      offset;
+    bool        cooked;
+};
+
+struct antBinaryRecordType
+{
+    int                   recordType;
+    const char           *name;
+    unsigned int          dataPage;     // Data page of all records of the type, C_BINARY_PAGE_IN_RECORD: in the record
+    size_t                pageOffset;   // Offset of the data page in the record (C_BINARY_PAGE_IN_RECORD)
+    const antBinaryField *fields;
+};
+
+// The data page of a HRM record and of an unsupported page is written in the record header.
+const antBinaryField C_HRM_FIELDS[] =
+{
+    { "heartRate",                  'u', 'u', offsetof( antHRMRecord, heartRate ),                  false },
+    { "deltaHeartBeatEventTime",    'u', 'u', offsetof( antHRMRecord, deltaHeartBeatEventTime ),    false },
+    { "deltaHeartBeatCount",        'u', 'u', offsetof( antHRMRecord, deltaHeartBeatCount ),        false },
+    { "additionalData1",            'u', 'u', offsetof( antHRMRecord, additionalData1 ),            false },
+    { "additionalData2",            'u', 'u', offsetof( antHRMRecord, additionalData2 ),            false },
+    { "additionalData3",            'u', 'u', offsetof( antHRMRecord, additionalData3 ),            false },
+    { "totalHeartBeatEventTime",    'd', 'd', offsetof( antHRMRecord, totalHeartBeatEventTime ),    true  },
+    { "totalHeartBeatCount",        'u', 'u', offsetof( antHRMRecord, totalHeartBeatCount ),        true  },
+    { "previousHeartBeatEventTime", 'd', 'd', offsetof( antHRMRecord, previousHeartBeatEventTime ), true  },
+    { NULL,                         0,   0,   0,                                                    false }
+};
+
+const antBinaryField C_POWER_B01_FIELDS[] =
+{
+    { "calibrationID",              'u', 'u', offsetof( antPowerB01Record, calibrationID ),          false },
+    { "calibrationData1",           'u', 'u', offsetof( antPowerB01Record, calibrationData1 ),       false },
+    { "calibrationData2",           'u', 'u', offsetof( antPowerB01Record, calibrationData2 ),       false },
+    { NULL,                         0,   0,   0,                                                     false }
+};
+
+const antBinaryField C_POWER_B02_FIELDS[] =
+{
+    { "subPage",                    'u', 'u', offsetof( antPowerB02Record, subPage ),                false },
+    { "crankLength",                'u', 'u', offsetof( antPowerB02Record, crankLength ),            false },
+    { "sensorStatus",               'u', 'u', offsetof( antPowerB02Record, sensorStatus ),           false },
+    { "sensorCapabilities",         'u', 'u', offsetof( antPowerB02Record, sensorCapabilities ),     false },
+    { NULL,                         0,   0,   0,                                                     false }
+};
+
+const antBinaryField C_POWER_B03_FIELDS[] =
+{
+    { "nbDataTypes",                'u', 'u', offsetof( antPowerB03Record, nbDataTypes ),            false },
+    { "dataType",                   'u', 'u', offsetof( antPowerB03Record, dataType ),               false },
+    { "scaleFactor",                'u', 'u', offsetof( antPowerB03Record, scaleFactor ),            false },
+    { "deltaEventTime",             'u', 'u', offsetof( antPowerB03Record, deltaEventTime ),         false },
+    { "value",                      'u', 'u', offsetof( antPowerB03Record, value ),                  false },
+    { "timeValue",                  'd', 'd', offsetof( antPowerB03Record, timeValue ),              true  },
+    { "measurementValue",           'd', 'd', offsetof( antPowerB03Record, measurementValue ),       true  },
+    { NULL,                         0,   0,   0,                                                     false }
+};
+
+const antBinaryField C_POWER_B10_FIELDS[] =
+{
+    { "eventCount",                 'u', 'u', offsetof( antPowerB10Record, eventCount ),             false },
+    { "deltaEventCount",            'u', 'u', offsetof( antPowerB10Record, deltaEventCount ),        false },
+    { "deltaAccumulatedPower",      'u', 'u', offsetof( antPowerB10Record, deltaAccumulatedPower ),  false },
+    { "instantaneousPower",         'u', 'u', offsetof( antPowerB10Record, instantaneousPower ),     false },
+    { "instantaneousCadence",       'u', 'u', offsetof( antPowerB10Record, instantaneousCadence ),   false },
+    { "pedalPower",                 'u', 'u', offsetof( antPowerB10Record, pedalPower ),             false },
+    { "power",                      'd', 'd', offsetof( antPowerB10Record, power ),                  true  },
+    { "cadence",                    'u', 'u', offsetof( antPowerB10Record, cadence ),                true  },
+    { "pedalPowerContribution",     'i', 'i', offsetof( antPowerB10Record, pedalPowerContribution ), true  },
+    { "rightPedal",                 '?', 'b', offsetof( antPowerB10Record, rightPedal ),             true  },
+    { "isMakeshiftSpeedSensor",     '?', 'b', offsetof( antPowerB10Record, isMakeshiftSpeedSensor ), true  },
+    { "speed",                      'd', 'd', offsetof( antPowerB10Record, speed ),                  true  },
+    { "wheelCircumference",         'd', 'd', offsetof( antPowerB10Record, wheelCircumference ),     true  },
+    { "gearRatio",                  'd', 'd', offsetof( antPowerB10Record, gearRatio ),              true  },
+    { NULL,                         0,   0,   0,                                                     false }
+};
+
+const antBinaryField C_POWER_B11_FIELDS[] =
+{
+    { "deltaEventCount",            'u', 'u', offsetof( antPowerB11Record, deltaEventCount ),        false },
+    { "deltaWheelPeriod",           'u', 'u', offsetof( antPowerB11Record, deltaWheelPeriod ),       false },
+    { "deltaAccumulatedTorque",     'u', 'u', offsetof( antPowerB11Record, deltaAccumulatedTorque ), false },
+    { "instantaneousCadence",       'u', 'u', offsetof( antPowerB11Record, instantaneousCadence ),   false },
+    { "wheelTicks",                 'u', 'u', offsetof( antPowerB11Record, wheelTicks ),             false },
+    { "power",                      'd', 'd', offsetof( antPowerB11Record, power ),                  true  },
+    { "cadence",                    'u', 'u', offsetof( antPowerB11Record, cadence ),                true  },
+    { "torque",                     'd', 'd', offsetof( antPowerB11Record, torque ),                 true  },
+    { "isSpeedSensor",              '?', 'b', offsetof( antPowerB11Record, isSpeedSensor ),          true  },
+    { "speed",                      'd', 'd', offsetof( antPowerB11Record, speed ),                  true  },
+    { "wheelCircumference",         'd', 'd', offsetof( antPowerB11Record, wheelCircumference ),     true  },
+    { NULL,                         0,   0,   0,                                                     false }
+};
+
+const antBinaryField C_POWER_B12_FIELDS[] =
+{
+    { "eventCount",                 'u', 'u', offsetof( antPowerB12Record, eventCount ),             false },
+    { "deltaEventCount",            'u', 'u', offsetof( antPowerB12Record, deltaEventCount ),        false },
+    { "deltaCrankPeriod",           'u', 'u', offsetof( antPowerB12Record, deltaCrankPeriod ),       false },
+    { "deltaAccumulatedTorque",     'u', 'u', offsetof( antPowerB12Record, deltaAccumulatedTorque ), false },
+    { "instantaneousCadence",       'u', 'u', offsetof( antPowerB12Record, instantaneousCadence ),   false },
+    { "crankTicks",                 'u', 'u', offsetof( antPowerB12Record, crankTicks ),             false },
+    { "power",                      'd', 'd', offsetof( antPowerB12Record, power ),                  true  },
+    { "cadence",                    'u', 'u', offsetof( antPowerB12Record, cadence ),                true  },
+    { "torque",                     'd', 'd', offsetof( antPowerB12Record, torque ),                 true  },
+    { "isMakeshiftSpeedSensor",     '?', 'b', offsetof( antPowerB12Record, isMakeshiftSpeedSensor ), true  },
+    { "speed",                      'd', 'd', offsetof( antPowerB12Record, speed ),                  true  },
+    { "wheelCircumference",         'd', 'd', offsetof( antPowerB12Record, wheelCircumference ),     true  },
+    { "gearRatio",                  'd', 'd', offsetof( antPowerB12Record, gearRatio ),              true  },
+    { NULL,                         0,   0,   0,                                                     false }
+};
+
+const antBinaryField C_POWER_B13_FIELDS[] =
+{
+    { "leftTorqueEffectiveness",    'u', 'u', offsetof( antPowerB13Record, leftTorqueEffectiveness ),  false },
+    { "rightTorqueEffectiveness",   'u', 'u', offsetof( antPowerB13Record, rightTorqueEffectiveness ), false },
+    { "leftPedalSmoothness",        'u', 'u', offsetof( antPowerB13Record, leftPedalSmoothness ),      false },
+    { "rightPedalSmoothness",       'u', 'u', offsetof( antPowerB13Record, rightPedalSmoothness ),     false },
+    { "deltaEventCount",            'u', 'u', offsetof( antPowerB13Record, deltaEventCount ),          false },
+    { "totalEventCount",            'u', 'u', offsetof( antPowerB13Record, totalEventCount ),          true  },
+    { NULL,                         0,   0,   0,                                                       false }
+};
+
+const antBinaryField C_POWER_B20_FIELDS[] =
+{
+    { "deltaEventCount",            'u', 'u', offsetof( antPowerB20Record, deltaEventCount ),        false },
+    { "deltaTimeStamp",             'u', 'u', offsetof( antPowerB20Record, deltaTimeStamp ),         false },
+    { "deltaTorqueTicks",           'u', 'u', offsetof( antPowerB20Record, deltaTorqueTicks ),       false },
+    { "factorySlope",               'u', 'u', offsetof( antPowerB20Record, factorySlope ),           false },
+    { "power",                      'd', 'd', offsetof( antPowerB20Record, power ),                  true  },
+    { "cadence",                    'u', 'u', offsetof( antPowerB20Record, cadence ),                true  },
+    { "torque",                     'd', 'd', offsetof( antPowerB20Record, torque ),                 true  },
+    { "offset",                     'u', 'u', offsetof( antPowerB20Record, offset ),                 true  },
+    { "slope",                      'u', 'u', offsetof( antPowerB20Record, slope ),                  true  },
+    { "isFactorySlope",             '?', 'b', offsetof( antPowerB20Record, isFactorySlope ),         true  },
+    { "isMakeshiftSpeedSensor",     '?', 'b', offsetof( antPowerB20Record, isMakeshiftSpeedSensor ), true  },
+    { "speed",                      'd', 'd', offsetof( antPowerB20Record, speed ),                  true  },
+    { "wheelCircumference",         'd', 'd', offsetof( antPowerB20Record, wheelCircumference ),     true  },
+    { "gearRatio",                  'd', 'd', offsetof( antPowerB20Record, gearRatio ),              true  },
+    { NULL,                         0,   0,   0,                                                     false }
+};
+
+const antBinaryField C_COMMON_PAGE67_FIELDS[] =
+{
+    { "outputPageNo",               '?', 'b', offsetof( antCommonPage67Record, outputPageNo ),       false },
+    { "statusByte1",                'u', 'u', offsetof( antCommonPage67Record, statusByte1 ),        false },
+    { "statusByte2",                'u', 'u', offsetof( antCommonPage67Record, statusByte2 ),        false },
+    { "authentication",             'u', 'u', offsetof( antCommonPage67Record, authentication ),     false },
+    { "deviceType",                 'u', 'u', offsetof( antCommonPage67Record, deviceType ),         false },
+    { "manufacturerID",             'u', 'u', offsetof( antCommonPage67Record, manufacturerID ),     false },
+    { NULL,                         0,   0,   0,                                                     false }
+};
+
+const antBinaryField C_COMMON_PAGE68_FIELDS[] =
+{
+    { "outputPageNo",               '?', 'b', offsetof( antCommonPage68Record, outputPageNo ),       false },
+    { "commandResponseID",          'u', 'u', offsetof( antCommonPage68Record, commandResponseID ),  false },
+    { "channelFrequency",           'u', 'u', offsetof( antCommonPage68Record, channelFrequency ),   false },
+    { "channelPeriod",              'u', 'u', offsetof( antCommonPage68Record, channelPeriod ),      false },
+    { "hostSerialNumber",           'u', 'u', offsetof( antCommonPage68Record, hostSerialNumber ),   false },
+    { NULL,                         0,   0,   0,                                                     false }
+};
+
+const antBinaryField C_COMMON_PAGE70_FIELDS[] =
+{
+    { "outputPageNo",               '?', 'b', offsetof( antCommonPage70Record, outputPageNo ),       false },
+    { "descriptor1",                'u', 'u', offsetof( antCommonPage70Record, descriptor1 ),        false },
+    { "descriptor2",                'u', 'u', offsetof( antCommonPage70Record, descriptor2 ),        false },
+    { "requestedResponse",          'u', 'u', offsetof( antCommonPage70Record, requestedResponse ),  false },
+    { "requestedPage",              'u', 'u', offsetof( antCommonPage70Record, requestedPage ),      false },
+    { "commandType",                'u', 'u', offsetof( antCommonPage70Record, commandType ),        false },
+    { NULL,                         0,   0,   0,                                                     false }
+};
+
+const antBinaryField C_COMMON_PAGE80_FIELDS[] =
+{
+    { "outputPageNo",               '?', 'b', offsetof( antCommonPage80Record, outputPageNo ),       false },
+    { "manufacturerID",             'u', 'u', offsetof( antCommonPage80Record, manufacturerID ),     false },
+    { "hardwareRevision",           'u', 'u', offsetof( antCommonPage80Record, hardwareRevision ),   false },
+    { "modelNumber",                'u', 'u', offsetof( antCommonPage80Record, modelNumber ),        false },
+    { NULL,                         0,   0,   0,                                                     false }
+};
+
+const antBinaryField C_COMMON_PAGE81_FIELDS[] =
+{
+    { "outputPageNo",               '?', 'b', offsetof( antCommonPage81Record, outputPageNo ),       false },
+    { "serialNumber",               'u', 'u', offsetof( antCommonPage81Record, serialNumber ),       false },
+    { "softwareRevision",           'u', 'u', offsetof( antCommonPage81Record, softwareRevision ),   false },
+    { NULL,                         0,   0,   0,                                                     false }
+};
+
+const antBinaryField C_COMMON_PAGE82_FIELDS[] =
+{
+    { "outputPageNo",               '?', 'b', offsetof( antCommonPage82Record, outputPageNo ),       false },
+    { "voltage256",                 'u', 'u', offsetof( antCommonPage82Record, voltage256 ),         false },
+    { "status",                     'u', 'u', offsetof( antCommonPage82Record, status ),             false },
+    { "deltaOperatingTime",         'u', 'u', offsetof( antCommonPage82Record, deltaOperatingTime ), false },
+    { "resolution",                 'u', 'u', offsetof( antCommonPage82Record, resolution ),         false },
+    { "nbBatteries",                'u', 'u', offsetof( antCommonPage82Record, nbBatteries ),        false },
+    { "batteryID",                  'u', 'u', offsetof( antCommonPage82Record, batteryID ),          false },
+    { "totalOperatingTime",         'd', 'd', offsetof( antCommonPage82Record, totalOperatingTime ), true  },
+    { NULL,                         0,   0,   0,                                                     false }
+};
+
+const antBinaryField C_COMMON_PAGE83_FIELDS[] =
+{
+    { "outputPageNo",               '?', 'b', offsetof( antCommonPage83Record, outputPageNo ),       false },
+    { "seconds",                    'u', 'u', offsetof( antCommonPage83Record, seconds ),            false },
+    { "minutes",                    'u', 'u', offsetof( antCommonPage83Record, minutes ),            false },
+    { "hours",                      'u', 'u', offsetof( antCommonPage83Record, hours ),              false },
+    { "weekDayNo",                  'u', 'u', offsetof( antCommonPage83Record, weekDayNo ),          false },
+    { "monthDay",                   'u', 'u', offsetof( antCommonPage83Record, monthDay ),           false },
+    { "month",                      'u', 'u', offsetof( antCommonPage83Record, month ),              false },
+    { "year",                       'u', 'u', offsetof( antCommonPage83Record, year ),               false },
+    { NULL,                         0,   0,   0,                                                     false }
+};
+
+const antBinaryField C_COMMON_PAGE84_FIELDS[] =
+{
+    { "outputPageNo",               '?', 'b', offsetof( antCommonPage84Record, outputPageNo ),       false },
+    { "subPage1",                   'u', 'u', offsetof( antCommonPage84Record, subPage1 ),           false },
+    { "subPage2",                   'u', 'u', offsetof( antCommonPage84Record, subPage2 ),           false },
+    { "dataField1",                 'u', 'u', offsetof( antCommonPage84Record, dataField1 ),         false },
+    { "dataField2",                 'u', 'u', offsetof( antCommonPage84Record, dataField2 ),         false },
+    { NULL,                         0,   0,   0,                                                     false }
+};
+
+const antBinaryField C_UNSUPPORTED_PAGE_FIELDS[] =
+{
+    { "byte0",                      'u', 'c', offsetof( antUnsupportedPageRecord, payLoad ),         false },
+    { "byte1",                      'u', 'c', offsetof( antUnsupportedPageRecord, payLoad ) + 1,     false },
+    { "byte2",                      'u', 'c', offsetof( antUnsupportedPageRecord, payLoad ) + 2,     false },
+    { "byte3",                      'u', 'c', offsetof( antUnsupportedPageRecord, payLoad ) + 3,     false },
+    { "byte4",                      'u', 'c', offsetof( antUnsupportedPageRecord, payLoad ) + 4,     false },
+    { "byte5",                      'u', 'c', offsetof( antUnsupportedPageRecord, payLoad ) + 5,     false },
+    { "byte6",                      'u', 'c', offsetof( antUnsupportedPageRecord, payLoad ) + 6,     false },
+    { "byte7",                      'u', 'c', offsetof( antUnsupportedPageRecord, payLoad ) + 7,     false },
+    { NULL,                         0,   0,   0,                                                     false }
+};
+
+const antBinaryField C_ENVIRONMENT_PAGE0_FIELDS[] =
+{
+    { "localTime",                  'u', 'u', offsetof( antEnvironmentPage0Record, localTime ),        false },
+    { "utcTime",                    'u', 'u', offsetof( antEnvironmentPage0Record, utcTime ),          false },
+    { "transmissionRate",           'u', 'u', offsetof( antEnvironmentPage0Record, transmissionRate ), false },
+    { "supportedPages",             'u', 'u', offsetof( antEnvironmentPage0Record, supportedPages ),   false },
+    { NULL,                         0,   0,   0,                                                       false }
+};
+
+const antBinaryField C_ENVIRONMENT_PAGE1_FIELDS[] =
+{
+    { "currentTemperature",         'u', 'u', offsetof( antEnvironmentPage1Record, currentTemperature ), false },
+    { "lowTemperature24h",          'u', 'u', offsetof( antEnvironmentPage1Record, lowTemperature24h ),  false },
+    { "highTemperature24h",         'u', 'u', offsetof( antEnvironmentPage1Record, highTemperature24h ), false },
+    { "eventCount",                 'u', 'u', offsetof( antEnvironmentPage1Record, eventCount ),         false },
+    { "currentTemp",                'd', 'd', offsetof( antEnvironmentPage1Record, currentTemp ),        true  },
+    { "lowTemp24h",                 'd', 'd', offsetof( antEnvironmentPage1Record, lowTemp24h ),         true  },
+    { "highTemp24h",                'd', 'd', offsetof( antEnvironmentPage1Record, highTemp24h ),        true  },
+    { NULL,                         0,   0,   0,                                                         false }
+};
+
+// The data page of the speed only and cadence only sensors is written in the record header.
+const antBinaryField C_CADENCE_FIELDS[] =
+{
+    { "deltaRevolutionCount",       'u', 'u', offsetof( antCadenceRecord, deltaRevolutionCount ),   false },
+    { "deltaEventTime",             'u', 'u', offsetof( antCadenceRecord, deltaEventTime ),         false },
+    { "additionalData1",            'u', 'u', offsetof( antCadenceRecord, additionalData1 ),        false },
+    { "additionalData2",            'u', 'u', offsetof( antCadenceRecord, additionalData2 ),        false },
+    { "additionalData3",            'u', 'u', offsetof( antCadenceRecord, additionalData3 ),        false },
+    { "cadence",                    'u', 'u', offsetof( antCadenceRecord, cadence ),                true  },
+    { "isMakeshiftSpeedSensor",     '?', 'b', offsetof( antCadenceRecord, isMakeshiftSpeedSensor ), true  },
+    { "speed",                      'd', 'd', offsetof( antCadenceRecord, speed ),                  true  },
+    { "wheelCircumference",         'd', 'd', offsetof( antCadenceRecord, wheelCircumference ),     true  },
+    { "gearRatio",                  'd', 'd', offsetof( antCadenceRecord, gearRatio ),              true  },
+    { NULL,                         0,   0,   0,                                                    false }
+};
+
+const antBinaryField C_SPEED_FIELDS[] =
+{
+    { "deltaEventTime",             'u', 'u', offsetof( antSpeedRecord, deltaEventTime ),       false },
+    { "deltaRevolutionCount",       'u', 'u', offsetof( antSpeedRecord, deltaRevolutionCount ), false },
+    { "additionalData1",            'u', 'u', offsetof( antSpeedRecord, additionalData1 ),      false },
+    { "additionalData2",            'u', 'u', offsetof( antSpeedRecord, additionalData2 ),      false },
+    { "additionalData3",            'u', 'u', offsetof( antSpeedRecord, additionalData3 ),      false },
+    { "speed",                      'd', 'd', offsetof( antSpeedRecord, speed ),                true  },
+    { "wheelCircumference",         'd', 'd', offsetof( antSpeedRecord, wheelCircumference ),   true  },
+    { "numberOfMagnets",            'u', 'u', offsetof( antSpeedRecord, numberOfMagnets ),      true  },
+    { NULL,                         0,   0,   0,                                                false }
+};
+
+const antBinaryField C_SPEED_CADENCE_FIELDS[] =
+{
+    { "deltaSpeedEventTime",        'u', 'u', offsetof( antSpeedCadenceRecord, deltaSpeedEventTime ),       false },
+    { "deltaWheelRevolutionCount",  'u', 'u', offsetof( antSpeedCadenceRecord, deltaWheelRevolutionCount ), false },
+    { "deltaCadenceEventTime",      'u', 'u', offsetof( antSpeedCadenceRecord, deltaCadenceEventTime ),     false },
+    { "deltaCrankRevolutionCount",  'u', 'u', offsetof( antSpeedCadenceRecord, deltaCrankRevolutionCount ), false },
+    { "speed",                      'd', 'd', offsetof( antSpeedCadenceRecord, speed ),                     true  },
+    { "cadence",                    'u', 'u', offsetof( antSpeedCadenceRecord, cadence ),                   true  },
+    { "wheelCircumference",         'd', 'd', offsetof( antSpeedCadenceRecord, wheelCircumference ),        true  },
+    { "numberOfMagnets",            'u', 'u', offsetof( antSpeedCadenceRecord, numberOfMagnets ),           true  },
+    { NULL,                         0,   0,   0,                                                            false }
+};
+
+const antBinaryField C_AERO_FIELDS[] =
+{
+    { "airSpeedRaw",                'u', 'u', offsetof( antAeroRecord, airSpeedRaw ),        false },
+    { "yawAngleRaw",                'u', 'u', offsetof( antAeroRecord, yawAngleRaw ),        false },
+    { "airSpeed",                   'd', 'd', offsetof( antAeroRecord, airSpeed ),           true  },
+    { "yawAngle",                   'd', 'd', offsetof( antAeroRecord, yawAngle ),           true  },
+    { "calibrationRho",             'd', 'd', offsetof( antAeroRecord, calibrationRho ),     true  },
+    { "airSpeedMultiplier",         'd', 'd', offsetof( antAeroRecord, airSpeedMultiplier ), true  },
+    { "currentRho",                 'd', 'd', offsetof( antAeroRecord, currentRho ),         true  },
+    { NULL,                         0,   0,   0,                                             false }
+};
+
+const antBinaryField C_WEIGHT_SCALE_FIELDS[] =
+{
+    { "userProfile",                'u', 'u', offsetof( antWeightScaleRecord, userProfile ), false },
+    { "value1",                     'u', 'u', offsetof( antWeightScaleRecord, value1 ),      false },
+    { "value2",                     'u', 'u', offsetof( antWeightScaleRecord, value2 ),      false },
+    { "age",                        'u', 'u', offsetof( antWeightScaleRecord, age ),         false },
+    { "userHeight",                 'u', 'u', offsetof( antWeightScaleRecord, userHeight ),  false },
+    { "descriptBit",                'u', 'u', offsetof( antWeightScaleRecord, descriptBit ), false },
+    { NULL,                         0,   0,   0,                                             false }
+};
+
+const antBinaryField C_AUDIO_PAGE1_FIELDS[] =
+{
+    { "volume",                     'u', 'u', offsetof( antAudioPage1Record, volume ),           false },
+    { "totalTrackTime",             'u', 'u', offsetof( antAudioPage1Record, totalTrackTime ),   false },
+    { "currentTrackTime",           'u', 'u', offsetof( antAudioPage1Record, currentTrackTime ), false },
+    { "state",                      'u', 'u', offsetof( antAudioPage1Record, state ),            false },
+    { NULL,                         0,   0,   0,                                                 false }
+};
+
+const antBinaryField C_AUDIO_PAGE16_FIELDS[] =
+{
+    { "serialNumber",               'u', 'u', offsetof( antAudioPage16Record, serialNumber ),  false },
+    { "commandNumber",              'u', 'u', offsetof( antAudioPage16Record, commandNumber ), false },
+    { NULL,                         0,   0,   0,                                               false }
+};
+
+const antBinaryField C_STRIDE_SPEED_DIST_FIELDS[] =
+{
+    { "value1",                     'u', 'u', offsetof( antStrideSpeedDistRecord, value1 ), false },
+    { "value2",                     'u', 'u', offsetof( antStrideSpeedDistRecord, value2 ), false },
+    { "value3",                     'u', 'u', offsetof( antStrideSpeedDistRecord, value3 ), false },
+    { "value4",                     'u', 'u', offsetof( antStrideSpeedDistRecord, value4 ), false },
+    { "value5",                     'u', 'u', offsetof( antStrideSpeedDistRecord, value5 ), false },
+    { "value6",                     'u', 'u', offsetof( antStrideSpeedDistRecord, value6 ), false },
+    { "value7",                     'u', 'u', offsetof( antStrideSpeedDistRecord, value7 ), false },
+    { "value8",                     'u', 'u', offsetof( antStrideSpeedDistRecord, value8 ), false },
+    { NULL,                         0,   0,   0,                                            false }
+};
+
+const antBinaryField C_MULTI_SPORT_FIELDS[] =
+{
+    { "value1",                     'u', 'u', offsetof( antMultiSportRecord, value1 ),        false },
+    { "value2",                     'u', 'u', offsetof( antMultiSportRecord, value2 ),        false },
+    { "value3",                     'u', 'u', offsetof( antMultiSportRecord, value3 ),        false },
+    { "totalTime",                  'd', 'd', offsetof( antMultiSportRecord, totalTime ),     true  },
+    { "totalDistance",              'd', 'd', offsetof( antMultiSportRecord, totalDistance ), true  },
+    { "heading",                    'd', 'd', offsetof( antMultiSportRecord, heading ),       true  },
+    { NULL,                         0,   0,   0,                                              false }
+};
+
+const antBinaryRecordType C_RECORD_TYPES[] =
+{
+    { ANT_HRM_RECORD,               "HRM",         C_BINARY_PAGE_IN_RECORD, offsetof( antHRMRecord, dataPage ),              C_HRM_FIELDS },
+    { ANT_POWER_B01_RECORD,         "PWRB01",      0x01,                    0,                                               C_POWER_B01_FIELDS },
+    { ANT_POWER_B02_RECORD,         "PWRB02",      0x02,                    0,                                               C_POWER_B02_FIELDS },
+    { ANT_POWER_B03_RECORD,         "PWRB03",      0x03,                    0,                                               C_POWER_B03_FIELDS },
+    { ANT_POWER_B10_RECORD,         "PWRB10",      0x10,                    0,                                               C_POWER_B10_FIELDS },
+    { ANT_POWER_B11_RECORD,         "PWRB11",      0x11,                    0,                                               C_POWER_B11_FIELDS },
+    { ANT_POWER_B12_RECORD,         "PWRB12",      0x12,                    0,                                               C_POWER_B12_FIELDS },
+    { ANT_POWER_B13_RECORD,         "PWRB13",      0x13,                    0,                                               C_POWER_B13_FIELDS },
+    { ANT_POWER_B20_RECORD,         "PWRB20",      0x20,                    0,                                               C_POWER_B20_FIELDS },
+    { ANT_COMMON_PAGE67_RECORD,     "COMMON67",    0x43,                    0,                                               C_COMMON_PAGE67_FIELDS },
+    { ANT_COMMON_PAGE68_RECORD,     "COMMON68",    0x44,                    0,                                               C_COMMON_PAGE68_FIELDS },
+    { ANT_COMMON_PAGE70_RECORD,     "COMMON70",    0x46,                    0,                                               C_COMMON_PAGE70_FIELDS },
+    { ANT_COMMON_PAGE80_RECORD,     "COMMON80",    0x50,                    0,                                               C_COMMON_PAGE80_FIELDS },
+    { ANT_COMMON_PAGE81_RECORD,     "COMMON81",    0x51,                    0,                                               C_COMMON_PAGE81_FIELDS },
+    { ANT_COMMON_PAGE82_RECORD,     "COMMON82",    0x52,                    0,                                               C_COMMON_PAGE82_FIELDS },
+    { ANT_COMMON_PAGE83_RECORD,     "COMMON83",    0x53,                    0,                                               C_COMMON_PAGE83_FIELDS },
+    { ANT_COMMON_PAGE84_RECORD,     "COMMON84",    0x54,                    0,                                               C_COMMON_PAGE84_FIELDS },
+    { ANT_ENVIRONMENT_PAGE0_RECORD, "ENV0",        C_BINARY_PAGE_IN_RECORD, offsetof( antEnvironmentPage0Record, dataPage ), C_ENVIRONMENT_PAGE0_FIELDS },
+    { ANT_ENVIRONMENT_PAGE1_RECORD, "ENV1",        C_BINARY_PAGE_IN_RECORD, offsetof( antEnvironmentPage1Record, dataPage ), C_ENVIRONMENT_PAGE1_FIELDS },
+    { ANT_CADENCE_RECORD,           "CAD7A",       C_BINARY_PAGE_IN_RECORD, offsetof( antCadenceRecord, dataPage ),          C_CADENCE_FIELDS },
+    { ANT_SPEED_RECORD,             "SPB7",        C_BINARY_PAGE_IN_RECORD, offsetof( antSpeedRecord, dataPage ),            C_SPEED_FIELDS },
+    { ANT_SPEED_CADENCE_RECORD,     "SPCAD790",    0x00,                    0,                                               C_SPEED_CADENCE_FIELDS },
+    { ANT_AERO_RECORD,              "AERO",        0x00,                    0,                                               C_AERO_FIELDS },
+    { ANT_WEIGHT_SCALE_RECORD,      "WEIGHT",      C_BINARY_PAGE_IN_RECORD, offsetof( antWeightScaleRecord, dataPage ),      C_WEIGHT_SCALE_FIELDS },
+    { ANT_AUDIO_PAGE1_RECORD,       "AUDIO1",      C_BINARY_PAGE_IN_RECORD, offsetof( antAudioPage1Record, dataPage ),       C_AUDIO_PAGE1_FIELDS },
+    { ANT_AUDIO_PAGE16_RECORD,      "AUDIO16",     C_BINARY_PAGE_IN_RECORD, offsetof( antAudioPage16Record, dataPage ),      C_AUDIO_PAGE16_FIELDS },
+    { ANT_STRIDE_SPEED_DIST_RECORD, "SBSDM",       C_BINARY_PAGE_IN_RECORD, offsetof( antStrideSpeedDistRecord, dataPage ),  C_STRIDE_SPEED_DIST_FIELDS },
+    { ANT_MULTI_SPORT_RECORD,       "MSSDM",       C_BINARY_PAGE_IN_RECORD, offsetof( antMultiSportRecord, dataPage ),       C_MULTI_SPORT_FIELDS },
+    { ANT_UNSUPPORTED_PAGE_RECORD,  "UNSUPPORTED", C_BINARY_PAGE_IN_RECORD, offsetof( antUnsupportedPageRecord, dataPage ),  C_UNSUPPORTED_PAGE_FIELDS },
+    { 0,                            NULL,          0,                       0,                                               NULL }
+};
+
+static const antBinaryRecordType *findRecordType
+(
+    int recordType
+)
+{
+    const antBinaryRecordType *result = C_RECORD_TYPES;
+    while ( ( result->name != NULL ) && ( result->recordType != recordType ) )
+    {
+        ++result;
+    }
+    return ( result->name != NULL ) ? result : NULL;
+}
+
+static bool isWireType
+(
+    char wireType
+)
+{
+    return ( wireType == 'u' ) || ( wireType == 'i' ) || ( wireType == '?' ) || ( wireType == 'd' );
+}
+
+static void appendName
+(
+    amString       &buffer,
+    const amString &name
+)
+{
+    size_t length = ( name.size() < C_MAX_NAME_LENGTH ) ? name.size() : C_MAX_NAME_LENGTH;
+    amAppendLittleEndian( buffer, length, 1 );
+    buffer.append( name, 0, length );
+}
+
+static void appendField
+(
+    amString             &buffer,
+    const antBinaryField &field,
+    const void           *record
+)
+{
+    const char         *member = ( const char * ) record + field.offset;
+    unsigned long long  value  = 0;
+    double              number = 0;
+
+    switch ( field.memberType )
+    {
+        case 'u':
+             value = *( const unsigned int * ) member;
+             break;
+        case 'i':
+             value = ( unsigned long long ) ( long long ) *( const int * ) member;
+             break;
+        case 'c':
+             value = *( const unsigned char * ) member;
+             break;
+        case 'b':
+             value = *( const bool * ) member ? 1 : 0;
+             break;
+        case 'd':
+             number = *( const double * ) member;
+             memcpy( &value, &number, sizeof( value ) );
+             break;
+    }
+
+    switch ( field.wireType )
+    {
+        case 'u':
+             amAppendVarint( buffer, value );
+             break;
+        case 'i':
+             amAppendVarint( buffer, amZigZagEncode( ( long long ) value ) );
+             break;
+        case '?':
+             amAppendLittleEndian( buffer, value, 1 );
+             break;
+        case 'd':
+             amAppendLittleEndian( buffer, value, 8 );
+             break;
+    }
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Header of a stream: format version, flags and the layout of the records.
+//
+// -------------------------------------------------------------------------------------------------//
+void antBinaryFormatter::appendStreamHeader
+(
+    void
+)
+{
+    const antBinaryRecordType *recordType = NULL;
+    const antBinaryField      *field      = NULL;
+    unsigned int               nbTypes    = 0;
+    unsigned int               nbFields   = 0;
+
+    for ( recordType = C_RECORD_TYPES; recordType->name != NULL; ++recordType )
+    {
+        ++nbTypes;
+    }
+
+    outBuffer.append( C_BINARY_MAGIC, C_BINARY_MAGIC_LENGTH );
+    amAppendLittleEndian( outBuffer, C_BINARY_FORMAT_VERSION, 1 );
+    amAppendLittleEndian( outBuffer, ( semiCooked ? C_BINARY_FLAG_SEMI_COOKED : 0 ) | ( jsonText ? C_BINARY_FLAG_JSON_TEXT : 0 ), 1 );
+    amAppendLittleEndian( outBuffer, nbTypes, 1 );
+
+    for ( recordType = C_RECORD_TYPES; recordType->name != NULL; ++recordType )
+    {
+        amAppendLittleEndian( outBuffer, recordType->recordType, 1 );
+        appendName( outBuffer, recordType->name );
+
+        nbFields = 0;
+        for ( field = recordType->fields; field->name != NULL; ++field )
+        {
+            if ( !field->cooked || !semiCooked )
+            {
+                ++nbFields;
+            }
+        }
+        amAppendLittleEndian( outBuffer, nbFields, 1 );
+        for ( field = recordType->fields; field->name != NULL; ++field )
+        {
+            if ( !field->cooked || !semiCooked )
+            {
+                outBuffer.push_back( field->wireType );
+                appendName( outBuffer, field->name );
+            }
+        }
+    }
+}
+
+void antBinaryFormatter::appendText
+(
+    const amString &text
+)
+{
+    outBuffer.push_back( C_BLOCK_TEXT );
+    amAppendVarint( outBuffer, text.size() );
+    outBuffer.append( text );
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Handle of the sensor and version of a record, a new one is defined in the stream first.
+//
+// -------------------------------------------------------------------------------------------------//
+antBinaryFormatter::sensorHandle &antBinaryFormatter::getHandle
+(
+    const antRecordContext &context
+)
+{
+    handleKey  = context.sensorID;
+    handleKey += '\t';
+    handleKey += context.version;
+
+    std::map<amString, sensorHandle>::iterator found = handles.find( handleKey );
+    if ( found == handles.end() )
+    {
+        sensorHandle newHandle;
+        newHandle.handle        = nextHandle;
+        newHandle.lastTimeStamp = 0;
+        nextHandle             += handleStep;
+        found                   = handles.insert( std::make_pair( handleKey, newHandle ) ).first;
+
+        outBuffer.push_back( C_BLOCK_DEFINITION );
+        amAppendVarint( outBuffer, newHandle.handle );
+        appendName( outBuffer, context.sensorID );
+        appendName( outBuffer, context.version );
+    }
+    return found->second;
+}
+
+void antBinaryFormatter::formatRecord
+(
+    int                     recordType,
+    const antRecordContext &context,
+    const void             *record
+)
+{
+    const antBinaryRecordType       *type        = findRecordType( recordType );
+    sensorHandle                    &handle      = getHandle( context );
+    std::vector<unsigned long long> &lastDoubles = handle.lastDoubles[ recordType ];
+    unsigned int                     dataPage    = type->dataPage;
+    long long                        timeStamp   = 0;
+    unsigned long long               repeated    = 0;
+    unsigned long long               bits        = 0;
+    unsigned int                     nbDoubles   = 0;
+
+    if ( dataPage == C_BINARY_PAGE_IN_RECORD )
+    {
+        dataPage = *( const unsigned int * ) ( ( const char * ) record + type->pageOffset );
+    }
+
+    if ( !context.timeStamp.parseMicroseconds( timeStamp ) )
+    {
+        timeStamp = 0;
+    }
+
+    outBuffer.push_back( C_BLOCK_RECORD );
+    amAppendLittleEndian( outBuffer, recordType, 1 );
+    amAppendVarint( outBuffer, handle.handle );
+    amAppendVarint( outBuffer, dataPage );
+    amAppendVarint( outBuffer, amZigZagEncode( timeStamp - handle.lastTimeStamp ) );
+    handle.lastTimeStamp = timeStamp;
+
+    // Most cooked values (wheel circumference, totals, ...) do not change from one page to the next.
+    for ( const antBinaryField *field = type->fields; field->name != NULL; ++field )
+    {
+        if ( ( field->wireType == 'd' ) && ( !field->cooked || !semiCooked ) )
+        {
+            memcpy( &bits, ( const char * ) record + field->offset, sizeof( bits ) );
+            if ( nbDoubles >= lastDoubles.size() )
+            {
+                lastDoubles.push_back( bits );
+            }
+            else if ( ( lastDoubles[ nbDoubles ] == bits ) && ( nbDoubles < C_MAX_REPEATED_DOUBLES ) )
+            {
+                repeated |= 1ULL << nbDoubles;
+            }
+            else
+            {
+                lastDoubles[ nbDoubles ] = bits;
+            }
+            ++nbDoubles;
+        }
+    }
+    if ( nbDoubles > 0 )
+    {
+        amAppendVarint( outBuffer, repeated );
+    }
+
+    nbDoubles = 0;
+    for ( const antBinaryField *field = type->fields; field->name != NULL; ++field )
+    {
+        if ( ( field->wireType == 'd' ) && ( !field->cooked || !semiCooked ) )
+        {
+            if ( ( nbDoubles >= C_MAX_REPEATED_DOUBLES ) || ( ( repeated & ( 1ULL << nbDoubles ) ) == 0 ) )
+            {
+                appendField( outBuffer, *field, record );
+            }
+            ++nbDoubles;
+        }
+        else if ( !field->cooked || !semiCooked )
+        {
+            appendField( outBuffer, *field, record );
+        }
+    }
+}
+
+bool antBinaryReader::readBytes
+(
+    std::istream &inStream,
+    size_t        nbBytes
+)
+{
+    block.resize( nbBytes + 1 );
+    inStream.read( &( block[ 0 ] ), nbBytes );
+    return ( ( size_t ) inStream.gcount() == nbBytes );
+}
+
+bool antBinaryReader::readName
+(
+    std::istream &inStream,
+    amString     &name
+)
+{
+    bool result = readBytes( inStream, 1 );
+    if ( result )
+    {
+        size_t length = ( unsigned char ) block[ 0 ];
+        result = readBytes( inStream, length );
+        if ( result )
+        {
+            name.assign( &( block[ 0 ] ), length );
+        }
+    }
+    return result;
+}
+
+bool antBinaryReader::readVarint
+(
+    std::istream       &inStream,
+    unsigned long long &value
+)
+{
+    char         byte   = 0;
+    unsigned int shift  = 0;
+    bool         result = true;
+    bool         more   = true;
+
+    value = 0;
+    while ( result && more )
+    {
+        result = ( shift < 64 ) && inStream.get( byte );
+        if ( result )
+        {
+            value |= ( unsigned long long ) ( byte & 0x7F ) << shift;
+            more   = ( ( byte & 0x80 ) != 0 );
+            shift += 7;
+        }
+    }
+    return result;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Read a field of a record into its member, or only skip it if 'field' is NULL (field unknown to
+// this version). The wire type of a field may differ from the one written by this version.
+// 'lastDouble' is the value of a double field in the previous record of the sensor: it is taken
+// instead if the field is 'repeated', and updated otherwise.
+//
+// -------------------------------------------------------------------------------------------------//
+bool antBinaryReader::readField
+(
+    std::istream         &inStream,
+    char                  wireType,
+    bool                  repeated,
+    double               &lastDouble,
+    const antBinaryField *field,
+    void                 *record
+)
+{
+    bool               result      = false;
+    unsigned long long value       = 0;
+    long long          signedValue = 0;
+    double             number      = 0;
+
+    switch ( wireType )
+    {
+        case 'u':
+             result      = readVarint( inStream, value );
+             signedValue = ( long long ) value;
+             break;
+        case 'i':
+             result      = readVarint( inStream, value );
+             signedValue = amZigZagDecode( value );
+             break;
+        case '?':
+             result      = readBytes( inStream, 1 );
+             signedValue = result ? ( unsigned char ) block[ 0 ] : 0;
+             break;
+        case 'd':
+             result = repeated || readBytes( inStream, 8 );
+             if ( result && !repeated )
+             {
+                 value = amReadLittleEndian( &( block[ 0 ] ), 8 );
+                 memcpy( &lastDouble, &value, sizeof( lastDouble ) );
+             }
+             number      = lastDouble;
+             signedValue = ( long long ) number;
+             break;
+    }
+    if ( wireType != 'd' )
+    {
+        number = ( double ) signedValue;
+    }
+
+    if ( result && ( field != NULL ) )
+    {
+        char *member = ( char * ) record + field->offset;
+        switch ( field->memberType )
+        {
+            case 'u':
+                 *( unsigned int * ) member = ( unsigned int ) signedValue;
+                 break;
+            case 'i':
+                 *( int * ) member = ( int ) signedValue;
+                 break;
+            case 'c':
+                 *( unsigned char * ) member = ( unsigned char ) signedValue;
+                 break;
+            case 'b':
+                 *( bool * ) member = ( number != 0 );
+                 break;
+            case 'd':
+                 *( double * ) member = number;
+                 break;
+        }
+    }
+    return result;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Read the header of a stream and match the fields it describes with the records known here.
+//
+// -------------------------------------------------------------------------------------------------//
+int antBinaryReader::readHeader
+(
+    std::istream &inStream,
+    amString     &message
+)
+{
+    bool                       valid      = false;
+    unsigned int               nbTypes    = 0;
+    unsigned int               nbFields   = 0;
+    unsigned int               typeNo     = 0;
+    const antBinaryRecordType *recordType = NULL;
+    amString                   name;
+    schemaField                field;
+
+    schema.clear();
+    schema.resize( 256 );
+    sensors.clear();
+
+    valid = readBytes( inStream, C_BINARY_MAGIC_LENGTH + 3 ) &&
+            ( memcmp( &( block[ 0 ] ), C_BINARY_MAGIC, C_BINARY_MAGIC_LENGTH ) == 0 ) &&
+            ( ( unsigned char ) block[ C_BINARY_MAGIC_LENGTH ] == C_BINARY_FORMAT_VERSION );
+    if ( valid )
+    {
+        semiCooked = ( ( block[ C_BINARY_MAGIC_LENGTH + 1 ] & C_BINARY_FLAG_SEMI_COOKED ) != 0 );
+        jsonText   = ( ( block[ C_BINARY_MAGIC_LENGTH + 1 ] & C_BINARY_FLAG_JSON_TEXT ) != 0 );
+        nbTypes    = ( unsigned char ) block[ C_BINARY_MAGIC_LENGTH + 2 ];
+    }
+
+    for ( unsigned int counter = 0; valid && ( counter < nbTypes ); ++counter )
+    {
+        valid = readBytes( inStream, 1 );
+        if ( valid )
+        {
+            typeNo = ( unsigned char ) block[ 0 ];
+            valid  = readName( inStream, name ) && readBytes( inStream, 1 );
+        }
+        if ( valid )
+        {
+            schemaRecord &thisRecord = schema[ typeNo ];
+            recordType           = findRecordType( typeNo );
+            nbFields             = ( unsigned char ) block[ 0 ];
+            thisRecord.described = true;
+            thisRecord.known     = ( recordType != NULL );
+            thisRecord.nbDoubles = 0;
+            thisRecord.fields.clear();
+            for ( unsigned int fieldNo = 0; valid && ( fieldNo < nbFields ); ++fieldNo )
+            {
+                valid = readBytes( inStream, 1 );
+                if ( valid )
+                {
+                    field.wireType = block[ 0 ];
+                    field.target   = NULL;
+                    if ( field.wireType == 'd' )
+                    {
+                        ++thisRecord.nbDoubles;
+                    }
+                    valid          = isWireType( field.wireType ) && readName( inStream, name );
+                }
+                if ( valid && ( recordType != NULL ) )
+                {
+                    for ( const antBinaryField *known = recordType->fields; known->name != NULL; ++known )
+                    {
+                        if ( name == known->name )
+                        {
+                            field.target = known;
+                            break;
+                        }
+                    }
+                }
+                if ( valid )
+                {
+                    thisRecord.fields.push_back( field );
+                }
+            }
+        }
+    }
+
+    if ( !valid )
+    {
+        message += "The input is not a binary stream (see option '-E').\n";
+    }
+    return valid ? 0 : E_READ_ERROR;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Read the next record or text block. Sensor definitions and records of types unknown to this
+// version are taken in passing.
+//
+// -------------------------------------------------------------------------------------------------//
+int antBinaryReader::next
+(
+    std::istream  &inStream,
+    antBinaryItem &item,
+    amString      &message
+)
+{
+    int                result     = 0;
+    bool               found      = false;
+    bool               valid      = true;
+    bool               isRepeated = false;
+    char               kind       = 0;
+    unsigned int       typeNo     = 0;
+    unsigned int       nbDoubles  = 0;
+    unsigned long long handle     = 0;
+    unsigned long long page       = 0;
+    unsigned long long timeDelta  = 0;
+    unsigned long long repeated   = 0;
+    unsigned long long length     = 0;
+    double             noDouble   = 0;
+
+    while ( ( result == 0 ) && !found )
+    {
+        if ( !inStream.get( kind ) )
+        {
+            result = E_END_OF_FILE;
+        }
+        else if ( kind == C_BLOCK_DEFINITION )
+        {
+            valid = readVarint( inStream, handle );
+            if ( valid )
+            {
+                sensorDefinition &definition = sensors[ handle ];
+                definition.lastTimeStamp = 0;
+                definition.lastDoubles.clear();
+                valid = readName( inStream, definition.sensorID ) && readName( inStream, definition.version );
+            }
+        }
+        else if ( kind == C_BLOCK_RECORD )
+        {
+            valid = readBytes( inStream, 1 ) && readVarint( inStream, handle ) && readVarint( inStream, page ) && readVarint( inStream, timeDelta );
+            if ( valid )
+            {
+                typeNo = ( unsigned char ) block[ 0 ];
+                valid  = schema[ typeNo ].described && ( sensors.count( handle ) > 0 );
+            }
+            if ( valid )
+            {
+                const schemaRecord        &thisRecord  = schema[ typeNo ];
+                const antBinaryRecordType *recordType  = findRecordType( typeNo );
+                sensorDefinition          &definition  = sensors[ handle ];
+                std::vector<double>       &lastDoubles = definition.lastDoubles[ typeNo ];
+                void                      *record      = &( item.record );
+
+                definition.lastTimeStamp += amZigZagDecode( timeDelta );
+                memset( record, 0, sizeof( item.record ) );
+                repeated  = 0;
+                nbDoubles = 0;
+                lastDoubles.resize( thisRecord.nbDoubles, 0 );
+                if ( thisRecord.nbDoubles > 0 )
+                {
+                    valid = readVarint( inStream, repeated );
+                }
+                for ( size_t counter = 0; valid && ( counter < thisRecord.fields.size() ); ++counter )
+                {
+                    const schemaField &field = thisRecord.fields[ counter ];
+                    if ( field.wireType == 'd' )
+                    {
+                        isRepeated = ( nbDoubles < C_MAX_REPEATED_DOUBLES ) && ( ( ( repeated >> nbDoubles ) & 1 ) != 0 );
+                        valid      = readField( inStream, field.wireType, isRepeated, lastDoubles[ nbDoubles ], field.target, record );
+                        ++nbDoubles;
+                    }
+                    else
+                    {
+                        valid = readField( inStream, field.wireType, false, noDouble, field.target, record );
+                    }
+                }
+                if ( valid && thisRecord.known )
+                {
+                    item.itemType  = typeNo;
+                    item.sensorID  = definition.sensorID;
+                    item.version   = definition.version;
+                    item.timeStamp = definition.lastTimeStamp;
+                    if ( recordType->dataPage == C_BINARY_PAGE_IN_RECORD )
+                    {
+                        *( unsigned int * ) ( ( char * ) record + recordType->pageOffset ) = ( unsigned int ) page;
+                    }
+                    found = true;
+                }
+            }
+        }
+        else if ( kind == C_BLOCK_TEXT )
+        {
+            valid = readVarint( inStream, length ) && readBytes( inStream, ( size_t ) length );
+            if ( valid )
+            {
+                item.itemType = C_BINARY_TEXT_ITEM;
+                item.text.assign( &( block[ 0 ] ), ( size_t ) length );
+                found = true;
+            }
+        }
+        else
+        {
+            valid = false;
+        }
+
+        if ( !valid )
+        {
+            message += "Invalid or truncated block in the binary input.\n";
+            result   = E_READ_ERROR;
+        }
+    }
+    return result;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Time stamp in the text form of the output (seconds with 'precision' decimals).
+//
+// -------------------------------------------------------------------------------------------------//
+amString antBinaryReader::formatTimeStamp
+(
+    long long microseconds,
+    int       precision
+)
+{
+    amString result;
+    result.appendFixedPoint( microseconds, C_MICROSECOND_DIGITS, precision );
+    return result;
+}
@@ -0,0 +1,154 @@
+#ifndef __ANT_BINARY_FORMAT_H__
+#define __ANT_BINARY_FORMAT_H__
+
+#include <istream>
+#include <map>
+#include <vector>
+
+#include "am_string.h"
+#include "ant_record_formatter.h"
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Binary output (-E) and input (-e).
+// All numbers are little-endian. A 'varint' is an unsigned integer written with as few bytes as
+// needed (see amAppendVarint() in am_little_endian.h). A stream starts with a header describing the
+// records:
+//
+//     "ANTB", format version (1 byte), flags (1 byte, bit 0: semi-cooked values, bit 1: JSON text),
+//     number of record types (1 byte) and per record type:
+//         record type (1 byte, see antRecordType), name length (1 byte), name,
+//         number of fields (1 byte) and per field: wire type (1 byte), name length (1 byte), name
+//
+// followed by blocks, each starting with its kind (1 byte):
+//
+//     'D' sensor definition: handle (varint), sensor ID length (1 byte), sensor ID,
+//         version length (1 byte), version. Written before the first record using the handle.
+//     'R' record: record type (1 byte), handle (varint), data page (varint), time stamp in
+//         microseconds minus the one of the previous record of the handle (signed varint, the
+//         first record of a handle holds its time stamp), then the fields in the order of the header.
+//     'T' text: length (varint), text. The output which is not a data page (bridge information,
+//         unknown packets, ...), in the text format selected when the stream was written (JSON
+//         objects if flag bit 1 is set). A reader cannot convert it, so it must output the stream
+//         in that format.
+//
+// The data page written in a record is the one of its type, or the one in the record (see
+// antBinaryRecordType::dataPage in ant_binary_format.cpp).
+// Wire types: 'u' varint, 'i' signed varint (see amZigZagEncode()), '?' 1 byte boolean, 'd' IEEE 754
+// double (8 bytes). The cooked fields of a record are left out of semi-cooked streams.
+// A reader takes the fields it knows by name and skips the others, so fields may be added.
+//
+// -------------------------------------------------------------------------------------------------//
+
+const int C_BINARY_TEXT_ITEM = 0;   // antBinaryItem::itemType of a text block
+
+struct antBinaryField;
+
+class antBinaryFormatter : public antRecordFormatter
+{
+
+    private:
+
+        struct sensorHandle
+        {
+            unsigned int                                    handle;
+            long long                                       lastTimeStamp;    // Microseconds
+            std::map<int, std::vector<unsigned long long> > lastDoubles;      // Bits of the doubles per record type
+        };
+
+        amString                        &outBuffer;
+        const bool                      &semiCooked;
+        const bool                      &jsonText;
+        std::map<amString, sensorHandle> handles;
+        amString                         handleKey;
+        unsigned int                     nextHandle;
+        unsigned int                     handleStep;
+
+        sensorHandle &getHandle( const antRecordContext &context );
+
+
+    public:
+
+        antBinaryFormatter( amString &buffer, const bool &semiCookedIn, const bool &jsonTextIn )
+            : outBuffer( buffer ), semiCooked( semiCookedIn ), jsonText( jsonTextIn ), nextHandle( 0 ), handleStep( 1 ) {}
+
+        // Decode threads number the sensors they see as 'first', 'first' + 'step', ... so the handles
+        // stay unique when their output is merged.
+        inline void setHandleNumbering( unsigned int first, unsigned int step ) { nextHandle = first; handleStep = step; }
+
+        void appendStreamHeader( void );
+        void appendText( const amString &text );
+
+
+
+    protected:
+
+        virtual void formatRecord( int recordType, const antRecordContext &context, const void *record );
+
+};
+
+// A record or text block read from a binary stream.
+struct antBinaryItem
+{
+    int               itemType;     // C_BINARY_TEXT_ITEM or an antRecordType
+    amString          sensorID;
+    amString          version;
+    long long         timeStamp;    // Microseconds
+    amString          text;
+    antRecord         record;       // Member of the union selected by itemType
+};
+
+class antBinaryReader
+{
+
+    private:
+
+        struct schemaField
+        {
+            char                  wireType;
+            const antBinaryField *target;    // NULL: field unknown to this version, skipped
+        };
+
+        struct schemaRecord
+        {
+            bool                     described;    // Listed in the header of the stream
+            bool                     known;        // Record type known to this version
+            unsigned int             nbDoubles;    // Number of 'd' fields
+            std::vector<schemaField> fields;
+        };
+
+        struct sensorDefinition
+        {
+            amString                                     sensorID;
+            amString                                     version;
+            long long                                    lastTimeStamp;
+            std::map<unsigned int, std::vector<double> > lastDoubles;    // Per record type
+        };
+
+        bool                                           semiCooked;
+        bool                                           jsonText;
+        std::vector<schemaRecord>                      schema;
+        std::map<unsigned long long, sensorDefinition> sensors;
+        std::vector<char>                              block;
+
+        bool readBytes ( std::istream &inStream, size_t nbBytes );
+        bool readName  ( std::istream &inStream, amString &name );
+        bool readVarint( std::istream &inStream, unsigned long long &value );
+        bool readField ( std::istream &inStream, char wireType, bool repeated, double &lastDouble, const antBinaryField *field, void *record );
+
+
+    public:
+
+        antBinaryReader( void ) : semiCooked( false ), jsonText( false ) {}
+
+        inline bool getSemiCooked( void ) const { return semiCooked; }
+        inline bool getJSONText  ( void ) const { return jsonText; }
+
+        int readHeader( std::istream &inStream, amString &message );
+        int next      ( std::istream &inStream, antBinaryItem &item, amString &message );
+
+        static amString formatTimeStamp( long long microseconds, int precision );
+
+};
+
+#endif // __ANT_BINARY_FORMAT_H__
@@ -72,16 +72,16 @@ bool antBloodPressureProcessing::appendBloodPressureSensor
 //-------------------------------------------------------------------------------------------------//
 amDeviceType antBloodPressureProcessing::processBloodPressureSensor
 (
-    const amString &deviceIDNo,
+    unsigned int    deviceIDNo,
     const amString &timeStampBuffer,
     BYTE            payLoad[]
 )
 {
-    amDeviceType result       = OTHER_DEVICE;
-    amString  sensorID        = amString( C_BLDPR_DEVICE_HEAD ) + deviceIDNo;
-    unsigned int dataPage     = 0;
-    bool         commonPage   = false;
-    bool         outputPageNo = true;
+    amDeviceType    result          = OTHER_DEVICE;
+    antSensorHandle sensorID        = sensorStates.intern( C_BLDPR_DEVICE_HEAD, deviceIDNo );
+    unsigned int    dataPage        = 0;
+    bool            commonPage      = false;
+    bool            outputPageNo    = true;
 
     if ( isRegisteredDevice( sensorID ) )
     {
@@ -103,20 +103,12 @@ amDeviceType antBloodPressureProcessing::processBloodPressureSensor
 
     if ( result == BLOOD_PRESSURE_SENSOR )
     {
-        createOutputHeader( sensorID, timeStampBuffer );
-        if ( commonPage )
+        // The blood pressure sensors are only decoded as far as the common data pages.
+        commonPage = processCommonPages( sensorID, timeStampBuffer, getVersion(), payLoad, outputPageNo );
+        if ( !commonPage )
         {
-            commonPage = processCommonPages( sensorID, payLoad, outputPageNo );
-            if ( !commonPage )
-            {
-                result = OTHER_DEVICE;
-            }
-        }
-        else
-        {
-            createBLDPRResultString( dataPage );
+            result = OTHER_DEVICE;
         }
-        appendOutputFooter( getVersion() );
     }
 
     if ( result == OTHER_DEVICE )
@@ -124,7 +116,7 @@ amDeviceType antBloodPressureProcessing::processBloodPressureSensor
         resetOutBuffer();
         if ( outputUnknown )
         {
-            int deviceIDNoAsInt = deviceIDNo.toInt();
+            int deviceIDNoAsInt = ( int ) deviceIDNo;
             createUnknownDeviceTypeString( C_BLDPR_TYPE, deviceIDNoAsInt, timeStampBuffer, payLoad );
         }
     }
@@ -199,20 +191,12 @@ amDeviceType antBloodPressureProcessing::processBloodPressureSensorSemiCooked
                 appendDiagnosticsLine( "Version", curVersion );
             }
         }
-        createOutputHeader( sensorID, timeStampBuffer );
-        if ( commonPage )
-        {
-            commonPage = processCommonPagesSemiCooked( words, startCounter, outputPageNo );
-            if ( !commonPage )
-            {
-                result = OTHER_DEVICE;
-            }
-        }
-        else
+        // The blood pressure sensors are only decoded as far as the common data pages.
+        commonPage = processCommonPagesSemiCooked( words, startCounter, curVersion, outputPageNo );
+        if ( !commonPage )
         {
-            createBLDPRResultString( dataPage );
+            result = OTHER_DEVICE;
         }
-        appendOutputFooter( curVersion );
     }
     else if ( result == UNKNOWN_DEVICE )
     {
@@ -240,7 +224,7 @@ amDeviceType antBloodPressureProcessing::processBloodPressureSensorSemiCooked
 //
 // Parameters:
 //    int             deviceType        IN   Device type
-//    const amString &deviceID          IN   Device ID (number).
+//    unsigned int    deviceID          IN   Device ID (number).
 //    const amString &timeStampBuffer   IN   Time stamp.
 //    BYTE            payLoad[]         IN   Array of bytes with the data to be converted.
 //
@@ -252,7 +236,7 @@ amDeviceType antBloodPressureProcessing::processBloodPressureSensorSemiCooked
 amDeviceType antBloodPressureProcessing::processSensor
 (
     int             deviceType,
-    const amString &deviceIDNo,
+    unsigned int    deviceIDNo,
     const amString &timeStampBuffer,
     BYTE            payLoad[]
 )
@@ -268,7 +252,7 @@ amDeviceType antBloodPressureProcessing::processSensor
         resetOutBuffer();
         if ( outputUnknown )
         {
-            int deviceIDNoAsInt = deviceIDNo.toInt();
+            int deviceIDNoAsInt = ( int ) deviceIDNo;
             createUnknownDeviceTypeString( deviceType, deviceIDNoAsInt, timeStampBuffer, payLoad );
         }
     }
@@ -342,18 +326,3 @@ void antBloodPressureProcessing::readDeviceFileLine
     }
 }
 
-void antBloodPressureProcessing::createBLDPRResultString
-(
-    unsigned int dataPage
-)
-{
-    if ( outputAsJSON )
-    {
-        appendJSONItem( "data page", dataPage );
-    }
-    else
-    {
-        appendOutput( dataPage );
-    }
-}
-
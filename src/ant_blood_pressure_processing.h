@@ -8,7 +8,7 @@ class antBloodPressureProcessing : virtual public antProcessing
 
     protected:
 
-        amDeviceType processBloodPressureSensor( const amString &deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
+        amDeviceType processBloodPressureSensor( unsigned int deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
         amDeviceType processBloodPressureSensorSemiCooked( const amString &inputBuffer );
 
         virtual void readDeviceFileLine( const char *line );
@@ -23,11 +23,11 @@ class antBloodPressureProcessing : virtual public antProcessing
 
         bool isBloodPressureSensor( const amString &deviceID );
 
-        virtual amDeviceType processSensor( int deviceType, const amString &deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
+        virtual amDeviceType processSensor( int deviceType, unsigned int deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
         virtual amDeviceType processSensorSemiCooked( const amString &inputBuffer );
 
-        void createBLDPRResultString( unsigned int dataPage );
         virtual void reset( void );
+        virtual antProcessing *createWorker( void ) const { return new antBloodPressureProcessing; }
 
 };
 
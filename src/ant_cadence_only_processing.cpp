@@ -70,12 +70,15 @@ bool antCadenceOnlyProcessing::appendCadenceOnlySensor
 
 unsigned int antCadenceOnlyProcessing::splitFormat137_CAD7A
 (
-    const amString &inputBuffer,
-    amSplitString  &outWords
+    amSplitString &outWords
 )
 {
     amSplitString inWords;
-    unsigned int  nbWords = inWords.split( inputBuffer );
+    unsigned int  nbWords = 0;
+
+    // The words of the line become the input, the result replaces them.
+    inWords.swap( outWords );
+    nbWords = inWords.size();
 
     // Convert Version 1.37:
     //     <sensor_id>  <time_stamp>    <S>   <dataPage>          <deltaEventTime>    <deltaRevolutionCount>   ...
@@ -124,26 +127,22 @@ unsigned int antCadenceOnlyProcessing::splitFormat137_CAD7A
 // ---------------------------------------------------------------------------------------------------
 amDeviceType antCadenceOnlyProcessing::processCadenceOnlySensor
 (
-    const amString &deviceIDNo,
+    unsigned int    deviceIDNo,
     const amString &timeStampBuffer,
     BYTE            payLoad[]
 )
 {
-    char         auxBuffer[ C_MEDIUM_BUFFER_SIZE ] = { 0 };
-    amDeviceType result               = OTHER_DEVICE;
-    amString     sensorID             = amString( C_CAD_DEVICE_HEAD ) + deviceIDNo;
-    unsigned int dataPage             = 0;
-    unsigned int eventTime            = 0;
-    unsigned int revCount             = 0;
-    unsigned int deltaRevolutionCount = 0;
-    unsigned int deltaEventTime       = 0;
-    unsigned int additionalData1      = 0;
-    unsigned int additionalData2      = 0;
-    unsigned int additionalData3      = 0;
-    unsigned int rollOver             = 0;
-    bool         rollOverHappened     = false;
-    bool         commonPage           = false;
-    bool         outputPageNo         = true;
+    char             auxBuffer[ C_MEDIUM_BUFFER_SIZE ] = { 0 };
+    amDeviceType     result                            = OTHER_DEVICE;
+    antSensorHandle  sensorID                          = sensorStates.intern( C_CAD_DEVICE_HEAD, deviceIDNo );
+    unsigned int     eventTime                         = 0;
+    unsigned int     revCount                          = 0;
+    unsigned int     operatingTime                     = 0;
+    unsigned int     rollOver                          = 0;
+    antCadenceRecord record                            = antCadenceRecord();
+    bool             rollOverHappened                  = false;
+    bool             commonPage                        = false;
+    bool             outputPageNo                      = true;
 
     if ( isRegisteredDevice( sensorID ) )
     {
@@ -151,24 +150,24 @@ amDeviceType antCadenceOnlyProcessing::processCadenceOnlySensor
              ( eventCountTable.count   ( sensorID ) == 0 ) ||
              ( operatingTimeTable.count( sensorID ) == 0 ) )
         {
-            eventTimeTable.insert    ( std::pair<amString, unsigned int>( sensorID, 0 ) );
-            eventCountTable.insert   ( std::pair<amString, unsigned int>( sensorID, 0 ) );
-            operatingTimeTable.insert( std::pair<amString, unsigned int>( sensorID, 0 ) );
+            eventTimeTable.insert    ( sensorID, 0 );
+            eventCountTable.insert   ( sensorID, 0 );
+            operatingTimeTable.insert( sensorID, 0 );
         }
 
         // - - - - - - - - - - - - - - - - - - - - -
         // Data Page
-        dataPage = byte2UInt( payLoad[ 0 ] );
+        record.dataPage = byte2UInt( payLoad[ 0 ] );
         if ( diagnostics )
         {
-            appendDiagnosticsLine( "Data Page", payLoad[ 0 ], dataPage );
+            appendDiagnosticsLine( "Data Page", payLoad[ 0 ], record.dataPage );
         }
 
         // - - - - - - - - - - - - - - - - - - - - -
         // Event Time
-        eventTime      = byte2UInt( payLoad[ 5 ], payLoad[ 4 ] );
-        rollOver       = 65536;  // 256^2
-        deltaEventTime = getDeltaInt( rollOverHappened, sensorID, rollOver, eventTimeTable, eventTime );
+        eventTime             = byte2UInt( payLoad[ 5 ], payLoad[ 4 ] );
+        rollOver              = 65536;  // 256^2
+        record.deltaEventTime = getDeltaInt( rollOverHappened, sensorID, rollOver, eventTimeTable, eventTime );
         if ( diagnostics )
         {
             appendDiagnosticsLine( "Bike Cadence Event Time", payLoad[ 5 ], payLoad[ 4 ], eventTime );
@@ -177,15 +176,15 @@ amDeviceType antCadenceOnlyProcessing::processCadenceOnlySensor
             {
                 sprintf( auxBuffer, " (Rollover [%d] occurred)", rollOver );
             }
-            appendDiagnosticsLine( "Delta Bike Cadence Event Time", deltaEventTime, auxBuffer );
+            appendDiagnosticsLine( "Delta Bike Cadence Event Time", record.deltaEventTime, auxBuffer );
         }
 
 
         // - - - - - - - - - - - - - - - - - - - - -
         // Cumulated Wheel Count
-        revCount             = byte2UInt( payLoad[ 7 ], payLoad[ 6 ] );
-        rollOver             = 65536;  // 256^2
-        deltaRevolutionCount = getDeltaInt( rollOverHappened, sensorID, rollOver, eventCountTable, revCount );
+        revCount                    = byte2UInt( payLoad[ 7 ], payLoad[ 6 ] );
+        rollOver                    = 65536;  // 256^2
+        record.deltaRevolutionCount = getDeltaInt( rollOverHappened, sensorID, rollOver, eventCountTable, revCount );
         if ( diagnostics )
         {
             appendDiagnosticsLine( "Cumulative Cadence Revolution Count", payLoad[ 7 ], payLoad[ 6 ], revCount );
@@ -194,56 +193,56 @@ amDeviceType antCadenceOnlyProcessing::processCadenceOnlySensor
             {
                 sprintf( auxBuffer, " (Rollover [%d] occurred)", rollOver );
             }
-            appendDiagnosticsLine( "Delta Cumulative Cadence Revolution Count", deltaRevolutionCount, auxBuffer );
+            appendDiagnosticsLine( "Delta Cumulative Cadence Revolution Count", record.deltaRevolutionCount, auxBuffer );
             *auxBuffer = 0;
         }
 
-        switch ( dataPage & 0x0F )
+        switch ( record.dataPage & 0x0F )
         {
             case  0: // - - Page 0: No Additional Data - - - - - - - - - - - - - - -
                      result = CADENCE_SENSOR;
                      break;
 
             case  1: // - - Page 1: Operating Time - - - - - - - - - - - - - - - - -
-                     result          = CADENCE_SENSOR;
-                     additionalData2 = byte2UInt( payLoad[ 3 ], payLoad[ 2 ], payLoad[ 1 ] ); // Operating Time
-                     rollOver        = 16777216;  // 256^3
-                     additionalData1 = getDeltaInt( rollOverHappened, sensorID, rollOver, operatingTimeTable, additionalData2 );
-                                       // deltaOperatingTime
+                     result                 = CADENCE_SENSOR;
+                     operatingTime          = byte2UInt( payLoad[ 3 ], payLoad[ 2 ], payLoad[ 1 ] );
+                     rollOver               = 16777216;  // 256^3
+                     record.additionalData1 = getDeltaInt( rollOverHappened, sensorID, rollOver, operatingTimeTable, operatingTime );
+                                              // deltaOperatingTime
                      if ( diagnostics )
                      {
-                         double cumOperatingTimeH = ( double ) additionalData2 / 3600.0;
+                         double cumOperatingTimeH = ( double ) operatingTime / 3600.0;
                          sprintf( auxBuffer, " (%2.2lfh)", cumOperatingTimeH );
-                         appendDiagnosticsLine( "Cumulative Operating Time", payLoad[ 3 ], payLoad[ 2 ], payLoad[ 1 ], additionalData2, auxBuffer );
+                         appendDiagnosticsLine( "Cumulative Operating Time", payLoad[ 3 ], payLoad[ 2 ], payLoad[ 1 ], operatingTime, auxBuffer );
                          *auxBuffer = 0;
                          if ( rollOverHappened )
                          {
                              sprintf( auxBuffer, " (Rollover [%d] occurred)", rollOver );
                          }
-                         appendDiagnosticsLine( "Delta Cumulative Operating Time", additionalData1, auxBuffer );
+                         appendDiagnosticsLine( "Delta Cumulative Operating Time", record.additionalData1, auxBuffer );
                      }
                      break;
             case  2: // - - Page 2: Manufacturer Information - - - - - - - - - - - -
-                     result          = CADENCE_SENSOR;
-                     additionalData1 = byte2UInt( payLoad[ 1 ] );                // Manufacturer ID
-                     additionalData2 = byte2UInt( payLoad[ 3 ], payLoad[ 2 ] );  // Serial Number
+                     result                 = CADENCE_SENSOR;
+                     record.additionalData1 = byte2UInt( payLoad[ 1 ] );                // Manufacturer ID
+                     record.additionalData2 = byte2UInt( payLoad[ 3 ], payLoad[ 2 ] );  // Serial Number
                      if ( diagnostics )
                      {
-                         appendDiagnosticsLine( "Manufacturer ID", payLoad[ 1 ], additionalData1 );
-                         appendDiagnosticsLine( "Serial Number", payLoad[ 3 ], payLoad[ 2 ], additionalData2 );
+                         appendDiagnosticsLine( "Manufacturer ID", payLoad[ 1 ], record.additionalData1 );
+                         appendDiagnosticsLine( "Serial Number", payLoad[ 3 ], payLoad[ 2 ], record.additionalData2 );
                      }
                      break;
 
             case  3: // - - Page 3: Product Information  - - - - - - - - - - - - - -
-                     result          = CADENCE_SENSOR;
-                     additionalData1 = byte2UInt( payLoad[ 1 ] );   // H/W Version
-                     additionalData2 = byte2UInt( payLoad[ 2 ] );   // S/W Version
-                     additionalData3 = byte2UInt( payLoad[ 3 ] );   // Model Number
+                     result                 = CADENCE_SENSOR;
+                     record.additionalData1 = byte2UInt( payLoad[ 1 ] );   // H/W Version
+                     record.additionalData2 = byte2UInt( payLoad[ 2 ] );   // S/W Version
+                     record.additionalData3 = byte2UInt( payLoad[ 3 ] );   // Model Number
                      if ( diagnostics )
                      {
-                         appendDiagnosticsLine( "Hardware Version", payLoad[ 1 ], additionalData1 );
-                         appendDiagnosticsLine( "Software Version", payLoad[ 2 ], additionalData2 );
-                         appendDiagnosticsLine( "Model Number",     payLoad[ 3 ], additionalData3 );
+                         appendDiagnosticsLine( "Hardware Version", payLoad[ 1 ], record.additionalData1 );
+                         appendDiagnosticsLine( "Software Version", payLoad[ 2 ], record.additionalData2 );
+                         appendDiagnosticsLine( "Model Number",     payLoad[ 3 ], record.additionalData3 );
                      }
                      break;
 
@@ -255,10 +254,9 @@ amDeviceType antCadenceOnlyProcessing::processCadenceOnlySensor
 
     if ( result == CADENCE_SENSOR )
     {
-        createOutputHeader( sensorID, timeStampBuffer );
         if ( commonPage )
         {
-            commonPage = processCommonPages( sensorID, payLoad, outputPageNo );
+            commonPage = processCommonPages( sensorID, timeStampBuffer, getVersion(), payLoad, outputPageNo );
             if ( !commonPage )
             {
                 result = OTHER_DEVICE;
@@ -266,37 +264,8 @@ amDeviceType antCadenceOnlyProcessing::processCadenceOnlySensor
         }
         else
         {
-            double       wheelCircumference = 0;
-            double       gearRatio          = 0;
-            double       speed              = 0;
-            unsigned int cadence            = getCadence( sensorID );
-            if ( isUsedAsSpeedSensor( sensorID ) )
-            {
-                wheelCircumference = getWheelCircumference( sensorID );
-                gearRatio          = getNbMagnets( sensorID );
-                speed              = getSpeed( sensorID );
-            }
-            createCadenceResultString
-            (
-                cadence,
-                dataPage,
-                deltaRevolutionCount,
-                deltaEventTime,
-                additionalData1,
-                additionalData2,
-                additionalData3,
-                isUsedAsSpeedSensor( sensorID ),
-                speed,
-                wheelCircumference,
-                gearRatio
-            );
-            if ( isUsedAsSpeedSensor( sensorID ) )
-            {
-                setSpeed( sensorID, speed );
-            }
-            setCadence( sensorID, cadence );
+            outputCadenceRecord( sensorID, timeStampBuffer, getVersion(), record );
         }
-        appendOutputFooter( getVersion() );
     }
 
     if ( result == OTHER_DEVICE )
@@ -304,7 +273,7 @@ amDeviceType antCadenceOnlyProcessing::processCadenceOnlySensor
         resetOutBuffer();
         if ( outputUnknown )
         {
-            int deviceIDNoAsInt = deviceIDNo.toInt();
+            int deviceIDNoAsInt = ( int ) deviceIDNo;
             createUnknownDeviceTypeString( C_CAD_TYPE, deviceIDNoAsInt, timeStampBuffer, payLoad );
         }
     }
@@ -326,31 +295,23 @@ amDeviceType antCadenceOnlyProcessing::processCadenceOnlySensorSemiCooked
     const amString &inputBuffer
 )
 {
-    amDeviceType result = OTHER_DEVICE;
-    unsigned int  nbWords              = 0;
-    unsigned int  counter              = 0;
-    unsigned int  startCounter         = 0;
-    unsigned int  dataPage             = 0;
-    unsigned int  deltaRevolutionCount = 0;
-    unsigned int  deltaEventTime       = 0;
-    unsigned int  additionalData1      = 0;
-    unsigned int  additionalData2      = 0;
-    unsigned int  additionalData3      = 0;
-    bool          commonPage           = false;
-    bool          outputPageNo         = true;
-    amString      curVersion           = getVersion();
-    amString      sensorID;
-    amString      semiCookedString;
-    amString      timeStampBuffer;
-    amSplitString words;
-
-    if ( isSemiCookedFormat137( inputBuffer ) )
+    amDeviceType     result       = OTHER_DEVICE;
+    unsigned int     nbWords      = 0;
+    unsigned int     counter      = 0;
+    unsigned int     startCounter = 0;
+    antCadenceRecord record       = antCadenceRecord();
+    bool             commonPage   = false;
+    bool             outputPageNo = true;
+    amString         curVersion   = getVersion();
+    amString         sensorID;
+    amString         semiCookedString;
+    amString         timeStampBuffer;
+    amSplitString    words;
+
+    nbWords = words.split( inputBuffer );
+    if ( isSemiCookedFormat137( words ) )
     {
-        nbWords = splitFormat137_CAD7A( inputBuffer, words );
-    }
-    else
-    {
-        nbWords = words.split( inputBuffer );
+        nbWords = splitFormat137_CAD7A( words );
     }
 
     if ( nbWords > 5 )
@@ -366,15 +327,15 @@ amDeviceType antCadenceOnlyProcessing::processCadenceOnlySensorSemiCooked
         }
         if ( isRegisteredDevice( sensorID ) && ( semiCookedString == C_SEMI_COOKED_SYMBOL_AS_STRING ) && isCadenceOnlySensor( sensorID ) )
         {
-            startCounter         = counter;
-            deltaRevolutionCount = words[ counter++ ].toUInt();                         // 3
-            deltaEventTime       = words[ counter++ ].toUInt();                         // 4
-            dataPage             = words[ counter++ ].toUInt();                         // 5
+            startCounter                = counter;
+            record.deltaRevolutionCount = words[ counter++ ].toUInt();                  // 3
+            record.deltaEventTime       = words[ counter++ ].toUInt();                  // 4
+            record.dataPage             = words[ counter++ ].toUInt();                  // 5
             if ( diagnostics )
             {
-                appendDiagnosticsLine( "Data Page", dataPage );
-                appendDiagnosticsLine( "Delta Revolution Count", deltaRevolutionCount );
-                appendDiagnosticsLine( "Delta Event Time", deltaEventTime );
+                appendDiagnosticsLine( "Data Page", record.dataPage );
+                appendDiagnosticsLine( "Delta Revolution Count", record.deltaRevolutionCount );
+                appendDiagnosticsLine( "Delta Event Time", record.deltaEventTime );
             }
             if ( words[ counter ] == C_UNSUPPORTED_DATA_PAGE )
             {
@@ -382,7 +343,7 @@ amDeviceType antCadenceOnlyProcessing::processCadenceOnlySensorSemiCooked
             }
             else
             {
-                switch ( dataPage & 0x0F )
+                switch ( record.dataPage & 0x0F )
                 {
                     case  0: // - - Page 0: No Additional Data - - - - - - - - - - - - - - -
                              result = CADENCE_SENSOR;
@@ -391,11 +352,11 @@ amDeviceType antCadenceOnlyProcessing::processCadenceOnlySensorSemiCooked
                     case  1: // - - Page 1: Operating Time - - - - - - - - - - - - - - - - -
                              if ( nbWords > 6 )
                              {
-                                 result          = CADENCE_SENSOR;
-                                 additionalData1 = words[ counter++ ].toUInt();   // deltaOperatingTime
+                                 result                 = CADENCE_SENSOR;
+                                 record.additionalData1 = words[ counter++ ].toUInt();   // deltaOperatingTime
                                  if ( diagnostics )
                                  {
-                                     appendDiagnosticsLine( "Delta Cumulative Operating Time", additionalData1 );
+                                     appendDiagnosticsLine( "Delta Cumulative Operating Time", record.additionalData1 );
                                  }
                              }
                              break;
@@ -403,13 +364,13 @@ amDeviceType antCadenceOnlyProcessing::processCadenceOnlySensorSemiCooked
                     case  2: // - - Page 2: Manufacturer Information - - - - - - - - - - - -
                              if ( nbWords > 7 )
                              {
-                                 result          = CADENCE_SENSOR;
-                                 additionalData1 = words[ counter++ ].toUInt();   // manufacturerID
-                                 additionalData2 = words[ counter++ ].toUInt();   // serialNumber
+                                 result                 = CADENCE_SENSOR;
+                                 record.additionalData1 = words[ counter++ ].toUInt();   // manufacturerID
+                                 record.additionalData2 = words[ counter++ ].toUInt();   // serialNumber
                                  if ( diagnostics )
                                  {
-                                     appendDiagnosticsLine( "Manufacturer ID", additionalData1 );
-                                     appendDiagnosticsLine( "Serial Number", additionalData2 );
+                                     appendDiagnosticsLine( "Manufacturer ID", record.additionalData1 );
+                                     appendDiagnosticsLine( "Serial Number", record.additionalData2 );
                                  }
                              }
                              break;
@@ -417,15 +378,15 @@ amDeviceType antCadenceOnlyProcessing::processCadenceOnlySensorSemiCooked
                     case  3: // - - Page 3: Product Information  - - - - - - - - - - - - - -
                              if ( nbWords > 8 )
                              {
-                                 result          = CADENCE_SENSOR;
-                                 additionalData1 = words[ counter++ ].toUInt();   // hwVersion
-                                 additionalData2 = words[ counter++ ].toUInt();   // swVersion
-                                 additionalData3 = words[ counter++ ].toUInt();   // modelNumber
+                                 result                 = CADENCE_SENSOR;
+                                 record.additionalData1 = words[ counter++ ].toUInt();   // hwVersion
+                                 record.additionalData2 = words[ counter++ ].toUInt();   // swVersion
+                                 record.additionalData3 = words[ counter++ ].toUInt();   // modelNumber
                                  if ( diagnostics )
                                  {
-                                     appendDiagnosticsLine( "Model Number", additionalData1 );
-                                     appendDiagnosticsLine( "Software Version", additionalData2 );
-                                     appendDiagnosticsLine( "Hardware Version", additionalData3 );
+                                     appendDiagnosticsLine( "Model Number", record.additionalData1 );
+                                     appendDiagnosticsLine( "Software Version", record.additionalData2 );
+                                     appendDiagnosticsLine( "Hardware Version", record.additionalData3 );
                                  }
                              }
                              break;
@@ -450,10 +411,9 @@ amDeviceType antCadenceOnlyProcessing::processCadenceOnlySensorSemiCooked
             }
         }
 
-        createOutputHeader( sensorID, timeStampBuffer );
         if ( commonPage )
         {
-            commonPage = processCommonPagesSemiCooked( words, startCounter, outputPageNo );
+            commonPage = processCommonPagesSemiCooked( words, startCounter, curVersion, outputPageNo );
             if ( !commonPage )
             {
                 result = OTHER_DEVICE;
@@ -461,37 +421,8 @@ amDeviceType antCadenceOnlyProcessing::processCadenceOnlySensorSemiCooked
         }
         else
         {
-            double       wheelCircumference = 0;
-            double       gearRatio          = 0;
-            double       speed              = 0;
-            unsigned int cadence            = getCadence( sensorID );
-            if ( isUsedAsSpeedSensor( sensorID ) )
-            {
-                wheelCircumference = getWheelCircumference( sensorID );
-                gearRatio          = getNbMagnets( sensorID );
-                speed              = getSpeed( sensorID );
-            }
-            createCadenceResultString
-            (
-                cadence,
-                dataPage,
-                deltaRevolutionCount,
-                deltaEventTime,
-                additionalData1,
-                additionalData2,
-                additionalData3,
-                isUsedAsSpeedSensor( sensorID ),
-                speed,
-                wheelCircumference,
-                gearRatio
-            );
-            if ( isUsedAsSpeedSensor( sensorID ) )
-            {
-                setSpeed( sensorID, speed );
-            }
-            setCadence( sensorID, cadence );
+            outputCadenceRecord( sensorID, timeStampBuffer, curVersion, record );
         }
-        appendOutputFooter( curVersion );
     }
     else if ( result == UNKNOWN_DEVICE )
     {
@@ -519,7 +450,7 @@ amDeviceType antCadenceOnlyProcessing::processCadenceOnlySensorSemiCooked
 //
 // Parameters:
 //    int             deviceType        IN   Device type (SPCAD, SPEED, CADENCE, HRM, AERO, POWER).
-//    const amString &deviceID          IN   Device ID (number).
+//    unsigned int    deviceID          IN   Device ID (number).
 //    const amString &timeStampBuffer   IN   Time stamp.
 //    BYTE            payLoad[]         IN   Array of bytes with the data to be converted.
 //
@@ -531,7 +462,7 @@ amDeviceType antCadenceOnlyProcessing::processCadenceOnlySensorSemiCooked
 amDeviceType antCadenceOnlyProcessing::processSensor
 (
     int             deviceType,
-    const amString &deviceIDNo,
+    unsigned int    deviceIDNo,
     const amString &timeStampBuffer,
     BYTE            payLoad[]
 )
@@ -544,7 +475,7 @@ amDeviceType antCadenceOnlyProcessing::processSensor
     }
     else if ( outputUnknown )
     {
-        int deviceIDNoAsInt = deviceIDNo.toInt();
+        int deviceIDNoAsInt = ( int ) deviceIDNo;
         createUnknownDeviceTypeString( deviceType, deviceIDNoAsInt, timeStampBuffer, payLoad );
     }
     else
@@ -643,113 +574,34 @@ void antCadenceOnlyProcessing::reset
     antCadenceSpeedProcessing::reset();
 }
 
-void antCadenceOnlyProcessing::createCadenceResultString
+void antCadenceOnlyProcessing::outputCadenceRecord
 (
-    unsigned int &cadence,
-    unsigned int  dataPage,
-    unsigned int  deltaRevolutionCount,
-    unsigned int  deltaEventTime,
-    unsigned int  additionalData1,
-    unsigned int  additionalData2,
-    unsigned int  additionalData3,
-    bool          isUsedAsSpeedSensor,
-    double       &speed,
-    double        wheelCircumference,
-    double        gearRatio
+    const antSensorHandle &sensorID,
+    const amString        &timeStampBuffer,
+    const amString        &versionString,
+    antCadenceRecord      &record
 )
 {
-    if ( !semiCookedOut )
+    record.cadence                = getCadence( sensorID );
+    record.isMakeshiftSpeedSensor = isUsedAsSpeedSensor( sensorID );
+    if ( record.isMakeshiftSpeedSensor )
     {
-        cadence = computeCadence( cadence, deltaRevolutionCount, deltaEventTime );
-        speed   = antCadenceSpeedProcessing::computeSpeed( cadence, wheelCircumference, gearRatio );
+        record.wheelCircumference = getWheelCircumference( sensorID );
+        record.gearRatio          = getNbMagnets( sensorID );
+        record.speed              = getSpeed( sensorID );
     }
 
-    if ( outputAsJSON )
+    if ( !semiCookedOut )
     {
-        if ( semiCookedOut )
-        {
-            appendJSONItem( "delta revolution count", deltaRevolutionCount );
-            appendJSONItem( "delta event time",       deltaEventTime );
-        }
-        else
-        {
-            appendJSONItem( C_CADENCE_JSON, cadence );
-            if ( isUsedAsSpeedSensor )
-            {
-                appendJSONItem( "speed",               speed,              getValuePrecision() );
-                appendJSONItem( "wheel circumference", wheelCircumference, getValuePrecision() );
-                appendJSONItem( "gear ratio",          gearRatio,          getValuePrecision() );
-            }
-        }
-        appendJSONItem( C_DATA_PAGE_JSON, dataPage );
-        if ( ( dataPage & 0x0F ) == 1 )
-        {
-            if ( semiCookedOut )
-            {
-                appendJSONItem( "delta operating time", additionalData1 );
-            }
-            else
-            {
-                appendJSONItem( "operating time", 2 * additionalData1 );
-            }
-        }
-        else if ( ( dataPage & 0x0F ) == 2 )
-        {
-            appendJSONItem( C_MANUFACTURER_JSON,  additionalData1 );
-            appendJSONItem( C_SERIAL_NUMBER_JSON, additionalData2 );
-        }
-        else if ( ( dataPage & 0x0F ) == 3 )
-        {
-            appendJSONItem( C_HARDWARE_REVISION_JSON, additionalData1 );
-            appendJSONItem( C_SOFTWARE_REVISION_JSON, additionalData2 );
-            appendJSONItem( C_MODEL_NUMBER_JSON,      additionalData3 );
-        }
+        record.cadence = computeCadence( record.cadence, record.deltaRevolutionCount, record.deltaEventTime );
+        record.speed   = antCadenceSpeedProcessing::computeSpeed( record.cadence, record.wheelCircumference, record.gearRatio );
     }
-    else
-    {
-        if ( semiCookedOut )
-        {
-            appendOutput( deltaRevolutionCount );
-            appendOutput( deltaEventTime );
-            appendOutput( dataPage );
-            if ( ( ( dataPage & 0x0F ) == 1 ) || ( ( dataPage & 0x0F ) == 2 ) || ( ( dataPage & 0x0F ) == 3 ) )
-            {
-                appendOutput( additionalData1 );             // deltaOperatingTime (1) / manufacturerID (2) / hwVersion (3)
-                if ( ( ( dataPage & 0x0F ) == 2 ) || ( ( dataPage & 0x0F ) == 3 ) )
-                {
-                     appendOutput( additionalData2 );        // serialNumber (2) / swVersion (3)
-                     if ( ( dataPage & 0x0F ) == 3 )
-                     {
-                          appendOutput( additionalData3 );   // modelNumber (3)
-                    }
-                }
-            }
-        }
-        else
-        {
-            appendOutput( cadence );
-            appendOutput( dataPage );
-            if ( isUsedAsSpeedSensor )
-            {
-                appendOutput( speed,              getValuePrecision() );
-                appendOutput( wheelCircumference, 3 );
-                appendOutput( gearRatio,          getValuePrecision() );
-            }
 
-            if ( ( dataPage & 0x0F ) == 1 )
-            {
-                appendOutput( 2 * additionalData1, "s" );    // operatingTimeSeconds
-            }
-            else if ( ( ( dataPage & 0x0F ) == 2 ) || ( ( dataPage & 0x0F ) == 3 ) )
-            {
-                appendOutput( additionalData1 );             // manufacturerID (2) / hwVersion (3)
-                appendOutput( additionalData2 );             // serialNumber (2)   / swVersion (3)
-                if ( ( dataPage & 0x0F ) == 3 )
-                {
-                    appendOutput( additionalData3 );         // modelNumber (3)
-                }
-            }
-        }
+    outputRecord( antRecordContext( sensorID, timeStampBuffer, versionString ), record );
+
+    if ( record.isMakeshiftSpeedSensor )
+    {
+        setSpeed( sensorID, record.speed );
     }
+    setCadence( sensorID, record.cadence );
 }
-
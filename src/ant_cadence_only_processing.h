@@ -10,27 +10,14 @@ class antCadenceOnlyProcessing : virtual public antProcessing,
 
     private:
 
-        void createCadenceResultString
-             (
-                 unsigned int &cadence,
-                 unsigned int  dataPage,
-                 unsigned int  deltaRevolutionCount,
-                 unsigned int  deltaEventTime,
-                 unsigned int  additionalData1,
-                 unsigned int  additionalData2,
-                 unsigned int  additionalData3,
-                 bool          isUsedAsSpeedSensor,
-                 double       &speed,
-                 double        wheelCircumference,
-                 double        gearRatio
-             );
-
-        unsigned int splitFormat137_CAD7A( const amString &inputBuffer, amSplitString &outWords );
+        void outputCadenceRecord( const antSensorHandle &sensorID, const amString &timeStampBuffer, const amString &versionString, antCadenceRecord &record );
+
+        unsigned int splitFormat137_CAD7A( amSplitString &outWords );
 
 
     protected:
 
-        amDeviceType processCadenceOnlySensor( const amString &deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
+        amDeviceType processCadenceOnlySensor( unsigned int deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
         amDeviceType processCadenceOnlySensorSemiCooked( const amString &inputBuffer );
 
         virtual void readDeviceFileLine( const char *line );
@@ -45,10 +32,11 @@ class antCadenceOnlyProcessing : virtual public antProcessing,
 
         bool isCadenceOnlySensor( const amString &deviceID );
 
-        virtual amDeviceType processSensor( int deviceType, const amString &deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
+        virtual amDeviceType processSensor( int deviceType, unsigned int deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
         virtual amDeviceType processSensorSemiCooked( const amString &inputBuffer );
 
         virtual void reset( void );
+        virtual antProcessing *createWorker( void ) const { return new antCadenceOnlyProcessing; }
 
 };
 
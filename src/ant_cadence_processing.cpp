@@ -19,7 +19,8 @@
 antCadenceProcessing::antCadenceProcessing
 (
     void
-)
+) : cadenceTable( sensorStates, &antSensorState::cadence, SS_CADENCE ),
+    cadenceSensorTable( sensorStates, &antSensorState::cadenceSensor, SS_CADENCE_SENSOR )
 {
     reset();
 }
@@ -68,20 +69,20 @@ void antCadenceProcessing::reset
 
 void antCadenceProcessing::setCadence
 (
-    const amString &sensorID,
-    unsigned int       value
+    const antSensorHandle &sensorID,
+    unsigned int           value
 )
 {
     if ( cadenceTable.count( sensorID ) > 0 )
     {
-        cadenceTable.insert( std::pair<amString, unsigned int>( sensorID, 0 ) );
+        cadenceTable.insert( sensorID, 0 );
     }
     cadenceTable[ sensorID ] = value;
 }
 
 unsigned int antCadenceProcessing::getCadence
 (
-    const amString &sensorID
+    const antSensorHandle &sensorID
 )
 {
     unsigned int cadence = 0;
@@ -1,24 +1,24 @@
 #ifndef __ANT_CADENCE_PROCESSING_H__
 #define __ANT_CADENCE_PROCESSING_H__
 
-#include <map>
+#include "ant_sensor_state.h"
 
 class amString;
 class amSplitString;
 
-class antCadenceProcessing
+class antCadenceProcessing : virtual public antSensorStateStore
 {
 
     private:
 
-        std::map<amString, unsigned int> cadenceTable;
-        std::map<amString, bool>         cadenceSensorTable;
+        antSensorField<unsigned int> cadenceTable;
+        antSensorField<bool>         cadenceSensorTable;
 
 
     protected:
 
-        unsigned int getCadence( const amString &sensorID );
-        void setCadence( const amString &sensorID, unsigned int value );
+        unsigned int getCadence( const antSensorHandle &sensorID );
+        void setCadence( const antSensorHandle &sensorID, unsigned int value );
 
         unsigned int computeCadence( unsigned int previousCadence, unsigned int deltaRevolutionCount, unsigned int deltaEventTime );
 
@@ -22,7 +22,8 @@ antCadenceSpeedProcessing::antCadenceSpeedProcessing
 (
     void
 ) : antSpeedProcessing(),
-    antCadenceProcessing()
+    antCadenceProcessing(),
+    speedCadenceSensorTable( sensorStates, &antSensorState::speedCadenceSensor, SS_SPEED_CADENCE_SENSOR )
 {
     nbMagnetsDefault = C_GEAR_RATIO_DEFAULT;
     reset();
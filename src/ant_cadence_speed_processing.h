@@ -11,7 +11,7 @@ class antCadenceSpeedProcessing : virtual public antSpeedProcessing,
     private:
 
         double gearRatioDefault;
-        std::map<amString, bool> speedCadenceSensorTable;
+        antSensorField<bool> speedCadenceSensorTable;
 
 
     protected:
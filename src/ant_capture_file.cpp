@@ -0,0 +1,723 @@
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <set>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "am_little_endian.h"
+#include "ant_capture_file.h"
+
+const char         C_CAPTURE_MAGIC[]            = "ANTC";
+const char         C_CAPTURE_BLOCK_MAGIC[]      = "ANCB";
+const char         C_CAPTURE_INDEX_MAGIC[]      = "ANCI";
+const size_t       C_CAPTURE_MAGIC_LENGTH       = 4;
+const unsigned int C_CAPTURE_FORMAT_VERSION     = 1;
+const size_t       C_CAPTURE_HEADER_SIZE        = 8;
+const size_t       C_CAPTURE_BLOCK_HEADER_SIZE  = 28;
+const size_t       C_CAPTURE_PACKET_HEADER_SIZE = 10;     // Receive time, length
+const size_t       C_CAPTURE_TRAILER_SIZE       = 12;
+const size_t       C_CAPTURE_INDEX_BLOCK_SIZE   = 24;
+const size_t       C_CAPTURE_INDEX_SENSOR_SIZE  = 7;
+const unsigned int C_CAPTURE_MAX_PACKET_SIZE    = 0xFFFF;
+const int          C_PAYLOAD_OFFSET             = 7;
+const unsigned int C_ANY_DEVICE_TYPE            = C_NB_DEVICE_TYPES;
+
+static long long toMicroseconds
+(
+    double seconds
+)
+{
+    return ( long long ) floor( seconds * 1.0E6 + 0.5 );
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Writer
+//
+// -------------------------------------------------------------------------------------------------//
+antCaptureWriter::antCaptureWriter
+(
+    void
+)
+{
+    fileDescriptor = -1;
+    offset         = 0;
+    nbPackets      = 0;
+    firstTime      = 0;
+    lastTime       = 0;
+}
+
+antCaptureWriter::~antCaptureWriter
+(
+    void
+)
+{
+    amString errorMessage;
+    close( errorMessage );
+}
+
+int antCaptureWriter::open
+(
+    const amString &fileName,
+    amString       &errorMessage
+)
+{
+    int      result = 0;
+    amString header( C_CAPTURE_MAGIC );
+
+    fileDescriptor = ::open( fileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+    if ( fileDescriptor < 0 )
+    {
+        errorMessage += "Could not open capture file \"";
+        errorMessage += fileName;
+        errorMessage += "\" for writing.\n";
+        result = E_WRITE_FILE_NOT_OPEN;
+    }
+    else
+    {
+        offset = 0;
+        blocks.clear();
+        sensorBlocks.clear();
+        amAppendLittleEndian( header, C_CAPTURE_FORMAT_VERSION, 1 );
+        amAppendLittleEndian( header, 0, 3 );
+        result = writeData( header, errorMessage );
+    }
+    return result;
+}
+
+int antCaptureWriter::writeData
+(
+    const amString &data,
+    amString       &errorMessage
+)
+{
+    if ( !amWriteAll( fileDescriptor, data.c_str(), data.size() ) )
+    {
+        errorMessage += "Could not write to the capture file: ";
+        errorMessage += strerror( errno );
+        errorMessage += "\n";
+        return E_WRITE_ERROR;
+    }
+    offset += data.size();
+    return 0;
+}
+
+int antCaptureWriter::writeBlock
+(
+    amString &errorMessage
+)
+{
+    int             result      = 0;
+    unsigned int    blockNumber = blocks.size();
+    amString        header( C_CAPTURE_BLOCK_MAGIC );
+    antCaptureBlock block;
+
+    block.offset    = offset;
+    block.firstTime = firstTime;
+    block.lastTime  = lastTime;
+
+    amAppendLittleEndian( header, nbPackets, 4 );
+    amAppendLittleEndian( header, blockData.size(), 4 );
+    amAppendLittleEndian( header, firstTime, 8 );
+    amAppendLittleEndian( header, lastTime, 8 );
+
+    result = writeData( header, errorMessage );
+    if ( result == 0 )
+    {
+        result = writeData( blockData, errorMessage );
+    }
+    if ( result == 0 )
+    {
+        blocks.push_back( block );
+        for ( size_t counter = 0; counter < blockSensors.size(); ++counter )
+        {
+            sensorBlocks[ blockSensors[ counter ] ].push_back( blockNumber );
+        }
+    }
+
+    blockData.clear();
+    blockSensors.clear();
+    nbPackets = 0;
+
+    return result;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Add a packet to the current block. A block is written once it is full or spans too much time.
+//
+// -------------------------------------------------------------------------------------------------//
+int antCaptureWriter::append
+(
+    const BYTE *line,
+    int         nbBytes,
+    long long   microseconds,
+    amString   &errorMessage
+)
+{
+    int          result    = 0;
+    unsigned int sensorKey = 0;
+
+    if ( ( nbBytes <= 0 ) || ( ( unsigned int ) nbBytes > C_CAPTURE_MAX_PACKET_SIZE ) )
+    {
+        return result;
+    }
+
+    if ( ( nbPackets > 0 ) && ( ( microseconds - firstTime ) >= C_CAPTURE_BLOCK_SECONDS * 1000000LL ) )
+    {
+        result = writeBlock( errorMessage );
+    }
+
+    if ( result == 0 )
+    {
+        if ( nbPackets == 0 )
+        {
+            firstTime = lastTime = microseconds;
+        }
+        firstTime = std::min( firstTime, microseconds );
+        lastTime  = std::max( lastTime, microseconds );
+        ++nbPackets;
+
+        amAppendLittleEndian( blockData, microseconds, 8 );
+        amAppendLittleEndian( blockData, nbBytes, 2 );
+        blockData.append( ( const char * ) line, nbBytes );
+
+        if ( antCaptureReader::getSensorKey( line, nbBytes, sensorKey ) &&
+             ( std::find( blockSensors.begin(), blockSensors.end(), sensorKey ) == blockSensors.end() ) )
+        {
+            blockSensors.push_back( sensorKey );
+        }
+
+        if ( blockData.size() >= ( size_t ) C_CAPTURE_BLOCK_SIZE )
+        {
+            result = writeBlock( errorMessage );
+        }
+    }
+
+    return result;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Write the last block, the index and the trailer.
+//
+// -------------------------------------------------------------------------------------------------//
+int antCaptureWriter::close
+(
+    amString &errorMessage
+)
+{
+    int       result      = 0;
+    long long indexOffset = 0;
+    amString  index;
+
+    if ( fileDescriptor < 0 )
+    {
+        return result;
+    }
+
+    if ( nbPackets > 0 )
+    {
+        result = writeBlock( errorMessage );
+    }
+
+    if ( result == 0 )
+    {
+        indexOffset = offset;
+        amAppendLittleEndian( index, blocks.size(), 4 );
+        for ( size_t counter = 0; counter < blocks.size(); ++counter )
+        {
+            amAppendLittleEndian( index, blocks[ counter ].offset, 8 );
+            amAppendLittleEndian( index, blocks[ counter ].firstTime, 8 );
+            amAppendLittleEndian( index, blocks[ counter ].lastTime, 8 );
+        }
+        amAppendLittleEndian( index, sensorBlocks.size(), 4 );
+        for ( std::map<unsigned int, std::vector<unsigned int> >::const_iterator sensor = sensorBlocks.begin(); sensor != sensorBlocks.end(); ++sensor )
+        {
+            amAppendLittleEndian( index, sensor->first >> 16, 1 );
+            amAppendLittleEndian( index, sensor->first & 0xFFFF, 2 );
+            amAppendLittleEndian( index, sensor->second.size(), 4 );
+            for ( size_t counter = 0; counter < sensor->second.size(); ++counter )
+            {
+                amAppendLittleEndian( index, sensor->second[ counter ], 4 );
+            }
+        }
+        amAppendLittleEndian( index, indexOffset, 8 );
+        index += C_CAPTURE_INDEX_MAGIC;
+        result = writeData( index, errorMessage );
+    }
+
+    ::close( fileDescriptor );
+    fileDescriptor = -1;
+
+    return result;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Selection
+//
+// -------------------------------------------------------------------------------------------------//
+antCaptureSelection::antCaptureSelection
+(
+    void
+)
+{
+    fromTime = C_CAPTURE_FIRST_TIME;
+    toTime   = C_CAPTURE_LAST_TIME;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// A sensor is given as <device type>:<device ID> (both numbers), or as a sensor ID of the output
+// (e.g. "PWRB10_442") or a device ID, which select the device ID of all device types.
+//
+// -------------------------------------------------------------------------------------------------//
+bool antCaptureSelection::addSensor
+(
+    const char *sensor
+)
+{
+    const char   *separator  = strchr( sensor, ':' );
+    const char   *number     = NULL;
+    char         *end        = NULL;
+    unsigned int  deviceType = C_ANY_DEVICE_TYPE;
+    unsigned long deviceID   = 0;
+
+    if ( separator != NULL )
+    {
+        deviceType = strtoul( sensor, &end, 10 );
+        if ( ( end != separator ) || ( deviceType >= C_ANY_DEVICE_TYPE ) )
+        {
+            return false;
+        }
+        number = separator + 1;
+    }
+    else
+    {
+        number = strrchr( sensor, '_' );
+        number = ( number == NULL ) ? sensor : number + 1;
+    }
+
+    deviceID = strtoul( number, &end, 10 );
+    if ( ( *number == 0 ) || ( *end != 0 ) || ( deviceID > 0xFFFF ) )
+    {
+        return false;
+    }
+
+    sensors.push_back( ( deviceType << 16 ) | deviceID );
+    return true;
+}
+
+static bool parseTimeStamp
+(
+    const char *timeStamp,
+    long long  &microseconds
+)
+{
+    char   *end   = NULL;
+    double  value = strtod( timeStamp, &end );
+    bool    valid = ( *timeStamp != 0 ) && ( *end == 0 );
+
+    if ( valid )
+    {
+        microseconds = toMicroseconds( value );
+    }
+    return valid;
+}
+
+bool antCaptureSelection::setFrom
+(
+    const char *timeStamp
+)
+{
+    return parseTimeStamp( timeStamp, fromTime );
+}
+
+bool antCaptureSelection::setTo
+(
+    const char *timeStamp
+)
+{
+    return parseTimeStamp( timeStamp, toTime );
+}
+
+bool antCaptureSelection::matchSensor
+(
+    unsigned int sensorKey
+) const
+{
+    for ( size_t counter = 0; counter < sensors.size(); ++counter )
+    {
+        if ( ( sensors[ counter ] == sensorKey ) ||
+             ( ( ( sensors[ counter ] >> 16 ) == C_ANY_DEVICE_TYPE ) && ( ( sensors[ counter ] & 0xFFFF ) == ( sensorKey & 0xFFFF ) ) ) )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool antCaptureSelection::matchPacket
+(
+    bool         isSensor,
+    unsigned int sensorKey,
+    long long    receiveTime
+) const
+{
+    bool result = ( receiveTime >= fromTime ) && ( receiveTime <= toTime );
+    if ( result && !sensors.empty() )
+    {
+        result = isSensor && matchSensor( sensorKey );
+    }
+    return result;
+}
+
+bool antCaptureSelection::matchTime
+(
+    long long firstTime,
+    long long lastTime
+) const
+{
+    return ( lastTime >= fromTime ) && ( firstTime <= toTime );
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Reader
+//
+// -------------------------------------------------------------------------------------------------//
+antCaptureReader::antCaptureReader
+(
+    void
+)
+{
+    fileDescriptor   = -1;
+    indexed          = false;
+    position         = 0;
+    remainingPackets = 0;
+}
+
+antCaptureReader::~antCaptureReader
+(
+    void
+)
+{
+    close();
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Device type * 65536 + device ID of a packet sent by a sensor (see antDecodePipeline::dispatchFrame()).
+//
+// -------------------------------------------------------------------------------------------------//
+bool antCaptureReader::getSensorKey
+(
+    const BYTE   *line,
+    int           nbBytes,
+    unsigned int &sensorKey
+)
+{
+    int  payLoadSize = nbBytes - C_PAYLOAD_OFFSET;
+    int  flagOffset  = 0;
+    bool result      = false;
+
+    payLoadSize = ( payLoadSize < 0 ) ? 0 : ( ( payLoadSize > C_ANT_PAY_LOAD_COUNT ) ? C_ANT_PAY_LOAD_COUNT : payLoadSize );
+    flagOffset  = C_PAYLOAD_OFFSET + payLoadSize;
+    if ( ( nbBytes > flagOffset + 3 ) && ( line[ 2 ] == C_ANT_ASYNC_MSG ) && ( ( line[ flagOffset ] & 0x80 ) != 0 ) )
+    {
+        sensorKey = ( ( unsigned int ) line[ flagOffset + 3 ] << 16 ) | ( ( unsigned int ) line[ flagOffset + 2 ] << 8 ) | line[ flagOffset + 1 ];
+        result    = true;
+    }
+    return result;
+}
+
+bool antCaptureReader::readAt
+(
+    long long  fileOffset,
+    size_t     nbBytes,
+    amString  &buffer
+)
+{
+    size_t  nbRead = 0;
+    ssize_t result = 0;
+
+    buffer.resize( nbBytes );
+    while ( nbRead < nbBytes )
+    {
+        result = pread( fileDescriptor, &( buffer[ nbRead ] ), nbBytes - nbRead, fileOffset + nbRead );
+        if ( ( result < 0 ) && ( errno == EINTR ) )
+        {
+            continue;
+        }
+        if ( result <= 0 )
+        {
+            return false;
+        }
+        nbRead += result;
+    }
+    return true;
+}
+
+bool antCaptureReader::readIndex
+(
+    long long fileSize
+)
+{
+    amString           index;
+    const char        *data        = NULL;
+    size_t             size        = 0;
+    size_t             offset      = 0;
+    unsigned long long indexOffset = 0;
+    unsigned int       nbBlocks    = 0;
+    unsigned int       nbSensors   = 0;
+    unsigned int       nbEntries   = 0;
+    unsigned int       sensorKey   = 0;
+    antCaptureBlock    block;
+
+    if ( ( fileSize < ( long long ) ( C_CAPTURE_HEADER_SIZE + C_CAPTURE_TRAILER_SIZE ) ) ||
+         !readAt( fileSize - C_CAPTURE_TRAILER_SIZE, C_CAPTURE_TRAILER_SIZE, index ) ||
+         ( memcmp( index.c_str() + 8, C_CAPTURE_INDEX_MAGIC, C_CAPTURE_MAGIC_LENGTH ) != 0 ) )
+    {
+        return false;
+    }
+
+    indexOffset = amReadLittleEndian( index.c_str(), 8 );
+    if ( ( indexOffset < C_CAPTURE_HEADER_SIZE ) || ( indexOffset > ( unsigned long long ) fileSize - C_CAPTURE_TRAILER_SIZE ) ||
+         !readAt( indexOffset, fileSize - C_CAPTURE_TRAILER_SIZE - indexOffset, index ) )
+    {
+        return false;
+    }
+
+    data = index.c_str();
+    size = index.size();
+    if ( size < 4 )
+    {
+        return false;
+    }
+    nbBlocks = amReadLittleEndian( data, 4 );
+    offset = 4;
+    if ( nbBlocks > ( size - offset ) / C_CAPTURE_INDEX_BLOCK_SIZE )
+    {
+        return false;
+    }
+    blocks.clear();
+    for ( unsigned int counter = 0; counter < nbBlocks; ++counter )
+    {
+        block.offset    = amReadLittleEndian( data + offset, 8 );
+        block.firstTime = amReadLittleEndian( data + offset + 8, 8 );
+        block.lastTime  = amReadLittleEndian( data + offset + 16, 8 );
+        blocks.push_back( block );
+        offset += C_CAPTURE_INDEX_BLOCK_SIZE;
+    }
+
+    if ( offset + 4 > size )
+    {
+        return false;
+    }
+    nbSensors = amReadLittleEndian( data + offset, 4 );
+    offset += 4;
+    sensorBlocks.clear();
+    for ( unsigned int counter = 0; counter < nbSensors; ++counter )
+    {
+        if ( offset + C_CAPTURE_INDEX_SENSOR_SIZE > size )
+        {
+            return false;
+        }
+        sensorKey = ( amReadLittleEndian( data + offset, 1 ) << 16 ) | amReadLittleEndian( data + offset + 1, 2 );
+        nbEntries = amReadLittleEndian( data + offset + 3, 4 );
+        offset += C_CAPTURE_INDEX_SENSOR_SIZE;
+        if ( nbEntries > ( size - offset ) / 4 )
+        {
+            return false;
+        }
+        std::vector<unsigned int> &entries = sensorBlocks[ sensorKey ];
+        for ( unsigned int entry = 0; entry < nbEntries; ++entry )
+        {
+            entries.push_back( amReadLittleEndian( data + offset, 4 ) );
+            offset += 4;
+            if ( entries.back() >= nbBlocks )
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Find the blocks of a capture without index (e.g. the program writing it was killed).
+// A truncated last block is ignored.
+//
+// -------------------------------------------------------------------------------------------------//
+bool antCaptureReader::walkBlocks
+(
+    long long fileSize
+)
+{
+    long long       offset = C_CAPTURE_HEADER_SIZE;
+    amString        header;
+    antCaptureBlock block;
+
+    blocks.clear();
+    sensorBlocks.clear();
+    while ( ( offset + ( long long ) C_CAPTURE_BLOCK_HEADER_SIZE <= fileSize ) &&
+            readAt( offset, C_CAPTURE_BLOCK_HEADER_SIZE, header ) &&
+            ( memcmp( header.c_str(), C_CAPTURE_BLOCK_MAGIC, C_CAPTURE_MAGIC_LENGTH ) == 0 ) )
+    {
+        block.offset    = offset;
+        block.firstTime = amReadLittleEndian( header.c_str() + 12, 8 );
+        block.lastTime  = amReadLittleEndian( header.c_str() + 20, 8 );
+        offset         += C_CAPTURE_BLOCK_HEADER_SIZE + amReadLittleEndian( header.c_str() + 8, 4 );
+        if ( offset > fileSize )
+        {
+            break;
+        }
+        blocks.push_back( block );
+    }
+    return true;
+}
+
+int antCaptureReader::open
+(
+    const amString &fileName,
+    amString       &errorMessage
+)
+{
+    int         result = 0;
+    amString    header;
+    struct stat fileStatus;
+
+    fileDescriptor = ::open( fileName.c_str(), O_RDONLY );
+    if ( fileDescriptor < 0 )
+    {
+        errorMessage += "Could not open file \"";
+        errorMessage += fileName;
+        errorMessage += "\" for reading.\n";
+        result = E_READ_FILE_NOT_OPEN;
+    }
+    else if ( ( fstat( fileDescriptor, &fileStatus ) != 0 ) ||
+              !readAt( 0, C_CAPTURE_HEADER_SIZE, header ) ||
+              ( memcmp( header.c_str(), C_CAPTURE_MAGIC, C_CAPTURE_MAGIC_LENGTH ) != 0 ) ||
+              ( ( unsigned char ) header[ C_CAPTURE_MAGIC_LENGTH ] != C_CAPTURE_FORMAT_VERSION ) )
+    {
+        errorMessage += "The input is not a capture file (see option '-C').\n";
+        result = E_READ_ERROR;
+    }
+    else
+    {
+        indexed = readIndex( fileStatus.st_size );
+        if ( !indexed )
+        {
+            walkBlocks( fileStatus.st_size );
+        }
+    }
+    return result;
+}
+
+void antCaptureReader::close
+(
+    void
+)
+{
+    if ( fileDescriptor >= 0 )
+    {
+        ::close( fileDescriptor );
+        fileDescriptor = -1;
+    }
+}
+
+void antCaptureReader::selectBlocks
+(
+    const antCaptureSelection &selection,
+    std::vector<unsigned int> &blockNumbers
+) const
+{
+    std::set<unsigned int> candidates;
+
+    if ( indexed && selection.hasSensors() )
+    {
+        for ( std::map<unsigned int, std::vector<unsigned int> >::const_iterator sensor = sensorBlocks.begin(); sensor != sensorBlocks.end(); ++sensor )
+        {
+            if ( selection.matchSensor( sensor->first ) )
+            {
+                candidates.insert( sensor->second.begin(), sensor->second.end() );
+            }
+        }
+    }
+    else
+    {
+        for ( unsigned int counter = 0; counter < blocks.size(); ++counter )
+        {
+            candidates.insert( counter );
+        }
+    }
+
+    blockNumbers.clear();
+    for ( std::set<unsigned int>::const_iterator candidate = candidates.begin(); candidate != candidates.end(); ++candidate )
+    {
+        if ( selection.matchTime( blocks[ *candidate ].firstTime, blocks[ *candidate ].lastTime ) )
+        {
+            blockNumbers.push_back( *candidate );
+        }
+    }
+}
+
+int antCaptureReader::readBlock
+(
+    unsigned int  blockNumber,
+    amString     &errorMessage
+)
+{
+    int      result = 0;
+    amString header;
+
+    position         = 0;
+    remainingPackets = 0;
+    if ( ( blockNumber >= blocks.size() ) ||
+         !readAt( blocks[ blockNumber ].offset, C_CAPTURE_BLOCK_HEADER_SIZE, header ) ||
+         ( memcmp( header.c_str(), C_CAPTURE_BLOCK_MAGIC, C_CAPTURE_MAGIC_LENGTH ) != 0 ) ||
+         !readAt( blocks[ blockNumber ].offset + C_CAPTURE_BLOCK_HEADER_SIZE, amReadLittleEndian( header.c_str() + 8, 4 ), blockData ) )
+    {
+        errorMessage += "Invalid or truncated block in the capture file.\n";
+        result = E_READ_ERROR;
+    }
+    else
+    {
+        remainingPackets = amReadLittleEndian( header.c_str() + 4, 4 );
+    }
+    return result;
+}
+
+bool antCaptureReader::nextPacket
+(
+    const BYTE *&packet,
+    int         &nbBytes,
+    long long   &receiveTime
+)
+{
+    size_t length = 0;
+
+    if ( ( remainingPackets == 0 ) || ( position + C_CAPTURE_PACKET_HEADER_SIZE > blockData.size() ) )
+    {
+        return false;
+    }
+    receiveTime = amReadLittleEndian( blockData.c_str() + position, 8 );
+    length      = amReadLittleEndian( blockData.c_str() + position + 8, 2 );
+    position   += C_CAPTURE_PACKET_HEADER_SIZE;
+    if ( position + length > blockData.size() )
+    {
+        return false;
+    }
+    packet    = ( const BYTE * ) blockData.c_str() + position;
+    nbBytes   = length;
+    position += length;
+    --remainingPackets;
+    return true;
+}
@@ -0,0 +1,140 @@
+#ifndef __ANT_CAPTURE_FILE_H__
+#define __ANT_CAPTURE_FILE_H__
+
+#include <map>
+#include <vector>
+
+#include "am_string.h"
+#include "ant_constants.h"
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Indexed capture file (written with -C, read with -i).
+// The ANT+ packets are stored as received, with their receive time, in blocks followed by an index,
+// so a reader only touches the blocks holding the sensors and the time range it is asked for.
+// All numbers are little-endian.
+//
+//     "ANTC", format version (1 byte), 3 bytes reserved
+//     blocks:  "ANCB", number of packets (4 bytes), number of data bytes (4 bytes),
+//              receive time of the first and of the last packet (8 bytes each), then per packet:
+//              receive time in microseconds (8 bytes, signed), length (2 bytes), packet
+//     index:   number of blocks (4 bytes), per block: file offset (8 bytes), first and last receive
+//              time (8 bytes each);
+//              number of sensors (4 bytes), per sensor: device type (1 byte), device ID (2 bytes),
+//              number of blocks (4 bytes), block numbers (4 bytes each)
+//     trailer: file offset of the index (8 bytes), "ANCI"
+//
+// Packets which are not sent by a sensor (e.g. bridge status) are not listed in the sensor index.
+// A capture which was not closed (no trailer) is read by walking the blocks instead of the index.
+//
+// -------------------------------------------------------------------------------------------------//
+
+const long long C_CAPTURE_FIRST_TIME = -0x7FFFFFFFFFFFFFFFLL - 1;
+const long long C_CAPTURE_LAST_TIME  =  0x7FFFFFFFFFFFFFFFLL;
+
+struct antCaptureBlock
+{
+    long long offset;
+    long long firstTime;    // Microseconds
+    long long lastTime;
+};
+
+class antCaptureWriter
+{
+
+    private:
+
+        int                                                fileDescriptor;
+        long long                                          offset;
+        amString                                           blockData;
+        unsigned int                                       nbPackets;
+        long long                                          firstTime;
+        long long                                          lastTime;
+        std::vector<unsigned int>                          blockSensors;
+        std::vector<antCaptureBlock>                       blocks;
+        std::map<unsigned int, std::vector<unsigned int> > sensorBlocks;
+
+        int writeData ( const amString &data, amString &errorMessage );
+        int writeBlock( amString &errorMessage );
+
+
+    public:
+
+        antCaptureWriter( void );
+        ~antCaptureWriter( void );
+
+        inline bool isOpen( void ) const { return fileDescriptor >= 0; }
+
+        int open  ( const amString &fileName, amString &errorMessage );
+        int append( const BYTE *line, int nbBytes, long long microseconds, amString &errorMessage );
+        int close ( amString &errorMessage );
+
+};
+
+// Packets to take from a capture file (-n, -a, -z).
+class antCaptureSelection
+{
+
+    private:
+
+        std::vector<unsigned int> sensors;     // Device type (or C_NB_DEVICE_TYPES: any) * 65536 + device ID
+        long long                 fromTime;
+        long long                 toTime;
+
+
+    public:
+
+        antCaptureSelection( void );
+
+        bool addSensor( const char *sensor );
+        bool setFrom  ( const char *timeStamp );
+        bool setTo    ( const char *timeStamp );
+
+        inline bool isEmpty   ( void ) const { return sensors.empty() && ( fromTime == C_CAPTURE_FIRST_TIME ) && ( toTime == C_CAPTURE_LAST_TIME ); }
+        inline bool hasSensors( void ) const { return !sensors.empty(); }
+
+        bool matchSensor( unsigned int sensorKey ) const;
+        bool matchPacket( bool isSensor, unsigned int sensorKey, long long receiveTime ) const;
+        bool matchTime  ( long long firstTime, long long lastTime ) const;
+
+};
+
+class antCaptureReader
+{
+
+    private:
+
+        int                                                fileDescriptor;
+        bool                                               indexed;
+        std::vector<antCaptureBlock>                       blocks;
+        std::map<unsigned int, std::vector<unsigned int> > sensorBlocks;
+        amString                                           blockData;
+        size_t                                             position;
+        unsigned int                                       remainingPackets;
+
+        bool readAt     ( long long fileOffset, size_t nbBytes, amString &buffer );
+        bool readIndex  ( long long fileSize );
+        bool walkBlocks ( long long fileSize );
+
+
+    public:
+
+        antCaptureReader( void );
+        ~antCaptureReader( void );
+
+        inline bool isIndexed( void ) const { return indexed; }
+
+        int  open( const amString &fileName, amString &errorMessage );
+        void close( void );
+
+        // Numbers of the blocks which may hold packets of the selection, in file order.
+        void selectBlocks( const antCaptureSelection &selection, std::vector<unsigned int> &blockNumbers ) const;
+
+        int  readBlock ( unsigned int blockNumber, amString &errorMessage );
+        bool nextPacket( const BYTE *&packet, int &nbBytes, long long &receiveTime );
+
+        static bool getSensorKey( const BYTE *line, int nbBytes, unsigned int &sensorKey );
+
+};
+
+#endif // __ANT_CAPTURE_FILE_H__
@@ -0,0 +1,367 @@
+#include <string.h>
+
+#include "am_spsc_queue.h"
+#include "ant_processing.h"
+#include "ant_decode_pipeline.h"
+#include "ant_chunked_decoder.h"
+
+// Chunk number of a slot which has not been used yet.
+const unsigned int C_NO_CHUNK = ( unsigned int ) -1;
+
+antChunkedDecoder::antChunkedDecoder
+(
+    antProcessing &ownerProcessor
+) : owner( ownerProcessor )
+{
+    buffer        = NULL;
+    bufferSize    = 0;
+    nextStart     = 0;
+    stopRequested = 0;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Decode the semi-cooked records in 'data' with 'nbWorkers' threads and write the output.
+// Returns E_END_OF_FILE when all records have been processed, like the stream reader does.
+//
+// -------------------------------------------------------------------------------------------------//
+int antChunkedDecoder::decode
+(
+    const char   *data,
+    size_t        dataSize,
+    unsigned int  nbWorkers,
+    amString     &message
+)
+{
+    int           errorCode = 0;
+    long          waitTime  = C_MIN_WAIT_NS;
+    bool          finished  = false;
+    decodeWorker *worker    = NULL;
+
+    buffer     = data;
+    bufferSize = dataSize;
+    nextStart  = 0;
+    __atomic_store_n( &stopRequested, 0, __ATOMIC_RELAXED );
+
+    if ( bufferSize == 0 )
+    {
+        return E_END_OF_FILE;
+    }
+
+    for ( unsigned int counter = 0; ( errorCode == 0 ) && ( counter < nbWorkers ); ++counter )
+    {
+        worker                = new decodeWorker;
+        worker->decoder       = this;
+        worker->workerNo      = counter;
+        worker->threadRunning = false;
+        worker->processor     = owner.createWorker();
+        workers.push_back( worker );
+
+        if ( worker->processor == NULL )
+        {
+            errorCode = E_BAD_PARAMETER_VALUE;
+            message  += "Decoding with several threads is not supported by this program.\n";
+        }
+        else
+        {
+            errorCode = worker->processor->configureWorker( owner, counter, nbWorkers );
+        }
+    }
+
+    for ( unsigned int slotNo = 0; slotNo < C_CHUNK_SLOTS; ++slotNo )
+    {
+        chunks[ slotNo ].chunkNo = C_NO_CHUNK;
+        chunks[ slotNo ].results.resize( nbWorkers );
+    }
+    mergePositions.resize( nbWorkers );
+
+    for ( unsigned int chunkNo = 0; ( chunkNo < C_CHUNK_SLOTS ) && publishChunk( chunkNo ); ++chunkNo )
+    {
+    }
+
+    for ( unsigned int counter = 0; ( errorCode == 0 ) && ( counter < workers.size() ); ++counter )
+    {
+        if ( pthread_create( &( workers[ counter ]->thread ), NULL, workerThreadMain, workers[ counter ] ) != 0 )
+        {
+            errorCode = E_THREAD_CREATE_FAIL;
+            message  += "Creating a decode thread failed.\n";
+        }
+        else
+        {
+            workers[ counter ]->threadRunning = true;
+        }
+    }
+
+    // Write the chunks in order, and hand the slot of a written chunk over to a new one.
+    for ( unsigned int chunkNo = 0; ( errorCode == 0 ) && !finished; ++chunkNo )
+    {
+        chunk &current = chunks[ chunkNo % C_CHUNK_SLOTS ];
+
+        waitTime = C_MIN_WAIT_NS;
+        while ( __atomic_load_n( &( current.nbDone ), __ATOMIC_ACQUIRE ) < workers.size() )
+        {
+            amWaitNS( waitTime );
+        }
+
+        errorCode = writeChunk( current, finished, message );
+        if ( !finished )
+        {
+            publishChunk( chunkNo + C_CHUNK_SLOTS );
+        }
+    }
+
+    __atomic_store_n( &stopRequested, 1, __ATOMIC_RELEASE );
+    for ( unsigned int counter = 0; counter < workers.size(); ++counter )
+    {
+        if ( workers[ counter ]->threadRunning )
+        {
+            pthread_join( workers[ counter ]->thread, NULL );
+        }
+    }
+    saveSensorStates();
+    for ( unsigned int counter = 0; counter < workers.size(); ++counter )
+    {
+        if ( workers[ counter ]->processor != NULL )
+        {
+            owner.addSensorCounters( *workers[ counter ]->processor );
+        }
+        delete workers[ counter ]->processor;
+        delete workers[ counter ];
+    }
+    workers.clear();
+
+    return ( errorCode == 0 ) ? E_END_OF_FILE : errorCode;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// The decode threads hold the sensor states: hand them to the state checkpoint (option '-k') before
+// the processors of the threads are deleted.
+//
+// -------------------------------------------------------------------------------------------------//
+void antChunkedDecoder::saveSensorStates
+(
+    void
+)
+{
+    antStateCheckpoint &checkpoint = owner.getStateCheckpoint();
+    unsigned int        snapshotNo = 0;
+
+    if ( checkpoint.isRunning() )
+    {
+        snapshotNo = checkpoint.begin( workers.size(), true );
+        for ( unsigned int counter = 0; counter < workers.size(); ++counter )
+        {
+            if ( workers[ counter ]->processor != NULL )
+            {
+                workers[ counter ]->processor->saveSensorStates( checkpoint, snapshotNo );
+            }
+        }
+    }
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Put the next chunk of the input (ending after a new line) into its slot and let the decode
+// threads start on it. Returns false if all of the input has been handed out already.
+//
+// -------------------------------------------------------------------------------------------------//
+bool antChunkedDecoder::publishChunk
+(
+    unsigned int chunkNo
+)
+{
+    chunk      &current = chunks[ chunkNo % C_CHUNK_SLOTS ];
+    size_t      end     = 0;
+    const char *newLine = NULL;
+
+    if ( nextStart >= bufferSize )
+    {
+        return false;
+    }
+
+    end = ( bufferSize - nextStart > C_CHUNK_SIZE ) ? nextStart + C_CHUNK_SIZE : bufferSize;
+    if ( end < bufferSize )
+    {
+        newLine = ( const char * ) memchr( buffer + end, '\n', bufferSize - end );
+        end     = ( newLine == NULL ) ? bufferSize : ( newLine - buffer ) + 1;
+    }
+
+    current.start  = nextStart;
+    current.end    = end;
+    current.last   = ( end == bufferSize );
+    current.nbDone = 0;
+    nextStart      = end;
+    __atomic_store_n( &( current.chunkNo ), chunkNo, __ATOMIC_RELEASE );
+
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Write the output of a chunk: merge the lines of all decode threads by their line numbers.
+// 'finished' is set if nothing follows this chunk (end of input or an error).
+//
+// -------------------------------------------------------------------------------------------------//
+int antChunkedDecoder::writeChunk
+(
+    chunk    &current,
+    bool     &finished,
+    amString &message
+)
+{
+    int          resultCode = 0;
+    unsigned int lineNo     = 0;
+    unsigned int workerNo   = 0;
+    size_t       position   = 0;
+    size_t       begin      = 0;
+    bool         found      = true;
+
+    for ( workerNo = 0; workerNo < workers.size(); ++workerNo )
+    {
+        mergePositions[ workerNo ] = 0;
+    }
+
+    while ( ( resultCode == 0 ) && found )
+    {
+        found  = false;
+        lineNo = C_NO_CHUNK;
+        for ( unsigned int counter = 0; counter < workers.size(); ++counter )
+        {
+            chunkResult &result = current.results[ counter ];
+            if ( ( mergePositions[ counter ] < result.lineNos.size() ) && ( result.lineNos[ mergePositions[ counter ] ] < lineNo ) )
+            {
+                lineNo   = result.lineNos[ mergePositions[ counter ] ];
+                workerNo = counter;
+                found    = true;
+            }
+        }
+
+        if ( found )
+        {
+            chunkResult &result = current.results[ workerNo ];
+            position   = mergePositions[ workerNo ];
+            begin      = ( position == 0 ) ? 0 : result.outputEnds[ position - 1 ];
+            resultCode = owner.writeDecodedOutput( result.output.data() + begin, result.outputEnds[ position ] - begin, message );
+            ++mergePositions[ workerNo ];
+
+            if ( ( resultCode == 0 ) && ( result.errorCode != 0 ) && ( mergePositions[ workerNo ] == result.lineNos.size() ) )
+            {
+                // The thread stopped at this line, and so does the output.
+                resultCode = result.errorCode;
+                message   += result.errorMessage;
+            }
+        }
+    }
+
+    finished = current.last || current.results[ 0 ].stopped || ( resultCode != 0 );
+    return resultCode;
+}
+
+void *antChunkedDecoder::workerThreadMain
+(
+    void *worker
+)
+{
+    ( ( decodeWorker * ) worker )->decoder->runWorker( *( ( decodeWorker * ) worker ) );
+    return NULL;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Main loop of a decode thread: decode the chunks in order until the input or the output is done.
+//
+// -------------------------------------------------------------------------------------------------//
+void antChunkedDecoder::runWorker
+(
+    decodeWorker &worker
+)
+{
+    long         waitTime = C_MIN_WAIT_NS;
+    bool         finished = false;
+    unsigned int chunkNo  = 0;
+
+    for ( chunkNo = 0; !finished; ++chunkNo )
+    {
+        chunk &current = chunks[ chunkNo % C_CHUNK_SLOTS ];
+
+        waitTime = C_MIN_WAIT_NS;
+        while ( __atomic_load_n( &( current.chunkNo ), __ATOMIC_ACQUIRE ) != chunkNo )
+        {
+            if ( __atomic_load_n( &stopRequested, __ATOMIC_ACQUIRE ) != 0 )
+            {
+                return;
+            }
+            amWaitNS( waitTime );
+        }
+
+        decodeChunk( worker, current );
+
+        chunkResult &result = current.results[ worker.workerNo ];
+        finished = current.last || result.stopped || ( result.errorCode != 0 );
+        __atomic_add_fetch( &( current.nbDone ), 1, __ATOMIC_RELEASE );
+    }
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Decode the lines of a chunk which belong to the devices of a decode thread.
+// Lines are handled like readSemiCookedSingleLineFromStream() does it: empty lines are skipped,
+// a line is cut at a '\0', and a line too long for the line buffer is cut and ends the input.
+//
+// -------------------------------------------------------------------------------------------------//
+void antChunkedDecoder::decodeChunk
+(
+    decodeWorker &worker,
+    chunk        &current
+)
+{
+    chunkResult  &result     = current.results[ worker.workerNo ];
+    size_t        position   = current.start;
+    size_t        length     = 0;
+    size_t        textLength = 0;
+    unsigned int  lineNo     = 0;
+    unsigned int  nbWorkers  = current.results.size();
+    const char   *lineStart  = NULL;
+    const char   *lineEnd    = NULL;
+
+    result.output.clear();
+    result.lineNos.clear();
+    result.outputEnds.clear();
+    result.errorCode = 0;
+    result.errorMessage.clear();
+    result.stopped   = false;
+
+    while ( ( position < current.end ) && ( result.errorCode == 0 ) && !result.stopped )
+    {
+        lineStart = buffer + position;
+        lineEnd   = ( const char * ) memchr( lineStart, '\n', current.end - position );
+        length    = ( lineEnd == NULL ) ? current.end - position : lineEnd - lineStart;
+        if ( length >= C_BUFFER_SIZE )
+        {
+            length         = C_BUFFER_SIZE - 1;
+            result.stopped = true;
+        }
+
+        textLength = strnlen( lineStart, length );
+        if ( ( textLength > 0 ) && ( antDecodePipeline::getSemiCookedKey( lineStart, textLength ) % nbWorkers == worker.workerNo ) )
+        {
+            worker.line.assign( lineStart, textLength );
+            result.errorCode = worker.processor->decodeSemiCookedLine( worker.line.c_str(), result.output, worker.message );
+            result.lineNos.push_back( lineNo );
+            result.outputEnds.push_back( result.output.size() );
+            if ( result.errorCode != 0 )
+            {
+                result.errorMessage = worker.message;
+                if ( result.stopped || ( current.last && ( lineEnd == NULL ) ) )
+                {
+                    // The stream reader reports the end of the input instead of the error of its last line.
+                    result.errorCode = E_END_OF_FILE;
+                }
+            }
+        }
+
+        ++lineNo;
+        position += length + 1;
+    }
+}
@@ -0,0 +1,87 @@
+#ifndef __ANT_CHUNKED_DECODER_H__
+#define __ANT_CHUNKED_DECODER_H__
+
+#include <pthread.h>
+#include <vector>
+
+#include "ant_constants.h"
+#include "am_string.h"
+
+class antProcessing;
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Decode a semi-cooked file held in memory with several threads (options '-s' and '-j').
+// The file is split at line boundaries into chunks of about C_CHUNK_SIZE bytes. Every decode thread
+// goes through all lines of a chunk but only decodes the lines of its own devices (see
+// antDecodePipeline::getSemiCookedKey), so the per-sensor state (totals, zero time counts, previous
+// values) of a device is carried over the seams between chunks by the one thread that owns it and
+// the result is exactly that of the single threaded program.
+// The calling thread merges the output of a chunk in the order of the lines and writes it while
+// the decode threads work on the next chunks (up to C_CHUNK_SLOTS chunks are in flight).
+//
+// -------------------------------------------------------------------------------------------------//
+class antChunkedDecoder
+{
+
+    private:
+
+        struct chunkResult
+        {
+            amString                  output;        // Captured output of the lines of one thread.
+            std::vector<unsigned int> lineNos;       // Number (within the chunk) of each of these lines.
+            std::vector<size_t>       outputEnds;    // End of the output of each of these lines.
+            int                       errorCode;     // Error of the last of these lines.
+            amString                  errorMessage;
+            bool                      stopped;       // An overlong line ends the input (like std::istream::getline).
+        };
+
+        struct chunk
+        {
+            unsigned int             chunkNo;        // Number of the chunk held by this slot.
+            unsigned int             nbDone;         // Number of threads done with the chunk.
+            size_t                   start;
+            size_t                   end;
+            bool                     last;
+            std::vector<chunkResult> results;        // One per decode thread.
+        };
+
+        struct decodeWorker
+        {
+            antChunkedDecoder *decoder;
+            antProcessing     *processor;
+            unsigned int       workerNo;
+            amString           line;
+            amString           message;
+            pthread_t          thread;
+            bool               threadRunning;
+        };
+
+        antProcessing               &owner;
+        const char                  *buffer;
+        size_t                       bufferSize;
+        size_t                       nextStart;
+        chunk                        chunks[ C_CHUNK_SLOTS ];
+        std::vector<decodeWorker *>  workers;
+        std::vector<size_t>          mergePositions;
+        int                          stopRequested;
+
+        static void *workerThreadMain( void *worker );
+        void runWorker  ( decodeWorker &worker );
+        void decodeChunk( decodeWorker &worker, chunk &current );
+
+        bool publishChunk    ( unsigned int chunkNo );
+        int  writeChunk      ( chunk &current, bool &finished, amString &message );
+        void saveSensorStates( void );
+
+
+    public:
+
+        antChunkedDecoder( antProcessing &ownerProcessor );
+        ~antChunkedDecoder( void ) {}
+
+        int decode( const char *data, size_t dataSize, unsigned int nbWorkers, amString &message );
+
+};
+
+#endif // __ANT_CHUNKED_DECODER_H__
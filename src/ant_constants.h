@@ -34,6 +34,12 @@ const char C_COPYRIGHT[]  = "Copyright (c) Alphamantis Technologies Inc. 2016";
 #define C_SMALL_BUFFER_SIZE   ( 1 <<  8 )
 #define C_TINY_BUFFER_SIZE    ( 1 <<  6 )
 #define C_ANT_PAYLOAD_LENGTH  8
+#define C_MC_BATCH_SIZE       32
+#define C_OUTPUT_QUEUE_SIZE   16   // Number of output chunks queued for the writer thread (power of 2).
+#define C_PIPELINE_QUEUE_SIZE 256   // Number of packets queued per decode thread (power of 2).
+#define C_CHUNK_SIZE          ( 1 << 22 )   // Size of the chunks a mapped semi-cooked file is decoded in (with '-j').
+#define C_CHUNK_SLOTS         4   // Number of chunks in flight.
+#define C_MC_MAX_DATAGRAM_SIZE 65507   // Largest UDP payload.
 
 enum amOperatingSystem
 {
@@ -71,6 +77,8 @@ const int E_BAD_PARAMETER_VALUE   = 10001;
 
 const int E_READ_ERROR            = 90001;
 const int E_READ_FILE_NOT_OPEN    = 90002;
+const int E_WRITE_FILE_NOT_OPEN   = 90003;
+const int E_WRITE_ERROR           = 90004;
 const int E_END_OF_FILE           = 90099;
 
 
@@ -84,6 +92,7 @@ const int E_SOCKET_CREATE_FAIL    = 90101;
 const int E_SOCKET_SET_OPT_FAIL   = 90102;
 const int E_SOCKET_BIND_FAIL      = 90103;
 const int E_LOOP_BACK_IP_ADDRESS  = 90104;
+const int E_THREAD_CREATE_FAIL    = 90105;
 const int E_EMPTY_MESSAGE         = 91099;
 
 const int E_BAD_OPTION            = 99998;
@@ -99,6 +108,14 @@ const bool C_DEFAULT_SEMI_COOKED_IN                         = false;
 const bool C_DEFAULT_SEMI_COOKED_OUT                        = false;
 const bool C_DEFAULT_OUTPUT_AS_JSON                         = false;
 const bool C_DEFAULT_OUTPUT_RAW                             = false;
+const bool C_DEFAULT_BINARY_IN                              = false;
+const bool C_DEFAULT_BINARY_OUT                             = false;
+const bool C_DEFAULT_CAPTURE_IN                             = false;
+const bool C_DEFAULT_WATCH_DEVICE_FILE                      = false;   // Reload the device file when it changes or on SIGHUP.
+const bool C_DEFAULT_TRACK_SEQUENCES                        = false;   // Count the sequence gaps of the bridges (-G).
+const bool C_DEFAULT_MARK_SEQUENCE_GAPS                     = false;   // Mark the records which follow a sequence gap (-G).
+const bool C_DEFAULT_OUTPUT_FLUSH_ON_IDLE                   = true;    // Flush output whenever no more input is waiting.
+const bool C_DEFAULT_OUTPUT_USE_THREAD                      = false;   // Write stdout from a separate thread.
 const bool C_DEFAULT_DIAGNOSTICS                            = false;
 const bool C_DEFAULT_ONLY_REGISTERED_DEVICES                = false;
 
@@ -208,6 +225,9 @@ const char C_ANT_FS_SESSION[]                               = "ANT_FS_SESSION";
 
 const char C_DEFAULT_DEVICE_FILE[]                          = "";
 const char C_DEFAULT_INPUT_FILE_NAME[]                      = "";
+const char C_DEFAULT_CAPTURE_FILE_NAME[]                    = "";
+const char C_DEFAULT_STATE_FILE_NAME[]                      = "";
+const char C_DEFAULT_STATS_FILE_NAME[]                      = "";
 const char C_DEFAULT_INTERFACE[]                            = C_AUTO_INTERFACE;
 const char C_DEFAULT_MC_ADDRESS_IN[]                        = "239.78.80.1";
 const char C_DEFAULT_MC_ADDRESS_OUT[]                       = "";
@@ -250,6 +270,8 @@ const char C_SBSDM_DEVICE_HEAD[]                            = "SBSDM_";
 const char C_UNKNOWN_TYPE_HEAD[]                            = "TYPE";
 const char C_PACKET_SAVER_HEAD[]                            = "PACKET_";
 const char C_BRIDGE_MESSAGE_ID[]                            = "BDG_";
+const char C_SEQUENCE_MESSAGE_ID[]                          = "SEQ_";
+const char C_SEQUENCE_GAP_SYMBOL[]                          = "GAP";
 const char C_COMMENT_SYMBOL                                 = '#';
 const char C_COMMENT_SYMBOL_AS_STRING[]                     = { C_COMMENT_SYMBOL, 0 };
 const char C_INCLUDE_FILE[]                                 = "AM_INCLUDE";
@@ -324,6 +346,25 @@ const int    C_DEFAULT_VALUE_PRECISION_DEFAULT              =     6;
 const int    C_DEFAULT_MC_PORT_NO_IN                        = 51113;
 const int    C_DEFAULT_MC_PORT_NO_OUT                       =     0;
 const int    C_DEFAULT_TIME_OUT_SEC                         =     0;   // Time out after x seconds of inactivity. x = 0: Do not time out.
+const int    C_DEFAULT_RECEIVE_BUFFER_SIZE                  =     0;   // Size of the multicast socket receive buffer in bytes. 0: System default.
+const int    C_DEFAULT_OUTPUT_BUFFER_SIZE                   = 65536;   // Flush output when this many bytes are pending. 0: Flush every record.
+const int    C_DEFAULT_OUTPUT_MAX_RECORDS                   =     0;   // Flush output after this many records. 0: No limit.
+const int    C_DEFAULT_OUTPUT_MAX_DELAY_MS                  =   100;   // Flush output when the oldest pending record is older (in ms). 0: No limit.
+const int    C_DEFAULT_MC_COALESCE_DELAY_MS                 =    10;   // Send coalesced multicast records at the latest after x ms.
+const int    C_DEFAULT_DECODE_THREADS                       =     1;   // Number of decode threads. 1: Decode in the reading thread.
+const int    C_MAX_DECODE_THREADS                           =    64;
+const int    C_CAPTURE_BLOCK_SIZE                           = 65536;   // Write a block of the capture file (-C) when it holds this many bytes ...
+const int    C_CAPTURE_BLOCK_SECONDS                        =    10;   // ... or when it spans this many seconds.
+const int    C_NB_DEVICE_TYPES                              =   256;   // Device types are a single byte.
+const int    C_DEFAULT_CHECKPOINT_SECONDS                   =    60;   // Save the sensor states (-k) every x seconds.
+const int    C_DEFAULT_SENSOR_IDLE_SECONDS                  =     0;   // Forget sensors not heard from for x seconds. 0: Never.
+const int    C_DEFAULT_MAX_SENSORS                          =     0;   // Keep the state of at most x sensors. 0: No limit.
+const int    C_EVICTION_INTERVAL_SECONDS                    =     1;   // Look for idle sensors every x seconds.
+const int    C_DEFAULT_STATS_INTERVAL_SECONDS               =     0;   // Write the statistics (-Y) every x seconds. 0: Only on SIGUSR1 and at the end.
+const int    C_DEFAULT_SEQUENCE_INTERVAL_SECONDS            =    60;   // Write the sequence gap records (-G) every x seconds. 0: Only at the end.
+const int    C_MICROSECOND_DIGITS                           =     6;   // Receive times are kept in microseconds since 1970.
+const long   C_MIN_WAIT_NS                                  = 50000;   // Waiting times of threads polling an empty (or full) queue.
+const long   C_MAX_WAIT_NS                                  = 5000000;
 
 const double C_DBL_UNDEFINED                                = 1.0E13;
 const double C_TWO_PI                                       = 4.0 * acos( 0 );         // 2 PI
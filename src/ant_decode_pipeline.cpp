@@ -0,0 +1,518 @@
+#include <string.h>
+
+#include "ant_processing.h"
+#include "ant_decode_pipeline.h"
+
+// Offset of the payload in a binary ANT+ packet (see antProcessing::ant2txt).
+const int C_PAYLOAD_OFFSET = 7;
+
+antDecodePipeline::antDecodePipeline
+(
+    antProcessing &ownerProcessor
+) : owner( ownerProcessor )
+{
+    writerRunning = false;
+    inputDone     = 0;
+    errorCode     = 0;
+    idleRequests  = 0;
+    flushRequests = 0;
+}
+
+antDecodePipeline::~antDecodePipeline
+(
+    void
+)
+{
+    amString message;
+    stop( message );
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Create the decode threads (each with a processor of its own) and the writer thread.
+//
+// -------------------------------------------------------------------------------------------------//
+int antDecodePipeline::start
+(
+    unsigned int  nbWorkers,
+    amString     &message
+)
+{
+    decodeWorker *worker = NULL;
+
+    order.resize( nbWorkers * C_PIPELINE_QUEUE_SIZE );
+    for ( unsigned int counter = 0; ( errorCode == 0 ) && ( counter < nbWorkers ); ++counter )
+    {
+        worker                = new decodeWorker;
+        worker->pipeline      = this;
+        worker->threadRunning = false;
+        worker->processor     = owner.createWorker();
+        worker->input.resize( C_PIPELINE_QUEUE_SIZE );
+        worker->output.resize( C_PIPELINE_QUEUE_SIZE );
+        workers.push_back( worker );
+
+        if ( worker->processor == NULL )
+        {
+            errorCode = E_BAD_PARAMETER_VALUE;
+            message  += "Decoding with several threads is not supported by this program.\n";
+        }
+        else
+        {
+            errorCode = worker->processor->configureWorker( owner, counter, nbWorkers );
+        }
+    }
+
+    for ( unsigned int counter = 0; ( errorCode == 0 ) && ( counter < workers.size() ); ++counter )
+    {
+        if ( pthread_create( &( workers[ counter ]->thread ), NULL, workerThreadMain, workers[ counter ] ) != 0 )
+        {
+            errorCode = E_THREAD_CREATE_FAIL;
+            message  += "Creating a decode thread failed.\n";
+        }
+        else
+        {
+            workers[ counter ]->threadRunning = true;
+        }
+    }
+
+    if ( errorCode == 0 )
+    {
+        if ( pthread_create( &writerThread, NULL, writerThreadMain, this ) != 0 )
+        {
+            errorCode = E_THREAD_CREATE_FAIL;
+            message  += "Creating the decode writer thread failed.\n";
+        }
+        else
+        {
+            writerRunning = true;
+        }
+    }
+
+    return errorCode;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// No more input: wait until all packets have been decoded and written, then stop all threads.
+// Returns the first error of the decode or writer threads.
+//
+// -------------------------------------------------------------------------------------------------//
+int antDecodePipeline::stop
+(
+    amString &message
+)
+{
+    __atomic_store_n( &inputDone, 1, __ATOMIC_RELEASE );
+
+    for ( unsigned int counter = 0; counter < workers.size(); ++counter )
+    {
+        if ( workers[ counter ]->threadRunning )
+        {
+            pthread_join( workers[ counter ]->thread, NULL );
+        }
+    }
+    if ( writerRunning )
+    {
+        pthread_join( writerThread, NULL );
+        writerRunning = false;
+    }
+
+    for ( unsigned int counter = 0; counter < workers.size(); ++counter )
+    {
+        if ( workers[ counter ]->processor != NULL )
+        {
+            owner.addSensorCounters( *workers[ counter ]->processor );
+        }
+        delete workers[ counter ]->processor;
+        delete workers[ counter ];
+    }
+    workers.clear();
+
+    message += errorMessage;
+    errorMessage.clear();
+
+    return errorCode;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Hand a binary ANT+ packet over to the decode thread of its device.
+// 'line' must hold at least C_BUFFER_SIZE bytes (like for antProcessing::ant2txtLine).
+// Returns the first error of the decode or writer threads.
+//
+// -------------------------------------------------------------------------------------------------//
+int antDecodePipeline::dispatchFrame
+(
+    const BYTE         *line,
+    int                 nbBytes,
+    long long           receiveTime,
+    unsigned long long  gapTag
+)
+{
+    unsigned int workerNo    = 0;
+    size_t       nbCopied    = ( nbBytes > C_BUFFER_SIZE ) ? nbBytes : C_BUFFER_SIZE;
+    int          payLoadSize = nbBytes - C_PAYLOAD_OFFSET;
+    int          flagOffset  = 0;
+    inputSlot   *slot        = NULL;
+
+    // The extended message flag follows the (possibly truncated) payload, the device ID follows the flag.
+    payLoadSize = ( payLoadSize < 0 ) ? 0 : ( ( payLoadSize > C_ANT_PAY_LOAD_COUNT ) ? C_ANT_PAY_LOAD_COUNT : payLoadSize );
+    flagOffset  = C_PAYLOAD_OFFSET + payLoadSize;
+    if ( ( line[ 2 ] == C_ANT_ASYNC_MSG ) && ( ( line[ flagOffset ] & 0x80 ) != 0 ) )
+    {
+        workerNo = ( 256 * line[ flagOffset + 2 ] + line[ flagOffset + 1 ] ) % workers.size();
+    }
+
+    slot              = getInputSlot( workerNo );
+    slot->semiCooked  = false;
+    slot->passThrough = false;
+    slot->snapshotNo  = 0;
+    slot->nbBytes     = nbBytes;
+    slot->receiveTime = receiveTime;
+    slot->gapTag      = gapTag;
+    if ( slot->data.size() < nbCopied )
+    {
+        slot->data.resize( nbCopied );
+    }
+    memcpy( &( slot->data[ 0 ] ), line, nbCopied );
+
+    return dispatch( workerNo );
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Return the number by which a semi-cooked input line is assigned to a decode thread.
+// This is the device ID, i.e. the number after the last '_' of the sensor ID (the first word of the
+// line). Sensor IDs without a device number are spread by a hash of the whole ID.
+//
+// -------------------------------------------------------------------------------------------------//
+unsigned int antDecodePipeline::getSemiCookedKey
+(
+    const char *line,
+    size_t      length
+)
+{
+    size_t       idEnd   = 0;
+    size_t       idStart = 0;
+    unsigned int key     = 0;
+
+    while ( ( idEnd < length ) && ( line[ idEnd ] != ' ' ) && ( line[ idEnd ] != '\t' ) )
+    {
+        ++idEnd;
+    }
+    idStart = idEnd;
+    while ( ( idStart > 0 ) && ( line[ idStart - 1 ] >= '0' ) && ( line[ idStart - 1 ] <= '9' ) )
+    {
+        --idStart;
+    }
+    if ( ( idStart > 0 ) && ( idStart < idEnd ) && ( line[ idStart - 1 ] == '_' ) )
+    {
+        for ( size_t counter = idStart; counter < idEnd; ++counter )
+        {
+            key = 10 * key + ( line[ counter ] - '0' );
+        }
+    }
+    else
+    {
+        key = 2166136261U;
+        for ( size_t counter = 0; counter < idEnd; ++counter )
+        {
+            key ^= ( unsigned char ) line[ counter ];
+            key *= 16777619U;
+        }
+    }
+    return key;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Hand a semi-cooked input line over to the decode thread of its device.
+// Returns the first error of the decode or writer threads.
+//
+// -------------------------------------------------------------------------------------------------//
+int antDecodePipeline::dispatchSemiCookedLine
+(
+    const char *line
+)
+{
+    size_t       length   = strlen( line );
+    unsigned int workerNo = getSemiCookedKey( line, length ) % workers.size();
+    inputSlot   *slot     = NULL;
+
+    slot              = getInputSlot( workerNo );
+    slot->semiCooked  = true;
+    slot->passThrough = false;
+    slot->snapshotNo  = 0;
+    slot->nbBytes     = length;
+    if ( slot->data.size() < length + 1 )
+    {
+        slot->data.resize( ( length < C_BUFFER_SIZE ) ? C_BUFFER_SIZE : length + 1 );
+    }
+    memcpy( &( slot->data[ 0 ] ), line, length + 1 );
+
+    return dispatch( workerNo );
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Hand a record made by the reading thread (e.g. a sequence gap record) to the output, after the
+// output of the packets dispatched so far.
+// Returns the first error of the decode or writer threads.
+//
+// -------------------------------------------------------------------------------------------------//
+int antDecodePipeline::dispatchOutput
+(
+    const amString &text
+)
+{
+    inputSlot *slot = getInputSlot( 0 );
+
+    slot->semiCooked  = false;
+    slot->passThrough = true;
+    slot->snapshotNo  = 0;
+    slot->text        = text;
+
+    return dispatch( 0 );
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Let every decode thread hand its sensor states to the state checkpoint (see antStateCheckpoint)
+// once it has decoded the packets dispatched so far. No output is written for this.
+//
+// -------------------------------------------------------------------------------------------------//
+void antDecodePipeline::dispatchSnapshot
+(
+    unsigned int snapshotNo
+)
+{
+    inputSlot *slot = NULL;
+
+    for ( unsigned int workerNo = 0; workerNo < workers.size(); ++workerNo )
+    {
+        slot             = getInputSlot( workerNo );
+        slot->snapshotNo = snapshotNo;
+        workers[ workerNo ]->input.push();
+    }
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// The input is idle: once everything dispatched so far has been written, the writer thread lets
+// the pending output go (see antProcessing::flushIdleOutput).
+//
+// -------------------------------------------------------------------------------------------------//
+void antDecodePipeline::idle
+(
+    bool flushMulticast
+)
+{
+    __atomic_add_fetch( flushMulticast ? &flushRequests : &idleRequests, 1, __ATOMIC_RELEASE );
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Return the next free input slot of a decode thread, waiting while its queue is full.
+//
+// -------------------------------------------------------------------------------------------------//
+antDecodePipeline::inputSlot *antDecodePipeline::getInputSlot
+(
+    unsigned int workerNo
+)
+{
+    long       waitTime = C_MIN_WAIT_NS;
+    inputSlot *slot     = NULL;
+
+    while ( ( slot = workers[ workerNo ]->input.getBack() ) == NULL )
+    {
+        amWaitNS( waitTime );
+    }
+    return slot;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Publish the filled input slot of a decode thread and tell the writer thread where to find the
+// output of this packet.
+//
+// -------------------------------------------------------------------------------------------------//
+int antDecodePipeline::dispatch
+(
+    unsigned int workerNo
+)
+{
+    long          waitTime = C_MIN_WAIT_NS;
+    unsigned int *entry    = NULL;
+
+    while ( ( entry = order.getBack() ) == NULL )
+    {
+        amWaitNS( waitTime );
+    }
+    *entry = workerNo;
+    order.push();
+    workers[ workerNo ]->input.push();
+
+    return __atomic_load_n( &errorCode, __ATOMIC_ACQUIRE );
+}
+
+void *antDecodePipeline::workerThreadMain
+(
+    void *worker
+)
+{
+    ( ( decodeWorker * ) worker )->pipeline->runWorker( *( ( decodeWorker * ) worker ) );
+    return NULL;
+}
+
+void *antDecodePipeline::writerThreadMain
+(
+    void *pipeline
+)
+{
+    ( ( antDecodePipeline * ) pipeline )->runWriter();
+    return NULL;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Main loop of a decode thread: decode the queued packets in order until the input is done.
+//
+// -------------------------------------------------------------------------------------------------//
+void antDecodePipeline::runWorker
+(
+    decodeWorker &worker
+)
+{
+    long        waitTime = C_MIN_WAIT_NS;
+    inputSlot  *input    = NULL;
+    outputSlot *output   = NULL;
+
+    while ( true )
+    {
+        input = worker.input.getFront();
+        if ( input == NULL )
+        {
+            if ( ( __atomic_load_n( &inputDone, __ATOMIC_ACQUIRE ) != 0 ) && worker.input.isEmpty() )
+            {
+                break;
+            }
+            amWaitNS( waitTime );
+            continue;
+        }
+
+        if ( input->snapshotNo != 0 )
+        {
+            worker.processor->saveSensorStates( owner.getStateCheckpoint(), input->snapshotNo );
+            worker.input.pop();
+            waitTime = C_MIN_WAIT_NS;
+            continue;
+        }
+
+        while ( ( output = worker.output.getBack() ) == NULL )
+        {
+            amWaitNS( waitTime );
+        }
+
+        output->output.clear();
+        if ( input->passThrough )
+        {
+            output->errorCode = worker.processor->decodeOutput( input->text, output->output, output->errorMessage );
+        }
+        else if ( input->semiCooked )
+        {
+            output->errorCode = worker.processor->decodeSemiCookedLine( ( const char * ) &( input->data[ 0 ] ), output->output, output->errorMessage );
+        }
+        else
+        {
+            output->errorCode = worker.processor->decodeFrame( &( input->data[ 0 ] ), input->nbBytes, input->receiveTime, output->output, output->errorMessage, input->gapTag );
+        }
+
+        worker.output.push();
+        worker.input.pop();
+        waitTime = C_MIN_WAIT_NS;
+    }
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Main loop of the writer thread: write the decoded packets in the order they were read.
+// After an error the remaining output is dropped (like the single threaded program stops).
+//
+// -------------------------------------------------------------------------------------------------//
+void antDecodePipeline::runWriter
+(
+    void
+)
+{
+    long          waitTime      = C_MIN_WAIT_NS;
+    bool          done          = false;
+    int           resultCode    = 0;
+    unsigned int  nbIdle        = 0;
+    unsigned int  nbFlush       = 0;
+    unsigned int  handledIdle   = 0;
+    unsigned int  handledFlush  = 0;
+    unsigned int *workerNo      = NULL;
+    outputSlot   *result        = NULL;
+    amString      message;
+
+    while ( true )
+    {
+        // Read the requests before looking at the queue: a request is only handled once all
+        // packets dispatched before it have been written.
+        done     = ( __atomic_load_n( &inputDone, __ATOMIC_ACQUIRE ) != 0 );
+        nbIdle   = __atomic_load_n( &idleRequests, __ATOMIC_ACQUIRE );
+        nbFlush  = __atomic_load_n( &flushRequests, __ATOMIC_ACQUIRE );
+        workerNo = order.getFront();
+
+        if ( workerNo == NULL )
+        {
+            if ( resultCode == 0 )
+            {
+                if ( ( nbIdle != handledIdle ) || ( nbFlush != handledFlush ) )
+                {
+                    resultCode = owner.flushIdleOutput( nbFlush != handledFlush, message );
+                }
+                else
+                {
+                    resultCode = owner.flushDueOutput( message );
+                }
+            }
+            handledIdle  = nbIdle;
+            handledFlush = nbFlush;
+            if ( done )
+            {
+                break;
+            }
+        }
+        else
+        {
+            result = workers[ *workerNo ]->output.getFront();
+            if ( result != NULL )
+            {
+                if ( resultCode == 0 )
+                {
+                    resultCode = owner.writeDecodedOutput( result->output.data(), result->output.size(), message );
+                    if ( resultCode == 0 )
+                    {
+                        resultCode = result->errorCode;
+                    }
+                    message += result->errorMessage;
+                }
+                workers[ *workerNo ]->output.pop();
+                order.pop();
+                waitTime = C_MIN_WAIT_NS;
+            }
+        }
+
+        if ( ( resultCode != 0 ) && ( __atomic_load_n( &errorCode, __ATOMIC_RELAXED ) == 0 ) )
+        {
+            errorMessage = message;
+            __atomic_store_n( &errorCode, resultCode, __ATOMIC_RELEASE );
+        }
+
+        if ( ( workerNo == NULL ) || ( result == NULL ) )
+        {
+            amWaitNS( waitTime );
+        }
+    }
+}
@@ -0,0 +1,97 @@
+#ifndef __ANT_DECODE_PIPELINE_H__
+#define __ANT_DECODE_PIPELINE_H__
+
+#include <pthread.h>
+#include <vector>
+
+#include "ant_constants.h"
+#include "am_string.h"
+#include "am_spsc_queue.h"
+
+class antProcessing;
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Decode the input with several threads (option '-j').
+// The reading thread hands every packet to one of the decode threads, chosen by the device ID of
+// the packet, so the per-sensor state of a device is only ever seen by a single thread. Every decode
+// thread owns a processor of its own (see antProcessing::createWorker) configured like the owner.
+// A writer thread collects the decoded output in the order of the input and writes it through the
+// stdout writer and the multicast connection of the owner.
+// All hand-overs are single producer/single consumer queues: one input and one output queue per
+// decode thread, and the order queue which tells the writer which thread has the next packet.
+//
+// -------------------------------------------------------------------------------------------------//
+class antDecodePipeline
+{
+
+    private:
+
+        struct inputSlot
+        {
+            bool               semiCooked;
+            bool               passThrough;  // No input, output 'text' (a record made by the reading thread).
+            unsigned int       snapshotNo;   // Not 0: no input, save the sensor states for this snapshot.
+            int                nbBytes;
+            long long          receiveTime;
+            unsigned long long gapTag;       // See antSequenceTracker::getGapTag.
+            std::vector<BYTE>  data;
+            amString           text;
+        };
+
+        struct outputSlot
+        {
+            int      errorCode;
+            amString output;
+            amString errorMessage;
+        };
+
+        struct decodeWorker
+        {
+            antDecodePipeline       *pipeline;
+            antProcessing           *processor;
+            amSpscQueue<inputSlot>   input;
+            amSpscQueue<outputSlot>  output;
+            pthread_t                thread;
+            bool                     threadRunning;
+        };
+
+        antProcessing               &owner;
+        std::vector<decodeWorker *>  workers;
+        amSpscQueue<unsigned int>    order;
+        pthread_t                    writerThread;
+        bool                         writerRunning;
+        int                          inputDone;
+        int                          errorCode;      // First error of the writer thread.
+        amString                     errorMessage;
+        unsigned int                 idleRequests;
+        unsigned int                 flushRequests;
+
+        static void *workerThreadMain( void *worker );
+        static void *writerThreadMain( void *pipeline );
+        void runWorker( decodeWorker &worker );
+        void runWriter( void );
+
+        inputSlot *getInputSlot( unsigned int workerNo );
+        int        dispatch    ( unsigned int workerNo );
+
+
+    public:
+
+        antDecodePipeline( antProcessing &ownerProcessor );
+        ~antDecodePipeline( void );
+
+        int start( unsigned int nbWorkers, amString &message );
+        int stop ( amString &message );
+
+        static unsigned int getSemiCookedKey( const char *line, size_t length );
+
+        int  dispatchFrame         ( const BYTE *line, int nbBytes, long long receiveTime, unsigned long long gapTag );
+        int  dispatchSemiCookedLine( const char *line );
+        int  dispatchOutput        ( const amString &text );
+        void dispatchSnapshot      ( unsigned int snapshotNo );
+        void idle                  ( bool flushMulticast );
+
+};
+
+#endif // __ANT_DECODE_PIPELINE_H__
@@ -0,0 +1,266 @@
+// -------------------------------------------------------------------------------------------------//
+//
+// Decoder library: the C interface of ant_decoder.h around an antAllProcessing.
+//
+// -------------------------------------------------------------------------------------------------//
+#include <cmath>
+#include <cstring>
+
+#include "ant_decoder.h"
+#include "ant_all_processing.h"
+
+const char C_LIBRARY_PROGRAM_NAME[] = "libant2txt";
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Record sink handing the records to the record callback of the application.
+//
+// -------------------------------------------------------------------------------------------------//
+class antCallbackSink : public antRecordFormatter
+{
+
+    private:
+
+        antRecordCallback callback;
+        void             *userData;
+
+
+    protected:
+
+        virtual void formatRecord( int recordType, const antRecordContext &context, const void *record );
+
+
+    public:
+
+        antCallbackSink() : callback( NULL ), userData( NULL ) {}
+
+        inline void setCallback( antRecordCallback callbackIn, void *userDataIn ) { callback = callbackIn; userData = userDataIn; }
+
+};
+
+void antCallbackSink::formatRecord
+(
+    int                     recordType,
+    const antRecordContext &context,
+    const void             *record
+)
+{
+    if ( callback != NULL )
+    {
+        antRecordHeader header;
+        header.recordType = recordType;
+        header.sensorID   = context.sensorID.c_str();
+        header.timeStamp  = context.timeStamp.c_str();
+        header.version    = context.version.c_str();
+        callback( userData, &header, record );
+    }
+}
+
+struct antDecoder
+{
+    antAllProcessing processor;
+    antCallbackSink  recordSink;
+    antTextCallback  textCallback;
+    void            *textUserData;
+    amString         output;
+    amString         message;
+    BYTE             line[ C_BUFFER_SIZE ];   // Copy of the frame: ant2txtLine() reads a full buffer.
+
+    int deliverOutput( int result );
+};
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Hand the output captured by the processor (see antProcessing::writeOutput()) to the text
+// callback: kind, length and text of each piece.
+//
+// -------------------------------------------------------------------------------------------------//
+int antDecoder::deliverOutput
+(
+    int result
+)
+{
+    const char *captured = output.c_str();
+    size_t      size     = output.size();
+    size_t      position = 0;
+    size_t      length   = 0;
+
+    while ( position + 1 + sizeof( length ) <= size )
+    {
+        memcpy( &length, captured + position + 1, sizeof( length ) );
+        position += 1 + sizeof( length );
+        if ( ( textCallback != NULL ) && ( length > 0 ) )
+        {
+            textCallback( textUserData, captured + position, length );
+        }
+        position += length;
+    }
+    output.clear();
+
+    if ( result == E_EMPTY_MESSAGE )
+    {
+        result = 0;
+    }
+    return result;
+}
+
+antDecoder *antDecoderCreate
+(
+    void
+)
+{
+    antDecoder *decoder = new antDecoder;
+
+    decoder->textCallback = NULL;
+    decoder->textUserData = NULL;
+    decoder->processor.setProgramName( C_LIBRARY_PROGRAM_NAME );
+    decoder->processor.setWriteStdout( false );
+    decoder->processor.setOutputText( false );
+    decoder->processor.addRecordSink( &( decoder->recordSink ) );
+
+    return decoder;
+}
+
+void antDecoderDestroy
+(
+    antDecoder *decoder
+)
+{
+    delete decoder;
+}
+
+void antDecoderSetRecordCallback
+(
+    antDecoder        *decoder,
+    antRecordCallback  callback,
+    void              *userData
+)
+{
+    decoder->recordSink.setCallback( callback, userData );
+}
+
+void antDecoderSetTextCallback
+(
+    antDecoder      *decoder,
+    antTextCallback  callback,
+    void            *userData
+)
+{
+    decoder->textCallback = callback;
+    decoder->textUserData = userData;
+}
+
+int antDecoderSetOption
+(
+    antDecoder *decoder,
+    int         option,
+    int         value
+)
+{
+    int result = ANT_DECODER_OK;
+
+    decoder->message.clear();
+    switch ( option )
+    {
+        case ANT_DECODER_SEMI_COOKED:
+             decoder->processor.setSemiCookedOut( value != 0 );
+             break;
+        case ANT_DECODER_JSON:
+             decoder->processor.setOutputAsJSON( value != 0 );
+             break;
+        case ANT_DECODER_RECORD_TEXT:
+             decoder->processor.setOutputText( value != 0 );
+             break;
+        case ANT_DECODER_ONLY_REGISTERED:
+             decoder->processor.setOnlyRegisteredDevices( value != 0 );
+             break;
+        case ANT_DECODER_VALUE_PRECISION:
+             if ( ( value < ( int ) C_MIN_PRECISION ) || ( value > ( int ) C_MAX_PRECISION ) )
+             {
+                 result = E_BAD_PARAMETER_VALUE;
+             }
+             decoder->processor.setValuePrecision( value );
+             break;
+        case ANT_DECODER_TIME_PRECISION:
+             if ( ( value < ( int ) C_MIN_PRECISION ) || ( value > ( int ) C_MAX_PRECISION ) )
+             {
+                 result = E_BAD_PARAMETER_VALUE;
+             }
+             decoder->processor.setTimePrecision( value );
+             break;
+        default:
+             result = E_BAD_OPTION;
+             break;
+    }
+    if ( result == E_BAD_PARAMETER_VALUE )
+    {
+        decoder->message = "Precision out of range.";
+    }
+    else if ( result == E_BAD_OPTION )
+    {
+        decoder->message = "Unknown decoder option.";
+    }
+    return result;
+}
+
+int antDecoderReadDeviceFile
+(
+    antDecoder *decoder,
+    const char *fileName
+)
+{
+    return decoder->processor.loadDeviceFile( fileName, decoder->message );
+}
+
+int antDecoderAddDevice
+(
+    antDecoder *decoder,
+    const char *line
+)
+{
+    return decoder->processor.addDevice( line, decoder->message );
+}
+
+int antDecoderFeedFrame
+(
+    antDecoder          *decoder,
+    const unsigned char *frame,
+    size_t               nbBytes,
+    double               receiveTime
+)
+{
+    long long microseconds = ( long long ) floor( receiveTime * 1.0E6 + 0.5 );
+    int       result       = 0;
+
+    // The decoder reads the header, flag and device fields at fixed offsets: decode a zero padded copy.
+    if ( nbBytes > ( size_t ) C_BUFFER_SIZE )
+    {
+        decoder->message  = "Frame longer than ";
+        decoder->message += amString( C_BUFFER_SIZE );
+        decoder->message += " bytes.";
+        return E_BAD_PARAMETER_VALUE;
+    }
+    memset( decoder->line, 0, C_BUFFER_SIZE );
+    memcpy( decoder->line, frame, nbBytes );
+
+    result = decoder->processor.decodeFrame( decoder->line, ( int ) nbBytes, microseconds, decoder->output, decoder->message );
+    return decoder->deliverOutput( result );
+}
+
+int antDecoderFeedSemiCookedLine
+(
+    antDecoder *decoder,
+    const char *line
+)
+{
+    int result = decoder->processor.decodeSemiCookedLine( line, decoder->output, decoder->message );
+    return decoder->deliverOutput( result );
+}
+
+const char *antDecoderGetErrorMessage
+(
+    const antDecoder *decoder
+)
+{
+    return decoder->message.c_str();
+}
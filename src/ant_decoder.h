@@ -0,0 +1,82 @@
+#ifndef __ANT_DECODER_H__
+#define __ANT_DECODER_H__
+
+#include <stddef.h>
+#include "ant_records.h"
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Decoder library (libant2txt.a, libant2txt.so).
+// Decodes the packets of the ANT+ bridges, or the semi-cooked lines written with -s, in the
+// process of the application: no command line, no multicast sockets and no output on stdout.
+//
+// The data pages which are decoded into records (see ant_records.h) are handed to the record
+// callback as structs, all other output (bridge and sequence information, unknown packets, ...) is
+// handed to the text callback as one line per call.
+// All data pages of all profiles, including the common data pages and the pages the decoders do not
+// know, are records.
+// A decoder keeps the history of the sensors, so it must only be used by one thread at a time.
+//
+// Functions returning an int return ANT_DECODER_OK, or an error code with the text of the error
+// available from antDecoderGetErrorMessage() until the next call.
+//
+// -------------------------------------------------------------------------------------------------//
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ANT_DECODER_OK 0
+
+typedef struct antDecoder antDecoder;
+
+// Identification of a record, the strings are only valid during the callback.
+typedef struct antRecordHeader
+{
+    int         recordType;     // enum antRecordType
+    const char *sensorID;       // E.g. "HRM_12345"
+    const char *timeStamp;      // Receive time of the packet, as written in the text output
+    const char *version;        // Version of the decoder which produced the record
+} antRecordHeader;
+
+// 'record' points to the struct matching header->recordType (e.g. antHRMRecord for ANT_HRM_RECORD).
+typedef void ( *antRecordCallback )( void *userData, const antRecordHeader *header, const void *record );
+
+// 'text' is one line of output without the end of line character, it is not null terminated.
+typedef void ( *antTextCallback )( void *userData, const char *text, size_t length );
+
+enum antDecoderOption
+{
+    ANT_DECODER_SEMI_COOKED     = 1,    // 1: Semi-cooked values (like -S), the records hold no cooked values
+    ANT_DECODER_JSON            = 2,    // 1: Text output as JSON objects (like -J)
+    ANT_DECODER_RECORD_TEXT     = 3,    // 1: The records are also handed to the text callback as text
+    ANT_DECODER_ONLY_REGISTERED = 4,    // 1: Only decode the devices added from a device file (like -R)
+    ANT_DECODER_VALUE_PRECISION = 5,    // Number of decimals of the values in the text output (like -P)
+    ANT_DECODER_TIME_PRECISION  = 6     // Number of decimals of the time stamps in the text output (like -T)
+};
+
+antDecoder *antDecoderCreate ( void );
+void        antDecoderDestroy( antDecoder *decoder );
+
+void antDecoderSetRecordCallback( antDecoder *decoder, antRecordCallback callback, void *userData );
+void antDecoderSetTextCallback  ( antDecoder *decoder, antTextCallback callback, void *userData );
+int  antDecoderSetOption        ( antDecoder *decoder, int option, int value );
+
+// Sensor parameters (wheel circumference, power meter settings, ...) in the format of the device file (-d).
+int antDecoderReadDeviceFile( antDecoder *decoder, const char *fileName );
+int antDecoderAddDevice     ( antDecoder *decoder, const char *line );
+
+// One packet as received from a bridge, 'receiveTime' in seconds since the epoch. Frames longer than
+// C_BUFFER_SIZE (ant_constants.h) bytes are rejected.
+int antDecoderFeedFrame( antDecoder *decoder, const unsigned char *frame, size_t nbBytes, double receiveTime );
+
+// One semi-cooked line (null terminated, without the end of line character).
+int antDecoderFeedSemiCookedLine( antDecoder *decoder, const char *line );
+
+const char *antDecoderGetErrorMessage( const antDecoder *decoder );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __ANT_DECODER_H__
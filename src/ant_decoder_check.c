@@ -0,0 +1,159 @@
+// -------------------------------------------------------------------------------------------------//
+//
+// C consumer of the decoder library (make decoder-check).
+// Compiled as C and linked with libant2txt.a the way ant_decoder.h asks for it, it feeds the frames
+// of an ANT+ capture file to antDecoderFeedFrame(), one every 0.1 s like the test mode of the
+// programs (-x), and writes the text output to stdout: it must be the output of "bridge2txt -x -f".
+// The records are also handed over as text (ANT_DECODER_RECORD_TEXT) and counted by the record
+// callback, the counts go to stderr.
+//
+// Usage: ant2txt_decoder_check <ANT+ file>
+//
+// -------------------------------------------------------------------------------------------------//
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ant_decoder.h"
+
+typedef struct checkCounts
+{
+    unsigned long nbFrames;
+    unsigned long nbRecords;
+    unsigned long nbTextLines;
+    unsigned long nbBadRecords;
+} checkCounts;
+
+static void countRecord
+(
+    void                  *userData,
+    const antRecordHeader *header,
+    const void            *record
+)
+{
+    checkCounts *counts = ( checkCounts * ) userData;
+
+    ++counts->nbRecords;
+    if ( ( record == NULL ) || ( header->sensorID == NULL ) || ( header->timeStamp == NULL ) || ( header->recordType <= 0 ) )
+    {
+        ++counts->nbBadRecords;
+    }
+}
+
+static void writeText
+(
+    void       *userData,
+    const char *text,
+    size_t      length
+)
+{
+    checkCounts *counts = ( checkCounts * ) userData;
+
+    ++counts->nbTextLines;
+    fwrite( text, 1, length, stdout );
+    fputc( '\n', stdout );
+}
+
+// Read the whole file, NULL if it cannot be read.
+static unsigned char *readFile
+(
+    const char *fileName,
+    size_t     *fileSize
+)
+{
+    FILE          *inputFile = fopen( fileName, "rb" );
+    unsigned char *result    = NULL;
+    long           size      = 0;
+
+    *fileSize = 0;
+    if ( inputFile != NULL )
+    {
+        if ( ( fseek( inputFile, 0, SEEK_END ) == 0 ) && ( ( size = ftell( inputFile ) ) > 0 ) && ( fseek( inputFile, 0, SEEK_SET ) == 0 ) )
+        {
+            result = ( unsigned char * ) malloc( ( size_t ) size );
+            if ( ( result != NULL ) && ( fread( result, 1, ( size_t ) size, inputFile ) == ( size_t ) size ) )
+            {
+                *fileSize = ( size_t ) size;
+            }
+            else
+            {
+                free( result );
+                result = NULL;
+            }
+        }
+        fclose( inputFile );
+    }
+    return result;
+}
+
+// Start of the next 'A','N' frame header at or after 'position', 'fileSize' if there is none.
+static size_t findFrame
+(
+    const unsigned char *data,
+    size_t               fileSize,
+    size_t               position
+)
+{
+    while ( ( position + 1 < fileSize ) && ( ( data[ position ] != 'A' ) || ( data[ position + 1 ] != 'N' ) ) )
+    {
+        ++position;
+    }
+    return ( position + 1 < fileSize ) ? position : fileSize;
+}
+
+int main
+(
+    int   argc,
+    char *argv[]
+)
+{
+    checkCounts    counts     = { 0, 0, 0, 0 };
+    antDecoder    *decoder    = NULL;
+    unsigned char *data       = NULL;
+    size_t         fileSize   = 0;
+    size_t         frameStart = 0;
+    size_t         frameEnd   = 0;
+    int            result     = 0;
+
+    if ( argc != 2 )
+    {
+        fprintf( stderr, "Usage: %s <ANT+ file>\n", argv[ 0 ] );
+        return 2;
+    }
+
+    data = readFile( argv[ 1 ], &fileSize );
+    if ( data == NULL )
+    {
+        fprintf( stderr, "%s: cannot read \"%s\".\n", argv[ 0 ], argv[ 1 ] );
+        return 2;
+    }
+
+    decoder = antDecoderCreate();
+    antDecoderSetRecordCallback( decoder, countRecord, &counts );
+    antDecoderSetTextCallback( decoder, writeText, &counts );
+    antDecoderSetOption( decoder, ANT_DECODER_RECORD_TEXT, 1 );
+
+    frameStart = findFrame( data, fileSize, 0 );
+    while ( ( result == ANT_DECODER_OK ) && ( frameStart < fileSize ) )
+    {
+        frameEnd = findFrame( data, fileSize, frameStart + 2 );
+        result   = antDecoderFeedFrame( decoder, data + frameStart, frameEnd - frameStart, counts.nbFrames * 0.1 );
+        if ( result != ANT_DECODER_OK )
+        {
+            fprintf( stderr, "%s: frame %lu: %s\n", argv[ 0 ], counts.nbFrames, antDecoderGetErrorMessage( decoder ) );
+        }
+        ++counts.nbFrames;
+        frameStart = frameEnd;
+    }
+
+    fprintf( stderr, "%lu frames, %lu records, %lu text lines.\n", counts.nbFrames, counts.nbRecords, counts.nbTextLines );
+    if ( counts.nbBadRecords > 0 )
+    {
+        fprintf( stderr, "%lu records without header or data.\n", counts.nbBadRecords );
+        result = 1;
+    }
+
+    antDecoderDestroy( decoder );
+    free( data );
+    return ( result == ANT_DECODER_OK ) ? 0 : 1;
+}
@@ -0,0 +1,182 @@
+#ifndef __ANT_DEVICE_DISPATCH_H__
+#define __ANT_DEVICE_DISPATCH_H__
+
+#include <string.h>
+#include <vector>
+
+#include "ant_constants.h"
+#include "am_string.h"
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Call the binary and the semi-cooked processing of the profile class P on a processor of class T
+// (a class which inherits from P), bypassing the overrides of T.
+//
+// -------------------------------------------------------------------------------------------------//
+template <class T, class P> amDeviceType antDispatchSensor
+(
+    T              &processor,
+    int             deviceType,
+    unsigned int    deviceIDNo,
+    const amString &timeStampBuffer,
+    BYTE            payLoad[]
+)
+{
+    return processor.P::processSensor( deviceType, deviceIDNo, timeStampBuffer, payLoad );
+}
+
+template <class T, class P> amDeviceType antDispatchSensorSemiCooked
+(
+    T              &processor,
+    const amString &inputBuffer
+)
+{
+    return processor.P::processSensorSemiCooked( inputBuffer );
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Device type dispatch table of a processor (class T) combining several profiles.
+// Every profile registers its ANT+ device type and the heads of its semi-cooked sensor IDs with
+// addProfile(). Binary packets are looked up by device type in a table with C_NB_DEVICE_TYPES
+// entries, semi-cooked lines by their head in a trie (one node per character, the children of a
+// node in a list), so finding the handler of a packet does not depend on the number of profiles.
+//
+// -------------------------------------------------------------------------------------------------//
+template <class T> class antDeviceDispatch
+{
+
+    public:
+
+        typedef amDeviceType ( *binaryHandler )( T &processor, int deviceType, unsigned int deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
+        typedef amDeviceType ( *semiCookedHandler )( T &processor, const amString &inputBuffer );
+
+
+    private:
+
+        struct trieNode
+        {
+            char              character;
+            int               firstChild;
+            int               nextSibling;
+            semiCookedHandler handler;      // Set if the characters up to this node are a complete head.
+        };
+
+        binaryHandler         binaryHandlers[ C_NB_DEVICE_TYPES ];
+        int                   rootNodes[ C_NB_DEVICE_TYPES ];
+        std::vector<trieNode> nodes;
+
+        int addNode
+        (
+            int  &link,
+            char  character
+        )
+        {
+            int nodeNo = link;
+
+            while ( ( nodeNo >= 0 ) && ( nodes[ nodeNo ].character != character ) )
+            {
+                nodeNo = nodes[ nodeNo ].nextSibling;
+            }
+            if ( nodeNo < 0 )
+            {
+                trieNode node;
+                node.character   = character;
+                node.firstChild  = -1;
+                node.nextSibling = link;
+                node.handler     = NULL;
+                nodeNo           = nodes.size();
+                nodes.push_back( node );
+                link             = nodeNo;
+            }
+            return nodeNo;
+        }
+
+
+    public:
+
+        antDeviceDispatch( void )
+        {
+            for ( int counter = 0; counter < C_NB_DEVICE_TYPES; ++counter )
+            {
+                binaryHandlers[ counter ] = NULL;
+                rootNodes[ counter ]      = -1;
+            }
+        }
+
+        void addDeviceType
+        (
+            int           deviceType,
+            binaryHandler handler
+        )
+        {
+            binaryHandlers[ deviceType ] = handler;
+        }
+
+        void addHead
+        (
+            const char        *head,
+            semiCookedHandler  handler
+        )
+        {
+            int nodeNo = addNode( rootNodes[ ( BYTE ) head[ 0 ] ], head[ 0 ] );
+
+            for ( size_t counter = 1; head[ counter ] != 0; ++counter )
+            {
+                // Note: the node vector may grow, so the link is not kept as a reference.
+                int firstChild = nodes[ nodeNo ].firstChild;
+                int childNo    = addNode( firstChild, head[ counter ] );
+                nodes[ nodeNo ].firstChild = firstChild;
+                nodeNo = childNo;
+            }
+            nodes[ nodeNo ].handler = handler;
+        }
+
+        template <class P> void addProfile
+        (
+            int         deviceType,
+            const char *head
+        )
+        {
+            addDeviceType( deviceType, antDispatchSensor<T, P> );
+            addHead( head, antDispatchSensorSemiCooked<T, P> );
+        }
+
+        inline binaryHandler getHandler
+        (
+            int deviceType
+        ) const
+        {
+            return ( ( deviceType >= 0 ) && ( deviceType < C_NB_DEVICE_TYPES ) ) ? binaryHandlers[ deviceType ] : NULL;
+        }
+
+        // Handler of the first (i.e. shortest) registered head the sensor ID starts with.
+        semiCookedHandler getHandler
+        (
+            const char *sensorID,
+            size_t      length
+        ) const
+        {
+            semiCookedHandler handler = NULL;
+            int               nodeNo  = ( length > 0 ) ? rootNodes[ ( BYTE ) sensorID[ 0 ] ] : -1;
+            size_t            counter = 0;
+
+            while ( ( nodeNo >= 0 ) && ( handler == NULL ) )
+            {
+                while ( ( nodeNo >= 0 ) && ( nodes[ nodeNo ].character != sensorID[ counter ] ) )
+                {
+                    nodeNo = nodes[ nodeNo ].nextSibling;
+                }
+                if ( nodeNo >= 0 )
+                {
+                    handler = nodes[ nodeNo ].handler;
+                    ++counter;
+                    nodeNo  = ( counter < length ) ? nodes[ nodeNo ].firstChild : -1;
+                }
+            }
+            return handler;
+        }
+
+};
+
+#endif // __ANT_DEVICE_DISPATCH_H__
@@ -0,0 +1,323 @@
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include "am_split_string.h"
+#include "ant_constants.h"
+#include "ant_device_file_watcher.h"
+
+const int          C_WATCH_POLL_MS       = 200;   // A changed file is reloaded once it was not written for this long.
+const unsigned int C_MAX_INCLUDE_DEPTH   = 16;
+const size_t       C_INOTIFY_BUFFER_SIZE = 4096;
+
+volatile sig_atomic_t antDeviceFileWatcher::hangUpReceived = 0;
+
+antDeviceFileWatcher::antDeviceFileWatcher
+(
+    void
+)
+{
+    threadRunning = false;
+    stopping      = 0;
+    inotifyFD     = -1;
+    generation    = 0;
+    nbReloads     = 0;
+    pthread_mutex_init( &mutex, NULL );
+}
+
+antDeviceFileWatcher::~antDeviceFileWatcher
+(
+    void
+)
+{
+    stop();
+    pthread_mutex_destroy( &mutex );
+}
+
+void antDeviceFileWatcher::onHangUp
+(
+    int signalNo
+)
+{
+    hangUpReceived = 1;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Start watching the device file 'fileNameIn'. Without inotify the file is only reloaded on SIGHUP.
+//
+// -------------------------------------------------------------------------------------------------//
+int antDeviceFileWatcher::start
+(
+    const amString &fileNameIn,
+    amString       &message
+)
+{
+    struct sigaction hangUpAction;
+    size_t           separator = fileNameIn.rfind( '/' );
+    int              result    = 0;
+
+    fileName      = fileNameIn;
+    baseName      = ( separator == std::string::npos ) ? fileName : amString( fileName.substr( separator + 1 ) );
+    directoryName = ( separator == std::string::npos ) ? amString( "." ) : amString( fileName.substr( 0, ( separator == 0 ) ? 1 : separator ) );
+    stopping      = 0;
+
+    // Editors and deployment tools often replace the file instead of writing it: watch the directory.
+    inotifyFD = inotify_init1( IN_NONBLOCK | IN_CLOEXEC );
+    if ( ( inotifyFD >= 0 ) && ( inotify_add_watch( inotifyFD, directoryName.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE ) < 0 ) )
+    {
+        close( inotifyFD );
+        inotifyFD = -1;
+    }
+    if ( inotifyFD < 0 )
+    {
+        std::cerr << "WARNING: Cannot watch the device file \"" << fileName << "\" for changes (" << strerror( errno ) << "), reload it with SIGHUP." << std::endl;
+    }
+
+    memset( &hangUpAction, 0, sizeof( hangUpAction ) );
+    hangUpAction.sa_handler = onHangUp;
+    hangUpAction.sa_flags   = SA_RESTART;
+    sigemptyset( &hangUpAction.sa_mask );
+    sigaction( SIGHUP, &hangUpAction, &previousHangUpAction );
+
+    if ( pthread_create( &thread, NULL, threadMain, this ) != 0 )
+    {
+        sigaction( SIGHUP, &previousHangUpAction, NULL );
+        message += "Creating the device file watch thread failed.\n";
+        result   = E_THREAD_CREATE_FAIL;
+    }
+    else
+    {
+        threadRunning = true;
+    }
+    return result;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Stop the thread and give SIGHUP its previous meaning.
+//
+// -------------------------------------------------------------------------------------------------//
+void antDeviceFileWatcher::stop
+(
+    void
+)
+{
+    if ( threadRunning )
+    {
+        __atomic_store_n( &stopping, 1, __ATOMIC_RELEASE );
+        pthread_join( thread, NULL );
+        threadRunning = false;
+        sigaction( SIGHUP, &previousHangUpAction, NULL );
+    }
+    if ( inotifyFD >= 0 )
+    {
+        close( inotifyFD );
+        inotifyFD = -1;
+    }
+}
+
+bool antDeviceFileWatcher::fetch
+(
+    unsigned int          &seenGeneration,
+    std::vector<amString> &newLines
+)
+{
+    bool result = false;
+
+    if ( ( __atomic_load_n( &generation, __ATOMIC_ACQUIRE ) != seenGeneration ) && ( pthread_mutex_trylock( &mutex ) == 0 ) )
+    {
+        newLines       = lines;
+        seenGeneration = generation;
+        result         = true;
+        pthread_mutex_unlock( &mutex );
+    }
+    return result;
+}
+
+void *antDeviceFileWatcher::threadMain
+(
+    void *watcher
+)
+{
+    ( ( antDeviceFileWatcher * ) watcher )->run();
+    return NULL;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Main loop of the watch thread: reload on SIGHUP at once, after a change of the file once it has
+// not been written for C_WATCH_POLL_MS.
+//
+// -------------------------------------------------------------------------------------------------//
+void antDeviceFileWatcher::run
+(
+    void
+)
+{
+    struct pollfd watchPoll;
+    bool          changed = false;
+    bool          active  = false;
+
+    watchPoll.fd     = inotifyFD;
+    watchPoll.events = POLLIN;
+
+    while ( __atomic_load_n( &stopping, __ATOMIC_ACQUIRE ) == 0 )
+    {
+        if ( hangUpReceived )
+        {
+            hangUpReceived = 0;
+            changed        = false;
+            reload();
+            continue;
+        }
+
+        active = false;
+        if ( inotifyFD >= 0 )
+        {
+            active = ( poll( &watchPoll, 1, C_WATCH_POLL_MS ) > 0 ) && readChanges();
+        }
+        else
+        {
+            usleep( C_WATCH_POLL_MS * 1000 );
+        }
+
+        if ( active )
+        {
+            changed = true;
+        }
+        else if ( changed )
+        {
+            changed = false;
+            reload();
+        }
+    }
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Read the pending inotify events. Returns true if one of them concerns the device file.
+//
+// -------------------------------------------------------------------------------------------------//
+bool antDeviceFileWatcher::readChanges
+(
+    void
+)
+{
+    char                        buffer[ C_INOTIFY_BUFFER_SIZE ] __attribute__ ( ( aligned( __alignof__( struct inotify_event ) ) ) );
+    const struct inotify_event *event    = NULL;
+    ssize_t                     nbBytes  = 0;
+    bool                        result   = false;
+
+    while ( ( nbBytes = read( inotifyFD, buffer, sizeof( buffer ) ) ) > 0 )
+    {
+        for ( char *position = buffer; position < buffer + nbBytes; position += sizeof( struct inotify_event ) + event->len )
+        {
+            event  = ( const struct inotify_event * ) position;
+            result = result || ( ( event->len > 0 ) && ( baseName == event->name ) );
+        }
+    }
+    return result;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Read the device file and hand its lines over to the decode threads.
+//
+// -------------------------------------------------------------------------------------------------//
+bool antDeviceFileWatcher::reload
+(
+    void
+)
+{
+    std::vector<amString> newLines;
+    amString              message;
+
+    if ( readLines( fileName, newLines, 0, message ) != 0 )
+    {
+        std::cerr << message << "The device file has not been reloaded." << std::endl;
+        return false;
+    }
+
+    pthread_mutex_lock( &mutex );
+    lines.swap( newLines );
+    __atomic_add_fetch( &generation, 1, __ATOMIC_RELEASE );
+    ++nbReloads;
+    pthread_mutex_unlock( &mutex );
+
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Append the lines of the device file 'name' which are neither empty nor comments to 'newLines',
+// with the lines of the files it includes in place of the AM_INCLUDE lines.
+//
+// -------------------------------------------------------------------------------------------------//
+int antDeviceFileWatcher::readLines
+(
+    const amString        &name,
+    std::vector<amString> &newLines,
+    unsigned int           depth,
+    amString              &message
+)
+{
+    char          line[ C_BUFFER_SIZE ];
+    amSplitString words;
+    amString      firstWord;
+    int           result = 0;
+    std::ifstream inStr( name.c_str() );
+
+    if ( inStr.fail() )
+    {
+        message += "Could not open device file \"";
+        message += name;
+        message += "\" for reading.\n";
+        return E_READ_FILE_NOT_OPEN;
+    }
+
+    while ( result == 0 )
+    {
+        inStr.getline( line, C_BUFFER_SIZE, '\n' );
+        if ( inStr.fail() || inStr.eof() )
+        {
+            break;
+        }
+        const char *lPtr = line;
+        while ( IS_WHITE_CHAR( *lPtr ) )
+        {
+            ++lPtr;
+        }
+        if ( ( *lPtr == 0 ) || ( *lPtr == C_COMMENT_SYMBOL ) )
+        {
+            continue;
+        }
+
+        firstWord.clear();
+        if ( words.split( lPtr, C_COMMENT_SYMBOL_AS_STRING ) > 1 )
+        {
+            firstWord = words[ 0 ];
+        }
+        if ( firstWord != C_INCLUDE_FILE )
+        {
+            newLines.push_back( amString( lPtr ) );
+        }
+        else if ( depth >= C_MAX_INCLUDE_DEPTH )
+        {
+            message += "Device files are included too deeply at \"";
+            message += name;
+            message += "\".\n";
+            result   = E_READ_ERROR;
+        }
+        else
+        {
+            result = readLines( words.concatenate( 1 ), newLines, depth + 1, message );
+        }
+    }
+    return result;
+}
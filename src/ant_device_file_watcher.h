@@ -0,0 +1,69 @@
+#ifndef __ANT_DEVICE_FILE_WATCHER_H__
+#define __ANT_DEVICE_FILE_WATCHER_H__
+
+#include <pthread.h>
+#include <signal.h>
+#include <vector>
+
+#include "am_string.h"
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Reload of the device file while running (option '-W').
+// A thread of its own reads the device file again when it is replaced or written (inotify on its
+// directory) or when the program receives SIGHUP. AM_INCLUDE lines are expanded while reading, so
+// the lines handed over need no further file access. A file which cannot be read completely is
+// reported and ignored: the previous configuration stays.
+//
+// The new lines are swapped in under a mutex and a generation number is raised. The decode threads
+// only compare the generation number for every packet; when it changed they try to take the mutex
+// and copy the lines (see fetch()). They never wait: if the mutex is taken they look again with the
+// next packet.
+//
+// -------------------------------------------------------------------------------------------------//
+class antDeviceFileWatcher
+{
+
+    private:
+
+        amString              fileName;
+        amString              directoryName;
+        amString              baseName;
+        pthread_t             thread;
+        pthread_mutex_t       mutex;
+        bool                  threadRunning;
+        int                   stopping;
+        int                   inotifyFD;
+        unsigned int          generation;
+        unsigned int          nbReloads;
+        std::vector<amString> lines;
+        struct sigaction      previousHangUpAction;
+
+        static volatile sig_atomic_t hangUpReceived;
+
+        static void  onHangUp( int signalNo );
+        static void *threadMain( void *watcher );
+        void run   ( void );
+        bool reload( void );
+        int  readLines( const amString &name, std::vector<amString> &newLines, unsigned int depth, amString &message );
+        bool readChanges( void );
+
+
+    public:
+
+        antDeviceFileWatcher( void );
+        ~antDeviceFileWatcher( void );
+
+        inline bool         isRunning   ( void ) const { return threadRunning; }
+        inline unsigned int getNbReloads( void ) const { return nbReloads; }
+
+        int  start( const amString &fileNameIn, amString &message );
+        void stop ( void );
+
+        // Copy the lines of the device file into 'newLines' if they were reloaded since generation
+        // 'seenGeneration', which is then updated. Returns false if there is nothing new (yet).
+        bool fetch( unsigned int &seenGeneration, std::vector<amString> &newLines );
+
+};
+
+#endif // __ANT_DEVICE_FILE_WATCHER_H__
@@ -70,24 +70,22 @@ bool antEnvironmentProcessing::appendEnvironmentSensor
 //-------------------------------------------------------------------------------------------------//
 amDeviceType antEnvironmentProcessing::processEnvironmentSensor
 (
-    const amString &deviceIDNo,
+    unsigned int    deviceIDNo,
     const amString &timeStampBuffer,
     BYTE            payLoad[]
 )
 {
-    char         auxBuffer[ C_MEDIUM_BUFFER_SIZE ] = { 0 };
-    unsigned int dataPage                          = 0;
-    unsigned int auxInt0                           = 0;
-    unsigned int auxInt1                           = 0;
-    unsigned int auxInt2                           = 0;
-    unsigned int additionalData1                   = 0;
-    unsigned int additionalData2                   = 0;
-    unsigned int additionalData3                   = 0;
-    unsigned int additionalData4                   = 0;
-    amDeviceType result                            = OTHER_DEVICE;
-    amString     sensorID                          = amString( C_ENV_DEVICE_HEAD ) + deviceIDNo;
-    bool         commonPage                        = false;
-    bool         outputPageNo                      = true;
+    char                      auxBuffer[ C_MEDIUM_BUFFER_SIZE ] = { 0 };
+    unsigned int              dataPage                          = 0;
+    unsigned int              auxInt0                           = 0;
+    unsigned int              auxInt1                           = 0;
+    unsigned int              auxInt2                           = 0;
+    antEnvironmentPage0Record page0                             = antEnvironmentPage0Record();
+    antEnvironmentPage1Record page1                             = antEnvironmentPage1Record();
+    amDeviceType              result                            = OTHER_DEVICE;
+    antSensorHandle           sensorID                          = sensorStates.intern( C_ENV_DEVICE_HEAD, deviceIDNo );
+    bool                      commonPage                        = false;
+    bool                      outputPageNo                      = true;
 
     if ( isRegisteredDevice( sensorID ) )
     {
@@ -101,41 +99,41 @@ amDeviceType antEnvironmentProcessing::processEnvironmentSensor
         {
             case  0: // - - Page 0: No Additional Data - - - - - - - - - - - - - - -
                      //     Bytes 1, 2, and 3: 0xFF.
-                     result          = ENVIRONMENT_SENSOR;
-                     auxInt0         = byte2UInt( payLoad[ 3 ] );                                              // Transmission Info
-                     additionalData1 = ( auxInt0 << 4 ) & 3;                                             // Local Time
-                     additionalData2 = ( auxInt0 << 2 ) & 3;                                             // UTC Time
-                     additionalData3 = auxInt0 & 3;                                                      // Transmission Rate
-                     additionalData4 = byte2UInt( payLoad[ 7 ], payLoad[ 6 ], payLoad[ 5 ], payLoad[ 4 ] );    // Supported Pages
+                     result                 = ENVIRONMENT_SENSOR;
+                     auxInt0                = byte2UInt( payLoad[ 3 ] );                                              // Transmission Info
+                     page0.localTime        = ( auxInt0 << 4 ) & 3;
+                     page0.utcTime          = ( auxInt0 << 2 ) & 3;
+                     page0.transmissionRate = auxInt0 & 3;
+                     page0.supportedPages   = byte2UInt( payLoad[ 7 ], payLoad[ 6 ], payLoad[ 5 ], payLoad[ 4 ] );
                      if ( diagnostics )
                      {
                          appendDiagnosticsLine( "Transmission Info", payLoad[ 3 ], auxInt0 );
-                         appendDiagnosticsLine( "Local Time",        additionalData1 );
-                         appendDiagnosticsLine( "UTC Time",          additionalData2 );
-                         appendDiagnosticsLine( "Transmission Rate", additionalData3 );
-                         appendDiagnosticsLine( "Supported Pages", payLoad[ 7 ], payLoad[ 6 ], payLoad[ 5 ], payLoad[ 4 ], additionalData4 );
+                         appendDiagnosticsLine( "Local Time",        page0.localTime );
+                         appendDiagnosticsLine( "UTC Time",          page0.utcTime );
+                         appendDiagnosticsLine( "Transmission Rate", page0.transmissionRate );
+                         appendDiagnosticsLine( "Supported Pages", payLoad[ 7 ], payLoad[ 6 ], payLoad[ 5 ], payLoad[ 4 ], page0.supportedPages );
                      }
                      break;
             case  1: // - - Page 1: Temperature - - - - - - - - - - - - - - - - -
                      //     Byte 3 and Bits 4-7 of Byte 4: Low  Temp * 10 (Byte 3 LSB)
                      //     Bits 0-3 of Byte 4 and Byte 5: High Temp * 10 (Byte 5 MSB)
                      //     Bytes 6 & 7                  : Current Temp * 100 (byte 6 LSB, byte 7 MSB)
-                     result          = ENVIRONMENT_SENSOR;
-                     additionalData4 = byte2UInt( payLoad[ 2 ] );                                              // Event Count
-                     auxInt0         = byte2UInt( payLoad[ 4 ] );
-                     auxInt1         = auxInt0 >> 4;
-                     auxInt2         = auxInt0 & 0x0F;
-                     additionalData2 = ( auxInt1 * 256 ) + byte2UInt( payLoad[ 3 ] );                          // Low Temperature 24h
-                     additionalData3 = ( byte2UInt( payLoad[ 5 ] ) << 4 ) + auxInt2;                           // High Temperature 24h
-                     additionalData1 = byte2UInt( payLoad[ 7 ], payLoad[ 6 ] );                               // Current Temperature
+                     result                   = ENVIRONMENT_SENSOR;
+                     page1.eventCount         = byte2UInt( payLoad[ 2 ] );
+                     auxInt0                  = byte2UInt( payLoad[ 4 ] );
+                     auxInt1                  = auxInt0 >> 4;
+                     auxInt2                  = auxInt0 & 0x0F;
+                     page1.lowTemperature24h  = ( auxInt1 * 256 ) + byte2UInt( payLoad[ 3 ] );
+                     page1.highTemperature24h = ( byte2UInt( payLoad[ 5 ] ) << 4 ) + auxInt2;
+                     page1.currentTemperature = byte2UInt( payLoad[ 7 ], payLoad[ 6 ] );
                      if ( diagnostics )
                      {
-                         appendDiagnosticsLine( "Current Temperature * 100", payLoad[ 7 ], payLoad[ 6 ], additionalData1 );
+                         appendDiagnosticsLine( "Current Temperature * 100", payLoad[ 7 ], payLoad[ 6 ], page1.currentTemperature );
                          strcpy( auxBuffer, " (Second Byte: Upper 4 Bits)" );
-                         appendDiagnosticsLine( "Low Temperature 24h * 10", payLoad[ 3 ], payLoad[ 4 ], additionalData2, auxBuffer );
+                         appendDiagnosticsLine( "Low Temperature 24h * 10", payLoad[ 3 ], payLoad[ 4 ], page1.lowTemperature24h, auxBuffer );
                          strcpy( auxBuffer, " (First Byte: Lower 4 Bits)" );
-                         appendDiagnosticsLine( "High Temperature 24h * 10", payLoad[ 4 ], payLoad[ 5 ], additionalData3, auxBuffer );
-                         appendDiagnosticsLine( "Event Count", payLoad[ 2 ], additionalData4 );
+                         appendDiagnosticsLine( "High Temperature 24h * 10", payLoad[ 4 ], payLoad[ 5 ], page1.highTemperature24h, auxBuffer );
+                         appendDiagnosticsLine( "Event Count", payLoad[ 2 ], page1.eventCount );
                      }
                      break;
 
@@ -147,10 +145,9 @@ amDeviceType antEnvironmentProcessing::processEnvironmentSensor
 
     if ( result == ENVIRONMENT_SENSOR )
     {
-        createOutputHeader( sensorID, timeStampBuffer );
         if ( commonPage )
         {
-            commonPage = processCommonPages( sensorID, payLoad, outputPageNo );
+            commonPage = processCommonPages( sensorID, timeStampBuffer, getVersion(), payLoad, outputPageNo );
             if ( !commonPage )
             {
                 result = OTHER_DEVICE;
@@ -158,9 +155,8 @@ amDeviceType antEnvironmentProcessing::processEnvironmentSensor
         }
         else
         {
-            createENVResultString( dataPage, additionalData1, additionalData2, additionalData3, additionalData4 );
+            outputEnvironmentRecord( sensorID, timeStampBuffer, getVersion(), dataPage, page0, page1 );
         }
-        appendOutputFooter( getVersion() );
     }
 
     if ( result == OTHER_DEVICE )
@@ -168,7 +164,7 @@ amDeviceType antEnvironmentProcessing::processEnvironmentSensor
         resetOutBuffer();
         if ( outputUnknown )
         {
-            int deviceIDNoAsInt = deviceIDNo.toInt();
+            int deviceIDNoAsInt = ( int ) deviceIDNo;
             createUnknownDeviceTypeString( C_ENV_TYPE, deviceIDNoAsInt, timeStampBuffer, payLoad );
         }
     }
@@ -190,24 +186,22 @@ amDeviceType antEnvironmentProcessing::processEnvironmentSensorSemiCooked
     const amString &inputBuffer
 )
 {
-    amDeviceType result = OTHER_DEVICE;
-    unsigned int  dataPage        = 0;
-    unsigned int  counter         = 0;
-    unsigned int  startCounter    = 0;
-    unsigned int  additionalData1 = 0;
-    unsigned int  additionalData2 = 0;
-    unsigned int  additionalData3 = 0;
-    unsigned int  additionalData4 = 0;
-    amString      curVersion      = getVersion();
-    amString      timeStampBuffer;
-    amString      sensorID;
-    amString      timeStampString;
-    amString      semiCookedString;
-    amString      dataPageString;
-    bool          commonPage      = false;
-    bool          outputPageNo    = true;
-    amSplitString words;
-    unsigned int  nbWords         = words.split( inputBuffer );
+    amDeviceType              result       = OTHER_DEVICE;
+    unsigned int              dataPage     = 0;
+    unsigned int              counter      = 0;
+    unsigned int              startCounter = 0;
+    antEnvironmentPage0Record page0        = antEnvironmentPage0Record();
+    antEnvironmentPage1Record page1        = antEnvironmentPage1Record();
+    amString                  curVersion   = getVersion();
+    amString                  timeStampBuffer;
+    amString                  sensorID;
+    amString                  timeStampString;
+    amString                  semiCookedString;
+    amString                  dataPageString;
+    bool                      commonPage   = false;
+    bool                      outputPageNo = true;
+    amSplitString             words;
+    unsigned int              nbWords      = words.split( inputBuffer );
 
     // Semi-cooked string has the syntax
     //    "<device_id>\t<time_stamp>\t<semi_cooked_symbol>\t<data_page>\t...."
@@ -240,17 +234,17 @@ amDeviceType antEnvironmentProcessing::processEnvironmentSensorSemiCooked
                              //
                              if ( nbWords > 7 )
                              {
-                                 result          = ENVIRONMENT_SENSOR;
-                                 additionalData1 = words[ counter++ ].toUInt();                      // 4 - Local Time
-                                 additionalData2 = words[ counter++ ].toUInt();                      // 5 - UTC Time
-                                 additionalData3 = words[ counter++ ].toUInt();                      // 6 - Transmission Rate
-                                 additionalData4 = words[ counter++ ].toUInt();                      // 7 - Supported Pages
+                                 result                 = ENVIRONMENT_SENSOR;
+                                 page0.localTime        = words[ counter++ ].toUInt();               // 4 - Local Time
+                                 page0.utcTime          = words[ counter++ ].toUInt();               // 5 - UTC Time
+                                 page0.transmissionRate = words[ counter++ ].toUInt();               // 6 - Transmission Rate
+                                 page0.supportedPages   = words[ counter++ ].toUInt();               // 7 - Supported Pages
                                  if ( diagnostics )
                                  {
-                                     appendDiagnosticsLine( "Local Time",        additionalData1 );
-                                     appendDiagnosticsLine( "UTC Time",          additionalData2 );
-                                     appendDiagnosticsLine( "Transmission Rate", additionalData2 );
-                                     appendDiagnosticsLine( "Supported Pages",   additionalData4 );
+                                     appendDiagnosticsLine( "Local Time",        page0.localTime );
+                                     appendDiagnosticsLine( "UTC Time",          page0.utcTime );
+                                     appendDiagnosticsLine( "Transmission Rate", page0.utcTime );
+                                     appendDiagnosticsLine( "Supported Pages",   page0.supportedPages );
                                  }
                              }
                              break;
@@ -258,17 +252,17 @@ amDeviceType antEnvironmentProcessing::processEnvironmentSensorSemiCooked
                              //
                              if ( nbWords > 7 )
                              {
-                                 result          = ENVIRONMENT_SENSOR;
-                                 additionalData1 = words[ counter++ ].toUInt();                      // 4 - Current Temperature
-                                 additionalData2 = words[ counter++ ].toUInt();                      // 5 - Low Temperature 24h
-                                 additionalData3 = words[ counter++ ].toUInt();                      // 6 - High Temperature 24h
-                                 additionalData4 = words[ counter++ ].toUInt();                      // 7 - Event Count
+                                 result                   = ENVIRONMENT_SENSOR;
+                                 page1.currentTemperature = words[ counter++ ].toUInt();             // 4 - Current Temperature
+                                 page1.lowTemperature24h  = words[ counter++ ].toUInt();             // 5 - Low Temperature 24h
+                                 page1.highTemperature24h = words[ counter++ ].toUInt();             // 6 - High Temperature 24h
+                                 page1.eventCount         = words[ counter++ ].toUInt();             // 7 - Event Count
                                  if ( diagnostics )
                                  {
-                                     appendDiagnosticsLine( "Current Temperature * 100", additionalData1 );
-                                     appendDiagnosticsLine( "Low Temperature * 10",      additionalData2, " (last 24h)" );
-                                     appendDiagnosticsLine( "High Temperature * 10",     additionalData3, " (last 24h)" );
-                                     appendDiagnosticsLine( "Event Count",               additionalData4 );
+                                     appendDiagnosticsLine( "Current Temperature * 100", page1.currentTemperature );
+                                     appendDiagnosticsLine( "Low Temperature * 10",      page1.lowTemperature24h, " (last 24h)" );
+                                     appendDiagnosticsLine( "High Temperature * 10",     page1.highTemperature24h, " (last 24h)" );
+                                     appendDiagnosticsLine( "Event Count",               page1.eventCount );
                                  }
                              }
                              break;
@@ -291,10 +285,9 @@ amDeviceType antEnvironmentProcessing::processEnvironmentSensorSemiCooked
             }
         }
 
-        createOutputHeader( sensorID, timeStampBuffer );
         if ( commonPage )
         {
-            commonPage = processCommonPagesSemiCooked( words, startCounter, outputPageNo );
+            commonPage = processCommonPagesSemiCooked( words, startCounter, curVersion, outputPageNo );
             if ( !commonPage )
             {
                 result = OTHER_DEVICE;
@@ -302,9 +295,8 @@ amDeviceType antEnvironmentProcessing::processEnvironmentSensorSemiCooked
         }
         else
         {
-            createENVResultString( dataPage, additionalData1, additionalData2, additionalData3, additionalData4 );
+            outputEnvironmentRecord( sensorID, timeStampBuffer, curVersion, dataPage, page0, page1 );
         }
-        appendOutputFooter( curVersion );
     }
     else if ( result == UNKNOWN_DEVICE )
     {
@@ -332,7 +324,7 @@ amDeviceType antEnvironmentProcessing::processEnvironmentSensorSemiCooked
 //
 // Parameters:
 //    int             deviceType        IN   Device type
-//    const amString &deviceID          IN   Device ID (number).
+//    unsigned int    deviceID          IN   Device ID (number).
 //    const amString &timeStampBuffer   IN   Time stamp.
 //    BYTE            payLoad[]         IN   Array of bytes with the data to be converted.
 //
@@ -344,7 +336,7 @@ amDeviceType antEnvironmentProcessing::processEnvironmentSensorSemiCooked
 amDeviceType antEnvironmentProcessing::processSensor
 (
     int             deviceType,
-    const amString &deviceIDNo,
+    unsigned int    deviceIDNo,
     const amString &timeStampBuffer,
     BYTE            payLoad[]
 )
@@ -357,7 +349,7 @@ amDeviceType antEnvironmentProcessing::processSensor
     }
     else if ( outputUnknown )
     {
-        int deviceIDNoAsInt = deviceIDNo.toInt();
+        int deviceIDNoAsInt = ( int ) deviceIDNo;
         createUnknownDeviceTypeString( deviceType, deviceIDNoAsInt, timeStampBuffer, payLoad );
     }
     else
@@ -433,133 +425,30 @@ void antEnvironmentProcessing::readDeviceFileLine
     }
 }
 
-void antEnvironmentProcessing::createENVResultString
+void antEnvironmentProcessing::outputEnvironmentRecord
 (
-    unsigned int dataPage,
-    unsigned int additionalData1,
-    unsigned int additionalData2,
-    unsigned int additionalData3,
-    unsigned int additionalData4
+    const antSensorHandle     &sensorID,
+    const amString            &timeStampBuffer,
+    const amString            &versionString,
+    unsigned int               dataPage,
+    antEnvironmentPage0Record &page0,
+    antEnvironmentPage1Record &page1
 )
 {
-    if ( semiCookedOut )
+    antRecordContext context( sensorID, timeStampBuffer, versionString );
+
+    if ( ( dataPage & 0x0F ) == 0 )
     {
-        if ( outputAsJSON )
-        {
-            appendJSONItem( "data page", dataPage );
-            if ( ( dataPage & 0x0F ) == 0 )
-            {
-                appendJSONItem( "local time",        additionalData1 );
-                appendJSONItem( "utc time",          additionalData2 );
-                appendJSONItem( "transmission rate", additionalData3 );
-                appendJSONItem( "supported pages",   additionalData4 );
-            }
-            else if ( ( dataPage & 0x0F ) == 1 )
-            {
-                appendJSONItem( "current temperature times 100", additionalData1 );
-                appendJSONItem( "low temperature 24h times 10",  additionalData2 );
-                appendJSONItem( "high temperature 24h times 10", additionalData3 );
-                appendJSONItem( "event count",                   additionalData4 );
-            }
-        }
-        else
-        {
-            appendOutput( dataPage );
-            appendOutput( additionalData1 );
-            appendOutput( additionalData2 );
-            appendOutput( additionalData3 );
-            appendOutput( additionalData4 );
-        }
+        page0.dataPage = dataPage;
+        outputRecord( context, page0 );
     }
     else
     {
-        double currTemp                         = 0;
-        double lowTemp24h                       = 0;
-        double highTemp24h                      = 0;
-        char   auxBuffer[ C_SMALL_BUFFER_SIZE ] = { 0 };
-        char   auxBuffer1[ C_TINY_BUFFER_SIZE ] = { 0 };
-
-        if ( ( ( dataPage & 0x0F ) == 0 ) && ( additionalData4 != 0 ) )
-        {
-            *auxBuffer = 0;
-            for ( int page = 0; page < 32; ++page )
-            {
-                if ( additionalData4 & ( 1 << page ) )
-                {
-                    if ( *auxBuffer != 0 )
-                    {
-                        strcat( auxBuffer, ", " );
-                    }
-                    sprintf( auxBuffer1, "%u", page );
-                    strcat( auxBuffer, auxBuffer1 );
-                }
-            }
-        }
-        else if ( ( dataPage & 0x0F ) == 1 )
-        {
-            currTemp    = convertTemp100( additionalData1 );
-            lowTemp24h  = convertTemp10 ( additionalData2 );
-            highTemp24h = convertTemp10 ( additionalData3 );
-        }
-
-        if ( outputAsJSON )
-        {
-            if ( ( dataPage & 0x0F ) == 0 )
-            {
-                appendJSONItem( "local time", ( additionalData1 == 0 ) ? "set" : (
-                                              ( additionalData1 == 1 ) ? "supported and not set" : (
-                                              ( additionalData1 == 2 ) ? "supported and set"     : C_UNUSED_JSON ) ) );
-
-                appendJSONItem( "utc time", ( additionalData2 == 0 ) ? "set" : (
-                                            ( additionalData2 == 1 ) ? "supported and not set" : (
-                                            ( additionalData2 == 2 ) ? "supported and set"     : C_UNUSED_JSON ) ) );
-
-                appendJSONItem( "transmission rate", ( additionalData3 == 0 ) ? "0.5" : (
-                                                     ( additionalData3 == 2 ) ? "4.0" : C_UNUSED ) );
-
-                appendJSONItem( "supported pages", ( additionalData4 == 0 ) ? C_NONE_JSON : auxBuffer );
-            }
-            else if ( ( dataPage & 0x0F ) == 1 )
-            {
-                appendJSONItem( "current temperature",  currTemp, 2 );
-                appendJSONItem( "low temperature 24h",  lowTemp24h, 1 );
-                appendJSONItem( "high temperature 24h", highTemp24h, 1 );
-                appendJSONItem( "event count",          additionalData1 );
-            }
-        }
-        else
-        {
-            if ( ( dataPage & 0x0F ) == 0 )
-            {
-                appendOutput( "LOCAL_TIME" );
-                appendOutput( ( additionalData1 == 0 ) ? C_SET_ID : (
-                              ( additionalData1 == 1 ) ? C_SUPPORTED_AND_NOT_SET_ID : (
-                              ( additionalData1 == 2 ) ? C_SUPPORTED_AND_SET_ID : C_UNUSED ) ) );
-
-                appendOutput( "UTC_TIME" );
-                appendOutput( ( additionalData2 == 0 ) ? C_SET_ID : (
-                              ( additionalData2 == 1 ) ? C_SUPPORTED_AND_NOT_SET_ID : (
-                              ( additionalData2 == 2 ) ? C_SUPPORTED_AND_SET_ID : C_UNUSED ) ) );
-
-                appendOutput( "TRANSMISSION_HZ" );
-                appendOutput( ( additionalData3 == 0 ) ? "0.5" : (
-                              ( additionalData3 == 2 ) ? "4.0" : C_UNUSED ) );
-
-                appendOutput( "SUPPORTED_PAGES" );
-                appendOutput( ( additionalData4 == 0 ) ? C_NONE_ID : auxBuffer );
-            }
-            else if ( ( dataPage & 0x0F ) == 1 )
-            {
-                appendOutput( "CURR_TEMP" );
-                appendOutput( currTemp, 2, "C" );
-                appendOutput( "LOW_TEMP_24H" );
-                appendOutput( lowTemp24h, 1, "C" );
-                appendOutput( "HIGH_TEMP_24H" );
-                appendOutput( highTemp24h, 1, "C" );
-                appendOutput( "EVENT_NO" );
-                appendOutput( additionalData4 );
-            }
-        }
+        page1.dataPage    = dataPage;
+        page1.currentTemp = convertTemp100( page1.currentTemperature );
+        page1.lowTemp24h  = convertTemp10 ( page1.lowTemperature24h );
+        page1.highTemp24h = convertTemp10 ( page1.highTemperature24h );
+        outputRecord( context, page1 );
     }
 }
 
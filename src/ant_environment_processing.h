@@ -11,14 +11,12 @@ class antEnvironmentProcessing : virtual public antProcessing
         double convertTemp10 ( int temp10 );
         double convertTemp100( int temp100 );
 
-        std::map<amString, unsigned int> previousHeartRateTable;
-        std::map<amString, unsigned int> eventTimeTable;
-        std::map<amString, double>       heartBeatTimeTable;
+        void outputEnvironmentRecord( const antSensorHandle &sensorID, const amString &timeStampBuffer, const amString &versionString, unsigned int dataPage, antEnvironmentPage0Record &page0, antEnvironmentPage1Record &page1 );
 
 
     protected:
 
-        amDeviceType processEnvironmentSensor( const amString &deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
+        amDeviceType processEnvironmentSensor( unsigned int deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
         amDeviceType processEnvironmentSensorSemiCooked( const amString &inputBuffer );
 
         virtual void readDeviceFileLine( const char *line );
@@ -32,19 +30,11 @@ class antEnvironmentProcessing : virtual public antProcessing
 
         bool isEnvironmentSensor( const amString &deviceID );
 
-        virtual amDeviceType processSensor( int deviceType, const amString &deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
+        virtual amDeviceType processSensor( int deviceType, unsigned int deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
         virtual amDeviceType processSensorSemiCooked( const amString &inputBuffer );
 
-        void createENVResultString
-             (
-                 unsigned int dataPage,
-                 unsigned int additionalData1,
-                 unsigned int additionalData2,
-                 unsigned int additionalData3,
-                 unsigned int additionalData4
-             );
-
         virtual void reset( void );
+        virtual antProcessing *createWorker( void ) const { return new antEnvironmentProcessing; }
 
 };
 
@@ -20,7 +20,11 @@
 antHRMProcessing::antHRMProcessing
 (
     void
-) : antProcessing()
+) : antProcessing(),
+    heartRateSensorTable( sensorStates, &antSensorState::heartRateSensor, SS_HEART_RATE_SENSOR ),
+    previousHeartRateTable( sensorStates, &antSensorState::previousHeartRate, SS_PREVIOUS_HEART_RATE ),
+    eventTimeTable( sensorStates, &antSensorState::heartRateEventTime, SS_HEART_RATE_EVENT_TIME ),
+    heartBeatTimeTable( sensorStates, &antSensorState::heartBeatTime, SS_HEART_BEAT_TIME )
 {
     reset();
     setCurrentDeviceType( "HRM" );
@@ -57,7 +61,7 @@ bool antHRMProcessing::appendHRMSensor
     {
         if ( !isRegisteredSensor( sensorID ) )
         {
-            heartRateSensorTable.insert( std::pair<amString, bool>( sensorID, true ) );
+            heartRateSensorTable.insert( sensorID, true );
         }
     }
     return result;
@@ -84,30 +88,21 @@ bool antHRMProcessing::isRegisteredSensor
 //-------------------------------------------------------------------------------------------------//
 amDeviceType antHRMProcessing::processHRMSensor
 (
-    const amString &deviceIDNo,
+    unsigned int    deviceIDNo,
     const amString &timeStampBuffer,
     BYTE            payLoad[]
 )
 {
-    char         auxBuffer[ C_MEDIUM_BUFFER_SIZE ] = { 0 };
-    unsigned int dataPage                          = 0;
-    unsigned int heartBeatEventTime                = 0;
-    unsigned int heartRate                         = 0;
-    unsigned int heartBeatCount                    = 0;
-    unsigned int deltaHeartBeatEventTime           = 0;
-    unsigned int deltaHeartBeatCount               = 0;
-    unsigned int rollOver                          = 0;
-    unsigned int additionalData1                   = 0;
-    unsigned int additionalData2                   = 0;
-    unsigned int additionalData3                   = 0;
-    unsigned int totalHeartBeatCount               = 0;
-    double       totalHeartBeatEventTime           = 0;
-    double       additionalDoubleData1             = 0;
-    bool         rollOverHappened                  = false;
-    bool         commonPage                        = false;
-    bool         outputPageNo                      = true;
-    amDeviceType result                            = OTHER_DEVICE;
-    amString     sensorID                          = amString( C_HRM_DEVICE_HEAD) + deviceIDNo;
+    char            auxBuffer[ C_MEDIUM_BUFFER_SIZE ] = { 0 };
+    antHRMRecord    record                            = antHRMRecord();
+    unsigned int    heartBeatEventTime                = 0;
+    unsigned int    heartBeatCount                    = 0;
+    unsigned int    rollOver                          = 0;
+    bool            rollOverHappened                  = false;
+    bool            commonPage                        = false;
+    bool            outputPageNo                      = true;
+    amDeviceType    result                            = OTHER_DEVICE;
+    antSensorHandle sensorID                          = sensorStates.intern( C_HRM_DEVICE_HEAD, deviceIDNo );
 
 
     if ( isRegisteredDevice( sensorID ) )
@@ -116,28 +111,28 @@ amDeviceType antHRMProcessing::processHRMSensor
              ( eventCountTable.count   ( sensorID ) == 0 ) ||
              ( operatingTimeTable.count( sensorID ) == 0 ) )
         {
-            eventTimeTable.insert( std::pair<amString, double>( sensorID, 0.0 ) );
-            eventCountTable.insert( std::pair<amString, double>( sensorID, 0.0 ) );
-            operatingTimeTable.insert( std::pair<amString, unsigned int>( sensorID, 0 ) );
+            eventTimeTable.insert( sensorID, 0.0 );
+            eventCountTable.insert( sensorID, 0.0 );
+            operatingTimeTable.insert( sensorID, 0 );
         }
 
-        dataPage = byte2UInt( payLoad[ 0 ] );
+        record.dataPage = byte2UInt( payLoad[ 0 ] );
         if ( diagnostics )
         {
-            appendDiagnosticsLine( "Data Page", payLoad[ 0 ], dataPage );
+            appendDiagnosticsLine( "Data Page", payLoad[ 0 ], record.dataPage );
         }
 
-        heartRate = byte2UInt( payLoad[ 7 ] );
+        record.heartRate = byte2UInt( payLoad[ 7 ] );
         if ( diagnostics )
         {
-            appendDiagnosticsLine( "Heart Rate", payLoad[ 7 ], heartRate );
+            appendDiagnosticsLine( "Heart Rate", payLoad[ 7 ], record.heartRate );
         }
 
-        heartBeatEventTime         = byte2UInt( payLoad[ 5 ], payLoad[ 4 ] );
-        rollOver                   = 65536;  // 256^2
-        deltaHeartBeatEventTime    = getDeltaInt( rollOverHappened, sensorID, rollOver, eventTimeTable, heartBeatEventTime );
-        totalHeartBeatEventTime    = totalTimeTable[ sensorID ] + ( ( double ) deltaHeartBeatEventTime ) / 1024.0;
-        totalTimeTable[ sensorID ] = totalHeartBeatEventTime;
+        heartBeatEventTime             = byte2UInt( payLoad[ 5 ], payLoad[ 4 ] );
+        rollOver                       = 65536;  // 256^2
+        record.deltaHeartBeatEventTime = getDeltaInt( rollOverHappened, sensorID, rollOver, eventTimeTable, heartBeatEventTime );
+        record.totalHeartBeatEventTime = totalTimeTable[ sensorID ] + ( ( double ) record.deltaHeartBeatEventTime ) / 1024.0;
+        totalTimeTable[ sensorID ]     = record.totalHeartBeatEventTime;
         if ( diagnostics )
         {
             appendDiagnosticsLine( "Heart Beat Even Time", payLoad[ 5 ], payLoad[ 4 ], heartBeatEventTime );
@@ -147,14 +142,14 @@ amDeviceType antHRMProcessing::processHRMSensor
             {
                 sprintf( auxBuffer, " (Rollover [%d] occurred)", rollOver );
             }
-            appendDiagnosticsLine( "Delta Heart Beat Even Time", deltaHeartBeatEventTime, auxBuffer );
+            appendDiagnosticsLine( "Delta Heart Beat Even Time", record.deltaHeartBeatEventTime, auxBuffer );
         }
 
         heartBeatCount              = byte2UInt( payLoad[ 6 ] );
         rollOver                    = 256;  // 256 = 1 Byte
-        deltaHeartBeatCount         = getDeltaInt( rollOverHappened, sensorID, rollOver, eventCountTable, heartBeatCount );
-        totalHeartBeatCount         = totalCountTable[ sensorID ] + deltaHeartBeatCount;
-        totalCountTable[ sensorID ] = totalHeartBeatCount;
+        record.deltaHeartBeatCount  = getDeltaInt( rollOverHappened, sensorID, rollOver, eventCountTable, heartBeatCount );
+        record.totalHeartBeatCount  = totalCountTable[ sensorID ] + record.deltaHeartBeatCount;
+        totalCountTable[ sensorID ] = record.totalHeartBeatCount;
         if ( diagnostics )
         {
             *auxBuffer = 0;
@@ -162,10 +157,10 @@ amDeviceType antHRMProcessing::processHRMSensor
             {
                 sprintf( auxBuffer, " (Rollover [%d] occurred)", rollOver );
             }
-            appendDiagnosticsLine( "Delta Heart Beat Count", deltaHeartBeatCount, auxBuffer );
+            appendDiagnosticsLine( "Delta Heart Beat Count", record.deltaHeartBeatCount, auxBuffer );
         }
 
-        int dataPageMod128 = dataPage & 0x0F;
+        int dataPageMod128 = record.dataPage & 0x0F;
         switch ( dataPageMod128 )
         {
             case  0: // - - Page 0: No Additional Data - - - - - - - - - - - - - - -
@@ -173,68 +168,68 @@ amDeviceType antHRMProcessing::processHRMSensor
                      break;
 
             case  1: // - - Page 1: Operating Time - - - - - - - - - - - - - - - - -
-                     result          = HEART_RATE_METER;
-                     additionalData2 = byte2UInt( payLoad[ 3 ], payLoad[ 2 ], payLoad[ 1 ] ); // Operating Time
-                     rollOver        = 16777216;  // 256^3
-                     additionalData1 = getDeltaInt( rollOverHappened, sensorID, rollOver, operatingTimeTable, additionalData2 );
+                     result                 = HEART_RATE_METER;
+                     record.additionalData2 = byte2UInt( payLoad[ 3 ], payLoad[ 2 ], payLoad[ 1 ] ); // Operating Time
+                     rollOver               = 16777216;  // 256^3
+                     record.additionalData1 = getDeltaInt( rollOverHappened, sensorID, rollOver, operatingTimeTable, record.additionalData2 );
                                        // deltaOperatingTime
                      if ( diagnostics )
                      {
-                         double cumOperatingTimeH = ( double ) additionalData2 / 3600.0;
+                         double cumOperatingTimeH = ( double ) record.additionalData2 / 3600.0;
                          sprintf( auxBuffer, " (%2.2lfh)", cumOperatingTimeH );
-                         appendDiagnosticsLine( "Cumulative Operating Time", payLoad[ 3 ], payLoad[ 2 ], payLoad[ 1 ], additionalData2, auxBuffer );
+                         appendDiagnosticsLine( "Cumulative Operating Time", payLoad[ 3 ], payLoad[ 2 ], payLoad[ 1 ], record.additionalData2, auxBuffer );
                          *auxBuffer = 0;
                          if ( rollOverHappened )
                          {
                              sprintf( auxBuffer, " (Rollover [%d] occurred)", rollOver );
                          }
-                         appendDiagnosticsLine( "Delta Cumulative Operating Time", additionalData1, auxBuffer );
+                         appendDiagnosticsLine( "Delta Cumulative Operating Time", record.additionalData1, auxBuffer );
                      }
                      break;
 
             case  2: // - - Page 2: Manufacturer Information - - - - - - - - - - - -
-                     result          = HEART_RATE_METER;
-                     additionalData1 = byte2UInt( payLoad[ 1 ] );                // Manufacturer ID
-                     additionalData2 = byte2UInt( payLoad[ 3 ], payLoad[ 2 ] );  // Serial Number
+                     result                 = HEART_RATE_METER;
+                     record.additionalData1 = byte2UInt( payLoad[ 1 ] );                // Manufacturer ID
+                     record.additionalData2 = byte2UInt( payLoad[ 3 ], payLoad[ 2 ] );  // Serial Number
                      if ( diagnostics )
                      {
-                         appendDiagnosticsLine( "Manufacturer ID", payLoad[ 1 ], additionalData1 );
-                         appendDiagnosticsLine( "Serial Number", payLoad[ 3 ], payLoad[ 2 ], additionalData2 );
+                         appendDiagnosticsLine( "Manufacturer ID", payLoad[ 1 ], record.additionalData1 );
+                         appendDiagnosticsLine( "Serial Number", payLoad[ 3 ], payLoad[ 2 ], record.additionalData2 );
                      }
                      break;
 
             case  3: // - - Page 3: Product Information  - - - - - - - - - - - - - -
-                     result          = HEART_RATE_METER;
-                     additionalData1 = byte2UInt( payLoad[ 1 ] );   // H/W Version
-                     additionalData2 = byte2UInt( payLoad[ 2 ] );   // S/W Version
-                     additionalData3 = byte2UInt( payLoad[ 3 ] );   // Model Number
+                     result                 = HEART_RATE_METER;
+                     record.additionalData1 = byte2UInt( payLoad[ 1 ] );   // H/W Version
+                     record.additionalData2 = byte2UInt( payLoad[ 2 ] );   // S/W Version
+                     record.additionalData3 = byte2UInt( payLoad[ 3 ] );   // Model Number
                      if ( diagnostics )
                      {
-                         appendDiagnosticsLine( "Hardware Version", payLoad[ 1 ], additionalData1 );
-                         appendDiagnosticsLine( "Software Version", payLoad[ 2 ], additionalData2 );
-                         appendDiagnosticsLine( "Model Number", payLoad[ 3 ], additionalData3 );
+                         appendDiagnosticsLine( "Hardware Version", payLoad[ 1 ], record.additionalData1 );
+                         appendDiagnosticsLine( "Software Version", payLoad[ 2 ], record.additionalData2 );
+                         appendDiagnosticsLine( "Model Number", payLoad[ 3 ], record.additionalData3 );
                      }
                      break;
 
             case  4: // - - Page 4: Previous Heartbeat Time - - - - - - - - - - - - -
-                     result                         = HEART_RATE_METER;
-                     rollOver                       = 65536;  // 256^2
-                     additionalData2                = byte2UInt( payLoad[ 1 ] );                 // Manufacturer Specific Data;
-                     additionalData3                = byte2UInt( payLoad[ 3 ], payLoad[ 2 ] );   // Previous Heart Beat Event Time
-                     additionalData1                = getDeltaInt( rollOverHappened, sensorID, rollOver, previousHeartRateTable, additionalData3 );
-                     additionalDoubleData1          = heartBeatTimeTable[ sensorID ] + ( ( double ) additionalData1 ) / 1024.0;
-                     additionalData3                = 0;
-                     heartBeatTimeTable[ sensorID ] = additionalDoubleData1;
+                     result                            = HEART_RATE_METER;
+                     rollOver                          = 65536;  // 256^2
+                     record.additionalData2            = byte2UInt( payLoad[ 1 ] );                 // Manufacturer Specific Data;
+                     record.additionalData3            = byte2UInt( payLoad[ 3 ], payLoad[ 2 ] );   // Previous Heart Beat Event Time
+                     record.additionalData1            = getDeltaInt( rollOverHappened, sensorID, rollOver, previousHeartRateTable, record.additionalData3 );
+                     record.previousHeartBeatEventTime = heartBeatTimeTable[ sensorID ] + ( ( double ) record.additionalData1 ) / 1024.0;
+                     record.additionalData3            = 0;
+                     heartBeatTimeTable[ sensorID ]    = record.previousHeartBeatEventTime;
                      if ( diagnostics )
                      {
-                         appendDiagnosticsLine( "Manufacturer Specific Info", payLoad[ 1 ], additionalData1 );
-                         appendDiagnosticsLine( "Previous Heart Beat Event Time", payLoad[ 3 ], payLoad[ 2 ], additionalData2 );
+                         appendDiagnosticsLine( "Manufacturer Specific Info", payLoad[ 1 ], record.additionalData1 );
+                         appendDiagnosticsLine( "Previous Heart Beat Event Time", payLoad[ 3 ], payLoad[ 2 ], record.additionalData2 );
                          *auxBuffer = 0;
                          if ( rollOverHappened )
                          {
                              sprintf( auxBuffer, " (Rollover [%d] occurred)", rollOver );
                          }
-                         appendDiagnosticsLine( "Delta Previous Heart Beat Event Time", additionalData2, auxBuffer );
+                         appendDiagnosticsLine( "Delta Previous Heart Beat Event Time", record.additionalData2, auxBuffer );
                      }
                      break;
 
@@ -246,10 +241,9 @@ amDeviceType antHRMProcessing::processHRMSensor
 
     if ( result == HEART_RATE_METER )
     {
-        createOutputHeader( sensorID, timeStampBuffer );
         if ( commonPage )
         {
-            commonPage = processCommonPages( sensorID, payLoad, outputPageNo );
+            commonPage = processCommonPages( sensorID, timeStampBuffer, getVersion(), payLoad, outputPageNo );
             if ( !commonPage )
             {
                 result = OTHER_DEVICE;
@@ -257,21 +251,8 @@ amDeviceType antHRMProcessing::processHRMSensor
         }
         else
         {
-            createHRMResultString
-            (
-                dataPage,
-                heartRate,
-                deltaHeartBeatEventTime,
-                deltaHeartBeatCount,
-                totalHeartBeatEventTime,
-                totalHeartBeatCount,
-                additionalData1,
-                additionalData2,
-                additionalData3,
-                additionalDoubleData1
-            );
+            outputRecord( antRecordContext( sensorID, timeStampBuffer, getVersion() ), record );
         }
-        appendOutputFooter( getVersion() );
     }
 
     return result;
@@ -293,19 +274,10 @@ amDeviceType antHRMProcessing::processHRMSensorSemiCooked
 {
     amDeviceType result = OTHER_DEVICE;
     amSplitString words;
-    unsigned int  deltaHeartBeatEventTime = 0;
-    unsigned int  deltaHeartBeatCount     = 0;
-    unsigned int  heartRate               = 0;
-    unsigned int  dataPage                = 0;
+    antHRMRecord  record                  = antHRMRecord();
     unsigned int  counter                 = 0;
     unsigned int  startCounter            = 0;
-    unsigned int  additionalData1         = 0;
-    unsigned int  additionalData2         = 0;
-    unsigned int  additionalData3         = 0;
-    unsigned int  totalHeartBeatCount     = 0;
     unsigned int  nbWords                 = words.split( inputBuffer );
-    double        totalHeartBeatEventTime = 0;
-    double        additionalDoubleData1   = 0;
     amString      timeStampBuffer;
     amString      curVersion              = getVersion();
     amString      sensorID;
@@ -327,30 +299,30 @@ amDeviceType antHRMProcessing::processHRMSensorSemiCooked
         }
         if ( isRegisteredDevice( sensorID ) && ( semiCookedString == C_SEMI_COOKED_SYMBOL_AS_STRING ) && isHeartRateSensor( sensorID ) )
         {
-            startCounter            = counter;
-            heartRate               = words[ counter++ ].toUInt();    // 3
-            deltaHeartBeatEventTime = words[ counter++ ].toUInt();    // 4
-            deltaHeartBeatCount     = words[ counter++ ].toUInt();    // 5
-            dataPage                = words[ counter++ ].toUInt();    // 6
+            startCounter                   = counter;
+            record.heartRate               = words[ counter++ ].toUInt();    // 3
+            record.deltaHeartBeatEventTime = words[ counter++ ].toUInt();    // 4
+            record.deltaHeartBeatCount     = words[ counter++ ].toUInt();    // 5
+            record.dataPage                = words[ counter++ ].toUInt();    // 6
             if ( words[ counter ] == C_UNSUPPORTED_DATA_PAGE )
             {
                 result = UNKNOWN_DEVICE;
             }
             else
             {
-                totalHeartBeatEventTime     = totalTimeTable[ sensorID ] + ( ( double ) deltaHeartBeatEventTime ) / 1024.0;
-                totalTimeTable[ sensorID ]  = totalHeartBeatEventTime;
-                totalHeartBeatCount         = totalCountTable[ sensorID ] + deltaHeartBeatCount;
-                totalCountTable[ sensorID ] = totalHeartBeatCount;
+                record.totalHeartBeatEventTime = totalTimeTable[ sensorID ] + ( ( double ) record.deltaHeartBeatEventTime ) / 1024.0;
+                totalTimeTable[ sensorID ]     = record.totalHeartBeatEventTime;
+                record.totalHeartBeatCount     = totalCountTable[ sensorID ] + record.deltaHeartBeatCount;
+                totalCountTable[ sensorID ]    = record.totalHeartBeatCount;
                 if ( diagnostics )
                 {
-                    appendDiagnosticsLine( "Data Page", dataPage );
-                    appendDiagnosticsLine( "Heart Rate", heartRate );
-                    appendDiagnosticsLine( "Delta Heart Beat Event Time", deltaHeartBeatEventTime );
-                    appendDiagnosticsLine( "Delta Heart Beat Count", deltaHeartBeatCount );
+                    appendDiagnosticsLine( "Data Page", record.dataPage );
+                    appendDiagnosticsLine( "Heart Rate", record.heartRate );
+                    appendDiagnosticsLine( "Delta Heart Beat Event Time", record.deltaHeartBeatEventTime );
+                    appendDiagnosticsLine( "Delta Heart Beat Count", record.deltaHeartBeatCount );
                 }
 
-                int dataPageMod128 = dataPage & 0x0F;
+                int dataPageMod128 = record.dataPage & 0x0F;
                 switch ( dataPageMod128 )
                 {
                     case  0: // - - Page 0: No Additional Data - - - - - - - - - - - - - - -
@@ -360,11 +332,11 @@ amDeviceType antHRMProcessing::processHRMSensorSemiCooked
                     case  1: // - - Page 1: Operating Time - - - - - - - - - - - - - - - - -
                              if ( nbWords > 7 )
                              {
-                                 result          = HEART_RATE_METER;
-                                 additionalData1 = words[ counter++ ].toUInt();   // deltaOperatingTime
+                                 result                 = HEART_RATE_METER;
+                                 record.additionalData1 = words[ counter++ ].toUInt();   // deltaOperatingTime
                                  if ( diagnostics )
                                  {
-                                     appendDiagnosticsLine( "Delta Cumulative Operating Time", additionalData1 );
+                                     appendDiagnosticsLine( "Delta Cumulative Operating Time", record.additionalData1 );
                                  }
                              }
                              break;
@@ -372,13 +344,13 @@ amDeviceType antHRMProcessing::processHRMSensorSemiCooked
                     case  2: // - - Page 2: Manufacturer Information - - - - - - - - - - - -
                              if ( nbWords > 8 )
                              {
-                                 result          = HEART_RATE_METER;
-                                 additionalData1 = words[ counter++ ].toUInt();   // manufacturerID
-                                 additionalData2 = words[ counter++ ].toUInt();   // serialNumber
+                                 result                 = HEART_RATE_METER;
+                                 record.additionalData1 = words[ counter++ ].toUInt();   // manufacturerID
+                                 record.additionalData2 = words[ counter++ ].toUInt();   // serialNumber
                                  if ( diagnostics )
                                  {
-                                     appendDiagnosticsLine( "Manufacturer ID", additionalData1 );
-                                     appendDiagnosticsLine( "Serial Number", additionalData2 );
+                                     appendDiagnosticsLine( "Manufacturer ID", record.additionalData1 );
+                                     appendDiagnosticsLine( "Serial Number", record.additionalData2 );
                                  }
                              }
                              break;
@@ -386,15 +358,15 @@ amDeviceType antHRMProcessing::processHRMSensorSemiCooked
                     case  3: // - - Page 3: Product Information  - - - - - - - - - - - - - -
                              if ( nbWords > 9 )
                              {
-                                 result          = HEART_RATE_METER;
-                                 additionalData1 = words[ counter++ ].toUInt();   // hwVersion
-                                 additionalData2 = words[ counter++ ].toUInt();   // swVersion
-                                 additionalData3 = words[ counter++ ].toUInt();   // modelNumber
+                                 result                 = HEART_RATE_METER;
+                                 record.additionalData1 = words[ counter++ ].toUInt();   // hwVersion
+                                 record.additionalData2 = words[ counter++ ].toUInt();   // swVersion
+                                 record.additionalData3 = words[ counter++ ].toUInt();   // modelNumber
                                  if ( diagnostics )
                                  {
-                                     appendDiagnosticsLine( "Model Number", additionalData1 );
-                                     appendDiagnosticsLine( "Software Version", additionalData2 );
-                                     appendDiagnosticsLine( "Hardware Version", additionalData3 );
+                                     appendDiagnosticsLine( "Model Number", record.additionalData1 );
+                                     appendDiagnosticsLine( "Software Version", record.additionalData2 );
+                                     appendDiagnosticsLine( "Hardware Version", record.additionalData3 );
                                  }
                              }
                              break;
@@ -402,15 +374,15 @@ amDeviceType antHRMProcessing::processHRMSensorSemiCooked
                     case  4: // - - Page 4: Previous Heartbeat Time - - - - - - - - - - - - -
                              if ( nbWords > 8 )
                              {
-                                 result                         = HEART_RATE_METER;
-                                 additionalData1                = words[ counter++ ].toUInt(); // deltaPrevHeartBeatEventTime;
-                                 additionalData2                = words[ counter++ ].toUInt(); // manufacturerSpecificData;
-                                 additionalDoubleData1          = heartBeatTimeTable[ sensorID ] + ( ( double ) additionalData1 ) / 1024.0;
-                                 heartBeatTimeTable[ sensorID ] = additionalDoubleData1;
+                                 result                            = HEART_RATE_METER;
+                                 record.additionalData1            = words[ counter++ ].toUInt(); // deltaPrevHeartBeatEventTime;
+                                 record.additionalData2            = words[ counter++ ].toUInt(); // manufacturerSpecificData;
+                                 record.previousHeartBeatEventTime = heartBeatTimeTable[ sensorID ] + ( ( double ) record.additionalData1 ) / 1024.0;
+                                 heartBeatTimeTable[ sensorID ]    = record.previousHeartBeatEventTime;
                                  if ( diagnostics )
                                  {
-                                     appendDiagnosticsLine( "Manufacturer Specific Info", additionalData1 );
-                                     appendDiagnosticsLine( "Delta Previous Heart Beat Event Time", additionalData2 );
+                                     appendDiagnosticsLine( "Manufacturer Specific Info", record.additionalData1 );
+                                     appendDiagnosticsLine( "Delta Previous Heart Beat Event Time", record.additionalData2 );
                                  }
                              }
                              break;
@@ -434,10 +406,9 @@ amDeviceType antHRMProcessing::processHRMSensorSemiCooked
                 appendDiagnosticsLine( "Version", curVersion );
             }
         }
-        createOutputHeader( sensorID, timeStampBuffer );
         if ( commonPage )
         {
-            commonPage = processCommonPagesSemiCooked( words, startCounter, outputPageNo );
+            commonPage = processCommonPagesSemiCooked( words, startCounter, curVersion, outputPageNo );
             if ( !commonPage )
             {
                 result = OTHER_DEVICE;
@@ -445,21 +416,8 @@ amDeviceType antHRMProcessing::processHRMSensorSemiCooked
         }
         else
         {
-            createHRMResultString
-            (
-                dataPage,
-                heartRate,
-                deltaHeartBeatEventTime,
-                deltaHeartBeatCount,
-                totalHeartBeatEventTime,
-                totalHeartBeatCount,
-                additionalData1,
-                additionalData2,
-                additionalData3,
-                additionalDoubleData1
-            );
+            outputRecord( antRecordContext( sensorID, timeStampBuffer, curVersion ), record );
         }
-        appendOutputFooter( curVersion );
     }
     else if ( result == UNKNOWN_DEVICE )
     {
@@ -487,7 +445,7 @@ amDeviceType antHRMProcessing::processHRMSensorSemiCooked
 //
 // Parameters:
 //    int             deviceType        IN   Device type (SPCAD, SPEED, CADENCE, HRM, AERO, POWER).
-//    const amString &deviceID          IN   Device ID (number).
+//    unsigned int    deviceID          IN   Device ID (number).
 //    const amString &timeStampBuffer   IN   Time stamp.
 //    BYTE            payLoad[]         IN   Array of bytes with the data to be converted.
 //
@@ -499,7 +457,7 @@ amDeviceType antHRMProcessing::processHRMSensorSemiCooked
 amDeviceType antHRMProcessing::processSensor
 (
     int             deviceType,
-    const amString &deviceIDNo,
+    unsigned int    deviceIDNo,
     const amString &timeStampBuffer,
     BYTE            payLoad[]
 )
@@ -515,7 +473,7 @@ amDeviceType antHRMProcessing::processSensor
         resetOutBuffer();
         if ( outputUnknown )
         {
-            int deviceIDNoAsInt = deviceIDNo.toInt();
+            int deviceIDNoAsInt = ( int ) deviceIDNo;
             createUnknownDeviceTypeString( deviceType, deviceIDNoAsInt, timeStampBuffer, payLoad );
         }
     }
@@ -587,117 +545,3 @@ void antHRMProcessing::readDeviceFileLine
     }
 }
 
-void antHRMProcessing::createHRMResultString
-(
-    unsigned int dataPage,
-    unsigned int heartRate,
-    unsigned int deltaHeartBeatEventTime,
-    unsigned int deltaHeartBeatCount,
-    double       totalHeartBeatEventTime,
-    unsigned int totalHeartBeatCount,
-    unsigned int additionalData1,
-    unsigned int additionalData2,
-    unsigned int additionalData3,
-    double       additionalDoubleData1
-)
-{
-    int dataPageMod128 = dataPage & 0x0F;
-    if ( outputAsJSON )
-    {
-        appendJSONItem( "heart rate", heartRate );
-        if ( semiCookedOut )
-        {
-            appendJSONItem( "delta heart beat event time", deltaHeartBeatEventTime );
-            appendJSONItem( "delta heart beat count",      deltaHeartBeatCount );
-        }
-        else
-        {
-            appendJSONItem( "total heart beat event time", totalHeartBeatEventTime, getValuePrecision() );
-            appendJSONItem( "total heart beat count",      totalHeartBeatCount );
-        }
-        appendJSONItem( C_DATA_PAGE_JSON, dataPage );
-        if ( dataPageMod128 == 1 )
-        {
-            if ( semiCookedOut )
-            {
-                appendJSONItem( "delta operating time", additionalData1 );
-            }
-            else
-            {
-                appendJSONItem( "operating time", 2 * additionalData1 );
-            }
-        }
-        else if ( dataPageMod128 == 2 )
-        {
-            appendJSONItem( C_MANUFACTURER_JSON,  additionalData1 );
-            appendJSONItem( C_SERIAL_NUMBER_JSON, additionalData2 );
-        }
-        else if ( dataPageMod128 == 3 )
-        {
-            appendJSONItem( C_MANUFACTURER_JSON,      additionalData1 );
-            appendJSONItem( C_HARDWARE_REVISION_JSON, additionalData2 );
-            appendJSONItem( C_MODEL_NUMBER_JSON,      additionalData3 );
-        }
-        else if ( dataPageMod128 == 4 )
-        {
-            if ( semiCookedOut )
-            {
-                appendJSONItem( "delta previous valid heart beat event time", additionalData1 );
-            }
-            else
-            {
-                appendJSONItem( "previous valid heart beat event time", additionalDoubleData1, getValuePrecision() );
-            }
-            appendJSONItem( "manufacturer specific data", additionalData2 );
-        }
-    }
-    else
-    {
-        if ( semiCookedOut )
-        {
-            appendOutput( heartRate );
-            appendOutput( deltaHeartBeatEventTime );
-            appendOutput( deltaHeartBeatCount );
-            appendOutput( dataPage );
-
-            if ( ( dataPageMod128 == 1 ) || ( dataPageMod128 == 2 ) || ( dataPageMod128 == 3 ) || ( dataPageMod128 == 4 ) )
-            {
-                appendOutput( additionalData1 ); //  deltaOperatingTime (1) / manufacturerID (2) / hwVersion (3) // deltaPrevHeartBeatEventTime (4)
-                if ( ( dataPageMod128 == 2 ) || ( dataPageMod128 == 3 ) || ( dataPageMod128 == 4 ) )
-                {
-                    appendOutput( additionalData2 ); //  serialNumber (2) / swVersion (3) / manufacturerSpecificData (4)
-                    if ( dataPageMod128 == 3 )
-                    {
-                        appendOutput( additionalData3 ); //  modelNumber (3)
-                    }
-                }
-            }
-        }
-        else
-        {
-            appendOutput( heartRate );
-            appendOutput( totalHeartBeatCount );
-            appendOutput( totalHeartBeatEventTime, 3 );
-            appendOutput( dataPage );
-            if ( dataPageMod128 == 1 )
-            {
-                appendOutput( 2 * additionalData1 );                         // operatingTimeSeconds
-            }
-            else if ( ( dataPageMod128 == 2 ) || ( dataPageMod128 == 3 ) )
-            {
-                appendOutput( additionalData1 );                             //  manufacturerID (2) / hwVersion (3)
-                appendOutput( additionalData2 );                             //  serialNumber (2)   / swVersion (3)
-                if ( dataPageMod128 == 3 )
-                {
-                    appendOutput( additionalData3 );                         //  modelNumber (3)
-                }
-            }
-            else if ( dataPageMod128 == 4 )
-            {
-                appendOutput( additionalDoubleData1, getTimePrecision() );   //  prevHeartBeatEventTime
-                appendOutput( additionalData2 );                             //  manufacturerSpecificData
-            }
-        }
-    }
-}
-
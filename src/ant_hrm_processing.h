@@ -7,15 +7,15 @@ class antHRMProcessing : virtual public antProcessing
 {
     private:
 
-        std::map<amString, bool>         heartRateSensorTable;
-        std::map<amString, unsigned int> previousHeartRateTable;
-        std::map<amString, unsigned int> eventTimeTable;
-        std::map<amString, double>       heartBeatTimeTable;
+        antSensorField<bool>         heartRateSensorTable;
+        antSensorField<unsigned int> previousHeartRateTable;
+        antSensorField<unsigned int> eventTimeTable;
+        antSensorField<double>       heartBeatTimeTable;
 
 
     protected:
 
-        amDeviceType processHRMSensor( const amString &deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
+        amDeviceType processHRMSensor( unsigned int deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
         amDeviceType processHRMSensorSemiCooked( const amString &inputBuffer );
 
         virtual void readDeviceFileLine( const char *line );
@@ -30,24 +30,11 @@ class antHRMProcessing : virtual public antProcessing
         bool appendHRMSensor   ( const amString &deviceName );
         bool isRegisteredSensor( const amString &deviceID );
 
-        virtual amDeviceType processSensor( int deviceType, const amString &deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
+        virtual amDeviceType processSensor( int deviceType, unsigned int deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
         virtual amDeviceType processSensorSemiCooked( const amString &inputBuffer );
 
         virtual void reset( void );
-
-        void createHRMResultString
-             (
-                 unsigned int dataPage,
-                 unsigned int heartRate,
-                 unsigned int deltaHeartBeatEventTime,
-                 unsigned int deltaHeartBeatCount,
-                 double       totalHeartBeatEventTime,
-                 unsigned int totalHeartBeatCount,
-                 unsigned int additionalData1,
-                 unsigned int additionalData2,
-                 unsigned int additionalData3,
-                 double       additionalDoubleData1
-             );
+        virtual antProcessing *createWorker( void ) const { return new antHRMProcessing; }
 
 };
 
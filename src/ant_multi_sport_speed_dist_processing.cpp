@@ -3,8 +3,6 @@
 #include "am_split_string.h"
 #include "ant_multi_sport_speed_dist_processing.h"
 
-const double C_SSU_2_DEG = 1.34110450744628906250E-6;
-
 
 // -------------------------------------------------------------------------------------------------------------------------
 // -------------------------------------------------------------------------------------------------------------------------
@@ -22,7 +20,9 @@ const double C_SSU_2_DEG = 1.34110450744628906250E-6;
 antMultiSportProcessing::antMultiSportProcessing
 (
     void
-) : antProcessing()
+) : antProcessing(),
+    totalDistTable( sensorStates, &antSensorState::multiSportTotalDist, SS_MULTI_SPORT_TOTAL_DIST ),
+    eventDistTable( sensorStates, &antSensorState::multiSportEventDist, SS_MULTI_SPORT_EVENT_DIST )
 {
     setCurrentDeviceType( "MULTI" );
     reset();
@@ -64,25 +64,21 @@ bool antMultiSportProcessing::appendMultiSportSensor
 //-------------------------------------------------------------------------------------------------//
 amDeviceType antMultiSportProcessing::processMultiSportSpeedAndDistanceSensor
 (
-    const amString &deviceIDNo,
+    unsigned int    deviceIDNo,
     const amString &timeStampBuffer,
     BYTE            payLoad[]
 )
 {
-    amDeviceType result                = OTHER_DEVICE;
-    amString     sensorID              = amString( C_MSSDM_DEVICE_HEAD ) + deviceIDNo;
-    unsigned int dataPage              = 0;
-    unsigned int auxInt1               = 0;
-    unsigned int auxInt2               = 0;
-    unsigned int additionalData1       = 0;
-    unsigned int additionalData2       = 0;
-    unsigned int additionalData3       = 0;
-    double       additionalDoubleData1 = 0;
-    double       additionalDoubleData2 = 0;
-    unsigned int rollOver              = 0;
-    bool         rollOverHappened      = false;
-    bool         commonPage            = false;
-    bool         outputPageNo          = true;
+    amDeviceType        result           = OTHER_DEVICE;
+    antSensorHandle     sensorID         = sensorStates.intern( C_MSSDM_DEVICE_HEAD, deviceIDNo );
+    unsigned int        dataPage         = 0;
+    unsigned int        auxInt1          = 0;
+    unsigned int        auxInt2          = 0;
+    unsigned int        rollOver         = 0;
+    bool                rollOverHappened = false;
+    bool                commonPage       = false;
+    bool                outputPageNo     = true;
+    antMultiSportRecord record           = antMultiSportRecord();
 
     if ( isRegisteredDevice( sensorID ) )
     {
@@ -98,82 +94,88 @@ amDeviceType antMultiSportProcessing::processMultiSportSpeedAndDistanceSensor
 
                      auxInt1         = byte2UInt( payLoad[ 3 ], payLoad[ 2 ] );    // Time Stamp
                      rollOver        = 65536;  // 256^2
-                     additionalData1 = getDeltaInt( rollOverHappened, sensorID, rollOver, eventTimeTable, auxInt1 );
+                     record.value1   = getDeltaInt( rollOverHappened, sensorID, rollOver, eventTimeTable, auxInt1 );
                      if ( !semiCookedOut )
                      {
-                         additionalDoubleData1      = totalTimeTable[ sensorID ] + ( double ) ( additionalData1 ) / 1024.0;
-                         totalTimeTable[ sensorID ] = additionalDoubleData1;
+                         record.totalTime           = totalTimeTable[ sensorID ] + ( double ) ( record.value1 ) / 1024.0;
+                         totalTimeTable[ sensorID ] = record.totalTime;
                      }
                      if ( diagnostics )
                      {
                          appendDiagnosticsLine( "Time Stamp", payLoad[ 3 ], payLoad[ 2 ], auxInt1 );
-                         appendDiagnosticsLine( "Delta Time Stamp", additionalData1 );
+                         appendDiagnosticsLine( "Delta Time Stamp", record.value1 );
                          if ( !semiCookedOut )
                          {
-                             appendDiagnosticsLine( "Total Time Stamp", additionalDoubleData1 );
+                             appendDiagnosticsLine( "Total Time Stamp", record.totalTime );
                          }
                      }
 
                      auxInt2         = byte2UInt( payLoad[ 5 ], payLoad[ 4 ] );    // Distance
                      rollOver        = 65536;  // 256^2
-                     additionalData2 = getDeltaInt( rollOverHappened, sensorID, rollOver, eventDistTable, auxInt2 );
+                     record.value2   = getDeltaInt( rollOverHappened, sensorID, rollOver, eventDistTable, auxInt2 );
                      if ( !semiCookedOut )
                      {
-                         additionalDoubleData2      = totalDistTable[ sensorID ] + ( double ) ( additionalData2 ) / 10.0;
-                         totalTimeTable[ sensorID ] = additionalDoubleData2;
+                         // Sic: the total distance is stored as the total time, the total distance stays 0.
+                         record.totalDistance       = totalDistTable[ sensorID ] + ( double ) ( record.value2 ) / 10.0;
+                         totalTimeTable[ sensorID ] = record.totalDistance;
                      }
                      if ( diagnostics )
                      {
                          appendDiagnosticsLine( "Distance Stamp", payLoad[ 5 ], payLoad[ 4 ], auxInt2 );
-                         appendDiagnosticsLine( "Delta Distance Stamp", additionalData2 );
+                         appendDiagnosticsLine( "Delta Distance Stamp", record.value2 );
                          if ( !semiCookedOut )
                          {
-                             appendDiagnosticsLine( "Total Distance Stamp", additionalDoubleData2 );
+                             appendDiagnosticsLine( "Total Distance Stamp", record.totalDistance );
                          }
                      }
 
-                     additionalData3 = byte2UInt( payLoad[ 7 ], payLoad[ 6 ] );    // Instantaneous Speed
+                     record.value3   = byte2UInt( payLoad[ 7 ], payLoad[ 6 ] );    // Instantaneous Speed
                      if ( diagnostics )
                      {
-                         appendDiagnosticsLine( "Instantaneous Speed", payLoad[ 7 ], payLoad[ 6 ], additionalData3 );
+                         appendDiagnosticsLine( "Instantaneous Speed", payLoad[ 7 ], payLoad[ 6 ], record.value3 );
                      }
                      break;
 
             case  2: result          = MULTI_SPORT_SD_SENSOR;
                      auxInt1         = byte2UInt( payLoad[ 4 ], payLoad[ 3 ], payLoad[ 2 ], payLoad[ 1 ] );          // Latitude
                      auxInt2         = byte2UInt( payLoad[ 7 ], payLoad[ 6 ], payLoad[ 5 ], payLoad[ 4 ] );          // Longitude
-                     additionalData1 = ( auxInt1 << 4 ) >> 4;
-                     additionalData2 = auxInt2 >> 4;
+                     record.value1   = ( auxInt1 << 4 ) >> 4;
+                     record.value2   = auxInt2 >> 4;
                      if ( diagnostics )
                      {
                          appendDiagnosticsLine( "Latitude", payLoad[ 4 ], payLoad[ 3 ], payLoad[ 2 ], payLoad[ 1 ],
-                                                additionalData1, " (Byte 1: first 4 bits)" );
+                                                record.value1, " (Byte 1: first 4 bits)" );
                          appendDiagnosticsLine( "Longitude", payLoad[ 7 ], payLoad[ 6 ], payLoad[ 5 ], payLoad[ 4 ],
-                                                additionalData2, " (Byte 4: last 4 bits)" );
+                                                record.value2, " (Byte 4: last 4 bits)" );
                      }
                      break;
 
             case  3: result          = MULTI_SPORT_SD_SENSOR;
                      auxInt1         = byte2UInt( payLoad[ 4 ] );
-                     additionalData1 = ( auxInt1 << 4 ) >> 4;                          // Fix Type
+                     record.value1   = ( auxInt1 << 4 ) >> 4;                          // Fix Type
                      auxInt2         = byte2UInt( payLoad[ 5 ], payLoad[ 4 ] );
-                     additionalData2 = auxInt2 >> 4;                                   // Heading
-                     additionalData3 = byte2UInt( payLoad[ 7 ], payLoad[ 6 ] );          // Elevation
+                     record.value2   = auxInt2 >> 4;                                   // Heading
+                     record.value3   = byte2UInt( payLoad[ 7 ], payLoad[ 6 ] );          // Elevation
+                     if ( !semiCookedOut )
+                     {
+                         record.heading = convertTemp10( record.value2 );
+                     }
                      if ( diagnostics )
                      {
-                         appendDiagnosticsLine( "Fix Type",  payLoad[ 4 ],               additionalData1, " (bits 7-4)" );
-                         appendDiagnosticsLine( "Heading",   payLoad[ 5 ], payLoad[ 4 ], additionalData2, " Second Byte: (bits 3-0)" );
-                         appendDiagnosticsLine( "Elevation", payLoad[ 7 ], payLoad[ 6 ], additionalData3 );
+                         appendDiagnosticsLine( "Fix Type",  payLoad[ 4 ],               record.value1, " (bits 7-4)" );
+                         appendDiagnosticsLine( "Heading",   payLoad[ 5 ], payLoad[ 4 ], record.value2, " Second Byte: (bits 3-0)" );
+                         appendDiagnosticsLine( "Elevation", payLoad[ 7 ], payLoad[ 6 ], record.value3 );
                      }
                      break;
 
+            // Sic: never reached, the switch is on the lower 4 bits of the data page.
             case 48: result          = MULTI_SPORT_SD_SENSOR;
-                     additionalData1 = byte2UInt( payLoad[ 5 ] );                        // Mode
-                     additionalData2 = byte2UInt( payLoad[ 7 ], payLoad[ 6 ] );          // Scale Factor
+                     record.value1   = byte2UInt( payLoad[ 5 ] );                        // Mode
+                     record.value2   = byte2UInt( payLoad[ 7 ], payLoad[ 6 ] );          // Scale Factor
                      if ( diagnostics )
                      {
-                         appendDiagnosticsLine( "Mode",         payLoad[ 5 ],               additionalData1 );
-                         appendDiagnosticsLine( "Scale Factor", payLoad[ 7 ], payLoad[ 6 ], additionalData2 );
+                         appendDiagnosticsLine( "Mode",         payLoad[ 5 ],               record.value1 );
+                         appendDiagnosticsLine( "Scale Factor", payLoad[ 7 ], payLoad[ 6 ], record.value2 );
                      }
                      break;
 
@@ -185,10 +187,9 @@ amDeviceType antMultiSportProcessing::processMultiSportSpeedAndDistanceSensor
 
     if ( result == MULTI_SPORT_SD_SENSOR )
     {
-        createOutputHeader( sensorID, timeStampBuffer );
         if ( commonPage )
         {
-            commonPage = processCommonPages( sensorID, payLoad, outputPageNo );
+            commonPage = processCommonPages( sensorID, timeStampBuffer, getVersion(), payLoad, outputPageNo );
             if ( !commonPage )
             {
                 result = OTHER_DEVICE;
@@ -196,9 +197,9 @@ amDeviceType antMultiSportProcessing::processMultiSportSpeedAndDistanceSensor
         }
         else
         {
-            createMSSDMResultString ( dataPage, additionalData1, additionalData2, additionalData3, additionalDoubleData1, additionalDoubleData2 );
+            record.dataPage = dataPage;
+            outputRecord( antRecordContext( sensorID, timeStampBuffer, getVersion() ), record );
         }
-        appendOutputFooter( getVersion() );
     }
 
     return result;
@@ -209,23 +210,19 @@ amDeviceType antMultiSportProcessing::processMultiSportSpeedAndDistanceSensorSem
     const amString &inputBuffer
 )
 {
-    amDeviceType  result                = OTHER_DEVICE;
-    amString      sensorID;
-    amString      semiCookedString;
-    amString      timeStampBuffer;
-    amString      curVersion            = getVersion();
-    amSplitString words;
-    unsigned int  nbWords               = words.split( inputBuffer );
-    unsigned int  counter               = 0;
-    unsigned int  startCounter          = 0;
-    unsigned int  dataPage              = 0;
-    unsigned int  additionalData1       = 0;
-    unsigned int  additionalData2       = 0;
-    unsigned int  additionalData3       = 0;
-    double        additionalDoubleData1 = 0;
-    double        additionalDoubleData2 = 0;
-    bool          commonPage            = false;
-    bool          outputPageNo          = true;
+    amDeviceType        result       = OTHER_DEVICE;
+    amString            sensorID;
+    amString            semiCookedString;
+    amString            timeStampBuffer;
+    amString            curVersion   = getVersion();
+    amSplitString       words;
+    unsigned int        nbWords      = words.split( inputBuffer );
+    unsigned int        counter      = 0;
+    unsigned int        startCounter = 0;
+    unsigned int        dataPage     = 0;
+    bool                commonPage   = false;
+    bool                outputPageNo = true;
+    antMultiSportRecord record       = antMultiSportRecord();
 
     if ( nbWords > 5 )
     {
@@ -258,60 +255,62 @@ amDeviceType antMultiSportProcessing::processMultiSportSpeedAndDistanceSensorSem
                     case  1: if ( nbWords > 6 )
                              {
                                  result         = MULTI_SPORT_SD_SENSOR;
-                                 additionalData1            = words[ counter++ ].toUInt();                        //  4 - deltaTimeEvent
-                                 additionalDoubleData1      = totalTimeTable[ sensorID ] + ( double ) additionalData1 / 1024.0;
-                                 totalTimeTable[ sensorID ] = additionalDoubleData1;                              // Total Event Time
+                                 record.value1              = words[ counter++ ].toUInt();                        //  4 - deltaTimeEvent
+                                 record.totalTime           = totalTimeTable[ sensorID ] + ( double ) record.value1 / 1024.0;
+                                 totalTimeTable[ sensorID ] = record.totalTime;                                   // Total Event Time
 
-                                 additionalData2 = words[ counter++ ].toUInt();                                   //  5 - deltaDistEvent
-                                 additionalDoubleData2      = totalDistTable[ sensorID ] + ( double ) additionalData2 / 1024.0;
-                                 totalDistTable[ sensorID ] = additionalDoubleData2;                 // Total Event Dist
+                                 record.value2              = words[ counter++ ].toUInt();                        //  5 - deltaDistEvent
+                                 // Sic: the delta distance is divided by 1024 here and by 10 in the raw data.
+                                 record.totalDistance       = totalDistTable[ sensorID ] + ( double ) record.value2 / 1024.0;
+                                 totalDistTable[ sensorID ] = record.totalDistance;                               // Total Event Dist
 
-                                 additionalData3 = words[ counter++ ].toUInt();                                   //  6 - event speed
+                                 record.value3              = words[ counter++ ].toUInt();                        //  6 - event speed
                                  if ( diagnostics )
                                  {
-                                     appendDiagnosticsLine( "Delta Event Time", additionalData1 );
-                                     appendDiagnosticsLine( "Event Time", additionalDoubleData1 );
-                                     appendDiagnosticsLine( "Delta Event Dist", additionalData2 );
-                                     appendDiagnosticsLine( "Event Dist", additionalDoubleData2 );
-                                     appendDiagnosticsLine( "Event Speed", additionalData3 );
+                                     appendDiagnosticsLine( "Delta Event Time", record.value1 );
+                                     appendDiagnosticsLine( "Event Time", record.totalTime );
+                                     appendDiagnosticsLine( "Delta Event Dist", record.value2 );
+                                     appendDiagnosticsLine( "Event Dist", record.totalDistance );
+                                     appendDiagnosticsLine( "Event Speed", record.value3 );
                                  }
                              }
                              break;
                     case  2: if ( nbWords > 5 )
                              {
                                  result          = MULTI_SPORT_SD_SENSOR;
-                                 additionalData1 = words[ counter++ ].toUInt();                                   //  4 - latitude
-                                 additionalData2 = words[ counter++ ].toUInt();                                   //  5 - longitude
+                                 record.value1   = words[ counter++ ].toUInt();                                   //  4 - latitude
+                                 record.value2   = words[ counter++ ].toUInt();                                   //  5 - longitude
                                  if ( diagnostics )
                                  {
-                                     appendDiagnosticsLine( "latitudeSSU",  additionalData1 );
-                                     appendDiagnosticsLine( "longitudeSSU", additionalData2 );
+                                     appendDiagnosticsLine( "latitudeSSU",  record.value1 );
+                                     appendDiagnosticsLine( "longitudeSSU", record.value2 );
                                  }
                              }
                              break;
                     case  3: if ( nbWords > 6 )
                              {
                                  result          = MULTI_SPORT_SD_SENSOR;
-                                 additionalData1 = words[ counter++ ].toUInt();                                   //  4 - fix type
-                                 additionalData2 = words[ counter++ ].toUInt();                                   //  5 - heading
-                                 additionalData3 = words[ counter++ ].toUInt();                                   //  6 - elevation
+                                 record.value1   = words[ counter++ ].toUInt();                                   //  4 - fix type
+                                 record.value2   = words[ counter++ ].toUInt();                                   //  5 - heading
+                                 record.value3   = words[ counter++ ].toUInt();                                   //  6 - elevation
+                                 record.heading  = convertTemp10( record.value2 );
                                  if ( diagnostics )
                                  {
-                                     appendDiagnosticsLine( "Fix Type",        additionalData1 );
-                                     appendDiagnosticsLine( "Heading (int)",   additionalData2 );
-                                     appendDiagnosticsLine( "Elevation (int)", additionalData3 );
+                                     appendDiagnosticsLine( "Fix Type",        record.value1 );
+                                     appendDiagnosticsLine( "Heading (int)",   record.value2 );
+                                     appendDiagnosticsLine( "Elevation (int)", record.value3 );
                                  }
                              }
                              break;
                     case 48: if ( nbWords > 5 )
                              {
                                  result         = MULTI_SPORT_SD_SENSOR;
-                                 additionalData1 = words[ counter++ ].toUInt();                                   //  4 - mode
-                                 additionalData2 = words[ counter++ ].toUInt();                                   //  5 - scale factoe
+                                 record.value1   = words[ counter++ ].toUInt();                                   //  4 - mode
+                                 record.value2   = words[ counter++ ].toUInt();                                   //  5 - scale factoe
                                  if ( diagnostics )
                                  {
-                                     appendDiagnosticsLine( "Mode",               additionalData1 );
-                                     appendDiagnosticsLine( "Scale Factor (int)", additionalData2 );
+                                     appendDiagnosticsLine( "Mode",               record.value1 );
+                                     appendDiagnosticsLine( "Scale Factor (int)", record.value2 );
                                  }
                              }
                              break;
@@ -333,10 +332,9 @@ amDeviceType antMultiSportProcessing::processMultiSportSpeedAndDistanceSensorSem
                 appendDiagnosticsLine( "Version", curVersion );
             }
         }
-        createOutputHeader( sensorID, timeStampBuffer );
         if ( commonPage )
         {
-            commonPage = processCommonPagesSemiCooked( words, startCounter, outputPageNo );
+            commonPage = processCommonPagesSemiCooked( words, startCounter, curVersion, outputPageNo );
             if ( !commonPage )
             {
                 result = OTHER_DEVICE;
@@ -344,9 +342,9 @@ amDeviceType antMultiSportProcessing::processMultiSportSpeedAndDistanceSensorSem
         }
         else
         {
-            createMSSDMResultString( dataPage, additionalData1, additionalData2, additionalData3, additionalDoubleData1, additionalDoubleData2 );
+            record.dataPage = dataPage;
+            outputRecord( antRecordContext( sensorID, timeStampBuffer, curVersion ), record );
         }
-        appendOutputFooter( curVersion );
     }
     else if ( result == UNKNOWN_DEVICE )
     {
@@ -374,7 +372,7 @@ amDeviceType antMultiSportProcessing::processMultiSportSpeedAndDistanceSensorSem
 //
 // Parameters:
 //    int             deviceType        IN   Device type
-//    const amString &deviceID          IN   Device ID (number).
+//    unsigned int    deviceID          IN   Device ID (number).
 //    const amString &timeStampBuffer   IN   Time stamp.
 //    BYTE            payLoad[]         IN   Array of bytes with the data to be converted.
 //
@@ -386,7 +384,7 @@ amDeviceType antMultiSportProcessing::processMultiSportSpeedAndDistanceSensorSem
 amDeviceType antMultiSportProcessing::processSensor
 (
     int             deviceType,
-    const amString &deviceIDNo,
+    unsigned int    deviceIDNo,
     const amString &timeStampBuffer,
     BYTE            payLoad[]
 )
@@ -402,7 +400,7 @@ amDeviceType antMultiSportProcessing::processSensor
         resetOutBuffer();
         if ( outputUnknown )
         {
-            int deviceIDNoAsInt = deviceIDNo.toInt();
+            int deviceIDNoAsInt = ( int ) deviceIDNo;
             createUnknownDeviceTypeString( deviceType, deviceIDNoAsInt, timeStampBuffer, payLoad );
         }
     }
@@ -485,211 +483,6 @@ void antMultiSportProcessing::reset
     eventDistTable.clear();
 }
 
-void antMultiSportProcessing::createMSSDMResultString
-(
-    unsigned int dataPage,
-    unsigned int additionalData1,
-    unsigned int additionalData2,
-    unsigned int additionalData3,
-    double       additionalDoubleData1,
-    double       additionalDoubleData2
-)
-{
-    char auxBuffer[ C_MEDIUM_BUFFER_SIZE ] = { 0 };
-
-    if ( outputAsJSON )
-    {
-        appendJSONItem( "data page", dataPage );
-    }
-    else
-    {
-        appendOutput( dataPage );
-    }
-    if ( semiCookedOut )
-    {
-        if ( ( dataPage == 1 ) || ( dataPage == 3 ) )
-        {
-            if ( outputAsJSON )
-            {
-                if ( dataPage == 1 )
-                {
-                    appendJSONItem( "delta event time",     additionalData1 );
-                    appendJSONItem( "delta event distance", additionalData2 );
-                    appendJSONItem( "event speed",          additionalData3 );
-                }
-                else if ( dataPage == 3 )
-                {
-                    appendJSONItem( "fix type",  additionalData1 );
-                    appendJSONItem( "heading",   additionalData2 );
-                    appendJSONItem( "elevation", additionalData3 );
-                }
-            }
-            else
-            {
-                appendOutput( additionalData1 );
-                appendOutput( additionalData2 );
-                appendOutput( additionalData3 );
-            }
-        }
-        if ( ( dataPage == 2 ) || ( dataPage == 48 ) )
-        {
-            if ( outputAsJSON )
-            {
-                if ( dataPage == 2 )
-                {
-                    appendJSONItem( "latitude",  additionalData1 );
-                    appendJSONItem( "longitude", additionalData2 );
-                }
-                else if ( dataPage == 48 )
-                {
-                    appendJSONItem( "mode",         additionalData1 );
-                    appendJSONItem( "scale factor", additionalData2 );
-                }
-            }
-            else
-            {
-                appendOutput( additionalData1 );
-                appendOutput( additionalData2 );
-            }
-        }
-    }
-    else
-    {
-        if ( dataPage == 1 )
-        {
-            double speed = ( double ) additionalData3 / 1000.0;
-            if ( outputAsJSON )
-            {
-                appendJSONItem( "time",     additionalDoubleData1, 3 );
-                appendJSONItem( "distance", additionalDoubleData2, 1 );
-                appendJSONItem( "speed",    speed,                 3 );
-            }
-            else
-            {
-                appendOutput( "T" );
-                appendOutput( additionalDoubleData1, 3, "s" );
-                appendOutput( "D" );
-                appendOutput( additionalDoubleData2, 1, "m" );
-                appendOutput( "V" );
-                appendOutput( speed, 3, "km/h" );
-            }
-        }
-        else if ( dataPage == 2 )
-        {
-            int    latitudeSigned  = NEGATE_BINARY_INT( additionalData1, 28 );
-            int    longitudeSigned = NEGATE_BINARY_INT( additionalData2, 28 );
-            double latitude  = ( double ) latitudeSigned * C_SSU_2_DEG;
-            double longitude = ( double ) longitudeSigned * C_SSU_2_DEG;
-            if ( outputAsJSON )
-            {
-                appendJSONItem( "latitude",  latitude, getValuePrecision() );
-                appendJSONItem( "longitude", longitude, getValuePrecision() );
-            }
-            else
-            {
-                appendOutput( "LAT" );
-                appendOutput( latitude, 3, "deg" );
-                appendOutput( "LON" );
-                appendOutput( longitude, 3, "deg" );
-            }
-        }
-        else if ( dataPage == 3 )
-        {
-            double heading   = convertTemp10( additionalData2 );
-            double elevation = ( double ) additionalData3 / 5.0 - 500.0;
-
-            switch ( additionalData1 )
-            {
-                case  0: strcpy( auxBuffer, outputAsJSON ? "no fix" : "NO_FIX" );
-                         break;
-                case  1: strcpy( auxBuffer, outputAsJSON ? "searching" : "SEARCHING" );
-                         break;
-                case  2: strcpy( auxBuffer, outputAsJSON ? "propagating" : "PROPAGATING" );
-                         break;
-                case  3: strcpy( auxBuffer, outputAsJSON ? "last known position" : "LAST_KNOWN_POS" );
-                         break;
-                case  4: strcpy( auxBuffer, outputAsJSON ? "2d" : "2D" );
-                         break;
-                case  5: strcpy( auxBuffer, outputAsJSON ? "2d waas" : "2D_WAAS" );
-                         break;
-                case  6: strcpy( auxBuffer, outputAsJSON ? "2d differential" : "2D_DIFFERENTIAL" );
-                         break;
-                case  7: strcpy( auxBuffer, outputAsJSON ? "3d" : "3D" );
-                         break;
-                case  8: strcpy( auxBuffer, outputAsJSON ? "3d waas" : "3D_WAAS" );
-                         break;
-                case  9: strcpy( auxBuffer, outputAsJSON ? "3d differential" : "3D_DIFFERENTIAL" );
-                         break;
-                case 15: strcpy( auxBuffer, outputAsJSON ? C_INVALID_JSON : C_INVALID );
-                         break;
-                default: strcpy( auxBuffer, outputAsJSON ? C_UNUSED_JSON : C_UNUSED );
-                         break;
-            }
-            if ( outputAsJSON )
-            {
-                appendJSONItem( "fix type",  auxBuffer );
-                appendJSONItem( "heading",   heading,   2 );
-                appendJSONItem( "elevation", elevation, 1 );
-            }
-            else
-            {
-                appendOutput( "FIX_TYPE" );
-                appendOutput( auxBuffer );
-                appendOutput( "HEADING" );
-                appendOutput( heading, 2 );
-                appendOutput( "ELEV" );
-                appendOutput( elevation, 1 );
-            }
-        }
-        else if ( dataPage == 48 )
-        {
-            double scaleFactor = additionalData2 / 10000.0;
-            if ( outputAsJSON )
-            {
-                if ( additionalData1 == 0xFF )
-                {
-                    appendJSONItem( "mode", C_INVALID_JSON );
-                }
-                else
-                {
-                    appendJSONItem( "mode", additionalData1 );
-                }
-
-                if ( additionalData2 == 0xFFFF )
-                {
-                    appendJSONItem( "calibration request", true );
-                }
-                else
-                {
-                    appendJSONItem( "scale factor", scaleFactor, 5 );
-                }
-            }
-            else
-            {
-                appendOutput( "MODE" );
-                if ( additionalData1 == 0xFF )
-                {
-                    appendOutput( C_INVALID );
-                }
-                else
-                {
-                    appendOutput( additionalData1 );
-                }
-
-                if ( additionalData2 == 0xFFFF )
-                {
-                    appendOutput( "CALIBRATION_REQUEST" );
-                }
-                else
-                {
-                    appendOutput( "SCALE_FACTOR" );
-                    appendOutput( scaleFactor, 5 );
-                }
-            }
-        }
-    }
-}
-
 double antMultiSportProcessing::convertTemp10
 (
     int temp10
@@ -10,13 +10,13 @@ class antMultiSportProcessing : virtual public antProcessing
 
         double convertTemp10( int temp10 );
 
-        std::map<amString, double>       totalDistTable;
-        std::map<amString, unsigned int> eventDistTable;
+        antSensorField<double>       totalDistTable;
+        antSensorField<unsigned int> eventDistTable;
 
 
     protected:
 
-        amDeviceType processMultiSportSpeedAndDistanceSensor( const amString &deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
+        amDeviceType processMultiSportSpeedAndDistanceSensor( unsigned int deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
         amDeviceType processMultiSportSpeedAndDistanceSensorSemiCooked( const amString &inputBuffer );
 
         virtual void readDeviceFileLine( const char *line );
@@ -30,10 +30,11 @@ class antMultiSportProcessing : virtual public antProcessing
 
         bool isMultiSportSensor( const amString & );
 
-        virtual amDeviceType processSensor( int deviceType, const amString &deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
+        virtual amDeviceType processSensor( int deviceType, unsigned int deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
         virtual amDeviceType processSensorSemiCooked( const amString &inputBuffer );
 
         virtual void reset( void );
+        virtual antProcessing *createWorker( void ) const { return new antMultiSportProcessing; }
 
         void createMSSDMResultString
              (
@@ -0,0 +1,374 @@
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#endif
+
+#include "ant_perf_counters.h"
+
+const char *C_PERF_EVENT_NAMES[]  = { "cycles", "instructions", "branchMisses", "cacheMisses" };
+const char  C_PERF_NO_DEVICE_ID[] = "none";
+
+#ifdef __linux__
+const unsigned long long C_PERF_EVENT_CONFIGS[] = { PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_BRANCH_MISSES, PERF_COUNT_HW_CACHE_MISSES };
+#endif
+
+antPerfCounters::antPerfCounters
+(
+    void
+)
+{
+    opened      = false;
+    groupFD     = -1;
+    nbOpen      = 0;
+    timeEnabled = 0;
+    timeRunning = 0;
+    for ( int event = 0; event < NB_PERF_EVENTS; ++event )
+    {
+        eventFDs[ event ]    = -1;
+        readSlots[ event ]   = -1;
+        openErrors[ event ]  = 0;
+        startValues[ event ] = 0;
+    }
+    memset( slots, 0, sizeof( slots ) );
+}
+
+antPerfCounters::~antPerfCounters
+(
+    void
+)
+{
+    close();
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Open the events as a group of the calling thread: the first event which can be opened leads the
+// group, so the events are always counted together and read with a single read().
+//
+// -------------------------------------------------------------------------------------------------//
+void antPerfCounters::open
+(
+    void
+)
+{
+    opened = true;
+#ifdef __linux__
+    struct perf_event_attr attributes;
+
+    for ( int event = 0; event < NB_PERF_EVENTS; ++event )
+    {
+        memset( &attributes, 0, sizeof( attributes ) );
+        attributes.size           = sizeof( attributes );
+        attributes.type           = PERF_TYPE_HARDWARE;
+        attributes.config         = C_PERF_EVENT_CONFIGS[ event ];
+        attributes.read_format    = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        attributes.exclude_kernel = 1;
+        attributes.exclude_hv     = 1;
+
+        eventFDs[ event ] = syscall( __NR_perf_event_open, &attributes, 0, -1, groupFD, 0 );
+        if ( eventFDs[ event ] < 0 )
+        {
+            openErrors[ event ] = errno;
+            continue;
+        }
+        if ( groupFD < 0 )
+        {
+            groupFD = eventFDs[ event ];
+        }
+        readSlots[ event ] = nbOpen;
+        ++nbOpen;
+    }
+#else
+    for ( int event = 0; event < NB_PERF_EVENTS; ++event )
+    {
+        openErrors[ event ] = ENOSYS;
+    }
+#endif
+}
+
+void antPerfCounters::close
+(
+    void
+)
+{
+    for ( int event = 0; event < NB_PERF_EVENTS; ++event )
+    {
+        if ( eventFDs[ event ] >= 0 )
+        {
+            ::close( eventFDs[ event ] );
+            eventFDs[ event ] = -1;
+        }
+    }
+    groupFD = -1;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Read the events of the group into 'values' (indexed by antPerfEvent).
+//
+// -------------------------------------------------------------------------------------------------//
+bool antPerfCounters::readValues
+(
+    unsigned long long values[]
+)
+{
+    // Number of events, time enabled, time running, the values.
+    unsigned long long buffer[ 3 + NB_PERF_EVENTS ];
+    ssize_t            nbBytes = ( 3 + nbOpen ) * sizeof( buffer[ 0 ] );
+
+    if ( ( groupFD < 0 ) || ( read( groupFD, buffer, nbBytes ) != nbBytes ) )
+    {
+        return false;
+    }
+    timeEnabled = buffer[ 1 ];
+    timeRunning = buffer[ 2 ];
+    for ( int event = 0; event < NB_PERF_EVENTS; ++event )
+    {
+        values[ event ] = ( readSlots[ event ] < 0 ) ? 0 : buffer[ 3 + readSlots[ event ] ];
+    }
+    return true;
+}
+
+void antPerfCounters::begin
+(
+    void
+)
+{
+    if ( !opened )
+    {
+        open();
+    }
+    if ( !readValues( startValues ) )
+    {
+        memset( startValues, 0, sizeof( startValues ) );
+    }
+}
+
+void antPerfCounters::end
+(
+    int deviceType
+)
+{
+    unsigned long long values[ NB_PERF_EVENTS ];
+    slotCounts        &slot = slots[ ( ( deviceType >= 0 ) && ( deviceType < C_NB_DEVICE_TYPES ) ) ? deviceType : C_PERF_NO_DEVICE_TYPE ];
+
+    ++slot.nbPackets;
+    if ( readValues( values ) )
+    {
+        for ( int event = 0; event < NB_PERF_EVENTS; ++event )
+        {
+            slot.values[ event ] += values[ event ] - startValues[ event ];
+        }
+    }
+}
+
+antPerfCounterSet::antPerfCounterSet
+(
+    void
+)
+{
+    pthread_mutex_init( &mutex, NULL );
+}
+
+antPerfCounterSet::~antPerfCounterSet
+(
+    void
+)
+{
+    clear();
+    pthread_mutex_destroy( &mutex );
+}
+
+antPerfCounters *antPerfCounterSet::newPart
+(
+    void
+)
+{
+    antPerfCounters *part = new antPerfCounters;
+
+    pthread_mutex_lock( &mutex );
+    parts.push_back( part );
+    pthread_mutex_unlock( &mutex );
+    return part;
+}
+
+void antPerfCounterSet::clear
+(
+    void
+)
+{
+    pthread_mutex_lock( &mutex );
+    for ( size_t counter = 0; counter < parts.size(); ++counter )
+    {
+        delete parts[ counter ];
+    }
+    parts.clear();
+    pthread_mutex_unlock( &mutex );
+}
+
+bool antPerfCounterSet::isAvailable
+(
+    amString &reason
+) const
+{
+    bool result = true;
+
+    for ( size_t counter = 0; counter < parts.size(); ++counter )
+    {
+        const antPerfCounters *part = parts[ counter ];
+        if ( part->opened && ( part->nbOpen == 0 ) )
+        {
+            reason = strerror( part->openErrors[ 0 ] );
+            result = false;
+        }
+    }
+    return result;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Write the counts of all threads to 'fileName' (replaced) as a JSON object on a single line:
+// the events counted (an event counts if every thread which decoded packets could open it, else its
+// error is given), whether the kernel had to multiplex the counters (then they only count part of
+// the time) and, per device type and in total, the packets and the events (sums and per packet).
+//
+// -------------------------------------------------------------------------------------------------//
+int antPerfCounterSet::write
+(
+    const amString &fileName,
+    const amString &programName,
+    const char     *outputMode,
+    amString       &message
+) const
+{
+    std::ofstream                  outStream( fileName.c_str(), std::ios::out | std::ios::trunc );
+    antPerfCounters::slotCounts    total;
+    antPerfCounters::slotCounts    slot;
+    bool                           available[ NB_PERF_EVENTS ];
+    int                            openErrors[ NB_PERF_EVENTS ];
+    bool                           multiplexed = false;
+    bool                           isFirst     = true;
+
+    if ( outStream.fail() )
+    {
+        message += "Could not open hardware counter file \"";
+        message += fileName;
+        message += "\" for writing.\n";
+        return E_WRITE_FILE_NOT_OPEN;
+    }
+
+    memset( &total, 0, sizeof( total ) );
+    for ( int event = 0; event < NB_PERF_EVENTS; ++event )
+    {
+        available[ event ]  = true;
+        openErrors[ event ] = 0;
+    }
+    for ( size_t counter = 0; counter < parts.size(); ++counter )
+    {
+        const antPerfCounters *part = parts[ counter ];
+        if ( !part->opened )
+        {
+            continue;
+        }
+        for ( int event = 0; event < NB_PERF_EVENTS; ++event )
+        {
+            if ( !part->isAvailable( event ) )
+            {
+                available[ event ]  = false;
+                openErrors[ event ] = part->openErrors[ event ];
+            }
+        }
+        multiplexed = multiplexed || ( part->timeRunning < part->timeEnabled );
+    }
+
+    outStream.setf( std::ios::fixed );
+    outStream.precision( 3 );
+    outStream << "{\"program\":\"" << programName << "\",\"outputMode\":\"" << outputMode << "\",\"threads\":" << parts.size();
+    outStream << ",\"events\":{";
+    for ( int event = 0; event < NB_PERF_EVENTS; ++event )
+    {
+        outStream << ( ( event == 0 ) ? "\"" : ",\"" ) << C_PERF_EVENT_NAMES[ event ] << "\":";
+        if ( available[ event ] )
+        {
+            outStream << "true";
+        }
+        else
+        {
+            outStream << "\"" << strerror( openErrors[ event ] ) << "\"";
+        }
+    }
+    outStream << "},\"multiplexed\":" << ( multiplexed ? "true" : "false" );
+
+    outStream << ",\"deviceTypes\":{";
+    for ( int slotNo = 0; slotNo <= C_PERF_NB_SLOTS; ++slotNo )
+    {
+        if ( slotNo < C_PERF_NB_SLOTS )
+        {
+            memset( &slot, 0, sizeof( slot ) );
+            for ( size_t counter = 0; counter < parts.size(); ++counter )
+            {
+                const antPerfCounters::slotCounts &part = parts[ counter ]->slots[ slotNo ];
+                slot.nbPackets += part.nbPackets;
+                for ( int event = 0; event < NB_PERF_EVENTS; ++event )
+                {
+                    slot.values[ event ] += part.values[ event ];
+                }
+            }
+            if ( slot.nbPackets == 0 )
+            {
+                continue;
+            }
+            total.nbPackets += slot.nbPackets;
+            for ( int event = 0; event < NB_PERF_EVENTS; ++event )
+            {
+                total.values[ event ] += slot.values[ event ];
+            }
+            outStream << ( isFirst ? "\"" : ",\"" );
+            if ( slotNo == C_PERF_NO_DEVICE_TYPE )
+            {
+                outStream << C_PERF_NO_DEVICE_ID;
+            }
+            else
+            {
+                outStream << slotNo;
+            }
+            outStream << "\":";
+            isFirst = false;
+        }
+        else
+        {
+            slot = total;
+            outStream << "},\"total\":";
+        }
+
+        outStream << "{\"packets\":" << slot.nbPackets;
+        for ( int event = 0; event < NB_PERF_EVENTS; ++event )
+        {
+            if ( available[ event ] )
+            {
+                outStream << ",\"" << C_PERF_EVENT_NAMES[ event ] << "\":" << slot.values[ event ];
+                outStream << ",\"" << C_PERF_EVENT_NAMES[ event ] << "PerPacket\":" << ( ( slot.nbPackets == 0 ) ? 0.0 : ( double ) slot.values[ event ] / slot.nbPackets );
+            }
+        }
+        if ( available[ PERF_CYCLES ] && available[ PERF_INSTRUCTIONS ] )
+        {
+            outStream << ",\"ipc\":" << ( ( slot.values[ PERF_CYCLES ] == 0 ) ? 0.0 : ( double ) slot.values[ PERF_INSTRUCTIONS ] / slot.values[ PERF_CYCLES ] );
+        }
+        outStream << "}";
+    }
+    outStream << "}" << std::endl;
+
+    if ( outStream.fail() )
+    {
+        message += "Error while writing hardware counter file \"";
+        message += fileName;
+        message += "\".\n";
+        return E_WRITE_ERROR;
+    }
+    return 0;
+}
@@ -0,0 +1,123 @@
+#ifndef __ANT_PERF_COUNTERS_H__
+#define __ANT_PERF_COUNTERS_H__
+
+#include <pthread.h>
+#include <vector>
+
+#include "am_string.h"
+#include "ant_constants.h"
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Hardware performance counters (option '-Q'): CPU cycles, instructions, branch misses and cache
+// misses of the packet path (everything ant2txtLine() does after reading a packet, output
+// included), per device type.
+//
+// The counters of a thread are a perf_event_open() group of the calling thread, user space only,
+// opened with the first packet the thread decodes and read (a read() system call) before and after
+// every packet. Events the CPU, the kernel or the container does not allow are left out (e.g.
+// perf_event_paranoid > 2, seccomp, virtual machines without a PMU): then only the packets are
+// counted, and the result file tells which events are missing and why.
+//
+// Every decode thread counts into an antPerfCounters of its own, antPerfCounterSet adds them up.
+//
+// -------------------------------------------------------------------------------------------------//
+enum antPerfEvent
+{
+    PERF_CYCLES,
+    PERF_INSTRUCTIONS,
+    PERF_BRANCH_MISSES,
+    PERF_CACHE_MISSES,
+    NB_PERF_EVENTS
+};
+
+const int C_PERF_NO_DEVICE_TYPE = C_NB_DEVICE_TYPES;      // Packets without device type (e.g. semi-cooked input, bridge messages).
+const int C_PERF_NB_SLOTS       = C_NB_DEVICE_TYPES + 1;
+
+class antPerfCounters
+{
+
+    friend class antPerfCounterSet;
+
+    private:
+
+        struct slotCounts
+        {
+            unsigned long long nbPackets;
+            unsigned long long values[ NB_PERF_EVENTS ];
+        };
+
+        bool               opened;                          // Opening was tried (in the thread counting).
+        int                groupFD;
+        int                eventFDs  [ NB_PERF_EVENTS ];
+        int                readSlots [ NB_PERF_EVENTS ];    // Position of the event in a read of the group, -1: not available.
+        int                openErrors[ NB_PERF_EVENTS ];    // errno of perf_event_open() for events not available.
+        unsigned int       nbOpen;
+        unsigned long long timeEnabled;                     // Of the last read (ns).
+        unsigned long long timeRunning;
+        unsigned long long startValues[ NB_PERF_EVENTS ];
+        slotCounts         slots[ C_PERF_NB_SLOTS ];
+
+        void open( void );
+        void close( void );
+        bool readValues( unsigned long long values[] );
+
+        antPerfCounters( const antPerfCounters & );
+        antPerfCounters &operator=( const antPerfCounters & );
+
+
+    public:
+
+        antPerfCounters( void );
+        ~antPerfCounters( void );
+
+        // Read the counters at the start of a packet.
+        void begin( void );
+
+        // Count the packet started with begin() under 'deviceType' (C_PERF_NO_DEVICE_TYPE: none).
+        void end( int deviceType );
+
+        inline bool isAvailable( int event ) const { return readSlots[ event ] >= 0; }
+
+};
+
+// -------------------------------------------------------------------------------------------------//
+//
+// The counters of all threads (see newPart()), written to the result file at the end as a single
+// JSON object.
+//
+// -------------------------------------------------------------------------------------------------//
+class antPerfCounterSet
+{
+
+    private:
+
+        pthread_mutex_t                 mutex;
+        std::vector<antPerfCounters *>  parts;
+
+        antPerfCounterSet( const antPerfCounterSet & );
+        antPerfCounterSet &operator=( const antPerfCounterSet & );
+
+
+    public:
+
+        antPerfCounterSet( void );
+        ~antPerfCounterSet( void );
+
+        inline bool isEmpty( void ) const { return parts.empty(); }
+
+        // Counters for a thread, owned by the set.
+        antPerfCounters *newPart( void );
+
+        // Returns false if no hardware counter could be opened by a thread which counted packets
+        // ('reason' tells why).
+        bool isAvailable( amString &reason ) const;
+
+        // Write the counts of all threads, 'outputMode' is the output mode of the run.
+        int write( const amString &fileName, const amString &programName, const char *outputMode, amString &message ) const;
+
+        void clear( void );
+
+};
+
+#endif // __ANT_PERF_COUNTERS_H__
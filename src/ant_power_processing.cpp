@@ -23,7 +23,20 @@ antPowerProcessing::antPowerProcessing
 (
     void
 ) : antProcessing(),
-    antCadenceSpeedProcessing()
+    antCadenceSpeedProcessing(),
+    slope_Nm_10Hz_Table( sensorStates, &antSensorState::slope_Nm_10Hz, SS_SLOPE_NM_10HZ ),
+    offsetTable( sensorStates, &antSensorState::offset, SS_OFFSET ),
+    accumulatedPowerTable( sensorStates, &antSensorState::accumulatedPower, SS_ACCUMULATED_POWER ),
+    accumulatedTorqueTable( sensorStates, &antSensorState::accumulatedTorque, SS_ACCUMULATED_TORQUE ),
+    crankOrWheelPeriodTable( sensorStates, &antSensorState::crankOrWheelPeriod, SS_CRANK_OR_WHEEL_PERIOD ),
+    otherEventCountTable( sensorStates, &antSensorState::otherEventCount, SS_OTHER_EVENT_COUNT ),
+    otherAccumulatedPowerTable( sensorStates, &antSensorState::otherAccumulatedPower, SS_OTHER_ACCUMULATED_POWER ),
+    otherTotalCountTable( sensorStates, &antSensorState::otherTotalCount, SS_OTHER_TOTAL_COUNT ),
+    otherAccumulatedTorqueTable( sensorStates, &antSensorState::otherAccumulatedTorque, SS_OTHER_ACCUMULATED_TORQUE ),
+    otherCrankOrWheelPeriodTable( sensorStates, &antSensorState::otherCrankOrWheelPeriod, SS_OTHER_CRANK_OR_WHEEL_PERIOD ),
+    powerTable( sensorStates, &antSensorState::power, SS_POWER ),
+    torqueTable( sensorStates, &antSensorState::torque, SS_TORQUE ),
+    speedSensorTable( sensorStates, &antSensorState::speedSensor, SS_SPEED_SENSOR )
 {
     setMaxZeroTimeB10( C_MAX_ZERO_TIME_POWER_B10 );
     setMaxZeroTimeB11( C_MAX_ZERO_TIME_POWER_B11 );
@@ -220,13 +233,13 @@ bool antPowerProcessing::appendPowerSensor
     {
         if ( slope_Nm_10Hz_Table.count( sensorID ) == 0 )
         {
-            slope_Nm_10Hz_Table.insert ( std::pair<amString, unsigned int>( sensorID, 0 ) );
+            slope_Nm_10Hz_Table.insert ( sensorID, 0 );
         }
         slope_Nm_10Hz_Table[ sensorID ] = slope_Nm_10Hz;
 
         if ( offsetTable.count( sensorID ) == 0 )
         {
-            offsetTable.insert( std::pair<amString, unsigned int>( sensorID, 0 ) );
+            offsetTable.insert( sensorID, 0 );
         }
         offsetTable[ sensorID ] = offset;
 
@@ -240,64 +253,48 @@ bool antPowerProcessing::appendPowerSensor
 
 double antPowerProcessing::getPower
 (
-    const amString &sensorID
+    const antSensorHandle &sensorID
 )
 {
-    if ( powerTable.count( sensorID ) == 0 )
-    {
-        powerTable.insert( std::pair<amString, double>( sensorID, 0 ) );
-    }
     double power = powerTable[ sensorID ];
     return power;
 }
 
 void antPowerProcessing::setPower
 (
-    const amString &sensorID,
-    double          value
+    const antSensorHandle &sensorID,
+    double                 value
 )
 {
-    if ( powerTable.count( sensorID ) == 0 )
-    {
-        powerTable.insert( std::pair<amString, double>( sensorID, 0 ) );
-    }
     powerTable[ sensorID ] = value;
 }
 
 double antPowerProcessing::getTorque
 (
-    const amString &sensorID
+    const antSensorHandle &sensorID
 )
 {
-    if ( torqueTable.count( sensorID ) == 0 )
-    {
-        torqueTable.insert( std::pair<amString, double>( sensorID, 0 ) );
-    }
     double torque = torqueTable[ sensorID ];
     return torque;
 }
 
 void antPowerProcessing::setTorque
 (
-    const amString &sensorID,
-    double          value
+    const antSensorHandle &sensorID,
+    double                 value
 )
 {
-    if ( torqueTable.count( sensorID ) == 0 )
-    {
-        torqueTable.insert( std::pair<amString, double>( sensorID, 0 ) );
-    }
     torqueTable[ sensorID ] = value;
 }
 
 unsigned int antPowerProcessing::getOffset
 (
-    const amString &sensorID
+    const antSensorHandle &sensorID
 )
 {
     if ( offsetTable.count( sensorID ) == 0 )
     {
-        offsetTable.insert( std::pair<amString, unsigned int>( sensorID, offsetDefault ) );
+        offsetTable.insert( sensorID, offsetDefault );
     }
     unsigned int offset = offsetTable[ sensorID ];
     return offset;
@@ -305,12 +302,12 @@ unsigned int antPowerProcessing::getOffset
 
 unsigned int antPowerProcessing::getSlope_Nm_10Hz
 (
-    const amString &sensorID
+    const antSensorHandle &sensorID
 )
 {
     if ( slope_Nm_10Hz_Table.count( sensorID ) == 0 )
     {
-        slope_Nm_10Hz_Table.insert( std::pair<amString, unsigned int>( sensorID, slopeDefault ) );
+        slope_Nm_10Hz_Table.insert( sensorID, slopeDefault );
     }
     unsigned int slope_Nm_10Hz = slope_Nm_10Hz_Table[ sensorID ];
     return slope_Nm_10Hz;
@@ -325,7 +322,7 @@ unsigned int antPowerProcessing::getSlope_Nm_10Hz
 //
 // Parameters:
 //    int             deviceType        IN   Device type
-//    const amString &deviceID          IN   Device ID (number).
+//    unsigned int    deviceID          IN   Device ID (number).
 //    const amString &timeStampBuffer   IN   Time stamp.
 //    BYTE            payLoad[]         IN   Array of bytes with the data to be converted.
 //
@@ -336,7 +333,7 @@ unsigned int antPowerProcessing::getSlope_Nm_10Hz
 amDeviceType antPowerProcessing::processSensor
 (
     int             deviceType,
-    const amString &deviceIDNo,
+    unsigned int    deviceIDNo,
     const amString &timeStampBuffer,
     BYTE            payLoad[]
 )
@@ -349,7 +346,7 @@ amDeviceType antPowerProcessing::processSensor
     }
     else if ( outputUnknown )
     {
-        int deviceIDNoAsInt = deviceIDNo.toInt();
+        int deviceIDNoAsInt = ( int ) deviceIDNo;
         createUnknownDeviceTypeString( deviceType, deviceIDNoAsInt, timeStampBuffer, payLoad );
     }
     else
@@ -548,9 +545,9 @@ const unsigned int C_MAX_DELTA_EVENT_COUNT = 10;
 
 bool antPowerProcessing::isLeftCrankEvent
 (
-    const amString &sensorID,
-    unsigned int    newValue,
-    unsigned int    rollOver
+    const antSensorHandle &sensorID,
+    unsigned int           newValue,
+    unsigned int           rollOver
 )
 {
     bool         result           = false;
@@ -609,12 +606,11 @@ bool antPowerProcessing::isLeftCrankEvent
 //-------------------------------------------------------------------------------------------------//
 unsigned int antPowerProcessing::splitFormat137_B01
 (
-    const amString &inputBuffer,
-    amSplitString  &outWords
+    amSplitString &outWords
 )
 {
     unsigned int nbWords = 0;
-    if ( !inputBuffer.empty() )
+    if ( outWords.size() > 0 )
     {
         amSplitString inWords;
         bool          success    = false;
@@ -622,7 +618,9 @@ unsigned int antPowerProcessing::splitFormat137_B01
         unsigned int  subCounter = 0;
         amString      calibrationID;
 
-        nbWords = inWords.split( inputBuffer );
+        // The words of the line become the input, the result replaces them.
+        inWords.swap( outWords );
+        nbWords = inWords.size();
 
         if ( nbWords > 4 )
         {
@@ -720,16 +718,14 @@ bool antPowerProcessing::createB01ResultString
     const amSplitString &words
 )
 {
-    amString     sensorID;
-    amString     timeStampBuffer;
-    amString     semiCookedString;
-    amString     curVersion      = getVersion();
-    bool         result          = false;
-    unsigned int nbWords         = words.size();
-    unsigned int counter         = 0;
-    unsigned int calibrationID   = 0;
-    unsigned int additionalData1 = 0;
-    unsigned int additionalData2 = 0;
+    amString          sensorID;
+    amString          timeStampBuffer;
+    amString          semiCookedString;
+    amString          curVersion = getVersion();
+    bool              result     = false;
+    unsigned int      nbWords    = words.size();
+    unsigned int      counter    = 0;
+    antPowerB01Record record     = antPowerB01Record();
 
     if ( nbWords > 3 )
     {
@@ -744,12 +740,12 @@ bool antPowerProcessing::createB01ResultString
         }
         if ( ( semiCookedString == C_SEMI_COOKED_SYMBOL_AS_STRING ) && isPowerMeterCalibration( sensorID ) )
         {
-            calibrationID = words[ counter++ ].toUInt();                          // 3
+            record.calibrationID = words[ counter++ ].toUInt();                          // 3
             if ( diagnostics )
             {
-                appendDiagnosticsLine( "Calibration ID", calibrationID );
+                appendDiagnosticsLine( "Calibration ID", record.calibrationID );
             }
-            if ( calibrationID == C_CTF_CALIBRATION_MESSAGE_ID )                                // 16 = 0x10: Crank Torque Frequency (CTF) Power Sensor defined message
+            if ( record.calibrationID == C_CTF_CALIBRATION_MESSAGE_ID )                                // 16 = 0x10: Crank Torque Frequency (CTF) Power Sensor defined message
             {
                 // Take care of old format first...
                 if ( nbWords > 5 )
@@ -759,78 +755,78 @@ bool antPowerProcessing::createB01ResultString
                     {
                         if ( words[ counter ].isUnsignedInteger() )
                         {
-                            additionalData1 = words[ counter++ ].toUInt();
-                            additionalData2 = words[ counter++ ].toUInt();
+                            record.calibrationData1 = words[ counter++ ].toUInt();
+                            record.calibrationData2 = words[ counter++ ].toUInt();
                         }
                         else
                         {
-                            additionalData1 = words[ counter++ ].toUInt();
-                            additionalData2 = words[ counter++ ].toUInt();
+                            record.calibrationData1 = words[ counter++ ].toUInt();
+                            record.calibrationData2 = words[ counter++ ].toUInt();
                         }
                     }
                     else
                     {
-                        additionalData1 = words[ counter++ ].toUInt();
-                        additionalData2 = words[ counter++ ].toUInt();
+                        record.calibrationData1 = words[ counter++ ].toUInt();
+                        record.calibrationData2 = words[ counter++ ].toUInt();
                     }
 
                     if ( diagnostics )
                     {
-                        appendDiagnosticsLine( "CTF Defined ID", additionalData1 );
-                        appendDiagnosticsLine( "Message Value", additionalData2 );
+                        appendDiagnosticsLine( "CTF Defined ID", record.calibrationData1 );
+                        appendDiagnosticsLine( "Message Value", record.calibrationData2 );
                     }
                 }
             }
-            else if ( calibrationID == C_AUTO_ZERO_SUPPORT_MESSAGE_ID )                         //  18 = 0x12
+            else if ( record.calibrationID == C_AUTO_ZERO_SUPPORT_MESSAGE_ID )                         //  18 = 0x12
             {
                 // Old format == New format
                 if ( nbWords > 5 )
                 {
-                    result          = true;
-                    additionalData1 = words[ counter++ ].toUInt();                     // 4
-                    additionalData2 = words[ counter++ ].toUInt();                     // 5
+                    result                  = true;
+                    record.calibrationData1 = words[ counter++ ].toUInt();                     // 4
+                    record.calibrationData2 = words[ counter++ ].toUInt();                     // 5
                     if ( diagnostics )
                     {
-                        appendDiagnosticsLine( "Auto Zero Enable", additionalData1 );
-                        appendDiagnosticsLine( "Auto Zero Status", additionalData2 );
+                        appendDiagnosticsLine( "Auto Zero Enable", record.calibrationData1 );
+                        appendDiagnosticsLine( "Auto Zero Status", record.calibrationData2 );
                     }
                 }
             }
-            else if ( calibrationID == C_CALIBRATION_REQUEST_MANUAL_ZERO_ID )                   // 170 = 0xAA
+            else if ( record.calibrationID == C_CALIBRATION_REQUEST_MANUAL_ZERO_ID )                   // 170 = 0xAA
             {
                 result = true;
             }
-            else if ( calibrationID == C_CALIBRATION_REQUEST_AUTO_ZERO_ID )                     // 171 = 0xAB
+            else if ( record.calibrationID == C_CALIBRATION_REQUEST_AUTO_ZERO_ID )                     // 171 = 0xAB
             {
                 if ( nbWords > 4 )
                 {
-                    result          = true;
-                    additionalData1 = words[ counter++ ].toUInt();                     // 4
+                    result                  = true;
+                    record.calibrationData1 = words[ counter++ ].toUInt();                     // 4
                     if ( diagnostics )
                     {
-                        appendDiagnosticsLine( "Auto Zero Status", additionalData1 );
+                        appendDiagnosticsLine( "Auto Zero Status", record.calibrationData1 );
                     }
                 }
             }
-            else if ( ( calibrationID == C_CALIBRATION_RESPONSE_MANUAL_ZERO_SUCCESS_ID ) ||            // 172 = 0xAC
-                      ( calibrationID == C_CALIBRATION_RESPONSE_MANUAL_ZERO_FAIL_ID ) )                // 175 = 0xAF
+            else if ( ( record.calibrationID == C_CALIBRATION_RESPONSE_MANUAL_ZERO_SUCCESS_ID ) ||            // 172 = 0xAC
+                      ( record.calibrationID == C_CALIBRATION_RESPONSE_MANUAL_ZERO_FAIL_ID ) )                // 175 = 0xAF
             {
                 if ( nbWords > 5 )
                 {
-                    result          = true;
-                    additionalData1 = words[ counter++ ].toUInt();                     // 4
-                    additionalData2 = words[ counter++ ].toUInt();                     // 5
+                    result                  = true;
+                    record.calibrationData1 = words[ counter++ ].toUInt();                     // 4
+                    record.calibrationData2 = words[ counter++ ].toUInt();                     // 5
                     if ( diagnostics )
                     {
-                        appendDiagnosticsLine( "Auto Zero Status", additionalData1 );
-                        appendDiagnosticsLine( "Message Value", additionalData2 );
+                        appendDiagnosticsLine( "Auto Zero Status", record.calibrationData1 );
+                        appendDiagnosticsLine( "Message Value", record.calibrationData2 );
                     }
                 }
             }
-            else if ( ( calibrationID == C_CUSTOM_CALIBRATION_PARAMETER_REQUEST_ID ) ||             // 186 = 0xBA
-                      ( calibrationID == C_CUSTOM_CALIBRATION_PARAMETER_RESPONSE_ID ) ||            // 187 = 0xBB
-                      ( calibrationID == C_CUSTOM_CALIBRATION_PARAMETER_UPDATE_ID ) ||              // 188 = 0xBC
-                      ( calibrationID == C_CUSTOM_CALIBRATION_PARAMETER_UPDATE_RESPONSE_ID ) )      // 189 = 0xBD
+            else if ( ( record.calibrationID == C_CUSTOM_CALIBRATION_PARAMETER_REQUEST_ID ) ||             // 186 = 0xBA
+                      ( record.calibrationID == C_CUSTOM_CALIBRATION_PARAMETER_RESPONSE_ID ) ||            // 187 = 0xBB
+                      ( record.calibrationID == C_CUSTOM_CALIBRATION_PARAMETER_UPDATE_ID ) ||              // 188 = 0xBC
+                      ( record.calibrationID == C_CUSTOM_CALIBRATION_PARAMETER_UPDATE_RESPONSE_ID ) )      // 189 = 0xBD
             {
                 result = true;
             }
@@ -847,110 +843,104 @@ bool antPowerProcessing::createB01ResultString
                 appendDiagnosticsLine( "Version", curVersion );
             }
         }
-        createOutputHeader( sensorID, timeStampBuffer );
-        createPWRB01ResultString( calibrationID, additionalData1, additionalData2 );
-        appendOutputFooter( curVersion );
+        outputRecord( antRecordContext( sensorID, timeStampBuffer, curVersion ), record );
     }
     return result;
 }
 
 amDeviceType antPowerProcessing::processPowerMeterB01
 (
-    const amString &deviceIDNo,
+    unsigned int    deviceIDNo,
     const amString &timeStampBuffer,
     BYTE            payLoad[]
 )
 {
-    amDeviceType result          = OTHER_DEVICE;
-    amString     sensorID        = amString( C_PM_CALIBRATION_HEAD ) + deviceIDNo;
-    unsigned int auxInt          = 0;
-    unsigned int calibrationID   = 0;
-    unsigned int additionalData1 = 0;
-    unsigned int additionalData2 = 0;
-
-    calibrationID = byte2UInt( payLoad[ 1 ] );
+    amDeviceType      result   = OTHER_DEVICE;
+    antSensorHandle   sensorID = sensorStates.intern( C_PM_CALIBRATION_HEAD, deviceIDNo );
+    antPowerB01Record record   = antPowerB01Record();
+    unsigned int      auxInt   = 0;
+
+    record.calibrationID = byte2UInt( payLoad[ 1 ] );
     if ( diagnostics )
     {
-        appendDiagnosticsLine( "\nCalibration ID", payLoad[ 1 ], calibrationID );
+        appendDiagnosticsLine( "\nCalibration ID", payLoad[ 1 ], record.calibrationID );
     }
 
-    if ( calibrationID == C_CTF_CALIBRATION_MESSAGE_ID )                                   //  16 = 0x10
+    if ( record.calibrationID == C_CTF_CALIBRATION_MESSAGE_ID )                                   //  16 = 0x10
     {
         // Crank Torque Frequency (CTF) Power Sensor defined message
-        result          = POWER_METER;
-        additionalData1 = byte2UInt( payLoad[ 2 ] );   // CTF Defined ID
+        result                  = POWER_METER;
+        record.calibrationData1 = byte2UInt( payLoad[ 2 ] );   // CTF Defined ID
         if ( diagnostics )
         {
-            appendDiagnosticsLine( "CTF Defined ID", payLoad[ 2 ], additionalData1 );
+            appendDiagnosticsLine( "CTF Defined ID", payLoad[ 2 ], record.calibrationData1 );
         }
 
-        if ( ( additionalData1 == 1 ) || ( additionalData1 == 2 ) || ( additionalData1 == 3 ) )
+        if ( ( record.calibrationData1 == 1 ) || ( record.calibrationData1 == 2 ) || ( record.calibrationData1 == 3 ) )
         {
-            additionalData2 = byte2UInt( payLoad[ 6 ], payLoad[ 7 ] );    // Message Value
+            record.calibrationData2 = byte2UInt( payLoad[ 6 ], payLoad[ 7 ] );    // Message Value
             if ( diagnostics )
             {
-                appendDiagnosticsLine( "Message Value", payLoad[ 7 ], payLoad[ 6 ], additionalData2 );
+                appendDiagnosticsLine( "Message Value", payLoad[ 7 ], payLoad[ 6 ], record.calibrationData2 );
             }
         }
-        else if ( additionalData1 == 172 )
+        else if ( record.calibrationData1 == 172 )
         {
-            additionalData2 = byte2UInt( payLoad[ 3 ] );   // CTF Acknowledge Message
+            record.calibrationData2 = byte2UInt( payLoad[ 3 ] );   // CTF Acknowledge Message
             if ( diagnostics )
             {
-                appendDiagnosticsLine( "CTF Acknowledge Message", payLoad[ 3 ], additionalData2 );
+                appendDiagnosticsLine( "CTF Acknowledge Message", payLoad[ 3 ], record.calibrationData2 );
             }
         }
     }
-    else if ( calibrationID == C_AUTO_ZERO_SUPPORT_MESSAGE_ID )                            //  18 = 0x12
+    else if ( record.calibrationID == C_AUTO_ZERO_SUPPORT_MESSAGE_ID )                            //  18 = 0x12
     {
-        result          = POWER_METER;
-        auxInt          = byte2UInt( payLoad[ 2 ] );
-        additionalData1 = auxInt & 1;     // Auto Zero Enable
-        additionalData2 = auxInt & 2;     // Auto Zero Status
+        result                  = POWER_METER;
+        auxInt                  = byte2UInt( payLoad[ 2 ] );
+        record.calibrationData1 = auxInt & 1;     // Auto Zero Enable
+        record.calibrationData2 = auxInt & 2;     // Auto Zero Status
         if ( diagnostics )
         {
-            appendDiagnosticsLine( "Auto Zero Enable", additionalData1 );
-            appendDiagnosticsLine( "Auto Zero Status", additionalData2 );
+            appendDiagnosticsLine( "Auto Zero Enable", record.calibrationData1 );
+            appendDiagnosticsLine( "Auto Zero Status", record.calibrationData2 );
         }
     }
-    else if ( ( calibrationID == C_CALIBRATION_REQUEST_MANUAL_ZERO_ID ) ||                   // 170 = 0xAA
-              ( calibrationID == C_CUSTOM_CALIBRATION_PARAMETER_REQUEST_ID ) ||              // 186 = 0xBA
-              ( calibrationID == C_CUSTOM_CALIBRATION_PARAMETER_RESPONSE_ID ) ||             // 187 = 0xBB
-              ( calibrationID == C_CUSTOM_CALIBRATION_PARAMETER_UPDATE_ID ) ||               // 188 = 0xBC
-              ( calibrationID == C_CUSTOM_CALIBRATION_PARAMETER_UPDATE_RESPONSE_ID ) )       // 189 = 0xBD
+    else if ( ( record.calibrationID == C_CALIBRATION_REQUEST_MANUAL_ZERO_ID ) ||                   // 170 = 0xAA
+              ( record.calibrationID == C_CUSTOM_CALIBRATION_PARAMETER_REQUEST_ID ) ||              // 186 = 0xBA
+              ( record.calibrationID == C_CUSTOM_CALIBRATION_PARAMETER_RESPONSE_ID ) ||             // 187 = 0xBB
+              ( record.calibrationID == C_CUSTOM_CALIBRATION_PARAMETER_UPDATE_ID ) ||               // 188 = 0xBC
+              ( record.calibrationID == C_CUSTOM_CALIBRATION_PARAMETER_UPDATE_RESPONSE_ID ) )       // 189 = 0xBD
     {
         result = POWER_METER;
     }
-    else if ( calibrationID == C_CALIBRATION_REQUEST_AUTO_ZERO_ID )                        // 171 = 0xAB
+    else if ( record.calibrationID == C_CALIBRATION_REQUEST_AUTO_ZERO_ID )                        // 171 = 0xAB
     {
-        result          = POWER_METER;
-        additionalData1 = byte2UInt( payLoad[ 2 ] );    // Auto Zero Status
+        result                  = POWER_METER;
+        record.calibrationData1 = byte2UInt( payLoad[ 2 ] );    // Auto Zero Status
         if ( diagnostics )
         {
-            appendDiagnosticsLine( "Auto Zero Status", payLoad[ 2 ], additionalData1 );
+            appendDiagnosticsLine( "Auto Zero Status", payLoad[ 2 ], record.calibrationData1 );
         }
     }
-    else if ( ( calibrationID == C_CALIBRATION_RESPONSE_MANUAL_ZERO_SUCCESS_ID ) ||         // 172 = 0xAC
-              ( calibrationID == C_CALIBRATION_RESPONSE_MANUAL_ZERO_FAIL_ID ) )             // 175 = 0xAF
+    else if ( ( record.calibrationID == C_CALIBRATION_RESPONSE_MANUAL_ZERO_SUCCESS_ID ) ||         // 172 = 0xAC
+              ( record.calibrationID == C_CALIBRATION_RESPONSE_MANUAL_ZERO_FAIL_ID ) )             // 175 = 0xAF
     {
-        result          = POWER_METER;
-        additionalData1 = byte2UInt( payLoad[ 2 ] );                  // Auto Zero Status
-        additionalData2 = byte2UInt( payLoad[ 7 ], payLoad[ 6 ] );    // Message Value
+        result                  = POWER_METER;
+        record.calibrationData1 = byte2UInt( payLoad[ 2 ] );                  // Auto Zero Status
+        record.calibrationData2 = byte2UInt( payLoad[ 7 ], payLoad[ 6 ] );    // Message Value
         if ( diagnostics )
         {
             char auxBuffer[ C_MEDIUM_BUFFER_SIZE ] = { 0 };
-            appendDiagnosticsLine( "Auto Zero Status", payLoad[ 2 ], additionalData1 );
-            int messageValue = NEGATE_BINARY_INT( additionalData2, 16 );
+            appendDiagnosticsLine( "Auto Zero Status", payLoad[ 2 ], record.calibrationData1 );
+            int messageValue = NEGATE_BINARY_INT( record.calibrationData2, 16 );
             sprintf( auxBuffer, "(signed: %d)", messageValue );
-            appendDiagnosticsLine( "Message Value", payLoad[ 7 ], payLoad[ 6 ], additionalData2, auxBuffer );
+            appendDiagnosticsLine( "Message Value", payLoad[ 7 ], payLoad[ 6 ], record.calibrationData2, auxBuffer );
         }
     }
 
     if ( result == POWER_METER )
     {
-        createOutputHeader( sensorID, timeStampBuffer );
-        createPWRB01ResultString( calibrationID, additionalData1, additionalData2 );
-        appendOutputFooter( getVersion() );
+        outputRecord( antRecordContext( sensorID, timeStampBuffer, getVersion() ), record );
     }
 
     return result;
@@ -976,13 +966,10 @@ amDeviceType antPowerProcessing::processPowerMeterB01SemiCooked
         bool          resultCreate = false;
         unsigned int  nbWords      = 0;
         amSplitString words;
-        if ( isSemiCookedFormat137( inputBuffer ) )
-        {
-            nbWords = splitFormat137_B01( inputBuffer, words );
-        }
-        else
+        nbWords = words.split( inputBuffer );
+        if ( isSemiCookedFormat137( words ) )
         {
-            nbWords = words.split( inputBuffer );
+            nbWords = splitFormat137_B01( words );
         }
 
         resultCreate = createB01ResultString( words );
@@ -1022,17 +1009,14 @@ amDeviceType antPowerProcessing::processPowerMeterB01SemiCooked
 // ---------------------------------------------------------------------------------------------------
 amDeviceType antPowerProcessing::processPowerMeterB02
 (
-    const amString &deviceIDNo,
+    unsigned int    deviceIDNo,
     const amString &timeStampBuffer,
     BYTE            payLoad[]
 )
 {
-    amDeviceType result          = OTHER_DEVICE;
-    amString     sensorID        = amString( C_PM_GET_SET_PARAM_HEAD ) + deviceIDNo;
-    unsigned int subPageNumber   = 0;
-    unsigned int additionalData1 = 0;
-    unsigned int additionalData2 = 0;
-    unsigned int additionalData3 = 0;
+    amDeviceType      result   = OTHER_DEVICE;
+    antSensorHandle   sensorID = sensorStates.intern( C_PM_GET_SET_PARAM_HEAD, deviceIDNo );
+    antPowerB02Record record   = antPowerB02Record();
 
     // ---------------------------------------------------------------
     // Payload
@@ -1040,32 +1024,30 @@ amDeviceType antPowerProcessing::processPowerMeterB02
     //   1   Subpage Number
     //   2-7 Subpage Defined Data
 
-    subPageNumber = byte2UInt( payLoad[ 1 ] );
+    record.subPage = byte2UInt( payLoad[ 1 ] );
     if ( diagnostics )
     {
-        appendDiagnosticsLine( "Sub Page Number", payLoad[ 2 ], subPageNumber );
+        appendDiagnosticsLine( "Sub Page Number", payLoad[ 2 ], record.subPage );
     }
 
-    if ( subPageNumber == 1 )
+    if ( record.subPage == 1 )
     {
         // Crank Parameters
-        result          = POWER_METER;
-        additionalData1 = byte2UInt( payLoad[ 4 ] );
-        additionalData2 = byte2UInt( payLoad[ 5 ] );
-        additionalData3 = byte2UInt( payLoad[ 6 ] );
+        result                    = POWER_METER;
+        record.crankLength        = byte2UInt( payLoad[ 4 ] );
+        record.sensorStatus       = byte2UInt( payLoad[ 5 ] );
+        record.sensorCapabilities = byte2UInt( payLoad[ 6 ] );
         if ( diagnostics )
         {
-            appendDiagnosticsLine( "Crank Length (int)", payLoad[ 4 ], additionalData1 );
-            appendDiagnosticsLine( "Sensor Status", payLoad[ 5 ], additionalData2 );
-            appendDiagnosticsLine( "Sensor Capabilities", payLoad[ 6 ], additionalData3 );
+            appendDiagnosticsLine( "Crank Length (int)", payLoad[ 4 ], record.crankLength );
+            appendDiagnosticsLine( "Sensor Status", payLoad[ 5 ], record.sensorStatus );
+            appendDiagnosticsLine( "Sensor Capabilities", payLoad[ 6 ], record.sensorCapabilities );
         }
     }
 
     if ( result == POWER_METER )
     {
-        createOutputHeader( sensorID, timeStampBuffer );
-        createPWRB02ResultString( subPageNumber, additionalData1, additionalData2, additionalData3 );
-        appendOutputFooter( getVersion() );
+        outputRecord( antRecordContext( sensorID, timeStampBuffer, getVersion() ), record );
     }
 
     return result;
@@ -1109,18 +1091,15 @@ bool antPowerProcessing::createB02ResultString
     const amSplitString &words
 )
 {
-    bool         result          = false;
-    bool         oldFormat       = false;
-    unsigned int nbWords         = words.size();
-    unsigned int counter         = 0;
-    unsigned int subPageNumber   = 0;
-    unsigned int additionalData1 = 0;
-    unsigned int additionalData2 = 0;
-    unsigned int additionalData3 = 0;
-    amString     curVersion      = getVersion();
-    amString     sensorID;
-    amString     timeStampBuffer;
-    amString     semiCookedString;
+    bool              result     = false;
+    bool              oldFormat  = false;
+    unsigned int      nbWords    = words.size();
+    unsigned int      counter    = 0;
+    antPowerB02Record record     = antPowerB02Record();
+    amString          curVersion = getVersion();
+    amString          sensorID;
+    amString          timeStampBuffer;
+    amString          semiCookedString;
 
     if ( nbWords > 3 )
     {
@@ -1135,10 +1114,10 @@ bool antPowerProcessing::createB02ResultString
         }
         if ( ( semiCookedString == C_SEMI_COOKED_SYMBOL_AS_STRING ) && isPowerMeterGetSetParameters( sensorID ) )
         {
-            subPageNumber = words[ counter++ ].toUInt();                         // 3
+            record.subPage = words[ counter++ ].toUInt();                         // 3
             if ( diagnostics )
             {
-                appendDiagnosticsLine( "Sub Page Number", subPageNumber );
+                appendDiagnosticsLine( "Sub Page Number", record.subPage );
             }
 
             if ( nbWords > 8 )
@@ -1151,20 +1130,20 @@ bool antPowerProcessing::createB02ResultString
                 counter   += 2;
             }
 
-            if ( subPageNumber == 1 )
+            if ( record.subPage == 1 )
             {
                 // Crank Parameters
                 if ( nbWords > 6 )
                 {
-                    result          = true;
-                    additionalData1 = words[ counter++ ].toUInt();            // 4 Crank Length (int)
-                    additionalData2 = words[ counter++ ].toUInt();            // 5 Sensor Status
-                    additionalData3 = words[ counter++ ].toUInt();            // 6 Sensor Capabilities
+                    result                    = true;
+                    record.crankLength        = words[ counter++ ].toUInt();      // 4 Crank Length (int)
+                    record.sensorStatus       = words[ counter++ ].toUInt();      // 5 Sensor Status
+                    record.sensorCapabilities = words[ counter++ ].toUInt();      // 6 Sensor Capabilities
                     if ( diagnostics )
                     {
-                        appendDiagnosticsLine( "Crank Length (int)", additionalData1 );
-                        appendDiagnosticsLine( "Sensor Status", additionalData2 );
-                        appendDiagnosticsLine( "Sensor Capabilities", additionalData3 );
+                        appendDiagnosticsLine( "Crank Length (int)", record.crankLength );
+                        appendDiagnosticsLine( "Sensor Status", record.sensorStatus );
+                        appendDiagnosticsLine( "Sensor Capabilities", record.sensorCapabilities );
                     }
                     if ( oldFormat )
                     {
@@ -1186,9 +1165,7 @@ bool antPowerProcessing::createB02ResultString
                 appendDiagnosticsLine( "Version", curVersion );
             }
         }
-        createOutputHeader( sensorID, timeStampBuffer );
-        createPWRB02ResultString( subPageNumber, additionalData1, additionalData2, additionalData3 );
-        appendOutputFooter( curVersion );
+        outputRecord( antRecordContext( sensorID, timeStampBuffer, curVersion ), record );
     }
 
     return result;
@@ -1206,27 +1183,22 @@ bool antPowerProcessing::createB02ResultString
 //-------------------------------------------------------------------------------------------------//
 amDeviceType antPowerProcessing::processPowerMeterB03
 (
-    const amString &deviceIDNo,
+    unsigned int    deviceIDNo,
     const amString &timeStampBuffer,
     BYTE            payLoad[]
 )
 {
-    unsigned int nbDataTypes      = 0;
-    unsigned int dataType         = 0;
-    unsigned int timeStampInt     = 0;
-    unsigned int rollOver         = 0;
-    unsigned int scaleFactor      = 0;
-    unsigned int value            = 0;
-    unsigned int deltaEventTime   = 0;
-    bool         rollOverHappened = false;
-    double       timeStampDbl     = 0;
-    amDeviceType result           = OTHER_DEVICE;
-    amString     sensorID         = amString( C_PM_MEASUREMENT_HEAD ) + deviceIDNo;
+    antPowerB03Record record           = antPowerB03Record();
+    unsigned int      timeStampInt     = 0;
+    unsigned int      rollOver         = 0;
+    bool              rollOverHappened = false;
+    amDeviceType      result           = OTHER_DEVICE;
+    antSensorHandle   sensorID         = sensorStates.intern( C_PM_MEASUREMENT_HEAD, deviceIDNo );
 
     if ( totalTimeTable.count( sensorID ) == 0 )
     {
-        totalTimeTable.insert( std::pair<amString, unsigned int>( sensorID, 0 ) );
-        eventTimeTable.insert( std::pair<amString, unsigned int>( sensorID, 0 ) );
+        totalTimeTable.insert( sensorID, 0 );
+        eventTimeTable.insert( sensorID, 0 );
     }
 
     // ---------------------------------------------------------------
@@ -1241,35 +1213,30 @@ amDeviceType antPowerProcessing::processPowerMeterB03
     //   6   Measurement Value LSB   \      Range:
     //   7   Measurement Value MSB   / -32768 to 32767
 
-    nbDataTypes                 = byte2UInt( payLoad[ 1 ] ) & 0x07;
-    dataType                    = byte2UInt( payLoad[ 2 ] );
-    scaleFactor                 = byte2UInt( payLoad[ 3 ] );
-    timeStampInt                = byte2UInt( payLoad[ 5 ], payLoad[ 4 ] );
-    rollOver                    = ( 1 << 16 );  // 2^16 = 256^2
-    deltaEventTime              = getDeltaInt( rollOverHappened, sensorID, rollOver, eventTimeTable, timeStampInt );
-    timeStampDbl                = totalTimeTable[ sensorID ];
-    timeStampDbl               += ( double ) deltaEventTime / 2048.0;
-    totalTimeTable[ sensorID ]  = timeStampDbl;
-    value                       = byte2UInt( payLoad[ 7 ], payLoad[ 6 ] );
+    record.nbDataTypes    = byte2UInt( payLoad[ 1 ] ) & 0x07;
+    record.dataType       = byte2UInt( payLoad[ 2 ] );
+    record.scaleFactor    = byte2UInt( payLoad[ 3 ] );
+    timeStampInt          = byte2UInt( payLoad[ 5 ], payLoad[ 4 ] );
+    rollOver              = ( 1 << 16 );  // 2^16 = 256^2
+    record.deltaEventTime = getDeltaInt( rollOverHappened, sensorID, rollOver, eventTimeTable, timeStampInt );
+    record.value          = byte2UInt( payLoad[ 7 ], payLoad[ 6 ] );
     if ( diagnostics )
     {
         char auxBuffer[ C_MEDIUM_BUFFER_SIZE ] = { 0 };
-        appendDiagnosticsLine( "Number of Data Types", payLoad[ 1 ], nbDataTypes, " (Lower 4 Bits)" );
-        appendDiagnosticsLine( "Data Type", payLoad[ 2 ], dataType );
-        int scaleFactorSigned = NEGATE_BINARY_INT( scaleFactor, 8 );
+        appendDiagnosticsLine( "Number of Data Types", payLoad[ 1 ], record.nbDataTypes, " (Lower 4 Bits)" );
+        appendDiagnosticsLine( "Data Type", payLoad[ 2 ], record.dataType );
+        int scaleFactorSigned = NEGATE_BINARY_INT( record.scaleFactor, 8 );
         sprintf( auxBuffer, "(signed %d)", scaleFactorSigned );
-        appendDiagnosticsLine( "Scale Factor", payLoad[ 3 ], scaleFactor, auxBuffer );
+        appendDiagnosticsLine( "Scale Factor", payLoad[ 3 ], record.scaleFactor, auxBuffer );
         appendDiagnosticsLine( "Time Stamp (int)", payLoad[ 5 ], payLoad[ 4 ], timeStampInt );
-        int valueSigned = NEGATE_BINARY_INT( value, 16 );
+        int valueSigned = NEGATE_BINARY_INT( record.value, 16 );
         sprintf( auxBuffer, "(signed %d)", valueSigned );
-        appendDiagnosticsLine( "Value", payLoad[ 5 ], payLoad[ 4 ], value, auxBuffer );
+        appendDiagnosticsLine( "Value", payLoad[ 5 ], payLoad[ 4 ], record.value, auxBuffer );
     }
 
     // - - - - - - - - - - - - - - - -
-    // Create the Result String
-    createOutputHeader( sensorID, timeStampBuffer );
-    createPWRB03ResultString( nbDataTypes, dataType, scaleFactor, deltaEventTime, value, timeStampDbl );
-    appendOutputFooter( getVersion() );
+    // Output the record
+    outputPowerB03Record( sensorID, timeStampBuffer, getVersion(), record );
 
     return result;
 }
@@ -1313,17 +1280,12 @@ bool antPowerProcessing::createB03ResultString
     const amSplitString &words
 )
 {
-    bool         result               = false;
-    unsigned int nbWords              = words.size();
-    unsigned int counter              = 0;
-    unsigned int additionalData1      = 0;
-    unsigned int additionalData2      = 0;
-    unsigned int additionalData3      = 0;
-    unsigned int additionalData4      = 0;
-    unsigned int additionalData5      = 0;
-    double       additionalDoubleData = 0;
-    amString     curVersion           = getVersion();
-    amString     sensorID;
+    bool              result     = false;
+    unsigned int      nbWords    = words.size();
+    unsigned int      counter    = 0;
+    antPowerB03Record record     = antPowerB03Record();
+    amString          curVersion = getVersion();
+    amString          sensorID;
     amString     timeStampBuffer;
     amString     semiCookedString;
 
@@ -1342,33 +1304,20 @@ bool antPowerProcessing::createB03ResultString
         {
             if ( totalTimeTable.count( sensorID ) == 0 )
             {
-                totalTimeTable.insert( std::pair<amString, unsigned int>( sensorID, 0 ) );
-                eventTimeTable.insert( std::pair<amString, unsigned int>( sensorID, 0 ) );
+                totalTimeTable.insert( sensorID, 0 );
+                eventTimeTable.insert( sensorID, 0 );
             }
-            result                      = true;
-            additionalData1             = words[ counter++ ].toUInt();          // 3 Number of Data Types
-            additionalData2             = words[ counter++ ].toUInt();          // 4 Data Type
-            additionalData3             = words[ counter++ ].toUInt();          // 5 Scale Factor
-            additionalData4             = words[ counter++ ].toUInt();          // 6 Delta Event Time
-            additionalData5             = words[ counter++ ].toUInt();          // 7 Value,
-            additionalDoubleData        = totalTimeTable[ sensorID ];
-            additionalDoubleData       += ( double ) additionalData4 / 2048.0;
-            totalTimeTable[ sensorID ]  = additionalDoubleData;
+            result                = true;
+            record.nbDataTypes    = words[ counter++ ].toUInt();          // 3 Number of Data Types
+            record.dataType       = words[ counter++ ].toUInt();          // 4 Data Type
+            record.scaleFactor    = words[ counter++ ].toUInt();          // 5 Scale Factor
+            record.deltaEventTime = words[ counter++ ].toUInt();          // 6 Delta Event Time
+            record.value          = words[ counter++ ].toUInt();          // 7 Value,
         }
     }
 
     if ( result )
     {
-        createOutputHeader( sensorID, timeStampBuffer );
-        createPWRB03ResultString
-        (
-            additionalData1,
-            additionalData2,
-            additionalData3,
-            additionalData4,
-            additionalData5,
-            additionalDoubleData
-        );
         if ( words.size() > counter )
         {
             curVersion = words[ counter ];
@@ -1377,7 +1326,7 @@ bool antPowerProcessing::createB03ResultString
                 appendDiagnosticsLine( "Version", curVersion );
             }
         }
-        appendOutputFooter( curVersion );
+        outputPowerB03Record( sensorID, timeStampBuffer, curVersion, record );
     }
 
     return result;
@@ -1394,24 +1343,19 @@ bool antPowerProcessing::createB03ResultString
 //-------------------------------------------------------------------------------------------------//
 amDeviceType antPowerProcessing::processPowerMeterB10
 (
-    const amString &deviceIDNo,
+    unsigned int    deviceIDNo,
     const amString &timeStampBuffer,
     BYTE            payLoad[]
 )
 {
-    amDeviceType result                = OTHER_DEVICE;
-    amString     sensorID              = amString( C_POWER_ONLY_DEVICE_HEAD ) + deviceIDNo;
-    unsigned int eventCount            = 0;
-    unsigned int pedalPower            = 0;
-    unsigned int instantaneousCadence  = 0;
-    unsigned int accumulatedPower      = 0;
-    unsigned int instantaneousPower    = 0;
-    unsigned int deltaEventCount       = 0;
-    unsigned int totalEventCount       = 0;
-    unsigned int deltaAccumulatedPower = 0;
-    unsigned int rollOver              = 0;
-    bool         rollOverHappened      = false;
-    bool         left                  = false;
+    amDeviceType      result           = OTHER_DEVICE;
+    antSensorHandle   sensorID         = sensorStates.intern( C_POWER_ONLY_DEVICE_HEAD, deviceIDNo );
+    antPowerB10Record record           = antPowerB10Record();
+    unsigned int      accumulatedPower = 0;
+    unsigned int      totalEventCount  = 0;
+    unsigned int      rollOver         = 0;
+    bool              rollOverHappened = false;
+    bool              left             = false;
 
     if ( powerTable.count( sensorID ) == 0 )
     {
@@ -1424,120 +1368,81 @@ amDeviceType antPowerProcessing::processPowerMeterB10
 
         // - - - - - - - - - - - - - - - -
         // Event Count
-        eventCount       = byte2UInt( payLoad[ 1 ] );
-        accumulatedPower = byte2UInt( payLoad[ 5 ], payLoad[ 4 ] );
-        rollOver         = 256;
-        if ( isLeftCrankEvent( sensorID, eventCount, rollOver ) )
+        record.eventCount = byte2UInt( payLoad[ 1 ] );
+        accumulatedPower  = byte2UInt( payLoad[ 5 ], payLoad[ 4 ] );
+        rollOver          = 256;
+        if ( isLeftCrankEvent( sensorID, record.eventCount, rollOver ) )
         {
             left                        = true;
-            deltaEventCount             = getDeltaInt( rollOverHappened, sensorID, rollOver, eventCountTable, eventCount );
-            totalEventCount             = totalCountTable[ sensorID ] + deltaEventCount;
+            record.deltaEventCount      = getDeltaInt( rollOverHappened, sensorID, rollOver, eventCountTable, record.eventCount );
+            totalEventCount             = totalCountTable[ sensorID ] + record.deltaEventCount;
             totalCountTable[ sensorID ] = totalEventCount;
 
             // - - - - - - - - - - - - - - - -
             // Accumulated Power
-            rollOver              = 65536;  // 256^2
-            deltaAccumulatedPower = getDeltaInt( rollOverHappened, sensorID, rollOver, accumulatedPowerTable, accumulatedPower );
+            rollOver                     = 65536;  // 256^2
+            record.deltaAccumulatedPower = getDeltaInt( rollOverHappened, sensorID, rollOver, accumulatedPowerTable, accumulatedPower );
         }
         else
         {
-            deltaEventCount                  = getDeltaInt( rollOverHappened, sensorID, rollOver, otherEventCountTable, eventCount );
-            totalEventCount                  = otherTotalCountTable[ sensorID ] + deltaEventCount;
+            record.deltaEventCount           = getDeltaInt( rollOverHappened, sensorID, rollOver, otherEventCountTable, record.eventCount );
+            totalEventCount                  = otherTotalCountTable[ sensorID ] + record.deltaEventCount;
             otherTotalCountTable[ sensorID ] = totalEventCount;
 
             // - - - - - - - - - - - - - - - -
             // Accumulated Power
-            rollOver              = 65536;  // 256^2
-            deltaAccumulatedPower = getDeltaInt( rollOverHappened, sensorID, rollOver, otherAccumulatedPowerTable, accumulatedPower );
+            rollOver                     = 65536;  // 256^2
+            record.deltaAccumulatedPower = getDeltaInt( rollOverHappened, sensorID, rollOver, otherAccumulatedPowerTable, accumulatedPower );
         }
 
         if ( diagnostics )
         {
             char auxBuffer[ C_MEDIUM_BUFFER_SIZE ] = { 0 };
-            appendDiagnosticsLine( "Event Count", payLoad[ 1 ], eventCount );
+            appendDiagnosticsLine( "Event Count", payLoad[ 1 ], record.eventCount );
             if ( rollOverHappened )
             {
                 sprintf( auxBuffer, " (Rollover [%d] occurred)", rollOver );
             }
-            appendDiagnosticsLine( "Delta Event Count", deltaEventCount, auxBuffer );
+            appendDiagnosticsLine( "Delta Event Count", record.deltaEventCount, auxBuffer );
             appendDiagnosticsLine( "Accumulated Power", payLoad[ 5 ], payLoad[ 4 ], accumulatedPower );
             if ( rollOverHappened )
             {
                 sprintf( auxBuffer, " (Rollover [%d] occurred)", rollOver );
             }
-            appendDiagnosticsLine( "Delta Accumulated Power", deltaAccumulatedPower, auxBuffer );
+            appendDiagnosticsLine( "Delta Accumulated Power", record.deltaAccumulatedPower, auxBuffer );
         }
 
 
         // - - - - - - - - - - - - - - - -
         // Pedal Power
-        pedalPower = byte2UInt( payLoad[ 2 ] );
+        record.pedalPower = byte2UInt( payLoad[ 2 ] );
         if ( diagnostics )
         {
-            appendDiagnosticsLine( "Pedal Power", payLoad[ 2 ], pedalPower );
+            appendDiagnosticsLine( "Pedal Power", payLoad[ 2 ], record.pedalPower );
         }
 
 
         // - - - - - - - - - - - - - - - -
         // Instantaneous Cadence
-        instantaneousCadence = byte2UInt( payLoad[ 3 ] );
+        record.instantaneousCadence = byte2UInt( payLoad[ 3 ] );
         if ( diagnostics )
         {
-            appendDiagnosticsLine( "Instantaneous Cadence", payLoad[ 3 ], instantaneousCadence );
+            appendDiagnosticsLine( "Instantaneous Cadence", payLoad[ 3 ], record.instantaneousCadence );
         }
 
 
         // - - - - - - - - - - - - - - - -
         // Instantaneous Power
-        instantaneousPower = byte2UInt( payLoad[ 7 ], payLoad[ 6 ] );
+        record.instantaneousPower = byte2UInt( payLoad[ 7 ], payLoad[ 6 ] );
         if ( diagnostics )
         {
-            appendDiagnosticsLine( "Instantaneous Power", payLoad[ 7 ], payLoad[ 6 ], instantaneousPower );
+            appendDiagnosticsLine( "Instantaneous Power", payLoad[ 7 ], payLoad[ 6 ], record.instantaneousPower );
         }
     }
 
     if ( result == POWER_METER )
     {
-        double       power              = getPower( sensorID );
-        double       speed              = 0;
-        double       wheelCircumference = 0;
-        double       gearRatio          = getNbMagnets( sensorID );
-        unsigned int cadence            = getCadence( sensorID );
-        unsigned int zeroTimeCount      = getZeroTimeCount( sensorID );
-
-        createOutputHeader( sensorID, timeStampBuffer );
-        if ( isUsedAsSpeedSensor( sensorID ) )
-        {
-            speed              = getSpeed( sensorID );
-            wheelCircumference = getWheelCircumference( sensorID );
-            gearRatio          = getNbMagnets( sensorID );
-        }
-
-        createPWRB10ResultString
-        (
-            power,
-            cadence,
-            zeroTimeCount,
-            eventCount,
-            deltaEventCount,
-            deltaAccumulatedPower,
-            instantaneousPower,
-            instantaneousCadence,
-            pedalPower,
-            isUsedAsSpeedSensor( sensorID ),
-            speed,
-            wheelCircumference,
-            gearRatio
-        );
-        appendOutputFooter( getVersion() );
-
-        if ( isUsedAsSpeedSensor( sensorID ) )
-        {
-            setSpeed( sensorID, speed );
-        }
-        setPower( sensorID,   power );
-        setCadence( sensorID, cadence );
-        setZeroTimeCount( sensorID, zeroTimeCount );
+        outputPowerB10Record( sensorID, timeStampBuffer, getVersion(), record );
     }
 
     return result;
@@ -1560,19 +1465,14 @@ amDeviceType antPowerProcessing::processPowerMeterB10SemiCooked
     amDeviceType result = OTHER_DEVICE;
     if ( !inputBuffer.empty() )
     {
-        amString      sensorID;
-        amString      timeStampBuffer;
-        amString      semiCookedString;
-        amString      curVersion            = getVersion();
-        amSplitString words;
-        unsigned int  nbWords               = words.split( inputBuffer );
-        unsigned int  eventCount            = 0;
-        unsigned int  deltaEventCount       = 0;
-        unsigned int  deltaAccumulatedPower = 0;
-        unsigned int  instantaneousPower    = 0;
-        unsigned int  instantaneousCadence  = 0;
-        unsigned int  pedalPower            = 0;
-        unsigned int  counter               = 0;
+        amString          sensorID;
+        amString          timeStampBuffer;
+        amString          semiCookedString;
+        amString          curVersion = getVersion();
+        amSplitString     words;
+        unsigned int      nbWords    = words.split( inputBuffer );
+        antPowerB10Record record     = antPowerB10Record();
+        unsigned int      counter    = 0;
 
         if ( nbWords > 7 )
         {
@@ -1587,24 +1487,24 @@ amDeviceType antPowerProcessing::processPowerMeterB10SemiCooked
             }
             if ( isRegisteredDevice( sensorID ) && ( semiCookedString == C_SEMI_COOKED_SYMBOL_AS_STRING ) && isPowerOnlySensor( sensorID ) )
             {
-                result                = POWER_METER;
-                deltaEventCount       = words[ counter++ ].toUInt();            // 3
-                deltaAccumulatedPower = words[ counter++ ].toUInt();            // 4
-                instantaneousPower    = words[ counter++ ].toUInt();            // 5
-                instantaneousCadence  = words[ counter++ ].toUInt();            // 6
-                pedalPower            = words[ counter++ ].toUInt();            // 7
+                result                       = POWER_METER;
+                record.deltaEventCount       = words[ counter++ ].toUInt();            // 3
+                record.deltaAccumulatedPower = words[ counter++ ].toUInt();            // 4
+                record.instantaneousPower    = words[ counter++ ].toUInt();            // 5
+                record.instantaneousCadence  = words[ counter++ ].toUInt();            // 6
+                record.pedalPower            = words[ counter++ ].toUInt();            // 7
                 if ( ( nbWords > 8 ) && words[ counter ].isUnsignedInteger() )
                 {
-                    eventCount        = words[ counter++ ].toUInt();            // 8
+                    record.eventCount        = words[ counter++ ].toUInt();            // 8
                 }
                 if ( diagnostics )
                 {
-                    appendDiagnosticsLine( "Delta Event Count", deltaEventCount );
-                    appendDiagnosticsLine( "Delta Accumulated Power", deltaAccumulatedPower );
-                    appendDiagnosticsLine( "Instantaneous Power", instantaneousPower );
-                    appendDiagnosticsLine( "Instantaneous Cadence", instantaneousCadence );
-                    appendDiagnosticsLine( "Pedal Power", pedalPower );
-                    appendDiagnosticsLine( "Event Count", eventCount );
+                    appendDiagnosticsLine( "Delta Event Count", record.deltaEventCount );
+                    appendDiagnosticsLine( "Delta Accumulated Power", record.deltaAccumulatedPower );
+                    appendDiagnosticsLine( "Instantaneous Power", record.instantaneousPower );
+                    appendDiagnosticsLine( "Instantaneous Cadence", record.instantaneousCadence );
+                    appendDiagnosticsLine( "Pedal Power", record.pedalPower );
+                    appendDiagnosticsLine( "Event Count", record.eventCount );
                 }
 
                 if ( powerTable.count( sensorID ) == 0 )
@@ -1616,13 +1516,6 @@ amDeviceType antPowerProcessing::processPowerMeterB10SemiCooked
 
         if ( result == POWER_METER )
         {
-            double       power              = getPower( sensorID );
-            unsigned int cadence            = getCadence( sensorID );
-            unsigned int zeroTimeCount      = getZeroTimeCount( sensorID );
-            double       speed              = 0;
-            double       wheelCircumference = 0;
-            double       gearRatio          = 0;
-
             if ( nbWords > counter )
             {
                 curVersion = words[ counter++ ];
@@ -1632,39 +1525,7 @@ amDeviceType antPowerProcessing::processPowerMeterB10SemiCooked
                 }
             }
 
-            if ( isUsedAsSpeedSensor( sensorID ) )
-            {
-                speed              = getSpeed( sensorID );
-                wheelCircumference = getWheelCircumference( sensorID );
-                gearRatio          = getNbMagnets( sensorID );
-            }
-
-            createOutputHeader( sensorID, timeStampBuffer );
-            createPWRB10ResultString
-            (
-                power,
-                cadence,
-                zeroTimeCount,
-                eventCount,
-                deltaEventCount,
-                deltaAccumulatedPower,
-                instantaneousPower,
-                instantaneousCadence,
-                pedalPower,
-                isUsedAsSpeedSensor( sensorID ),
-                speed,
-                wheelCircumference,
-                gearRatio
-            );
-            appendOutputFooter( curVersion );
-
-            if ( isUsedAsSpeedSensor( sensorID ) )
-            {
-                setSpeed( sensorID, speed );
-            }
-            setPower  ( sensorID, power );
-            setCadence( sensorID, cadence );
-            setZeroTimeCount( sensorID, zeroTimeCount );
+            outputPowerB10Record( sensorID, timeStampBuffer, curVersion, record );
         }
 
         if ( result == OTHER_DEVICE )
@@ -1703,24 +1564,20 @@ amDeviceType antPowerProcessing::processPowerMeterB10SemiCooked
 // ---------------------------------------------------------------------------------------------------
 amDeviceType antPowerProcessing::processPowerMeterB11
 (
-    const amString &deviceIDNo,
+    unsigned int    deviceIDNo,
     const amString &timeStampBuffer,
     BYTE            payLoad[]
 )
 {
-    amDeviceType result                 = OTHER_DEVICE;
-    amString     sensorID               = amString( C_WT_POWER_DEVICE_HEAD ) + deviceIDNo;
-    unsigned int eventCount             = 0;
-    unsigned int wheelTicks             = 0;
-    unsigned int instantaneousCadence   = 0;
-    unsigned int accumWheelPeriod       = 0;
-    unsigned int accumulatedTorque      = 0;
-    unsigned int deltaEventCount        = 0;
-    unsigned int deltaWheelPeriod       = 0;
-    unsigned int deltaAccumulatedTorque = 0;
-    unsigned int rollOver               = 0;
-    bool         rollOverHappened       = false;
-    char         auxBuffer[ C_SMALL_BUFFER_SIZE ] = { 0 };
+    amDeviceType      result                           = OTHER_DEVICE;
+    antSensorHandle   sensorID                         = sensorStates.intern( C_WT_POWER_DEVICE_HEAD, deviceIDNo );
+    antPowerB11Record record                           = antPowerB11Record();
+    unsigned int      eventCount                       = 0;
+    unsigned int      accumWheelPeriod                 = 0;
+    unsigned int      accumulatedTorque                = 0;
+    unsigned int      rollOver                         = 0;
+    bool              rollOverHappened                 = false;
+    char              auxBuffer[ C_SMALL_BUFFER_SIZE ] = { 0 };
 
     if ( powerTable.count( sensorID ) == 0 )
     {
@@ -1733,9 +1590,9 @@ amDeviceType antPowerProcessing::processPowerMeterB11
 
         // - - - - - - - - - - - - - - - -
         // Event Count
-        eventCount      = byte2UInt( payLoad[ 1 ] );
-        rollOver        = 256;
-        deltaEventCount = getDeltaInt( rollOverHappened, sensorID, rollOver, eventCountTable, eventCount );
+        eventCount             = byte2UInt( payLoad[ 1 ] );
+        rollOver               = 256;
+        record.deltaEventCount = getDeltaInt( rollOverHappened, sensorID, rollOver, eventCountTable, eventCount );
         if ( diagnostics )
         {
             appendDiagnosticsLine( "Event Count", payLoad[ 1 ], eventCount );
@@ -1743,7 +1600,7 @@ amDeviceType antPowerProcessing::processPowerMeterB11
             {
                 sprintf( auxBuffer, " (Rollover [%d] occurred)", rollOver );
             }
-            appendDiagnosticsLine( "Delta Event Count", deltaEventCount, auxBuffer );
+            appendDiagnosticsLine( "Delta Event Count", record.deltaEventCount, auxBuffer );
         }
         if ( eventCountTable[ sensorID ] == eventCount )
         {
@@ -1757,25 +1614,25 @@ amDeviceType antPowerProcessing::processPowerMeterB11
 
         // - - - - - - - - - - - - - - - -
         // Wheel Ticks
-        wheelTicks = byte2UInt( payLoad[ 2 ] );
+        record.wheelTicks = byte2UInt( payLoad[ 2 ] );
         if ( diagnostics )
         {
-            appendDiagnosticsLine( "Wheel Ticks", payLoad[ 2 ], wheelTicks );
+            appendDiagnosticsLine( "Wheel Ticks", payLoad[ 2 ], record.wheelTicks );
         }
 
         // - - - - - - - - - - - - - - - -
         // Instantaneous Cadence
-        instantaneousCadence = byte2UInt( payLoad[ 3 ] );
+        record.instantaneousCadence = byte2UInt( payLoad[ 3 ] );
         if ( diagnostics )
         {
-            appendDiagnosticsLine( "Instantaneous Cadence", payLoad[ 3 ], instantaneousCadence );
+            appendDiagnosticsLine( "Instantaneous Cadence", payLoad[ 3 ], record.instantaneousCadence );
         }
 
         // - - - - - - - - - - - - - - - -
         // Accumulated Power
-        accumWheelPeriod = byte2UInt( payLoad[ 5 ], payLoad[ 4 ] );
-        rollOver         = 65536;  // 256^2
-        deltaWheelPeriod = getDeltaInt( rollOverHappened, sensorID, rollOver, crankOrWheelPeriodTable, accumWheelPeriod );
+        accumWheelPeriod        = byte2UInt( payLoad[ 5 ], payLoad[ 4 ] );
+        rollOver                = 65536;  // 256^2
+        record.deltaWheelPeriod = getDeltaInt( rollOverHappened, sensorID, rollOver, crankOrWheelPeriodTable, accumWheelPeriod );
         if ( diagnostics )
         {
             appendDiagnosticsLine( "Accumulated Wheel Period", payLoad[ 5 ], payLoad[ 4 ], accumWheelPeriod );
@@ -1784,15 +1641,15 @@ amDeviceType antPowerProcessing::processPowerMeterB11
             {
                 sprintf( auxBuffer, " (Rollover [%d] occurred)", rollOver );
             }
-            appendDiagnosticsLine( "Delta Accumulated Wheel Period", deltaWheelPeriod, auxBuffer );
+            appendDiagnosticsLine( "Delta Accumulated Wheel Period", record.deltaWheelPeriod, auxBuffer );
         }
 
 
         // - - - - - - - - - - - - - - - -
         // Accumulated Torque
-        accumulatedTorque      = byte2UInt( payLoad[ 7 ], payLoad[ 6 ] );
-        rollOver               = 65536;  // 256^2
-        deltaAccumulatedTorque = getDeltaInt( rollOverHappened, sensorID, rollOver, accumulatedTorqueTable, accumulatedTorque );
+        accumulatedTorque             = byte2UInt( payLoad[ 7 ], payLoad[ 6 ] );
+        rollOver                      = 65536;  // 256^2
+        record.deltaAccumulatedTorque = getDeltaInt( rollOverHappened, sensorID, rollOver, accumulatedTorqueTable, accumulatedTorque );
         if ( diagnostics )
         {
             appendDiagnosticsLine( "Accumulated Torque", payLoad[ 7 ], payLoad[ 6 ], accumulatedTorque );
@@ -1801,50 +1658,13 @@ amDeviceType antPowerProcessing::processPowerMeterB11
             {
                 sprintf( auxBuffer, " (Rollover [%d] occurred)", rollOver );
             }
-            appendDiagnosticsLine( "Delta Accumulated Torque", deltaAccumulatedTorque, auxBuffer );
+            appendDiagnosticsLine( "Delta Accumulated Torque", record.deltaAccumulatedTorque, auxBuffer );
         }
     }
 
     if ( result == POWER_METER )
     {
-        double       power              = getPower( sensorID );
-        unsigned int zeroTimeCount      = getZeroTimeCount( sensorID );
-        unsigned int cadence            = getCadence( sensorID );
-        double       torque             = getTorque( sensorID );
-        double       speed              = 0;
-        double       wheelCircumference = 0;
-        if ( isUsedAsSpeedSensor( sensorID ) )
-        {
-            speed                       = getSpeed( sensorID );
-            wheelCircumference          = getWheelCircumference( sensorID );
-        }
-
-        createOutputHeader( sensorID, timeStampBuffer );
-        createPWRB11ResultString
-        (
-            power,
-            cadence,
-            torque,
-            zeroTimeCount,
-            deltaEventCount,
-            deltaWheelPeriod,
-            deltaAccumulatedTorque,
-            instantaneousCadence,
-            wheelTicks,
-            isUsedAsSpeedSensor( sensorID ),
-            speed,
-            wheelCircumference
-        );
-        appendOutputFooter( getVersion() );
-
-        setPower  ( sensorID, power );
-        setTorque ( sensorID, torque );
-        setCadence( sensorID, cadence );
-        setZeroTimeCount( sensorID, zeroTimeCount );
-        if ( isUsedAsSpeedSensor( sensorID ) )
-        {
-            setSpeed( sensorID, speed );
-        }
+        outputPowerB11Record( sensorID, timeStampBuffer, getVersion(), record );
     }
 
     return result;
@@ -1867,18 +1687,14 @@ amDeviceType antPowerProcessing::processPowerMeterB11SemiCooked
     amDeviceType result = OTHER_DEVICE;
     if ( !inputBuffer.empty() )
     {
-        amSplitString words;
-        unsigned int  nbWords                = words.split( inputBuffer );
-        unsigned int  deltaEventCount        = 0;
-        unsigned int  deltaWheelPeriod       = 0;
-        unsigned int  deltaAccumulatedTorque = 0;
-        unsigned int  instantaneousCadence   = 0;
-        unsigned int  wheelTicks             = 0;
-        unsigned int  counter                = 0;
-        amString      curVersion             = getVersion();
-        amString      semiCookedString;
-        amString      timeStampBuffer;
-        amString      sensorID;
+        amSplitString     words;
+        unsigned int      nbWords    = words.split( inputBuffer );
+        antPowerB11Record record     = antPowerB11Record();
+        unsigned int      counter    = 0;
+        amString          curVersion = getVersion();
+        amString          semiCookedString;
+        amString          timeStampBuffer;
+        amString          sensorID;
 
         if ( nbWords > 7 )
         {
@@ -1893,19 +1709,19 @@ amDeviceType antPowerProcessing::processPowerMeterB11SemiCooked
             }
             if ( isRegisteredDevice( sensorID ) && ( semiCookedString == C_SEMI_COOKED_SYMBOL_AS_STRING ) && isWheelTorquePowerSensor( sensorID ) )
             {
-                result                 = POWER_METER;
-                deltaEventCount        = words[ counter++ ].toUInt();      // 3
-                deltaWheelPeriod       = words[ counter++ ].toUInt();      // 4
-                deltaAccumulatedTorque = words[ counter++ ].toUInt();      // 5
-                instantaneousCadence   = words[ counter++ ].toUInt();      // 6
-                wheelTicks             = words[ counter++ ].toUInt();      // 7
+                result                        = POWER_METER;
+                record.deltaEventCount        = words[ counter++ ].toUInt();      // 3
+                record.deltaWheelPeriod       = words[ counter++ ].toUInt();      // 4
+                record.deltaAccumulatedTorque = words[ counter++ ].toUInt();      // 5
+                record.instantaneousCadence   = words[ counter++ ].toUInt();      // 6
+                record.wheelTicks             = words[ counter++ ].toUInt();      // 7
                 if ( diagnostics )
                 {
-                    appendDiagnosticsLine( "Delta Event Count", deltaEventCount );
-                    appendDiagnosticsLine( "Delta Wheel Period", deltaWheelPeriod );
-                    appendDiagnosticsLine( "Delta Accumulated Torque Ticks", deltaAccumulatedTorque );
-                    appendDiagnosticsLine( "Instantaneous Cadence", instantaneousCadence );
-                    appendDiagnosticsLine( "Wheel Ticks", wheelTicks );
+                    appendDiagnosticsLine( "Delta Event Count", record.deltaEventCount );
+                    appendDiagnosticsLine( "Delta Wheel Period", record.deltaWheelPeriod );
+                    appendDiagnosticsLine( "Delta Accumulated Torque Ticks", record.deltaAccumulatedTorque );
+                    appendDiagnosticsLine( "Instantaneous Cadence", record.instantaneousCadence );
+                    appendDiagnosticsLine( "Wheel Ticks", record.wheelTicks );
                 }
 
                 if ( powerTable.count( sensorID ) == 0 )
@@ -1917,18 +1733,6 @@ amDeviceType antPowerProcessing::processPowerMeterB11SemiCooked
 
         if ( result == POWER_METER )
         {
-            double       power              = getPower( sensorID );
-            unsigned int zeroTimeCount      = getZeroTimeCount( sensorID );
-            unsigned int cadence            = getCadence( sensorID );
-            double       torque             = getTorque( sensorID );
-            double       speed              = 0;
-            double       wheelCircumference = 0;
-            if ( isUsedAsSpeedSensor( sensorID ) )
-            {
-                speed                       = getSpeed( sensorID );
-                wheelCircumference          = getWheelCircumference( sensorID );
-            }
-
             if ( nbWords > counter )
             {
                 curVersion = words[ counter++ ];
@@ -1938,32 +1742,7 @@ amDeviceType antPowerProcessing::processPowerMeterB11SemiCooked
                 }
             }
 
-            createOutputHeader( sensorID, timeStampBuffer );
-            createPWRB11ResultString
-            (
-                power,
-                cadence,
-                torque,
-                zeroTimeCount,
-                deltaEventCount,
-                deltaWheelPeriod,
-                deltaAccumulatedTorque,
-                instantaneousCadence,
-                wheelTicks,
-                isUsedAsSpeedSensor( sensorID ),
-                speed,
-                wheelCircumference
-            );
-            appendOutputFooter( curVersion );
-
-            setPower  ( sensorID, power );
-            setTorque ( sensorID, torque );
-            setCadence( sensorID, cadence );
-            setZeroTimeCount( sensorID, zeroTimeCount );
-            if ( isUsedAsSpeedSensor( sensorID ) )
-            {
-                setSpeed( sensorID, speed );
-            }
+            outputPowerB11Record( sensorID, timeStampBuffer, curVersion, record );
         }
 
         if ( result == OTHER_DEVICE )
@@ -2002,26 +1781,21 @@ amDeviceType antPowerProcessing::processPowerMeterB11SemiCooked
 // ---------------------------------------------------------------------------------------------------
 amDeviceType antPowerProcessing::processPowerMeterB12
 (
-    const amString &deviceIDNo,
+    unsigned int    deviceIDNo,
     const amString &timeStampBuffer,
     BYTE            payLoad[]
 )
 {
-    amDeviceType result                 = OTHER_DEVICE;
-    amString     sensorID               = amString( C_CT_POWER_DEVICE_HEAD ) + deviceIDNo;
-    unsigned int eventCount             = 0;
-    unsigned int crankTicks             = 0;
-    unsigned int instantaneousCadence   = 0;
-    unsigned int crankPeriod            = 0;
-    unsigned int accumulatedTorque      = 0;
-    unsigned int deltaEventCount        = 0;
-    unsigned int totalEventCount        = 0;
-    unsigned int deltaCrankPeriod       = 0;
-    unsigned int deltaAccumulatedTorque = 0;
-    unsigned int rollOver               = 0;
-    bool         rollOverHappened       = false;
-    bool         left                   = false;
-    char         auxBuffer[ C_MEDIUM_BUFFER_SIZE ] = { 0 };
+    amDeviceType      result                            = OTHER_DEVICE;
+    antSensorHandle   sensorID                          = sensorStates.intern( C_CT_POWER_DEVICE_HEAD, deviceIDNo );
+    antPowerB12Record record                            = antPowerB12Record();
+    unsigned int      crankPeriod                       = 0;
+    unsigned int      accumulatedTorque                 = 0;
+    unsigned int      totalEventCount                   = 0;
+    unsigned int      rollOver                          = 0;
+    bool              rollOverHappened                  = false;
+    bool              left                              = false;
+    char              auxBuffer[ C_MEDIUM_BUFFER_SIZE ] = { 0 };
 
     if ( powerTable.count( sensorID ) == 0 )
     {
@@ -2035,31 +1809,31 @@ amDeviceType antPowerProcessing::processPowerMeterB12
 
         // - - - - - - - - - - - - - - - -
         // Event Count
-        eventCount        = byte2UInt( payLoad[ 1 ] );
+        record.eventCount = byte2UInt( payLoad[ 1 ] );
         crankPeriod       = byte2UInt( payLoad[ 5 ], payLoad[ 4 ] );
         accumulatedTorque = byte2UInt( payLoad[ 7 ], payLoad[ 6 ] );
         rollOver          = 256;
-        if ( isLeftCrankEvent( sensorID, eventCount, rollOver ) )
+        if ( isLeftCrankEvent( sensorID, record.eventCount, rollOver ) )
         {
             left                        = true;
-            deltaEventCount             = getDeltaInt( rollOverHappened, sensorID, rollOver, eventCountTable, eventCount );
-            totalEventCount             = totalCountTable[ sensorID ] + deltaEventCount;
+            record.deltaEventCount      = getDeltaInt( rollOverHappened, sensorID, rollOver, eventCountTable, record.eventCount );
+            totalEventCount             = totalCountTable[ sensorID ] + record.deltaEventCount;
             totalCountTable[ sensorID ] = totalEventCount;
             if ( diagnostics )
             {
-                appendDiagnosticsLine( "Event Count", deltaEventCount, auxBuffer );
+                appendDiagnosticsLine( "Event Count", record.deltaEventCount, auxBuffer );
                 if ( rollOverHappened )
                 {
                     sprintf( auxBuffer, " (Rollover [%d] occurred)", rollOver );
                 }
-                appendDiagnosticsLine( "Delta Event Count", deltaEventCount, auxBuffer );
+                appendDiagnosticsLine( "Delta Event Count", record.deltaEventCount, auxBuffer );
                 appendDiagnosticsLine( "Total Event Count", totalEventCount );
             }
 
             // - - - - - - - - - - - - - - - -
             // Crank Period
-            rollOver         = 65536;  // 256^2
-            deltaCrankPeriod = getDeltaInt( rollOverHappened, sensorID, rollOver, crankOrWheelPeriodTable, crankPeriod );
+            rollOver                = 65536;  // 256^2
+            record.deltaCrankPeriod = getDeltaInt( rollOverHappened, sensorID, rollOver, crankOrWheelPeriodTable, crankPeriod );
             if ( diagnostics )
             {
                 appendDiagnosticsLine( "Accumulated Crank Period", payLoad[ 5 ], payLoad[ 4 ], crankPeriod );
@@ -2068,13 +1842,13 @@ amDeviceType antPowerProcessing::processPowerMeterB12
                 {
                     sprintf( auxBuffer, " (Rollover [%d] occurred)", rollOver );
                 }
-                appendDiagnosticsLine( "Delta Accumulated Crank Period", deltaCrankPeriod, auxBuffer );
+                appendDiagnosticsLine( "Delta Accumulated Crank Period", record.deltaCrankPeriod, auxBuffer );
             }
 
             // - - - - - - - - - - - - - - - -
             // Accumulated Torque
-            rollOver               = 65536;  // 256^2
-            deltaAccumulatedTorque = getDeltaInt( rollOverHappened, sensorID, rollOver, accumulatedTorqueTable, accumulatedTorque );
+            rollOver                      = 65536;  // 256^2
+            record.deltaAccumulatedTorque = getDeltaInt( rollOverHappened, sensorID, rollOver, accumulatedTorqueTable, accumulatedTorque );
             if ( diagnostics )
             {
                 appendDiagnosticsLine( "Accumulated Torque", payLoad[ 7 ], payLoad[ 6 ], accumulatedTorque );
@@ -2083,29 +1857,29 @@ amDeviceType antPowerProcessing::processPowerMeterB12
                 {
                     sprintf( auxBuffer, " (Rollover [%d] occurred)", rollOver );
                 }
-                appendDiagnosticsLine( "Delta Accumulated Torque", deltaAccumulatedTorque, auxBuffer );
+                appendDiagnosticsLine( "Delta Accumulated Torque", record.deltaAccumulatedTorque, auxBuffer );
             }
         }
         else
         {
-            deltaEventCount                  = getDeltaInt( rollOverHappened, sensorID, rollOver, otherEventCountTable, eventCount );
-            totalEventCount                  = otherTotalCountTable[ sensorID ] + deltaEventCount;
+            record.deltaEventCount           = getDeltaInt( rollOverHappened, sensorID, rollOver, otherEventCountTable, record.eventCount );
+            totalEventCount                  = otherTotalCountTable[ sensorID ] + record.deltaEventCount;
             otherTotalCountTable[ sensorID ] = totalEventCount;
             if ( diagnostics )
             {
-                appendDiagnosticsLine( "Event Count", deltaEventCount, auxBuffer );
+                appendDiagnosticsLine( "Event Count", record.deltaEventCount, auxBuffer );
                 if ( rollOverHappened )
                 {
                     sprintf( auxBuffer, " (Rollover [%d] occurred)", rollOver );
                 }
-                appendDiagnosticsLine( "Delta Event Count (other)", deltaEventCount, auxBuffer );
+                appendDiagnosticsLine( "Delta Event Count (other)", record.deltaEventCount, auxBuffer );
                 appendDiagnosticsLine( "Total Event Count (other)", totalEventCount );
             }
 
             // - - - - - - - - - - - - - - - -
             // Crank Period
-            rollOver         = 65536;  // 256^2
-            deltaCrankPeriod = getDeltaInt( rollOverHappened, sensorID, rollOver, otherCrankOrWheelPeriodTable, crankPeriod );
+            rollOver                = 65536;  // 256^2
+            record.deltaCrankPeriod = getDeltaInt( rollOverHappened, sensorID, rollOver, otherCrankOrWheelPeriodTable, crankPeriod );
             if ( diagnostics )
             {
                 appendDiagnosticsLine( "Accumulated Crank Period", payLoad[ 5 ], payLoad[ 4 ], crankPeriod );
@@ -2114,13 +1888,13 @@ amDeviceType antPowerProcessing::processPowerMeterB12
                 {
                     sprintf( auxBuffer, " (Rollover [%d] occurred)", rollOver );
                 }
-                appendDiagnosticsLine( "Delta Accumulated Crank Period (other)", deltaCrankPeriod, auxBuffer );
+                appendDiagnosticsLine( "Delta Accumulated Crank Period (other)", record.deltaCrankPeriod, auxBuffer );
             }
 
             // - - - - - - - - - - - - - - - -
             // Accumulated Torque
-            rollOver               = 65536;  // 256^2
-            deltaAccumulatedTorque = getDeltaInt( rollOverHappened, sensorID, rollOver, otherAccumulatedTorqueTable, accumulatedTorque );
+            rollOver                      = 65536;  // 256^2
+            record.deltaAccumulatedTorque = getDeltaInt( rollOverHappened, sensorID, rollOver, otherAccumulatedTorqueTable, accumulatedTorque );
             if ( diagnostics )
             {
                 appendDiagnosticsLine( "Accumulated Torque", payLoad[ 7 ], payLoad[ 6 ], accumulatedTorque );
@@ -2129,74 +1903,32 @@ amDeviceType antPowerProcessing::processPowerMeterB12
                 {
                     sprintf( auxBuffer, " (Rollover [%d] occurred)", rollOver );
                 }
-                appendDiagnosticsLine( "Delta Accumulated Torque (other)", deltaAccumulatedTorque, auxBuffer );
+                appendDiagnosticsLine( "Delta Accumulated Torque (other)", record.deltaAccumulatedTorque, auxBuffer );
             }
         }
 
 
         // - - - - - - - - - - - - - - - -
         // Crank Ticks
-        crankTicks = byte2UInt( payLoad[ 2 ] );
+        record.crankTicks = byte2UInt( payLoad[ 2 ] );
         if ( diagnostics )
         {
-            appendDiagnosticsLine( "Crank Ticks", payLoad[ 2 ], crankTicks );
+            appendDiagnosticsLine( "Crank Ticks", payLoad[ 2 ], record.crankTicks );
         }
 
 
         // - - - - - - - - - - - - - - - -
         // Instantaneous Cadence
-        instantaneousCadence = byte2UInt( payLoad[ 3 ] );
+        record.instantaneousCadence = byte2UInt( payLoad[ 3 ] );
         if ( diagnostics )
         {
-            appendDiagnosticsLine( "Instantaneous Cadence", payLoad[ 3 ], instantaneousCadence );
+            appendDiagnosticsLine( "Instantaneous Cadence", payLoad[ 3 ], record.instantaneousCadence );
         }
     }
 
     if ( result == POWER_METER )
     {
-        double       power              = getPower( sensorID );
-        unsigned int cadence            = getCadence( sensorID );
-        unsigned int zeroTimeCount      = getZeroTimeCount( sensorID );
-        double       torque             = getTorque( sensorID );
-        double       speed              = 0;
-        double       wheelCircumference = 0;
-        double       gearRatio          = 0;
-
-        if ( isUsedAsSpeedSensor( sensorID ) )
-        {
-            speed              = getSpeed( sensorID );
-            wheelCircumference = getWheelCircumference( sensorID );
-            gearRatio          = getNbMagnets( sensorID );
-        }
-
-        createOutputHeader( sensorID, timeStampBuffer );
-        createPWRB12ResultString
-        (
-            power,
-            cadence,
-            torque,
-            zeroTimeCount,
-            eventCount,
-            deltaEventCount,
-            deltaCrankPeriod,
-            deltaAccumulatedTorque,
-            instantaneousCadence,
-            crankTicks,
-            isUsedAsSpeedSensor( sensorID ),
-            speed,
-            wheelCircumference,
-            gearRatio
-        );
-        appendOutputFooter( getVersion() );
-        if ( isUsedAsSpeedSensor( sensorID ) )
-        {
-            setSpeed( sensorID, speed );
-        }
-
-        setPower  ( sensorID, power );
-        setTorque ( sensorID, torque );
-        setCadence( sensorID, cadence );
-        setZeroTimeCount( sensorID, zeroTimeCount );
+        outputPowerB12Record( sensorID, timeStampBuffer, getVersion(), record );
     }
 
     return result;
@@ -2210,19 +1942,14 @@ amDeviceType antPowerProcessing::processPowerMeterB12SemiCooked
     amDeviceType result = OTHER_DEVICE;
     if ( !inputBuffer.empty() )
     {
-        amSplitString words;
-        unsigned int  nbWords                = words.split( inputBuffer );
-        amString      sensorID;
-        amString      curVersion             = getVersion();
-        amString      timeStampBuffer;
-        amString      semiCookedString;
-        unsigned int  counter                = 0;
-        unsigned int  eventCount             = 0;
-        unsigned int  deltaEventCount        = 0;
-        unsigned int  deltaCrankPeriod       = 0;
-        unsigned int  deltaAccumulatedTorque = 0;
-        unsigned int  instantaneousCadence   = 0;
-        unsigned int  crankTicks             = 0;
+        amSplitString     words;
+        unsigned int      nbWords    = words.split( inputBuffer );
+        amString          sensorID;
+        amString          curVersion = getVersion();
+        amString          timeStampBuffer;
+        amString          semiCookedString;
+        unsigned int      counter    = 0;
+        antPowerB12Record record     = antPowerB12Record();
 
         if ( nbWords > 7 )
         {
@@ -2239,24 +1966,24 @@ amDeviceType antPowerProcessing::processPowerMeterB12SemiCooked
             {
                 // -----------------------------------------
                 // Create output string
-                result                 = POWER_METER;
-                deltaEventCount        = words[ counter++ ].toUInt();        // 3
-                deltaCrankPeriod       = words[ counter++ ].toUInt();        // 4
-                deltaAccumulatedTorque = words[ counter++ ].toUInt();        // 5
-                instantaneousCadence   = words[ counter++ ].toUInt();        // 6
-                crankTicks             = words[ counter++ ].toUInt();        // 7
+                result                        = POWER_METER;
+                record.deltaEventCount        = words[ counter++ ].toUInt();        // 3
+                record.deltaCrankPeriod       = words[ counter++ ].toUInt();        // 4
+                record.deltaAccumulatedTorque = words[ counter++ ].toUInt();        // 5
+                record.instantaneousCadence   = words[ counter++ ].toUInt();        // 6
+                record.crankTicks             = words[ counter++ ].toUInt();        // 7
                 if ( ( nbWords > 8 ) && words[ counter ].isUnsignedInteger() )
                 {
-                    eventCount         = words[ counter++ ].toUInt();        // 8
+                    record.eventCount         = words[ counter++ ].toUInt();        // 8
                 }
                 if ( diagnostics )
                 {
-                    appendDiagnosticsLine( "Delta Event Count", deltaEventCount );
-                    appendDiagnosticsLine( "Delta Crank Period", deltaCrankPeriod );
-                    appendDiagnosticsLine( "Delta Accumulated Torque", deltaAccumulatedTorque );
-                    appendDiagnosticsLine( "Instantaneous Cadence", instantaneousCadence );
-                    appendDiagnosticsLine( "Crank Ticks", crankTicks );
-                    appendDiagnosticsLine( "Event Count", eventCount );
+                    appendDiagnosticsLine( "Delta Event Count", record.deltaEventCount );
+                    appendDiagnosticsLine( "Delta Crank Period", record.deltaCrankPeriod );
+                    appendDiagnosticsLine( "Delta Accumulated Torque", record.deltaAccumulatedTorque );
+                    appendDiagnosticsLine( "Instantaneous Cadence", record.instantaneousCadence );
+                    appendDiagnosticsLine( "Crank Ticks", record.crankTicks );
+                    appendDiagnosticsLine( "Event Count", record.eventCount );
                 }
 
                 if ( powerTable.count( sensorID ) == 0 )
@@ -2268,14 +1995,6 @@ amDeviceType antPowerProcessing::processPowerMeterB12SemiCooked
 
         if ( result == POWER_METER )
         {
-            double       power              = getPower( sensorID );
-            unsigned int zeroTimeCount      = getZeroTimeCount( sensorID );
-            unsigned int cadence            = getCadence( sensorID );
-            double       torque             = getTorque( sensorID );
-            double       speed              = 0;
-            double       wheelCircumference = 0;
-            double       gearRatio          = 0;
-
             if ( nbWords > counter )
             {
                 curVersion = words[ counter++ ];
@@ -2285,41 +2004,7 @@ amDeviceType antPowerProcessing::processPowerMeterB12SemiCooked
                 }
             }
 
-            if ( isUsedAsSpeedSensor( sensorID ) )
-            {
-                speed              = getSpeed( sensorID );
-                wheelCircumference = getWheelCircumference( sensorID );
-                gearRatio          = getNbMagnets( sensorID );
-            }
-
-            createOutputHeader( sensorID, timeStampBuffer );
-            createPWRB12ResultString
-            (
-                power,
-                cadence,
-                torque,
-                zeroTimeCount,
-                eventCount,
-                deltaEventCount,
-                deltaCrankPeriod,
-                deltaAccumulatedTorque,
-                instantaneousCadence,
-                crankTicks,
-                isUsedAsSpeedSensor( sensorID ),
-                speed,
-                wheelCircumference,
-                gearRatio
-            );
-            appendOutputFooter( curVersion );
-            if ( isUsedAsSpeedSensor( sensorID ) )
-            {
-                setSpeed( sensorID, speed );
-            }
-
-            setPower  ( sensorID, power );
-            setTorque ( sensorID, torque );
-            setCadence( sensorID, cadence );
-            setZeroTimeCount( sensorID, zeroTimeCount );
+            outputPowerB12Record( sensorID, timeStampBuffer, curVersion, record );
         }
 
         if ( result == OTHER_DEVICE )
@@ -2349,19 +2034,14 @@ bool antPowerProcessing::createB13ResultString
     const amSplitString &words
 )
 {
-    bool         result                      = false;
-    unsigned int nbWords                     = words.size();
-    unsigned int counter                     = 0;
-    unsigned int rawLeftTorqueEffectiveness  = 0;
-    unsigned int rawRightTorqueEffectiveness = 0;
-    unsigned int rawLeftPedalSmoothness      = 0;
-    unsigned int rawRightPedalSmoothness     = 0;
-    unsigned int deltaEventCount             = 0;
-    unsigned int totalEventCount             = 0;
-    amString     curVersion                  = getVersion();
-    amString     sensorID;
-    amString     timeStampBuffer;
-    amString     semiCookedString;
+    bool              result     = false;
+    unsigned int      nbWords    = words.size();
+    unsigned int      counter    = 0;
+    antPowerB13Record record     = antPowerB13Record();
+    amString          curVersion = getVersion();
+    amString          sensorID;
+    amString          timeStampBuffer;
+    amString          semiCookedString;
 
     if ( nbWords > 7 )
     {
@@ -2376,25 +2056,25 @@ bool antPowerProcessing::createB13ResultString
         }
         if ( ( semiCookedString == C_SEMI_COOKED_SYMBOL_AS_STRING ) && isPowerMeterPedalSmoothness( sensorID ) )
         {
-            result                      = true;
-            rawLeftTorqueEffectiveness  = words[ counter++ ].toUInt();     //  3
-            rawRightTorqueEffectiveness = words[ counter++ ].toUInt();     //  4
-            rawLeftPedalSmoothness      = words[ counter++ ].toUInt();     //  5
-            rawRightPedalSmoothness     = words[ counter++ ].toUInt();     //  6
+            result                          = true;
+            record.leftTorqueEffectiveness  = words[ counter++ ].toUInt();     //  3
+            record.rightTorqueEffectiveness = words[ counter++ ].toUInt();     //  4
+            record.leftPedalSmoothness      = words[ counter++ ].toUInt();     //  5
+            record.rightPedalSmoothness     = words[ counter++ ].toUInt();     //  6
             if ( words[ counter ].isUnsignedInteger() )
             {
                 // Previous Format did not have deltaEventCount as 7th output item (bridge2txt s/w version instead)
-                deltaEventCount         = words[ counter++ ].toUInt();     //  7
+                record.deltaEventCount      = words[ counter++ ].toUInt();     //  7
             }
-            totalEventCount             = totalCountTable[ sensorID ] + deltaEventCount;
-            totalCountTable[ sensorID ] = totalEventCount;
+            record.totalEventCount          = totalCountTable[ sensorID ] + record.deltaEventCount;
+            totalCountTable[ sensorID ]     = record.totalEventCount;
 
             if ( diagnostics )
             {
-                appendDiagnosticsLine( "Raw Left Torque Effectiveness", rawLeftTorqueEffectiveness );
-                appendDiagnosticsLine( "Raw Right Torque Effectiveness", rawRightTorqueEffectiveness );
-                appendDiagnosticsLine( "Raw Left Pedal Smoothness", rawLeftPedalSmoothness );
-                appendDiagnosticsLine( "Raw Right Pedal Smoothness", rawRightPedalSmoothness );
+                appendDiagnosticsLine( "Raw Left Torque Effectiveness", record.leftTorqueEffectiveness );
+                appendDiagnosticsLine( "Raw Right Torque Effectiveness", record.rightTorqueEffectiveness );
+                appendDiagnosticsLine( "Raw Left Pedal Smoothness", record.leftPedalSmoothness );
+                appendDiagnosticsLine( "Raw Right Pedal Smoothness", record.rightPedalSmoothness );
             }
         }
     }
@@ -2410,17 +2090,7 @@ bool antPowerProcessing::createB13ResultString
             }
         }
 
-        createOutputHeader( sensorID, timeStampBuffer );
-        createPWRB13ResultString
-        (
-            rawLeftTorqueEffectiveness,
-            rawRightTorqueEffectiveness,
-            rawLeftPedalSmoothness,
-            rawRightPedalSmoothness,
-            deltaEventCount,
-            totalEventCount
-        );
-        appendOutputFooter( curVersion );
+        outputRecord( antRecordContext( sensorID, timeStampBuffer, curVersion ), record );
     }
 
     return result;
@@ -2428,35 +2098,30 @@ bool antPowerProcessing::createB13ResultString
 
 amDeviceType antPowerProcessing::processPowerMeterB13
 (
-    const amString &deviceIDNo,
+    unsigned int    deviceIDNo,
     const amString &timeStampBuffer,
     BYTE            payLoad[]
 )
 {
-    amDeviceType result                      = POWER_METER;
-    amString     sensorID                    = amString( C_PM_PEDAL_SMOOTH_HEAD ) + deviceIDNo;
-    unsigned int eventCount                  = 0;
-    unsigned int rawLeftTorqueEffectiveness  = 0;
-    unsigned int rawRightTorqueEffectiveness = 0;
-    unsigned int rawLeftPedalSmoothness      = 0;
-    unsigned int rawRightPedalSmoothness     = 0;
-    unsigned int deltaEventCount             = 0;
-    unsigned int totalEventCount             = 0;
-    unsigned int rollOver                    = 0;
-    bool         rollOverHappened            = false;
-    bool         left                        = false;
-    char         auxBuffer[ C_MEDIUM_BUFFER_SIZE ] = { 0 };
+    amDeviceType      result                            = POWER_METER;
+    antSensorHandle   sensorID                          = sensorStates.intern( C_PM_PEDAL_SMOOTH_HEAD, deviceIDNo );
+    antPowerB13Record record                            = antPowerB13Record();
+    unsigned int      eventCount                        = 0;
+    unsigned int      rollOver                          = 0;
+    bool              rollOverHappened                  = false;
+    bool              left                              = false;
+    char              auxBuffer[ C_MEDIUM_BUFFER_SIZE ] = { 0 };
 
     if ( ( eventCountTable.count( sensorID ) == 0 ) || ( totalCountTable.count( sensorID ) == 0 ) )
     {
         appendPowerSensor( sensorID );
     }
 
-    eventCount                  = byte2UInt( payLoad[ 1 ] );
-    rawLeftTorqueEffectiveness  = byte2UInt( payLoad[ 2 ] );
-    rawRightTorqueEffectiveness = byte2UInt( payLoad[ 3 ] );
-    rawLeftPedalSmoothness      = byte2UInt( payLoad[ 4 ] );
-    rawRightPedalSmoothness     = byte2UInt( payLoad[ 5 ] );
+    eventCount                      = byte2UInt( payLoad[ 1 ] );
+    record.leftTorqueEffectiveness  = byte2UInt( payLoad[ 2 ] );
+    record.rightTorqueEffectiveness = byte2UInt( payLoad[ 3 ] );
+    record.leftPedalSmoothness      = byte2UInt( payLoad[ 4 ] );
+    record.rightPedalSmoothness     = byte2UInt( payLoad[ 5 ] );
 
     // - - - - - - - - - - - - - - - -
     // Event Count
@@ -2464,15 +2129,15 @@ amDeviceType antPowerProcessing::processPowerMeterB13
     if ( isLeftCrankEvent( sensorID, eventCount, rollOver ) )
     {
         left                        = true;
-        deltaEventCount             = getDeltaInt( rollOverHappened, sensorID, rollOver, eventCountTable, eventCount );
-        totalEventCount             = totalCountTable[ sensorID ] + deltaEventCount;
-        totalCountTable[ sensorID ] = totalEventCount;
+        record.deltaEventCount      = getDeltaInt( rollOverHappened, sensorID, rollOver, eventCountTable, eventCount );
+        record.totalEventCount      = totalCountTable[ sensorID ] + record.deltaEventCount;
+        totalCountTable[ sensorID ] = record.totalEventCount;
     }
     else
     {
-        deltaEventCount                  = getDeltaInt( rollOverHappened, sensorID, rollOver, otherEventCountTable, eventCount );
-        totalEventCount                  = otherTotalCountTable[ sensorID ] + deltaEventCount;
-        otherTotalCountTable[ sensorID ] = totalEventCount;
+        record.deltaEventCount           = getDeltaInt( rollOverHappened, sensorID, rollOver, otherEventCountTable, eventCount );
+        record.totalEventCount           = otherTotalCountTable[ sensorID ] + record.deltaEventCount;
+        otherTotalCountTable[ sensorID ] = record.totalEventCount;
     }
 
     if ( diagnostics )
@@ -2483,26 +2148,16 @@ amDeviceType antPowerProcessing::processPowerMeterB13
         {
             sprintf( auxBuffer, " (Rollover [%d] occurred)", rollOver );
         }
-        appendDiagnosticsLine( "Delta Event Count", deltaEventCount, auxBuffer );
-        appendDiagnosticsLine( "Raw Left Torque Effectiveness", payLoad[ 2 ], rawLeftTorqueEffectiveness );
-        appendDiagnosticsLine( "Raw Right Torque Effectiveness", payLoad[ 3 ], rawRightTorqueEffectiveness );
-        appendDiagnosticsLine( "Raw Left Pedal Smoothness", payLoad[ 4 ], rawLeftPedalSmoothness );
-        appendDiagnosticsLine( "Raw Right Pedal Smoothness", payLoad[ 5 ], rawRightPedalSmoothness );
+        appendDiagnosticsLine( "Delta Event Count", record.deltaEventCount, auxBuffer );
+        appendDiagnosticsLine( "Raw Left Torque Effectiveness", payLoad[ 2 ], record.leftTorqueEffectiveness );
+        appendDiagnosticsLine( "Raw Right Torque Effectiveness", payLoad[ 3 ], record.rightTorqueEffectiveness );
+        appendDiagnosticsLine( "Raw Left Pedal Smoothness", payLoad[ 4 ], record.leftPedalSmoothness );
+        appendDiagnosticsLine( "Raw Right Pedal Smoothness", payLoad[ 5 ], record.rightPedalSmoothness );
     }
 
     if ( result == POWER_METER )
     {
-        createOutputHeader( sensorID, timeStampBuffer );
-        createPWRB13ResultString
-        (
-            rawLeftTorqueEffectiveness,
-            rawRightTorqueEffectiveness,
-            rawLeftPedalSmoothness,
-            rawRightPedalSmoothness,
-            deltaEventCount,
-            totalEventCount
-        );
-        appendOutputFooter( getVersion() );
+        outputRecord( antRecordContext( sensorID, timeStampBuffer, getVersion() ), record );
     }
 
     return result;
@@ -2562,23 +2217,20 @@ amDeviceType antPowerProcessing::processPowerMeterB13SemiCooked
 //-------------------------------------------------------------------------------------------------//
 amDeviceType antPowerProcessing::processPowerMeterB20
 (
-    const amString &deviceIDNo,
+    unsigned int    deviceIDNo,
     const amString &timeStampBuffer,
     BYTE            payLoad[]
 )
 {
-    amDeviceType result               = OTHER_DEVICE;
-    amString     sensorID             = amString( C_CTF_POWER_DEVICE_HEAD ) + deviceIDNo;
-    unsigned int deltaTimeStamp       = 0;
-    unsigned int deltaEventCount      = 0;
-    unsigned int deltaTorqueTicks     = 0;
-    unsigned int factorySlope_Nm_10Hz = 0;
-    unsigned int timeStamp            = 0;
-    unsigned int eventCount           = 0;
-    unsigned int torqueTicks          = 0;
-    unsigned int rollOver             = 0;
-    bool         rollOverHappened     = false;
-    char         auxBuffer[ C_MEDIUM_BUFFER_SIZE ] = { 0 };
+    amDeviceType      result                            = OTHER_DEVICE;
+    antSensorHandle   sensorID                          = sensorStates.intern( C_CTF_POWER_DEVICE_HEAD, deviceIDNo );
+    antPowerB20Record record                            = antPowerB20Record();
+    unsigned int      timeStamp                         = 0;
+    unsigned int      eventCount                        = 0;
+    unsigned int      torqueTicks                       = 0;
+    unsigned int      rollOver                          = 0;
+    bool              rollOverHappened                  = false;
+    char              auxBuffer[ C_MEDIUM_BUFFER_SIZE ] = { 0 };
 
     if ( isRegisteredDevice( sensorID ) )
     {
@@ -2586,9 +2238,9 @@ amDeviceType antPowerProcessing::processPowerMeterB20
 
         // - - - - - - - - - - - - - - - -
         // Event Count
-        eventCount      = byte2UInt( payLoad[ 1 ] );
-        rollOver        = 256;
-        deltaEventCount = getDeltaInt( rollOverHappened, sensorID, rollOver, eventCountTable, eventCount );
+        eventCount             = byte2UInt( payLoad[ 1 ] );
+        rollOver               = 256;
+        record.deltaEventCount = getDeltaInt( rollOverHappened, sensorID, rollOver, eventCountTable, eventCount );
         if ( diagnostics )
         {
             appendDiagnosticsLine( "Event Count", payLoad[ 1 ], eventCount );
@@ -2597,7 +2249,7 @@ amDeviceType antPowerProcessing::processPowerMeterB20
             {
                 sprintf( auxBuffer, " (Rollover [%d] occurred)", rollOver );
             }
-            appendDiagnosticsLine( "Delta Event Count", deltaEventCount, auxBuffer );
+            appendDiagnosticsLine( "Delta Event Count", record.deltaEventCount, auxBuffer );
         }
         if ( eventCountTable[ sensorID ] == eventCount )
         {
@@ -2611,18 +2263,18 @@ amDeviceType antPowerProcessing::processPowerMeterB20
 
         // - - - - - - - - - - - - - - - -
         // Factory Slope (Nm/10Hz)
-        factorySlope_Nm_10Hz = byte2UInt( payLoad[ 2 ], payLoad[ 3 ] );
+        record.factorySlope = byte2UInt( payLoad[ 2 ], payLoad[ 3 ] );
         if ( diagnostics )
         {
-            appendDiagnosticsLine( "Factory Slope", payLoad[ 2 ], payLoad[ 3 ], factorySlope_Nm_10Hz, " (Nm/10Hz)" );
+            appendDiagnosticsLine( "Factory Slope", payLoad[ 2 ], payLoad[ 3 ], record.factorySlope, " (Nm/10Hz)" );
         }
 
 
         // - - - - - - - - - - - - - - - -
         // Time Stamp
-        timeStamp      = byte2UInt( payLoad[ 4 ], payLoad[ 5 ] );
-        rollOver       = 65536;  // 256^2
-        deltaTimeStamp = getDeltaInt( rollOverHappened, sensorID, rollOver, eventTimeTable, timeStamp );
+        timeStamp             = byte2UInt( payLoad[ 4 ], payLoad[ 5 ] );
+        rollOver              = 65536;  // 256^2
+        record.deltaTimeStamp = getDeltaInt( rollOverHappened, sensorID, rollOver, eventTimeTable, timeStamp );
         if ( diagnostics )
         {
             appendDiagnosticsLine( "Time Stamp", payLoad[ 4 ], payLoad[ 5 ], timeStamp );
@@ -2631,15 +2283,15 @@ amDeviceType antPowerProcessing::processPowerMeterB20
             {
                 sprintf( auxBuffer, " (Rollover [%d] occurred)", rollOver );
             }
-            appendDiagnosticsLine( "Delta Time Stamp", deltaTimeStamp, auxBuffer );
+            appendDiagnosticsLine( "Delta Time Stamp", record.deltaTimeStamp, auxBuffer );
         }
 
 
         // - - - - - - - - - - - - - - - -
         // Accumulated Torque Ticks
-        torqueTicks      = byte2UInt( payLoad[ 6 ], payLoad[ 7 ] );
-        rollOver         = 65536;  // 256^2
-        deltaTorqueTicks = getDeltaInt( rollOverHappened, sensorID, rollOver, accumulatedTorqueTable, torqueTicks );
+        torqueTicks             = byte2UInt( payLoad[ 6 ], payLoad[ 7 ] );
+        rollOver                = 65536;  // 256^2
+        record.deltaTorqueTicks = getDeltaInt( rollOverHappened, sensorID, rollOver, accumulatedTorqueTable, torqueTicks );
         if ( diagnostics )
         {
             appendDiagnosticsLine( "Torque Ticks", payLoad[ 6 ], payLoad[ 7 ], torqueTicks );
@@ -2648,59 +2300,13 @@ amDeviceType antPowerProcessing::processPowerMeterB20
             {
                 sprintf( auxBuffer, " (Rollover [%d] occurred)", rollOver );
             }
-            appendDiagnosticsLine( "Delta Torque Ticks", deltaTorqueTicks, auxBuffer );
+            appendDiagnosticsLine( "Delta Torque Ticks", record.deltaTorqueTicks, auxBuffer );
         }
     }
 
     if ( result == POWER_METER )
     {
-        double       power              = getPower( sensorID );
-        unsigned int cadence            = getCadence( sensorID );
-        double       torque             = getTorque( sensorID );
-        unsigned int zeroTimeCount      = getZeroTimeCount( sensorID );
-        unsigned int powerMeterOffset   = getOffset( sensorID );
-        unsigned int userDefinedSlope   = getSlope_Nm_10Hz( sensorID );
-        double       speed              = 0;
-        double       wheelCircumference = 0;
-        double       gearRatio          = 0;
-
-        createOutputHeader( sensorID, timeStampBuffer );
-        if ( isUsedAsSpeedSensor( sensorID ) )
-        {
-            speed              = getSpeed( sensorID );
-            wheelCircumference = getWheelCircumference( sensorID );
-            gearRatio          = getNbMagnets( sensorID );
-        }
-
-        createPWRB20ResultString
-        (
-            power,
-            cadence,
-            torque,
-            zeroTimeCount,
-            deltaEventCount,
-            deltaTimeStamp,
-            deltaTorqueTicks,
-            factorySlope_Nm_10Hz,
-            powerMeterOffset,
-            userDefinedSlope,
-            isUsedAsSpeedSensor( sensorID ),
-            speed,
-            wheelCircumference,
-            gearRatio
-        );
-
-        if ( isUsedAsSpeedSensor( sensorID ) )
-        {
-            setSpeed( sensorID, speed );
-        }
-
-        appendOutputFooter( getVersion() );
-
-        setPower  ( sensorID, power );
-        setTorque ( sensorID, torque );
-        setCadence( sensorID, cadence );
-        setZeroTimeCount( sensorID, zeroTimeCount );
+        outputPowerB20Record( sensorID, timeStampBuffer, getVersion(), record );
     }
 
     return result;
@@ -2723,17 +2329,14 @@ amDeviceType antPowerProcessing::processPowerMeterB20SemiCooked
     amDeviceType result = OTHER_DEVICE;
     if ( !inputBuffer.empty() )
     {
-        amSplitString words;
-        unsigned int  nbWords              = words.split( inputBuffer );
-        amString      sensorID;
-        amString      timeStampBuffer;
-        amString      curVersion           = getVersion();
-        amString      semiCookedString;
-        unsigned int  deltaEventCount      = 0;
-        unsigned int  deltaTimeStamp       = 0;
-        unsigned int  deltaTorqueTicks     = 0;
-        unsigned int  factorySlope_Nm_10Hz = 0;
-        unsigned int  counter              = 0;
+        amSplitString     words;
+        unsigned int      nbWords    = words.split( inputBuffer );
+        amString          sensorID;
+        amString          timeStampBuffer;
+        amString          curVersion = getVersion();
+        amString          semiCookedString;
+        antPowerB20Record record     = antPowerB20Record();
+        unsigned int      counter    = 0;
 
         if ( nbWords > 6 )
         {
@@ -2748,17 +2351,17 @@ amDeviceType antPowerProcessing::processPowerMeterB20SemiCooked
             }
             if ( isRegisteredDevice( sensorID ) && ( semiCookedString == C_SEMI_COOKED_SYMBOL_AS_STRING ) && isCrankTorqueFrequencyPowerSensor( sensorID ) )
             {
-                result               = POWER_METER;
-                deltaEventCount      = words[ counter++ ].toUInt();      // 3
-                deltaTimeStamp       = words[ counter++ ].toUInt();      // 4
-                deltaTorqueTicks     = words[ counter++ ].toUInt();      // 5
-                factorySlope_Nm_10Hz = words[ counter++ ].toUInt();      // 6
+                result                  = POWER_METER;
+                record.deltaEventCount  = words[ counter++ ].toUInt();      // 3
+                record.deltaTimeStamp   = words[ counter++ ].toUInt();      // 4
+                record.deltaTorqueTicks = words[ counter++ ].toUInt();      // 5
+                record.factorySlope     = words[ counter++ ].toUInt();      // 6
                 if ( diagnostics )
                 {
-                    appendDiagnosticsLine( "Delta Event Count", deltaEventCount );
-                    appendDiagnosticsLine( "Delta Time Stamp", deltaTimeStamp );
-                    appendDiagnosticsLine( "Delta Torque Ticks", deltaTorqueTicks );
-                    appendDiagnosticsLine( "Factory Slope (Nm/10Hz)", factorySlope_Nm_10Hz );
+                    appendDiagnosticsLine( "Delta Event Count", record.deltaEventCount );
+                    appendDiagnosticsLine( "Delta Time Stamp", record.deltaTimeStamp );
+                    appendDiagnosticsLine( "Delta Torque Ticks", record.deltaTorqueTicks );
+                    appendDiagnosticsLine( "Factory Slope (Nm/10Hz)", record.factorySlope );
                 }
 
                 if ( powerTable.count( sensorID ) == 0 )
@@ -2770,16 +2373,6 @@ amDeviceType antPowerProcessing::processPowerMeterB20SemiCooked
 
         if ( result == POWER_METER )
         {
-            double       power              = getPower( sensorID );
-            unsigned int cadence            = getCadence( sensorID );
-            unsigned int zeroTimeCount      = getZeroTimeCount( sensorID );
-            double       torque             = getTorque( sensorID );
-            unsigned int powerMeterOffset   = getOffset( sensorID );
-            unsigned int userDefinedSlope   = getSlope_Nm_10Hz( sensorID );
-            double       speed              = 0;
-            double       wheelCircumference = 0;
-            double       gearRatio          = 0;
-
             if ( nbWords > counter )
             {
                 curVersion = words[ counter++ ];
@@ -2789,42 +2382,7 @@ amDeviceType antPowerProcessing::processPowerMeterB20SemiCooked
                 }
             }
 
-            if ( isUsedAsSpeedSensor( sensorID ) )
-            {
-                speed              = getSpeed( sensorID );
-                wheelCircumference = getWheelCircumference( sensorID );
-                gearRatio          = getNbMagnets( sensorID );
-            }
-
-            createOutputHeader( sensorID, timeStampBuffer );
-            createPWRB20ResultString
-            (
-                power,
-                cadence,
-                torque,
-                zeroTimeCount,
-                deltaEventCount,
-                deltaTimeStamp,
-                deltaTorqueTicks,
-                factorySlope_Nm_10Hz,
-                powerMeterOffset,
-                userDefinedSlope,
-                isUsedAsSpeedSensor( sensorID ),
-                speed,
-                wheelCircumference,
-                gearRatio
-            );
-            appendOutputFooter( curVersion );
-
-            if ( isUsedAsSpeedSensor( sensorID ) )
-            {
-                setSpeed( sensorID, speed );
-            }
-
-            setPower  ( sensorID, power );
-            setTorque ( sensorID, torque );
-            setCadence( sensorID, cadence );
-            setZeroTimeCount( sensorID, zeroTimeCount );
+            outputPowerB20Record( sensorID, timeStampBuffer, curVersion, record );
         }
         else
         {
@@ -2901,8 +2459,6 @@ bool antPowerProcessing::createB46ResultString
 
     if ( result )
     {
-        createOutputHeader( sensorID, timeStampBuffer );
-        createCommonResultStringPage70( sensorID, outputPageNo, descriptor1, descriptor2, requestedResponse, requestedPageNo, commandType );
         if ( nbWords > counter )
         {
             curVersion = words[ counter++ ];                      //  8
@@ -2911,7 +2467,7 @@ bool antPowerProcessing::createB46ResultString
                 appendDiagnosticsLine( "Version", curVersion );
             }
         }
-        appendOutputFooter( curVersion );
+        outputCommonPage70Record( antRecordContext( sensorID, timeStampBuffer, curVersion ), outputPageNo, descriptor1, descriptor2, requestedResponse, requestedPageNo, commandType );
     }
     return result;
 }
@@ -2925,19 +2481,19 @@ bool antPowerProcessing::createB46ResultString
 // ---------------------------------------------------------------------------------------------------
 amDeviceType antPowerProcessing::processPowerMeterB46
 (
-    const amString &deviceIDNo,
+    unsigned int    deviceIDNo,
     const amString &timeStampBuffer,
     BYTE            payLoad[]
 )
 {
-    amDeviceType result            = POWER_METER;
-    amString     sensorID          = amString( C_PM_REQUEST_HEAD ) + deviceIDNo;
-    unsigned int descriptor1       = byte2UInt( payLoad[ 3 ] );
-    unsigned int descriptor2       = byte2UInt( payLoad[ 4 ] );
-    unsigned int requestedResponse = byte2UInt( payLoad[ 5 ] );
-    unsigned int requestedPageNo   = byte2UInt( payLoad[ 6 ] );
-    unsigned int commandType       = byte2UInt( payLoad[ 7 ] );
-    bool         outputPageNo      = false;  // The page number is already mentioned in the meassage header (PWBR46)
+    amDeviceType    result            = POWER_METER;
+    antSensorHandle sensorID          = sensorStates.intern( C_PM_REQUEST_HEAD, deviceIDNo );
+    unsigned int    descriptor1       = byte2UInt( payLoad[ 3 ] );
+    unsigned int    descriptor2       = byte2UInt( payLoad[ 4 ] );
+    unsigned int    requestedResponse = byte2UInt( payLoad[ 5 ] );
+    unsigned int    requestedPageNo   = byte2UInt( payLoad[ 6 ] );
+    unsigned int    commandType       = byte2UInt( payLoad[ 7 ] );
+    bool            outputPageNo      = false;  // The page number is already mentioned in the meassage header (PWBR46)
 
     // ---------------------------------------------------------------
     // Payload
@@ -2961,9 +2517,7 @@ amDeviceType antPowerProcessing::processPowerMeterB46
 
     if ( result == POWER_METER )
     {
-        createOutputHeader( sensorID, timeStampBuffer );
-        createCommonResultStringPage70( sensorID, outputPageNo, descriptor1, descriptor2, requestedResponse, requestedPageNo, commandType );
-        appendOutputFooter( getVersion() );
+        outputCommonPage70Record( antRecordContext( sensorID, timeStampBuffer, getVersion() ), outputPageNo, descriptor1, descriptor2, requestedResponse, requestedPageNo, commandType );
     }
 
     return result;
@@ -3058,8 +2612,6 @@ bool antPowerProcessing::createB50ResultString
                 appendDiagnosticsLine( "Hardware Revision", hardwareRevision );
                 appendDiagnosticsLine( "Manufacturer ID", manufacturerID );
             }
-            createOutputHeader( sensorID, timeStampBuffer );
-            createCommonResultStringPage80( sensorID, outputPageNo, manufacturerID, hardwareRevision, modelNumber );
         }
     }
 
@@ -3073,7 +2625,7 @@ bool antPowerProcessing::createB50ResultString
                 appendDiagnosticsLine( "Version", curVersion );
             }
         }
-        appendOutputFooter( curVersion );
+        outputCommonPage80Record( antRecordContext( sensorID, timeStampBuffer, curVersion ), outputPageNo, manufacturerID, hardwareRevision, modelNumber );
     }
 
     return result;
@@ -3093,17 +2645,17 @@ bool antPowerProcessing::createB50ResultString
 // ---------------------------------------------------------------------------------------------------
 amDeviceType antPowerProcessing::processPowerMeterB50
 (
-    const amString &deviceIDNo,
+    unsigned int    deviceIDNo,
     const amString &timeStampBuffer,
     BYTE            payLoad[]
 )
 {
-    amDeviceType result           = POWER_METER;
-    unsigned int hardwareRevision = byte2UInt( payLoad[ 3 ] );
-    unsigned int manufacturerID   = byte2UInt( payLoad[ 5 ], payLoad[ 4 ] );
-    unsigned int modelNumber      = byte2UInt( payLoad[ 7 ], payLoad[ 6 ] );
-    amString     sensorID         = amString( C_PM_MFR_INFO_HEAD ) + deviceIDNo;
-    bool         outputPageNo     = false;  // The page number is already mentioned in the meassage header (PWBR50)
+    amDeviceType    result           = POWER_METER;
+    unsigned int    hardwareRevision = byte2UInt( payLoad[ 3 ] );
+    unsigned int    manufacturerID   = byte2UInt( payLoad[ 5 ], payLoad[ 4 ] );
+    unsigned int    modelNumber      = byte2UInt( payLoad[ 7 ], payLoad[ 6 ] );
+    antSensorHandle sensorID         = sensorStates.intern( C_PM_MFR_INFO_HEAD, deviceIDNo );
+    bool            outputPageNo     = false;  // The page number is already mentioned in the meassage header (PWBR50)
 
     if ( diagnostics )
     {
@@ -3112,9 +2664,7 @@ amDeviceType antPowerProcessing::processPowerMeterB50
         appendDiagnosticsLine( "Hardware Revision", payLoad[ 3 ], hardwareRevision );
     }
 
-    createOutputHeader( sensorID, timeStampBuffer );
-    createCommonResultStringPage80( sensorID, outputPageNo, manufacturerID, hardwareRevision, modelNumber );
-    appendOutputFooter( getVersion() );
+    outputCommonPage80Record( antRecordContext( sensorID, timeStampBuffer, getVersion() ), outputPageNo, manufacturerID, hardwareRevision, modelNumber );
 
     return result;
 }
@@ -3200,8 +2750,6 @@ bool antPowerProcessing::createB51ResultString
                 appendDiagnosticsLine( "Serial Number", serialNumber );
                 appendDiagnosticsLine( "Software Revision", softwareRevision );
             }
-            createOutputHeader( sensorID, timeStampBuffer );
-            createCommonResultStringPage81( sensorID, outputPageNo, serialNumber, softwareRevision );
         }
     }
 
@@ -3215,7 +2763,7 @@ bool antPowerProcessing::createB51ResultString
                 appendDiagnosticsLine( "Version", curVersion );
             }
         }
-        appendOutputFooter( curVersion );
+        outputCommonPage81Record( antRecordContext( sensorID, timeStampBuffer, curVersion ), outputPageNo, serialNumber, softwareRevision );
     }
 
     return result;
@@ -3230,7 +2778,7 @@ bool antPowerProcessing::createB51ResultString
 //     "PWRB51_<device_ID> <seconds> payLoad[ 7 ], payLoad[ 6 ], payLoad[ 5 ], payLoad[ 4 ], <serialNumber>"
 //
 // Parameters:
-//    const amString &deviceIDNo        IN   Device ID (number).
+//    unsigned int    deviceIDNo        IN   Device ID (number).
 //    const amString &timeStampBuffer   IN   Time stamp.
 //    BYTE            payLoad[]         IN   Array of bytes with the data to be converted.
 //
@@ -3246,16 +2794,16 @@ bool antPowerProcessing::createB51ResultString
 // ---------------------------------------------------------------------------------------------------
 amDeviceType antPowerProcessing::processPowerMeterB51
 (
-    const amString &deviceIDNo,
+    unsigned int    deviceIDNo,
     const amString &timeStampBuffer,
     BYTE            payLoad[]
 )
 {
-    amDeviceType result           = POWER_METER;
-    amString     sensorID         = amString( C_PM_PROD_INFO_HEAD ) + deviceIDNo;
-    unsigned int serialNumber     = byte2UInt( payLoad[ 7 ], payLoad[ 6 ], payLoad[ 5 ], payLoad[ 4 ] );
-    unsigned int softwareRevision = byte2UInt( payLoad[ 3 ] );
-    bool         outputPageNo     = false;  // The page number is already mentioned in the meassage header (PWBR51)
+    amDeviceType    result           = POWER_METER;
+    antSensorHandle sensorID         = sensorStates.intern( C_PM_PROD_INFO_HEAD, deviceIDNo );
+    unsigned int    serialNumber     = byte2UInt( payLoad[ 7 ], payLoad[ 6 ], payLoad[ 5 ], payLoad[ 4 ] );
+    unsigned int    softwareRevision = byte2UInt( payLoad[ 3 ] );
+    bool            outputPageNo     = false;  // The page number is already mentioned in the meassage header (PWBR51)
 
     if ( diagnostics )
     {
@@ -3263,9 +2811,7 @@ amDeviceType antPowerProcessing::processPowerMeterB51
         appendDiagnosticsLine( "Software Revision", payLoad[ 3 ], softwareRevision );
     }
 
-    createOutputHeader( sensorID, timeStampBuffer );
-    createCommonResultStringPage81( sensorID, outputPageNo, serialNumber, softwareRevision );
-    appendOutputFooter( getVersion() );
+    outputCommonPage81Record( antRecordContext( sensorID, timeStampBuffer, getVersion() ), outputPageNo, serialNumber, softwareRevision );
 
     return result;
 }
@@ -3426,12 +2972,10 @@ bool antPowerProcessing::createB52ResultString
                 appendDiagnosticsLine( "Version", curVersion );
             }
         }
-        createOutputHeader( sensorID, timeStampBuffer );
-        commonPage = createCommonResultStringPage82( sensorID, outputPageNo, voltage256, status, deltaOperatingTime, resolution, nbBatteries, batteryID );
+        commonPage = outputCommonPage82Record( antRecordContext( sensorID, timeStampBuffer, getVersion() ), outputPageNo, voltage256, status, deltaOperatingTime, resolution, nbBatteries, batteryID );
         if ( commonPage )
         {
             result = POWER_METER;
-            appendOutputFooter( getVersion() );
         }
         else
         {
@@ -3444,15 +2988,16 @@ bool antPowerProcessing::createB52ResultString
 
 unsigned int antPowerProcessing::splitFormat137_B52
 (
-    const amString &inputBuffer,
-    amSplitString  &outWords
+    amSplitString &outWords
 )
 {
     unsigned int nbWords = 0;
-    if ( !inputBuffer.empty() )
+    if ( outWords.size() > 0 )
     {
         amSplitString inWords;
-        nbWords = inWords.split( inputBuffer );
+        // The words of the line become the input, the result replaces them.
+        inWords.swap( outWords );
+        nbWords = inWords.size();
 
         if ( nbWords >= 8 )
         {
@@ -3484,7 +3029,7 @@ unsigned int antPowerProcessing::splitFormat137_B52
             operatingTime   = inWords[ counter++ ].toUInt();               // Accumulative Operating Time
             if ( operatingTimeTable.count( sensorID ) == 0 )               //     must be converted to Delta Operating Time
             {
-                operatingTimeTable.insert( std::pair<amString, unsigned int>( sensorID, 0 ) );
+                operatingTimeTable.insert( sensorID, 0 );
             }
             deltaOperatingTime = operatingTime - operatingTimeTable[ sensorID ];
             operatingTimeTable[ sensorID ] = operatingTime;
@@ -3509,7 +3054,7 @@ unsigned int antPowerProcessing::splitFormat137_B52
 //     "PWRB52_<device_ID> <seconds> <battery_status> <voltage>"
 //
 // Parameters:
-//    const amString &deviceIDNo        IN   Device ID (number).
+//    unsigned int    deviceIDNo        IN   Device ID (number).
 //    const amString &timeStampBuffer   IN   Time stamp.
 //    BYTE            payLoad[]         IN   Array of bytes with the data to be converted.
 //
@@ -3525,26 +3070,26 @@ unsigned int antPowerProcessing::splitFormat137_B52
 // ---------------------------------------------------------------------------------------------------
 amDeviceType antPowerProcessing::processPowerMeterB52
 (
-    const amString &deviceIDNo,
+    unsigned int    deviceIDNo,
     const amString &timeStampBuffer,
     BYTE            payLoad[]
 )
 {
-    unsigned int deltaOperatingTime = 0;
-    unsigned int operatingTime      = 0;
-    unsigned int voltage256         = 0;
-    unsigned int voltageInt         = 0;
-    unsigned int nbBatteries        = 0;
-    unsigned int batteryID          = 0;
-    unsigned int status             = 0;
-    unsigned int resolution         = 0;
-    unsigned int rollOver           = 0;
-    amDeviceType result             = POWER_METER;
-    amString     sensorID           = amString( C_PM_STATUS_MSG_HEAD ) + deviceIDNo;
-    bool         rollOverHappened   = false;
-    bool         commonPage         = false;
-    bool         outputPageNo       = false;  // The page number is already mentioned in the meassage header (PWBR52)
-    char         auxBuffer[ C_MEDIUM_BUFFER_SIZE ] = { 0 };
+    unsigned int    deltaOperatingTime                = 0;
+    unsigned int    operatingTime                     = 0;
+    unsigned int    voltage256                        = 0;
+    unsigned int    voltageInt                        = 0;
+    unsigned int    nbBatteries                       = 0;
+    unsigned int    batteryID                         = 0;
+    unsigned int    status                            = 0;
+    unsigned int    resolution                        = 0;
+    unsigned int    rollOver                          = 0;
+    amDeviceType    result                            = POWER_METER;
+    antSensorHandle sensorID                          = sensorStates.intern( C_PM_STATUS_MSG_HEAD, deviceIDNo );
+    bool            rollOverHappened                  = false;
+    bool            commonPage                        = false;
+    bool            outputPageNo                      = false;  // The page number is already mentioned in the meassage header (PWBR52)
+    char            auxBuffer[ C_MEDIUM_BUFFER_SIZE ] = { 0 };
 
     // Byte 2: Identifies the battery in the system to which this battery status
     //         pertains and specifies how many batteries are available in the system.
@@ -3553,8 +3098,8 @@ amDeviceType antPowerProcessing::processPowerMeterB52
     //         Set to 0xFF if not used.
     if ( ( totalTimeTable.count( sensorID ) == 0 ) && ( eventTimeTable.count( sensorID ) == 0 ) )
     {
-        operatingTimeTable.insert( std::pair<amString, double>( sensorID, 0 ) );
-        eventTimeTable.insert( std::pair<amString, unsigned int>( sensorID, 0 ) );
+        operatingTimeTable.insert( sensorID, 0 );
+        eventTimeTable.insert( sensorID, 0 );
     }
 
     if ( payLoad[ 2 ] != 0xFF )
@@ -3605,12 +3150,10 @@ amDeviceType antPowerProcessing::processPowerMeterB52
         appendDiagnosticsLine( "Delta Cumulative Operating Time", deltaOperatingTime, auxBuffer );
     }
 
-    createOutputHeader( sensorID, timeStampBuffer );
-    commonPage = createCommonResultStringPage82( sensorID, outputPageNo, voltage256, status, deltaOperatingTime, resolution, nbBatteries, batteryID );
+    commonPage = outputCommonPage82Record( antRecordContext( sensorID, timeStampBuffer, getVersion() ), outputPageNo, voltage256, status, deltaOperatingTime, resolution, nbBatteries, batteryID );
     if ( commonPage )
     {
         result = POWER_METER;
-        appendOutputFooter( getVersion() );
     }
     else
     {
@@ -3641,13 +3184,10 @@ amDeviceType antPowerProcessing::processPowerMeterB52SemiCooked
         unsigned int  nbWords      = 0;
         amSplitString words;
 
-        if ( isSemiCookedFormat137( inputBuffer ) )
+        nbWords = words.split( inputBuffer );
+        if ( isSemiCookedFormat137( words ) )
         {
-            nbWords = splitFormat137_B52( inputBuffer, words );
-        }
-        else
-        {
-            nbWords = words.split( inputBuffer );
+            nbWords = splitFormat137_B52( words );
         }
 
         if ( nbWords > 3 )
@@ -3684,7 +3224,7 @@ amDeviceType antPowerProcessing::processPowerMeterB52SemiCooked
 // and put the result string into the outBuffer.
 //
 // Parameters:
-//    const amString &deviceIDNo        IN   Device ID (number).
+//    unsigned int    deviceIDNo        IN   Device ID (number).
 //    const amString &timeStampBuffer   IN   Time stamp.
 //    BYTE            payLoad[]         IN   Array of bytes with the data to be converted.
 //
@@ -3696,7 +3236,7 @@ amDeviceType antPowerProcessing::processPowerMeterB52SemiCooked
 // -------------------------------------------------------------------------------------------------//
 amDeviceType antPowerProcessing::processPowerMeter
 (
-    const amString &deviceIDNo,
+    unsigned int    deviceIDNo,
     const amString &timeStampBuffer,
     BYTE            payLoad[]
 )
@@ -3765,10 +3305,8 @@ amDeviceType antPowerProcessing::processPowerMeter
                  result = processPowerMeterB52( deviceIDNo, timeStampBuffer, payLoad );
                  break;
         default: sprintf( auxBuffer, "%2X_", payLoad[ 0 ] );
-                 sensorID = amString( C_POWER_DEVICE_HEAD ) + auxBuffer + deviceIDNo;
-                 createOutputHeader( sensorID, timeStampBuffer );
-                 commonPage = processCommonPages( sensorID, payLoad, outputPageNo );
-                 appendOutputFooter( getVersion() );
+                 sensorID = amString( C_POWER_DEVICE_HEAD ) + auxBuffer + amString( deviceIDNo );
+                 commonPage = processCommonPages( sensorID, timeStampBuffer, getVersion(), payLoad, outputPageNo );
                  if ( commonPage )
                  {
                      result = POWER_METER;
@@ -3905,12 +3443,10 @@ amDeviceType antPowerProcessing::processPowerMeterSemiCooked
                              // 0x52 = 82: Power Meter Battery Voltage Message (PWRB52)
                              result = processPowerMeterB52SemiCooked( inputBuffer );
                              break;
-                    default: createOutputHeader( sensorID, timeStampBuffer );
-                             commonPage = processCommonPagesSemiCooked( words, startCounter, outputPageNo );
+                    default: commonPage = processCommonPagesSemiCooked( words, startCounter, getVersion(), outputPageNo );
                              if ( commonPage )
                              {
                                  result = POWER_METER;
-                                 appendOutputFooter( getVersion() );
                              }
                              else
                              {
@@ -3929,1214 +3465,323 @@ amDeviceType antPowerProcessing::processPowerMeterSemiCooked
     return result;
 }
 
-void antPowerProcessing::createPMCalibrationResultString016
-(
-    unsigned int  ctfDefinedID,
-    unsigned int  messageValue
-)
-{
-    if ( outputAsJSON )
-    {
-        if ( semiCookedOut )
-        {
-            appendJSONItem( "calibration id", 16 );
-            appendJSONItem( "ctf defined id", ctfDefinedID );
-            appendJSONItem( "message value", messageValue );
-        }
-        else
-        {
-            if ( ctfDefinedID == 172 )
-            {
-                appendJSONItem( "calibration id", "ctf calibration response" );
-                if ( messageValue == 1 )
-                {
-                    appendJSONItem( "acknowledgement", C_OFFSET_JSON );
-                }
-                else if ( messageValue == 2 )
-                {
-                    appendJSONItem( "acknowledgement", C_SLOPE_JSON );
-                }
-                else if ( messageValue == 3 )
-                {
-                    appendJSONItem( "acknowledgement", C_SERIAL_NUMBER_JSON );
-                }
-            }
-            else
-            {
-                appendJSONItem( "calibration id", "ctf calibration request" );
-                if ( ctfDefinedID == 1 )
-                {
-                    appendJSONItem( C_OFFSET_JSON, messageValue );
-                }
-                else if ( ctfDefinedID == 2 )
-                {
-                    appendJSONItem( C_SLOPE_10_JSON, messageValue );
-                    appendJSONItem( C_SLOPE_JSON,    messageValue / 10.0, 1 );
-                }
-                else if ( ctfDefinedID == 3 )
-                {
-                    appendJSONItem( C_SERIAL_NUMBER_JSON, messageValue );
-                }
-            }
-        }
-    }
-    else
-    {
-        if ( semiCookedOut )
-        {
-            appendOutput( "16" );
-            appendOutput( ctfDefinedID );
-            appendOutput( messageValue );
-        }
-        else
-        {
-            if ( ctfDefinedID == 172 )
-            {
-                appendOutput( C_CTF_CALIBRATION_RESPONSE );
-                appendOutput4Way( messageValue, C_UNKNOWN, C_ZERO_OFFSET, C_SLOPE, C_SERIAL_NUMBER );
-            }
-            else
-            {
-                appendOutput( C_CTF_CALIBRATION_REQUEST );
-                appendOutput4Way( ctfDefinedID, C_UNKNOWN, C_ZERO_OFFSET, C_SLOPE, C_SERIAL_NUMBER );
-                appendOutput( messageValue );
-            }
-        }
-    }
-}
-
-void antPowerProcessing::createPMCalibrationResultString018
-(
-    int autoZeroEnable,
-    int autoZeroStatus
-)
-{
-    if ( outputAsJSON )
-    {
-        if ( semiCookedOut )
-        {
-            appendJSONItem( "calibration id", 18 );
-            appendJSONItem( "auto zero enable", autoZeroEnable );
-            appendJSONItem( "auto zero status", autoZeroStatus );
-        }
-        else
-        {
-            appendJSONItem( "calibration id", "auto zero support" );
-            appendJSONItemConditional( "auto zero enable", autoZeroEnable, "supported", "not supported" );
-            appendJSONItemConditional( "auto zero status", autoZeroStatus, C_ON_JSON,   C_OFF_JSON );
-        }
-    }
-    else
-    {
-        if ( semiCookedOut )
-        {
-            appendOutput( "18" );
-            appendOutput( autoZeroEnable );
-            appendOutput( autoZeroStatus );
-        }
-        else
-        {
-            appendOutput( C_AUTO_ZERO_ENABLE );
-            appendOutputConditional( autoZeroEnable, C_SUPPORTED_ID, C_NOT_SUPPORTED_ID );
-            appendOutput( C_AUTO_ZERO_STATUS );
-            appendOutputConditional( autoZeroStatus, C_ON, C_OFF );
-        }
-    }
-}
-
-void antPowerProcessing::createPMCalibrationResultString170
-(
-    void
-)
-{
-    if ( outputAsJSON )
-    {
-        appendJSONItemConditional( "calibration id", semiCookedOut, 170, "calibration request" );
-    }
-    else
-    {
-        appendOutputConditional( semiCookedOut, 170, C_CALIBRATION_REQUEST_MANUAL_ZERO );
-    }
-}
-
-void antPowerProcessing::createPMCalibrationResultString171
-(
-    unsigned int autoZeroStatus
-)
-{
-    if ( outputAsJSON )
-    {
-        if ( semiCookedOut )
-        {
-            appendJSONItem( "calibration id", 171 );
-            appendJSONItem( "auto zero status", autoZeroStatus );
-        }
-        else
-        {
-            appendJSONItem( "calibration request", "auto zero configuration" );
-            appendJSONItemConditional( "auto zero", autoZeroStatus == 0, "off", ( ( autoZeroStatus == 1 ) ? "on" : "not supported" ) );
-        }
-    }
-    else
-    {
-        if ( semiCookedOut )
-        {
-            appendOutput( "171" );
-            appendOutput( autoZeroStatus );
-        }
-        else
-        {
-            appendOutput( C_CALIBRATION_REQUEST_AUTO_ZERO );
-            appendOutput( C_AUTO_ZERO );
-            appendOutputConditional( autoZeroStatus == 0, C_OFF, ( ( autoZeroStatus == 1 ) ? C_ON : C_NOT_SUPPORTED_ID ) );
-        }
-    }
-}
-
-void antPowerProcessing::createPMCalibrationResultString172
-(
-    int autoZeroStatus,
-    int messageValue
-)
-{
-    if ( outputAsJSON )
-    {
-        if ( semiCookedOut )
-        {
-            appendJSONItem( "calibration id", 172 );
-            appendJSONItem( "auto zero status", autoZeroStatus );
-        }
-        else
-        {
-            appendJSONItem( "manual zero", "success" );
-            appendJSONItemConditional( "auto zero", autoZeroStatus == 0, "off", ( ( autoZeroStatus == 1 ) ? "on" : "not supported" ) );
-            appendJSONItem( "value", messageValue );
-        }
-    }
-    else
-    {
-        if ( semiCookedOut )
-        {
-            appendOutput( "172" );
-            appendOutput( autoZeroStatus );
-            appendOutput( messageValue );
-        }
-        else
-        {
-            appendOutput( C_CALIBRATION_RESPONSE_MANUAL_ZERO_SUCCESS );
-            appendOutput( C_AUTO_ZERO );
-            appendOutputConditional( autoZeroStatus == 0, C_OFF, ( ( autoZeroStatus == 1 ) ? C_ON : C_NOT_SUPPORTED_ID ) );
-            appendOutput( messageValue );
-        }
-    }
-}
-
-void antPowerProcessing::createPMCalibrationResultString175
-(
-    int autoZeroStatus,
-    int messageValue
-)
-{
-    if ( outputAsJSON )
-    {
-        if ( semiCookedOut )
-        {
-            appendJSONItem( "calibration id", 175 );
-            appendJSONItem( "auto zero status", autoZeroStatus );
-        }
-        else
-        {
-            appendJSONItem( "manual zero", "fail" );
-            appendJSONItemConditional( "auto zero", autoZeroStatus == 0, "off", ( ( autoZeroStatus == 1 ) ? "on" : "not supported" ) );
-            appendJSONItem( "value", messageValue );
-        }
-    }
-    else
-    {
-        if ( semiCookedOut )
-        {
-            appendOutput( "175" );
-            appendOutput( autoZeroStatus );
-            appendOutput( messageValue );
-        }
-        else
-        {
-            appendOutput( C_CALIBRATION_RESPONSE_MANUAL_ZERO_FAILED );
-            appendOutput( C_AUTO_ZERO );
-            appendOutputConditional( autoZeroStatus == 0, C_OFF, ( ( autoZeroStatus == 1 ) ? C_ON : C_NOT_SUPPORTED_ID ) );
-            appendOutput( messageValue );
-        }
-    }
-}
-
-void antPowerProcessing::createPMCalibrationResultString186
-(
-    void
-)
-{
-    if ( outputAsJSON )
-    {
-        appendJSONItemConditional( "calibration id", semiCookedOut, 186, "custom calibration parameter request" );
-    }
-    else
-    {
-        appendOutputConditional( semiCookedOut, 186, C_CUSTOM_CALIBRATION_PARAMETER_REQUEST );
-    }
-}
-
-void antPowerProcessing::createPMCalibrationResultString187
-(
-    void
-)
-{
-    if ( outputAsJSON )
-    {
-        appendJSONItemConditional( "calibration id", semiCookedOut, 187, "custom calibration parameter response" );
-    }
-    else
-    {
-        appendOutputConditional( semiCookedOut, 187, C_CUSTOM_CALIBRATION_PARAMETER_RESPONSE );
-    }
-}
-
-void antPowerProcessing::createPMCalibrationResultString188
+void antPowerProcessing::outputPowerB03Record
 (
-    void
+    const antSensorHandle &sensorID,
+    const amString        &timeStampBuffer,
+    const amString        &versionString,
+    antPowerB03Record     &record
 )
 {
-    if ( outputAsJSON )
-    {
-        appendJSONItemConditional( "calibration id", semiCookedOut, 188, "custom calibration parameter update" );
-    }
-    else
-    {
-        appendOutputConditional( semiCookedOut, 188, C_CUSTOM_CALIBRATION_PARAMETER_UPDATE );
-    }
-}
+    int scaleFactor = NEGATE_BINARY_INT( record.scaleFactor,  8 );
+    int value       = NEGATE_BINARY_INT( record.value,       16 );
 
-void antPowerProcessing::createPMCalibrationResultString189
-(
-    void
-)
-{
-    if ( outputAsJSON )
-    {
-        appendJSONItemConditional( "calibration id", semiCookedOut, 189, "custom calibration parameter update response" );
-    }
-    else
-    {
-        appendOutputConditional( semiCookedOut, 189, C_CUSTOM_CALIBRATION_PARAMETER_UPDATE_RESPONSE );
-    }
-}
+    record.timeValue           = totalTimeTable[ sensorID ] + ( double ) record.deltaEventTime / 2048.0;
+    record.measurementValue    = scaleValue( value, scaleFactor );
+    totalTimeTable[ sensorID ] = record.timeValue;
 
-void antPowerProcessing::createPWRB01ResultString
-(
-    unsigned int calibrationID,
-    unsigned int additionalData1,
-    unsigned int additionalData2
-)
-{
-    switch ( calibrationID )
-    {
-        case C_CTF_CALIBRATION_MESSAGE_ID:                      // 16 = 0x10: Crank Torque Frequency (CTF) Power Sensor (PWRB20) defined message
-             createPMCalibrationResultString016( additionalData1, additionalData2 );
-             break;
-        case C_AUTO_ZERO_SUPPORT_MESSAGE_ID:                    // 18 = 0x12: Auto Zero Support
-             createPMCalibrationResultString018( additionalData1, additionalData2 );
-             break;
-        case C_CALIBRATION_REQUEST_MANUAL_ZERO_ID:              // 170 = 0xAA: Calibration Request - Manual Zero
-             createPMCalibrationResultString170();
-             break;
-        case C_CALIBRATION_REQUEST_AUTO_ZERO_ID:                // 171 = 0xAB: Calibration Request - Auto Zero Configuration
-             createPMCalibrationResultString171( additionalData1 );
-             break;
-        case C_CALIBRATION_RESPONSE_MANUAL_ZERO_SUCCESS_ID:     // 172 = 0xAC: Calibration Response - Auto Zero Configuration Success
-             createPMCalibrationResultString172( additionalData1, additionalData2 );
-             break;
-        case C_CALIBRATION_RESPONSE_MANUAL_ZERO_FAIL_ID:        // 175 = 0xAF: Calibration Response - Auto Zero Configuration Fail
-             createPMCalibrationResultString175( additionalData1, additionalData2 );
-             break;
-        case C_CUSTOM_CALIBRATION_PARAMETER_REQUEST_ID:         // 186 = 0xBA: Custom Calibration Parameter Request
-             createPMCalibrationResultString186();
-             break;
-        case C_CUSTOM_CALIBRATION_PARAMETER_RESPONSE_ID:        // 187 = 0xBB: Custom Calibration Parameter Response
-             createPMCalibrationResultString187();
-             break;
-        case C_CUSTOM_CALIBRATION_PARAMETER_UPDATE_ID:          // 188 = 0xBC: Custom Calibration Parameter Update
-             createPMCalibrationResultString188();
-             break;
-        case C_CUSTOM_CALIBRATION_PARAMETER_UPDATE_RESPONSE_ID: // 188 = 0xBC: Custom Calibration Parameter Update Response
-             createPMCalibrationResultString189();
-             break;
-        default:
-             break;
-    }
+    outputRecord( antRecordContext( sensorID, timeStampBuffer, versionString ), record );
 }
 
-void antPowerProcessing::createPWRB02ResultString
+void antPowerProcessing::outputPowerB10Record
 (
-    unsigned int subPageNumber,
-    unsigned int additionalData1,
-    unsigned int additionalData2,
-    unsigned int additionalData3
+    const antSensorHandle &sensorID,
+    const amString        &timeStampBuffer,
+    const amString        &versionString,
+    antPowerB10Record     &record
 )
 {
-    if ( outputAsJSON )
-    {
-        appendJSONItem( "subpage number", subPageNumber );
-    }
-    if ( subPageNumber == 1 )
-    {
-        if ( semiCookedOut )
-        {
-            if ( outputAsJSON )
-            {
-                appendJSONItem( "crank length (raw)",  additionalData1 );
-                appendJSONItem( "sensor status",       additionalData2 );
-                appendJSONItem( "sensor capabilities", additionalData3 );
-            }
-            else
-            {
-                appendOutput( "1" );
-                appendOutput( additionalData1 );
-                appendOutput( additionalData2 );
-                appendOutput( additionalData3 );
-            }
-        }
-        else
-        {
-            double crankLength             = ( additionalData1 == 255 ) ? 0 : ( 110.0 + ( double ) additionalData1 / 2.0 );
-            int    crankLengthStatus       = ( additionalData2 & 3 );
-            int    sensorSWMismatchStatus  = ( ( additionalData2 >> 2 ) & 3 );
-            int    sensorAvailabiltyStatus = ( ( additionalData2 >> 4 ) & 3 );
-            int    customCalibrationStatus = ( ( additionalData2 >> 6 ) & 3 );
-            bool   autoCrankLength         = ( ( additionalData3 & 1 ) != 0 );
-
-            if ( outputAsJSON )
-            {
-                if ( additionalData1 == 255 )
-                {
-                    appendJSONItem( "crank length", C_UNDEFINED_JSON );
-                }
-                else
-                {
-                    appendJSONItem( "crank length", crankLength, 1 );   // <xyz>.0  or  <xyz>.5
-                }
-
-                appendJSONItem4Way( "crank length set",   crankLengthStatus,       C_UNDEFINED_JSON, "default length",     "manually set",      "automatically set" );
-                appendJSONItem4Way( "sw mismatch",        sensorSWMismatchStatus,  C_UNDEFINED_JSON, "right sensor older", "left sensor older", C_NONE_JSON );
-                appendJSONItem4Way( "sensor availabilty", sensorAvailabiltyStatus, C_UNDEFINED_JSON, "left present",       "right present",     "both present" );
-                appendJSONItem4Way( "custom calibration", customCalibrationStatus, C_UNDEFINED_JSON, "not required",       "required",          C_UNKNOWN_JSON );
-                appendJSONItemConditional( "determine crank length", autoCrankLength, "automatically", "manually" );
-            }
-            else
-            {
-                appendOutput( C_CRANK_LENGTH );
-                if ( additionalData1 == 255 )
-                {
-                    appendOutput( C_UNDEFINED );
-                }
-                else
-                {
-                    appendOutput( crankLength, 1 );
-                }
-
-                appendOutput( C_CRANK_LENGTH_USED );
-                appendOutput4Way( crankLengthStatus, C_INVALID, "DEFAULT_LENGTH", "MANUALLY_SET", "AUTOMATICALLY_SET" );
-
-                appendOutput( C_SW_MISMATCH );
-                appendOutput4Way( sensorSWMismatchStatus, C_UNDEFINED, "RIGHT_SENSOR_OLDER", "LEFT_SENSOR_OLDER", C_NONE_ID );
-
-                appendOutput( C_SENSOR_AVAILABILTY );
-                appendOutput4Way( sensorAvailabiltyStatus, C_UNDEFINED, "RIGHT_PRESENT", "LEFT_PRESENT", "BOTH_PRESENT" );
-
-                appendOutput( C_CUSTOM_CALIBRATION );
-                appendOutput4Way( customCalibrationStatus, C_UNDEFINED, "NOT_REQUIRED", "REQUIRED", C_UNKNOWN );
-
-                appendOutput( "DETERMINE_CRANK_LENGTH" );
-                appendOutputConditional( autoCrankLength, "AUTOMATICALLY", "MANUALLY" );
-            }
-        }
-    }
-}
+    unsigned int zeroTimeCount = getZeroTimeCount( sensorID );
 
-void antPowerProcessing::createPWRB03ResultString
-(
-    unsigned int additionalData1,
-    unsigned int additionalData2,
-    unsigned int additionalData3,
-    unsigned int additionalData4,
-    unsigned int additionalData5,
-    double       additionalDoubleData
-)
-{
-    if ( semiCookedOut )
-    {
-        if ( outputAsJSON )
-        {
-            appendJSONItem( "number of data types", additionalData1 );
-            appendJSONItem( "data type",            additionalData3 );
-            appendJSONItem( "scale factor",         additionalData3 );
-            appendJSONItem( "delta time stamp",     additionalData4 );
-            appendJSONItem( "value",                additionalData5 );
-        }
-        else
-        {
-            appendOutput( additionalData1 );
-            appendOutput( additionalData2 );
-            appendOutput( additionalData3 );
-            appendOutput( additionalData4 );
-            appendOutput( additionalData5 );
-        }
-    }
-    else
+    record.power                  = getPower( sensorID );
+    record.cadence                = getCadence( sensorID );
+    record.isMakeshiftSpeedSensor = isUsedAsSpeedSensor( sensorID );
+    if ( record.isMakeshiftSpeedSensor )
     {
-        int    scaleFactor = NEGATE_BINARY_INT( additionalData3,  8 );
-        int    value       = NEGATE_BINARY_INT( additionalData5, 16 );
-        double finalValue  = scaleValue( value, scaleFactor );
-        if ( outputAsJSON )
-        {
-            appendJSONItem( "number of data types", additionalData1 );
-            appendJSONItem( "time value",           additionalDoubleData, getValuePrecision() );
-        }
-        else
-        {
-            appendOutput( "NB_DATA_TYPES" );
-            appendOutput( additionalData1 );
-            appendOutput( "TIME_VALUE" );
-            appendOutput( additionalDoubleData, getValuePrecision() );
-        }
-
-        switch ( additionalData2 )
-        {
-            case  0: // Countdown (remaining process, in %)
-                     if ( outputAsJSON )
-                     {
-                         appendJSONItem( "countdown percentage", finalValue, 2 );
-                     }
-                     else
-                     {
-                         appendOutput( "COUNTDOWN_PCT" );
-                         appendOutput( finalValue, 2, "\%" );
-                     }
-                     break;
-            case  1: // Countdown (time of remaining process, in s)
-                     if ( outputAsJSON )
-                     {
-                         appendJSONItem( "countdown seconds", finalValue, 2 );
-                     }
-                     else
-                     {
-                         appendOutput( "COUNTDOWN_SEC" );
-                         appendOutput( finalValue, 2, "s" );
-                     }
-                     break;
-            case  8: // Torque (whole sensor, in Nm)
-                     if ( outputAsJSON )
-                     {
-                         appendJSONItem( "total torque", finalValue, 2 );
-                     }
-                     else
-                     {
-                         appendOutput( "TOTAL_TORQUE" );
-                         appendOutput( finalValue, 2, "Nm" );
-                     }
-                     break;
-            case  9: // Left Torque (in Nm)
-                     if ( outputAsJSON )
-                     {
-                         appendJSONItem( "left torque", finalValue, 2 );
-                     }
-                     else
-                     {
-                         appendOutput( "L_TORQUE" );
-                         appendOutput( finalValue, 2, "Nm" );
-                     }
-                     break;
-            case 10: // Right Torque (in Nm)
-                     if ( outputAsJSON )
-                     {
-                         appendJSONItem( "right torque", finalValue, 2 );
-                     }
-                     else
-                     {
-                         appendOutput( "R_TORQUE" );
-                         appendOutput( finalValue, 2, "Nm" );
-                     }
-                     break;
-            case 16: // Force (whole sensor, in N)
-                     if ( outputAsJSON )
-                     {
-                         appendJSONItem( "total force", finalValue, 2 );
-                     }
-                     else
-                     {
-                         appendOutput( "TOTAL_FORCE" );
-                         appendOutput( finalValue, 2, "N" );
-                     }
-                     break;
-            case 17: // Left Force (in N)
-                     if ( outputAsJSON )
-                     {
-                         appendJSONItem( "left force", finalValue, 2 );
-                     }
-                     else
-                     {
-                         appendOutput( "L_FORCE" );
-                         appendOutput( finalValue, 2, "N" );
-                     }
-                     break;
-            case 18: // Right Force (in N)
-                     if ( outputAsJSON )
-                     {
-                         appendJSONItem( "right force", finalValue, 2 );
-                     }
-                     else
-                     {
-                         appendOutput( "R_FORCE" );
-                         appendOutput( finalValue, 2, "N" );
-                     }
-                     break;
-            case 24: // Zero Offset
-                     if ( outputAsJSON )
-                     {
-                         appendJSONItem( "zero offset", finalValue, 2 );
-                     }
-                     else
-                     {
-                         appendOutput( "ZERO_OFFSET" );
-                         appendOutput( finalValue, 2 );
-                     }
-                     break;
-            case 25: // Temperature (in degree C)
-                     if ( outputAsJSON )
-                     {
-                         appendJSONItem( "temperature", finalValue, 2 );
-                     }
-                     else
-                     {
-                         appendOutput( "TEMP" );
-                         appendOutput( finalValue, 2, "C" );
-                     }
-                     break;
-            case 26: // Voltage (in V)
-                     if ( outputAsJSON )
-                     {
-                         appendJSONItem( "voltage", finalValue, 2 );
-                     }
-                     else
-                     {
-                         appendOutput( "VOLT" );
-                         appendOutput( finalValue, 2, "V" );
-                     }
-                     break;
-            default: // Reserved for future use
-                     if ( outputAsJSON )
-                     {
-                         appendJSONItem( "data type", C_UNDEFINED_JSON );
-                     }
-                     else
-                     {
-                         appendOutput( "UNUSED" );
-                         appendOutput( "0" );
-                     }
-                     break;
-        }
+        record.speed              = getSpeed( sensorID );
+        record.wheelCircumference = getWheelCircumference( sensorID );
+        record.gearRatio          = getNbMagnets( sensorID );
     }
-}
 
-void antPowerProcessing::createPWRB10ResultString
-(
-    double       &power,
-    unsigned int &cadence,
-    unsigned int &zeroTimeCount,
-    unsigned int  eventCount,
-    unsigned int  deltaEventCount,
-    unsigned int  deltaAccumulatedPower,
-    unsigned int  instantaneousPower,
-    unsigned int  instantaneousCadence,
-    unsigned int  pedalPower,
-    bool          isMakeshiftSpeedSensor,
-    double       &speed,
-    double        wheelCircumference,
-    double        gearRatio
-)
-{
-    if ( semiCookedOut )
+    if ( !semiCookedOut )
     {
-        if ( outputAsJSON )
-        {
-            appendJSONItem( "event count",             eventCount );
-            appendJSONItem( "delta event count",       deltaEventCount );
-            appendJSONItem( "delta accumulated power", deltaAccumulatedPower );
-            appendJSONItem( "instantaneous power",     instantaneousPower );
-            appendJSONItemConditional( "instantaneous cadence", instantaneousCadence != 255, instantaneousCadence, C_UNDEFINED_JSON );
-            appendJSONItem( "pedal power",             pedalPower );
-        }
-        else
-        {
-            appendOutput( eventCount );
-            appendOutput( deltaEventCount );
-            appendOutput( deltaAccumulatedPower );
-            appendOutput( instantaneousPower );
-            appendOutput( instantaneousCadence );
-            appendOutput( pedalPower );
-        }
-    }
-    else
-    {
-        int  pedalPowerContribution = 0;
-        bool rightPedal             = false;
-
-        cadence = instantaneousCadence;
-        if ( deltaEventCount == 0 )
+        record.cadence = record.instantaneousCadence;
+        if ( record.deltaEventCount == 0 )
         {
             ++zeroTimeCount;
             if ( zeroTimeCount > maxZeroTimeB10 )
             {
-                speed = 0;
-                power = 0;
+                record.speed = 0;
+                record.power = 0;
             }
         }
         else
         {
             zeroTimeCount = 0;
-            power = ( double ) deltaAccumulatedPower / ( double ) deltaEventCount;
-            if ( isMakeshiftSpeedSensor && ( instantaneousCadence != 255 ) )
+            record.power  = ( double ) record.deltaAccumulatedPower / ( double ) record.deltaEventCount;
+            if ( record.isMakeshiftSpeedSensor && ( record.instantaneousCadence != 255 ) )
             {
-                speed = ( ( wheelCircumference > 0 ) && ( gearRatio > 0 ) ) ? wheelCircumference * cadence * gearRatio / 60.0 : 0;
+                record.speed = ( ( record.wheelCircumference > 0 ) && ( record.gearRatio > 0 ) ) ? record.wheelCircumference * record.cadence * record.gearRatio / 60.0 : 0;
             }
         }
 
         // pedalPower: Bit 0 - 6: Pedal Power value (in %)
         //             Bit 7 = 0: Unknown Pedal Power Contribution
         //                     1: Right Pedal Power Contribution
-        if ( pedalPower == 0xFF )
+        if ( record.pedalPower == 0xFF )
         {
-            pedalPowerContribution = -1;
+            record.pedalPowerContribution = -1;
         }
-        else if ( pedalPower & 0x80 )
+        else if ( record.pedalPower & 0x80 )
         {
-            pedalPowerContribution = ( int ) ( pedalPower & 0x7F );
-            rightPedal             = true;
+            record.pedalPowerContribution = ( int ) ( record.pedalPower & 0x7F );
+            record.rightPedal             = true;
         }
         else
         {
-            pedalPowerContribution = ( int ) pedalPower;
-            rightPedal             = false;
+            record.pedalPowerContribution = ( int ) record.pedalPower;
+            record.rightPedal             = false;
         }
+    }
 
-        if ( outputAsJSON )
-        {
-            appendJSONItem( "event count", eventCount );
-            appendJSONItem( "power",       power,              getValuePrecision() );
-            appendJSONItemConditional( "cadence", instantaneousCadence != 255, cadence, C_UNDEFINED_JSON );
-            if ( isMakeshiftSpeedSensor )
-            {
-                appendJSONItem( "speed",               speed,              getValuePrecision() );
-                appendJSONItem( "wheel circumference", wheelCircumference, getValuePrecision() );
-                appendJSONItem( "gear ratio",          gearRatio,          getValuePrecision() );
-            }
-            appendJSONItemConditional( "pedal contribution percentage", pedalPowerContribution >= 0, pedalPowerContribution, C_UNKNOWN_JSON );
-            appendJSONItemConditional( "contributing pedal", ( pedalPowerContribution >= 0 ) && rightPedal, "right", C_UNKNOWN_JSON );
-        }
-        else
-        {
-            appendOutput( power, getValuePrecision() );
-            appendOutputConditional( instantaneousCadence != 255, cadence, C_UNDEFINED );
-            appendOutputConditional( pedalPowerContribution >= 0, pedalPowerContribution, "NO_PEDAL_POWER_CONTRIBUTION" );
-            appendOutputConditional( rightPedal, C_RIGHT_PEDAL, C_UNKNOWN_PEDAL );
-            appendOutput( eventCount );
-            if ( isMakeshiftSpeedSensor )
-            {
-                appendOutput( speed, getValuePrecision() );
-                appendOutput( wheelCircumference, getValuePrecision() );
-                appendOutput( gearRatio, getValuePrecision() );
-            }
-        }
+    outputRecord( antRecordContext( sensorID, timeStampBuffer, versionString ), record );
+
+    if ( record.isMakeshiftSpeedSensor )
+    {
+        setSpeed( sensorID, record.speed );
     }
+    setPower( sensorID,   record.power );
+    setCadence( sensorID, record.cadence );
+    setZeroTimeCount( sensorID, zeroTimeCount );
 }
 
-void antPowerProcessing::createPWRB11ResultString
+void antPowerProcessing::outputPowerB11Record
 (
-    double       &power,
-    unsigned int &cadence,
-    double       &torque,
-    unsigned int &zeroTimeCount,
-    unsigned int  deltaEventCount,
-    unsigned int  deltaWheelPeriod,
-    unsigned int  deltaAccumulatedTorque,
-    unsigned int  instantaneousCadence,
-    unsigned int  wheelTicks,
-    bool          isSpeedSensor,
-    double       &speed,
-    double        wheelCircumference
+    const antSensorHandle &sensorID,
+    const amString        &timeStampBuffer,
+    const amString        &versionString,
+    antPowerB11Record     &record
 )
 {
-    if ( semiCookedOut )
+    unsigned int zeroTimeCount = getZeroTimeCount( sensorID );
+
+    record.power         = getPower( sensorID );
+    record.cadence       = getCadence( sensorID );
+    record.torque        = getTorque( sensorID );
+    record.isSpeedSensor = isUsedAsSpeedSensor( sensorID );
+    if ( record.isSpeedSensor )
     {
-        if ( outputAsJSON )
-        {
-            appendJSONItem( "delta event count",        deltaEventCount );
-            appendJSONItem( "delta wheel period",       deltaWheelPeriod );
-            appendJSONItem( "delta accumulated torque", deltaAccumulatedTorque );
-            appendJSONItem( "instantaneous cadence",    instantaneousCadence );
-            appendJSONItem( "wheel ticks",              wheelTicks );
-        }
-        else
-        {
-            appendOutput( deltaEventCount );
-            appendOutput( deltaWheelPeriod );
-            appendOutput( deltaAccumulatedTorque );
-            appendOutput( instantaneousCadence );
-            appendOutput( wheelTicks );
-        }
+        record.speed              = getSpeed( sensorID );
+        record.wheelCircumference = getWheelCircumference( sensorID );
     }
-    else
+
+    if ( !semiCookedOut )
     {
-        if ( instantaneousCadence != 255 )
+        if ( record.instantaneousCadence != 255 )
         {
             // 255 means invalid
-            cadence = instantaneousCadence;
+            record.cadence = record.instantaneousCadence;
         }
 
-        if ( deltaEventCount == 0 )
+        if ( record.deltaEventCount == 0 )
         {
             ++zeroTimeCount;
             if ( zeroTimeCount > maxZeroTimeB11 )
             {
-                speed  = 0;
-                power  = 0;
-                torque = 0;
+                record.speed  = 0;
+                record.power  = 0;
+                record.torque = 0;
             }
         }
         else
         {
             zeroTimeCount = 0;
-            torque = ( double ) deltaAccumulatedTorque / ( 32.0 * ( double ) deltaEventCount );
-            if ( deltaWheelPeriod != 0 )
+            record.torque = ( double ) record.deltaAccumulatedTorque / ( 32.0 * ( double ) record.deltaEventCount );
+            if ( record.deltaWheelPeriod != 0 )
             {
-                double angularVel = 2048.0 * ( double ) deltaEventCount / ( ( double ) deltaWheelPeriod );
-                power             = torque * angularVel * C_TWO_PI;
-                if ( isSpeedSensor )
+                double angularVel = 2048.0 * ( double ) record.deltaEventCount / ( ( double ) record.deltaWheelPeriod );
+                record.power      = record.torque * angularVel * C_TWO_PI;
+                if ( record.isSpeedSensor )
                 {
-                    speed         = wheelCircumference * angularVel;
+                    record.speed  = record.wheelCircumference * angularVel;
                 }
             }
         }
+    }
 
-        if ( outputAsJSON )
-        {
-            appendJSONItem( "power",               power,              getValuePrecision() );
-            appendJSONItem( "cadence",             cadence );
-            appendJSONItem( "torque",              torque,             getValuePrecision() );
-            appendJSONItem( "wheel ticks",         wheelTicks );
-            if ( isSpeedSensor )
-            {
-                appendJSONItem( "speed",               speed,              getValuePrecision() );
-                appendJSONItem( "wheel circumference", wheelCircumference, getValuePrecision() );
-            }
-        }
-        else
-        {
-            appendOutput( power, getValuePrecision() );
-            appendOutput( cadence );
-            appendOutput( torque, getValuePrecision() );
-            appendOutput( wheelTicks );
-            if ( isSpeedSensor )
-            {
-                appendOutput( speed, getValuePrecision() );
-                appendOutput( wheelCircumference, getValuePrecision() );
-            }
-        }
+    outputRecord( antRecordContext( sensorID, timeStampBuffer, versionString ), record );
+
+    setPower  ( sensorID, record.power );
+    setTorque ( sensorID, record.torque );
+    setCadence( sensorID, record.cadence );
+    setZeroTimeCount( sensorID, zeroTimeCount );
+    if ( record.isSpeedSensor )
+    {
+        setSpeed( sensorID, record.speed );
     }
 }
 
-void antPowerProcessing::createPWRB12ResultString
+void antPowerProcessing::outputPowerB12Record
 (
-    double       &power,
-    unsigned int &cadence,
-    double       &torque,
-    unsigned int &zeroTimeCount,
-    unsigned int  eventCount,
-    unsigned int  deltaEventCount,
-    unsigned int  deltaCrankPeriod,
-    unsigned int  deltaAccumulatedTorque,
-    unsigned int  instantaneousCadence,
-    unsigned int  crankTicks,
-    bool          isMakeshiftSpeedSensor,
-    double       &speed,
-    double        wheelCircumference,
-    double        gearRatio
+    const antSensorHandle &sensorID,
+    const amString        &timeStampBuffer,
+    const amString        &versionString,
+    antPowerB12Record     &record
 )
 {
-    if ( semiCookedOut )
+    unsigned int zeroTimeCount = getZeroTimeCount( sensorID );
+
+    record.power                  = getPower( sensorID );
+    record.cadence                = getCadence( sensorID );
+    record.torque                 = getTorque( sensorID );
+    record.isMakeshiftSpeedSensor = isUsedAsSpeedSensor( sensorID );
+    if ( record.isMakeshiftSpeedSensor )
     {
-        if ( outputAsJSON )
-        {
-            appendJSONItem( "event count",              eventCount );
-            appendJSONItem( "delta event count",        deltaEventCount );
-            appendJSONItem( "delta crank period",       deltaCrankPeriod );
-            appendJSONItem( "delta accumulated torque", deltaAccumulatedTorque );
-            appendJSONItem( "instantaneous cadence",    instantaneousCadence );
-            appendJSONItem( "crank ticks",              crankTicks );
-        }
-        else
-        {
-            appendOutput( deltaEventCount );
-            appendOutput( deltaCrankPeriod );
-            appendOutput( deltaAccumulatedTorque );
-            appendOutput( instantaneousCadence );
-            appendOutput( crankTicks );
-            appendOutput( eventCount );
-        }
+        record.speed              = getSpeed( sensorID );
+        record.wheelCircumference = getWheelCircumference( sensorID );
+        record.gearRatio          = getNbMagnets( sensorID );
     }
-    else
+
+    if ( !semiCookedOut )
     {
-        if ( deltaEventCount == 0 )
+        if ( record.deltaEventCount == 0 )
         {
             ++zeroTimeCount;
             if ( zeroTimeCount > maxZeroTimeB12 )
             {
-                cadence = 0;
-                speed   = 0;
-                power   = 0;
-                torque  = 0;
+                record.cadence = 0;
+                record.speed   = 0;
+                record.power   = 0;
+                record.torque  = 0;
             }
         }
         else
         {
-            double cadenceAsDouble = ( double ) cadence;
+            double cadenceAsDouble = ( double ) record.cadence;
 
             zeroTimeCount = 0;
-            torque = ( double ) deltaAccumulatedTorque / ( 32.0 * ( double ) deltaEventCount );
+            record.torque = ( double ) record.deltaAccumulatedTorque / ( 32.0 * ( double ) record.deltaEventCount );
 
             // Compute power
-            if ( deltaCrankPeriod != 0 )
+            if ( record.deltaCrankPeriod != 0 )
             {
-                cadenceAsDouble   = ( double ) deltaEventCount / ( ( double ) deltaCrankPeriod / 2048.0 );
+                cadenceAsDouble   = ( double ) record.deltaEventCount / ( ( double ) record.deltaCrankPeriod / 2048.0 );
                 double angularVel = C_TWO_PI * cadenceAsDouble;
                 cadenceAsDouble  *= 60.0;
-                cadence           = ( unsigned int ) round( cadenceAsDouble );
-                power             = torque * angularVel;
-                if ( isMakeshiftSpeedSensor )
+                record.cadence    = ( unsigned int ) round( cadenceAsDouble );
+                record.power      = record.torque * angularVel;
+                if ( record.isMakeshiftSpeedSensor )
                 {
-                    speed             = ( ( wheelCircumference > 0 ) && ( gearRatio > 0 ) ) ?
-                                        wheelCircumference * cadenceAsDouble * gearRatio / 60.0 : 0;
+                    record.speed  = ( ( record.wheelCircumference > 0 ) && ( record.gearRatio > 0 ) ) ?
+                                    record.wheelCircumference * cadenceAsDouble * record.gearRatio / 60.0 : 0;
                 }
             }
         }
-
-        if ( outputAsJSON )
-        {
-            appendJSONItem( "event count",           eventCount );
-            appendJSONItem( "power",                 power,              getValuePrecision() );
-            appendJSONItem( "cadence",               cadence );
-            appendJSONItem( "instantaneous cadence", instantaneousCadence );
-            appendJSONItem( "torque",                torque,             getValuePrecision() );
-            appendJSONItem( "crank ticks",           crankTicks );
-            if ( isMakeshiftSpeedSensor )
-            {
-                appendJSONItem( "speed",               speed,              getValuePrecision() );
-                appendJSONItem( "wheel circumference", wheelCircumference, getValuePrecision() );
-                appendJSONItem( "gear ratio",          gearRatio,          getValuePrecision() );
-            }
-        }
-        else
-        {
-            appendOutput( power,              getValuePrecision() );
-            appendOutput( cadence );
-            appendOutput( torque,             getValuePrecision() );
-            appendOutput( crankTicks );
-            appendOutput( eventCount );
-            if ( isMakeshiftSpeedSensor )
-            {
-                appendOutput( speed,              getValuePrecision() );
-                appendOutput( wheelCircumference, getValuePrecision() );
-                appendOutput( gearRatio,          getValuePrecision() );
-            }
-        }
     }
-}
 
-void antPowerProcessing::createPWRB13ResultString
-(
-    unsigned int rawLeftTorqueEffectiveness,
-    unsigned int rawRightTorqueEffectiveness,
-    unsigned int rawLeftPedalSmoothness,
-    unsigned int rawRightPedalSmoothness,
-    unsigned int deltaEventCount,
-    unsigned int eventCount
-)
-{
-    if ( semiCookedOut )
-    {
-        if ( outputAsJSON )
-        {
-            appendJSONItem( "left torque effectiveness",  rawLeftTorqueEffectiveness );
-            appendJSONItem( "right torque effectiveness", rawRightTorqueEffectiveness );
-            appendJSONItem( "left pedal smoothness",      rawLeftPedalSmoothness );
-            appendJSONItem( "right pedal smoothness",     rawRightPedalSmoothness );
-            appendJSONItem( "delta event count",          deltaEventCount );
-        }
-        else
-        {
-            appendOutput( rawLeftTorqueEffectiveness );
-            appendOutput( rawRightTorqueEffectiveness );
-            appendOutput( rawLeftPedalSmoothness );
-            appendOutput( rawRightPedalSmoothness );
-            appendOutput( deltaEventCount );
-        }
-    }
-    else
-    {
-        double leftTorqueValue  = ( ( double ) rawLeftTorqueEffectiveness  ) / 2.0;
-        double rightTorqueValue = ( ( double ) rawRightTorqueEffectiveness ) / 2.0;
-        double leftPedalValue   = ( ( double ) rawLeftPedalSmoothness )      / 2.0;
-        double rightPedalValue  = ( ( double ) rawRightPedalSmoothness )     / 2.0;
-
-        if ( outputAsJSON )
-        {
-            if ( rawLeftTorqueEffectiveness == 255 )
-            {
-                appendJSONItem( "left torque effectiveness", C_INVALID_JSON );
-            }
-            else
-            {
-                appendJSONItem( "left torque effectiveness", leftTorqueValue, 1 );
-            }
-            if ( rawRightTorqueEffectiveness == 255 )
-            {
-                appendJSONItem( "right torque effectiveness", C_INVALID_JSON );
-            }
-            else
-            {
-                appendJSONItem( "right torque effectiveness", rightTorqueValue, 1 );
-            }
+    outputRecord( antRecordContext( sensorID, timeStampBuffer, versionString ), record );
 
-            if ( rawRightPedalSmoothness == 254 )
-            {
-                // Pedal Smoothness is combined, no Left/Right Pedal Smoothness.
-                if ( rawLeftPedalSmoothness == 255 )
-                {
-                    appendJSONItem( "common pedal smoothness", C_INVALID_JSON );
-                }
-                else
-                {
-                    appendJSONItem( "common pedal smoothness", leftPedalValue, 1 );
-                }
-            }
-            else
-            {
-                // Separate Left and Right Pedal Smoothness
-                if ( rawLeftPedalSmoothness == 255 )
-                {
-                    appendJSONItem( "left pedal smoothness", C_INVALID_JSON );
-                }
-                else
-                {
-                    appendJSONItem( "left pedal smoothness", leftPedalValue, 1 );
-                }
-                if ( rawRightPedalSmoothness == 255 )
-                {
-                    appendJSONItem( "right pedal smoothness", C_INVALID_JSON );
-                }
-                else
-                {
-                    appendJSONItem( "right pedal smoothness", rightPedalValue, 1 );
-                }
-            }
-
-            appendJSONItem( "event count", eventCount );
-        }
-        else
-        {
-            appendOutput( C_LEFT_TORQUE_EFFECTIVENESS );
-            if ( rawLeftTorqueEffectiveness == 255 )
-            {
-                appendOutput( C_INVALID );
-            }
-            else
-            {
-                appendOutput( leftTorqueValue, 1, "\%" );
-            }
-
-            appendOutput( C_RIGHT_TORQUE_EFFECTIVENESS );
-            if ( rawRightTorqueEffectiveness == 255 )
-            {
-                appendOutput( C_INVALID );
-            }
-            else
-            {
-                appendOutput( rightTorqueValue, 1, "\%" );
-            }
-
-            if ( rawRightPedalSmoothness == 254 )
-            {
-                // Pedal Smoothness is combined, no Left/Right Pedal Smoothness.
-                appendOutput( C_COMMON_PEDAL_SMOOTHNESS );
-                if ( rawLeftPedalSmoothness == 255 )
-                {
-                    appendOutput( C_INVALID );
-                }
-                else
-                {
-                    appendOutput( leftPedalValue, 1, "\%" );
-                }
-            }
-            else
-            {
-                // Separate Left and Right Pedal Smoothness
-                appendOutput( C_LEFT_PEDAL_SMOOTHNESS );
-                if ( rawLeftPedalSmoothness == 255 )
-                {
-                    appendOutput( C_INVALID );
-                }
-                else
-                {
-                    appendOutput( leftPedalValue, 1, "\%" );
-                }
-
-                appendOutput( C_RIGHT_PEDAL_SMOOTHNESS );
-                if ( rawRightPedalSmoothness == 255 )
-                {
-                    appendOutput( C_INVALID );
-                }
-                else
-                {
-                    appendOutput( rightPedalValue, 1, "\%" );
-                }
-            }
-            appendOutput( "EVENT_NO" );
-            appendOutput( eventCount );
-        }
+    if ( record.isMakeshiftSpeedSensor )
+    {
+        setSpeed( sensorID, record.speed );
     }
+    setPower  ( sensorID, record.power );
+    setTorque ( sensorID, record.torque );
+    setCadence( sensorID, record.cadence );
+    setZeroTimeCount( sensorID, zeroTimeCount );
 }
 
-void antPowerProcessing::createPWRB20ResultString
+void antPowerProcessing::outputPowerB20Record
 (
-    double       &power,
-    unsigned int &cadence,
-    double       &torque,
-    unsigned int &zeroTimeCount,
-    unsigned int  deltaEventCount,
-    unsigned int  deltaTimeStamp,
-    unsigned int  deltaTorqueTicks,
-    unsigned int  factorySlope_Nm_10Hz,
-    unsigned int  powerMeterOffset,
-    unsigned int  userDefinedSlope_Nm_10Hz,
-    bool          isMakeshiftSpeedSensor,
-    double       &speed,
-    double        wheelCircumference,
-    double        gearRatio
+    const antSensorHandle &sensorID,
+    const amString        &timeStampBuffer,
+    const amString        &versionString,
+    antPowerB20Record     &record
 )
 {
-    if ( semiCookedOut )
+    unsigned int zeroTimeCount    = getZeroTimeCount( sensorID );
+    unsigned int userDefinedSlope = getSlope_Nm_10Hz( sensorID );
+
+    record.power                  = getPower( sensorID );
+    record.cadence                = getCadence( sensorID );
+    record.torque                 = getTorque( sensorID );
+    record.offset                 = getOffset( sensorID );
+    record.isFactorySlope         = ( userDefinedSlope == C_SLOPE_DEFAULT );
+    record.slope                  = record.isFactorySlope ? record.factorySlope : userDefinedSlope;
+    record.isMakeshiftSpeedSensor = isUsedAsSpeedSensor( sensorID );
+    if ( record.isMakeshiftSpeedSensor )
     {
-        if ( outputAsJSON )
-        {
-            appendJSONItem( "delta event count",       deltaEventCount );
-            appendJSONItem( "delta time stamp",        deltaTimeStamp );
-            appendJSONItem( "delta torque ticks",      deltaTorqueTicks );
-            appendJSONItem( "factory slope times ten", factorySlope_Nm_10Hz );
-        }
-        else
-        {
-            appendOutput( deltaEventCount );
-            appendOutput( deltaTimeStamp );
-            appendOutput( deltaTorqueTicks );
-            appendOutput( factorySlope_Nm_10Hz );
-        }
+        record.speed              = getSpeed( sensorID );
+        record.wheelCircumference = getWheelCircumference( sensorID );
+        record.gearRatio          = getNbMagnets( sensorID );
     }
-    else
-    {
-        unsigned int powerMeterSlope_Nm_10Hz = ( userDefinedSlope_Nm_10Hz == C_SLOPE_DEFAULT ) ? factorySlope_Nm_10Hz : userDefinedSlope_Nm_10Hz;
 
-        if ( deltaTimeStamp == 0 )
+    if ( !semiCookedOut )
+    {
+        if ( record.deltaTimeStamp == 0 )
         {
             ++zeroTimeCount;
             if ( zeroTimeCount > maxZeroTimeB20 )
             {
-                speed   = 0;
-                power   = 0;
-                torque  = 0;
-                cadence = 0;
+                record.speed   = 0;
+                record.power   = 0;
+                record.torque  = 0;
+                record.cadence = 0;
             }
         }
         else
         {
             zeroTimeCount = 0;
-            if ( deltaEventCount != 0 )
+            if ( record.deltaEventCount != 0 )
             {
-                double newCadence    = ( double ) cadence;
-                double elapsedTime   = ( double ) deltaTimeStamp / 2000.0;
-                double cadencePeriod = elapsedTime / ( double ) deltaEventCount;
+                double newCadence    = ( double ) record.cadence;
+                double elapsedTime   = ( double ) record.deltaTimeStamp / 2000.0;
+                double cadencePeriod = elapsedTime / ( double ) record.deltaEventCount;
 
                 if ( cadencePeriod != 0 )
                 {
                     newCadence = 60.0 / cadencePeriod;
                 }
 
-                if ( ( deltaTorqueTicks > 0 ) && ( cadencePeriod > 0 ) && ( powerMeterSlope_Nm_10Hz != 0 ) )
+                if ( ( record.deltaTorqueTicks > 0 ) && ( cadencePeriod > 0 ) && ( record.slope != 0 ) )
                 {
-                    double rawTorqueFrequency = ( ( double ) deltaTorqueTicks / elapsedTime );
-                    double torqueFrequency    = rawTorqueFrequency - ( double ) powerMeterOffset;
-                    double newTorque          = 10.0 * torqueFrequency / ( double ) powerMeterSlope_Nm_10Hz;
+                    double rawTorqueFrequency = ( ( double ) record.deltaTorqueTicks / elapsedTime );
+                    double torqueFrequency    = rawTorqueFrequency - ( double ) record.offset;
+                    double newTorque          = 10.0 * torqueFrequency / ( double ) record.slope;
                     double newPower           = newTorque * C_TWO_PI / cadencePeriod;
 
                     if ( ( newPower   >= C_MIN_POWER_VALUE ) && ( newPower   <= C_MAX_POWER_VALUE ) &&
                          ( newCadence >= C_MIN_CADENCE     ) && ( newCadence <= C_MAX_CADENCE     ) )
                     {
-                        power   = newPower;
-                        torque  = newTorque;
-                        cadence = ( unsigned int ) round( newCadence );
+                        record.power   = newPower;
+                        record.torque  = newTorque;
+                        record.cadence = ( unsigned int ) round( newCadence );
                     }
                     // Else: This is a spike. Use the previous value
                 }
                 else
                 {
-                    power  = 0;
-                    torque = 0;
+                    record.power  = 0;
+                    record.torque = 0;
                 }
-                if ( isMakeshiftSpeedSensor )
+                if ( record.isMakeshiftSpeedSensor )
                 {
-                    speed = antCadenceSpeedProcessing::computeSpeed( newCadence, wheelCircumference, gearRatio );
+                    record.speed = antCadenceSpeedProcessing::computeSpeed( newCadence, record.wheelCircumference, record.gearRatio );
                 }
             }
         }
+    }
 
-        if ( outputAsJSON )
-        {
-            appendJSONItem( "power",               power,              getValuePrecision() );
-            appendJSONItem( "cadence",             cadence );
-            appendJSONItem( "torque",              torque,             getValuePrecision() );
-            appendJSONItem( "power meter offset",  powerMeterOffset );
-            appendJSONItem( "power meter slope",   powerMeterSlope_Nm_10Hz / 10.0, 1 );
-            appendJSONItemConditional( "slope used", userDefinedSlope_Nm_10Hz == C_SLOPE_DEFAULT, "factory slope", "user-defined slope" );
-            if ( isMakeshiftSpeedSensor )
-            {
-                appendJSONItem( "speed",               speed,              getValuePrecision() );
-                appendJSONItem( "wheel circumference", wheelCircumference, getValuePrecision() );
-                appendJSONItem( "gear ratio",          gearRatio,          getValuePrecision() );
-            }
-        }
-        else
-        {
-            appendOutput( power,                          getValuePrecision() );
-            appendOutput( cadence );
-            appendOutput( torque,                         getValuePrecision() );
-            appendOutput( powerMeterOffset );
-            appendOutput( powerMeterSlope_Nm_10Hz / 10.0, 1 );
-            appendOutputConditional( userDefinedSlope_Nm_10Hz == C_SLOPE_DEFAULT, "FACTORY_SLOPE", "USER_DEFINED_SLOPE" );
-            appendOutput( factorySlope_Nm_10Hz / 10.0, 1 );
-            if ( isMakeshiftSpeedSensor )
-            {
-                appendOutput( speed,                      getValuePrecision() );
-                appendOutput( wheelCircumference,         getValuePrecision() );
-                appendOutput( gearRatio,                  getValuePrecision() );
-            }
-        }
+    outputRecord( antRecordContext( sensorID, timeStampBuffer, versionString ), record );
+
+    if ( record.isMakeshiftSpeedSensor )
+    {
+        setSpeed( sensorID, record.speed );
     }
+    setPower  ( sensorID, record.power );
+    setTorque ( sensorID, record.torque );
+    setCadence( sensorID, record.cadence );
+    setZeroTimeCount( sensorID, zeroTimeCount );
 }
 
 double antPowerProcessing::scaleValue
@@ -1,13 +1,22 @@
+#include <algorithm>
+#include <cmath>
 #include <sstream>
 #include <fstream>
 #include <iostream>
 #include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <sys/time.h>
 
 // -------------------------------------------------------------------------------------------------------------------------
 // Local Libraries
 #include "am_split_string.h"
 #include "ant_processing.h"
+#include "ant_decode_pipeline.h"
+#include "ant_chunked_decoder.h"
 
 // -------------------------------------------------------------------------------------------------------------------------
 // -------------------------------------------------------------------------------------------------------------------------
@@ -19,6 +28,13 @@
 
 #define AAA( _XXX_ ) std::cerr << "AAA " << _XXX_ << std::endl;
 
+// Kinds of the pieces of output captured by a decode thread (see writeOutput).
+const char C_CAPTURED_TEXT   = 'T';
+const char C_CAPTURED_RECORD = 'R';
+
+const int  C_SEQUENCE_OFFSET   =  3;   // Sequence number of a bridge message.
+const int  C_BRIDGE_MAC_OFFSET = 49;   // MAC address of the bridge in a query response (C_QUERY_RESP).
+
 // ------------------------------------------------------------------------------------------------------
 //
 // Constructor
@@ -27,10 +43,45 @@
 antProcessing::antProcessing
 (
     void
-)
+) : semiCookedFormatter( outBuffer, valuePrecision, timePrecision ),
+    cookedFormatter( outBuffer, valuePrecision, timePrecision ),
+    jsonFormatter( outBuffer, valuePrecision, timePrecision, semiCookedOut ),
+    binaryFormatter( binaryBuffer, semiCookedOut, outputAsJSON ),
+    registeredDevices( sensorStates, &antSensorState::registered, SS_REGISTERED ),
+    zeroTimeCountTable( sensorStates, &antSensorState::zeroTimeCount, SS_ZERO_TIME_COUNT ),
+    eventTimeTable( sensorStates, &antSensorState::eventTime, SS_EVENT_TIME ),
+    eventCountTable( sensorStates, &antSensorState::eventCount, SS_EVENT_COUNT ),
+    totalTimeIntTable( sensorStates, &antSensorState::totalTimeInt, SS_TOTAL_TIME_INT ),
+    totalCountTable( sensorStates, &antSensorState::totalCount, SS_TOTAL_COUNT ),
+    operatingTimeTable( sensorStates, &antSensorState::operatingTime, SS_OPERATING_TIME ),
+    sameEventCountTable( sensorStates, &antSensorState::sameEventCount, SS_SAME_EVENT_COUNT ),
+    totalTimeTable( sensorStates, &antSensorState::totalTime, SS_TOTAL_TIME ),
+    totalOperatingTimeTable( sensorStates, &antSensorState::totalOperatingTime, SS_TOTAL_OPERATING_TIME )
 {
-    b2tVersion = BUILD_NUMBER;
-    testMode   = false;
+    b2tVersion           = BUILD_NUMBER;
+    testMode             = false;
+    isDecodeWorker       = false;
+    hasFrameTime         = false;
+    frameTime            = 0;
+    argCount             = 0;
+    nextCheckpointTime   = 0;
+    nextEvictionTime     = 0;
+    nextSequenceReport   = 0;
+    argValues            = NULL;
+    deviceFileSource     = NULL;
+    deviceFileGeneration = 0;
+    stageStatsSource     = NULL;
+    stageStats           = NULL;
+    perfCounterSource    = NULL;
+    perfCounters         = NULL;
+    perfDeviceType       = C_PERF_NO_DEVICE_TYPE;
+    unregisteredSeen     = false;
+    followsGap           = false;
+    frameSender          = 0;
+    frameGapTag          = 0;
+    capturedOutput       = NULL;
+    pipeline             = NULL;
+    outputText           = true;
     resetAll();
 }
 
@@ -54,18 +105,35 @@ void antProcessing::resetAll
     setOutputBridge( C_DEFAULT_OUTPUT_BRIDGE );
     setDeviceFileName( C_DEFAULT_DEVICE_FILE );
     setInputFileName( C_DEFAULT_INPUT_FILE_NAME );
+    setCaptureFileName( C_DEFAULT_CAPTURE_FILE_NAME );
+    setStateFileName( C_DEFAULT_STATE_FILE_NAME );
+    setCheckpointSeconds( C_DEFAULT_CHECKPOINT_SECONDS );
+    setSensorIdleSeconds( C_DEFAULT_SENSOR_IDLE_SECONDS );
+    setMaxSensors( C_DEFAULT_MAX_SENSORS );
+    setStatsFileName( C_DEFAULT_STATS_FILE_NAME );
+    setStatsIntervalSeconds( C_DEFAULT_STATS_INTERVAL_SECONDS );
     setInterface( C_DEFAULT_INTERFACE );
     setMCAddressIn( C_DEFAULT_MC_ADDRESS_IN );
     setMCPortNoIn( C_DEFAULT_MC_PORT_NO_IN );
     setMCAddressOut( C_DEFAULT_MC_ADDRESS_OUT );
     setMCPortNoOut( C_DEFAULT_MC_PORT_NO_OUT );
     setTimeOutSec( C_DEFAULT_TIME_OUT_SEC );
+    setReceiveBufferSize( C_DEFAULT_RECEIVE_BUFFER_SIZE );
     setWriteStdout( C_DEFAULT_WRITE_STDOUT );
     setSemiCookedIn( C_DEFAULT_SEMI_COOKED_IN );
     setSemiCookedOut(C_DEFAULT_SEMI_COOKED_OUT );
     setOutputAsJSON( C_DEFAULT_OUTPUT_AS_JSON );
     setOutputRaw( C_DEFAULT_OUTPUT_RAW );
+    setBinaryIn( C_DEFAULT_BINARY_IN );
+    setBinaryOut( C_DEFAULT_BINARY_OUT );
+    setCaptureIn( C_DEFAULT_CAPTURE_IN );
+    setWatchDeviceFile( C_DEFAULT_WATCH_DEVICE_FILE );
+    setTrackSequences( C_DEFAULT_TRACK_SEQUENCES );
+    setMarkSequenceGaps( C_DEFAULT_MARK_SEQUENCE_GAPS );
+    setSequenceIntervalSeconds( C_DEFAULT_SEQUENCE_INTERVAL_SECONDS );
+    captureSelection = antCaptureSelection();
     setOnlyRegisteredDevices( C_DEFAULT_ONLY_REGISTERED_DEVICES );
+    setDecodeThreads( C_DEFAULT_DECODE_THREADS );
 
     setDiagnostics( C_DEFAULT_DIAGNOSTICS );
 
@@ -122,7 +190,7 @@ bool antProcessing::isSupportedSensor
 // Check if a device is registered.
 //
 // Parameters:
-//    const amString &deviceID   IN   Device ID (key for the has table)
+//    const antSensorHandle &deviceID   IN   Device ID (key for the has table)
 //
 // Return true if the device hash table has an entry for the key.
 //        false otherwise.
@@ -130,13 +198,14 @@ bool antProcessing::isSupportedSensor
 //---------------------------------------------------------------------------------------------------
 bool antProcessing::isRegisteredDevice
 (
-    const amString &deviceID
+    const antSensorHandle &deviceID
 )
 {
     bool result = !onlyRegisteredDevices;
     if ( !result )
     {
-        result = ( registeredDevices.count( deviceID ) > 0 );
+        result           = ( registeredDevices.count( deviceID ) > 0 );
+        unregisteredSeen = unregisteredSeen || !result;
     }
     return result;
 }
@@ -148,67 +217,114 @@ bool antProcessing::isRegisteredDevice
 // ------------------------------------------------------------------------------------------------------
 void antProcessing::registerDevice
 (
-    const amString &deviceID
+    const antSensorHandle &deviceID
 )
 {
     if ( registeredDevices.count( deviceID ) == 0 )
     {
-        registeredDevices.insert( std::pair<amString, bool>( deviceID, false ) );
+        registeredDevices.insert( deviceID, false );
     }
 }
 
 // ------------------------------------------------------------------------------------------------------
 //
-// Get the number of elapsed seconds since 1970 (with micro-second presision).
+// Get the number of elapsed microseconds since 1970.
 //
 // ------------------------------------------------------------------------------------------------------
-double antProcessing::getUnixTime
+long long antProcessing::getUnixTime
 (
     void
 )
 {
     struct timeval tv;
     gettimeofday( &tv, NULL );
-    double result = ( double ) tv.tv_sec + ( ( double ) tv.tv_usec ) / 1.0E6;
+    long long result = ( long long ) tv.tv_sec * 1000000 + tv.tv_usec;
 
     return result;
 }
 
 // ------------------------------------------------------------------------------------------------------
 //
-// Get the number of elapsed seconds since 1970 and write the result into a buffer.
+// Get the time stamp of a semi-cooked line in microseconds: its second field (the receive time of the
+// packet in seconds), or the number of elapsed microseconds since 1970 if the line has none.
 //
 // ------------------------------------------------------------------------------------------------------
-void antProcessing::getUnixTimeAsString
+long long antProcessing::getSemiCookedTime
 (
-    amString &timeStampBuffer
+    const char *line
+)
+{
+    const char *timeStamp = strchr( line, '\t' );
+    char       *end       = NULL;
+    double      seconds   = 0;
+
+    if ( timeStamp != NULL )
+    {
+        ++timeStamp;
+        seconds = strtod( timeStamp, &end );
+        if ( ( end != timeStamp ) && ( ( *end == '\t' ) || ( *end == 0 ) ) )
+        {
+            return ( long long ) floor( seconds * 1.0E6 + 0.5 );
+        }
+    }
+    return getUnixTime();
+}
+
+// ------------------------------------------------------------------------------------------------------
+//
+// Get the time stamp of the packet being processed in microseconds: the time the packet was received
+// (set by the multicast reader, a capture file or a decode thread), the packet counter / 10 seconds
+// in test mode, or the number of elapsed microseconds since 1970.
+//
+// ------------------------------------------------------------------------------------------------------
+long long antProcessing::getFrameTime
+(
+    void
 )
 {
-    double subSecondTimer = 0;
-    if ( testMode )
+    long long result = 0;
+    if ( hasFrameTime )
     {
-        subSecondTimer = ( double ) testCounter * 0.1;
+        result = frameTime;
+    }
+    else if ( testMode )
+    {
+        result = ( long long ) testCounter * 100000;
         ++testCounter;
     }
     else
     {
-        subSecondTimer = getUnixTime();
+        result = getUnixTime();
     }
-    getUnixTimeAsString( timeStampBuffer, subSecondTimer );
+    return result;
+}
+
+// ------------------------------------------------------------------------------------------------------
+//
+// Get the time stamp of the packet being processed and write the result into a buffer.
+//
+// ------------------------------------------------------------------------------------------------------
+void antProcessing::getUnixTimeAsString
+(
+    amString &timeStampBuffer
+)
+{
+    getUnixTimeAsString( timeStampBuffer, getFrameTime() );
 }
 
 // ------------------------------------------------------------------------------------------------------
 //
-// Write the result into a buffer.
+// Write a time stamp in microseconds into a buffer (in seconds, with timePrecision decimals).
 //
 // ------------------------------------------------------------------------------------------------------
 void antProcessing::getUnixTimeAsString
 (
-    amString &timeStampBuffer,
-    double    subSecondTimer
+    amString  &timeStampBuffer,
+    long long  microseconds
 )
 {
-    timeStampBuffer = amString( subSecondTimer, timePrecision );
+    timeStampBuffer.clear();
+    timeStampBuffer.appendFixedPoint( microseconds, C_MICROSECOND_DIGITS, timePrecision );
 }
 
 // ------------------------------------------------------------------------------------------------------
@@ -220,17 +336,22 @@ void antProcessing::getUnixTimeAsString
 // ------------------------------------------------------------------------------------------------------
 unsigned int antProcessing::getDeltaInt
 (
-    bool                             &rollOverHappened,
-    const amString                   &sensorID,
-    unsigned int                      rollOver,
-    std::map<amString, unsigned int> &valueTable,
-    unsigned int                      newValue
+    bool                         &rollOverHappened,
+    const antSensorHandle        &sensorID,
+    unsigned int                  rollOver,
+    antSensorField<unsigned int> &valueTable,
+    unsigned int                  newValue
 )
 {
-    unsigned int prevValue  = valueTable[ sensorID ];
-    valueTable[ sensorID ]  = newValue;
+    unsigned int &value     = valueTable[ sensorID ];
+    unsigned int prevValue  = value;
+    value                   = newValue;
     rollOverHappened        = ( newValue < prevValue );
     unsigned int deltaValue = rollOverHappened ? ( rollOver - prevValue + newValue ) : ( newValue - prevValue );
+    if ( rollOverHappened && ( stageStats != NULL ) )
+    {
+        stageStats->count( STATS_ROLL_OVERS );
+    }
     return deltaValue;
 }
 
@@ -266,19 +387,168 @@ void antProcessing::setValuePrecision
     }
 }
 
+// -------------------------------------------------------------------------------------------------//
+//
+// Set when the output is flushed from a comma separated list of
+//     bytes=<n>    flush when <n> bytes are pending (0: flush every record),
+//     records=<n>  flush after <n> records (0: no limit),
+//     ms=<n>       flush when the oldest pending record is <n> milliseconds old (0: no limit),
+//     idle|noidle  flush (or not) whenever no more input is waiting,
+//     thread       write stdout from a separate thread.
+// Returns false if the policy could not be parsed.
+//
+// -------------------------------------------------------------------------------------------------//
+bool antProcessing::setOutputPolicy
+(
+    const amString &policy
+)
+{
+    amSplitString words;
+    amString      word;
+    size_t        nbWords = words.split( policy, ",=" );
+    bool          result  = ( nbWords > 0 );
+
+    for ( size_t counter = 0; result && ( counter < nbWords ); ++counter )
+    {
+        word = words[ counter ];
+        if ( word == "idle" )
+        {
+            outputWriter.setFlushOnIdle( true );
+        }
+        else if ( word == "noidle" )
+        {
+            outputWriter.setFlushOnIdle( false );
+        }
+        else if ( word == "thread" )
+        {
+            outputWriter.setUseThread( true );
+        }
+        else if ( ( counter + 1 < nbWords ) && words[ counter + 1 ].isUnsignedInteger() )
+        {
+            ++counter;
+            if ( word == "bytes" )
+            {
+                outputWriter.setMaxBytes( words[ counter ].toUInt() );
+            }
+            else if ( word == "records" )
+            {
+                outputWriter.setMaxRecords( words[ counter ].toUInt() );
+            }
+            else if ( word == "ms" )
+            {
+                outputWriter.setMaxDelayMS( words[ counter ].toUInt() );
+            }
+            else
+            {
+                result = false;
+            }
+        }
+        else
+        {
+            result = false;
+        }
+    }
+    return result;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Set the coalescing of the multicast output from "<bytes>[,<ms>]": pack records into datagrams of
+// at most <bytes> bytes which are sent at the latest <ms> milliseconds after their first record.
+// <bytes> = 0 switches coalescing off.
+// Returns false if the parameter could not be parsed.
+//
+// -------------------------------------------------------------------------------------------------//
+bool antProcessing::setCoalescing
+(
+    const amString &coalescing
+)
+{
+    amSplitString words;
+    size_t        nbWords      = words.split( coalescing, "," );
+    unsigned int  datagramSize = words[ 0 ].toUInt();
+    unsigned int  maxDelay     = C_DEFAULT_MC_COALESCE_DELAY_MS;
+    bool          result       = ( ( nbWords == 1 ) || ( nbWords == 2 ) ) && words[ 0 ].isUnsignedInteger() &&
+                                 ( ( datagramSize == 0 ) || ( ( datagramSize >= C_TINY_BUFFER_SIZE ) && ( datagramSize <= C_MC_MAX_DATAGRAM_SIZE ) ) );
+
+    if ( result && ( nbWords == 2 ) )
+    {
+        result   = words[ 1 ].isUnsignedInteger();
+        maxDelay = words[ 1 ].toUInt();
+    }
+    if ( result )
+    {
+        multicastWrite.setCoalescing( datagramSize, maxDelay );
+    }
+    return result;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Set the statistics output from "<file>[,<seconds>]": append the statistics to <file> every
+// <seconds> seconds (see antStageStatsDump).
+// Returns false if the parameter could not be parsed.
+//
+// -------------------------------------------------------------------------------------------------//
+bool antProcessing::setStatsOutput
+(
+    const amString &statsOutput
+)
+{
+    size_t   separator = statsOutput.rfind( ',' );
+    amString seconds;
+    bool     result    = true;
+
+    setStatsFileName( statsOutput );
+    setStatsIntervalSeconds( C_DEFAULT_STATS_INTERVAL_SECONDS );
+    if ( separator != std::string::npos )
+    {
+        seconds = amString( statsOutput.substr( separator + 1 ) );
+        result  = seconds.isUnsignedInteger();
+        setStatsFileName( amString( statsOutput.substr( 0, separator ) ) );
+        setStatsIntervalSeconds( seconds.toInt() );
+    }
+    return result && !statsFileName.empty();
+}
+
+// ------------------------------------------------------------------------------------------------------
+//
+// Option '-G': "<seconds>[,mark]".
+//
+// ------------------------------------------------------------------------------------------------------
+bool antProcessing::setSequenceTracking
+(
+    const amString &sequenceTracking
+)
+{
+    size_t   separator = sequenceTracking.find( ',' );
+    amString seconds   = sequenceTracking;
+    bool     result    = true;
+
+    setTrackSequences( true );
+    setMarkSequenceGaps( false );
+    if ( separator != std::string::npos )
+    {
+        seconds = amString( sequenceTracking.substr( 0, separator ) );
+        result  = ( sequenceTracking.substr( separator + 1 ) == "mark" );
+        setMarkSequenceGaps( result );
+    }
+    result = result && seconds.isUnsignedInteger();
+    setSequenceIntervalSeconds( seconds.toInt() );
+    return result;
+}
+
 //---------------------------------------------------------------------------------------------------
 //
-// Decide if a semi-cooked input string was created by an older version (version 1.37)
+// Decide if a split semi-cooked input string was created by an older version (version 1.37)
 //
 //---------------------------------------------------------------------------------------------------
 bool antProcessing::isSemiCookedFormat137
 (
-    const amString &inputBuffer
+    const amSplitString &words
 )
 {
-    amSplitString words( inputBuffer );
-    amString      lastWord = words.back();
-    bool          result   = lastWord.startsWith( "1.34." );
+    bool result = words.back().startsWith( "1.34." );
     return result;
 }
 
@@ -289,7 +559,7 @@ bool antProcessing::isSemiCookedFormat137
 //
 // Parameters:
 //    int             deviceType        IN   Device type (SPCAD, SPEED, CADENCE, HRM, AERO, POWER).
-//    const amString &deviceID          IN   Device ID (number).
+//    unsigned int    deviceID          IN   Device ID (number).
 //    const amString &timeStampBuffer   IN   Device ID (number).
 //    BYTE            payLoad[]         IN   Array of bytes with the data to be converted.
 //
@@ -302,7 +572,7 @@ bool antProcessing::isSemiCookedFormat137
 amDeviceType antProcessing::processSensor
 (
     int             deviceType,
-    const amString &deviceID,
+    unsigned int    deviceID,
     const amString &timeStampBuffer,
     BYTE            payLoad[]
 )
@@ -481,7 +751,7 @@ amDeviceType antProcessing::processUndefinedSensorType
             }
         }
 
-        result = processSensor( deviceType, deviceID, timeStampBuffer, payLoad );
+        result = processSensor( deviceType, deviceID.toUInt(), timeStampBuffer, payLoad );
     }
     else
     {
@@ -492,48 +762,6 @@ amDeviceType antProcessing::processUndefinedSensorType
     return result;
 }
 
-// -------------------------------------------------------------------------------------------------//
-//
-// Write the battery status for the given index into a buffer
-//
-// -------------------------------------------------------------------------------------------------//
-bool antProcessing::getBatteryStatus
-(
-   amString &status,
-   int       index,
-   bool      lowerCase
-)
-{
-    bool result = true;
-    switch ( index )
-    {
-        case  0: status = "N/A";
-                 break;
-        case  1: status = "New";
-                 break;
-        case  2: status = "Good";
-                 break;
-        case  3: status = "Ok";
-                 break;
-        case  4: status = "Low";
-                 break;
-        case  5: status = "Critical";
-                 break;
-        case  6: status = "Reserved for future use";
-                 break;
-        case  7: status = "Invalid";
-                 break;
-        default: status = "Unknown";
-                 result = false;
-                 break;
-    }
-    if ( lowerCase )
-    {
-        status.toLower();
-    }
-    return result;
-}
-
 //----------------------------------------------------------------------------------------------------------------------------------------
 // Auxilairy functions
 //----------------------------------------------------------------------------------------------------------------------------------------
@@ -623,7 +851,7 @@ void antProcessing::appendErrorMessage
     int value
 )
 {
-    errorMessage += amString( value );
+    errorMessage.appendNumber( value );
 }
 
 // -------------------------------------------------------------------------------------------------//
@@ -636,7 +864,7 @@ void antProcessing::appendErrorMessage
     unsigned int value
 )
 {
-    errorMessage += amString( value );
+    errorMessage.appendNumber( value );
 }
 
 // -------------------------------------------------------------------------------------------------//
@@ -649,7 +877,7 @@ void antProcessing::appendErrorMessage
     BYTE value
 )
 {
-    errorMessage += amString( value );
+    errorMessage.appendHex( value );
 }
 
 // -------------------------------------------------------------------------------------------------//
@@ -664,7 +892,7 @@ void antProcessing::appendErrorMessage
     int precision
 )
 {
-    errorMessage += amString( value, precision );
+    errorMessage.appendNumber( value, precision );
 }
 
 // -------------------------------------------------------------------------------------------------//
@@ -741,9 +969,9 @@ void antProcessing::appendDiagnosticsLine
 {
     diagnosticsBuffer += itemName;
     diagnosticsBuffer += "[ ";;
-    diagnosticsBuffer += amString( index );
+    diagnosticsBuffer.appendNumber( index );
     diagnosticsBuffer += " ]";;
-    diagnosticsBuffer += amString(itemValue ); 
+    diagnosticsBuffer.appendHex( itemValue );
 }
 
 // -------------------------------------------------------------------------------------------------//
@@ -777,7 +1005,7 @@ void antProcessing::appendDiagnosticsLine
 )
 {
     appendDiagnosticsItemName( itemName );
-    diagnosticsBuffer += amString( itemValue );
+    diagnosticsBuffer.appendNumber( itemValue );
     if ( !additionalInfo.empty() )
     {
         diagnosticsBuffer += " ";
@@ -802,7 +1030,7 @@ void antProcessing::appendDiagnosticsLine
     appendDiagnosticsItemName( itemName );
     diagnosticsBuffer += stringValue;
     diagnosticsBuffer += " = ";
-    diagnosticsBuffer += amString( itemValue );
+    diagnosticsBuffer.appendNumber( itemValue );
     if ( !additionalInfo.empty() )
     {
         diagnosticsBuffer += " ";
@@ -826,9 +1054,9 @@ void antProcessing::appendDiagnosticsLine
 {
 
     appendDiagnosticsItemName( itemName );
-    diagnosticsBuffer += amString( byteValue );
+    diagnosticsBuffer.appendHex( byteValue );
     diagnosticsBuffer += " = ";
-    diagnosticsBuffer += amString( itemValue );
+    diagnosticsBuffer.appendNumber( itemValue );
     if ( !additionalInfo.empty() )
     {
         diagnosticsBuffer += " ";
@@ -854,7 +1082,7 @@ void antProcessing::appendDiagnosticsLine
     appendDiagnosticsItemName( itemName );
     diagnosticsBuffer += amString( byteValue1, byteValue2 );
     diagnosticsBuffer += " = ";
-    diagnosticsBuffer += amString( itemValue );
+    diagnosticsBuffer.appendNumber( itemValue );
     if ( !additionalInfo.empty() )
     {
         diagnosticsBuffer += " ";
@@ -881,7 +1109,7 @@ void antProcessing::appendDiagnosticsLine
     appendDiagnosticsItemName( itemName );
     diagnosticsBuffer += amString( byteValue1, byteValue2, byteValue3 );
     diagnosticsBuffer += " = ";
-    diagnosticsBuffer += amString( itemValue );
+    diagnosticsBuffer.appendNumber( itemValue );
     if ( !additionalInfo.empty() )
     {
         diagnosticsBuffer += " ";
@@ -909,7 +1137,7 @@ void antProcessing::appendDiagnosticsLine
     appendDiagnosticsItemName( itemName );
     diagnosticsBuffer += amString( byteValue1, byteValue2, byteValue3, byteValue4 );
     diagnosticsBuffer += " = ";
-    diagnosticsBuffer += amString( itemValue );
+    diagnosticsBuffer.appendNumber( itemValue );
     if ( !additionalInfo.empty() )
     {
         diagnosticsBuffer += " ";
@@ -927,8 +1155,7 @@ void antProcessing::appendOutput
     BYTE itemValue
 )
 {
-    outBuffer += "\t";
-    outBuffer += amString( itemValue );
+    antTextFormatter::appendHexItem( outBuffer, itemValue );
 }
 
 // -------------------------------------------------------------------------------------------------//
@@ -942,9 +1169,7 @@ void antProcessing::appendOutput
     const amString &unit
 )
 {
-    outBuffer += "\t";
-    outBuffer += amString( itemValue );
-    outBuffer += unit;
+    antTextFormatter::appendItem( outBuffer, itemValue, unit );
 }
 
 // -------------------------------------------------------------------------------------------------//
@@ -960,9 +1185,7 @@ void antProcessing::appendOutput
     const amString &unit
 )
 {
-    outBuffer += "\t";
-    outBuffer += amString( itemValue, precision );
-    outBuffer += unit;
+    antTextFormatter::appendItem( outBuffer, itemValue, precision, unit );
 }
 
 // -------------------------------------------------------------------------------------------------//
@@ -976,9 +1199,7 @@ void antProcessing::appendOutput
     const amString &unit
 )
 {
-    outBuffer += "\t";
-    outBuffer += amString( itemValue );
-    outBuffer += unit;
+    antTextFormatter::appendItem( outBuffer, itemValue, unit );
 }
 
 // -------------------------------------------------------------------------------------------------//
@@ -991,8 +1212,7 @@ void antProcessing::appendOutput
     const amString &itemValue
 )
 {
-    outBuffer += "\t";
-    outBuffer += itemValue;
+    antTextFormatter::appendItem( outBuffer, itemValue );
 }
 
 // -------------------------------------------------------------------------------------------------//
@@ -1008,15 +1228,7 @@ void antProcessing::appendOutputConditional
     const amString &itemValueFalse
 )
 {
-    outBuffer += "\t";
-    if ( condition )
-    {
-        outBuffer += itemValueTrue;
-    }
-    else
-    {
-        outBuffer += itemValueFalse;
-    }
+    antTextFormatter::appendItemConditional( outBuffer, condition, itemValueTrue, itemValueFalse );
 }
 
 // -------------------------------------------------------------------------------------------------//
@@ -1032,15 +1244,7 @@ void antProcessing::appendOutputConditional
     const amString &itemValueFalse
 )
 {
-    outBuffer += "\t";
-    if ( condition )
-    {
-        outBuffer += amString( itemValueTrue );
-    }
-    else
-    {
-        outBuffer += itemValueFalse;
-    }
+    antTextFormatter::appendItemConditional( outBuffer, condition, itemValueTrue, itemValueFalse );
 }
 
 // -------------------------------------------------------------------------------------------------//
@@ -1056,15 +1260,7 @@ void antProcessing::appendOutputConditional
     const amString &itemValueFalse
 )
 {
-    outBuffer += "\t";
-    if ( condition )
-    {
-        outBuffer += amString( itemValueTrue );
-    }
-    else
-    {
-        outBuffer += itemValueFalse;
-    }
+    antTextFormatter::appendItemConditional( outBuffer, condition, itemValueTrue, itemValueFalse );
 }
 
 // -------------------------------------------------------------------------------------------------//
@@ -1085,7 +1281,7 @@ void antProcessing::appendOutputConditional
     outBuffer += "\t";
     if ( condition )
     {
-        outBuffer += amString( itemValueTrue, precision );
+        outBuffer.appendNumber( itemValueTrue, precision );
     }
     else
     {
@@ -1108,23 +1304,7 @@ void antProcessing::appendOutput4Way
     const amString &itemValue3
 )
 {
-    outBuffer += "\t";
-    if ( condition == 0 )
-    {
-        outBuffer += itemValue0;
-    }
-    else if ( condition == 1 )
-    {
-        outBuffer += itemValue1;
-    }
-    else if ( condition == 2 )
-    {
-        outBuffer += itemValue2;
-    }
-    else
-    {
-        outBuffer += itemValue3;
-    }
+    antTextFormatter::appendItem4Way( outBuffer, condition, itemValue0, itemValue1, itemValue2, itemValue3 );
 }
 
 // -------------------------------------------------------------------------------------------------//
@@ -1138,12 +1318,7 @@ void antProcessing::appendJSONItem
     BYTE            itemValue
 )
 {
-    outBuffer += C_JSON_INDENT;
-    outBuffer += "\"";
-    outBuffer += itemName;
-    outBuffer += "\": ";
-    outBuffer += amString( itemValue );
-    outBuffer += ",\n";
+    antTextFormatter::appendJSONHexItem( outBuffer, itemName, itemValue );
 }
 
 // -------------------------------------------------------------------------------------------------//
@@ -1157,12 +1332,7 @@ void antProcessing::appendJSONItem
     unsigned int    itemValue
 )
 {
-    outBuffer += C_JSON_INDENT;
-    outBuffer += "\"";
-    outBuffer += itemName;
-    outBuffer += "\": ";
-    outBuffer += amString( itemValue );
-    outBuffer += ",\n";
+    antTextFormatter::appendJSONItem( outBuffer, itemName, itemValue );
 }
 
 // -------------------------------------------------------------------------------------------------//
@@ -1176,12 +1346,7 @@ void antProcessing::appendJSONItem
     int             itemValue
 )
 {
-    outBuffer += C_JSON_INDENT;
-    outBuffer += "\"";
-    outBuffer += itemName;
-    outBuffer += "\": ";
-    outBuffer += amString( itemValue );
-    outBuffer += ",\n";
+    antTextFormatter::appendJSONItem( outBuffer, itemName, itemValue );
 }
 
 // -------------------------------------------------------------------------------------------------//
@@ -1195,12 +1360,7 @@ void antProcessing::appendJSONItemB
     bool            itemValue
 )
 {
-    outBuffer += C_JSON_INDENT;
-    outBuffer += "\"";
-    outBuffer += itemName;
-    outBuffer += "\": ";
-    outBuffer += ( itemValue ? C_TRUE_JSON : C_FALSE_JSON );
-    outBuffer += ",\n";
+    antTextFormatter::appendJSONItemB( outBuffer, itemName, itemValue );
 }
 
 // -------------------------------------------------------------------------------------------------//
@@ -1214,12 +1374,7 @@ void antProcessing::appendJSONItem
     const amString &itemValue
 )
 {
-    outBuffer += C_JSON_INDENT;
-    outBuffer += "\"";
-    outBuffer += itemName;
-    outBuffer += "\": \"";
-    outBuffer += itemValue;
-    outBuffer += "\",\n";
+    antTextFormatter::appendJSONItem( outBuffer, itemName, itemValue );
 }
 
 // -------------------------------------------------------------------------------------------------//
@@ -1235,12 +1390,7 @@ void antProcessing::appendJSONItem
     int             precision
 )
 {
-    outBuffer += C_JSON_INDENT;
-    outBuffer += "\"";
-    outBuffer += itemName;
-    outBuffer += "\": ";
-    outBuffer += amString( itemValue, precision );
-    outBuffer += ",\n";
+    antTextFormatter::appendJSONItem( outBuffer, itemName, itemValue, precision );
 }
 
 // -------------------------------------------------------------------------------------------------//
@@ -1256,15 +1406,7 @@ void antProcessing::appendJSONItem
     BYTE            itemValue
 )
 {
-    outBuffer += C_JSON_INDENT;
-    outBuffer += "\"";
-    outBuffer += itemName;
-    outBuffer += "[ ";;
-    outBuffer += amString( index );
-    outBuffer += " ]";;
-    outBuffer += "\": ";
-    outBuffer += amString(itemValue ); 
-    outBuffer += ",\n";
+    antTextFormatter::appendJSONHexItem( outBuffer, itemName, index, itemValue );
 }
 
 // -------------------------------------------------------------------------------------------------//
@@ -1281,19 +1423,7 @@ void antProcessing::appendJSONItemConditional
     const amString &itemValueFalse
 )
 {
-    outBuffer += C_JSON_INDENT;
-    outBuffer += "\"";
-    outBuffer += itemName;
-    outBuffer += "\": \"";
-    if ( condition )
-    {
-        outBuffer += itemValueTrue;
-    }
-    else
-    {
-        outBuffer += itemValueFalse;
-    }
-    outBuffer += "\",\n";
+    antTextFormatter::appendJSONItemConditional( outBuffer, itemName, condition, itemValueTrue, itemValueFalse );
 }
 
 // -------------------------------------------------------------------------------------------------//
@@ -1310,21 +1440,7 @@ void antProcessing::appendJSONItemConditional
     const amString &itemValueFalse
 )
 {
-    outBuffer += C_JSON_INDENT;
-    outBuffer += "\"";
-    outBuffer += itemName;
-    if ( condition )
-    {
-        outBuffer += "\": ";
-        outBuffer += amString( itemValueTrue );
-        outBuffer += ",\n";
-    }
-    else
-    {
-        outBuffer += "\": \"";
-        outBuffer += itemValueFalse;
-        outBuffer += "\",\n";
-    }
+    antTextFormatter::appendJSONItemConditional( outBuffer, itemName, condition, itemValueTrue, itemValueFalse );
 }
 
 // -------------------------------------------------------------------------------------------------//
@@ -1341,21 +1457,7 @@ void antProcessing::appendJSONItemConditional
     const amString &itemValueFalse
 )
 {
-    outBuffer += C_JSON_INDENT;
-    outBuffer += "\"";
-    outBuffer += itemName;
-    if ( condition )
-    {
-        outBuffer += "\": ";
-        outBuffer += amString( itemValueTrue );
-        outBuffer += ",\n";
-    }
-    else
-    {
-        outBuffer += "\": \"";
-        outBuffer += itemValueFalse;
-        outBuffer += "\",\n";
-    }
+    antTextFormatter::appendJSONItemConditional( outBuffer, itemName, condition, itemValueTrue, itemValueFalse );
 }
 
 // -------------------------------------------------------------------------------------------------//
@@ -1380,7 +1482,7 @@ void antProcessing::appendJSONItemConditional
     if ( condition )
     {
         outBuffer += "\": ";
-        outBuffer += amString( itemValueTrue );
+        outBuffer.appendNumber( itemValueTrue );
         outBuffer += ",\n";
     }
     else
@@ -1407,27 +1509,7 @@ void antProcessing::appendJSONItem4Way
     const amString &itemValue3
 )
 {
-    outBuffer += C_JSON_INDENT;
-    outBuffer += "\"";
-    outBuffer += itemName;
-    outBuffer += "\": \"";
-    if ( condition == 0 )
-    {
-        outBuffer += itemValue0;
-    }
-    else if ( condition == 1 )
-    {
-        outBuffer += itemValue1;
-    }
-    else if ( condition == 2 )
-    {
-        outBuffer += itemValue2;
-    }
-    else
-    {
-        outBuffer += itemValue3;
-    }
-    outBuffer += "\",\n";
+    antTextFormatter::appendJSONItem4Way( outBuffer, itemName, condition, itemValue0, itemValue1, itemValue2, itemValue3 );
 }
 
 // -------------------------------------------------------------------------------------------------//
@@ -1483,23 +1565,185 @@ void antProcessing::createOutputHeader
 
 // -------------------------------------------------------------------------------------------------//
 //
-// Output version to the output (result) string.
-// If the output mode is JSON also output the exceutable's name and
-// the closing string for the JSON object.
+// Text formatter selected by the output options (-s, -J).
 //
 // -------------------------------------------------------------------------------------------------//
-void antProcessing::appendOutputFooter
+antTextFormatter &antProcessing::getTextFormatter
 (
-    const amString &versionString
+    void
 )
 {
     if ( outputAsJSON )
     {
-        outBuffer += C_JSON_INDENT;
-        outBuffer += "\"program name\": \"";
-        outBuffer += programName;
-        outBuffer += "\",\n";
-
+        return jsonFormatter;
+    }
+    if ( semiCookedOut )
+    {
+        return semiCookedFormatter;
+    }
+    return cookedFormatter;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Write a decoded record to the output (result) string and pass it on to the record sinks.
+// 'format' is the method of antRecordFormatter for the type of the record.
+//
+// -------------------------------------------------------------------------------------------------//
+template <class recordT> void antProcessing::outputRecord
+(
+    const antRecordContext &context,
+    const recordT          &record,
+    void ( antRecordFormatter::*format )( const antRecordContext &, const recordT & )
+)
+{
+    long long formatStart = ( stageStats != NULL ) ? antStageStats::now() : 0;
+
+    if ( outputText )
+    {
+        createOutputHeader( context.sensorID, context.timeStamp );
+        ( getTextFormatter().*format )( context, record );
+        appendOutputFooter( context.version );
+    }
+    for ( size_t counter = 0; counter < recordSinks.size(); ++counter )
+    {
+        ( recordSinks[ counter ]->*format )( context, record );
+    }
+    if ( stageStats != NULL )
+    {
+        stageStats->addTimeSince( STAGE_FORMAT, formatStart );
+    }
+}
+
+void antProcessing::outputRecord( const antRecordContext &context, const antHRMRecord &record )              { outputRecord( context, record, &antRecordFormatter::formatHRM ); }
+void antProcessing::outputRecord( const antRecordContext &context, const antPowerB01Record &record )         { outputRecord( context, record, &antRecordFormatter::formatPowerB01 ); }
+void antProcessing::outputRecord( const antRecordContext &context, const antPowerB02Record &record )         { outputRecord( context, record, &antRecordFormatter::formatPowerB02 ); }
+void antProcessing::outputRecord( const antRecordContext &context, const antPowerB03Record &record )         { outputRecord( context, record, &antRecordFormatter::formatPowerB03 ); }
+void antProcessing::outputRecord( const antRecordContext &context, const antPowerB10Record &record )         { outputRecord( context, record, &antRecordFormatter::formatPowerB10 ); }
+void antProcessing::outputRecord( const antRecordContext &context, const antPowerB11Record &record )         { outputRecord( context, record, &antRecordFormatter::formatPowerB11 ); }
+void antProcessing::outputRecord( const antRecordContext &context, const antPowerB12Record &record )         { outputRecord( context, record, &antRecordFormatter::formatPowerB12 ); }
+void antProcessing::outputRecord( const antRecordContext &context, const antPowerB13Record &record )         { outputRecord( context, record, &antRecordFormatter::formatPowerB13 ); }
+void antProcessing::outputRecord( const antRecordContext &context, const antPowerB20Record &record )         { outputRecord( context, record, &antRecordFormatter::formatPowerB20 ); }
+void antProcessing::outputRecord( const antRecordContext &context, const antCommonPage67Record &record )     { outputRecord( context, record, &antRecordFormatter::formatCommonPage67 ); }
+void antProcessing::outputRecord( const antRecordContext &context, const antCommonPage68Record &record )     { outputRecord( context, record, &antRecordFormatter::formatCommonPage68 ); }
+void antProcessing::outputRecord( const antRecordContext &context, const antCommonPage70Record &record )     { outputRecord( context, record, &antRecordFormatter::formatCommonPage70 ); }
+void antProcessing::outputRecord( const antRecordContext &context, const antCommonPage80Record &record )     { outputRecord( context, record, &antRecordFormatter::formatCommonPage80 ); }
+void antProcessing::outputRecord( const antRecordContext &context, const antCommonPage81Record &record )     { outputRecord( context, record, &antRecordFormatter::formatCommonPage81 ); }
+void antProcessing::outputRecord( const antRecordContext &context, const antCommonPage82Record &record )     { outputRecord( context, record, &antRecordFormatter::formatCommonPage82 ); }
+void antProcessing::outputRecord( const antRecordContext &context, const antCommonPage83Record &record )     { outputRecord( context, record, &antRecordFormatter::formatCommonPage83 ); }
+void antProcessing::outputRecord( const antRecordContext &context, const antCommonPage84Record &record )     { outputRecord( context, record, &antRecordFormatter::formatCommonPage84 ); }
+void antProcessing::outputRecord( const antRecordContext &context, const antEnvironmentPage0Record &record ) { outputRecord( context, record, &antRecordFormatter::formatEnvironmentPage0 ); }
+void antProcessing::outputRecord( const antRecordContext &context, const antEnvironmentPage1Record &record ) { outputRecord( context, record, &antRecordFormatter::formatEnvironmentPage1 ); }
+void antProcessing::outputRecord( const antRecordContext &context, const antCadenceRecord &record )          { outputRecord( context, record, &antRecordFormatter::formatCadence ); }
+void antProcessing::outputRecord( const antRecordContext &context, const antSpeedRecord &record )            { outputRecord( context, record, &antRecordFormatter::formatSpeed ); }
+void antProcessing::outputRecord( const antRecordContext &context, const antSpeedCadenceRecord &record )     { outputRecord( context, record, &antRecordFormatter::formatSpeedCadence ); }
+void antProcessing::outputRecord( const antRecordContext &context, const antAeroRecord &record )             { outputRecord( context, record, &antRecordFormatter::formatAero ); }
+void antProcessing::outputRecord( const antRecordContext &context, const antWeightScaleRecord &record )      { outputRecord( context, record, &antRecordFormatter::formatWeightScale ); }
+void antProcessing::outputRecord( const antRecordContext &context, const antAudioPage1Record &record )       { outputRecord( context, record, &antRecordFormatter::formatAudioPage1 ); }
+void antProcessing::outputRecord( const antRecordContext &context, const antAudioPage16Record &record )      { outputRecord( context, record, &antRecordFormatter::formatAudioPage16 ); }
+void antProcessing::outputRecord( const antRecordContext &context, const antStrideSpeedDistRecord &record )  { outputRecord( context, record, &antRecordFormatter::formatStrideSpeedDist ); }
+void antProcessing::outputRecord( const antRecordContext &context, const antMultiSportRecord &record )       { outputRecord( context, record, &antRecordFormatter::formatMultiSport ); }
+void antProcessing::outputRecord( const antRecordContext &context, const antUnsupportedPageRecord &record )  { outputRecord( context, record, &antRecordFormatter::formatUnsupportedPage ); }
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Write a record of the given type (records read from a binary stream).
+//
+// -------------------------------------------------------------------------------------------------//
+void antProcessing::outputRecord
+(
+    int                     recordType,
+    const antRecordContext &context,
+    const antRecord        &record
+)
+{
+    switch ( recordType )
+    {
+        case ANT_HRM_RECORD:               outputRecord( context, record.hrm );
+                                           break;
+        case ANT_POWER_B01_RECORD:         outputRecord( context, record.powerB01 );
+                                           break;
+        case ANT_POWER_B02_RECORD:         outputRecord( context, record.powerB02 );
+                                           break;
+        case ANT_POWER_B03_RECORD:         outputRecord( context, record.powerB03 );
+                                           break;
+        case ANT_POWER_B10_RECORD:         outputRecord( context, record.powerB10 );
+                                           break;
+        case ANT_POWER_B11_RECORD:         outputRecord( context, record.powerB11 );
+                                           break;
+        case ANT_POWER_B12_RECORD:         outputRecord( context, record.powerB12 );
+                                           break;
+        case ANT_POWER_B13_RECORD:         outputRecord( context, record.powerB13 );
+                                           break;
+        case ANT_POWER_B20_RECORD:         outputRecord( context, record.powerB20 );
+                                           break;
+        case ANT_COMMON_PAGE67_RECORD:     outputRecord( context, record.commonPage67 );
+                                           break;
+        case ANT_COMMON_PAGE68_RECORD:     outputRecord( context, record.commonPage68 );
+                                           break;
+        case ANT_COMMON_PAGE70_RECORD:     outputRecord( context, record.commonPage70 );
+                                           break;
+        case ANT_COMMON_PAGE80_RECORD:     outputRecord( context, record.commonPage80 );
+                                           break;
+        case ANT_COMMON_PAGE81_RECORD:     outputRecord( context, record.commonPage81 );
+                                           break;
+        case ANT_COMMON_PAGE82_RECORD:     outputRecord( context, record.commonPage82 );
+                                           break;
+        case ANT_COMMON_PAGE83_RECORD:     outputRecord( context, record.commonPage83 );
+                                           break;
+        case ANT_COMMON_PAGE84_RECORD:     outputRecord( context, record.commonPage84 );
+                                           break;
+        case ANT_ENVIRONMENT_PAGE0_RECORD: outputRecord( context, record.environmentPage0 );
+                                           break;
+        case ANT_ENVIRONMENT_PAGE1_RECORD: outputRecord( context, record.environmentPage1 );
+                                           break;
+        case ANT_CADENCE_RECORD:           outputRecord( context, record.cadence );
+                                           break;
+        case ANT_SPEED_RECORD:             outputRecord( context, record.speed );
+                                           break;
+        case ANT_SPEED_CADENCE_RECORD:     outputRecord( context, record.speedCadence );
+                                           break;
+        case ANT_AERO_RECORD:              outputRecord( context, record.aero );
+                                           break;
+        case ANT_WEIGHT_SCALE_RECORD:      outputRecord( context, record.weightScale );
+                                           break;
+        case ANT_AUDIO_PAGE1_RECORD:       outputRecord( context, record.audioPage1 );
+                                           break;
+        case ANT_AUDIO_PAGE16_RECORD:      outputRecord( context, record.audioPage16 );
+                                           break;
+        case ANT_STRIDE_SPEED_DIST_RECORD: outputRecord( context, record.strideSpeedDist );
+                                           break;
+        case ANT_MULTI_SPORT_RECORD:       outputRecord( context, record.multiSport );
+                                           break;
+        case ANT_UNSUPPORTED_PAGE_RECORD:  outputRecord( context, record.unsupportedPage );
+                                           break;
+    }
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Output version to the output (result) string.
+// If the output mode is JSON also output the exceutable's name and
+// the closing string for the JSON object.
+//
+// -------------------------------------------------------------------------------------------------//
+void antProcessing::appendOutputFooter
+(
+    const amString &versionString
+)
+{
+    if ( outputAsJSON )
+    {
+        if ( followsGap )
+        {
+            appendJSONItemB( "sequence gap", true );
+        }
+
+        outBuffer += C_JSON_INDENT;
+        outBuffer += "\"program name\": \"";
+        outBuffer += programName;
+        outBuffer += "\",\n";
+
         outBuffer += C_JSON_INDENT;
         outBuffer += "\"version\": \"";
         outBuffer += versionString;
@@ -1512,6 +1756,11 @@ void antProcessing::appendOutputFooter
     {
         outBuffer += "\t";
         outBuffer += versionString;
+        if ( followsGap )
+        {
+            outBuffer += "\t";
+            outBuffer += C_SEQUENCE_GAP_SYMBOL;
+        }
     }
 }
 
@@ -1579,10 +1828,13 @@ void antProcessing::createUnknownDeviceTypeString
 bool antProcessing::processCommonPages
 (
     const amString &sensorID,
+    const amString &timeStampBuffer,
+    const amString &versionString,
     const BYTE      payLoad[],
     bool            outputPage
 )
 {
+    antRecordContext context( sensorID, timeStampBuffer, versionString );
     bool         result             = false;
     unsigned int dataPage           = payLoad[ 0 ];
     unsigned int descriptor1        = 0;
@@ -1639,7 +1891,7 @@ bool antProcessing::processCommonPages
                      appendDiagnosticsLine( "Device Type",     payLoad[ 5 ], payLoad[ 4 ], value4 );
                      appendDiagnosticsLine( "Manufacturer ID", payLoad[ 7 ], payLoad[ 6 ], value5 );
                  }
-                 result = createCommonResultStringPage67( sensorID, outputPage, value1, value2, value3, value4, value5 );
+                 result = outputCommonPage67Record( context, outputPage, value1, value2, value3, value4, value5 );
                  break;
 
         case 68: // ---------------------------------------------------------------------------------
@@ -1657,7 +1909,7 @@ bool antProcessing::processCommonPages
                      appendDiagnosticsLine( "Channel Period",      payLoad[ 3 ], value3 );
                      appendDiagnosticsLine( "Host Serial Number",  payLoad[ 7 ], payLoad[ 6 ], payLoad[ 5 ], payLoad[ 4 ], value4 );
                  }
-                 result = createCommonResultStringPage68( sensorID, outputPage, value1, value2, value3, value4 );
+                 result = outputCommonPage68Record( context, outputPage, value1, value2, value3, value4 );
                  break;
 
         case 70: descriptor1       = byte2UInt( payLoad[ 3 ] );
@@ -1673,7 +1925,7 @@ bool antProcessing::processCommonPages
                      appendDiagnosticsLine( "Requested Page ",  payLoad[ 6 ], requestedPage );
                      appendDiagnosticsLine( "Command Type",       payLoad[ 7 ], commandType );
                  }
-                 result = createCommonResultStringPage70( sensorID, outputPage, descriptor1, descriptor2, requestedResponse, requestedPage, commandType );
+                 result = outputCommonPage70Record( context, outputPage, descriptor1, descriptor2, requestedResponse, requestedPage, commandType );
                  break;
 
         case 80: modelNumber      = byte2UInt( payLoad[ 7 ], payLoad[ 6 ] );
@@ -1685,7 +1937,7 @@ bool antProcessing::processCommonPages
                      appendDiagnosticsLine( "Manufacturer ID",   payLoad[ 5 ], payLoad[ 4 ], manufacturerID );
                      appendDiagnosticsLine( "Model Number",      payLoad[ 7 ], payLoad[ 6 ], modelNumber );
                  }
-                 result = createCommonResultStringPage80( sensorID, outputPage, manufacturerID, hardwareRevision, modelNumber );
+                 result = outputCommonPage80Record( context, outputPage, manufacturerID, hardwareRevision, modelNumber );
                  break;
 
         case 81: serialNumber     = byte2UInt( payLoad[ 3 ] );
@@ -1695,7 +1947,7 @@ bool antProcessing::processCommonPages
                      appendDiagnosticsLine( "Software Revision", payLoad[ 7 ], payLoad[ 6 ], payLoad[ 5 ], payLoad[ 4 ], softwareRevision );
                      appendDiagnosticsLine( "Serial Number",     payLoad[ 3 ], serialNumber );
                  }
-                 result = createCommonResultStringPage81( sensorID, outputPage, serialNumber, softwareRevision );
+                 result = outputCommonPage81Record( context, outputPage, serialNumber, softwareRevision );
                  break;
 
         case 82: // - - Page 82 (0x52) - Battery status - -
@@ -1728,7 +1980,7 @@ bool antProcessing::processCommonPages
                      appendDiagnosticsLine( "Battery Status ID",     payLoad[ 7 ],               status,       "(bits 4-6)" );
                      appendDiagnosticsLine( "Resolution",            payLoad[ 7 ],               resolution,   "(7th bit: [0/1] for [32/2] seconds)" );
                  }
-                 result = createCommonResultStringPage82( sensorID, outputPage, voltage256, status, deltaOperatingTime, resolution, nbBatteries, batteryID );
+                 result = outputCommonPage82Record( context, outputPage, voltage256, status, deltaOperatingTime, resolution, nbBatteries, batteryID );
                  break;
 
         case 83: // Time And Date
@@ -1749,7 +2001,7 @@ bool antProcessing::processCommonPages
                      appendDiagnosticsLine( "Month",           payLoad[ 6 ], month );
                      appendDiagnosticsLine( "Year",            payLoad[ 7 ], year );
                  }
-                 result = createCommonResultStringPage83( sensorID, outputPage, seconds, minutes, hours, weekDayNo, monthDay, month, year );
+                 result = outputCommonPage83Record( context, outputPage, seconds, minutes, hours, weekDayNo, monthDay, month, year );
                  break;
 
         case 84: // Weather Data
@@ -1764,11 +2016,11 @@ bool antProcessing::processCommonPages
                      appendDiagnosticsLine( "Sub Page 2",   payLoad[ 3 ], subPage2 );
                      appendDiagnosticsLine( "Data Field 2", payLoad[ 7 ], payLoad[ 6 ], dataField2 );
                  }
-                 result = createCommonResultStringPage84( sensorID, outputPage, subPage1, subPage2, dataField1, dataField2 );
+                 result = outputCommonPage84Record( context, outputPage, subPage1, subPage2, dataField1, dataField2 );
                  break;
 
         default: // - - Unknown Page - - - - - - - - - - - - - - - - -
-                 result = createCommonResultStringUnsupportedPage( sensorID, dataPage, payLoad );
+                 result = outputUnsupportedPageRecord( context, dataPage, payLoad );
                  break;
     }
     return result;
@@ -1784,6 +2036,7 @@ bool antProcessing::processCommonPagesSemiCooked
 (
     const amSplitString &words,
     unsigned int         startCounter,
+    const amString      &versionString,
     bool                 outputPage
 )
 {
@@ -1828,6 +2081,8 @@ bool antProcessing::processCommonPagesSemiCooked
         unsigned int   value5             = 0;
         unsigned int   dataPage           = words[ counter++ ].toUInt();
         const amString sensorID           = words[ 0 ];
+        const amString timeStampBuffer    = words[ 1 ];
+        antRecordContext context( sensorID, timeStampBuffer, versionString );
 
         switch ( dataPage )
         {
@@ -1850,7 +2105,7 @@ bool antProcessing::processCommonPagesSemiCooked
                              appendDiagnosticsLine( "Device Type",     words[ counter++ ], value4 );
                              appendDiagnosticsLine( "Manufacturer ID", words[ counter++ ], value5 );
                          }
-                         result = createCommonResultStringPage67( sensorID, outputPage, value1, value2, value3, value4, value5 );
+                         result = outputCommonPage67Record( context, outputPage, value1, value2, value3, value4, value5 );
                          break;
                      }
             case 68: // - - Page 68 - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -1870,7 +2125,7 @@ bool antProcessing::processCommonPagesSemiCooked
                              appendDiagnosticsLine( "Channel Period",      words[ counter++ ], value3 );
                              appendDiagnosticsLine( "Host Serial Number",  words[ counter++ ], value4 );
                          }
-                         result = createCommonResultStringPage68( sensorID, outputPage, value1, value2, value3, value4 );
+                         result = outputCommonPage68Record( context, outputPage, value1, value2, value3, value4 );
                          break;
                      }
             case 70: // - - Page 70 - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -1892,7 +2147,7 @@ bool antProcessing::processCommonPagesSemiCooked
                              appendDiagnosticsLine( "Requested Page ",  words[ counter++ ], requestedPage );
                              appendDiagnosticsLine( "Command Type",       words[ counter++ ], commandType );
                          }
-                         result = createCommonResultStringPage70( sensorID, outputPage, descriptor1, descriptor2, requestedResponse, requestedPage, commandType );
+                         result = outputCommonPage70Record( context, outputPage, descriptor1, descriptor2, requestedResponse, requestedPage, commandType );
                      }
                      break;
             case 80: // - - Page 80 - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -1910,7 +2165,7 @@ bool antProcessing::processCommonPagesSemiCooked
                              appendDiagnosticsLine( "Manufacturer ID",   words[ counter++ ], manufacturerID );
                              appendDiagnosticsLine( "Model Number",      words[ counter++ ], modelNumber );
                          }
-                         result = createCommonResultStringPage80( sensorID, outputPage, manufacturerID, hardwareRevision, modelNumber );
+                         result = outputCommonPage80Record( context, outputPage, manufacturerID, hardwareRevision, modelNumber );
                      }
                      break;
             case 81: // - - Page 81 - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -1926,7 +2181,7 @@ bool antProcessing::processCommonPagesSemiCooked
                              appendDiagnosticsLine( "Serial Number",     words[ counter++ ], serialNumber );
                              appendDiagnosticsLine( "Software Revision", words[ counter++ ], softwareRevision );
                          }
-                         result = createCommonResultStringPage81( sensorID, outputPage, serialNumber, softwareRevision );
+                         result = outputCommonPage81Record( context, outputPage, serialNumber, softwareRevision );
                      }
                      break;
             case 82: // - - Page 82 - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -1950,7 +2205,7 @@ bool antProcessing::processCommonPagesSemiCooked
                              appendDiagnosticsLine( "nbBatteries",        words[ counter++ ], nbBatteries );
                              appendDiagnosticsLine( "batteryID",          words[ counter++ ], batteryID );
                          }
-                         result = createCommonResultStringPage82( sensorID, outputPage, voltage256, status, deltaOperatingTime, resolution, nbBatteries, batteryID );
+                         result = outputCommonPage82Record( context, outputPage, voltage256, status, deltaOperatingTime, resolution, nbBatteries, batteryID );
                      }
                      break;
             case 83: // - - Page 83 - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -1976,7 +2231,7 @@ bool antProcessing::processCommonPagesSemiCooked
                              appendDiagnosticsLine( "Month",           words[ counter++ ], month );
                              appendDiagnosticsLine( "Year",            words[ counter++ ], year );
                          }
-                         result = createCommonResultStringPage83( sensorID, outputPage, seconds, minutes, hours, weekDayNo, monthDay, month, year );
+                         result = outputCommonPage83Record( context, outputPage, seconds, minutes, hours, weekDayNo, monthDay, month, year );
                      }
                      break;
             case 84: // - - Page 84 - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -1996,11 +2251,11 @@ bool antProcessing::processCommonPagesSemiCooked
                              appendDiagnosticsLine( "Sub Page 2",   words[ counter++ ], subPage2 );
                              appendDiagnosticsLine( "Data Field 2", words[ counter++ ], dataField2 );
                          }
-                         result = createCommonResultStringPage84( sensorID, outputPage, subPage1, subPage2, dataField1, dataField2 );
+                         result = outputCommonPage84Record( context, outputPage, subPage1, subPage2, dataField1, dataField2 );
                      }
                      break;
             default: // - - Unknown Page - - - - - - - - - - - - - - - - -
-                     result = createCommonResultStringUnsupportedPageSemiCooked( sensorID, dataPage, words, startCounter );
+                     result = outputUnsupportedPageRecordSemiCooked( context, dataPage, words, startCounter );
                      break;
         }
     }
@@ -2009,1045 +2264,954 @@ bool antProcessing::processCommonPagesSemiCooked
 
 // -------------------------------------------------------------------------------------------------//
 //
-// Create the output for a common page (data page 0x43 or 67) and
-// append it to the output (result) string.
+// Output a common page (data page 0x43 or 67).
 //
 // Note: This needs reworking - ANT-FS Documentation required
 //
 // -------------------------------------------------------------------------------------------------//
-bool antProcessing::createCommonResultStringPage67
+bool antProcessing::outputCommonPage67Record
 (
-    const amString &sensorID,
-    bool            outputPage,
-    unsigned int    value1,
-    unsigned int    value2,
-    unsigned int    value3,
-    unsigned int    value4,
-    unsigned int    value5
+    const antRecordContext &context,
+    bool                    outputPageNo,
+    unsigned int            value1,
+    unsigned int            value2,
+    unsigned int            value3,
+    unsigned int            value4,
+    unsigned int            value5
 )
 {
     // For now semi-cooked and fully cooked output are the same
-    bool result = true;
-
-    if ( outputPage )
-    {
-        int dataPage = 67;
-        if ( outputAsJSON )
-        {
-            appendJSONItem( C_DATA_PAGE_JSON, dataPage );
-        }
-        else
-        {
-            appendOutput( dataPage );
-        }
-    }
-
-    if ( outputAsJSON )
-    {
-        appendJSONItem( "status byte 1",   value1 );
-        appendJSONItem( "status byte 2",   value2 );
-        appendJSONItem( "authentication",  value3 );
-        appendJSONItem( "device type",     value4 );
-        appendJSONItem( "manufacturer id", value5 );
-    }
-    else
-    {
-        appendOutput( value1 );
-        appendOutput( value2 );
-        appendOutput( value3 );
-        appendOutput( value4 );
-        appendOutput( value5 );
-    }
-    return result;
+    antCommonPage67Record record = antCommonPage67Record();
+
+    record.outputPageNo   = outputPageNo;
+    record.statusByte1    = value1;
+    record.statusByte2    = value2;
+    record.authentication = value3;
+    record.deviceType     = value4;
+    record.manufacturerID = value5;
+    outputRecord( context, record );
+    return true;
 }
 
 // -------------------------------------------------------------------------------------------------//
 //
-// Create the output for a common page (data page 0x44 or 68) and
-// append it to the output (result) string.
+// Output a common page (data page 0x44 or 68).
 //
 // Note: This needs reworking - ANT-FS Documentation required
 //
 // -------------------------------------------------------------------------------------------------//
-bool antProcessing::createCommonResultStringPage68
+bool antProcessing::outputCommonPage68Record
 (
-    const amString &sensorID,
-    bool            outputPage,
-    unsigned int    value1,
-    unsigned int    value2,
-    unsigned int    value3,
-    unsigned int    value4
+    const antRecordContext &context,
+    bool                    outputPageNo,
+    unsigned int            value1,
+    unsigned int            value2,
+    unsigned int            value3,
+    unsigned int            value4
 )
 {
     // For now semi-cooked and fully cooked output are the same
-    bool result = true;
+    antCommonPage68Record record = antCommonPage68Record();
+
+    record.outputPageNo      = outputPageNo;
+    record.commandResponseID = value1;
+    record.channelFrequency  = value2;
+    record.channelPeriod     = value3;
+    record.hostSerialNumber  = value4;
+    outputRecord( context, record );
+    return true;
+}
 
-    if ( outputPage )
-    {
-        int dataPage = 68;
-        if ( outputAsJSON )
-        {
-            appendJSONItem( C_DATA_PAGE_JSON, dataPage );
-        }
-        else
-        {
-            appendOutput( dataPage );
-        }
-    }
+// -------------------------------------------------------------------------------------------------//
+//
+// Output a common page (data page 0x46 or 70).
+//
+// -------------------------------------------------------------------------------------------------//
+bool antProcessing::outputCommonPage70Record
+(
+    const antRecordContext &context,
+    bool                    outputPageNo,
+    unsigned int            descriptor1,
+    unsigned int            descriptor2,
+    unsigned int            requestedResponse,
+    unsigned int            requestedPage,
+    unsigned int            commandType
+)
+{
+    antCommonPage70Record record = antCommonPage70Record();
+
+    record.outputPageNo      = outputPageNo;
+    record.descriptor1       = descriptor1;
+    record.descriptor2       = descriptor2;
+    record.requestedResponse = requestedResponse;
+    record.requestedPage     = requestedPage;
+    record.commandType       = commandType;
+    outputRecord( context, record );
+    return true;
+}
 
-    if ( outputAsJSON )
-    {
-        appendJSONItem( "command/response id", value1 );
-        appendJSONItem( "channel frequency",   value2 );
-        appendJSONItem( "channel period",      value3 );
-        appendJSONItem( "host serial number",  value4 );
-    }
-    else
-    {
-        appendOutput( value1 );
-        appendOutput( value2 );
-        appendOutput( value3 );
-        appendOutput( value4 );
-    }
-    return result;
+// -------------------------------------------------------------------------------------------------//
+//
+// Output a common page (data page 0x50 or 80).
+//
+// -------------------------------------------------------------------------------------------------//
+bool antProcessing::outputCommonPage80Record
+(
+    const antRecordContext &context,
+    bool                    outputPageNo,
+    unsigned int            manufacturerID,
+    unsigned int            hardwareRevision,
+    unsigned int            modelNumber
+)
+{
+    antCommonPage80Record record = antCommonPage80Record();
+
+    record.outputPageNo     = outputPageNo;
+    record.manufacturerID   = manufacturerID;
+    record.hardwareRevision = hardwareRevision;
+    record.modelNumber      = modelNumber;
+    outputRecord( context, record );
+    return true;
 }
 
 // -------------------------------------------------------------------------------------------------//
 //
-// Create the output for a common page (data page 0x46 or 70) and
-// append it to the output (result) string.
+// Output a common page (data page 0x51 or 81).
 //
 // -------------------------------------------------------------------------------------------------//
-bool antProcessing::createCommonResultStringPage70
+bool antProcessing::outputCommonPage81Record
 (
-    const amString &sensorID,
-    bool            outputPage,
-    unsigned int    descriptor1,
-    unsigned int    descriptor2,
-    unsigned int    requestedResponse,
-    unsigned int    requestedPage,
-    unsigned int    commandType
+    const antRecordContext &context,
+    bool                    outputPageNo,
+    unsigned int            serialNumber,
+    unsigned int            softwareRevision
+)
+{
+    antCommonPage81Record record = antCommonPage81Record();
+
+    record.outputPageNo     = outputPageNo;
+    record.serialNumber     = serialNumber;
+    record.softwareRevision = softwareRevision;
+    outputRecord( context, record );
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Output a common page (data page 0x52 or 82).
+// The total operating time is the sum of the operating times of the sensor.
+//
+// -------------------------------------------------------------------------------------------------//
+bool antProcessing::outputCommonPage82Record
+(
+    const antRecordContext &context,
+    bool                    outputPageNo,
+    unsigned int            voltage256,
+    unsigned int            status,
+    unsigned int            deltaOperatingTime,
+    unsigned int            resolution,
+    unsigned int            nbBatteries,
+    unsigned int            batteryID
 )
 {
-    bool result = true;
+    antCommonPage82Record record = antCommonPage82Record();
+
+    record.outputPageNo       = outputPageNo;
+    record.voltage256         = voltage256;
+    record.status             = status;
+    record.deltaOperatingTime = deltaOperatingTime;
+    record.resolution         = resolution;
+    record.nbBatteries        = nbBatteries;
+    record.batteryID          = batteryID;
 
-    if ( outputPage )
+    if ( !semiCookedOut )
     {
-        int dataPage = 70;
-        if ( outputAsJSON )
-        {
-            appendJSONItem( C_DATA_PAGE_JSON, dataPage );
-        }
-        else
-        {
-            appendOutput( dataPage );
-        }
+        record.totalOperatingTime  = getTotalOperationTime( context.sensorID );
+        record.totalOperatingTime += ( double ) deltaOperatingTime * ( double ) resolution;
+        setTotalOperationTime( context.sensorID, record.totalOperatingTime );
     }
 
-    if ( outputAsJSON )
-    {
-        if ( !semiCookedOut && ( descriptor1 == 255 ) )
-        {
-            appendJSONItem( "descriptor byte 1 page", C_NONE_ID );
-        }
-        else
-        {
-            appendJSONItem( "descriptor byte 1 page", descriptor1 );
-        }
+    outputRecord( context, record );
+    return true;
+}
 
-        if ( !semiCookedOut && ( descriptor2 == 255 ) )
-        {
-            appendJSONItem( "descriptor byte 2 page", C_NONE_ID );
-        }
-        else
-        {
-            appendJSONItem( "descriptor byte 2 page", descriptor2 );
-        }
+// -------------------------------------------------------------------------------------------------//
+//
+// Output a common page (data page 0x53 or 83).
+//
+// -------------------------------------------------------------------------------------------------//
+bool antProcessing::outputCommonPage83Record
+(
+    const antRecordContext &context,
+    bool                    outputPageNo,
+    unsigned int            seconds,
+    unsigned int            minutes,
+    unsigned int            hours,
+    unsigned int            weekDayNo,
+    unsigned int            monthDay,
+    unsigned int            month,
+    unsigned int            year
+)
+{
+    antCommonPage83Record record = antCommonPage83Record();
+
+    record.outputPageNo = outputPageNo;
+    record.seconds      = seconds;
+    record.minutes      = minutes;
+    record.hours        = hours;
+    record.weekDayNo    = weekDayNo;
+    record.monthDay     = monthDay;
+    record.month        = month;
+    record.year         = year;
+    outputRecord( context, record );
+    return true;
+}
 
-        if ( semiCookedOut )
-        {
-            appendJSONItem( "requested response",    requestedResponse );
-            appendJSONItem( "requested page number", requestedPage );
-            appendJSONItem( "command type",          commandType );
-        }
-        else
-        {
-            if ( requestedResponse == 0 )
-            {
-                appendJSONItem( "number of transmisions", C_INVALID_JSON );
-            }
-            else if ( requestedResponse == 128 )
-            {
-                appendJSONItem( "number of transmisions", "until success acknowledged" );
-            }
-            else
-            {
-                appendJSONItem( "number of transmisions", requestedResponse & 0x80 );
-                appendJSONItem( "acknowledgement reply", ( requestedResponse & 128 ) ? C_TRUE_JSON : C_FALSE_JSON );
-            }
-            appendJSONItem( "requested page number", requestedPage );
-            appendJSONItem( "command type", ( commandType == 1 ) ? "data page" : "ant fs session" );
-        }
-    }
-    else
-    {
-        // Power Meters the page number is already identified by the device type (as PWRB46 - 46 = 0x70)
+// -------------------------------------------------------------------------------------------------//
+//
+// Output a common page (data page 0x54 or 84).
+//
+// -------------------------------------------------------------------------------------------------//
+bool antProcessing::outputCommonPage84Record
+(
+    const antRecordContext &context,
+    bool                    outputPageNo,
+    unsigned int            subPage1,
+    unsigned int            subPage2,
+    unsigned int            dataField1,
+    unsigned int            dataField2
+)
+{
+    antCommonPage84Record record = antCommonPage84Record();
+
+    record.outputPageNo = outputPageNo;
+    record.subPage1     = subPage1;
+    record.subPage2     = subPage2;
+    record.dataField1   = dataField1;
+    record.dataField2   = dataField2;
+    outputRecord( context, record );
+    return true;
+}
 
-        if ( semiCookedOut )
+amDeviceType antProcessing::processUnsupportedDataPage
+(
+    const amSplitString &words
+)
+{
+    amDeviceType  result        = OTHER_DEVICE;
+    unsigned int  nbWords       = words.size();
+    unsigned int  counter       = 0;
+    unsigned int  dataPage      = 0;
+    unsigned int  nbWordsSensor = 0;
+    amString      sensorID;
+    amString      semiCookedString;
+    amString      timeStampBuffer;
+    amString      inputString;
+    amSplitString sensorWords;
+
+    if ( nbWords > 13 )  // SENSOR(1) + TIME(1) + SEMICOOKED(1) + DATAPAGE(1) + UNSUPPORTED(1) + PALYLOD(8)
+    {
+        sensorID         = words[ counter++ ];                            //  0
+        timeStampBuffer  = words[ counter++ ];                            //  1
+        if ( diagnostics )
         {
-            appendOutput( descriptor1 );
-            appendOutput( descriptor2 );
-            appendOutput( requestedResponse );
-            appendOutput( requestedPage );
-            appendOutput( commandType );
+            appendDiagnosticsLine( "SensorID",   sensorID );
+            appendDiagnosticsLine( "Timestamp",  timeStampBuffer );
         }
-        else
+        if ( isRegisteredDevice( sensorID ) )
         {
-            appendOutput( "DESCRIPTOR_BYTE_1" );
-            if ( descriptor1 == 255 )
+            semiCookedString = words[ counter++ ];                        //  2
+            if ( semiCookedString == C_SEMI_COOKED_SYMBOL_AS_STRING )
             {
-                appendOutput( "NONE" );
+                if ( diagnostics )
+                {
+                    appendDiagnosticsLine( "SemiCooked", semiCookedString );
+                }
             }
             else
             {
-                appendOutput( descriptor1 );
-            }
-
-            appendOutput( "DESCRIPTOR_BYTE_2" );
-            if ( descriptor2 == 255 )
-            {
-                appendOutput( "NONE" );
+                --counter;
             }
-            else
+            dataPage = ( unsigned int ) words[ counter++ ].toInt();       //  2 or 3
+            if ( diagnostics )
             {
-                appendOutput( descriptor2 );
+                appendDiagnosticsLine( "Data Page", dataPage );
             }
 
-
-            if ( requestedResponse == 0 )
-            {
-                appendOutput( C_TRANSMIT_INVALID );
-            }
-            else if ( requestedResponse == 128 )
-            {
-                appendOutput( C_TRANSMIT_UNTIL_SUCCESS_ACKNOWLEDGED );
-            }
-            else
+            if ( words[ counter ] == C_UNSUPPORTED_DATA_PAGE )
             {
-                appendOutput( C_TRANSMIT_NB_TIMES );
-                appendOutput( ( unsigned int ) requestedResponse & 0x7F );
-                appendOutput( ( requestedResponse & 128 ) ? C_REPLY_ACKNOWLEDGE : C_NO_REPLY_ACKNOWLEDGE );
+                nbWordsSensor = sensorWords.split( sensorID, "_" );
+                if ( nbWordsSensor == 2 ) 
+                {   
+                    inputString  = C_UNKNOWN_TYPE_HEAD;
+                    inputString += amString( C_AUDIO_TYPE );
+                    inputString += "_";
+                    inputString += sensorWords[ 1 ];
+                    inputString += "\t";
+                    inputString += timeStampBuffer;
+                    while ( ++counter < nbWords )
+                    {   
+                        inputString += "\t";
+                        inputString += words[ counter ];
+                    }   
+                    result = updateSensorSemiCooked( inputString );
+                }
             }
-
-            appendOutput( C_REQUESTED_PAGE_NO );
-            appendOutput( requestedPage );
-            appendOutput( ( commandType == 1 ) ? C_DATA_PAGE : C_ANT_FS_SESSION );
         }
-    }
+    }   
     return result;
 }
 
 // -------------------------------------------------------------------------------------------------//
 //
-// Create the output for a common page (data page 0x50 or 80) and
-// append it to the output (result) string.
+// Output an unsupported data page with its payload.
 //
 // -------------------------------------------------------------------------------------------------//
-bool antProcessing::createCommonResultStringPage80
+bool antProcessing::outputUnsupportedPageRecord
 (
-    const amString &sensorID,
-    bool            outputPage,
-    unsigned int    manufacturerID,
-    unsigned int    hardwareRevision,
-    unsigned int    modelNumber
+    const antRecordContext &context,
+    unsigned int            dataPage,
+    const BYTE             *payLoad
 )
 {
-    bool result = true;
+    antUnsupportedPageRecord record = antUnsupportedPageRecord();
 
-    if ( outputPage )
+    if ( stageStats != NULL )
     {
-        int dataPage = 80;
-        if ( outputAsJSON )
-        {
-            appendJSONItem( C_DATA_PAGE_JSON, dataPage );
-        }
-        else
-        {
-            appendOutput( dataPage );
-        }
+        stageStats->count( STATS_UNKNOWN_PAGES );
     }
-
-    if ( outputAsJSON )
+    if ( diagnostics )
     {
-        appendJSONItem( C_MANUFACTURER_JSON,      manufacturerID );
-        appendJSONItem( C_HARDWARE_REVISION_JSON, hardwareRevision );
-        appendJSONItem( C_MODEL_NUMBER_JSON,      modelNumber );
+        appendDiagnosticsLine( "Unsupported Data Page Number", dataPage );
     }
-    else
+
+    record.dataPage = dataPage;
+    for ( int counter = 0; counter < C_ANT_PAYLOAD_LENGTH; ++counter )
     {
-        // Power Meters the page number is already identified by the device type (as PWRB50 - 50 = 0x80)
-        appendOutput( manufacturerID );
-        appendOutput( hardwareRevision );
-        appendOutput( modelNumber );
+        if ( diagnostics )
+        {
+            appendDiagnosticsLine( "byte", counter, payLoad[ counter ] );
+        }
+        record.payLoad[ counter ] = payLoad[ counter ];
     }
-    return result;
+
+    outputRecord( context, record );
+    return true;
 }
 
 // -------------------------------------------------------------------------------------------------//
 //
-// Create the output for a common page (data page 0x51 or 81) and
-// append it to the output (result) string.
+// For semi-cooked input, output an unsupported data page with its payload.
 //
 // -------------------------------------------------------------------------------------------------//
-bool antProcessing::createCommonResultStringPage81
+bool antProcessing::outputUnsupportedPageRecordSemiCooked
 (
-    const amString &sensorID,
-    bool            outputPage,
-    unsigned int    serialNumber,
-    unsigned int    softwareRevision
+    const antRecordContext &context,
+    unsigned int            dataPage,
+    const amSplitString    &words,
+    unsigned int            startCounter
 )
 {
-    bool result = true;
-
-    if ( outputPage )
-    {
-        int dataPage = 81;
-        if ( outputAsJSON )
-        {
-            appendJSONItem( C_DATA_PAGE_JSON, dataPage );
-        }
-        else
-        {
-            appendOutput( dataPage );
-        }
+    bool         result                          = true;
+    unsigned int wordsCounter                    = startCounter;
+    BYTE         payLoad[ C_ANT_PAYLOAD_LENGTH ] = { 0 };
+
+    for ( int counter = 0; ( counter < C_ANT_PAYLOAD_LENGTH ) && ( wordsCounter < words.size() ); ++counter, ++wordsCounter )
+    {
+        payLoad[ counter ] = words[ wordsCounter ].toInt();
     }
+    result = outputUnsupportedPageRecord( context, dataPage, payLoad );
+
+    return result;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Create the output for a bridge status message and append it to the output (result) string.
+//
+// -------------------------------------------------------------------------------------------------//
+void antProcessing::createBridgeString
+(
+    const amString &bridgeDeviceID,
+    const amString &timeStampBuffer,
+    const amString &bridgeName,
+    const amString &bridgeMACAddess,
+    const amString &firmwareVersion,
+    int             voltageValue,
+    int             powerIndicator,
+    int             operatingMode,
+    int             connectionStatus
+)
+{
+    double dVoltage = semiCookedOut ? 0 : ( ( double ) ( 500 + voltageValue ) ) / 1000.0;
+
+    createOutputHeader( bridgeDeviceID, timeStampBuffer );
 
     if ( outputAsJSON )
     {
-        // Power Meters the page number is already identified by the device type (as PWRB51 - 51 = 0x81)
-        if ( !semiCookedOut && ( int ( serialNumber ) == -1 ) )
+        appendJSONItem( "bridge name",      bridgeName );
+        appendJSONItem( "mac address",      bridgeMACAddess );
+        appendJSONItem( "firmware version", firmwareVersion );
+
+        if ( semiCookedOut )
         {
-            appendJSONItem( C_SERIAL_NUMBER_JSON, C_NONE_ID );
+            appendJSONItem( "voltage", voltageValue );
+            appendJSONItem( "power indicator", powerIndicator );
+            appendJSONItem( "operating mode", operatingMode );
+            appendJSONItem( "connection status", connectionStatus );
         }
         else
         {
-            appendJSONItem( C_SERIAL_NUMBER_JSON, serialNumber );
+            appendJSONItem( "voltage", dVoltage, 3 );
+            appendJSONItem( "power indicator", powerIndicator ? "E" : "I" );
+            appendJSONItem( "operating mode", operatingMode );
+            appendJSONItem( "connection status", connectionStatus ? "I" : "A" );
         }
-        appendJSONItem( C_SOFTWARE_REVISION_JSON, softwareRevision );
     }
     else
     {
-        // Power Meters the page number is already identified by the device type (as PWRB51 - 51 = 0x81)
-        if ( semiCookedOut || ( ( int ) serialNumber >= 0 ) )
+        appendOutput( bridgeName );
+        appendOutput( bridgeMACAddess );
+        appendOutput( firmwareVersion );
+        if ( semiCookedOut )
         {
-            appendOutput( serialNumber );
+            appendOutput( voltageValue );
         }
         else
         {
-            appendOutput( "NO_SERIAL_NUMBER" );
+            appendOutput( dVoltage, 3, "V" );
         }
-        appendOutput( softwareRevision );
+        appendOutput( powerIndicator ? "E" : "I" );
+        appendOutput( operatingMode );
+        appendOutput( connectionStatus ? "I" : "A" );
     }
-    return result;
+    appendOutputFooter( b2tVersion );
 }
 
 // -------------------------------------------------------------------------------------------------//
 //
-// Create the output for a common page (data page 0x52 or 82) and
-// append it to the output (result) string.
+// Sequence gap record of a bridge (option '-G'): totals since the start and the share of the
+// packets lost since the previous record and since the start (in %).
 //
 // -------------------------------------------------------------------------------------------------//
-bool antProcessing::createCommonResultStringPage82
+void antProcessing::createSequenceString
 (
-    const amString &sensorID,
-    bool            outputPage,
-    unsigned int    voltage256,
-    unsigned int    status,
-    unsigned int    deltaOperatingTime,
-    unsigned int    resolution,
-    unsigned int    nbBatteries,
-    unsigned int    batteryID
+    unsigned int    sourceNo,
+    const amString &timeStampBuffer
 )
 {
-    bool result = true;
+    antSequenceSource &source    = sequenceTracker[ sourceNo ];
+    double             nbPackets = ( double ) ( source.nbPackets - source.reportedPackets );
+    double             nbLost    = ( source.nbLost > source.reportedLost ) ? ( double ) ( source.nbLost - source.reportedLost ) : 0;
+    double             lossRate  = ( nbPackets + nbLost > 0 ) ? 100.0 * nbLost / ( nbPackets + nbLost ) : 0;
+    double             totalLoss = ( source.nbPackets + source.nbLost > 0 ) ? 100.0 * source.nbLost / ( source.nbPackets + source.nbLost ) : 0;
+    char               address   [ C_TINY_BUFFER_SIZE ];
+    char               macAddress[ C_TINY_BUFFER_SIZE ];
 
-    if ( outputPage )
+    strcpy( address, "-" );
+    if ( source.address != 0 )
     {
-        int dataPage = 82;
-        if ( outputAsJSON )
-        {
-            appendJSONItem( C_DATA_PAGE_JSON, dataPage );
-        }
-        else
-        {
-            appendOutput( dataPage );
-        }
+        sprintf( address, "%u.%u.%u.%u", source.address >> 24, ( source.address >> 16 ) & 0xFF, ( source.address >> 8 ) & 0xFF, source.address & 0xFF );
+    }
+    strcpy( macAddress, "-" );
+    if ( source.hasMACAddress )
+    {
+        sprintf( macAddress, "%02X:%02X:%02X:%02X:%02X:%02X", source.macAddress[ 0 ], source.macAddress[ 1 ], source.macAddress[ 2 ],
+                                                              source.macAddress[ 3 ], source.macAddress[ 4 ], source.macAddress[ 5 ] );
     }
+    source.reportedPackets = source.nbPackets;
+    source.reportedLost    = source.nbLost;
 
-    if ( semiCookedOut )
+    createOutputHeader( C_SEQUENCE_MESSAGE_ID + sequenceTracker.getSourceID( sourceNo ), timeStampBuffer );
+
+    if ( outputAsJSON )
     {
-        if ( outputAsJSON )
-        {
-            appendJSONItem( "voltage256",           voltage256 );
-            appendJSONItem( "battery status index", status );
-            appendJSONItem( "operating time",       deltaOperatingTime );
-            appendJSONItem( "resolution",           resolution );
-            appendJSONItem( "number of batteries",  nbBatteries );
-            appendJSONItem( "battery no.",          batteryID );
-        }
-        else
-        {
-            appendOutput( voltage256 );
-            appendOutput( status );
-            appendOutput( deltaOperatingTime );
-            appendOutput( resolution );
-            appendOutput( nbBatteries );
-            appendOutput( batteryID );
-        }
+        appendJSONItem( "sender address",  address );
+        appendJSONItem( "mac address",     macAddress );
+        appendJSONItem( "packets",         ( double ) source.nbPackets, 0 );
+        appendJSONItem( "lost packets",    ( double ) source.nbLost, 0 );
+        appendJSONItem( "gaps",            ( double ) source.nbGaps, 0 );
+        appendJSONItem( "reordered",       ( double ) source.nbReordered, 0 );
+        appendJSONItem( "duplicates",      ( double ) source.nbDuplicates, 0 );
+        appendJSONItem( "loss rate",       lossRate, 3 );
+        appendJSONItem( "total loss rate", totalLoss, 3 );
     }
     else
     {
-        amString batteryStatus;
-        double   voltageDbl         = ( double ) voltage256 / 256.0;
-        double   totalOperatingTime = getTotalOperationTime( sensorID );
-        double   auxDouble          = ( double ) deltaOperatingTime;
-
-        auxDouble          *= ( double ) resolution;
-        totalOperatingTime += auxDouble;
-        setTotalOperationTime( sensorID, totalOperatingTime );
-
-        getBatteryStatus( batteryStatus, status, outputAsJSON );
+        appendOutput( address );
+        appendOutput( macAddress );
+        appendOutput( ( double ) source.nbPackets, 0 );
+        appendOutput( ( double ) source.nbLost, 0 );
+        appendOutput( ( double ) source.nbGaps, 0 );
+        appendOutput( ( double ) source.nbReordered, 0 );
+        appendOutput( ( double ) source.nbDuplicates, 0 );
+        appendOutput( lossRate, 3, "%" );
+        appendOutput( totalLoss, 3, "%" );
+    }
+    appendOutputFooter( b2tVersion );
+}
 
+// -------------------------------------------------------------------------------------------------//
+//
+// Create the output for a message in packet saver mode (which includes the hexadecimal values
+// of all bytes) and append it to the output (result) string.
+//
+// -------------------------------------------------------------------------------------------------//
+void antProcessing::createPacketSaverString
+(
+    const BYTE     *line,
+    int             nbBytes,
+    const amString &timeStampBuffer
+)
+{
+    createOutputHeader( C_PACKET_SAVER_NAME, timeStampBuffer );
+    for ( int counter = 0; counter < nbBytes; ++counter )
+    {
+        if ( diagnostics )
+        {
+            appendDiagnosticsLine( "byte", counter, line[ counter ] );
+        }
         if ( outputAsJSON )
         {
-            if ( nbBatteries == 0 )
-            {
-                appendJSONItem( "number of batteries", C_N_A_JSON );
-                appendJSONItem( "battery no.",         C_N_A_JSON );
-            }
-            else
-            {
-                appendJSONItem( "number of batteries", nbBatteries );
-                appendJSONItem( "battery no.",         batteryID );
-            }
-            appendJSONItem( "voltage",              voltageDbl, 2 );
-            appendJSONItem( "battery status",       batteryStatus );
-            appendJSONItem( "total operating time", totalOperatingTime, timePrecision );
+            std::stringstream auxStream;
+            auxStream << "byte[ " << counter << " ]";
+            appendJSONItem( auxStream.str(), line[ counter ] );
         }
         else
         {
-            unsigned int localNbBatteries = ( nbBatteries == 0 ) ? 1 : nbBatteries;
-            appendOutput( localNbBatteries );
-            appendOutput( batteryID );
-            appendOutput( voltageDbl, 2 );
-            appendOutput( batteryStatus );
-            appendOutput( totalOperatingTime, timePrecision );
+            appendOutput( line[ counter ] );
         }
     }
-    return result;
+    appendOutputFooter( b2tVersion );
 }
 
 // -------------------------------------------------------------------------------------------------//
 //
-// Create the output for a common page (data page 0x53 or 83) and
-// append it to the output (result) string.
+// Create the output for an unrecognized message (which includes the hexadecimal values
+// of all bytes) and append it to the output (result) string.
 //
 // -------------------------------------------------------------------------------------------------//
-bool antProcessing::createCommonResultStringPage83
+void antProcessing::createUnknownPacketString
 (
-    const amString &sensorID,
-    bool            outputPage,
-    unsigned int    seconds,
-    unsigned int    minutes,
-    unsigned int    hours,
-    unsigned int    weekDayNo,
-    unsigned int    monthDay,
-    unsigned int    month,
-    unsigned int    year
+    const BYTE     *line,
+    int             nbBytes,
+    const amString &timeStampBuffer
 )
 {
-    bool     result = true;
-    amString timeString;
-    amString dateString;
-    amString wDayString;
-
-    if ( outputPage )
+    createOutputHeader( C_UNKOWN_PACKET_NAME, timeStampBuffer );
+    for ( int counter = 0; counter < nbBytes; ++counter )
     {
-        int dataPage = 83;
+        if ( diagnostics )
+        {
+            appendDiagnosticsLine( "byte", counter, line[ counter ] );
+        }
         if ( outputAsJSON )
         {
-            appendJSONItem( C_DATA_PAGE_JSON, dataPage );
+            std::stringstream auxStream;
+            auxStream << "byte[ " << counter << " ]";
+            appendJSONItem( auxStream.str(), line[ counter ] );
         }
         else
         {
-            appendOutput( dataPage );
+            appendOutput( line[ counter ] );
         }
     }
+    appendOutputFooter( b2tVersion );
+}
 
-    if ( !semiCookedOut )
+// -------------------------------------------------------------------------------------------------//
+//
+// Output the result string, the 'raw data' output string, and/or the dignostics string.
+// Depending on the settings, output the string(s) on stdout and/or the multicast port.
+//
+// -------------------------------------------------------------------------------------------------//
+int antProcessing::outputData
+(
+    void
+)
+{
+    if ( binaryOut )
     {
-        int year2000 = year + 2000;
-        dateString = date2String( year2000, month, monthDay );
-        timeString = time2String( hours, minutes, seconds );
-        switch( weekDayNo )
-        {
-            case  0: wDayString = "SUN";
-                     break;
-            case  1: wDayString = "MON";
-                     break;
-            case  2: wDayString = "TUE";
-                     break;
-            case  3: wDayString = "WED";
-                     break;
-            case  4: wDayString = "THU";
-                     break;
-            case  5: wDayString = "FRI";
-                     break;
-            case  6: wDayString = "SAT";
-                     break;
-            default: wDayString = C_UNKNOWN;
-                     break;
-        }
-        wDayString.toLower();
+        return outputBinaryData();
     }
 
-    if ( outputAsJSON )
+    if ( outputRaw && ( rawBuffer.size() > 0 ) )
     {
-        if ( semiCookedOut )
-        {
-            appendJSONItem( "year", year );
-            appendJSONItem( "month", month );
-            appendJSONItem( "monthDay", monthDay );
-            appendJSONItem( "week day", weekDayNo );
-            appendJSONItem( "hours", hours );
-            appendJSONItem( "minutes", minutes );
-            appendJSONItem( "seconds", seconds );
-        }
-        else
-        {
-            appendJSONItem( "date", dateString );
-            appendJSONItem( "time", timeString );
-            appendJSONItem( "week day", wDayString );
-        }
+        errorCode = writeOutput( rawBuffer, false, errorCode, errorMessage );
+        rawBuffer.clear();
     }
-    else
+    if ( ( errorCode == 0 ) && diagnostics && ( diagnosticsBuffer.size() > 0 ) )
     {
-        if ( semiCookedOut )
-        {
-            appendOutput( seconds );
-            appendOutput( minutes );
-            appendOutput( hours );
-            appendOutput( weekDayNo );
-            appendOutput( monthDay );
-            appendOutput( month );
-            appendOutput( year );
-        }
-        else
-        {
-            appendOutput( "DATE" );
-            appendOutput( dateString );
-            appendOutput( "WEEK_DAY" );
-            appendOutput( wDayString );
-            appendOutput( "TIME" );
-            appendOutput( timeString );
-        }
+        errorCode = writeOutput( diagnosticsBuffer, false, errorCode, errorMessage );
     }
-    return result;
+    if ( ( errorCode == 0 ) && !outputRaw && ( outBuffer.size() > 0 ) )
+    {
+        errorCode = writeOutput( outBuffer, true, errorCode, errorMessage );
+    }
+
+    if ( errorCode == E_EMPTY_MESSAGE )
+    {
+        errorCode = 0;
+    }
+
+    return errorCode;
 }
 
 // -------------------------------------------------------------------------------------------------//
 //
-// Create the output for a common page (data page 0x54 or 84) and
-// append it to the output (result) string.
+// Binary output (-E): the records written by binaryFormatter, followed by the text output in text
+// blocks, all in a single write.
 //
 // -------------------------------------------------------------------------------------------------//
-bool antProcessing::createCommonResultStringPage84
+int antProcessing::outputBinaryData
 (
-    const amString &sensorID,
-    bool            outputPage,
-    unsigned int    subPage1,
-    unsigned int    subPage2,
-    unsigned int    dataField1,
-    unsigned int    dataField2
+    void
 )
 {
-    bool result = true;
+    if ( outputRaw && ( rawBuffer.size() > 0 ) )
+    {
+        binaryFormatter.appendText( rawBuffer );
+        rawBuffer.clear();
+    }
+    if ( diagnostics && ( diagnosticsBuffer.size() > 0 ) )
+    {
+        binaryFormatter.appendText( diagnosticsBuffer );
+    }
+    if ( !outputRaw && ( outBuffer.size() > 0 ) )
+    {
+        binaryFormatter.appendText( outBuffer );
+    }
+    if ( binaryBuffer.size() > 0 )
+    {
+        errorCode = writeOutput( binaryBuffer, false, errorCode, errorMessage );
+        binaryBuffer.clear();
+    }
 
-    if ( outputPage )
+    if ( errorCode == E_EMPTY_MESSAGE )
     {
-        int dataPage = 84;
-        if ( outputAsJSON )
-        {
-            appendJSONItem( C_DATA_PAGE_JSON, dataPage );
-        }
-        else
-        {
-            appendOutput( dataPage );
-        }
+        errorCode = 0;
     }
 
-    if ( outputAsJSON )
+    return errorCode;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Output a string on stdout and/or the multicast port. Records ('asRecord') may be coalesced with
+// other records into a single datagram. A decode thread keeps the strings in capturedOutput
+// instead, they are output in the order of the input by writeDecodedOutput().
+// Returns the result of the multicast write, or 'resultCode' if nothing was sent.
+//
+// -------------------------------------------------------------------------------------------------//
+int antProcessing::writeOutput
+(
+    const amString &text,
+    bool            asRecord,
+    int             resultCode,
+    amString       &message
+)
+{
+    if ( capturedOutput != NULL )
     {
-        if ( semiCookedOut )
-        {
-            appendJSONItem( "sub page 1",   subPage1 );
-            appendJSONItem( "data field 1", dataField1 );
-            appendJSONItem( "sub page 2",   subPage1 );
-            appendJSONItem( "data field 2", dataField1 );
-        }
-        else
-        {
-            createDataPage84SubPage( sensorID, 1, subPage1, dataField1 );
-            createDataPage84SubPage( sensorID, 2, subPage2, dataField2 );
-        }
+        // Kind, length and text of each piece (the text may hold any byte, e.g. in diagnostics).
+        size_t length = text.size();
+        capturedOutput->push_back( asRecord ? C_CAPTURED_RECORD : C_CAPTURED_TEXT );
+        capturedOutput->append( ( const char * ) &length, sizeof( length ) );
+        capturedOutput->append( text );
     }
     else
     {
-        if ( semiCookedOut )
+        if ( multicastWrite.isUp() )
         {
-            appendOutput( subPage1 );
-            appendOutput( dataField1 );
-            appendOutput( subPage2 );
-            appendOutput( dataField2 );
+            if ( asRecord )
+            {
+                resultCode = multicastWrite.writeLine( text, resultCode, message );
+            }
+            else
+            {
+                resultCode = multicastWrite.write( text, resultCode, message );
+            }
         }
-        else
+        if ( writeStdout )
         {
-            createDataPage84SubPage( sensorID, 1, subPage1, dataField1 );
-            createDataPage84SubPage( sensorID, 2, subPage2, dataField2 );
+            if ( binaryOut )
+            {
+                outputWriter.write( text );
+            }
+            else
+            {
+                outputWriter.writeLine( text );
+            }
         }
     }
-    return result;
+    return resultCode;
 }
 
 // -------------------------------------------------------------------------------------------------//
 //
-// Create the output for a sub page of common page 0x54 or 84 and
-// append it to the output (result) string.
+// Read (and process) the input data from a stream.
 //
 // -------------------------------------------------------------------------------------------------//
-void antProcessing::createDataPage84SubPage
+int antProcessing::readAntFromStream
 (
-    const amString &sensorID,
-    unsigned int    subPageNo,
-    unsigned int    subPage,
-    unsigned int    dataField
+    std::istream &inStream
 )
 {
-    int      tempAsInt10 = 0;
-    int      precision   = 3;
-    double   dblValue    = 0;
-    amString auxString;
+    struct pollfd stdinPoll;
+    bool          isStdin = ( &inStream == &std::cin );
+
+    stdinPoll.fd     = STDIN_FILENO;
+    stdinPoll.events = POLLIN;
 
-    switch ( subPage )
+    while ( errorCode == 0 )
     {
-        case  1: // Temperature
-                 tempAsInt10 = NEGATE_BINARY_INT( dataField, 16 );
-                 dblValue = ( double ) tempAsInt10 / 100.0;
-                 if ( outputAsJSON )
-                 {
-                     appendJSONItem( "temperature value", dblValue, 3 );
-                     appendJSONItem( "temperature unit", "celsius" );
-                 }
-                 else
-                 {
-                     appendOutput( "TEMP" );
-                     appendOutput( dblValue, 3, "C" );
-                 }
-                 break;
-        case  2: // Barometric Pressure
-                 dblValue = ( double ) dataField / 100.0;
-                 if ( outputAsJSON )
-                 {
-                     appendJSONItem( "barometric pressure value", dblValue, precision );
-                     appendJSONItem( "barometric pressure unit", "pascal" );
-                 }
-                 else
-                 {
-                     appendOutput( "PRESSURE" );
-                     appendOutput( dblValue, 3 );
-                 }
-                 break;
-        case  3: // Humidity
-                 dblValue = ( double ) dataField / 100.0;
-                 if ( outputAsJSON )
-                 {
-                     appendJSONItem( "humidity value", dblValue, precision );
-                     appendJSONItem( "humidity unit", "percent" );
-                 }
-                 else
-                 {
-                     appendOutput( "HUMIDITY" );
-                     appendOutput( dblValue, 3, "\%" );
-                 }
-                 break;
-        case  4: // Wind Speed
-                 dblValue = ( double ) dataField / 100.0;  // 0.01 km/h
-                 if ( outputAsJSON )
-                 {
-                     appendJSONItem( "wind speed value", dblValue, precision );
-                     appendJSONItem( "wind speed unit", "km/h" );
-                 }
-                 else
-                 {
-                     appendOutput( "WIND_SPEED" );
-                     appendOutput( dblValue, 3 );
-                 }
-                 break;
-        case  5: // Wind Direction
-                 dblValue = ( double ) dataField / 200.0;   // 0.005 Degrees
-                 if ( outputAsJSON )
-                 {
-                     appendJSONItem( "wind direction value", dblValue, precision );
-                     appendJSONItem( "wind direction unit", "degrees" );
-                 }
-                 else
-                 {
-                     appendOutput( "WIND_DIR" );
-                     appendOutput( dblValue, 3 );
-                 }
-                 break;
-        default: // Undefined
-                 if ( outputAsJSON )
-                 {
-                     auxString = "sub page ";
-                     auxString += amString( subPageNo );
-                     appendJSONItem( auxString, C_UNKNOWN_JSON );
-                 }
-                 else
-                 {
-                     appendOutput( "UNKNOWN"  );
-                 }
-                 break;
-    }
-}
-
-amDeviceType antProcessing::processUnsupportedDataPage
-(
-    const amSplitString words
-)
-{
-    amDeviceType  result        = OTHER_DEVICE;
-    unsigned int  nbWords       = words.size();
-    unsigned int  counter       = 0;
-    unsigned int  dataPage      = 0;
-    unsigned int  nbWordsSensor = 0;
-    amString      sensorID;
-    amString      semiCookedString;
-    amString      timeStampBuffer;
-    amString      inputString;
-    amSplitString sensorWords;
-
-    if ( nbWords > 13 )  // SENSOR(1) + TIME(1) + SEMICOOKED(1) + DATAPAGE(1) + UNSUPPORTED(1) + PALYLOD(8)
-    {
-        sensorID         = words[ counter++ ];                            //  0
-        timeStampBuffer  = words[ counter++ ];                            //  1
-        if ( diagnostics )
+        resetOutBuffer();
+        resetDiagnosticsBuffer();
+        if ( semiCookedIn )
         {
-            appendDiagnosticsLine( "SensorID",   sensorID );
-            appendDiagnosticsLine( "Timestamp",  timeStampBuffer );
+            errorCode = readSemiCookedSingleLineFromStream( inStream );
         }
-        if ( isRegisteredDevice( sensorID ) )
+        else
         {
-            semiCookedString = words[ counter++ ];                        //  2
-            if ( semiCookedString == C_SEMI_COOKED_SYMBOL_AS_STRING )
-            {
-                if ( diagnostics )
-                {
-                    appendDiagnosticsLine( "SemiCooked", semiCookedString );
-                }
-            }
-            else
-            {
-                --counter;
-            }
-            dataPage = ( unsigned int ) words[ counter++ ].toInt();       //  2 or 3
-            if ( diagnostics )
+            resetRawBuffer();
+            errorCode = readAntSingleLineFromStream( inStream );
+        }
+
+        // Live input on stdin: do not keep output back while waiting for the next line.
+        if ( isStdin && ( inStream.rdbuf()->in_avail() <= 0 ) && ( poll( &stdinPoll, 1, 0 ) == 0 ) )
+        {
+            if ( pipeline != NULL )
             {
-                appendDiagnosticsLine( "Data Page", dataPage );
+                pipeline->idle( true );
             }
-
-            if ( words[ counter ] == C_UNSUPPORTED_DATA_PAGE )
+            else if ( errorCode == 0 )
             {
-                nbWordsSensor = sensorWords.split( sensorID, "_" );
-                if ( nbWordsSensor == 2 ) 
-                {   
-                    inputString  = C_UNKNOWN_TYPE_HEAD;
-                    inputString += amString( C_AUDIO_TYPE );
-                    inputString += "_";
-                    inputString += sensorWords[ 1 ];
-                    inputString += "\t";
-                    inputString += timeStampBuffer;
-                    while ( ++counter < nbWords )
-                    {   
-                        inputString += "\t";
-                        inputString += words[ counter ];
-                    }   
-                    result = updateSensorSemiCooked( inputString );
-                }
+                errorCode = flushIdleOutput( true, errorMessage );
             }
         }
-    }   
-    return result;
+    }
+    return errorCode;
 }
 
 // -------------------------------------------------------------------------------------------------//
 //
-// Create the output for an unsupported data page and append it to the output (result) string.
+// Read (and process) a single input line from a stream.
 //
 // -------------------------------------------------------------------------------------------------//
-bool antProcessing::createCommonResultStringUnsupportedPage
+int antProcessing::readSemiCookedSingleLineFromStream
 (
-    const amString &sensorID,
-    unsigned int    dataPage,
-    const BYTE     *payLoad
+    std::istream &inStream
 )
 {
-    bool result = true;
+    char      line[ C_BUFFER_SIZE ];
+    long long readStart = ( stageStats != NULL ) ? antStageStats::now() : 0;
 
-    if ( diagnostics )
-    {
-        appendDiagnosticsLine( "Unsupported Data Page Number", dataPage );
-    }
-    if ( outputAsJSON )
+    inStream.getline( line, C_BUFFER_SIZE );
+    if ( stageStats != NULL )
     {
-        appendJSONItem( C_UNSUPPORTED_DATA_PAGE_JSON, dataPage );
+        stageStats->addTimeSince( STAGE_READ, readStart );
     }
-    else
+    if ( strlen( line ) > 0 )
     {
-        appendOutput( dataPage );
-        appendOutput( C_UNSUPPORTED_DATA_PAGE );
+        errorCode = processSemiCookedLine( line );
     }
 
-    for ( int counter = 0; counter < C_ANT_PAYLOAD_LENGTH; ++counter )
+    if ( inStream.eof() || inStream.fail() )
     {
-        if ( diagnostics )
-        {
-            appendDiagnosticsLine( "byte", counter, payLoad[ counter ] );
-        }
-        if ( outputAsJSON )
-        {
-            appendJSONItem( "byte", counter, payLoad[ counter ] );
-        }
-        else
-        {
-            appendOutput( payLoad[ counter ] );
-        }
+        errorCode = E_END_OF_FILE;
     }
 
-    return result;
+    return errorCode;
 }
 
 // -------------------------------------------------------------------------------------------------//
 //
-// For semi-cooked input, create the output for an unsupported data page
-// and append it to the output (result) string.
+// Process a single semi-cooked input line and output the result.
 //
 // -------------------------------------------------------------------------------------------------//
-bool antProcessing::createCommonResultStringUnsupportedPageSemiCooked
+int antProcessing::processSemiCookedLine
 (
-    const amString      &sensorID,
-    unsigned int         dataPage,
-    const amSplitString &words,
-    unsigned int         startCounter
+    const char *line
 )
 {
-    bool         result                          = true;
-    unsigned int wordsCounter                    = startCounter;
-    BYTE         payLoad[ C_ANT_PAYLOAD_LENGTH ] = { 0 };
+    bool      resultDevice = false;
+    long long lineTime     = 0;
 
-    for ( int counter = 0; ( counter < C_ANT_PAYLOAD_LENGTH ) && ( wordsCounter < words.size() ); ++counter, ++wordsCounter )
+    // Like binary packets, sensors age by the time stamps of the input, not by the time of processing.
+    if ( stateCheckpoint.isRunning() || ( sensorIdleSeconds > 0 ) || ( maxSensors > 0 ) )
     {
-        payLoad[ counter ] = words[ wordsCounter ].toInt();
+        lineTime = getSemiCookedTime( line );
     }
-    result = createCommonResultStringUnsupportedPage( sensorID, dataPage, payLoad );
 
-    return result;
-}
+    if ( stateCheckpoint.isRunning() )
+    {
+        checkpointSensorStates( lineTime );
+    }
 
-// -------------------------------------------------------------------------------------------------//
-//
-// Create the output for a bridge status message and append it to the output (result) string.
-//
-// -------------------------------------------------------------------------------------------------//
-void antProcessing::createBridgeString
-(
-    const amString &bridgeDeviceID,
-    const amString &timeStampBuffer,
-    const amString &bridgeName,
-    const amString &bridgeMACAddess,
-    const amString &firmwareVersion,
-    int             voltageValue,
-    int             powerIndicator,
-    int             operatingMode,
-    int             connectionStatus
-)
-{
-    double dVoltage = semiCookedOut ? 0 : ( ( double ) ( 500 + voltageValue ) ) / 1000.0;
+    if ( pipeline != NULL )
+    {
+        return pipeline->dispatchSemiCookedLine( line );
+    }
 
-    createOutputHeader( bridgeDeviceID, timeStampBuffer );
+    if ( perfCounters != NULL )
+    {
+        perfCounters->begin();
+    }
+    if ( stageStats != NULL )
+    {
+        stageStats->beginPacket();
+    }
 
-    if ( outputAsJSON )
+    if ( deviceFileSource != NULL )
     {
-        appendJSONItem( "bridge name",      bridgeName );
-        appendJSONItem( "mac address",      bridgeMACAddess );
-        appendJSONItem( "firmware version", firmwareVersion );
+        reloadDeviceFile();
+    }
 
-        if ( semiCookedOut )
-        {
-            appendJSONItem( "voltage", voltageValue );
-            appendJSONItem( "power indicator", powerIndicator );
-            appendJSONItem( "operating mode", operatingMode );
-            appendJSONItem( "connection status", connectionStatus );
-        }
-        else
-        {
-            appendJSONItem( "voltage", dVoltage, 3 );
-            appendJSONItem( "power indicator", powerIndicator ? "E" : "I" );
-            appendJSONItem( "operating mode", operatingMode );
-            appendJSONItem( "connection status", connectionStatus ? "I" : "A" );
-        }
+    if ( ( sensorIdleSeconds > 0 ) || ( maxSensors > 0 ) )
+    {
+        evictSensors( lineTime );
+    }
+
+    if ( stageStats != NULL )
+    {
+        stageStats->beginStage();
+    }
+    if ( semiCookedOut )
+    {
+        resultDevice = updateSensorSemiCooked( line );
     }
     else
     {
-        appendOutput( bridgeName );
-        appendOutput( bridgeMACAddess );
-        appendOutput( firmwareVersion );
-        if ( semiCookedOut )
-        {
-            appendOutput( voltageValue );
-        }
-        else
-        {
-            appendOutput( dVoltage, 3, "V" );
-        }
-        appendOutput( powerIndicator ? "E" : "I" );
-        appendOutput( operatingMode );
-        appendOutput( connectionStatus ? "I" : "A" );
+        resultDevice = processSensorSemiCooked( line );
     }
-    appendOutputFooter( b2tVersion );
+    if ( stageStats != NULL )
+    {
+        stageStats->endStage( STAGE_DECODE );
+        stageStats->beginStage();
+    }
+    errorCode = outputData();
+    if ( stageStats != NULL )
+    {
+        stageStats->endStage( STAGE_OUTPUT );
+        stageStats->endPacket();
+    }
+    if ( perfCounters != NULL )
+    {
+        perfCounters->end( C_PERF_NO_DEVICE_TYPE );
+    }
+    return errorCode;
 }
 
 // -------------------------------------------------------------------------------------------------//
 //
-// Create the output for a message in packet saver mode (which includes the hexadecimal values
-// of all bytes) and append it to the output (result) string.
+// Process the semi-cooked records of a datagram. A datagram may hold several records, one per line.
+// 'datagram' must have room for a terminating '\0' after 'nbBytes' bytes.
 //
 // -------------------------------------------------------------------------------------------------//
-void antProcessing::createPacketSaverString
+int antProcessing::processSemiCookedDatagram
 (
-    const BYTE     *line,
-    int             nbBytes,
-    const amString &timeStampBuffer
+    char   *datagram,
+    size_t  nbBytes
 )
 {
-    createOutputHeader( C_PACKET_SAVER_NAME, timeStampBuffer );
-    for ( int counter = 0; counter < nbBytes; ++counter )
+    char *line    = datagram;
+    char *end     = datagram + nbBytes;
+    char *lineEnd = NULL;
+
+    *end = '\0';
+    while ( ( errorCode == 0 ) && ( line < end ) )
     {
-        if ( diagnostics )
-        {
-            appendDiagnosticsLine( "byte", counter, line[ counter ] );
-        }
-        if ( outputAsJSON )
+        lineEnd = ( char * ) memchr( line, '\n', end - line );
+        if ( lineEnd == NULL )
         {
-            std::stringstream auxStream;
-            auxStream << "byte[ " << counter << " ]";
-            appendJSONItem( auxStream.str(), line[ counter ] );
+            lineEnd = end;
         }
-        else
+        *lineEnd = '\0';
+        if ( lineEnd > line )
         {
-            appendOutput( line[ counter ] );
+            resetOutBuffer();
+            resetDiagnosticsBuffer();
+            errorCode = processSemiCookedLine( line );
         }
+        line = lineEnd + 1;
     }
-    appendOutputFooter( b2tVersion );
+    return errorCode;
 }
 
+
 // -------------------------------------------------------------------------------------------------//
 //
-// Create the output for an unrecognized message (which includes the hexadecimal values
-// of all bytes) and append it to the output (result) string.
+// Read (and process) binary ANT+ data from a stream.
 //
 // -------------------------------------------------------------------------------------------------//
-void antProcessing::createUnknownPacketString
+int antProcessing::readAntSingleLineFromStream
 (
-    const BYTE     *line,
-    int             nbBytes,
-    const amString &timeStampBuffer
+    std::istream &inStream
 )
 {
-    createOutputHeader( C_UNKOWN_PACKET_NAME, timeStampBuffer );
-    for ( int counter = 0; counter < nbBytes; ++counter )
+    int       nbBytes   = 0;
+    BYTE      byte      = 0;
+    long long readStart = ( stageStats != NULL ) ? antStageStats::now() : 0;
+    BYTE      line[ C_BUFFER_SIZE ];
+
+    while ( errorCode == 0 )
     {
-        if ( diagnostics )
-        {
-            appendDiagnosticsLine( "byte", counter, line[ counter ] );
-        }
-        if ( outputAsJSON )
+        byte = inStream.get();
+        if ( inStream.eof() || inStream.fail() )
         {
-            std::stringstream auxStream;
-            auxStream << "byte[ " << counter << " ]";
-            appendJSONItem( auxStream.str(), line[ counter ] );
-        }
-        else
-        {
-            appendOutput( line[ counter ] );
+            if ( stageStats != NULL )
+            {
+                stageStats->addTimeSince( STAGE_READ, readStart );
+            }
+            errorCode = ant2txtLine( line, nbBytes );
+            if ( errorCode == 0 )
+            {
+                errorCode = E_END_OF_FILE;
+            }
+            break;
         }
-    }
-    appendOutputFooter( b2tVersion );
-}
 
-// -------------------------------------------------------------------------------------------------//
-//
-// Output the result string, the 'raw data' output string, and/or the dignostics string.
-// Depending on the settings, output the string(s) on stdout and/or the multicast port.
-//
-// -------------------------------------------------------------------------------------------------//
-int antProcessing::outputData
-(
-    void
-)
-{
-    if ( outputRaw && ( rawBuffer.size() > 0 ) )
-    {
-        if ( multicastWrite.isUp() )
-        {
-            errorCode = multicastWrite.write( rawBuffer, errorCode, errorMessage );
-        }
-        if ( writeStdout )
-        {
-            std::cout << rawBuffer << std::endl;
-        }
-        rawBuffer.clear();
-    }
-    if ( ( errorCode == 0 ) && diagnostics && ( diagnosticsBuffer.size() > 0 ) )
-    {
-        if ( multicastWrite.isUp() )
-        {
-            errorCode = multicastWrite.write( diagnosticsBuffer, errorCode, errorMessage );
-        }
-        if ( writeStdout )
+        line[ nbBytes ] = byte;
+        ++nbBytes;
+        if ( nbBytes == 1 )
         {
-            std::cout << diagnosticsBuffer << std::endl;
+            if ( ( unsigned int ) line[ 0 ] != ( unsigned int ) 'A' )
+            {
+                if ( outputRaw || diagnostics )
+                {
+                    rawBuffer += amString( line[ 0 ] );
+                }
+                nbBytes = 0;
+            }
         }
-    }
-    if ( ( errorCode == 0 ) && !outputRaw && ( outBuffer.size() > 0 ) )
-    {
-        if ( multicastWrite.isUp() )
+        else if ( nbBytes == 2 )
         {
-            errorCode = multicastWrite.write( outBuffer, errorCode, errorMessage );
-            if ( errorCode == 0 )
+            if ( ( unsigned int ) line[ 1 ] != ( unsigned int ) 'N' )
             {
-                errorCode = multicastWrite.write( "\n", errorCode, errorMessage );
+                if ( outputRaw || diagnostics )
+                {
+                    rawBuffer += amString( line[ 0 ] );
+                    rawBuffer += " ";
+                    rawBuffer += amString( line[ 1 ] );
+                }
+                nbBytes = 0;
             }
         }
-        if ( writeStdout )
+        else if ( ( ( unsigned int ) line[ nbBytes - 1 ] == ( unsigned int ) 'N' ) &&
+                  ( ( unsigned int ) line[ nbBytes - 2 ] == ( unsigned int ) 'A' ) )
         {
-            std::cout << outBuffer << std::endl;
-        }
-    }
+            // Put 'A' and 'N' back into the stream (they belong to the next message).
+            inStream.putback( line[ nbBytes - 1 ] );
+            inStream.putback( line[ nbBytes - 2 ] );
+            nbBytes -= 2;
 
-    if ( errorCode == E_EMPTY_MESSAGE )
-    {
-        errorCode = 0;
+            if ( stageStats != NULL )
+            {
+                stageStats->addTimeSince( STAGE_READ, readStart );
+            }
+            errorCode = ant2txtLine( line, nbBytes );
+            break;
+        }
     }
 
     return errorCode;
@@ -3055,131 +3219,154 @@ int antProcessing::outputData
 
 // -------------------------------------------------------------------------------------------------//
 //
-// Read (and process) the input data from a stream.
+// Read (and process) binary ANT+ data held in memory (e.g. a memory mapped file).
+// Frames are split exactly like readAntSingleLineFromStream() does it, but the 'A','N' headers are
+// located with memchr() and ant2txtLine() is handed a pointer into the buffer instead of a copy.
 //
 // -------------------------------------------------------------------------------------------------//
-int antProcessing::readAntFromStream
+int antProcessing::readAntFromBuffer
 (
-    std::istream &inStream
+    const BYTE *buffer,
+    size_t      bufferSize
 )
 {
+    const BYTE *candidate  = NULL;
+    size_t      position   = 0;
+    size_t      frameStart    = 0;
+    size_t      frameEnd      = 0;
+    size_t      previousStart = 0;
+    size_t      searchFrom = 0;
+    bool        endOfFile  = false;
+    BYTE        line[ C_BUFFER_SIZE ];
+
     while ( errorCode == 0 )
     {
         resetOutBuffer();
         resetDiagnosticsBuffer();
-        if ( semiCookedIn )
+        resetRawBuffer();
+
+        // Skip everything up to the next 'A','N' header. An 'A' which is not followed by an 'N'
+        // is dropped together with the byte that follows it.
+        endOfFile = true;
+        while ( position < bufferSize )
         {
-            errorCode = readSemiCookedSingleLineFromStream( inStream );
+            candidate = ( const BYTE * ) memchr( buffer + position, 'A', bufferSize - position );
+            if ( candidate == NULL )
+            {
+                position = bufferSize;
+                break;
+            }
+            position = candidate - buffer;
+            if ( position + 1 >= bufferSize )
+            {
+                break;
+            }
+            if ( buffer[ position + 1 ] == 'N' )
+            {
+                endOfFile = false;
+                break;
+            }
+            position += 2;
         }
-        else
+
+        // The frame ends where the next 'A','N' header starts.
+        frameStart = position;
+        frameEnd   = bufferSize;
+        if ( !endOfFile )
         {
-            resetRawBuffer();
-            errorCode = readAntSingleLineFromStream( inStream );
+            searchFrom = frameStart + 2;
+            endOfFile  = true;
+            while ( searchFrom < bufferSize )
+            {
+                candidate = ( const BYTE * ) memchr( buffer + searchFrom, 'A', bufferSize - searchFrom );
+                if ( candidate == NULL )
+                {
+                    break;
+                }
+                searchFrom = candidate - buffer;
+                if ( ( searchFrom + 1 < bufferSize ) && ( buffer[ searchFrom + 1 ] == 'N' ) )
+                {
+                    frameEnd  = searchFrom;
+                    endOfFile = false;
+                    break;
+                }
+                ++searchFrom;
+            }
         }
-    }
-    return errorCode;
-}
-
-// -------------------------------------------------------------------------------------------------//
-//
-// Read (and process) a single input line from a stream.
-//
-// -------------------------------------------------------------------------------------------------//
-int antProcessing::readSemiCookedSingleLineFromStream
-(
-    std::istream &inStream
-)
-{
-    char line[ C_BUFFER_SIZE ];
+        position = frameEnd;
 
-    inStream.getline( line, C_BUFFER_SIZE );
-    if ( strlen( line ) > 0 )
-    {
-        bool resultDevice = false;
-        if ( semiCookedOut )
+        if ( ( bufferSize - frameStart ) < C_BUFFER_SIZE )
         {
-            resultDevice = updateSensorSemiCooked( line );
+            // Near the end of the buffer: work on a copy so nothing is read beyond the mapping.
+            // Like the stream reader, a truncated last frame sees the previous frame behind its own bytes.
+            memset( line, 0, C_BUFFER_SIZE );
+            memcpy( line, buffer + previousStart, std::min( ( size_t ) C_BUFFER_SIZE, frameStart - previousStart ) );
+            memcpy( line, buffer + frameStart, frameEnd - frameStart );
+            errorCode = ant2txtLine( line, frameEnd - frameStart );
         }
         else
         {
-            resultDevice = processSensorSemiCooked( line );
+            errorCode = ant2txtLine( buffer + frameStart, frameEnd - frameStart );
         }
-        errorCode = outputData();
-    }
+        previousStart = frameStart;
 
-    if ( inStream.eof() || inStream.fail() )
-    {
-        errorCode = E_END_OF_FILE;
+        if ( endOfFile && ( errorCode == 0 ) )
+        {
+            errorCode = E_END_OF_FILE;
+        }
     }
 
     return errorCode;
 }
 
-
 // -------------------------------------------------------------------------------------------------//
 //
-// Read (and process) binary ANT+ data from a stream.
+// Map the input file into memory and process it with readAntFromBuffer(), or with several threads
+// in chunks if it holds semi-cooked data (see antChunkedDecoder).
+// fileMapped is set to false if the file cannot be mapped (e.g. a pipe or an empty file), in which
+// case the caller falls back to reading from a stream.
 //
 // -------------------------------------------------------------------------------------------------//
-int antProcessing::readAntSingleLineFromStream
+int antProcessing::readAntFromFile
 (
-    std::istream &inStream
+    bool &fileMapped
 )
 {
-    int  nbBytes = 0;
-    BYTE byte    = 0;
-    BYTE line[ C_BUFFER_SIZE ];
+    int         fileDescriptor = -1;
+    void       *mapping        = MAP_FAILED;
+    struct stat fileStatus;
 
-    while ( errorCode == 0 )
+    fileMapped     = false;
+    fileDescriptor = open( inputFileName.c_str(), O_RDONLY );
+    if ( fileDescriptor >= 0 )
     {
-        byte = inStream.get();
-        if ( inStream.eof() || inStream.fail() )
+        if ( ( fstat( fileDescriptor, &fileStatus ) == 0 ) && S_ISREG( fileStatus.st_mode ) && ( fileStatus.st_size > 0 ) )
         {
-            errorCode = ant2txtLine( line, nbBytes );
-            if ( errorCode == 0 )
-            {
-                errorCode = E_END_OF_FILE;
-            }
-            break;
+            mapping = mmap( NULL, fileStatus.st_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0 );
         }
+        close( fileDescriptor );
+    }
 
-        line[ nbBytes ] = byte;
-        ++nbBytes;
-        if ( nbBytes == 1 )
+    if ( mapping != MAP_FAILED )
+    {
+        fileMapped = true;
+        madvise( mapping, fileStatus.st_size, MADV_SEQUENTIAL );
+        if ( diagnostics )
         {
-            if ( ( unsigned int ) line[ 0 ] != ( unsigned int ) 'A' )
-            {
-                if ( outputRaw || diagnostics )
-                {
-                    rawBuffer += amString( line[ 0 ] );
-                }
-                nbBytes = 0;
-            }
+            std::cerr << std::endl;
+            std::cerr << "Successfully opened input file \"" << inputFileName << "\" for reading." << std::endl;
+            std::cerr << std::endl;
         }
-        else if ( nbBytes == 2 )
+        if ( semiCookedIn )
         {
-            if ( ( unsigned int ) line[ 1 ] != ( unsigned int ) 'N' )
-            {
-                if ( outputRaw || diagnostics )
-                {
-                    rawBuffer += amString( line[ 0 ] );
-                    rawBuffer += " ";
-                    rawBuffer += amString( line[ 1 ] );
-                }
-                nbBytes = 0;
-            }
+            antChunkedDecoder chunkedDecoder( *this );
+            errorCode = chunkedDecoder.decode( ( const char * ) mapping, fileStatus.st_size, decodeThreads, errorMessage );
         }
-        else if ( ( ( unsigned int ) line[ nbBytes - 1 ] == ( unsigned int ) 'N' ) &&
-                  ( ( unsigned int ) line[ nbBytes - 2 ] == ( unsigned int ) 'A' ) )
+        else
         {
-            // Put 'A' and 'N' back into the stream (they belong to the next message).
-            inStream.putback( line[ nbBytes - 1 ] );
-            inStream.putback( line[ nbBytes - 2 ] );
-            nbBytes -= 2;
-
-            errorCode = ant2txtLine( line, nbBytes );
-            break;
+            errorCode = readAntFromBuffer( ( const BYTE * ) mapping, fileStatus.st_size );
         }
+        munmap( mapping, fileStatus.st_size );
     }
 
     return errorCode;
@@ -3202,7 +3389,6 @@ int antProcessing::ant2txtLine
     const char   operatingModeString0[] = "undefined";
 
     char         bridgeName[ C_WASP_NAME_LENGTH ];
-    char         deviceIDCString[ C_SMALL_BUFFER_SIZE ];
     char         operatingModeString[ C_MEDIUM_BUFFER_SIZE ];
     BYTE         payLoad[ C_ANT_PAYLOAD_LENGTH ];
     BYTE         packetID[ 2 ];
@@ -3239,15 +3425,59 @@ int antProcessing::ant2txtLine
     int          voltageValue       = 0;
     int          timeStampValue     = 0;
     size_t       charCount          = 0;
-    amString     deviceID           = "";
+    long long    receiveTime        = getFrameTime();
     amString     timeStampBuffer;
     amDeviceType resultDevice;
 
+    if ( captureWriter.isOpen() )
+    {
+        errorCode = captureWriter.append( line, nbBytes, receiveTime, errorMessage );
+        if ( errorCode != 0 )
+        {
+            return errorCode;
+        }
+    }
+
+    if ( stateCheckpoint.isRunning() )
+    {
+        checkpointSensorStates( receiveTime );
+    }
+
+    if ( trackSequences && !isDecodeWorker )
+    {
+        trackSequence( line, nbBytes, receiveTime );
+    }
+
+    if ( pipeline != NULL )
+    {
+        return pipeline->dispatchFrame( line, nbBytes, receiveTime, frameGapTag );
+    }
+
+    if ( perfCounters != NULL )
+    {
+        perfCounters->begin();
+        perfDeviceType = C_PERF_NO_DEVICE_TYPE;
+    }
+    if ( stageStats != NULL )
+    {
+        stageStats->beginPacket();
+    }
+
+    if ( deviceFileSource != NULL )
+    {
+        reloadDeviceFile();
+    }
+
+    if ( ( sensorIdleSeconds > 0 ) || ( maxSensors > 0 ) )
+    {
+        evictSensors( receiveTime );
+    }
+
     resetOutBuffer();
     resetRawBuffer();
     resetDiagnosticsBuffer();
 
-    getUnixTimeAsString( timeStampBuffer );
+    getUnixTimeAsString( timeStampBuffer, receiveTime );
 
     if ( outputRaw || diagnostics )
     {
@@ -3404,9 +3634,24 @@ int antProcessing::ant2txtLine
                     diagnosticsBuffer += ")";
                 }
 
-                sprintf( deviceIDCString, "%d", deviceIDint );
-                deviceID     = amString( deviceIDCString );
-                resultDevice = processSensor( deviceType, deviceID, timeStampBuffer, payLoad );
+                if ( stageStats != NULL )
+                {
+                    unregisteredSeen = false;
+                    stageStats->beginStage();
+                }
+                perfDeviceType = deviceType;
+                followsGap     = markSequenceGaps && sensorFollowsGap( deviceType, deviceIDint );
+                resultDevice   = processSensor( deviceType, deviceIDint, timeStampBuffer, payLoad );
+                followsGap     = false;
+                if ( stageStats != NULL )
+                {
+                    stageStats->endStage( STAGE_DECODE );
+                    stageStats->countPacket( deviceType, payLoad[ 0 ] );
+                    if ( resultDevice == OTHER_DEVICE )
+                    {
+                        stageStats->count( unregisteredSeen ? STATS_UNREGISTERED_DROPS : STATS_UNKNOWN_DEVICE_TYPES );
+                    }
+                }
 
                 if ( resultDevice == OTHER_DEVICE )
                 {
@@ -3729,26 +3974,152 @@ int antProcessing::ant2txtLine
         diagnosticsBuffer.clear();
     }
 
+    if ( stageStats != NULL )
+    {
+        stageStats->beginStage();
+    }
     errorCode = outputData();
+    if ( stageStats != NULL )
+    {
+        stageStats->endStage( STAGE_OUTPUT );
+        stageStats->endPacket();
+    }
+    if ( perfCounters != NULL )
+    {
+        perfCounters->end( perfDeviceType );
+    }
 
     return errorCode;
 }
 
 // -------------------------------------------------------------------------------------------------//
 //
-// Read (and process) binary ANT+ data from a multicast port.
+// Read a stream written with option '-E' and output its records as text (see ant_binary_format.h).
+// The text blocks are output as they are. A semi-cooked stream can only be output semi-cooked, and
+// a stream is refused if its text blocks are not in the output format asked for (text or JSON):
+// the records would be output in one format and the text blocks in the other.
 //
 // -------------------------------------------------------------------------------------------------//
-int antProcessing::readAntFromMultiCast
+int antProcessing::readBinaryFromStream
+(
+    std::istream &inStream
+)
+{
+    antBinaryReader reader;
+    antBinaryItem   item;
+    amString        timeStampBuffer;
+
+    errorCode = reader.readHeader( inStream, errorMessage );
+    if ( reader.getSemiCooked() )
+    {
+        setSemiCookedOut( true );
+    }
+    if ( ( errorCode == 0 ) && ( reader.getJSONText() != outputAsJSON ) )
+    {
+        errorCode = E_BAD_OPTION;
+        appendErrorMessage( reader.getJSONText() ? "The text blocks of the binary input are JSON objects: read it with option '-J'.\n"
+                                                 : "The text blocks of the binary input are text: read it without option '-J'.\n" );
+    }
+
+    while ( errorCode == 0 )
+    {
+        errorCode = reader.next( inStream, item, errorMessage );
+        if ( errorCode == 0 )
+        {
+            resetOutBuffer();
+            if ( item.itemType == C_BINARY_TEXT_ITEM )
+            {
+                outBuffer = item.text;
+            }
+            else
+            {
+                timeStampBuffer = antBinaryReader::formatTimeStamp( item.timeStamp, timePrecision );
+                outputRecord( item.itemType, antRecordContext( item.sensorID, timeStampBuffer, item.version ), item.record );
+            }
+            errorCode = outputData();
+        }
+    }
+    return errorCode;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Process the packets of an indexed capture file (option '-i') which match the selection (options
+// '-n', '-a' and '-z'), with the receive times stored in the capture. Only the blocks which may
+// hold such packets are read.
+//
+// -------------------------------------------------------------------------------------------------//
+int antProcessing::readAntFromCapture
 (
     void
 )
 {
+    antCaptureReader          reader;
+    std::vector<unsigned int> blockNumbers;
+    const BYTE               *packet      = NULL;
+    int                       nbBytes     = 0;
+    long long                 receiveTime = 0;
+    unsigned int              sensorKey   = 0;
+    bool                      isSensor    = false;
+    BYTE                      line[ C_BUFFER_SIZE ];
+
+    errorCode = reader.open( inputFileName, errorMessage );
     if ( errorCode == 0 )
     {
-        if ( interface == C_AUTO_INTERFACE )
+        reader.selectBlocks( captureSelection, blockNumbers );
+        if ( diagnostics )
         {
-            amString localInterface;
+            std::cerr << std::endl;
+            std::cerr << "Successfully opened capture file \"" << inputFileName << "\" for reading";
+            std::cerr << ( reader.isIndexed() ? "" : " (no index, the blocks are looked up)" ) << ": ";
+            std::cerr << blockNumbers.size() << " block(s) selected." << std::endl;
+            std::cerr << std::endl;
+        }
+
+        // Like with the other readers, ant2txtLine() may look beyond the end of a short packet.
+        memset( line, 0, C_BUFFER_SIZE );
+        for ( size_t counter = 0; ( errorCode == 0 ) && ( counter < blockNumbers.size() ); ++counter )
+        {
+            errorCode = reader.readBlock( blockNumbers[ counter ], errorMessage );
+            while ( ( errorCode == 0 ) && reader.nextPacket( packet, nbBytes, receiveTime ) )
+            {
+                isSensor = antCaptureReader::getSensorKey( packet, nbBytes, sensorKey );
+                if ( captureSelection.matchPacket( isSensor, sensorKey, receiveTime ) )
+                {
+                    memcpy( line, packet, std::min( nbBytes, C_BUFFER_SIZE ) );
+                    frameTime    = receiveTime;
+                    hasFrameTime = true;
+                    errorCode    = ant2txtLine( line, nbBytes );
+                }
+            }
+        }
+        hasFrameTime = false;
+        reader.close();
+    }
+
+    if ( errorCode == 0 )
+    {
+        errorCode = E_END_OF_FILE;
+    }
+    return errorCode;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Read (and process) binary ANT+ data from a multicast port.
+//
+// -------------------------------------------------------------------------------------------------//
+int antProcessing::readAntFromMultiCast
+(
+    void
+)
+{
+    if ( errorCode == 0 )
+    {
+        multicastRead.setReceiveBufferSize( receiveBufferSize );
+        if ( interface == C_AUTO_INTERFACE )
+        {
+            amString localInterface;
             bool result = true;
             for ( unsigned int counter = 0; result && ( counter < C_MAX_INTERFACE_COUNT ); ++counter )
             {
@@ -3792,93 +4163,727 @@ int antProcessing::readAntFromMultiCast
 
     if ( errorCode == 0 )
     {
-        BYTE line[ C_BUFFER_SIZE ];
-        int  nbBytes   = 1;
+        // Drain as many datagrams as the kernel has queued (up to C_MC_BATCH_SIZE) per system call.
+        // Semi-cooked input may hold several records (lines) per datagram, see option '-c'.
+        // UDP datagrams are never longer than C_MC_MAX_DATAGRAM_SIZE, so there is room for a terminating '\0'.
+        size_t            datagramSize      = semiCookedIn ? C_MC_MAX_DATAGRAM_SIZE + 1 : C_BUFFER_SIZE;
+        std::vector<BYTE> lines( C_MC_BATCH_SIZE * datagramSize );
+        size_t            nbBytes[ C_MC_BATCH_SIZE ];
+        long long         receiveTimes[ C_MC_BATCH_SIZE ];
+        unsigned int      senders[ C_MC_BATCH_SIZE ];
+        int               nbMessages        = 0;
+        unsigned int      reportedDropCount = 0;
 
         resetOutBuffer();
         resetDiagnosticsBuffer();
         resetRawBuffer();
 
-        while ( errorCode == 0 )
+        while ( errorCode == 0 )
+        {
+            if ( ( pipeline == NULL ) && multicastWrite.hasPending() && ( multicastRead.waitForData( multicastWrite.getRemainingDelayMS() ) == 0 ) )
+            {
+                // Nothing arrived before the coalesced output records were due.
+                errorCode = multicastWrite.flush( errorMessage );
+                if ( errorCode != 0 )
+                {
+                    break;
+                }
+            }
+
+            nbMessages = multicastRead.readBatch( &( lines[ 0 ] ), datagramSize, nbBytes, receiveTimes, C_MC_BATCH_SIZE, senders );
+            if ( nbMessages < 0 )
+            {
+                size_t startCount = errorMessage.size();
+                errorMessage.resize( startCount + C_BUFFER_SIZE );
+                strerror_r( errno, &( errorMessage[ startCount ] ), C_BUFFER_SIZE );
+                if ( errno == E_READ_TIMEOUT_C )
+                {
+                    errorCode     = E_READ_TIMEOUT;
+                    appendErrorMessage( "Read source timed out.\n" );
+                }
+                else
+                {
+                    errorCode = E_READ_ERROR;
+                    appendErrorMessage("Error while reading.\n" );
+                }
+            }
+            else
+            {
+                if ( stageStats != NULL )
+                {
+                    // From the arrival of the datagrams (kernel time stamps) to the return of the read.
+                    long long readTime = getUnixTime();
+                    for ( int counter = 0; counter < nbMessages; ++counter )
+                    {
+                        stageStats->addTime( STAGE_READ, ( readTime - receiveTimes[ counter ] ) * 1000 );
+                    }
+                }
+                for ( int counter = 0; ( errorCode == 0 ) && ( counter < nbMessages ); ++counter )
+                {
+                    if ( semiCookedIn )
+                    {
+                        errorCode = processSemiCookedDatagram( ( char * ) &( lines[ counter * datagramSize ] ), nbBytes[ counter ] );
+                    }
+                    else
+                    {
+                        // The packets are stamped with the time they arrived, not the time they are decoded.
+                        hasFrameTime = !testMode;
+                        frameTime    = receiveTimes[ counter ];
+                        frameSender  = senders[ counter ];
+                        errorCode    = ant2txtLine( &( lines[ counter * datagramSize ] ), nbBytes[ counter ] );
+                        hasFrameTime = false;
+                        frameSender  = 0;
+                    }
+                }
+                if ( nbMessages < C_MC_BATCH_SIZE )
+                {
+                    // The socket has been drained, the next read will wait for new data.
+                    if ( pipeline != NULL )
+                    {
+                        pipeline->idle( false );
+                    }
+                    else
+                    {
+                        outputWriter.idle();
+                    }
+                }
+                if ( multicastRead.getDroppedCount() > reportedDropCount )
+                {
+                    std::cerr << "WARNING: The kernel dropped " << ( multicastRead.getDroppedCount() - reportedDropCount );
+                    std::cerr << " multicast packet(s) (" << multicastRead.getDroppedCount() << " in total)." << std::endl;
+                    reportedDropCount = multicastRead.getDroppedCount();
+                }
+            }
+        }
+    }
+
+    multicastRead.close();
+
+    return errorCode;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Process a binary ANT+ data package.
+//
+// A package has the following syntax:
+//
+//  ANT+ messages
+//
+//     Byte  0 -  1: Packet Type Identifier
+//                   (two byte header 'A', 'N' or '41', '4E' written in hex ASCII)
+//     Byte       2: Packet Command Byte (Refer to table XXX), For ANT+ messages: 0x12 (18 dec)
+//     Byte       3: Message ID (Incremental counter)
+//     Byte       4: Payload Message Length (number of bytes, in our case: 14)
+//     Byte       5: Payload Command Byte
+//     Byte       6: Channel Number
+//     Byte  7 - 14: Payload Data              if Byte 4 is '0E' = 14
+//     Byte      15: Flag Type                 if Byte 4 is '0E' = 14
+//     Byte 16 - 17: Device ID                 if Byte 4 is '0E' = 14
+//     Byte      18: Device Type               if Byte 4 is '0E' = 14
+//     Byte      19: Trans Type                if Byte 4 is '0E' = 14
+//
+//  Bridge messages
+//
+//     Byte  0 -  1: Packet Type Identifier
+//                   (two byte header 'A', 'N' or '41', '4E' written in hex ASCII)
+//     Byte       2: Packet Command Byte (Refer to table XXX). For Bridge messages: 0x43 (67 dec)
+//     Byte       3: Message Sequence # Same Message Sequence # used to query ...
+//     Byte       4: Message Length Number of Bytes in the Payload (Starting at Byte 7)
+//     Byte  5 -  6: Reserved Contents t Defined
+//     Byte       7: Major Version Bridge Firmware Major Version - Hex
+//     Byte       8: Minor Version Bridge Firmware Minor Version - Hex
+//     Byte       9: Product Type Bridge Product Version
+//     Byte      10: Connection Stat 0 - TCP Available, 1 - TCP In Use
+//     Byte      11: Reserved Reserved
+//     Byte 12 - 13: Battery Level LSB, MSB Voltage in millivolts
+//     Byte      14: Power Indicator 1 - Battery Charging
+//     Byte      15: Operating Mode ...
+//     Byte      16: Bridge Name Length
+//     Byte 17 - 48: Bridge Name ASCII Name of Bridge
+//     Byte 49 - 55: Bridge Mac Mac Address of Bridge in HEX
+//
+// -------------------------------------------------------------------------------------------------//
+int antProcessing::ant2txt
+(
+    void
+)
+{
+    errorMessage.clear();
+
+    readDeviceFile();
+
+    if ( ( errorCode == 0 ) && !stateFileName.empty() )
+    {
+        errorCode = restoreSensorStates( 0, 1 );
+        if ( errorCode == 0 )
+        {
+            errorCode = stateCheckpoint.start( stateFileName, errorMessage );
+        }
+    }
+
+    if ( ( errorCode == 0 ) && watchDeviceFile )
+    {
+        errorCode = deviceFileWatcher.start( deviceFileName, errorMessage );
+        if ( errorCode == 0 )
+        {
+            deviceFileSource = &deviceFileWatcher;
+        }
+    }
+
+    if ( ( errorCode == 0 ) && !statsFileName.empty() )
+    {
+        errorCode = stageStatsDump.start( statsFileName, statsIntervalSeconds, errorMessage );
+        if ( errorCode == 0 )
+        {
+            stageStatsSource = &stageStatsDump;
+            stageStats       = stageStatsDump.newPart();
+        }
+    }
+
+    if ( ( errorCode == 0 ) && !perfCountersFileName.empty() )
+    {
+        perfCounterSource = &perfCounterSet;
+        perfCounters      = perfCounterSet.newPart();
+    }
+
+    if ( ( errorCode == 0 ) && ( !mcAddressOut.empty() ) && ( mcPortNoOut > 0 ) )
+    {
+        errorCode = multicastWrite.connect( mcAddressOut, mcPortNoOut, errorMessage );
+        if ( ( errorCode == 0 ) && diagnostics )
+        {
+            std::cerr << std::endl;
+            std::cerr << "Successfully created multicast connection for writing on IP address \"" << mcAddressOut << "\" and port number " << mcPortNoOut << "." << std::endl;
+            std::cerr << std::endl;
+        }
+    }
+
+    if ( ( errorCode == 0 ) && writeStdout )
+    {
+        std::cout.flush();
+        errorCode = outputWriter.open( STDOUT_FILENO, errorMessage );
+    }
+
+    if ( ( errorCode == 0 ) && !captureFileName.empty() )
+    {
+        errorCode = captureWriter.open( captureFileName, errorMessage );
+    }
+
+    if ( ( errorCode == 0 ) && binaryOut )
+    {
+        binaryFormatter.appendStreamHeader();
+        errorCode = writeOutput( binaryBuffer, false, errorCode, errorMessage );
+        binaryBuffer.clear();
+    }
+
+    // A semi-cooked input file is decoded in chunks (see readAntFromFile()) rather than through the pipeline.
+    if ( ( errorCode == 0 ) && !binaryIn && ( !semiCookedIn || !mcAddressIn.empty() || inputFileName.empty() ) )
+    {
+        errorCode = startDecodePipeline();
+    }
+
+    if ( ( errorCode == 0 ) && binaryIn )
+    {
+        if ( inputFileName.empty() )
+        {
+            errorCode = readBinaryFromStream( std::cin );
+        }
+        else
+        {
+            std::ifstream inputStream( inputFileName.c_str(), std::ios::in | std::ios::binary );
+            if ( inputStream.fail() )
+            {
+                appendErrorMessage( "Could not open file \"" );
+                appendErrorMessage( inputFileName );
+                appendErrorMessage( "\" for reading.\n" );
+                errorCode = E_READ_FILE_NOT_OPEN;
+            }
+            else
+            {
+                errorCode = readBinaryFromStream( inputStream );
+            }
+        }
+    }
+    else if ( ( errorCode == 0 ) && captureIn )
+    {
+        errorCode = readAntFromCapture();
+    }
+    else if ( errorCode == 0 )
+    {
+        if ( mcAddressIn.empty() )
+        {
+            // Read from stdin or from file
+            if ( inputFileName.empty() )
+            {
+                if ( diagnostics )
+                {
+                    std::cerr << "READ data from STDIN." << std::endl;
+                }
+                errorCode = readAntFromStream( std::cin );
+            }
+            else
+            {
+                bool fileMapped = false;
+                if ( !semiCookedIn || ( decodeThreads > 1 ) )
+                {
+                    errorCode = readAntFromFile( fileMapped );
+                }
+                if ( !fileMapped && semiCookedIn && ( errorCode == 0 ) )
+                {
+                    errorCode = startDecodePipeline();
+                }
+                if ( !fileMapped && ( errorCode == 0 ) )
+                {
+                    std::ifstream inputStream( inputFileName.c_str() );
+                    if ( inputStream.bad() )
+                    {
+                       appendErrorMessage( "Could not open file \"" );
+                       appendErrorMessage( inputFileName );
+                       appendErrorMessage( "\" for reading.\n" );
+                       errorCode = E_READ_FILE_NOT_OPEN;
+                    }
+                    else
+                    {
+                        if ( diagnostics )
+                        {
+                            std::cerr << std::endl;
+                            std::cerr << "Successfully opened input file \"" << inputFileName << "\" for reading." << std::endl;
+                            std::cerr << std::endl;
+                        }
+                        errorCode = readAntFromStream( inputStream );
+                        inputStream.close();
+                    }
+                }
+            }
+        }
+        else
+        {
+            errorCode = readAntFromMultiCast();
+        }
+    }
+
+    // The totals of the bridges, after the packets read.
+    if ( trackSequences && ( sequenceTracker.size() > 0 ) && ( ( errorCode == 0 ) || ( errorCode == E_END_OF_FILE ) || ( errorCode == E_READ_TIMEOUT ) ) )
+    {
+        int endErrorCode = errorCode;
+        errorCode = 0;
+        writeSequenceRecords( sequenceTracker.getLastSeen() );
+        if ( errorCode == 0 )
+        {
+            errorCode = endErrorCode;
+        }
+    }
+
+    // With several threads and no pipeline, a semi-cooked file was decoded by an antChunkedDecoder,
+    // which has saved the sensor states of its threads already.
+    if ( stateCheckpoint.isRunning() && ( ( pipeline != NULL ) || ( decodeThreads <= 1 ) ) )
+    {
+        snapshotSensorStates( true );
+    }
+
+    if ( pipeline != NULL )
+    {
+        // Wait until everything read has been decoded and output.
+        int pipelineError = pipeline->stop( errorMessage );
+        if ( pipelineError != 0 )
+        {
+            errorCode = pipelineError;
+        }
+        delete pipeline;
+        pipeline = NULL;
+    }
+    if ( captureWriter.isOpen() )
+    {
+        int captureError = captureWriter.close( errorMessage );
+        if ( ( captureError != 0 ) && ( ( errorCode == 0 ) || ( errorCode == E_END_OF_FILE ) ) )
+        {
+            errorCode = captureError;
+        }
+    }
+    if ( stateCheckpoint.isRunning() )
+    {
+        int checkpointError = stateCheckpoint.stop( errorMessage );
+        if ( ( checkpointError != 0 ) && ( ( errorCode == 0 ) || ( errorCode == E_END_OF_FILE ) ) )
+        {
+            errorCode = checkpointError;
+        }
+        if ( diagnostics )
+        {
+            std::cerr << "Wrote " << stateCheckpoint.getNbWritten() << " sensor state checkpoint(s) to \"" << stateFileName << "\"." << std::endl;
+        }
+    }
+    if ( deviceFileWatcher.isRunning() )
+    {
+        deviceFileWatcher.stop();
+        deviceFileSource = NULL;
+        if ( diagnostics )
+        {
+            std::cerr << "Reloaded the device file \"" << deviceFileName << "\" " << deviceFileWatcher.getNbReloads() << " time(s)." << std::endl;
+        }
+    }
+    if ( stageStatsDump.isRunning() )
+    {
+        int statsError = stageStatsDump.stop( errorMessage );
+        if ( ( statsError != 0 ) && ( ( errorCode == 0 ) || ( errorCode == E_END_OF_FILE ) ) )
+        {
+            errorCode = statsError;
+        }
+        stageStats       = NULL;
+        stageStatsSource = NULL;
+        if ( diagnostics )
+        {
+            std::cerr << "Wrote the statistics " << stageStatsDump.getNbDumps() << " time(s) to \"" << statsFileName << "\"." << std::endl;
+        }
+    }
+    if ( perfCounterSource == &perfCounterSet )
+    {
+        writePerfCounters();
+    }
+    if ( diagnostics && ( ( sensorIdleSeconds > 0 ) || ( maxSensors > 0 ) ) )
+    {
+        const antSensorStateCounters &counters = sensorStates.getCounters();
+        std::cerr << "Sensor states created: " << counters.nbCreated;
+        std::cerr << ", evicted when idle: " << counters.nbEvictedIdle;
+        std::cerr << ", evicted over the limit: " << counters.nbEvictedLimit << "." << std::endl;
+    }
+    multicastWrite.close();
+    outputWriter.close();
+    if ( errorCode == E_END_OF_FILE )
+    {
+        errorCode = 0;
+    }
+    return errorCode;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Start the decode threads (option '-j'), if any.
+// From then on ant2txtLine() and processSemiCookedLine() hand the input over to the pipeline.
+//
+// -------------------------------------------------------------------------------------------------//
+int antProcessing::startDecodePipeline
+(
+    void
+)
+{
+    if ( ( decodeThreads > 1 ) && ( pipeline == NULL ) )
+    {
+        pipeline  = new antDecodePipeline( *this );
+        errorCode = pipeline->start( decodeThreads, errorMessage );
+    }
+    return errorCode;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Restore the sensor states saved by a previous run (option '-k'). A decode thread only restores the
+// sensors it decodes (see antDecodePipeline::getSemiCookedKey).
+//
+// -------------------------------------------------------------------------------------------------//
+int antProcessing::restoreSensorStates
+(
+    unsigned int workerNo,
+    unsigned int nbWorkers
+)
+{
+    unsigned int nbRestored = 0;
+
+    errorCode = antStateCheckpoint::load( stateFileName, sensorStates, workerNo, nbWorkers, nbRestored, errorMessage );
+    if ( ( errorCode == 0 ) && diagnostics && !isDecodeWorker )
+    {
+        std::cerr << std::endl;
+        std::cerr << "Restored the state of " << nbRestored << " sensor(s) from \"" << stateFileName << "\"." << std::endl;
+        std::cerr << std::endl;
+    }
+    return errorCode;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Save the sensor states once every 'checkpointSeconds' seconds of receive time.
+//
+// -------------------------------------------------------------------------------------------------//
+void antProcessing::checkpointSensorStates
+(
+    long long now
+)
+{
+    if ( nextCheckpointTime == 0 )
+    {
+        nextCheckpointTime = now + ( long long ) checkpointSeconds * 1000000;
+    }
+    else if ( now >= nextCheckpointTime )
+    {
+        snapshotSensorStates( false );
+        nextCheckpointTime = now + ( long long ) checkpointSeconds * 1000000;
+    }
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Hand a copy of the sensor states to the checkpoint thread. With decode threads every thread copies
+// its own sensors once it has decoded all packets read so far.
+//
+// -------------------------------------------------------------------------------------------------//
+void antProcessing::snapshotSensorStates
+(
+    bool last
+)
+{
+    // 0: the decode threads have not handed in the previous snapshot yet.
+    unsigned int snapshotNo = stateCheckpoint.begin( ( pipeline != NULL ) ? decodeThreads : 1, last );
+
+    if ( ( snapshotNo != 0 ) && ( pipeline != NULL ) )
+    {
+        pipeline->dispatchSnapshot( snapshotNo );
+    }
+    else if ( snapshotNo != 0 )
+    {
+        saveSensorStates( stateCheckpoint, snapshotNo );
+    }
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Forget the sensors not heard from for 'sensorIdleSeconds' seconds (option '-A') and the least
+// recently heard from sensors while there are more than 'maxSensors' (option '-L'). The sensors of
+// the device file are kept. The idle sensors are looked for once a second, the limit is checked for
+// every packet (before its sensor is added).
+//
+// -------------------------------------------------------------------------------------------------//
+void antProcessing::evictSensors
+(
+    long long now
+)
+{
+    bool atLimit = ( maxSensors > 0 ) && ( sensorStates.size() >= ( size_t ) maxSensors );
+
+    sensorStates.setTime( now );
+    if ( atLimit || ( now >= nextEvictionTime ) )
+    {
+        sensorStates.evict( ( long long ) sensorIdleSeconds * 1000000, ( maxSensors > 0 ) ? maxSensors - 1 : 0 );
+        nextEvictionTime = now + ( long long ) C_EVICTION_INTERVAL_SECONDS * 1000000;
+    }
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Count the sequence number of a bridge message (option '-G'). ANT messages and query responses
+// share the sequence counter of the bridge, query responses also tell its MAC address.
+// Runs in the reading thread, the gap tag of the packet goes with it to the decode thread.
+//
+// -------------------------------------------------------------------------------------------------//
+void antProcessing::trackSequence
+(
+    const BYTE *line,
+    int         nbBytes,
+    long long   receiveTime
+)
+{
+    const BYTE   *macAddress = NULL;
+    unsigned int  sourceNo   = 0;
+
+    frameGapTag = 0;
+    if ( ( nbBytes > C_SEQUENCE_OFFSET ) && ( ( line[ 2 ] == C_ANT_ASYNC_MSG ) || ( line[ 2 ] == C_QUERY_RESP ) ) )
+    {
+        if ( ( line[ 2 ] == C_QUERY_RESP ) && ( nbBytes >= C_BRIDGE_MAC_OFFSET + C_BRIDGE_MAC_LENGTH ) )
+        {
+            macAddress = line + C_BRIDGE_MAC_OFFSET;
+        }
+        sourceNo    = sequenceTracker.track( frameSender, line[ C_SEQUENCE_OFFSET ], receiveTime, macAddress );
+        frameGapTag = sequenceTracker.getGapTag( sourceNo );
+    }
+
+    if ( nextSequenceReport == 0 )
+    {
+        nextSequenceReport = receiveTime + ( long long ) sequenceIntervalSeconds * 1000000;
+    }
+    else if ( ( sequenceIntervalSeconds > 0 ) && ( receiveTime >= nextSequenceReport ) )
+    {
+        writeSequenceRecords( receiveTime );
+        nextSequenceReport = receiveTime + ( long long ) sequenceIntervalSeconds * 1000000;
+    }
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Output a sequence gap record for every bridge. With decode threads the records are handed to the
+// output in the order of the input.
+//
+// -------------------------------------------------------------------------------------------------//
+void antProcessing::writeSequenceRecords
+(
+    long long now
+)
+{
+    amString timeStampBuffer;
+
+    if ( binaryOut || outputRaw )
+    {
+        return;
+    }
+
+    getUnixTimeAsString( timeStampBuffer, now );
+    for ( unsigned int sourceNo = 0; ( errorCode == 0 ) && ( sourceNo < sequenceTracker.size() ); ++sourceNo )
+    {
+        if ( !sequenceTracker[ sourceNo ].used )
+        {
+            continue;
+        }
+        resetOutBuffer();
+        createSequenceString( sourceNo, timeStampBuffer );
+        if ( pipeline != NULL )
+        {
+            errorCode = pipeline->dispatchOutput( outBuffer );
+        }
+        else
+        {
+            errorCode = writeOutput( outBuffer, true, errorCode, errorMessage );
+        }
+    }
+    resetOutBuffer();
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Return true if a gap was seen in the sequence of the bridge since the previous packet of the
+// sensor: its delta values (event counts, accumulated power, ...) may span lost packets.
+//
+// -------------------------------------------------------------------------------------------------//
+bool antProcessing::sensorFollowsGap
+(
+    int deviceType,
+    int deviceID
+)
+{
+    unsigned int                                         key    = ( ( unsigned int ) deviceType << 16 ) | ( unsigned int ) deviceID;
+    std::map<unsigned int, unsigned long long>::iterator sensor = sensorGapTags.find( key );
+    bool                                                 result = false;
+
+    if ( sensor == sensorGapTags.end() )
+    {
+        sensorGapTags.insert( std::make_pair( key, frameGapTag ) );
+    }
+    else
+    {
+        // Same bridge (upper half of the tag), other number of gaps.
+        result         = ( ( sensor->second >> 32 ) == ( frameGapTag >> 32 ) ) && ( sensor->second != frameGapTag );
+        sensor->second = frameGapTag;
+    }
+    return result;
+}
+
+// Name of the output mode for the hardware counters (like the output modes of ant2txt_bench).
+const char *antProcessing::getOutputModeName
+(
+    void
+) const
+{
+    if ( binaryOut )
+    {
+        return "binary";
+    }
+    if ( diagnostics )
+    {
+        return "diag";
+    }
+    if ( outputRaw )
+    {
+        return "raw";
+    }
+    if ( outputAsJSON )
+    {
+        return semiCookedOut ? "semiJSON" : "json";
+    }
+    return semiCookedOut ? "semi" : "cooked";
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Write the hardware counters of all threads (option '-Q'), warn if the counters could not be
+// opened: the file then only holds the packets.
+//
+// -------------------------------------------------------------------------------------------------//
+void antProcessing::writePerfCounters
+(
+    void
+)
+{
+    amString reason;
+    int      perfError = perfCounterSet.write( perfCountersFileName, programName, getOutputModeName(), errorMessage );
+
+    if ( ( perfError != 0 ) && ( ( errorCode == 0 ) || ( errorCode == E_END_OF_FILE ) ) )
+    {
+        errorCode = perfError;
+    }
+    if ( !perfCounterSet.isAvailable( reason ) )
+    {
+        std::cerr << "WARNING: Hardware performance counters are not available (" << reason << "), \"" << perfCountersFileName << "\" only counts the packets." << std::endl;
+    }
+    else if ( diagnostics )
+    {
+        std::cerr << "Wrote the hardware performance counters to \"" << perfCountersFileName << "\"." << std::endl;
+    }
+    perfCounters      = NULL;
+    perfCounterSource = NULL;
+    perfCounterSet.clear();
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Apply the device file if it was reloaded (option '-W'). The values, registrations, roles and
+// pinning of the old file are dropped first, the running state of the sensors is kept. Problems of
+// the new file are reported but do not stop the decoding.
+//
+// -------------------------------------------------------------------------------------------------//
+void antProcessing::reloadDeviceFile
+(
+    void
+)
+{
+    std::vector<amString> lines;
+    int                   savedErrorCode    = errorCode;
+    amString              savedErrorMessage = errorMessage;
+
+    if ( deviceFileSource->fetch( deviceFileGeneration, lines ) )
+    {
+        clearErrors();
+        sensorStates.clearFields( C_DEVICE_FILE_FIELDS );
+        sensorStates.clearPinning();
+        sensorStates.setPinning( true );
+        for ( size_t counter = 0; counter < lines.size(); ++counter )
         {
-            nbBytes = multicastRead.read( line, C_BUFFER_SIZE );
-            if ( nbBytes < 0 )
+            readDeviceFileLine( lines[ counter ].c_str() );
+            if ( errorCode != 0 )
             {
-                size_t startCount = errorMessage.size();
-                errorMessage.resize( startCount + C_BUFFER_SIZE );
-                strerror_r( errno, &( errorMessage[ startCount ] ), C_BUFFER_SIZE );
-                if ( errno == E_READ_TIMEOUT_C )
-                {
-                    errorCode     = E_READ_TIMEOUT;
-                    appendErrorMessage( "Read source timed out.\n" );
-                }
-                else
+                if ( !isDecodeWorker )
                 {
-                    errorCode = E_READ_ERROR;
-                    appendErrorMessage("Error while reading.\n" );
+                    std::cerr << errorMessage << std::endl;
                 }
+                clearErrors();
             }
-            else
-            {
-                errorCode = ant2txtLine( line, nbBytes );
-            }
         }
+        sensorStates.setPinning( false );
+        if ( diagnostics && !isDecodeWorker )
+        {
+            std::cerr << "Reloaded the device file \"" << deviceFileName << "\" (" << lines.size() << " line(s))." << std::endl;
+        }
+        errorCode    = savedErrorCode;
+        errorMessage = savedErrorMessage;
     }
-
-    multicastRead.close();
-
-    return errorCode;
 }
 
 // -------------------------------------------------------------------------------------------------//
 //
-// Process a binary ANT+ data package.
-//
-// A package has the following syntax:
-//
-//  ANT+ messages
-//
-//     Byte  0 -  1: Packet Type Identifier
-//                   (two byte header 'A', 'N' or '41', '4E' written in hex ASCII)
-//     Byte       2: Packet Command Byte (Refer to table XXX), For ANT+ messages: 0x12 (18 dec)
-//     Byte       3: Message ID (Incremental counter)
-//     Byte       4: Payload Message Length (number of bytes, in our case: 14)
-//     Byte       5: Payload Command Byte
-//     Byte       6: Channel Number
-//     Byte  7 - 14: Payload Data              if Byte 4 is '0E' = 14
-//     Byte      15: Flag Type                 if Byte 4 is '0E' = 14
-//     Byte 16 - 17: Device ID                 if Byte 4 is '0E' = 14
-//     Byte      18: Device Type               if Byte 4 is '0E' = 14
-//     Byte      19: Trans Type                if Byte 4 is '0E' = 14
-//
-//  Bridge messages
-//
-//     Byte  0 -  1: Packet Type Identifier
-//                   (two byte header 'A', 'N' or '41', '4E' written in hex ASCII)
-//     Byte       2: Packet Command Byte (Refer to table XXX). For Bridge messages: 0x43 (67 dec)
-//     Byte       3: Message Sequence # Same Message Sequence # used to query ...
-//     Byte       4: Message Length Number of Bytes in the Payload (Starting at Byte 7)
-//     Byte  5 -  6: Reserved Contents t Defined
-//     Byte       7: Major Version Bridge Firmware Major Version - Hex
-//     Byte       8: Minor Version Bridge Firmware Minor Version - Hex
-//     Byte       9: Product Type Bridge Product Version
-//     Byte      10: Connection Stat 0 - TCP Available, 1 - TCP In Use
-//     Byte      11: Reserved Reserved
-//     Byte 12 - 13: Battery Level LSB, MSB Voltage in millivolts
-//     Byte      14: Power Indicator 1 - Battery Charging
-//     Byte      15: Operating Mode ...
-//     Byte      16: Bridge Name Length
-//     Byte 17 - 48: Bridge Name ASCII Name of Bridge
-//     Byte 49 - 55: Bridge Mac Mac Address of Bridge in HEX
+// Read the device IDs and parameters from the device file (option '-d'), if there is one.
+// The sensors of the device file are pinned: they are never evicted (options '-A' and '-L').
 //
 // -------------------------------------------------------------------------------------------------//
-int antProcessing::ant2txt
+int antProcessing::readDeviceFile
 (
     void
 )
 {
-    errorMessage.clear();
-
     if ( !deviceFileName.empty() )
     {
         std::ifstream inStr( deviceFileName.c_str() );
@@ -3891,69 +4896,267 @@ int antProcessing::ant2txt
         }
         else
         {
+            sensorStates.setPinning( true );
             readDeviceFileStream( inStr );
+            sensorStates.setPinning( false );
         }
     }
+    return errorCode;
+}
 
-    if ( ( errorCode == 0 ) && ( !mcAddressOut.empty() ) && ( mcPortNoOut > 0 ) )
+// -------------------------------------------------------------------------------------------------//
+//
+// Read a device file for an embedding application (see ant_decoder.h). The errors are returned in
+// 'message' instead of being kept for outputError().
+//
+// -------------------------------------------------------------------------------------------------//
+int antProcessing::loadDeviceFile
+(
+    const amString &fileName,
+    amString       &message
+)
+{
+    int result = 0;
+
+    deviceFileName = fileName;
+    result         = readDeviceFile();
+    message        = errorMessage;
+    clearErrors();
+
+    return result;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Process one line in the format of the device file for an embedding application.
+//
+// -------------------------------------------------------------------------------------------------//
+int antProcessing::addDevice
+(
+    const char *line,
+    amString   &message
+)
+{
+    int result = 0;
+
+    while ( IS_WHITE_CHAR( *line ) )
     {
-        errorCode = multicastWrite.connect( mcAddressOut, mcPortNoOut, errorMessage );
-        if ( ( errorCode != 0 ) && diagnostics )
-        {
-            std::cerr << std::endl;
-            std::cerr << "Successfully created multicast connection for writing on IP address \"" << mcAddressOut << "\" and port number " << mcPortNoOut << "." << std::endl;
-            std::cerr << std::endl;
-        }
+        ++line;
+    }
+    if ( ( *line != 0 ) && ( *line != C_COMMENT_SYMBOL ) )
+    {
+        sensorStates.setPinning( true );
+        readDeviceFileLine( line );
+        sensorStates.setPinning( false );
     }
+    result  = errorCode;
+    message = errorMessage;
+    clearErrors();
 
-    if ( errorCode == 0 )
+    return result;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Set up a processor made by createWorker() for a decode thread: same command line options and
+// device file as 'owner', but no input or output of its own. 'workerNo' of 'nbWorkers' keeps the
+// sensor handles of the binary output (-E) apart from those of the other threads.
+//
+// -------------------------------------------------------------------------------------------------//
+int antProcessing::configureWorker
+(
+    const antProcessing &owner,
+    unsigned int         workerNo,
+    unsigned int         nbWorkers
+)
+{
+    isDecodeWorker = true;
+    binaryFormatter.setHandleNumbering( workerNo, nbWorkers );
+
+    optind = 1;
+    if ( processArguments( owner.programName, owner.validOptions, owner.deviceTypeName, owner.argCount, owner.argValues ) && ( errorCode == 0 ) )
     {
-        if ( mcAddressIn.empty() )
+        setDecodeThreads( 1 );
+        setWriteStdout( false );
+        setMaxSensors( ( maxSensors + nbWorkers - 1 ) / nbWorkers );
+        deviceFileSource = owner.deviceFileSource;
+        stageStatsSource = owner.stageStatsSource;
+        if ( stageStatsSource != NULL )
         {
-            // Read from stdin or from file
-            if ( inputFileName.empty() )
-            {
-                if ( diagnostics )
-                {
-                    std::cerr << "READ data from STDIN." << std::endl;
-                }
-                errorCode = readAntFromStream( std::cin );
-            }
-            else
-            {
-                std::ifstream inputStream( inputFileName.c_str() );
-                if ( inputStream.bad() )
-                {
-                   appendErrorMessage( "Could not open file \"" );
-                   appendErrorMessage( inputFileName );
-                   appendErrorMessage( "\" for reading.\n" );
-                   errorCode = E_READ_FILE_NOT_OPEN;
-                }
-                else
-                {
-                    if ( diagnostics )
-                    {
-                        std::cerr << std::endl;
-                        std::cerr << "Successfully opened input file \"" << inputFileName << "\" for reading." << std::endl;
-                        std::cerr << std::endl;
-                    }
-                    errorCode = readAntFromStream( inputStream );
-                    inputStream.close();
-                }
-            }
+            stageStats = stageStatsSource->newPart();
         }
-        else
+        perfCounterSource = owner.perfCounterSource;
+        if ( perfCounterSource != NULL )
         {
-            errorCode = readAntFromMultiCast();
+            perfCounters = perfCounterSource->newPart();
+        }
+        readDeviceFile();
+        if ( ( errorCode == 0 ) && !stateFileName.empty() )
+        {
+            restoreSensorStates( workerNo, nbWorkers );
+        }
+    }
+    return errorCode;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Decode a binary ANT+ packet in a decode thread. The output is kept in 'output' (see
+// writeOutput), the packet gets the time stamp it was read at.
+//
+// -------------------------------------------------------------------------------------------------//
+int antProcessing::decodeFrame
+(
+    const BYTE         *line,
+    int                 nbBytes,
+    long long           receiveTime,
+    amString           &output,
+    amString           &message,
+    unsigned long long  gapTag
+)
+{
+    int result = 0;
+
+    capturedOutput = &output;
+    hasFrameTime   = true;
+    frameTime      = receiveTime;
+    frameGapTag    = gapTag;
+
+    result = ant2txtLine( line, nbBytes );
+
+    hasFrameTime   = false;
+    capturedOutput = NULL;
+    message        = errorMessage;
+    clearErrors();
+
+    return result;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Process a semi-cooked input line in a decode thread. The output is kept in 'output'.
+//
+// -------------------------------------------------------------------------------------------------//
+int antProcessing::decodeSemiCookedLine
+(
+    const char *line,
+    amString   &output,
+    amString   &message
+)
+{
+    int result = 0;
+
+    capturedOutput = &output;
+    resetOutBuffer();
+    resetDiagnosticsBuffer();
+
+    result = processSemiCookedLine( line );
+
+    capturedOutput = NULL;
+    message        = errorMessage;
+    clearErrors();
+
+    return result;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Output a record made by the reading thread (e.g. the sequence gap records), in the order of the
+// input (see antDecodePipeline::dispatchOutput).
+//
+// -------------------------------------------------------------------------------------------------//
+int antProcessing::decodeOutput
+(
+    const amString &text,
+    amString       &output,
+    amString       &message
+)
+{
+    int result = 0;
+
+    capturedOutput = &output;
+
+    result = writeOutput( text, true, 0, errorMessage );
+
+    capturedOutput = NULL;
+    message        = errorMessage;
+    clearErrors();
+
+    return result;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Output what a decode thread has captured for one or more packets (called by the thread which
+// does the output only).
+//
+// -------------------------------------------------------------------------------------------------//
+int antProcessing::writeDecodedOutput
+(
+    const char *decoded,
+    size_t      size,
+    amString   &message
+)
+{
+    int    resultCode = 0;
+    size_t position   = 0;
+    size_t length     = 0;
+    bool   asRecord   = false;
+
+    while ( ( resultCode == 0 ) && ( position + 1 + sizeof( length ) <= size ) )
+    {
+        asRecord = ( decoded[ position ] == C_CAPTURED_RECORD );
+        memcpy( &length, decoded + position + 1, sizeof( length ) );
+        position += 1 + sizeof( length );
+        decodedRecord.assign( decoded + position, length );
+        resultCode = writeOutput( decodedRecord, asRecord, resultCode, message );
+        if ( resultCode == E_EMPTY_MESSAGE )
+        {
+            resultCode = 0;
         }
+        position += length;
+    }
+    return resultCode;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// No more input is waiting: let the pending output go (the multicast records only if requested).
+//
+// -------------------------------------------------------------------------------------------------//
+int antProcessing::flushIdleOutput
+(
+    bool      flushMulticast,
+    amString &message
+)
+{
+    int resultCode = 0;
 
-        multicastWrite.close();
+    outputWriter.idle();
+    if ( flushMulticast && multicastWrite.hasPending() )
+    {
+        resultCode = multicastWrite.flush( message );
     }
-    if ( errorCode == E_END_OF_FILE )
+    return resultCode;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Send the coalesced multicast records if the oldest one has waited long enough.
+//
+// -------------------------------------------------------------------------------------------------//
+int antProcessing::flushDueOutput
+(
+    amString &message
+)
+{
+    int resultCode = 0;
+
+    if ( multicastWrite.hasPending() && ( multicastWrite.getRemainingDelayMS() == 0 ) )
     {
-        errorCode = 0;
+        resultCode = multicastWrite.flush( message );
     }
-    return errorCode;
+    return resultCode;
 }
 
 // -------------------------------------------------------------------------------------------------//
@@ -3986,7 +5189,11 @@ void antProcessing::readDeviceFileStream
         readDeviceFileLine( lPtr );
         if ( ( errorCode == E_BAD_PARAMETER_VALUE ) && !getExitOnWarnings() )
         {
-            std::cerr << errorMessage << std::endl;
+            if ( !isDecodeWorker )
+            {
+                // Decode threads read the same file, the warnings have been output already.
+                std::cerr << errorMessage << std::endl;
+            }
             clearErrors();
         }
     }
@@ -3999,13 +5206,13 @@ void antProcessing::readDeviceFileStream
 // -------------------------------------------------------------------------------------------------//
 void antProcessing::setZeroTimeCount
 (
-    const amString &sensorID,
-    unsigned int    value
+    const antSensorHandle &sensorID,
+    unsigned int           value
 )
 {
     if ( zeroTimeCountTable.count( sensorID ) > 0 )
     {
-        zeroTimeCountTable.insert( std::pair<amString, unsigned int>( sensorID, 0 ) );
+        zeroTimeCountTable.insert( sensorID, 0 );
     }
     zeroTimeCountTable[ sensorID ] = value;
 }
@@ -4017,7 +5224,7 @@ void antProcessing::setZeroTimeCount
 // -------------------------------------------------------------------------------------------------//
 unsigned int antProcessing::getZeroTimeCount
 (
-    const amString &sensorID
+    const antSensorHandle &sensorID
 )
 {
     unsigned int value = 0;
@@ -4035,13 +5242,13 @@ unsigned int antProcessing::getZeroTimeCount
 // -------------------------------------------------------------------------------------------------//
 void antProcessing::setTotalOperationTime
 (
-    const amString &sensorID,
-    double          value
+    const antSensorHandle &sensorID,
+    double                 value
 )
 {
     if ( totalOperatingTimeTable.count( sensorID ) == 0 )
     {
-        totalOperatingTimeTable.insert( std::pair<amString, double>(  sensorID, 0 ) );
+        totalOperatingTimeTable.insert( sensorID, 0 );
     }
     totalOperatingTimeTable[ sensorID ] = value;
 }
@@ -4053,7 +5260,7 @@ void antProcessing::setTotalOperationTime
 // -------------------------------------------------------------------------------------------------//
 double antProcessing::getTotalOperationTime
 (
-    const amString &sensorID
+    const antSensorHandle &sensorID
 )
 {
     double result = 0;
@@ -4090,6 +5297,7 @@ void antProcessing::outputError
         case E_SOCKET_CREATE_FAIL:
         case E_SOCKET_SET_OPT_FAIL:
         case E_LOOP_BACK_IP_ADDRESS:
+        case E_THREAD_CREATE_FAIL:
         case E_SOCKET_BIND_FAIL:
         case E_READ_ERROR:
         case E_READ_FILE_NOT_OPEN:
@@ -4155,22 +5363,68 @@ void antProcessing::help
         outputMessage << indent;
         outputMessage << "-";
         outputMessage << option;
-        outputMessage << ": Read from stdin.";
+        outputMessage << ": Read from stdin.";
+        outputMessage << "\n";
+    }
+
+    option = "2";
+    if ( validOptions.contains( option ) )
+    {
+        outputMessage << indent;
+        outputMessage << "-";
+        outputMessage << option;
+        outputMessage << ": Write to stdout.";
+        outputMessage << indent2;
+        outputMessage << programName;
+        outputMessage << " writes to stdout by default.";
+        outputMessage << indent2;
+        outputMessage << "Note: This option only applies with option '-m' to create output to both multicast and stdout.";
+        outputMessage << "\n";
+    }
+
+    option = "a";
+    if ( validOptions.contains( option ) )
+    {
+        outputMessage << indent;
+        outputMessage << "-";
+        outputMessage << option;
+        outputMessage << " <time_stamp>: Only output the packets of a capture file (option '-i') received at or after <time_stamp>.";
+        outputMessage << indent2;
+        outputMessage << "Time stamps are seconds since 1970 as in the output (in test mode the packet counter / 10).";
+        outputMessage << "\n";
+    }
+
+    option = "A";
+    if ( validOptions.contains( option ) )
+    {
+        outputMessage << indent;
+        outputMessage << "-";
+        outputMessage << option;
+        outputMessage << " <seconds>: Forget the state of a sensor (event counts, totals, previous values) when no packet of it";
+        outputMessage << indent2;
+        outputMessage << "was received for <seconds> seconds. The sensors of the device file (option '-d') are kept.";
+        outputMessage << indent2;
+        outputMessage << "Default: <seconds> = ";
+        outputMessage << C_DEFAULT_SENSOR_IDLE_SECONDS;
+        outputMessage << " (keep all sensors).";
         outputMessage << "\n";
     }
 
-    option = "2";
+    option = "b";
     if ( validOptions.contains( option ) )
     {
         outputMessage << indent;
         outputMessage << "-";
         outputMessage << option;
-        outputMessage << ": Write to stdout.";
+        outputMessage << " <bytes>: Set the size of the receive buffer for multicast input to <bytes>.";
         outputMessage << indent2;
-        outputMessage << programName;
-        outputMessage << " writes to stdout by default.";
+        outputMessage << "A larger buffer lets bursts from several bridges queue up instead of being dropped by the kernel.";
         outputMessage << indent2;
-        outputMessage << "Note: This option only applies with option '-m' to create output to both multicast and stdout.";
+        outputMessage << "Dropped packets are reported on stderr.";
+        outputMessage << indent2;
+        outputMessage << "Default: <bytes> = ";
+        outputMessage << C_DEFAULT_RECEIVE_BUFFER_SIZE;
+        outputMessage << " (system default).";
         outputMessage << "\n";
     }
 
@@ -4184,6 +5438,40 @@ void antProcessing::help
         outputMessage << "\n";
     }
 
+    option = "c";
+    if ( validOptions.contains( option ) )
+    {
+        outputMessage << indent;
+        outputMessage << "-";
+        outputMessage << option;
+        outputMessage << " <bytes>[,<ms>]: Pack several output records into one multicast datagram of at most <bytes> bytes (see option '-m').";
+        outputMessage << indent2;
+        outputMessage << "Records are separated by new lines and never split. A record is sent at the latest <ms> milliseconds after it was created.";
+        outputMessage << indent2;
+        outputMessage << "Receivers split the datagrams at the new lines (e.g. when reading semi-cooked data with options '-s' and '-M').";
+        outputMessage << indent2;
+        outputMessage << "Default: No coalescing (one record per datagram), <ms> = ";
+        outputMessage << C_DEFAULT_MC_COALESCE_DELAY_MS;
+        outputMessage << ". A good value for <bytes> on Ethernet is 1472.";
+        outputMessage << "\n";
+    }
+
+    option = "C";
+    if ( validOptions.contains( option ) )
+    {
+        outputMessage << indent;
+        outputMessage << "-";
+        outputMessage << option;
+        outputMessage << " <capture_file>: Also write the ANT+ packets read, with their receive times, to the capture file \"<capture_file>\".";
+        outputMessage << indent2;
+        outputMessage << "The packets are stored in blocks followed by an index of the sensors and receive times, so a capture";
+        outputMessage << indent2;
+        outputMessage << "can be read back (option '-i') for some sensors (option '-n') or a time range (options '-a' and '-z')";
+        outputMessage << indent2;
+        outputMessage << "without decoding all of it. Not available for semi-cooked (option '-s') or binary (option '-e') input.";
+        outputMessage << "\n";
+    }
+
     option = "d";
     if ( validOptions.contains( option ) )
     {
@@ -4215,6 +5503,36 @@ void antProcessing::help
         outputMessage << "\n";
     }
 
+    option = "e";
+    if ( validOptions.contains( option ) )
+    {
+        outputMessage << indent;
+        outputMessage << "-";
+        outputMessage << option;
+        outputMessage << ": Input data are binary (written with option '-E'): output them as text or JSON objects.";
+        outputMessage << indent2;
+        outputMessage << "Note: Binary input is read from a file (option '-f') or from stdin (option '-1'). Semi-cooked input is output semi-cooked.";
+        outputMessage << indent2;
+        outputMessage << "      Input written with option '-J' must be read with option '-J', other input without it.";
+        outputMessage << "\n";
+    }
+
+    option = "E";
+    if ( validOptions.contains( option ) )
+    {
+        outputMessage << indent;
+        outputMessage << "-";
+        outputMessage << option;
+        outputMessage << ": Output data in binary form: a record per data page with variable length integers and time stamps";
+        outputMessage << indent2;
+        outputMessage << "in microseconds, about a quarter of the size of the text output (see ant_binary_format.h).";
+        outputMessage << indent2;
+        outputMessage << "All data pages are decoded into records (see ant_records.h), the other output (bridge information,";
+        outputMessage << indent2;
+        outputMessage << "unknown packets, ...) is written in text blocks (format as selected by the other options).";
+        outputMessage << "\n";
+    }
+
     option = "f";
     if ( validOptions.contains( option ) )
     {
@@ -4225,6 +5543,28 @@ void antProcessing::help
         outputMessage << "\n";
     }
 
+    option = "G";
+    if ( validOptions.contains( option ) )
+    {
+        outputMessage << indent;
+        outputMessage << "-";
+        outputMessage << option;
+        outputMessage << " <seconds>[,mark]: Count the gaps in the sequence numbers of the messages of every bridge (by sender address";
+        outputMessage << indent2;
+        outputMessage << "for multicast input, by continuity of the sequence for files and stdin) and output a record per bridge";
+        outputMessage << indent2;
+        outputMessage << "with the lost, reordered and duplicate packets and the loss rates every <seconds> seconds and at the end";
+        outputMessage << indent2;
+        outputMessage << "(\"";
+        outputMessage << C_SEQUENCE_MESSAGE_ID;
+        outputMessage << "<bridge>\", not with raw or binary output). With \"mark\", records which follow a gap get a field";
+        outputMessage << indent2;
+        outputMessage << "\"";
+        outputMessage << C_SEQUENCE_GAP_SYMBOL;
+        outputMessage << "\" (JSON: \"sequence gap\"): their delta values may span lost packets. <seconds> = 0: Only at the end.";
+        outputMessage << "\n";
+    }
+
     option = "H";
     if ( validOptions.contains( option ) )
     {
@@ -4272,6 +5612,18 @@ void antProcessing::help
         outputMessage << "\n";
     }
 
+    option = "i";
+    if ( validOptions.contains( option ) )
+    {
+        outputMessage << indent;
+        outputMessage << "-";
+        outputMessage << option;
+        outputMessage << ": The input file (option '-f') is a capture file written with option '-C'.";
+        outputMessage << indent2;
+        outputMessage << "The packets are decoded with the receive times stored in the capture.";
+        outputMessage << "\n";
+    }
+
     option = "J";
     if ( validOptions.contains( option ) )
     {
@@ -4282,6 +5634,74 @@ void antProcessing::help
         outputMessage << "\n";
     }
 
+    option = "j";
+    if ( validOptions.contains( option ) )
+    {
+        outputMessage << indent;
+        outputMessage << "-";
+        outputMessage << option;
+        outputMessage << " <threads>: Decode the input with <threads> threads (1 to ";
+        outputMessage << C_MAX_DECODE_THREADS;
+        outputMessage << ").";
+        outputMessage << indent2;
+        outputMessage << "The packets of a device are always decoded by the same thread, the output keeps the order of the input.";
+        outputMessage << indent2;
+        outputMessage << "A semi-cooked input file (options '-s' and '-f') is decoded in chunks of the file by all threads.";
+        outputMessage << indent2;
+        outputMessage << "Default: <threads> = ";
+        outputMessage << C_DEFAULT_DECODE_THREADS;
+        outputMessage << " (decode in the reading thread).";
+        outputMessage << "\n";
+    }
+
+    option = "k";
+    if ( validOptions.contains( option ) )
+    {
+        outputMessage << indent;
+        outputMessage << "-";
+        outputMessage << option;
+        outputMessage << " <state_file>: Restore the state of the sensors (event counts, totals, previous values) from the file";
+        outputMessage << indent2;
+        outputMessage << "\"<state_file>\" at start, if it exists, and save it there every few seconds (see option '-K') and at the end.";
+        outputMessage << indent2;
+        outputMessage << "After a restart the first packets of a sensor are then decoded against the values of the previous run.";
+        outputMessage << indent2;
+        outputMessage << "The file is replaced as a whole (written to \"<state_file>.tmp\" first), the configuration from the device";
+        outputMessage << indent2;
+        outputMessage << "file (option '-d') is not saved.";
+        outputMessage << "\n";
+    }
+
+    option = "K";
+    if ( validOptions.contains( option ) )
+    {
+        outputMessage << indent;
+        outputMessage << "-";
+        outputMessage << option;
+        outputMessage << " <seconds>: Save the state of the sensors (option '-k') every <seconds> seconds of receive time.";
+        outputMessage << indent2;
+        outputMessage << "Default: <seconds> = ";
+        outputMessage << C_DEFAULT_CHECKPOINT_SECONDS;
+        outputMessage << ".";
+        outputMessage << "\n";
+    }
+
+    option = "L";
+    if ( validOptions.contains( option ) )
+    {
+        outputMessage << indent;
+        outputMessage << "-";
+        outputMessage << option;
+        outputMessage << " <max_sensors>: Keep the state of at most <max_sensors> sensors: when a new sensor would exceed the limit,";
+        outputMessage << indent2;
+        outputMessage << "the sensors received least recently are forgotten. The sensors of the device file (option '-d') are kept.";
+        outputMessage << indent2;
+        outputMessage << "Default: <max_sensors> = ";
+        outputMessage << C_DEFAULT_MAX_SENSORS;
+        outputMessage << " (no limit).";
+        outputMessage << "\n";
+    }
+
     option = "m";
     if ( validOptions.contains( option ) )
     {
@@ -4320,6 +5740,50 @@ void antProcessing::help
         outputMessage << "\n";
     }
 
+    option = "n";
+    if ( validOptions.contains( option ) )
+    {
+        outputMessage << indent;
+        outputMessage << "-";
+        outputMessage << option;
+        outputMessage << " <sensor>: Only output the packets of <sensor> from a capture file (option '-i'). The option can be repeated.";
+        outputMessage << indent2;
+        outputMessage << "<sensor> is <device_type>:<device_id> (both numbers), or a device ID or sensor ID of the output (e.g. \"PWRB10_442\")";
+        outputMessage << indent2;
+        outputMessage << "which select the device ID for all device types.";
+        outputMessage << "\n";
+    }
+
+    option = "o";
+    if ( validOptions.contains( option ) )
+    {
+        outputMessage << indent;
+        outputMessage << "-";
+        outputMessage << option;
+        outputMessage << " <policy>: Set when output to stdout is flushed. <policy> is a comma separated list of";
+        outputMessage << indent2;
+        outputMessage << "    bytes=<n>   : Flush when <n> bytes are pending (0: flush every record).";
+        outputMessage << indent2;
+        outputMessage << "    records=<n> : Flush after <n> records (0: no limit).";
+        outputMessage << indent2;
+        outputMessage << "    ms=<n>      : Flush when the oldest pending record is <n> milliseconds old (0: no limit).";
+        outputMessage << indent2;
+        outputMessage << "    idle|noidle : Flush (or not) whenever no more input is waiting.";
+        outputMessage << indent2;
+        outputMessage << "    thread      : Write to stdout from a separate thread so a slow consumer does not hold up the input.";
+        outputMessage << indent2;
+        outputMessage << "Default: <policy> = \"bytes=";
+        outputMessage << C_DEFAULT_OUTPUT_BUFFER_SIZE;
+        outputMessage << ",records=";
+        outputMessage << C_DEFAULT_OUTPUT_MAX_RECORDS;
+        outputMessage << ",ms=";
+        outputMessage << C_DEFAULT_OUTPUT_MAX_DELAY_MS;
+        outputMessage << ( C_DEFAULT_OUTPUT_FLUSH_ON_IDLE ? ",idle" : ",noidle" );
+        outputMessage << ( C_DEFAULT_OUTPUT_USE_THREAD ? ",thread" : "" );
+        outputMessage << "\".";
+        outputMessage << "\n";
+    }
+
     option = "p";
     if ( validOptions.contains( option ) )
     {
@@ -4349,6 +5813,22 @@ void antProcessing::help
         outputMessage << ".\n";
     }
 
+    option = "Q";
+    if ( validOptions.contains( option ) )
+    {
+        outputMessage << indent;
+        outputMessage << "-";
+        outputMessage << option;
+        outputMessage << " <counters_file>: Count CPU cycles, instructions, branch misses and cache misses (perf_event_open) of the packet";
+        outputMessage << indent2;
+        outputMessage << "path per device type and write them, with the packets and the output mode, to the file \"<counters_file>\"";
+        outputMessage << indent2;
+        outputMessage << "at the end (a JSON object). Without hardware counters (e.g. in containers) only the packets are counted.";
+        outputMessage << indent2;
+        outputMessage << "Note: The counters are read before and after every packet, which costs two system calls per packet.";
+        outputMessage << "\n";
+    }
+
     option = "r";
     if ( validOptions.contains( option ) )
     {
@@ -4379,7 +5859,7 @@ void antProcessing::help
         outputMessage << option;
         outputMessage << ": Input data are 'semi-cooked'.";
         outputMessage << indent2;
-        outputMessage << "Note: This option only applies when options '-1' (read from stdin) or '-f' (read from file) are present.";
+        outputMessage << "Note: When reading from multicast a datagram may hold several records (one per line, see option '-c').";
         outputMessage << "\n";
     }
 
@@ -4461,6 +5941,20 @@ void antProcessing::help
         outputMessage << "\n";
     }
 
+    option = "W";
+    if ( validOptions.contains( option ) )
+    {
+        outputMessage << indent;
+        outputMessage << "-";
+        outputMessage << option;
+        outputMessage << ": Reload the device file (option '-d') when it is written or replaced, and on SIGHUP.";
+        outputMessage << indent2;
+        outputMessage << "The values of the new file replace those of the old one, the sensors keep their running state.";
+        outputMessage << indent2;
+        outputMessage << "Included files (AM_INCLUDE) are read again with the device file, only SIGHUP reloads after they changed.";
+        outputMessage << "\n";
+    }
+
     option = "x";
     if ( validOptions.contains( option ) )
     {
@@ -4475,6 +5969,38 @@ void antProcessing::help
         outputMessage << "\n";
     }
 
+    option = "Y";
+    if ( validOptions.contains( option ) )
+    {
+        outputMessage << indent;
+        outputMessage << "-";
+        outputMessage << option;
+        outputMessage << " <stats_file>[,<seconds>]: Append run time statistics to the file \"<stats_file>\" every <seconds> seconds,";
+        outputMessage << indent2;
+        outputMessage << "on SIGUSR1 and at the end: a JSON object per line with the time histograms of the stages of the packet";
+        outputMessage << indent2;
+        outputMessage << "path (read, frame, decode, format, output, packet) and the packets per device type and data page, unknown";
+        outputMessage << indent2;
+        outputMessage << "device types and data pages, packets of unregistered sensors (option '-R') and roll overs.";
+        outputMessage << indent2;
+        outputMessage << "Default: <seconds> = ";
+        outputMessage << C_DEFAULT_STATS_INTERVAL_SECONDS;
+        outputMessage << " (only on SIGUSR1 and at the end).";
+        outputMessage << "\n";
+    }
+
+    option = "z";
+    if ( validOptions.contains( option ) )
+    {
+        outputMessage << indent;
+        outputMessage << "-";
+        outputMessage << option;
+        outputMessage << " <time_stamp>: Only output the packets of a capture file (option '-i') received at or before <time_stamp>.";
+        outputMessage << indent2;
+        outputMessage << "See option '-a'.";
+        outputMessage << "\n";
+    }
+
     std::cout << outputMessage.str() << std::endl;
 }
 
@@ -7096,8 +8622,11 @@ bool antProcessing::processArguments
     std::vector<amString> labels;
     amString              thisLabel;
 
-    programName  = programNameIn;
-    validOptions = validOptionsIn;
+    programName    = programNameIn;
+    validOptions   = validOptionsIn;
+    deviceTypeName = deviceType;
+    argCount       = argc;
+    argValues      = argv;
 
     resetAll();
 
@@ -7116,12 +8645,62 @@ bool antProcessing::processArguments
             case '2':
                  setWriteStdout( true );
                  break;
+            case 'a':
+                 if ( !captureSelection.setFrom( optarg ) )
+                 {
+                     running   = false;
+                     errorCode = E_BAD_PARAMETER_VALUE;
+                     appendErrorMessage( "Invalid time stamp \"" );
+                     appendErrorMessage( optarg );
+                     appendErrorMessage( "\".\n" );
+                 }
+                 ++counter;
+                 break;
+            case 'A':
+                 intArg = atoi( optarg );
+                 if ( intArg < 0 )
+                 {
+                     running   = false;
+                     errorCode = E_BAD_PARAMETER_VALUE;
+                     appendErrorMessage( "Invalid number of seconds before an idle sensor is forgotten \"" );
+                     appendErrorMessage( optarg );
+                     appendErrorMessage( "\".\n" );
+                 }
+                 setSensorIdleSeconds( intArg );
+                 ++counter;
+                 break;
+            case 'b':
+                 intArg = atoi( optarg );
+                 setReceiveBufferSize( intArg );
+                 ++counter;
+                 break;
             case 'B':
                  setOutputBridge( true );
                  break;
+            case 'c':
+                 if ( !setCoalescing( optarg ) )
+                 {
+                     running   = false;
+                     errorCode = E_BAD_PARAMETER_VALUE;
+                     appendErrorMessage( "Invalid multicast output coalescing \"" );
+                     appendErrorMessage( optarg );
+                     appendErrorMessage( "\".\n" );
+                 }
+                 ++counter;
+                 break;
+            case 'C':
+                 setCaptureFileName( optarg );
+                 ++counter;
+                 break;
             case 'D':
                  setDiagnostics( true );
                  break;
+            case 'E':
+                 setBinaryOut( true );
+                 break;
+            case 'e':
+                 setBinaryIn( true );
+                 break;
             case 'd':
                  ++counter;
                  setDeviceFileName( optarg );
@@ -7131,6 +8710,17 @@ bool antProcessing::processArguments
                  setInputFileName( optarg );
                  ++counter;
                  break;
+            case 'G':
+                 if ( !setSequenceTracking( optarg ) )
+                 {
+                     running   = false;
+                     errorCode = E_BAD_PARAMETER_VALUE;
+                     appendErrorMessage( "Invalid sequence gap tracking \"" );
+                     appendErrorMessage( optarg );
+                     appendErrorMessage( "\".\n" );
+                 }
+                 ++counter;
+                 break;
             case 'H':
                  if ( validOptions.contains( "H:" ) )
                  {
@@ -7151,13 +8741,59 @@ bool antProcessing::processArguments
                  setInterface( optarg );
                  ++counter;
                  break;
+            case 'i':
+                 setCaptureIn( true );
+                 break;
             case 'J':
                  setOutputAsJSON( true );
                  break;
+            case 'j':
+                 intArg = atoi( optarg );
+                 if ( ( intArg < 1 ) || ( intArg > C_MAX_DECODE_THREADS ) )
+                 {
+                     running   = false;
+                     errorCode = E_BAD_PARAMETER_VALUE;
+                     appendErrorMessage( "Invalid number of decode threads \"" );
+                     appendErrorMessage( optarg );
+                     appendErrorMessage( "\".\n" );
+                 }
+                 setDecodeThreads( intArg );
+                 ++counter;
+                 break;
+            case 'k':
+                 setStateFileName( optarg );
+                 ++counter;
+                 break;
+            case 'K':
+                 intArg = atoi( optarg );
+                 if ( intArg < 1 )
+                 {
+                     running   = false;
+                     errorCode = E_BAD_PARAMETER_VALUE;
+                     appendErrorMessage( "Invalid number of seconds between sensor state checkpoints \"" );
+                     appendErrorMessage( optarg );
+                     appendErrorMessage( "\".\n" );
+                 }
+                 setCheckpointSeconds( intArg );
+                 ++counter;
+                 break;
             case 'l':
                  labels.push_back( optarg );
                  ++counter;
                  break;
+            case 'L':
+                 intArg = atoi( optarg );
+                 if ( intArg < 0 )
+                 {
+                     running   = false;
+                     errorCode = E_BAD_PARAMETER_VALUE;
+                     appendErrorMessage( "Invalid maximum number of sensors \"" );
+                     appendErrorMessage( optarg );
+                     appendErrorMessage( "\".\n" );
+                 }
+                 setMaxSensors( intArg );
+                 ++counter;
+                 break;
             case 'M':
                  setMCAddressIn( optarg );
                  ++counter;
@@ -7168,6 +8804,28 @@ bool antProcessing::processArguments
                  ++counter;
                  outPort = true;
                  break;
+            case 'n':
+                 if ( !captureSelection.addSensor( optarg ) )
+                 {
+                     running   = false;
+                     errorCode = E_BAD_PARAMETER_VALUE;
+                     appendErrorMessage( "Invalid sensor \"" );
+                     appendErrorMessage( optarg );
+                     appendErrorMessage( "\".\n" );
+                 }
+                 ++counter;
+                 break;
+            case 'o':
+                 if ( !setOutputPolicy( optarg ) )
+                 {
+                     running   = false;
+                     errorCode = E_BAD_PARAMETER_VALUE;
+                     appendErrorMessage( "Invalid output policy \"" );
+                     appendErrorMessage( optarg );
+                     appendErrorMessage( "\".\n" );
+                 }
+                 ++counter;
+                 break;
             case 'P':
                  intArg = atoi( optarg );
                  setValuePrecision( intArg );
@@ -7185,6 +8843,10 @@ bool antProcessing::processArguments
                  }
                  ++counter;
                  break;
+            case 'Q':
+                 setPerfCountersFileName( optarg );
+                 ++counter;
+                 break;
             case 'R':
                  setOnlyRegisteredDevices( true );
                  break;
@@ -7221,9 +8883,34 @@ bool antProcessing::processArguments
             case 'w':
                  setExitOnWarnings( true );
                  break;
+            case 'W':
+                 setWatchDeviceFile( true );
+                 break;
             case 'x':
                  setTestMode( true );
                  break;
+            case 'Y':
+                 if ( !setStatsOutput( optarg ) )
+                 {
+                     running   = false;
+                     errorCode = E_BAD_PARAMETER_VALUE;
+                     appendErrorMessage( "Invalid statistics output \"" );
+                     appendErrorMessage( optarg );
+                     appendErrorMessage( "\".\n" );
+                 }
+                 ++counter;
+                 break;
+            case 'z':
+                 if ( !captureSelection.setTo( optarg ) )
+                 {
+                     running   = false;
+                     errorCode = E_BAD_PARAMETER_VALUE;
+                     appendErrorMessage( "Invalid time stamp \"" );
+                     appendErrorMessage( optarg );
+                     appendErrorMessage( "\".\n" );
+                 }
+                 ++counter;
+                 break;
             case '?':
                  running = false;
                  if ( strcmp( argv[ counter ], "-H" ) == 0 )
@@ -7288,6 +8975,31 @@ bool antProcessing::processArguments
             {
                 errorCode = E_MC_NO_INTERFACE;
             }
+            if ( binaryIn )
+            {
+                errorCode = E_BAD_OPTION;
+                appendErrorMessage( "Binary input (option '-e') is read from a file (option '-f') or from stdin (option '-1').\n" );
+            }
+        }
+        if ( captureIn && !readFile )
+        {
+            errorCode = E_BAD_OPTION;
+            appendErrorMessage( "A capture file (option '-i') is read from a file (option '-f').\n" );
+        }
+        if ( ( captureIn || !captureFileName.empty() ) && ( semiCookedIn || binaryIn ) )
+        {
+            errorCode = E_BAD_OPTION;
+            appendErrorMessage( "Capture files (options '-C' and '-i') hold ANT+ packets, not semi-cooked (option '-s') or binary (option '-e') data.\n" );
+        }
+        if ( !captureIn && !captureSelection.isEmpty() )
+        {
+            errorCode = E_BAD_OPTION;
+            appendErrorMessage( "Options '-n', '-a' and '-z' select the packets of a capture file (option '-i').\n" );
+        }
+        if ( watchDeviceFile && deviceFileName.empty() )
+        {
+            errorCode = E_BAD_OPTION;
+            appendErrorMessage( "Option '-W' reloads the device file (option '-d').\n" );
         }
     }
 
@@ -7316,6 +9028,11 @@ bool antProcessing::processArguments
             // Make sure that the output goes somewhere....
             setWriteStdout( true );
         }
+        if ( binaryOut && !outputRaw )
+        {
+            setOutputText( false );
+            addRecordSink( &binaryFormatter );
+        }
     }
 
     return running;
@@ -7,13 +7,24 @@
 
 #include <am_multicast_read.h>
 #include <am_multicast_write.h>
+#include <am_output_writer.h>
 
 #include "ant_constants.h"
 #include "am_string.h"
+#include "ant_sensor_state.h"
+#include "ant_record_formatter.h"
+#include "ant_binary_format.h"
+#include "ant_capture_file.h"
+#include "ant_state_checkpoint.h"
+#include "ant_device_file_watcher.h"
+#include "ant_stage_stats.h"
+#include "ant_perf_counters.h"
+#include "ant_sequence_tracker.h"
 
 class amSplitString;
+class antDecodePipeline;
 
-class antProcessing
+class antProcessing : virtual public antSensorStateStore
 {
 
     private:
@@ -23,8 +34,18 @@ class antProcessing
         bool writeStdout;
         bool semiCookedIn;
         bool outputRaw;
+        bool binaryIn;
+        bool binaryOut;
+        bool captureIn;
+        bool watchDeviceFile;
         bool onlyRegisteredDevices;
         bool exitOnWarnings;
+        bool isDecodeWorker;
+        bool hasFrameTime;
+        bool unregisteredSeen;
+        bool trackSequences;
+        bool markSequenceGaps;
+        bool followsGap;
 
         int testCounter;
         int timePrecision;
@@ -32,6 +53,27 @@ class antProcessing
         int mcPortNoIn;
         int mcPortNoOut;
         int timeOutSec;
+        int receiveBufferSize;
+        int decodeThreads;
+        int checkpointSeconds;
+        int sensorIdleSeconds;
+        int maxSensors;
+        int statsIntervalSeconds;
+        int sequenceIntervalSeconds;
+        int perfDeviceType;                       // Device type of the packet counted (option '-Q').
+        int argCount;
+
+        unsigned int deviceFileGeneration;
+        unsigned int frameSender;
+
+        unsigned long long frameGapTag;
+
+        char **argValues;
+
+        long long frameTime;
+        long long nextCheckpointTime;
+        long long nextEvictionTime;
+        long long nextSequenceReport;
 
         amString programName;
         amString validOptions;
@@ -44,26 +86,87 @@ class antProcessing
         amString mcAddressOut;
         amString interface;
         amString inputFileName;
+        amString captureFileName;
+        amString stateFileName;
+        amString statsFileName;
+        amString perfCountersFileName;
         amString currentDeviceType;
         amString b2tVersion;
+        amString deviceTypeName;
+        amString decodedRecord;
+        amString binaryBuffer;
+        amString *capturedOutput;
 
-        std::vector<amString>            supportedSensorTypes;
-        std::map<amString, bool>         registeredDevices;
-        std::map<amString, unsigned int> zeroTimeCountTable;
+        std::vector<amString> supportedSensorTypes;
 
         amMulticastRead  multicastRead;
         amMulticastWrite multicastWrite;
+        amOutputWriter   outputWriter;
+
+        antCaptureWriter    captureWriter;
+        antCaptureSelection captureSelection;
+        antStateCheckpoint  stateCheckpoint;
+
+        antDeviceFileWatcher  deviceFileWatcher;
+        antDeviceFileWatcher *deviceFileSource;   // Watcher of the owner (decode threads) or own one.
+
+        antStageStatsDump  stageStatsDump;
+        antStageStatsDump *stageStatsSource;      // Statistics of the owner (decode threads) or own ones.
+        antStageStats     *stageStats;            // Counters of this thread, NULL without statistics.
+
+        antPerfCounterSet  perfCounterSet;
+        antPerfCounterSet *perfCounterSource;     // Hardware counters of the owner (decode threads) or own ones.
+        antPerfCounters   *perfCounters;          // Hardware counters of this thread, NULL without option '-Q'.
+
+        antSequenceTracker                          sequenceTracker;
+        std::map<unsigned int, unsigned long long>  sensorGapTags;   // Gap tag (see antSequenceTracker) of the last packet of each sensor.
+
+        antDecodePipeline *pipeline;
+
+        antSemiCookedFormatter            semiCookedFormatter;
+        antCookedFormatter                cookedFormatter;
+        antJSONFormatter                  jsonFormatter;
+        antBinaryFormatter                binaryFormatter;
+        std::vector<antRecordFormatter *> recordSinks;
+        bool                              outputText;
 
         int readSemiCookedSingleLineFromStream( std::istream &inStream );
         int readAntSingleLineFromStream       ( std::istream &inStream );
         int readAntFromStream   ( std::istream &inStream );
+        int readAntFromBuffer   ( const BYTE *buffer, size_t bufferSize );
+        int readAntFromFile     ( bool &fileMapped );
         int ant2txtLine         ( const BYTE *line, int nbBytes );
         int readAntFromMultiCast( void );
+        int readBinaryFromStream( std::istream &inStream );
+        int readAntFromCapture  ( void );
+        int processSemiCookedLine    ( const char *line );
+        int processSemiCookedDatagram( char *datagram, size_t nbBytes );
         int outputData          ( void );
+        int outputBinaryData    ( void );
+        int writeOutput         ( const amString &text, bool asRecord, int resultCode, amString &message );
+        int readDeviceFile      ( void );
+        int startDecodePipeline ( void );
+        int restoreSensorStates ( unsigned int workerNo, unsigned int nbWorkers );
+        void checkpointSensorStates( long long now );
+        void snapshotSensorStates  ( bool last );
+        void evictSensors          ( long long now );
+        void reloadDeviceFile      ( void );
+        void trackSequence         ( const BYTE *line, int nbBytes, long long receiveTime );
+        void writeSequenceRecords  ( long long now );
+        bool sensorFollowsGap      ( int deviceType, int deviceID );
+        void writePerfCounters     ( void );
+        const char *getOutputModeName( void ) const;
 
         void appendDiagnosticsItemName( const amString &itemName );
         void appendDiagnosticsField   ( const amString &fieldName);
 
+        template <class recordT> void outputRecord
+                                      (
+                                          const antRecordContext &context,
+                                          const recordT          &record,
+                                          void ( antRecordFormatter::*format )( const antRecordContext &, const recordT & )
+                                      );
+
 
     protected:
 
@@ -74,14 +177,16 @@ class antProcessing
         bool outputAsJSON;
         bool outputUnknown;
 
-        std::map<amString, unsigned int> eventTimeTable;
-        std::map<amString, unsigned int> eventCountTable;
-        std::map<amString, unsigned int> totalTimeIntTable;
-        std::map<amString, unsigned int> totalCountTable;
-        std::map<amString, unsigned int> operatingTimeTable;
-        std::map<amString, unsigned int> sameEventCountTable;
-        std::map<amString, double>       totalTimeTable;
-        std::map<amString, double>       totalOperatingTimeTable;
+        antSensorField<bool>         registeredDevices;
+        antSensorField<unsigned int> zeroTimeCountTable;
+        antSensorField<unsigned int> eventTimeTable;
+        antSensorField<unsigned int> eventCountTable;
+        antSensorField<unsigned int> totalTimeIntTable;
+        antSensorField<unsigned int> totalCountTable;
+        antSensorField<unsigned int> operatingTimeTable;
+        antSensorField<unsigned int> sameEventCountTable;
+        antSensorField<double>       totalTimeTable;
+        antSensorField<double>       totalOperatingTimeTable;
 
         inline amString getCurrentDeviceType( void ) const { return currentDeviceType; }
         inline void  setCurrentDeviceType( const amString &value) { currentDeviceType = value; }
@@ -100,87 +205,86 @@ class antProcessing
         void readDeviceFileStream( std::ifstream &deviceFileStream );
         virtual void readDeviceFileLine( const char *line ) {}
 
-        double getUnixTime( void );
+        long long getUnixTime( void );
+        long long getFrameTime( void );
+        long long getSemiCookedTime( const char *line );
         void getUnixTimeAsString( amString &timeStampBuffer );
-        void getUnixTimeAsString( amString &timeStampBuffer, double subSecondTimer );
-        void setZeroTimeCount( const amString &sensorID, unsigned int value );
-        unsigned int getZeroTimeCount( const amString &sensorID );
+        void getUnixTimeAsString( amString &timeStampBuffer, long long microseconds );
+        void setZeroTimeCount( const antSensorHandle &sensorID, unsigned int value );
+        unsigned int getZeroTimeCount( const antSensorHandle &sensorID );
 
-        bool createCommonResultStringPage67
+        bool outputCommonPage67Record
              (
-                 const amString &sensorID,
-                 bool            outputPageNo,
-                 unsigned int    value1,
-                 unsigned int    value2,
-                 unsigned int    value3,
-                 unsigned int    value4,
-                 unsigned int    value5
+                 const antRecordContext &context,
+                 bool                    outputPageNo,
+                 unsigned int            value1,
+                 unsigned int            value2,
+                 unsigned int            value3,
+                 unsigned int            value4,
+                 unsigned int            value5
              );
-        bool createCommonResultStringPage68( const amString &sensorID, bool outputPageNo, unsigned int value1, unsigned int value2, unsigned int value3, unsigned int value4 );
-        bool createCommonResultStringPage70
+        bool outputCommonPage68Record( const antRecordContext &context, bool outputPageNo, unsigned int value1, unsigned int value2, unsigned int value3, unsigned int value4 );
+        bool outputCommonPage70Record
              (
-                 const amString &sensorID,
-                 bool            outputPageNo,
-                 unsigned int    descriptor1,
-                 unsigned int    descriptor2,
-                 unsigned int    requestedResponse,
-                 unsigned int    requestedPageNo,
-                 unsigned int    commandType
+                 const antRecordContext &context,
+                 bool                    outputPageNo,
+                 unsigned int            descriptor1,
+                 unsigned int            descriptor2,
+                 unsigned int            requestedResponse,
+                 unsigned int            requestedPageNo,
+                 unsigned int            commandType
              );
-        bool createCommonResultStringPage80( const amString &sensorID, bool outputPageNo, unsigned int manufacturerID, unsigned int hardwareRevision, unsigned int modelNumber );
-        bool createCommonResultStringPage81( const amString &sensorID, bool outputPageNo, unsigned int serialNumber, unsigned int softwareRevision );
-        bool createCommonResultStringPage82
+        bool outputCommonPage80Record( const antRecordContext &context, bool outputPageNo, unsigned int manufacturerID, unsigned int hardwareRevision, unsigned int modelNumber );
+        bool outputCommonPage81Record( const antRecordContext &context, bool outputPageNo, unsigned int serialNumber, unsigned int softwareRevision );
+        bool outputCommonPage82Record
              (
-                 const amString &sensorID,
-                 bool            outputPageNo,
-                 unsigned int    voltage256,
-                 unsigned int    status,
-                 unsigned int    operatingTime,
-                 unsigned int    resolution,
-                 unsigned int    nbBatteries,
-                 unsigned int    batteryID
+                 const antRecordContext &context,
+                 bool                    outputPageNo,
+                 unsigned int            voltage256,
+                 unsigned int            status,
+                 unsigned int            operatingTime,
+                 unsigned int            resolution,
+                 unsigned int            nbBatteries,
+                 unsigned int            batteryID
              );
-        bool createCommonResultStringPage83
+        bool outputCommonPage83Record
              (
-                 const amString &sensorID,
-                 bool            outputPageNo,
-                 unsigned int    seconds,
-                 unsigned int    minutes,
-                 unsigned int    hours,
-                 unsigned int    weekDayNo,
-                 unsigned int    monthDay,
-                 unsigned int    month,
-                 unsigned int    year
+                 const antRecordContext &context,
+                 bool                    outputPageNo,
+                 unsigned int            seconds,
+                 unsigned int            minutes,
+                 unsigned int            hours,
+                 unsigned int            weekDayNo,
+                 unsigned int            monthDay,
+                 unsigned int            month,
+                 unsigned int            year
              );
-        bool createCommonResultStringPage84
+        bool outputCommonPage84Record
              (
-                 const amString &sensorID,
-                 bool            outputPageNo,
-                 unsigned int    subPage1,
-                 unsigned int    subPage2,
-                 unsigned int    dataField1,
-                 unsigned int    dataField2
+                 const antRecordContext &context,
+                 bool                    outputPageNo,
+                 unsigned int            subPage1,
+                 unsigned int            subPage2,
+                 unsigned int            dataField1,
+                 unsigned int            dataField2
              );
-        void createDataPage84SubPage( const amString &sensorID, unsigned int subPageNo, unsigned int subPage, unsigned int dataField );
-        bool createCommonResultStringUnsupportedPage( const amString &sensorID, unsigned int dataPage, const BYTE *payLoad );
-        bool createCommonResultStringUnsupportedPageSemiCooked( const amString &sensorID, unsigned int dataPage, const amSplitString &words, unsigned int startCounter );
-
-        bool getBatteryStatus( amString &status, int index, bool lowerCase = false );
+        bool outputUnsupportedPageRecord( const antRecordContext &context, unsigned int dataPage, const BYTE *payLoad );
+        bool outputUnsupportedPageRecordSemiCooked( const antRecordContext &context, unsigned int dataPage, const amSplitString &words, unsigned int startCounter );
 
         unsigned int getDeltaInt
                      (
-                         bool                             &rollOverHappened,
-                         const amString                   &sensorID,
-                         unsigned int                      rollOver,
-                         std::map<amString, unsigned int> &valueTable,
-                         unsigned int                      newValue
+                         bool                         &rollOverHappened,
+                         const antSensorHandle        &sensorID,
+                         unsigned int                  rollOver,
+                         antSensorField<unsigned int> &valueTable,
+                         unsigned int                  newValue
                      );
 
-        bool isRegisteredDevice( const amString & );
-        void registerDevice    ( const amString & );
+        bool isRegisteredDevice( const antSensorHandle & );
+        void registerDevice    ( const antSensorHandle & );
 
         bool isSupportedSensor    ( const amString &deviceID );
-        bool isSemiCookedFormat137( const amString &inputBuffer );
+        bool isSemiCookedFormat137( const amSplitString &words );
 
         // Error Message
         void appendErrorMessage( const amString &message );
@@ -229,15 +333,49 @@ class antProcessing
         void appendJSONItemConditional( const amString &itemName, bool condition, const amString &itemValueTrue, const amString &itemValueFalse );
         void appendJSONItem4Way( const amString &itemName, int condition, const amString &itemValue0, const amString &itemValue1, const amString &itemValue2, const amString &itemValue3 );
 
+        // Decoded records
+        antTextFormatter &getTextFormatter( void );
+        void outputRecord( const antRecordContext &context, const antHRMRecord &record );
+        void outputRecord( const antRecordContext &context, const antPowerB01Record &record );
+        void outputRecord( const antRecordContext &context, const antPowerB02Record &record );
+        void outputRecord( const antRecordContext &context, const antPowerB03Record &record );
+        void outputRecord( const antRecordContext &context, const antPowerB10Record &record );
+        void outputRecord( const antRecordContext &context, const antPowerB11Record &record );
+        void outputRecord( const antRecordContext &context, const antPowerB12Record &record );
+        void outputRecord( const antRecordContext &context, const antPowerB13Record &record );
+        void outputRecord( const antRecordContext &context, const antPowerB20Record &record );
+        void outputRecord( const antRecordContext &context, const antCommonPage67Record &record );
+        void outputRecord( const antRecordContext &context, const antCommonPage68Record &record );
+        void outputRecord( const antRecordContext &context, const antCommonPage70Record &record );
+        void outputRecord( const antRecordContext &context, const antCommonPage80Record &record );
+        void outputRecord( const antRecordContext &context, const antCommonPage81Record &record );
+        void outputRecord( const antRecordContext &context, const antCommonPage82Record &record );
+        void outputRecord( const antRecordContext &context, const antCommonPage83Record &record );
+        void outputRecord( const antRecordContext &context, const antCommonPage84Record &record );
+        void outputRecord( const antRecordContext &context, const antEnvironmentPage0Record &record );
+        void outputRecord( const antRecordContext &context, const antEnvironmentPage1Record &record );
+        void outputRecord( const antRecordContext &context, const antCadenceRecord &record );
+        void outputRecord( const antRecordContext &context, const antSpeedRecord &record );
+        void outputRecord( const antRecordContext &context, const antSpeedCadenceRecord &record );
+        void outputRecord( const antRecordContext &context, const antAeroRecord &record );
+        void outputRecord( const antRecordContext &context, const antWeightScaleRecord &record );
+        void outputRecord( const antRecordContext &context, const antAudioPage1Record &record );
+        void outputRecord( const antRecordContext &context, const antAudioPage16Record &record );
+        void outputRecord( const antRecordContext &context, const antStrideSpeedDistRecord &record );
+        void outputRecord( const antRecordContext &context, const antMultiSportRecord &record );
+        void outputRecord( const antRecordContext &context, const antUnsupportedPageRecord &record );
+        void outputRecord( int recordType, const antRecordContext &context, const antRecord &record );
+
         void createUnknownDeviceTypeString( int deviceType, int deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
         void createOutputHeader( const amString &sensorID, const amString &timeStampBuffer );
         void appendOutputFooter( const amString &versionString );
 
         amDeviceType processUndefinedSensorType( const amString &inputBuffer );
-        amDeviceType processUnsupportedDataPage( const amSplitString words );
+        amDeviceType processUnsupportedDataPage( const amSplitString &words );
 
-        bool processCommonPagesSemiCooked( const amSplitString &words, unsigned int startCounter, bool outputPageNo );
-        bool processCommonPages( const amString &sensorID, const BYTE payLoad[], bool outputPageNo );
+        // Common pages are output as complete records, without header and footer of the caller.
+        bool processCommonPagesSemiCooked( const amSplitString &words, unsigned int startCounter, const amString &versionString, bool outputPageNo );
+        bool processCommonPages( const amString &sensorID, const amString &timeStampBuffer, const amString &versionString, const BYTE payLoad[], bool outputPageNo );
 
         void resetAll( void );
 
@@ -245,7 +383,7 @@ class antProcessing
     public:
 
         antProcessing();
-        ~antProcessing() {}
+        virtual ~antProcessing() {}
 
         bool processArguments( const amString &programNameIn, const amString &validOptionsIn, const amString &deviceType, int argc, char *argv[] );
 
@@ -274,6 +412,39 @@ class antProcessing
         inline amString getInputFileName( void ) const     { return inputFileName; }
         inline void     setInputFileName( amString value ) { inputFileName = value; }
 
+        inline amString getCaptureFileName( void ) const     { return captureFileName; }
+        inline void     setCaptureFileName( amString value ) { captureFileName = value; }
+
+        inline amString getStateFileName( void ) const     { return stateFileName; }
+        inline void     setStateFileName( amString value ) { stateFileName = value; }
+
+        inline int  getCheckpointSeconds( void ) const { return checkpointSeconds; }
+        inline void setCheckpointSeconds( int value )  { checkpointSeconds = value; }
+
+        inline int  getSensorIdleSeconds( void ) const { return sensorIdleSeconds; }
+        inline void setSensorIdleSeconds( int value )  { sensorIdleSeconds = value; }
+
+        inline int  getMaxSensors( void ) const { return maxSensors; }
+        inline void setMaxSensors( int value )  { maxSensors = value; }
+
+        inline amString getStatsFileName( void ) const     { return statsFileName; }
+        inline void     setStatsFileName( amString value ) { statsFileName = value; }
+
+        inline int  getStatsIntervalSeconds( void ) const { return statsIntervalSeconds; }
+        inline void setStatsIntervalSeconds( int value )  { statsIntervalSeconds = value; }
+
+        inline amString getPerfCountersFileName( void ) const     { return perfCountersFileName; }
+        inline void     setPerfCountersFileName( amString value ) { perfCountersFileName = value; }
+
+        inline bool getTrackSequences( void ) const { return trackSequences; }
+        inline void setTrackSequences( bool value ) { trackSequences = value; }
+
+        inline bool getMarkSequenceGaps( void ) const { return markSequenceGaps; }
+        inline void setMarkSequenceGaps( bool value ) { markSequenceGaps = value; }
+
+        inline int  getSequenceIntervalSeconds( void ) const { return sequenceIntervalSeconds; }
+        inline void setSequenceIntervalSeconds( int value )  { sequenceIntervalSeconds = value; }
+
         inline int  getMCPortNoIn( void ) const { return mcPortNoIn; }
         inline void setMCPortNoIn( int value )  { mcPortNoIn = value; }
 
@@ -283,6 +454,17 @@ class antProcessing
         inline int  getTimeOutSec( void ) const { return timeOutSec; }
         inline void setTimeOutSec( int value )  { timeOutSec = value; }
 
+        inline int  getReceiveBufferSize( void ) const { return receiveBufferSize; }
+        inline void setReceiveBufferSize( int value )  { receiveBufferSize = value; }
+
+        bool setOutputPolicy( const amString &policy );
+        bool setCoalescing  ( const amString &coalescing );
+        bool setStatsOutput ( const amString &statsOutput );
+        bool setSequenceTracking( const amString &sequenceTracking );
+
+        inline int  getDecodeThreads( void ) const { return decodeThreads; }
+        inline void setDecodeThreads( int value )  { decodeThreads = value; }
+
         inline int getTimePrecision( void ) const { return timePrecision; }
         void       setTimePrecision( int );
 
@@ -301,9 +483,26 @@ class antProcessing
         inline bool getOutputAsJSON( void ) const { return outputAsJSON; }
         inline void setOutputAsJSON( bool value ) { outputAsJSON = value; }
 
+        // Records are also passed to the sinks; without text output they are not formatted at all.
+        inline void addRecordSink( antRecordFormatter *sink ) { recordSinks.push_back( sink ); }
+        inline bool getOutputText( void ) const { return outputText; }
+        inline void setOutputText( bool value ) { outputText = value; }
+
         inline bool getOutputRaw( void ) const { return outputRaw; }
         inline void setOutputRaw( bool value ) { outputRaw = value; }
 
+        inline bool getBinaryIn( void ) const { return binaryIn; }
+        inline void setBinaryIn( bool value ) { binaryIn = value; }
+
+        inline bool getBinaryOut( void ) const { return binaryOut; }
+        inline void setBinaryOut( bool value ) { binaryOut = value; }
+
+        inline bool getCaptureIn( void ) const { return captureIn; }
+        inline void setCaptureIn( bool value ) { captureIn = value; }
+
+        inline bool getWatchDeviceFile( void ) const { return watchDeviceFile; }
+        inline void setWatchDeviceFile( bool value ) { watchDeviceFile = value; }
+
         inline bool getOnlyRegisteredDevices( void ) const { return onlyRegisteredDevices; }
         inline void setOnlyRegisteredDevices( bool value ) { onlyRegisteredDevices = value; }
 
@@ -322,10 +521,10 @@ class antProcessing
         inline void setTestMode( bool value ) { testMode = value; }
         inline bool getTestMode( void ) const { return testMode; }
 
-        double getTotalOperationTime( const amString &sensorID );
-        void setTotalOperationTime( const amString &sensorID, double value );
+        double getTotalOperationTime( const antSensorHandle &sensorID );
+        void setTotalOperationTime( const antSensorHandle &sensorID, double value );
 
-        virtual amDeviceType processSensor( int deviceType, const amString &deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
+        virtual amDeviceType processSensor( int deviceType, unsigned int deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
         virtual amDeviceType processSensorSemiCooked( const amString &inputBuffer );
         amDeviceType         updateSensorSemiCooked ( const amString &inputBuffer );
 
@@ -344,9 +543,32 @@ class antProcessing
 
         void createPacketSaverString( const BYTE *line, int nbBytes, const amString &timeStampBuffer );
         void createUnknownPacketString( const BYTE *line, int nbBytes, const amString &timeStampBuffer );
+        void createSequenceString( unsigned int sourceNo, const amString &timeStampBuffer );
 
         int ant2txt( void );
 
+        // Parallel decoding (see antDecodePipeline and option '-j').
+        virtual antProcessing *createWorker( void ) const { return NULL; }
+        int configureWorker     ( const antProcessing &owner, unsigned int workerNo, unsigned int nbWorkers );
+        int decodeFrame         ( const BYTE *line, int nbBytes, long long receiveTime, amString &output, amString &message, unsigned long long gapTag = 0 );
+        int decodeSemiCookedLine( const char *line, amString &output, amString &message );
+        int decodeOutput        ( const amString &text, amString &output, amString &message );
+        int writeDecodedOutput  ( const char *decoded, size_t size, amString &message );
+        int flushIdleOutput     ( bool flushMulticast, amString &message );
+        int flushDueOutput      ( amString &message );
+
+        // Sensor state checkpoints (see antStateCheckpoint and option '-k').
+        inline antStateCheckpoint &getStateCheckpoint( void ) { return stateCheckpoint; }
+        inline void saveSensorStates( antStateCheckpoint &checkpoint, unsigned int snapshotNo ) { checkpoint.submit( snapshotNo, sensorStates ); }
+
+        // Sensor eviction (options '-A' and '-L'): the counters of a decode thread go to its owner.
+        inline void addSensorCounters( const antProcessing &worker ) { sensorStates.addCounters( worker.sensorStates.getCounters() ); }
+
+        // Embedding (see ant_decoder.h).
+        inline void setProgramName( const amString &value ) { programName = value; }
+        int loadDeviceFile( const amString &fileName, amString &message );
+        int addDevice     ( const char *line, amString &message );
+
 };
 
 #endif // __ANT_PROCESSING_H__
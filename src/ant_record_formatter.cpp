@@ -0,0 +1,3459 @@
+#include "ant_constants.h"
+#include "ant_record_formatter.h"
+
+const double C_SSU_2_DEG = 1.34110450744628906250E-6;    // Semicircles to degrees (MSSDM)
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Append an integer value with unit as a tab separated item.
+//
+// -------------------------------------------------------------------------------------------------//
+void antTextFormatter::appendItem
+(
+    amString       &buffer,
+    int             itemValue,
+    const amString &unit
+)
+{
+    buffer += "\t";
+    buffer.appendNumber( itemValue );
+    buffer += unit;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Append an unsigned integer value with unit as a tab separated item.
+//
+// -------------------------------------------------------------------------------------------------//
+void antTextFormatter::appendItem
+(
+    amString       &buffer,
+    unsigned int    itemValue,
+    const amString &unit
+)
+{
+    buffer += "\t";
+    buffer.appendNumber( itemValue );
+    buffer += unit;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Append a floating point value with unit as a tab separated item
+// with 'precision' digits after the decimal dot.
+//
+// -------------------------------------------------------------------------------------------------//
+void antTextFormatter::appendItem
+(
+    amString       &buffer,
+    double          itemValue,
+    unsigned int    precision,
+    const amString &unit
+)
+{
+    buffer += "\t";
+    buffer.appendNumber( itemValue, precision );
+    buffer += unit;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Append a string as a tab separated item.
+//
+// -------------------------------------------------------------------------------------------------//
+void antTextFormatter::appendItem
+(
+    amString       &buffer,
+    const amString &itemValue
+)
+{
+    buffer += "\t";
+    buffer += itemValue;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Append a byte as a tab separated item in hexadecimal notation.
+//
+// -------------------------------------------------------------------------------------------------//
+void antTextFormatter::appendHexItem
+(
+    amString      &buffer,
+    unsigned char  itemValue
+)
+{
+    buffer += "\t";
+    buffer.appendHex( itemValue );
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Append an integer value or a string as a tab separated item.
+// Which value to append is determined by the value of the condition.
+//
+// -------------------------------------------------------------------------------------------------//
+void antTextFormatter::appendItemConditional
+(
+    amString       &buffer,
+    bool            condition,
+    int             itemValueTrue,
+    const amString &itemValueFalse
+)
+{
+    buffer += "\t";
+    if ( condition )
+    {
+        buffer.appendNumber( itemValueTrue );
+    }
+    else
+    {
+        buffer += itemValueFalse;
+    }
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Append an unsigned integer value or a string as a tab separated item.
+// Which value to append is determined by the value of the condition.
+//
+// -------------------------------------------------------------------------------------------------//
+void antTextFormatter::appendItemConditional
+(
+    amString       &buffer,
+    bool            condition,
+    unsigned int    itemValueTrue,
+    const amString &itemValueFalse
+)
+{
+    buffer += "\t";
+    if ( condition )
+    {
+        buffer.appendNumber( itemValueTrue );
+    }
+    else
+    {
+        buffer += itemValueFalse;
+    }
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Append one of two strings as a tab separated item.
+// Which string to append is determined by the value of the condition.
+//
+// -------------------------------------------------------------------------------------------------//
+void antTextFormatter::appendItemConditional
+(
+    amString       &buffer,
+    bool            condition,
+    const amString &itemValueTrue,
+    const amString &itemValueFalse
+)
+{
+    buffer += "\t";
+    if ( condition )
+    {
+        buffer += itemValueTrue;
+    }
+    else
+    {
+        buffer += itemValueFalse;
+    }
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Append one of 4 possible strings as a tab separated item.
+// Which string to append is determined by the value of the condition.
+//
+// -------------------------------------------------------------------------------------------------//
+void antTextFormatter::appendItem4Way
+(
+    amString       &buffer,
+    int             condition,
+    const amString &itemValue0,
+    const amString &itemValue1,
+    const amString &itemValue2,
+    const amString &itemValue3
+)
+{
+    buffer += "\t";
+    if ( condition == 0 )
+    {
+        buffer += itemValue0;
+    }
+    else if ( condition == 1 )
+    {
+        buffer += itemValue1;
+    }
+    else if ( condition == 2 )
+    {
+        buffer += itemValue2;
+    }
+    else
+    {
+        buffer += itemValue3;
+    }
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Append an (signed) integer value as part of a JSON object.
+//
+// -------------------------------------------------------------------------------------------------//
+void antTextFormatter::appendJSONItem
+(
+    amString       &buffer,
+    const amString &itemName,
+    int             itemValue
+)
+{
+    buffer += C_JSON_INDENT;
+    buffer += "\"";
+    buffer += itemName;
+    buffer += "\": ";
+    buffer.appendNumber( itemValue );
+    buffer += ",\n";
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Append an unsigned integer value as part of a JSON object.
+//
+// -------------------------------------------------------------------------------------------------//
+void antTextFormatter::appendJSONItem
+(
+    amString       &buffer,
+    const amString &itemName,
+    unsigned int    itemValue
+)
+{
+    buffer += C_JSON_INDENT;
+    buffer += "\"";
+    buffer += itemName;
+    buffer += "\": ";
+    buffer.appendNumber( itemValue );
+    buffer += ",\n";
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Append a floating point value (with 'precision' digits after the decimal dot)
+// as part of a JSON object.
+//
+// -------------------------------------------------------------------------------------------------//
+void antTextFormatter::appendJSONItem
+(
+    amString       &buffer,
+    const amString &itemName,
+    double          itemValue,
+    int             precision
+)
+{
+    buffer += C_JSON_INDENT;
+    buffer += "\"";
+    buffer += itemName;
+    buffer += "\": ";
+    buffer.appendNumber( itemValue, precision );
+    buffer += ",\n";
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Append a string value as part of a JSON object.
+//
+// -------------------------------------------------------------------------------------------------//
+void antTextFormatter::appendJSONItem
+(
+    amString       &buffer,
+    const amString &itemName,
+    const amString &itemValue
+)
+{
+    buffer += C_JSON_INDENT;
+    buffer += "\"";
+    buffer += itemName;
+    buffer += "\": \"";
+    buffer += itemValue;
+    buffer += "\",\n";
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Append a boolean value as part of a JSON object.
+//
+// -------------------------------------------------------------------------------------------------//
+void antTextFormatter::appendJSONItemB
+(
+    amString       &buffer,
+    const amString &itemName,
+    bool            itemValue
+)
+{
+    buffer += C_JSON_INDENT;
+    buffer += "\"";
+    buffer += itemName;
+    buffer += "\": ";
+    buffer += ( itemValue ? C_TRUE_JSON : C_FALSE_JSON );
+    buffer += ",\n";
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Append a byte in hexadecimal notation as part of a JSON object.
+//
+// -------------------------------------------------------------------------------------------------//
+void antTextFormatter::appendJSONHexItem
+(
+    amString       &buffer,
+    const amString &itemName,
+    unsigned char   itemValue
+)
+{
+    buffer += C_JSON_INDENT;
+    buffer += "\"";
+    buffer += itemName;
+    buffer += "\": ";
+    buffer.appendHex( itemValue );
+    buffer += ",\n";
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Append a byte of an array (with its array name and index) in hexadecimal notation
+// as part of a JSON object.
+//
+// -------------------------------------------------------------------------------------------------//
+void antTextFormatter::appendJSONHexItem
+(
+    amString       &buffer,
+    const amString &itemName,
+    unsigned int    index,
+    unsigned char   itemValue
+)
+{
+    buffer += C_JSON_INDENT;
+    buffer += "\"";
+    buffer += itemName;
+    buffer += "[ ";
+    buffer.appendNumber( index );
+    buffer += " ]";
+    buffer += "\": ";
+    buffer.appendHex( itemValue );
+    buffer += ",\n";
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Append an integer value or a string as part of a JSON object.
+// Which value to append is determined by the value of the condition.
+//
+// -------------------------------------------------------------------------------------------------//
+void antTextFormatter::appendJSONItemConditional
+(
+    amString       &buffer,
+    const amString &itemName,
+    bool            condition,
+    int             itemValueTrue,
+    const amString &itemValueFalse
+)
+{
+    buffer += C_JSON_INDENT;
+    buffer += "\"";
+    buffer += itemName;
+    if ( condition )
+    {
+        buffer += "\": ";
+        buffer.appendNumber( itemValueTrue );
+        buffer += ",\n";
+    }
+    else
+    {
+        buffer += "\": \"";
+        buffer += itemValueFalse;
+        buffer += "\",\n";
+    }
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Append an unsigned integer value or a string as part of a JSON object.
+// Which value to append is determined by the value of the condition.
+//
+// -------------------------------------------------------------------------------------------------//
+void antTextFormatter::appendJSONItemConditional
+(
+    amString       &buffer,
+    const amString &itemName,
+    bool            condition,
+    unsigned int    itemValueTrue,
+    const amString &itemValueFalse
+)
+{
+    buffer += C_JSON_INDENT;
+    buffer += "\"";
+    buffer += itemName;
+    if ( condition )
+    {
+        buffer += "\": ";
+        buffer.appendNumber( itemValueTrue );
+        buffer += ",\n";
+    }
+    else
+    {
+        buffer += "\": \"";
+        buffer += itemValueFalse;
+        buffer += "\",\n";
+    }
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Append one of two strings as part of a JSON object.
+// Which value to append is determined by the value of the condition.
+//
+// -------------------------------------------------------------------------------------------------//
+void antTextFormatter::appendJSONItemConditional
+(
+    amString       &buffer,
+    const amString &itemName,
+    bool            condition,
+    const amString &itemValueTrue,
+    const amString &itemValueFalse
+)
+{
+    buffer += C_JSON_INDENT;
+    buffer += "\"";
+    buffer += itemName;
+    buffer += "\": \"";
+    if ( condition )
+    {
+        buffer += itemValueTrue;
+    }
+    else
+    {
+        buffer += itemValueFalse;
+    }
+    buffer += "\",\n";
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Append one of 4 possible strings as part of a JSON object.
+// Which string to append is determined by the value of the condition.
+//
+// -------------------------------------------------------------------------------------------------//
+void antTextFormatter::appendJSONItem4Way
+(
+    amString       &buffer,
+    const amString &itemName,
+    int             condition,
+    const amString &itemValue0,
+    const amString &itemValue1,
+    const amString &itemValue2,
+    const amString &itemValue3
+)
+{
+    buffer += C_JSON_INDENT;
+    buffer += "\"";
+    buffer += itemName;
+    buffer += "\": \"";
+    if ( condition == 0 )
+    {
+        buffer += itemValue0;
+    }
+    else if ( condition == 1 )
+    {
+        buffer += itemValue1;
+    }
+    else if ( condition == 2 )
+    {
+        buffer += itemValue2;
+    }
+    else
+    {
+        buffer += itemValue3;
+    }
+    buffer += "\",\n";
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Name of a battery status (common data page 82).
+//
+// -------------------------------------------------------------------------------------------------//
+amString antTextFormatter::getBatteryStatus
+(
+    unsigned int index,
+    bool         lowerCase
+)
+{
+    amString status;
+    switch ( index )
+    {
+        case  0: status = "N/A";
+                 break;
+        case  1: status = "New";
+                 break;
+        case  2: status = "Good";
+                 break;
+        case  3: status = "Ok";
+                 break;
+        case  4: status = "Low";
+                 break;
+        case  5: status = "Critical";
+                 break;
+        case  6: status = "Reserved for future use";
+                 break;
+        case  7: status = "Invalid";
+                 break;
+        default: status = "Unknown";
+                 break;
+    }
+    if ( lowerCase )
+    {
+        status.toLower();
+    }
+    return status;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Name of a week day (common data page 83), 0 is Sunday.
+//
+// -------------------------------------------------------------------------------------------------//
+amString antTextFormatter::getWeekDay
+(
+    unsigned int weekDayNo
+)
+{
+    amString wDayString;
+    switch( weekDayNo )
+    {
+        case  0: wDayString = "SUN";
+                 break;
+        case  1: wDayString = "MON";
+                 break;
+        case  2: wDayString = "TUE";
+                 break;
+        case  3: wDayString = "WED";
+                 break;
+        case  4: wDayString = "THU";
+                 break;
+        case  5: wDayString = "FRI";
+                 break;
+        case  6: wDayString = "SAT";
+                 break;
+        default: wDayString = C_UNKNOWN;
+                 break;
+    }
+    wDayString.toLower();
+    return wDayString;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Comma separated list of the data pages set in a bit field (environment data page 0).
+//
+// -------------------------------------------------------------------------------------------------//
+amString antTextFormatter::getSupportedPages
+(
+    unsigned int supportedPages
+)
+{
+    amString pagesString;
+    for ( unsigned int page = 0; page < 32; ++page )
+    {
+        if ( supportedPages & ( 1u << page ) )
+        {
+            if ( !pagesString.empty() )
+            {
+                pagesString += ", ";
+            }
+            pagesString.appendNumber( page );
+        }
+    }
+    return pagesString;
+}
+
+//-------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------//
+//
+// Text, semi-cooked and fully cooked
+//
+//-------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------//
+void antTextFormatter::appendPageNo
+(
+    bool         outputPageNo,
+    unsigned int dataPage
+)
+{
+    if ( outputPageNo )
+    {
+        appendItem( outBuffer, dataPage );
+    }
+}
+
+// Note: This needs reworking - ANT-FS Documentation required
+void antTextFormatter::formatCommonPage67
+(
+    const antRecordContext      &context,
+    const antCommonPage67Record &record
+)
+{
+    appendPageNo( record.outputPageNo, 67 );
+    appendItem( outBuffer, record.statusByte1 );
+    appendItem( outBuffer, record.statusByte2 );
+    appendItem( outBuffer, record.authentication );
+    appendItem( outBuffer, record.deviceType );
+    appendItem( outBuffer, record.manufacturerID );
+}
+
+// Note: This needs reworking - ANT-FS Documentation required
+void antTextFormatter::formatCommonPage68
+(
+    const antRecordContext      &context,
+    const antCommonPage68Record &record
+)
+{
+    appendPageNo( record.outputPageNo, 68 );
+    appendItem( outBuffer, record.commandResponseID );
+    appendItem( outBuffer, record.channelFrequency );
+    appendItem( outBuffer, record.channelPeriod );
+    appendItem( outBuffer, record.hostSerialNumber );
+}
+
+void antTextFormatter::formatCommonPage80
+(
+    const antRecordContext      &context,
+    const antCommonPage80Record &record
+)
+{
+    appendPageNo( record.outputPageNo, 80 );
+    appendItem( outBuffer, record.manufacturerID );
+    appendItem( outBuffer, record.hardwareRevision );
+    appendItem( outBuffer, record.modelNumber );
+}
+
+void antTextFormatter::formatUnsupportedPage
+(
+    const antRecordContext         &context,
+    const antUnsupportedPageRecord &record
+)
+{
+    appendItem( outBuffer, record.dataPage );
+    appendItem( outBuffer, C_UNSUPPORTED_DATA_PAGE );
+    for ( int counter = 0; counter < C_ANT_PAYLOAD_LENGTH; ++counter )
+    {
+        appendHexItem( outBuffer, record.payLoad[ counter ] );
+    }
+}
+
+//-------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------//
+//
+// Semi-cooked text
+//
+//-------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------//
+void antSemiCookedFormatter::formatHRM
+(
+    const antRecordContext &context,
+    const antHRMRecord     &record
+)
+{
+    int dataPageMod128 = record.dataPage & 0x0F;
+
+    appendItem( outBuffer, record.heartRate );
+    appendItem( outBuffer, record.deltaHeartBeatEventTime );
+    appendItem( outBuffer, record.deltaHeartBeatCount );
+    appendItem( outBuffer, record.dataPage );
+
+    if ( ( dataPageMod128 == 1 ) || ( dataPageMod128 == 2 ) || ( dataPageMod128 == 3 ) || ( dataPageMod128 == 4 ) )
+    {
+        appendItem( outBuffer, record.additionalData1 ); //  deltaOperatingTime (1) / manufacturerID (2) / hwVersion (3) // deltaPrevHeartBeatEventTime (4)
+        if ( ( dataPageMod128 == 2 ) || ( dataPageMod128 == 3 ) || ( dataPageMod128 == 4 ) )
+        {
+            appendItem( outBuffer, record.additionalData2 ); //  serialNumber (2) / swVersion (3) / manufacturerSpecificData (4)
+            if ( dataPageMod128 == 3 )
+            {
+                appendItem( outBuffer, record.additionalData3 ); //  modelNumber (3)
+            }
+        }
+    }
+}
+
+void antSemiCookedFormatter::formatPowerB01
+(
+    const antRecordContext  &context,
+    const antPowerB01Record &record
+)
+{
+    appendItem( outBuffer, record.calibrationID );
+    switch ( record.calibrationID )
+    {
+        case C_CTF_CALIBRATION_MESSAGE_ID:                      //  16 = 0x10: Crank Torque Frequency (CTF) Power Sensor (PWRB20) defined message
+        case C_AUTO_ZERO_SUPPORT_MESSAGE_ID:                    //  18 = 0x12: Auto Zero Support
+        case C_CALIBRATION_RESPONSE_MANUAL_ZERO_SUCCESS_ID:     // 172 = 0xAC: Calibration Response - Auto Zero Configuration Success
+        case C_CALIBRATION_RESPONSE_MANUAL_ZERO_FAIL_ID:        // 175 = 0xAF: Calibration Response - Auto Zero Configuration Fail
+             appendItem( outBuffer, record.calibrationData1 );
+             appendItem( outBuffer, record.calibrationData2 );
+             break;
+        case C_CALIBRATION_REQUEST_AUTO_ZERO_ID:                // 171 = 0xAB: Calibration Request - Auto Zero Configuration
+             appendItem( outBuffer, record.calibrationData1 );
+             break;
+        default:
+             break;
+    }
+}
+
+void antSemiCookedFormatter::formatPowerB02
+(
+    const antRecordContext  &context,
+    const antPowerB02Record &record
+)
+{
+    if ( record.subPage == 1 )
+    {
+        appendItem( outBuffer, record.subPage );
+        appendItem( outBuffer, record.crankLength );
+        appendItem( outBuffer, record.sensorStatus );
+        appendItem( outBuffer, record.sensorCapabilities );
+    }
+}
+
+void antSemiCookedFormatter::formatPowerB03
+(
+    const antRecordContext  &context,
+    const antPowerB03Record &record
+)
+{
+    appendItem( outBuffer, record.nbDataTypes );
+    appendItem( outBuffer, record.dataType );
+    appendItem( outBuffer, record.scaleFactor );
+    appendItem( outBuffer, record.deltaEventTime );
+    appendItem( outBuffer, record.value );
+}
+
+void antSemiCookedFormatter::formatPowerB10
+(
+    const antRecordContext  &context,
+    const antPowerB10Record &record
+)
+{
+    appendItem( outBuffer, record.eventCount );
+    appendItem( outBuffer, record.deltaEventCount );
+    appendItem( outBuffer, record.deltaAccumulatedPower );
+    appendItem( outBuffer, record.instantaneousPower );
+    appendItem( outBuffer, record.instantaneousCadence );
+    appendItem( outBuffer, record.pedalPower );
+}
+
+void antSemiCookedFormatter::formatPowerB11
+(
+    const antRecordContext  &context,
+    const antPowerB11Record &record
+)
+{
+    appendItem( outBuffer, record.deltaEventCount );
+    appendItem( outBuffer, record.deltaWheelPeriod );
+    appendItem( outBuffer, record.deltaAccumulatedTorque );
+    appendItem( outBuffer, record.instantaneousCadence );
+    appendItem( outBuffer, record.wheelTicks );
+}
+
+void antSemiCookedFormatter::formatPowerB12
+(
+    const antRecordContext  &context,
+    const antPowerB12Record &record
+)
+{
+    appendItem( outBuffer, record.deltaEventCount );
+    appendItem( outBuffer, record.deltaCrankPeriod );
+    appendItem( outBuffer, record.deltaAccumulatedTorque );
+    appendItem( outBuffer, record.instantaneousCadence );
+    appendItem( outBuffer, record.crankTicks );
+    appendItem( outBuffer, record.eventCount );
+}
+
+void antSemiCookedFormatter::formatPowerB13
+(
+    const antRecordContext  &context,
+    const antPowerB13Record &record
+)
+{
+    appendItem( outBuffer, record.leftTorqueEffectiveness );
+    appendItem( outBuffer, record.rightTorqueEffectiveness );
+    appendItem( outBuffer, record.leftPedalSmoothness );
+    appendItem( outBuffer, record.rightPedalSmoothness );
+    appendItem( outBuffer, record.deltaEventCount );
+}
+
+void antSemiCookedFormatter::formatPowerB20
+(
+    const antRecordContext  &context,
+    const antPowerB20Record &record
+)
+{
+    appendItem( outBuffer, record.deltaEventCount );
+    appendItem( outBuffer, record.deltaTimeStamp );
+    appendItem( outBuffer, record.deltaTorqueTicks );
+    appendItem( outBuffer, record.factorySlope );
+}
+
+void antSemiCookedFormatter::formatCommonPage70
+(
+    const antRecordContext      &context,
+    const antCommonPage70Record &record
+)
+{
+    appendPageNo( record.outputPageNo, 70 );
+    appendItem( outBuffer, record.descriptor1 );
+    appendItem( outBuffer, record.descriptor2 );
+    appendItem( outBuffer, record.requestedResponse );
+    appendItem( outBuffer, record.requestedPage );
+    appendItem( outBuffer, record.commandType );
+}
+
+void antSemiCookedFormatter::formatCommonPage81
+(
+    const antRecordContext      &context,
+    const antCommonPage81Record &record
+)
+{
+    appendPageNo( record.outputPageNo, 81 );
+    appendItem( outBuffer, record.serialNumber );
+    appendItem( outBuffer, record.softwareRevision );
+}
+
+void antSemiCookedFormatter::formatCommonPage82
+(
+    const antRecordContext      &context,
+    const antCommonPage82Record &record
+)
+{
+    appendPageNo( record.outputPageNo, 82 );
+    appendItem( outBuffer, record.voltage256 );
+    appendItem( outBuffer, record.status );
+    appendItem( outBuffer, record.deltaOperatingTime );
+    appendItem( outBuffer, record.resolution );
+    appendItem( outBuffer, record.nbBatteries );
+    appendItem( outBuffer, record.batteryID );
+}
+
+void antSemiCookedFormatter::formatCommonPage83
+(
+    const antRecordContext      &context,
+    const antCommonPage83Record &record
+)
+{
+    appendPageNo( record.outputPageNo, 83 );
+    appendItem( outBuffer, record.seconds );
+    appendItem( outBuffer, record.minutes );
+    appendItem( outBuffer, record.hours );
+    appendItem( outBuffer, record.weekDayNo );
+    appendItem( outBuffer, record.monthDay );
+    appendItem( outBuffer, record.month );
+    appendItem( outBuffer, record.year );
+}
+
+void antSemiCookedFormatter::formatCommonPage84
+(
+    const antRecordContext      &context,
+    const antCommonPage84Record &record
+)
+{
+    appendPageNo( record.outputPageNo, 84 );
+    appendItem( outBuffer, record.subPage1 );
+    appendItem( outBuffer, record.dataField1 );
+    appendItem( outBuffer, record.subPage2 );
+    appendItem( outBuffer, record.dataField2 );
+}
+
+void antSemiCookedFormatter::formatEnvironmentPage0
+(
+    const antRecordContext          &context,
+    const antEnvironmentPage0Record &record
+)
+{
+    appendItem( outBuffer, record.dataPage );
+    appendItem( outBuffer, record.localTime );
+    appendItem( outBuffer, record.utcTime );
+    appendItem( outBuffer, record.transmissionRate );
+    appendItem( outBuffer, record.supportedPages );
+}
+
+void antSemiCookedFormatter::formatEnvironmentPage1
+(
+    const antRecordContext          &context,
+    const antEnvironmentPage1Record &record
+)
+{
+    appendItem( outBuffer, record.dataPage );
+    appendItem( outBuffer, record.currentTemperature );
+    appendItem( outBuffer, record.lowTemperature24h );
+    appendItem( outBuffer, record.highTemperature24h );
+    appendItem( outBuffer, record.eventCount );
+}
+
+void antSemiCookedFormatter::formatCadence
+(
+    const antRecordContext &context,
+    const antCadenceRecord &record
+)
+{
+    int dataPageMod128 = record.dataPage & 0x0F;
+
+    appendItem( outBuffer, record.deltaRevolutionCount );
+    appendItem( outBuffer, record.deltaEventTime );
+    appendItem( outBuffer, record.dataPage );
+    if ( ( dataPageMod128 == 1 ) || ( dataPageMod128 == 2 ) || ( dataPageMod128 == 3 ) )
+    {
+        appendItem( outBuffer, record.additionalData1 );             // deltaOperatingTime (1) / manufacturerID (2) / hwVersion (3)
+        if ( ( dataPageMod128 == 2 ) || ( dataPageMod128 == 3 ) )
+        {
+            appendItem( outBuffer, record.additionalData2 );         // serialNumber (2) / swVersion (3)
+            if ( dataPageMod128 == 3 )
+            {
+                appendItem( outBuffer, record.additionalData3 );     // modelNumber (3)
+            }
+        }
+    }
+}
+
+void antSemiCookedFormatter::formatSpeed
+(
+    const antRecordContext &context,
+    const antSpeedRecord   &record
+)
+{
+    int dataPageMod128 = record.dataPage & 0x0F;
+
+    appendItem( outBuffer, record.dataPage );
+    appendItem( outBuffer, record.deltaEventTime );
+    appendItem( outBuffer, record.deltaRevolutionCount );
+    if ( dataPageMod128 != 0 )
+    {
+        appendItem( outBuffer, record.additionalData1 );             // deltaOperatingTime (1) / manufacturerID (2) / hwVersion (3)
+        if ( dataPageMod128 != 1 )
+        {
+            appendItem( outBuffer, record.additionalData2 );         // serialNumber (2) / swVersion (3)
+            if ( dataPageMod128 != 2 )
+            {
+                appendItem( outBuffer, record.additionalData3 );     // modelNumber (3)
+            }
+        }
+    }
+}
+
+void antSemiCookedFormatter::formatSpeedCadence
+(
+    const antRecordContext      &context,
+    const antSpeedCadenceRecord &record
+)
+{
+    appendItem( outBuffer, record.deltaSpeedEventTime );
+    appendItem( outBuffer, record.deltaWheelRevolutionCount );
+    appendItem( outBuffer, record.deltaCadenceEventTime );
+    appendItem( outBuffer, record.deltaCrankRevolutionCount );
+}
+
+void antSemiCookedFormatter::formatAero
+(
+    const antRecordContext &context,
+    const antAeroRecord    &record
+)
+{
+    appendItem( outBuffer, record.airSpeedRaw );
+    appendItem( outBuffer, record.yawAngleRaw );
+}
+
+void antSemiCookedFormatter::formatWeightScale
+(
+    const antRecordContext     &context,
+    const antWeightScaleRecord &record
+)
+{
+    appendItem( outBuffer, record.dataPage );
+    appendItem( outBuffer, record.userProfile );
+    appendItem( outBuffer, record.value1 );
+    appendItem( outBuffer, record.value2 );
+    if ( record.dataPage == 58 )
+    {
+        appendItem( outBuffer, record.age );
+        appendItem( outBuffer, record.userHeight );
+        appendItem( outBuffer, record.descriptBit );
+    }
+}
+
+void antSemiCookedFormatter::formatAudioPage1
+(
+    const antRecordContext    &context,
+    const antAudioPage1Record &record
+)
+{
+    appendItem( outBuffer, record.dataPage );
+    appendItem( outBuffer, record.volume );
+    appendItem( outBuffer, record.totalTrackTime );
+    appendItem( outBuffer, record.currentTrackTime );
+    appendItem( outBuffer, record.state );
+}
+
+void antSemiCookedFormatter::formatAudioPage16
+(
+    const antRecordContext     &context,
+    const antAudioPage16Record &record
+)
+{
+    appendItem( outBuffer, record.dataPage );
+    appendItem( outBuffer, record.serialNumber );
+    appendItem( outBuffer, record.commandNumber );
+}
+
+void antSemiCookedFormatter::formatStrideSpeedDist
+(
+    const antRecordContext         &context,
+    const antStrideSpeedDistRecord &record
+)
+{
+    if ( ( record.dataPage >= 1 ) && ( record.dataPage <= 15 ) )
+    {
+        appendItem( outBuffer, record.dataPage );
+        if ( record.dataPage == 1 )
+        {
+            appendItem( outBuffer, record.value1 );
+            appendItem( outBuffer, record.value2 );
+        }
+        appendItem( outBuffer, record.value3 );
+        appendItem( outBuffer, record.value4 );
+        appendItem( outBuffer, record.value5 );
+        appendItem( outBuffer, record.value6 );
+        if ( ( record.dataPage == 1 ) || ( record.dataPage == 3 ) )
+        {
+            appendItem( outBuffer, record.value7 );
+        }
+        appendItem( outBuffer, record.value8 );
+    }
+    else if ( record.dataPage == 16 )
+    {
+        appendItem( outBuffer, record.value1 );
+        appendItem( outBuffer, record.value2 );
+    }
+    else if ( record.dataPage == 22 )
+    {
+        appendItem( outBuffer, record.value1 );
+    }
+}
+
+void antSemiCookedFormatter::formatMultiSport
+(
+    const antRecordContext    &context,
+    const antMultiSportRecord &record
+)
+{
+    appendItem( outBuffer, record.dataPage );
+    if ( ( record.dataPage == 1 ) || ( record.dataPage == 3 ) )
+    {
+        appendItem( outBuffer, record.value1 );
+        appendItem( outBuffer, record.value2 );
+        appendItem( outBuffer, record.value3 );
+    }
+    if ( ( record.dataPage == 2 ) || ( record.dataPage == 48 ) )
+    {
+        appendItem( outBuffer, record.value1 );
+        appendItem( outBuffer, record.value2 );
+    }
+}
+
+//-------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------//
+//
+// Fully cooked text
+//
+//-------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------//
+void antCookedFormatter::formatHRM
+(
+    const antRecordContext &context,
+    const antHRMRecord     &record
+)
+{
+    int dataPageMod128 = record.dataPage & 0x0F;
+
+    appendItem( outBuffer, record.heartRate );
+    appendItem( outBuffer, record.totalHeartBeatCount );
+    appendItem( outBuffer, record.totalHeartBeatEventTime, 3 );
+    appendItem( outBuffer, record.dataPage );
+    if ( dataPageMod128 == 1 )
+    {
+        appendItem( outBuffer, 2 * record.additionalData1 );                             // operatingTimeSeconds
+    }
+    else if ( ( dataPageMod128 == 2 ) || ( dataPageMod128 == 3 ) )
+    {
+        appendItem( outBuffer, record.additionalData1 );                                 //  manufacturerID (2) / hwVersion (3)
+        appendItem( outBuffer, record.additionalData2 );                                 //  serialNumber (2)   / swVersion (3)
+        if ( dataPageMod128 == 3 )
+        {
+            appendItem( outBuffer, record.additionalData3 );                             //  modelNumber (3)
+        }
+    }
+    else if ( dataPageMod128 == 4 )
+    {
+        appendItem( outBuffer, record.previousHeartBeatEventTime, timePrecision );      //  prevHeartBeatEventTime
+        appendItem( outBuffer, record.additionalData2 );                                 //  manufacturerSpecificData
+    }
+}
+
+void antCookedFormatter::appendAutoZeroB01
+(
+    unsigned int autoZeroStatus
+)
+{
+    appendItem( outBuffer, C_AUTO_ZERO );
+    appendItemConditional( outBuffer, autoZeroStatus == 0, C_OFF, ( ( autoZeroStatus == 1 ) ? C_ON : C_NOT_SUPPORTED_ID ) );
+}
+
+void antCookedFormatter::formatPowerB01
+(
+    const antRecordContext  &context,
+    const antPowerB01Record &record
+)
+{
+    switch ( record.calibrationID )
+    {
+        case C_CTF_CALIBRATION_MESSAGE_ID:                      //  16 = 0x10: Crank Torque Frequency (CTF) Power Sensor (PWRB20) defined message
+             if ( record.calibrationData1 == 172 )
+             {
+                 appendItem( outBuffer, C_CTF_CALIBRATION_RESPONSE );
+                 appendItem4Way( outBuffer, record.calibrationData2, C_UNKNOWN, C_ZERO_OFFSET, C_SLOPE, C_SERIAL_NUMBER );
+             }
+             else
+             {
+                 appendItem( outBuffer, C_CTF_CALIBRATION_REQUEST );
+                 appendItem4Way( outBuffer, record.calibrationData1, C_UNKNOWN, C_ZERO_OFFSET, C_SLOPE, C_SERIAL_NUMBER );
+                 appendItem( outBuffer, record.calibrationData2 );
+             }
+             break;
+        case C_AUTO_ZERO_SUPPORT_MESSAGE_ID:                    //  18 = 0x12: Auto Zero Support
+             appendItem( outBuffer, C_AUTO_ZERO_ENABLE );
+             appendItemConditional( outBuffer, record.calibrationData1 != 0, C_SUPPORTED_ID, C_NOT_SUPPORTED_ID );
+             appendItem( outBuffer, C_AUTO_ZERO_STATUS );
+             appendItemConditional( outBuffer, record.calibrationData2 != 0, C_ON, C_OFF );
+             break;
+        case C_CALIBRATION_REQUEST_MANUAL_ZERO_ID:              // 170 = 0xAA: Calibration Request - Manual Zero
+             appendItem( outBuffer, C_CALIBRATION_REQUEST_MANUAL_ZERO );
+             break;
+        case C_CALIBRATION_REQUEST_AUTO_ZERO_ID:                // 171 = 0xAB: Calibration Request - Auto Zero Configuration
+             appendItem( outBuffer, C_CALIBRATION_REQUEST_AUTO_ZERO );
+             appendAutoZeroB01( record.calibrationData1 );
+             break;
+        case C_CALIBRATION_RESPONSE_MANUAL_ZERO_SUCCESS_ID:     // 172 = 0xAC: Calibration Response - Auto Zero Configuration Success
+             appendItem( outBuffer, C_CALIBRATION_RESPONSE_MANUAL_ZERO_SUCCESS );
+             appendAutoZeroB01( record.calibrationData1 );
+             appendItem( outBuffer, record.calibrationData2 );
+             break;
+        case C_CALIBRATION_RESPONSE_MANUAL_ZERO_FAIL_ID:        // 175 = 0xAF: Calibration Response - Auto Zero Configuration Fail
+             appendItem( outBuffer, C_CALIBRATION_RESPONSE_MANUAL_ZERO_FAILED );
+             appendAutoZeroB01( record.calibrationData1 );
+             appendItem( outBuffer, record.calibrationData2 );
+             break;
+        case C_CUSTOM_CALIBRATION_PARAMETER_REQUEST_ID:         // 186 = 0xBA: Custom Calibration Parameter Request
+             appendItem( outBuffer, C_CUSTOM_CALIBRATION_PARAMETER_REQUEST );
+             break;
+        case C_CUSTOM_CALIBRATION_PARAMETER_RESPONSE_ID:        // 187 = 0xBB: Custom Calibration Parameter Response
+             appendItem( outBuffer, C_CUSTOM_CALIBRATION_PARAMETER_RESPONSE );
+             break;
+        case C_CUSTOM_CALIBRATION_PARAMETER_UPDATE_ID:          // 188 = 0xBC: Custom Calibration Parameter Update
+             appendItem( outBuffer, C_CUSTOM_CALIBRATION_PARAMETER_UPDATE );
+             break;
+        case C_CUSTOM_CALIBRATION_PARAMETER_UPDATE_RESPONSE_ID: // 189 = 0xBD: Custom Calibration Parameter Update Response
+             appendItem( outBuffer, C_CUSTOM_CALIBRATION_PARAMETER_UPDATE_RESPONSE );
+             break;
+        default:
+             break;
+    }
+}
+
+void antCookedFormatter::formatPowerB02
+(
+    const antRecordContext  &context,
+    const antPowerB02Record &record
+)
+{
+    if ( record.subPage == 1 )
+    {
+        int  crankLengthStatus       = ( record.sensorStatus & 3 );
+        int  sensorSWMismatchStatus  = ( ( record.sensorStatus >> 2 ) & 3 );
+        int  sensorAvailabiltyStatus = ( ( record.sensorStatus >> 4 ) & 3 );
+        int  customCalibrationStatus = ( ( record.sensorStatus >> 6 ) & 3 );
+        bool autoCrankLength         = ( ( record.sensorCapabilities & 1 ) != 0 );
+
+        appendItem( outBuffer, C_CRANK_LENGTH );
+        if ( record.crankLength == 255 )
+        {
+            appendItem( outBuffer, C_UNDEFINED );
+        }
+        else
+        {
+            appendItem( outBuffer, 110.0 + ( double ) record.crankLength / 2.0, 1 );
+        }
+
+        appendItem( outBuffer, C_CRANK_LENGTH_USED );
+        appendItem4Way( outBuffer, crankLengthStatus, C_INVALID, "DEFAULT_LENGTH", "MANUALLY_SET", "AUTOMATICALLY_SET" );
+
+        appendItem( outBuffer, C_SW_MISMATCH );
+        appendItem4Way( outBuffer, sensorSWMismatchStatus, C_UNDEFINED, "RIGHT_SENSOR_OLDER", "LEFT_SENSOR_OLDER", C_NONE_ID );
+
+        appendItem( outBuffer, C_SENSOR_AVAILABILTY );
+        appendItem4Way( outBuffer, sensorAvailabiltyStatus, C_UNDEFINED, "RIGHT_PRESENT", "LEFT_PRESENT", "BOTH_PRESENT" );
+
+        appendItem( outBuffer, C_CUSTOM_CALIBRATION );
+        appendItem4Way( outBuffer, customCalibrationStatus, C_UNDEFINED, "NOT_REQUIRED", "REQUIRED", C_UNKNOWN );
+
+        appendItem( outBuffer, "DETERMINE_CRANK_LENGTH" );
+        appendItemConditional( outBuffer, autoCrankLength, "AUTOMATICALLY", "MANUALLY" );
+    }
+}
+
+void antCookedFormatter::formatPowerB03
+(
+    const antRecordContext  &context,
+    const antPowerB03Record &record
+)
+{
+    appendItem( outBuffer, "NB_DATA_TYPES" );
+    appendItem( outBuffer, record.nbDataTypes );
+    appendItem( outBuffer, "TIME_VALUE" );
+    appendItem( outBuffer, record.timeValue, valuePrecision );
+
+    switch ( record.dataType )
+    {
+        case  0: // Countdown (remaining process, in %)
+                 appendItem( outBuffer, "COUNTDOWN_PCT" );
+                 appendItem( outBuffer, record.measurementValue, 2, "%" );
+                 break;
+        case  1: // Countdown (time of remaining process, in s)
+                 appendItem( outBuffer, "COUNTDOWN_SEC" );
+                 appendItem( outBuffer, record.measurementValue, 2, "s" );
+                 break;
+        case  8: // Torque (whole sensor, in Nm)
+                 appendItem( outBuffer, "TOTAL_TORQUE" );
+                 appendItem( outBuffer, record.measurementValue, 2, "Nm" );
+                 break;
+        case  9: // Left Torque (in Nm)
+                 appendItem( outBuffer, "L_TORQUE" );
+                 appendItem( outBuffer, record.measurementValue, 2, "Nm" );
+                 break;
+        case 10: // Right Torque (in Nm)
+                 appendItem( outBuffer, "R_TORQUE" );
+                 appendItem( outBuffer, record.measurementValue, 2, "Nm" );
+                 break;
+        case 16: // Force (whole sensor, in N)
+                 appendItem( outBuffer, "TOTAL_FORCE" );
+                 appendItem( outBuffer, record.measurementValue, 2, "N" );
+                 break;
+        case 17: // Left Force (in N)
+                 appendItem( outBuffer, "L_FORCE" );
+                 appendItem( outBuffer, record.measurementValue, 2, "N" );
+                 break;
+        case 18: // Right Force (in N)
+                 appendItem( outBuffer, "R_FORCE" );
+                 appendItem( outBuffer, record.measurementValue, 2, "N" );
+                 break;
+        case 24: // Zero Offset
+                 appendItem( outBuffer, "ZERO_OFFSET" );
+                 appendItem( outBuffer, record.measurementValue, 2 );
+                 break;
+        case 25: // Temperature (in degree C)
+                 appendItem( outBuffer, "TEMP" );
+                 appendItem( outBuffer, record.measurementValue, 2, "C" );
+                 break;
+        case 26: // Voltage (in V)
+                 appendItem( outBuffer, "VOLT" );
+                 appendItem( outBuffer, record.measurementValue, 2, "V" );
+                 break;
+        default: // Reserved for future use
+                 appendItem( outBuffer, "UNUSED" );
+                 appendItem( outBuffer, "0" );
+                 break;
+    }
+}
+
+void antCookedFormatter::formatPowerB10
+(
+    const antRecordContext  &context,
+    const antPowerB10Record &record
+)
+{
+    appendItem( outBuffer, record.power, valuePrecision );
+    appendItemConditional( outBuffer, record.instantaneousCadence != 255, record.cadence, C_UNDEFINED );
+    appendItemConditional( outBuffer, record.pedalPowerContribution >= 0, record.pedalPowerContribution, "NO_PEDAL_POWER_CONTRIBUTION" );
+    appendItemConditional( outBuffer, record.rightPedal, C_RIGHT_PEDAL, C_UNKNOWN_PEDAL );
+    appendItem( outBuffer, record.eventCount );
+    if ( record.isMakeshiftSpeedSensor )
+    {
+        appendItem( outBuffer, record.speed, valuePrecision );
+        appendItem( outBuffer, record.wheelCircumference, valuePrecision );
+        appendItem( outBuffer, record.gearRatio, valuePrecision );
+    }
+}
+
+void antCookedFormatter::formatPowerB11
+(
+    const antRecordContext  &context,
+    const antPowerB11Record &record
+)
+{
+    appendItem( outBuffer, record.power, valuePrecision );
+    appendItem( outBuffer, record.cadence );
+    appendItem( outBuffer, record.torque, valuePrecision );
+    appendItem( outBuffer, record.wheelTicks );
+    if ( record.isSpeedSensor )
+    {
+        appendItem( outBuffer, record.speed, valuePrecision );
+        appendItem( outBuffer, record.wheelCircumference, valuePrecision );
+    }
+}
+
+void antCookedFormatter::formatPowerB12
+(
+    const antRecordContext  &context,
+    const antPowerB12Record &record
+)
+{
+    appendItem( outBuffer, record.power, valuePrecision );
+    appendItem( outBuffer, record.cadence );
+    appendItem( outBuffer, record.torque, valuePrecision );
+    appendItem( outBuffer, record.crankTicks );
+    appendItem( outBuffer, record.eventCount );
+    if ( record.isMakeshiftSpeedSensor )
+    {
+        appendItem( outBuffer, record.speed, valuePrecision );
+        appendItem( outBuffer, record.wheelCircumference, valuePrecision );
+        appendItem( outBuffer, record.gearRatio, valuePrecision );
+    }
+}
+
+// Torque effectiveness and pedal smoothness in %, 255 means invalid.
+void antCookedFormatter::appendPercentageB13
+(
+    const amString &name,
+    unsigned int    value
+)
+{
+    appendItem( outBuffer, name );
+    if ( value == 255 )
+    {
+        appendItem( outBuffer, C_INVALID );
+    }
+    else
+    {
+        appendItem( outBuffer, ( double ) value / 2.0, 1, "%" );
+    }
+}
+
+void antCookedFormatter::formatPowerB13
+(
+    const antRecordContext  &context,
+    const antPowerB13Record &record
+)
+{
+    appendPercentageB13( C_LEFT_TORQUE_EFFECTIVENESS,  record.leftTorqueEffectiveness );
+    appendPercentageB13( C_RIGHT_TORQUE_EFFECTIVENESS, record.rightTorqueEffectiveness );
+    if ( record.rightPedalSmoothness == 254 )
+    {
+        // Pedal Smoothness is combined, no Left/Right Pedal Smoothness.
+        appendPercentageB13( C_COMMON_PEDAL_SMOOTHNESS, record.leftPedalSmoothness );
+    }
+    else
+    {
+        appendPercentageB13( C_LEFT_PEDAL_SMOOTHNESS,  record.leftPedalSmoothness );
+        appendPercentageB13( C_RIGHT_PEDAL_SMOOTHNESS, record.rightPedalSmoothness );
+    }
+    appendItem( outBuffer, "EVENT_NO" );
+    appendItem( outBuffer, record.totalEventCount );
+}
+
+void antCookedFormatter::formatPowerB20
+(
+    const antRecordContext  &context,
+    const antPowerB20Record &record
+)
+{
+    appendItem( outBuffer, record.power, valuePrecision );
+    appendItem( outBuffer, record.cadence );
+    appendItem( outBuffer, record.torque, valuePrecision );
+    appendItem( outBuffer, record.offset );
+    appendItem( outBuffer, record.slope / 10.0, 1 );
+    appendItemConditional( outBuffer, record.isFactorySlope, "FACTORY_SLOPE", "USER_DEFINED_SLOPE" );
+    appendItem( outBuffer, record.factorySlope / 10.0, 1 );
+    if ( record.isMakeshiftSpeedSensor )
+    {
+        appendItem( outBuffer, record.speed, valuePrecision );
+        appendItem( outBuffer, record.wheelCircumference, valuePrecision );
+        appendItem( outBuffer, record.gearRatio, valuePrecision );
+    }
+}
+
+void antCookedFormatter::formatCommonPage70
+(
+    const antRecordContext      &context,
+    const antCommonPage70Record &record
+)
+{
+    appendPageNo( record.outputPageNo, 70 );
+    appendItem( outBuffer, "DESCRIPTOR_BYTE_1" );
+    appendItemConditional( outBuffer, record.descriptor1 != 255, record.descriptor1, "NONE" );
+    appendItem( outBuffer, "DESCRIPTOR_BYTE_2" );
+    appendItemConditional( outBuffer, record.descriptor2 != 255, record.descriptor2, "NONE" );
+
+    if ( record.requestedResponse == 0 )
+    {
+        appendItem( outBuffer, C_TRANSMIT_INVALID );
+    }
+    else if ( record.requestedResponse == 128 )
+    {
+        appendItem( outBuffer, C_TRANSMIT_UNTIL_SUCCESS_ACKNOWLEDGED );
+    }
+    else
+    {
+        appendItem( outBuffer, C_TRANSMIT_NB_TIMES );
+        appendItem( outBuffer, record.requestedResponse & 0x7F );
+        appendItemConditional( outBuffer, ( record.requestedResponse & 128 ) != 0, C_REPLY_ACKNOWLEDGE, C_NO_REPLY_ACKNOWLEDGE );
+    }
+
+    appendItem( outBuffer, C_REQUESTED_PAGE_NO );
+    appendItem( outBuffer, record.requestedPage );
+    appendItemConditional( outBuffer, record.commandType == 1, C_DATA_PAGE, C_ANT_FS_SESSION );
+}
+
+void antCookedFormatter::formatCommonPage81
+(
+    const antRecordContext      &context,
+    const antCommonPage81Record &record
+)
+{
+    appendPageNo( record.outputPageNo, 81 );
+    appendItemConditional( outBuffer, ( int ) record.serialNumber >= 0, record.serialNumber, "NO_SERIAL_NUMBER" );
+    appendItem( outBuffer, record.softwareRevision );
+}
+
+void antCookedFormatter::formatCommonPage82
+(
+    const antRecordContext      &context,
+    const antCommonPage82Record &record
+)
+{
+    appendPageNo( record.outputPageNo, 82 );
+    appendItem( outBuffer, ( record.nbBatteries == 0 ) ? 1 : record.nbBatteries );
+    appendItem( outBuffer, record.batteryID );
+    appendItem( outBuffer, ( double ) record.voltage256 / 256.0, 2 );
+    appendItem( outBuffer, getBatteryStatus( record.status, false ) );
+    appendItem( outBuffer, record.totalOperatingTime, timePrecision );
+}
+
+void antCookedFormatter::formatCommonPage83
+(
+    const antRecordContext      &context,
+    const antCommonPage83Record &record
+)
+{
+    appendPageNo( record.outputPageNo, 83 );
+    appendItem( outBuffer, "DATE" );
+    appendItem( outBuffer, date2String( record.year + 2000, record.month, record.monthDay ) );
+    appendItem( outBuffer, "WEEK_DAY" );
+    appendItem( outBuffer, getWeekDay( record.weekDayNo ) );
+    appendItem( outBuffer, "TIME" );
+    appendItem( outBuffer, time2String( record.hours, record.minutes, record.seconds ) );
+}
+
+void antCookedFormatter::formatCommonPage84
+(
+    const antRecordContext      &context,
+    const antCommonPage84Record &record
+)
+{
+    appendPageNo( record.outputPageNo, 84 );
+    appendSubPage84( record.subPage1, record.dataField1 );
+    appendSubPage84( record.subPage2, record.dataField2 );
+}
+
+void antCookedFormatter::appendSubPage84
+(
+    unsigned int subPage,
+    unsigned int dataField
+)
+{
+    int temperature100 = 0;
+
+    switch ( subPage )
+    {
+        case  1: // Temperature
+                 temperature100 = NEGATE_BINARY_INT( dataField, 16 );
+                 appendItem( outBuffer, "TEMP" );
+                 appendItem( outBuffer, ( double ) temperature100 / 100.0, 3, "C" );
+                 break;
+        case  2: // Barometric Pressure
+                 appendItem( outBuffer, "PRESSURE" );
+                 appendItem( outBuffer, ( double ) dataField / 100.0, 3 );
+                 break;
+        case  3: // Humidity
+                 appendItem( outBuffer, "HUMIDITY" );
+                 appendItem( outBuffer, ( double ) dataField / 100.0, 3, "\%" );
+                 break;
+        case  4: // Wind Speed (0.01 km/h)
+                 appendItem( outBuffer, "WIND_SPEED" );
+                 appendItem( outBuffer, ( double ) dataField / 100.0, 3 );
+                 break;
+        case  5: // Wind Direction (0.005 degrees)
+                 appendItem( outBuffer, "WIND_DIR" );
+                 appendItem( outBuffer, ( double ) dataField / 200.0, 3 );
+                 break;
+        default: // Undefined
+                 appendItem( outBuffer, "UNKNOWN" );
+                 break;
+    }
+}
+
+void antCookedFormatter::formatEnvironmentPage0
+(
+    const antRecordContext          &context,
+    const antEnvironmentPage0Record &record
+)
+{
+    appendItem( outBuffer, "LOCAL_TIME" );
+    appendItem( outBuffer, ( record.localTime == 0 ) ? C_SET_ID : (
+                           ( record.localTime == 1 ) ? C_SUPPORTED_AND_NOT_SET_ID : (
+                           ( record.localTime == 2 ) ? C_SUPPORTED_AND_SET_ID : C_UNUSED ) ) );
+
+    appendItem( outBuffer, "UTC_TIME" );
+    appendItem( outBuffer, ( record.utcTime == 0 ) ? C_SET_ID : (
+                           ( record.utcTime == 1 ) ? C_SUPPORTED_AND_NOT_SET_ID : (
+                           ( record.utcTime == 2 ) ? C_SUPPORTED_AND_SET_ID : C_UNUSED ) ) );
+
+    appendItem( outBuffer, "TRANSMISSION_HZ" );
+    appendItem( outBuffer, ( record.transmissionRate == 0 ) ? "0.5" : (
+                           ( record.transmissionRate == 2 ) ? "4.0" : C_UNUSED ) );
+
+    appendItem( outBuffer, "SUPPORTED_PAGES" );
+    appendItemConditional( outBuffer, record.supportedPages == 0, C_NONE_ID, getSupportedPages( record.supportedPages ) );
+}
+
+void antCookedFormatter::formatEnvironmentPage1
+(
+    const antRecordContext          &context,
+    const antEnvironmentPage1Record &record
+)
+{
+    appendItem( outBuffer, "CURR_TEMP" );
+    appendItem( outBuffer, record.currentTemp, 2, "C" );
+    appendItem( outBuffer, "LOW_TEMP_24H" );
+    appendItem( outBuffer, record.lowTemp24h, 1, "C" );
+    appendItem( outBuffer, "HIGH_TEMP_24H" );
+    appendItem( outBuffer, record.highTemp24h, 1, "C" );
+    appendItem( outBuffer, "EVENT_NO" );
+    appendItem( outBuffer, record.eventCount );
+}
+
+void antCookedFormatter::formatCadence
+(
+    const antRecordContext &context,
+    const antCadenceRecord &record
+)
+{
+    int dataPageMod128 = record.dataPage & 0x0F;
+
+    appendItem( outBuffer, record.cadence );
+    appendItem( outBuffer, record.dataPage );
+    if ( record.isMakeshiftSpeedSensor )
+    {
+        appendItem( outBuffer, record.speed,              valuePrecision );
+        appendItem( outBuffer, record.wheelCircumference, 3 );
+        appendItem( outBuffer, record.gearRatio,          valuePrecision );
+    }
+
+    if ( dataPageMod128 == 1 )
+    {
+        appendItem( outBuffer, 2 * record.additionalData1, "s" );    // operatingTimeSeconds
+    }
+    else if ( ( dataPageMod128 == 2 ) || ( dataPageMod128 == 3 ) )
+    {
+        appendItem( outBuffer, record.additionalData1 );             // manufacturerID (2) / hwVersion (3)
+        appendItem( outBuffer, record.additionalData2 );             // serialNumber (2)   / swVersion (3)
+        if ( dataPageMod128 == 3 )
+        {
+            appendItem( outBuffer, record.additionalData3 );         // modelNumber (3)
+        }
+    }
+}
+
+void antCookedFormatter::formatSpeed
+(
+    const antRecordContext &context,
+    const antSpeedRecord   &record
+)
+{
+    int dataPageMod128 = record.dataPage & 0x0F;
+
+    appendItem( outBuffer, record.speed,              valuePrecision );
+    appendItem( outBuffer, record.wheelCircumference, valuePrecision );
+    appendItem( outBuffer, record.numberOfMagnets );
+    appendItem( outBuffer, record.dataPage );
+    if ( dataPageMod128 == 1 )
+    {
+        appendItem( outBuffer, 2 * record.additionalData1 );         // operatingTimeSeconds
+    }
+    else if ( dataPageMod128 != 0 )
+    {
+        appendItem( outBuffer, record.additionalData1 );             // manufacturerID (2) / hwVersion (3)
+        appendItem( outBuffer, record.additionalData2 );             // serialNumber (2)   / swVersion (3)
+        if ( dataPageMod128 != 2 )
+        {
+            appendItem( outBuffer, record.additionalData3 );         // modelNumber (3)
+        }
+    }
+}
+
+void antCookedFormatter::formatSpeedCadence
+(
+    const antRecordContext      &context,
+    const antSpeedCadenceRecord &record
+)
+{
+    appendItem( outBuffer, record.speed,              valuePrecision );
+    appendItem( outBuffer, record.cadence );
+    appendItem( outBuffer, record.wheelCircumference, valuePrecision );
+    appendItem( outBuffer, record.numberOfMagnets );
+}
+
+void antCookedFormatter::formatAero
+(
+    const antRecordContext &context,
+    const antAeroRecord    &record
+)
+{
+    appendItem( outBuffer, record.airSpeed,           valuePrecision );
+    appendItem( outBuffer, record.yawAngle,           valuePrecision );
+    appendItem( outBuffer, record.calibrationRho,     valuePrecision );
+    appendItem( outBuffer, record.airSpeedMultiplier, valuePrecision );
+    appendItem( outBuffer, record.currentRho,         valuePrecision );
+}
+
+void antCookedFormatter::formatWeightScale
+(
+    const antRecordContext     &context,
+    const antWeightScaleRecord &record
+)
+{
+    appendItem( outBuffer, record.dataPage );
+    appendItem( outBuffer, "USER_PROFILE" );
+    appendItemConditional( outBuffer, record.userProfile != 0xFFFF, record.userProfile, C_INVALID );
+    if ( ( record.dataPage == 1 ) || ( record.dataPage == 58 ) )
+    {
+        appendItem( outBuffer, ( record.value1 & 1 )          ? "SCALE_USER_PROFILE_SELECTED"           : "SCALE_USER_PROFILE_NOT_SELECTED" );
+        appendItem( outBuffer, ( record.value1 & ( 1 << 1 ) ) ? "SCALE_USER_PROFILE_CAPABLE"            : "SCALE_USER_PROFILE_NOT_CAPABLE" );
+        appendItem( outBuffer, ( record.value1 & ( 1 << 2 ) ) ? "ANT_FS_CHANNEL_AVALIABLE"              : "ANT_FS_CHANNEL_NOT_AVALIABLE" );
+        appendItem( outBuffer, ( record.value1 & ( 1 << 7 ) ) ? "DISPLAY_USER_PROFILE_EXHCANGE_CAPABLE" : "DISPLAY_USER_PROFILE_EXHCANGE_NOT_CAPABLE" );
+        if ( record.dataPage == 1 )
+        {
+            appendItem( outBuffer, "BODY_WEIGHT" );
+            if ( ( record.value2 == 0xFFFF ) || ( record.value2 == 0xFFFE ) )
+            {
+                appendItem( outBuffer, ( record.value2 == 0xFFFF ) ? C_INVALID : "COMPUTING" );
+            }
+            else
+            {
+                appendItem( outBuffer, ( double ) record.value2 / 100.0, 2 );
+            }
+        }
+        else
+        {
+            // Sic: the gender is taken from the capabilities and the age from the gender.
+            appendItem( outBuffer, "GENDER" );
+            if ( ( record.value2 == 0 ) && ( record.age == 0 ) )
+            {
+                appendItem( outBuffer, "NOT_SET" );
+                appendItem( outBuffer, "AGE" );
+                appendItem( outBuffer, "NOT_SET" );
+            }
+            else
+            {
+                appendItem( outBuffer, ( record.value1 == 0 ) ? "F" : "M" );
+                appendItem( outBuffer, "AGE" );
+                appendItem( outBuffer, record.value2 );
+            }
+
+            appendItem( outBuffer, "HEIGHT" );
+            if ( record.userHeight == 0 )
+            {
+                appendItem( outBuffer, "NOT_SET" );
+            }
+            else
+            {
+                appendItem( outBuffer, record.userHeight, "cm" );
+            }
+
+            appendItem( outBuffer, "ATHLETE_TYPE" );
+            appendItem( outBuffer, ( ( record.descriptBit & ( 1 << 7 ) ) != 0 ) ? "LIFETIME" : "STANDARD" );
+            appendItem( outBuffer, "ACTIVITY_CLASS" );
+            appendItem( outBuffer, record.descriptBit >> 6 );
+        }
+    }
+    else if ( record.dataPage == 2 )
+    {
+        appendItem( outBuffer, "HYDRATION" );
+        if ( ( record.value1 == 0xFFFF ) || ( record.value1 == 0xFFFE ) )
+        {
+            appendItem( outBuffer, ( record.value1 == 0xFFFF ) ? C_INVALID : "COMPUTING" );
+        }
+        else
+        {
+            appendItem( outBuffer, ( double ) record.value1 / 100.0, 2, "%" );
+        }
+
+        appendItem( outBuffer, "BODY_FAT" );
+        if ( ( record.value2 == 0xFFFF ) || ( record.value2 == 0xFFFE ) )
+        {
+            appendItem( outBuffer, ( record.value2 == 0xFFFF ) ? C_INVALID : "COMPUTING" );
+        }
+        else
+        {
+            appendItem( outBuffer, ( double ) record.value2 / 100.0, 2, "%" );
+        }
+    }
+    else if ( record.dataPage == 3 )
+    {
+        appendItem( outBuffer, "ACTIVE_METABOLIC_RATE" );
+        if ( ( record.value1 == 0xFFFF ) || ( record.value1 == 0xFFFE ) )
+        {
+            appendItem( outBuffer, ( record.value1 == 0xFFFF ) ? C_INVALID : "COMPUTING" );
+        }
+        else
+        {
+            appendItem( outBuffer, ( double ) record.value1 / 100.0, 2, "%" );
+        }
+
+        appendItem( outBuffer, "BASAL_METABOLIC_RATE" );
+        if ( ( record.value2 == 0xFFFF ) || ( record.value2 == 0xFFFE ) )
+        {
+            appendItem( outBuffer, ( record.value2 == 0xFFFF ) ? C_INVALID : "COMPUTING" );
+        }
+        else
+        {
+            appendItem( outBuffer, ( double ) record.value2 / 100.0, 2, "%" );
+        }
+    }
+    else if ( record.dataPage == 4 )
+    {
+        appendItem( outBuffer, "MUSCLE_MASS" );
+        if ( ( record.value1 == 0xFFFF ) || ( record.value1 == 0xFFFE ) )
+        {
+            appendItem( outBuffer, ( record.value1 == 0xFFFF ) ? C_INVALID : "COMPUTING" );
+        }
+        else
+        {
+            appendItem( outBuffer, ( double ) record.value1 / 100.0, 2, "kg" );
+        }
+
+        // Sic: an invalid bone mass (0xFF) is output as COMPUTING.
+        appendItem( outBuffer, "BONE_MASS" );
+        if ( ( record.value2 == 0xFF ) || ( record.value2 == 0xFE ) )
+        {
+            appendItem( outBuffer, "COMPUTING" );
+        }
+        else
+        {
+            appendItem( outBuffer, ( double ) record.value2 / 10.0, 2, "kg" );
+        }
+    }
+}
+
+void antCookedFormatter::formatAudioPage1
+(
+    const antRecordContext    &context,
+    const antAudioPage1Record &record
+)
+{
+    appendItem( outBuffer, "VOLUME" );
+    if ( record.volume == 0xFF )
+    {
+        appendItem( outBuffer, C_UNKNOWN );
+    }
+    else
+    {
+        appendItem( outBuffer, record.volume, "%" );
+    }
+
+    appendItem( outBuffer, "TOTAL_TRACK_TIME" );
+    if ( record.totalTrackTime == 0xFFFF )
+    {
+        appendItem( outBuffer, C_UNKNOWN );
+    }
+    else
+    {
+        appendItem( outBuffer, record.totalTrackTime, "s" );
+    }
+
+    appendItem( outBuffer, "CURR_TRACK_TIME" );
+    appendItemConditional( outBuffer, record.currentTrackTime != 0xFFFF, record.currentTrackTime, C_UNKNOWN );
+
+    // Sic: the states are taken from the current track time, not from the state byte, and the
+    // repeat state is not shifted.
+    unsigned int audioDeviceState = record.currentTrackTime >> 4;
+    appendItem( outBuffer, "STATE" );
+    switch ( audioDeviceState )
+    {
+        case  0: appendItem( outBuffer, "OFF" );
+                 break;
+        case  1: appendItem( outBuffer, "PLAY" );
+                 break;
+        case  2: appendItem( outBuffer, "PAUSED" );
+                 break;
+        case  3: appendItem( outBuffer, "STOPPED" );
+                 break;
+        case  4: appendItem( outBuffer, "BUSY" );
+                 break;
+        case 15: appendItem( outBuffer, C_UNKNOWN );
+                 break;
+        default: appendItem( outBuffer, "RESERVED" );
+                 break;
+    }
+
+    if ( audioDeviceState != 15 )
+    {
+        appendItem( outBuffer, "REPEAT" );
+        switch ( record.currentTrackTime & 0x0C )
+        {
+            case  0: appendItem( outBuffer, "OFF" );
+                     break;
+            case  1: appendItem( outBuffer, "CURRENT_TRACK" );
+                     break;
+            case  2: appendItem( outBuffer, "ALL" );
+                     break;
+            default: appendItem( outBuffer, "RESERVED" );
+                     break;
+        }
+
+        appendItem( outBuffer, "SHUFFLE" );
+        switch ( record.currentTrackTime & 0x03 )
+        {
+            case  0: appendItem( outBuffer, "OFF" );
+                     break;
+            case  1: appendItem( outBuffer, "TRACK" );
+                     break;
+            case  2: appendItem( outBuffer, "ALBUM" );
+                     break;
+            default: appendItem( outBuffer, "RESERVED" );
+                     break;
+        }
+    }
+}
+
+void antCookedFormatter::formatAudioPage16
+(
+    const antRecordContext     &context,
+    const antAudioPage16Record &record
+)
+{
+    appendItem( outBuffer, "SERIAL_NO" );
+    appendItemConditional( outBuffer, record.serialNumber != 0xFFFF, record.serialNumber, C_UNKNOWN );
+    appendItem( outBuffer, "COMMAND" );
+    switch ( record.commandNumber )
+    {
+        case  1: appendItem( outBuffer, "OFF" );
+                 break;
+        case  2: appendItem( outBuffer, "PAUSE" );
+                 break;
+        case  3: appendItem( outBuffer, "STOP" );
+                 break;
+        case  4: appendItem( outBuffer, "VOLUME_UP" );
+                 break;
+        case  5: appendItem( outBuffer, "VOLUME_DOWN" );
+                 break;
+        case  6: appendItem( outBuffer, "MUTE" );
+                 break;
+        case  7: appendItem( outBuffer, "TRACK_AHEAD" );
+                 break;
+        case  8: appendItem( outBuffer, "TRACK_BACK" );
+                 break;
+        case  9: appendItem( outBuffer, "REPEAT_CURRENT_TRACK" );
+                 break;
+        case 10: appendItem( outBuffer, "REPEAT_ALL" );
+                 break;
+        case 11: appendItem( outBuffer, "REPEAT_OFF" );
+                 break;
+        case 12: appendItem( outBuffer, "SHUFFLE_SONGS" );
+                 break;
+        case 13: appendItem( outBuffer, "SHUFFLE_ALBUMS" );
+                 break;
+        case 14: appendItem( outBuffer, "SHUFFLE_OFF" );
+                 break;
+        case 15: appendItem( outBuffer, "FFD" );
+                 break;
+        case 16: appendItem( outBuffer, "REW" );
+                 break;
+        default: appendItem( outBuffer, "RESERVED" );
+                 break;
+    }
+}
+
+void antCookedFormatter::formatStrideSpeedDist
+(
+    const antRecordContext         &context,
+    const antStrideSpeedDistRecord &record
+)
+{
+    appendItem( outBuffer, "DATA_PAGE" );
+    appendItem( outBuffer, record.dataPage );
+    if ( ( record.dataPage >= 1 ) && ( record.dataPage <= 15 ) )
+    {
+        appendItem( outBuffer, "SPEED" );
+        if ( ( record.value5 == 0 ) && ( record.value6 == 0 ) )
+        {
+            appendItem( outBuffer, "OFF" );
+        }
+        else
+        {
+            appendItem( outBuffer, ( double ) record.value5 + ( ( double ) record.value6 ) / 256.0, 8 );
+        }
+
+        if ( record.dataPage == 1 )
+        {
+            appendItem( outBuffer, "TOTAL_TIME" );
+            if ( ( record.value1 == 0 ) && ( record.value2 == 0 ) )
+            {
+                appendItem( outBuffer, "OFF" );
+            }
+            else
+            {
+                appendItem( outBuffer, ( double ) record.value1 + ( ( double ) record.value2 ) / 200.0, 3 );
+            }
+
+            appendItem( outBuffer, "TOTAL_DIST" );
+            if ( ( record.value3 == 0 ) && ( record.value4 == 0 ) )
+            {
+                appendItem( outBuffer, "OFF" );
+            }
+            else
+            {
+                appendItem( outBuffer, ( double ) record.value3 + ( ( double ) record.value4 ) / 16.0, 4 );
+            }
+
+            appendItem( outBuffer, "LATENCY" );
+            if ( record.value8 == 0 )
+            {
+                appendItem( outBuffer, "OFF" );
+            }
+            else
+            {
+                appendItem( outBuffer, ( double ) record.value8 / 32.0, 6 );
+            }
+
+            appendItem( outBuffer, "TOTAL_STRIDE_COUNT" );
+            appendItem( outBuffer, record.value7 );
+        }
+        else
+        {
+            appendItem( outBuffer, "CADENCE" );
+            if ( ( record.value3 == 0 ) && ( record.value4 == 0 ) )
+            {
+                appendItem( outBuffer, "OFF" );
+            }
+            else
+            {
+                appendItem( outBuffer, ( double ) record.value3 + ( ( double ) record.value4 ) / 16.0, 4 );
+            }
+
+            if ( record.dataPage == 3 )
+            {
+                // Sic: the calories are "OFF" when value1 and value2 (not used by page 3) are 0.
+                appendItem( outBuffer, "CALORIES" );
+                if ( ( record.value1 == 0 ) && ( record.value2 == 0 ) )
+                {
+                    appendItem( outBuffer, "OFF" );
+                }
+                else
+                {
+                    appendItem( outBuffer, record.value7 );
+                }
+            }
+
+            appendItem( outBuffer, "DEVICE_LOCATION" );
+            appendItem( outBuffer, ( ( record.value8 & 0x03 ) == 0 ) ? "LACES"   : (
+                                   ( ( record.value8 & 0x03 ) == 1 ) ? "MIDSOLE" : (
+                                   ( ( record.value8 & 0x03 ) == 2 ) ? "OTHER"   : "ANKLE" ) ) );
+
+            // Sic: the battery status is not shifted, the device health and the use state are not
+            // written at all.
+            appendItem( outBuffer, "BATTERY_STATUS" );
+            appendItem( outBuffer, ( ( record.value8 & 0x0C ) == 0 ) ? "NEW"  : (
+                                   ( ( record.value8 & 0x0C ) == 1 ) ? "GOOD" : (
+                                   ( ( record.value8 & 0x0C ) == 2 ) ? "OK"   : "LOW" ) ) );
+        }
+    }
+    else if ( record.dataPage == 16 )
+    {
+        appendItem( outBuffer, record.value1 );
+        appendItem( outBuffer, ( double ) record.value2 / 256.0, 8 );
+    }
+    else if ( record.dataPage == 22 )
+    {
+        appendItem( outBuffer, "TIME" );
+        appendItem( outBuffer, ( record.value1 &  1 ) ? "VALID" : "INVALID" );
+        appendItem( outBuffer, "DIST" );
+        appendItem( outBuffer, ( record.value1 &  2 ) ? "VALID" : "INVALID" );
+        appendItem( outBuffer, "SPEED" );
+        appendItem( outBuffer, ( record.value1 &  4 ) ? "VALID" : "INVALID" );
+        appendItem( outBuffer, "LATENCY" );
+        appendItem( outBuffer, ( record.value1 &  8 ) ? "VALID" : "INVALID" );
+        appendItem( outBuffer, "CADENCE" );
+        appendItem( outBuffer, ( record.value1 & 16 ) ? "VALID" : "INVALID" );
+        appendItem( outBuffer, "CALORIES" );
+        appendItem( outBuffer, ( record.value1 & 32 ) ? "VALID" : "INVALID" );
+    }
+}
+
+void antCookedFormatter::formatMultiSport
+(
+    const antRecordContext    &context,
+    const antMultiSportRecord &record
+)
+{
+    appendItem( outBuffer, record.dataPage );
+    if ( record.dataPage == 1 )
+    {
+        appendItem( outBuffer, "T" );
+        appendItem( outBuffer, record.totalTime, 3, "s" );
+        appendItem( outBuffer, "D" );
+        appendItem( outBuffer, record.totalDistance, 1, "m" );
+        appendItem( outBuffer, "V" );
+        appendItem( outBuffer, ( double ) record.value3 / 1000.0, 3, "km/h" );
+    }
+    else if ( record.dataPage == 2 )
+    {
+        int latitudeSigned  = NEGATE_BINARY_INT( record.value1, 28 );
+        int longitudeSigned = NEGATE_BINARY_INT( record.value2, 28 );
+        appendItem( outBuffer, "LAT" );
+        appendItem( outBuffer, ( double ) latitudeSigned * C_SSU_2_DEG, 3, "deg" );
+        appendItem( outBuffer, "LON" );
+        appendItem( outBuffer, ( double ) longitudeSigned * C_SSU_2_DEG, 3, "deg" );
+    }
+    else if ( record.dataPage == 3 )
+    {
+        appendItem( outBuffer, "FIX_TYPE" );
+        switch ( record.value1 )
+        {
+            case  0: appendItem( outBuffer, "NO_FIX" );
+                     break;
+            case  1: appendItem( outBuffer, "SEARCHING" );
+                     break;
+            case  2: appendItem( outBuffer, "PROPAGATING" );
+                     break;
+            case  3: appendItem( outBuffer, "LAST_KNOWN_POS" );
+                     break;
+            case  4: appendItem( outBuffer, "2D" );
+                     break;
+            case  5: appendItem( outBuffer, "2D_WAAS" );
+                     break;
+            case  6: appendItem( outBuffer, "2D_DIFFERENTIAL" );
+                     break;
+            case  7: appendItem( outBuffer, "3D" );
+                     break;
+            case  8: appendItem( outBuffer, "3D_WAAS" );
+                     break;
+            case  9: appendItem( outBuffer, "3D_DIFFERENTIAL" );
+                     break;
+            case 15: appendItem( outBuffer, C_INVALID );
+                     break;
+            default: appendItem( outBuffer, C_UNUSED );
+                     break;
+        }
+        appendItem( outBuffer, "HEADING" );
+        appendItem( outBuffer, record.heading, 2 );
+        appendItem( outBuffer, "ELEV" );
+        appendItem( outBuffer, ( double ) record.value3 / 5.0 - 500.0, 1 );
+    }
+    else if ( record.dataPage == 48 )
+    {
+        appendItem( outBuffer, "MODE" );
+        appendItemConditional( outBuffer, record.value1 != 0xFF, record.value1, C_INVALID );
+        if ( record.value2 == 0xFFFF )
+        {
+            appendItem( outBuffer, "CALIBRATION_REQUEST" );
+        }
+        else
+        {
+            appendItem( outBuffer, "SCALE_FACTOR" );
+            appendItem( outBuffer, record.value2 / 10000.0, 5 );
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------//
+//
+// JSON
+//
+//-------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------//
+void antJSONFormatter::formatHRM
+(
+    const antRecordContext &context,
+    const antHRMRecord     &record
+)
+{
+    int dataPageMod128 = record.dataPage & 0x0F;
+
+    appendJSONItem( outBuffer, "heart rate", record.heartRate );
+    if ( semiCooked )
+    {
+        appendJSONItem( outBuffer, "delta heart beat event time", record.deltaHeartBeatEventTime );
+        appendJSONItem( outBuffer, "delta heart beat count",      record.deltaHeartBeatCount );
+    }
+    else
+    {
+        appendJSONItem( outBuffer, "total heart beat event time", record.totalHeartBeatEventTime, valuePrecision );
+        appendJSONItem( outBuffer, "total heart beat count",      record.totalHeartBeatCount );
+    }
+    appendJSONItem( outBuffer, C_DATA_PAGE_JSON, record.dataPage );
+    if ( dataPageMod128 == 1 )
+    {
+        if ( semiCooked )
+        {
+            appendJSONItem( outBuffer, "delta operating time", record.additionalData1 );
+        }
+        else
+        {
+            appendJSONItem( outBuffer, "operating time", 2 * record.additionalData1 );
+        }
+    }
+    else if ( dataPageMod128 == 2 )
+    {
+        appendJSONItem( outBuffer, C_MANUFACTURER_JSON,  record.additionalData1 );
+        appendJSONItem( outBuffer, C_SERIAL_NUMBER_JSON, record.additionalData2 );
+    }
+    else if ( dataPageMod128 == 3 )
+    {
+        appendJSONItem( outBuffer, C_MANUFACTURER_JSON,      record.additionalData1 );
+        appendJSONItem( outBuffer, C_HARDWARE_REVISION_JSON, record.additionalData2 );
+        appendJSONItem( outBuffer, C_MODEL_NUMBER_JSON,      record.additionalData3 );
+    }
+    else if ( dataPageMod128 == 4 )
+    {
+        if ( semiCooked )
+        {
+            appendJSONItem( outBuffer, "delta previous valid heart beat event time", record.additionalData1 );
+        }
+        else
+        {
+            appendJSONItem( outBuffer, "previous valid heart beat event time", record.previousHeartBeatEventTime, valuePrecision );
+        }
+        appendJSONItem( outBuffer, "manufacturer specific data", record.additionalData2 );
+    }
+}
+
+void antJSONFormatter::appendAutoZeroB01
+(
+    unsigned int autoZeroStatus
+)
+{
+    appendJSONItemConditional( outBuffer, "auto zero", autoZeroStatus == 0, "off", ( ( autoZeroStatus == 1 ) ? "on" : "not supported" ) );
+}
+
+void antJSONFormatter::formatPowerB01
+(
+    const antRecordContext  &context,
+    const antPowerB01Record &record
+)
+{
+    if ( semiCooked )
+    {
+        appendJSONItem( outBuffer, "calibration id", record.calibrationID );
+        switch ( record.calibrationID )
+        {
+            case C_CTF_CALIBRATION_MESSAGE_ID:                      //  16 = 0x10: Crank Torque Frequency (CTF) Power Sensor (PWRB20) defined message
+                 appendJSONItem( outBuffer, "ctf defined id", record.calibrationData1 );
+                 appendJSONItem( outBuffer, "message value",  record.calibrationData2 );
+                 break;
+            case C_AUTO_ZERO_SUPPORT_MESSAGE_ID:                    //  18 = 0x12: Auto Zero Support
+                 appendJSONItem( outBuffer, "auto zero enable", record.calibrationData1 );
+                 appendJSONItem( outBuffer, "auto zero status", record.calibrationData2 );
+                 break;
+            case C_CALIBRATION_REQUEST_AUTO_ZERO_ID:                // 171 = 0xAB: Calibration Request - Auto Zero Configuration
+            case C_CALIBRATION_RESPONSE_MANUAL_ZERO_SUCCESS_ID:     // 172 = 0xAC: Calibration Response - Auto Zero Configuration Success
+            case C_CALIBRATION_RESPONSE_MANUAL_ZERO_FAIL_ID:        // 175 = 0xAF: Calibration Response - Auto Zero Configuration Fail
+                 appendJSONItem( outBuffer, "auto zero status", record.calibrationData1 );
+                 break;
+            default:
+                 break;
+        }
+    }
+    else
+    {
+        switch ( record.calibrationID )
+        {
+            case C_CTF_CALIBRATION_MESSAGE_ID:                      //  16 = 0x10: Crank Torque Frequency (CTF) Power Sensor (PWRB20) defined message
+                 if ( record.calibrationData1 == 172 )
+                 {
+                     appendJSONItem( outBuffer, "calibration id", "ctf calibration response" );
+                     if ( record.calibrationData2 == 1 )
+                     {
+                         appendJSONItem( outBuffer, "acknowledgement", C_OFFSET_JSON );
+                     }
+                     else if ( record.calibrationData2 == 2 )
+                     {
+                         appendJSONItem( outBuffer, "acknowledgement", C_SLOPE_JSON );
+                     }
+                     else if ( record.calibrationData2 == 3 )
+                     {
+                         appendJSONItem( outBuffer, "acknowledgement", C_SERIAL_NUMBER_JSON );
+                     }
+                 }
+                 else
+                 {
+                     appendJSONItem( outBuffer, "calibration id", "ctf calibration request" );
+                     if ( record.calibrationData1 == 1 )
+                     {
+                         appendJSONItem( outBuffer, C_OFFSET_JSON, record.calibrationData2 );
+                     }
+                     else if ( record.calibrationData1 == 2 )
+                     {
+                         appendJSONItem( outBuffer, C_SLOPE_10_JSON, record.calibrationData2 );
+                         appendJSONItem( outBuffer, C_SLOPE_JSON,    record.calibrationData2 / 10.0, 1 );
+                     }
+                     else if ( record.calibrationData1 == 3 )
+                     {
+                         appendJSONItem( outBuffer, C_SERIAL_NUMBER_JSON, record.calibrationData2 );
+                     }
+                 }
+                 break;
+            case C_AUTO_ZERO_SUPPORT_MESSAGE_ID:                    //  18 = 0x12: Auto Zero Support
+                 appendJSONItem( outBuffer, "calibration id", "auto zero support" );
+                 appendJSONItemConditional( outBuffer, "auto zero enable", record.calibrationData1 != 0, "supported", "not supported" );
+                 appendJSONItemConditional( outBuffer, "auto zero status", record.calibrationData2 != 0, C_ON_JSON,   C_OFF_JSON );
+                 break;
+            case C_CALIBRATION_REQUEST_MANUAL_ZERO_ID:              // 170 = 0xAA: Calibration Request - Manual Zero
+                 appendJSONItem( outBuffer, "calibration id", "calibration request" );
+                 break;
+            case C_CALIBRATION_REQUEST_AUTO_ZERO_ID:                // 171 = 0xAB: Calibration Request - Auto Zero Configuration
+                 appendJSONItem( outBuffer, "calibration request", "auto zero configuration" );
+                 appendAutoZeroB01( record.calibrationData1 );
+                 break;
+            case C_CALIBRATION_RESPONSE_MANUAL_ZERO_SUCCESS_ID:     // 172 = 0xAC: Calibration Response - Auto Zero Configuration Success
+                 appendJSONItem( outBuffer, "manual zero", "success" );
+                 appendAutoZeroB01( record.calibrationData1 );
+                 appendJSONItem( outBuffer, "value", record.calibrationData2 );
+                 break;
+            case C_CALIBRATION_RESPONSE_MANUAL_ZERO_FAIL_ID:        // 175 = 0xAF: Calibration Response - Auto Zero Configuration Fail
+                 appendJSONItem( outBuffer, "manual zero", "fail" );
+                 appendAutoZeroB01( record.calibrationData1 );
+                 appendJSONItem( outBuffer, "value", record.calibrationData2 );
+                 break;
+            case C_CUSTOM_CALIBRATION_PARAMETER_REQUEST_ID:         // 186 = 0xBA: Custom Calibration Parameter Request
+                 appendJSONItem( outBuffer, "calibration id", "custom calibration parameter request" );
+                 break;
+            case C_CUSTOM_CALIBRATION_PARAMETER_RESPONSE_ID:        // 187 = 0xBB: Custom Calibration Parameter Response
+                 appendJSONItem( outBuffer, "calibration id", "custom calibration parameter response" );
+                 break;
+            case C_CUSTOM_CALIBRATION_PARAMETER_UPDATE_ID:          // 188 = 0xBC: Custom Calibration Parameter Update
+                 appendJSONItem( outBuffer, "calibration id", "custom calibration parameter update" );
+                 break;
+            case C_CUSTOM_CALIBRATION_PARAMETER_UPDATE_RESPONSE_ID: // 189 = 0xBD: Custom Calibration Parameter Update Response
+                 appendJSONItem( outBuffer, "calibration id", "custom calibration parameter update response" );
+                 break;
+            default:
+                 break;
+        }
+    }
+}
+
+void antJSONFormatter::formatPowerB02
+(
+    const antRecordContext  &context,
+    const antPowerB02Record &record
+)
+{
+    appendJSONItem( outBuffer, "subpage number", record.subPage );
+    if ( record.subPage == 1 )
+    {
+        if ( semiCooked )
+        {
+            appendJSONItem( outBuffer, "crank length (raw)",  record.crankLength );
+            appendJSONItem( outBuffer, "sensor status",       record.sensorStatus );
+            appendJSONItem( outBuffer, "sensor capabilities", record.sensorCapabilities );
+        }
+        else
+        {
+            int  crankLengthStatus       = ( record.sensorStatus & 3 );
+            int  sensorSWMismatchStatus  = ( ( record.sensorStatus >> 2 ) & 3 );
+            int  sensorAvailabiltyStatus = ( ( record.sensorStatus >> 4 ) & 3 );
+            int  customCalibrationStatus = ( ( record.sensorStatus >> 6 ) & 3 );
+            bool autoCrankLength         = ( ( record.sensorCapabilities & 1 ) != 0 );
+
+            if ( record.crankLength == 255 )
+            {
+                appendJSONItem( outBuffer, "crank length", C_UNDEFINED_JSON );
+            }
+            else
+            {
+                appendJSONItem( outBuffer, "crank length", 110.0 + ( double ) record.crankLength / 2.0, 1 );   // <xyz>.0  or  <xyz>.5
+            }
+
+            appendJSONItem4Way( outBuffer, "crank length set",   crankLengthStatus,       C_UNDEFINED_JSON, "default length",     "manually set",      "automatically set" );
+            appendJSONItem4Way( outBuffer, "sw mismatch",        sensorSWMismatchStatus,  C_UNDEFINED_JSON, "right sensor older", "left sensor older", C_NONE_JSON );
+            appendJSONItem4Way( outBuffer, "sensor availabilty", sensorAvailabiltyStatus, C_UNDEFINED_JSON, "left present",       "right present",     "both present" );
+            appendJSONItem4Way( outBuffer, "custom calibration", customCalibrationStatus, C_UNDEFINED_JSON, "not required",       "required",          C_UNKNOWN_JSON );
+            appendJSONItemConditional( outBuffer, "determine crank length", autoCrankLength, "automatically", "manually" );
+        }
+    }
+}
+
+void antJSONFormatter::formatPowerB03
+(
+    const antRecordContext  &context,
+    const antPowerB03Record &record
+)
+{
+    if ( semiCooked )
+    {
+        appendJSONItem( outBuffer, "number of data types", record.nbDataTypes );
+        appendJSONItem( outBuffer, "data type",            record.scaleFactor );     // Sic: written like this by the text version
+        appendJSONItem( outBuffer, "scale factor",         record.scaleFactor );
+        appendJSONItem( outBuffer, "delta time stamp",     record.deltaEventTime );
+        appendJSONItem( outBuffer, "value",                record.value );
+    }
+    else
+    {
+        appendJSONItem( outBuffer, "number of data types", record.nbDataTypes );
+        appendJSONItem( outBuffer, "time value",           record.timeValue, valuePrecision );
+        switch ( record.dataType )
+        {
+            case  0: // Countdown (remaining process, in %)
+                     appendJSONItem( outBuffer, "countdown percentage", record.measurementValue, 2 );
+                     break;
+            case  1: // Countdown (time of remaining process, in s)
+                     appendJSONItem( outBuffer, "countdown seconds", record.measurementValue, 2 );
+                     break;
+            case  8: // Torque (whole sensor, in Nm)
+                     appendJSONItem( outBuffer, "total torque", record.measurementValue, 2 );
+                     break;
+            case  9: // Left Torque (in Nm)
+                     appendJSONItem( outBuffer, "left torque", record.measurementValue, 2 );
+                     break;
+            case 10: // Right Torque (in Nm)
+                     appendJSONItem( outBuffer, "right torque", record.measurementValue, 2 );
+                     break;
+            case 16: // Force (whole sensor, in N)
+                     appendJSONItem( outBuffer, "total force", record.measurementValue, 2 );
+                     break;
+            case 17: // Left Force (in N)
+                     appendJSONItem( outBuffer, "left force", record.measurementValue, 2 );
+                     break;
+            case 18: // Right Force (in N)
+                     appendJSONItem( outBuffer, "right force", record.measurementValue, 2 );
+                     break;
+            case 24: // Zero Offset
+                     appendJSONItem( outBuffer, "zero offset", record.measurementValue, 2 );
+                     break;
+            case 25: // Temperature (in degree C)
+                     appendJSONItem( outBuffer, "temperature", record.measurementValue, 2 );
+                     break;
+            case 26: // Voltage (in V)
+                     appendJSONItem( outBuffer, "voltage", record.measurementValue, 2 );
+                     break;
+            default: // Reserved for future use
+                     appendJSONItem( outBuffer, "data type", C_UNDEFINED_JSON );
+                     break;
+        }
+    }
+}
+
+void antJSONFormatter::formatPowerB10
+(
+    const antRecordContext  &context,
+    const antPowerB10Record &record
+)
+{
+    if ( semiCooked )
+    {
+        appendJSONItem( outBuffer, "event count",             record.eventCount );
+        appendJSONItem( outBuffer, "delta event count",       record.deltaEventCount );
+        appendJSONItem( outBuffer, "delta accumulated power", record.deltaAccumulatedPower );
+        appendJSONItem( outBuffer, "instantaneous power",     record.instantaneousPower );
+        appendJSONItemConditional( outBuffer, "instantaneous cadence", record.instantaneousCadence != 255, record.instantaneousCadence, C_UNDEFINED_JSON );
+        appendJSONItem( outBuffer, "pedal power",             record.pedalPower );
+    }
+    else
+    {
+        appendJSONItem( outBuffer, "event count", record.eventCount );
+        appendJSONItem( outBuffer, "power",       record.power, valuePrecision );
+        appendJSONItemConditional( outBuffer, "cadence", record.instantaneousCadence != 255, record.cadence, C_UNDEFINED_JSON );
+        if ( record.isMakeshiftSpeedSensor )
+        {
+            appendJSONItem( outBuffer, "speed",               record.speed,              valuePrecision );
+            appendJSONItem( outBuffer, "wheel circumference", record.wheelCircumference, valuePrecision );
+            appendJSONItem( outBuffer, "gear ratio",          record.gearRatio,          valuePrecision );
+        }
+        appendJSONItemConditional( outBuffer, "pedal contribution percentage", record.pedalPowerContribution >= 0, record.pedalPowerContribution, C_UNKNOWN_JSON );
+        appendJSONItemConditional( outBuffer, "contributing pedal", ( record.pedalPowerContribution >= 0 ) && record.rightPedal, "right", C_UNKNOWN_JSON );
+    }
+}
+
+void antJSONFormatter::formatPowerB11
+(
+    const antRecordContext  &context,
+    const antPowerB11Record &record
+)
+{
+    if ( semiCooked )
+    {
+        appendJSONItem( outBuffer, "delta event count",        record.deltaEventCount );
+        appendJSONItem( outBuffer, "delta wheel period",       record.deltaWheelPeriod );
+        appendJSONItem( outBuffer, "delta accumulated torque", record.deltaAccumulatedTorque );
+        appendJSONItem( outBuffer, "instantaneous cadence",    record.instantaneousCadence );
+        appendJSONItem( outBuffer, "wheel ticks",              record.wheelTicks );
+    }
+    else
+    {
+        appendJSONItem( outBuffer, "power",       record.power,  valuePrecision );
+        appendJSONItem( outBuffer, "cadence",     record.cadence );
+        appendJSONItem( outBuffer, "torque",      record.torque, valuePrecision );
+        appendJSONItem( outBuffer, "wheel ticks", record.wheelTicks );
+        if ( record.isSpeedSensor )
+        {
+            appendJSONItem( outBuffer, "speed",               record.speed,              valuePrecision );
+            appendJSONItem( outBuffer, "wheel circumference", record.wheelCircumference, valuePrecision );
+        }
+    }
+}
+
+void antJSONFormatter::formatPowerB12
+(
+    const antRecordContext  &context,
+    const antPowerB12Record &record
+)
+{
+    if ( semiCooked )
+    {
+        appendJSONItem( outBuffer, "event count",              record.eventCount );
+        appendJSONItem( outBuffer, "delta event count",        record.deltaEventCount );
+        appendJSONItem( outBuffer, "delta crank period",       record.deltaCrankPeriod );
+        appendJSONItem( outBuffer, "delta accumulated torque", record.deltaAccumulatedTorque );
+        appendJSONItem( outBuffer, "instantaneous cadence",    record.instantaneousCadence );
+        appendJSONItem( outBuffer, "crank ticks",              record.crankTicks );
+    }
+    else
+    {
+        appendJSONItem( outBuffer, "event count",           record.eventCount );
+        appendJSONItem( outBuffer, "power",                 record.power,  valuePrecision );
+        appendJSONItem( outBuffer, "cadence",               record.cadence );
+        appendJSONItem( outBuffer, "instantaneous cadence", record.instantaneousCadence );
+        appendJSONItem( outBuffer, "torque",                record.torque, valuePrecision );
+        appendJSONItem( outBuffer, "crank ticks",           record.crankTicks );
+        if ( record.isMakeshiftSpeedSensor )
+        {
+            appendJSONItem( outBuffer, "speed",               record.speed,              valuePrecision );
+            appendJSONItem( outBuffer, "wheel circumference", record.wheelCircumference, valuePrecision );
+            appendJSONItem( outBuffer, "gear ratio",          record.gearRatio,          valuePrecision );
+        }
+    }
+}
+
+// Torque effectiveness and pedal smoothness in %, 255 means invalid.
+void antJSONFormatter::appendPercentageB13
+(
+    const amString &name,
+    unsigned int    value
+)
+{
+    if ( value == 255 )
+    {
+        appendJSONItem( outBuffer, name, C_INVALID_JSON );
+    }
+    else
+    {
+        appendJSONItem( outBuffer, name, ( double ) value / 2.0, 1 );
+    }
+}
+
+void antJSONFormatter::formatPowerB13
+(
+    const antRecordContext  &context,
+    const antPowerB13Record &record
+)
+{
+    if ( semiCooked )
+    {
+        appendJSONItem( outBuffer, "left torque effectiveness",  record.leftTorqueEffectiveness );
+        appendJSONItem( outBuffer, "right torque effectiveness", record.rightTorqueEffectiveness );
+        appendJSONItem( outBuffer, "left pedal smoothness",      record.leftPedalSmoothness );
+        appendJSONItem( outBuffer, "right pedal smoothness",     record.rightPedalSmoothness );
+        appendJSONItem( outBuffer, "delta event count",          record.deltaEventCount );
+    }
+    else
+    {
+        appendPercentageB13( "left torque effectiveness",  record.leftTorqueEffectiveness );
+        appendPercentageB13( "right torque effectiveness", record.rightTorqueEffectiveness );
+        if ( record.rightPedalSmoothness == 254 )
+        {
+            // Pedal Smoothness is combined, no Left/Right Pedal Smoothness.
+            appendPercentageB13( "common pedal smoothness", record.leftPedalSmoothness );
+        }
+        else
+        {
+            appendPercentageB13( "left pedal smoothness",  record.leftPedalSmoothness );
+            appendPercentageB13( "right pedal smoothness", record.rightPedalSmoothness );
+        }
+        appendJSONItem( outBuffer, "event count", record.totalEventCount );
+    }
+}
+
+void antJSONFormatter::formatPowerB20
+(
+    const antRecordContext  &context,
+    const antPowerB20Record &record
+)
+{
+    if ( semiCooked )
+    {
+        appendJSONItem( outBuffer, "delta event count",       record.deltaEventCount );
+        appendJSONItem( outBuffer, "delta time stamp",        record.deltaTimeStamp );
+        appendJSONItem( outBuffer, "delta torque ticks",      record.deltaTorqueTicks );
+        appendJSONItem( outBuffer, "factory slope times ten", record.factorySlope );
+    }
+    else
+    {
+        appendJSONItem( outBuffer, "power",              record.power,        valuePrecision );
+        appendJSONItem( outBuffer, "cadence",            record.cadence );
+        appendJSONItem( outBuffer, "torque",             record.torque,       valuePrecision );
+        appendJSONItem( outBuffer, "power meter offset", record.offset );
+        appendJSONItem( outBuffer, "power meter slope",  record.slope / 10.0, 1 );
+        appendJSONItemConditional( outBuffer, "slope used", record.isFactorySlope, "factory slope", "user-defined slope" );
+        if ( record.isMakeshiftSpeedSensor )
+        {
+            appendJSONItem( outBuffer, "speed",               record.speed,              valuePrecision );
+            appendJSONItem( outBuffer, "wheel circumference", record.wheelCircumference, valuePrecision );
+            appendJSONItem( outBuffer, "gear ratio",          record.gearRatio,          valuePrecision );
+        }
+    }
+}
+
+void antJSONFormatter::appendPageNo
+(
+    bool         outputPageNo,
+    unsigned int dataPage
+)
+{
+    if ( outputPageNo )
+    {
+        appendJSONItem( outBuffer, C_DATA_PAGE_JSON, dataPage );
+    }
+}
+
+void antJSONFormatter::formatCommonPage67
+(
+    const antRecordContext      &context,
+    const antCommonPage67Record &record
+)
+{
+    appendPageNo( record.outputPageNo, 67 );
+    appendJSONItem( outBuffer, "status byte 1",   record.statusByte1 );
+    appendJSONItem( outBuffer, "status byte 2",   record.statusByte2 );
+    appendJSONItem( outBuffer, "authentication",  record.authentication );
+    appendJSONItem( outBuffer, "device type",     record.deviceType );
+    appendJSONItem( outBuffer, "manufacturer id", record.manufacturerID );
+}
+
+void antJSONFormatter::formatCommonPage68
+(
+    const antRecordContext      &context,
+    const antCommonPage68Record &record
+)
+{
+    appendPageNo( record.outputPageNo, 68 );
+    appendJSONItem( outBuffer, "command/response id", record.commandResponseID );
+    appendJSONItem( outBuffer, "channel frequency",   record.channelFrequency );
+    appendJSONItem( outBuffer, "channel period",      record.channelPeriod );
+    appendJSONItem( outBuffer, "host serial number",  record.hostSerialNumber );
+}
+
+void antJSONFormatter::formatCommonPage70
+(
+    const antRecordContext      &context,
+    const antCommonPage70Record &record
+)
+{
+    appendPageNo( record.outputPageNo, 70 );
+    appendJSONItemConditional( outBuffer, "descriptor byte 1 page", semiCooked || ( record.descriptor1 != 255 ), record.descriptor1, C_NONE_ID );
+    appendJSONItemConditional( outBuffer, "descriptor byte 2 page", semiCooked || ( record.descriptor2 != 255 ), record.descriptor2, C_NONE_ID );
+    if ( semiCooked )
+    {
+        appendJSONItem( outBuffer, "requested response",    record.requestedResponse );
+        appendJSONItem( outBuffer, "requested page number", record.requestedPage );
+        appendJSONItem( outBuffer, "command type",          record.commandType );
+    }
+    else
+    {
+        if ( record.requestedResponse == 0 )
+        {
+            appendJSONItem( outBuffer, "number of transmisions", C_INVALID_JSON );
+        }
+        else if ( record.requestedResponse == 128 )
+        {
+            appendJSONItem( outBuffer, "number of transmisions", "until success acknowledged" );
+        }
+        else
+        {
+            appendJSONItem( outBuffer, "number of transmisions", record.requestedResponse & 0x80 );
+            appendJSONItemConditional( outBuffer, "acknowledgement reply", ( record.requestedResponse & 128 ) != 0, C_TRUE_JSON, C_FALSE_JSON );
+        }
+        appendJSONItem( outBuffer, "requested page number", record.requestedPage );
+        appendJSONItemConditional( outBuffer, "command type", record.commandType == 1, "data page", "ant fs session" );
+    }
+}
+
+void antJSONFormatter::formatCommonPage80
+(
+    const antRecordContext      &context,
+    const antCommonPage80Record &record
+)
+{
+    appendPageNo( record.outputPageNo, 80 );
+    appendJSONItem( outBuffer, C_MANUFACTURER_JSON,      record.manufacturerID );
+    appendJSONItem( outBuffer, C_HARDWARE_REVISION_JSON, record.hardwareRevision );
+    appendJSONItem( outBuffer, C_MODEL_NUMBER_JSON,      record.modelNumber );
+}
+
+void antJSONFormatter::formatCommonPage81
+(
+    const antRecordContext      &context,
+    const antCommonPage81Record &record
+)
+{
+    appendPageNo( record.outputPageNo, 81 );
+    appendJSONItemConditional( outBuffer, C_SERIAL_NUMBER_JSON, semiCooked || ( ( int ) record.serialNumber != -1 ), record.serialNumber, C_NONE_ID );
+    appendJSONItem( outBuffer, C_SOFTWARE_REVISION_JSON, record.softwareRevision );
+}
+
+void antJSONFormatter::formatCommonPage82
+(
+    const antRecordContext      &context,
+    const antCommonPage82Record &record
+)
+{
+    appendPageNo( record.outputPageNo, 82 );
+    if ( semiCooked )
+    {
+        appendJSONItem( outBuffer, "voltage256",           record.voltage256 );
+        appendJSONItem( outBuffer, "battery status index", record.status );
+        appendJSONItem( outBuffer, "operating time",       record.deltaOperatingTime );
+        appendJSONItem( outBuffer, "resolution",           record.resolution );
+        appendJSONItem( outBuffer, "number of batteries",  record.nbBatteries );
+        appendJSONItem( outBuffer, "battery no.",          record.batteryID );
+    }
+    else
+    {
+        appendJSONItemConditional( outBuffer, "number of batteries", record.nbBatteries != 0, record.nbBatteries, C_N_A_JSON );
+        appendJSONItemConditional( outBuffer, "battery no.",         record.nbBatteries != 0, record.batteryID,   C_N_A_JSON );
+        appendJSONItem( outBuffer, "voltage",              ( double ) record.voltage256 / 256.0, 2 );
+        appendJSONItem( outBuffer, "battery status",       getBatteryStatus( record.status, true ) );
+        appendJSONItem( outBuffer, "total operating time", record.totalOperatingTime, timePrecision );
+    }
+}
+
+void antJSONFormatter::formatCommonPage83
+(
+    const antRecordContext      &context,
+    const antCommonPage83Record &record
+)
+{
+    appendPageNo( record.outputPageNo, 83 );
+    if ( semiCooked )
+    {
+        appendJSONItem( outBuffer, "year",     record.year );
+        appendJSONItem( outBuffer, "month",    record.month );
+        appendJSONItem( outBuffer, "monthDay", record.monthDay );
+        appendJSONItem( outBuffer, "week day", record.weekDayNo );
+        appendJSONItem( outBuffer, "hours",    record.hours );
+        appendJSONItem( outBuffer, "minutes",  record.minutes );
+        appendJSONItem( outBuffer, "seconds",  record.seconds );
+    }
+    else
+    {
+        appendJSONItem( outBuffer, "date",     date2String( record.year + 2000, record.month, record.monthDay ) );
+        appendJSONItem( outBuffer, "time",     time2String( record.hours, record.minutes, record.seconds ) );
+        appendJSONItem( outBuffer, "week day", getWeekDay( record.weekDayNo ) );
+    }
+}
+
+void antJSONFormatter::formatCommonPage84
+(
+    const antRecordContext      &context,
+    const antCommonPage84Record &record
+)
+{
+    appendPageNo( record.outputPageNo, 84 );
+    if ( semiCooked )
+    {
+        // Sub page 2 repeats sub page 1 (kept for compatibility of the output).
+        appendJSONItem( outBuffer, "sub page 1",   record.subPage1 );
+        appendJSONItem( outBuffer, "data field 1", record.dataField1 );
+        appendJSONItem( outBuffer, "sub page 2",   record.subPage1 );
+        appendJSONItem( outBuffer, "data field 2", record.dataField1 );
+    }
+    else
+    {
+        appendSubPage84( 1, record.subPage1, record.dataField1 );
+        appendSubPage84( 2, record.subPage2, record.dataField2 );
+    }
+}
+
+void antJSONFormatter::appendSubPage84
+(
+    unsigned int subPageNo,
+    unsigned int subPage,
+    unsigned int dataField
+)
+{
+    int      temperature100 = 0;
+    amString auxString;
+
+    switch ( subPage )
+    {
+        case  1: // Temperature
+                 temperature100 = NEGATE_BINARY_INT( dataField, 16 );
+                 appendJSONItem( outBuffer, "temperature value", ( double ) temperature100 / 100.0, 3 );
+                 appendJSONItem( outBuffer, "temperature unit", "celsius" );
+                 break;
+        case  2: // Barometric Pressure
+                 appendJSONItem( outBuffer, "barometric pressure value", ( double ) dataField / 100.0, 3 );
+                 appendJSONItem( outBuffer, "barometric pressure unit", "pascal" );
+                 break;
+        case  3: // Humidity
+                 appendJSONItem( outBuffer, "humidity value", ( double ) dataField / 100.0, 3 );
+                 appendJSONItem( outBuffer, "humidity unit", "percent" );
+                 break;
+        case  4: // Wind Speed (0.01 km/h)
+                 appendJSONItem( outBuffer, "wind speed value", ( double ) dataField / 100.0, 3 );
+                 appendJSONItem( outBuffer, "wind speed unit", "km/h" );
+                 break;
+        case  5: // Wind Direction (0.005 degrees)
+                 appendJSONItem( outBuffer, "wind direction value", ( double ) dataField / 200.0, 3 );
+                 appendJSONItem( outBuffer, "wind direction unit", "degrees" );
+                 break;
+        default: // Undefined
+                 auxString = "sub page ";
+                 auxString.appendNumber( subPageNo );
+                 appendJSONItem( outBuffer, auxString, C_UNKNOWN_JSON );
+                 break;
+    }
+}
+
+void antJSONFormatter::formatEnvironmentPage0
+(
+    const antRecordContext          &context,
+    const antEnvironmentPage0Record &record
+)
+{
+    if ( semiCooked )
+    {
+        appendJSONItem( outBuffer, "data page",         record.dataPage );
+        appendJSONItem( outBuffer, "local time",        record.localTime );
+        appendJSONItem( outBuffer, "utc time",          record.utcTime );
+        appendJSONItem( outBuffer, "transmission rate", record.transmissionRate );
+        appendJSONItem( outBuffer, "supported pages",   record.supportedPages );
+    }
+    else
+    {
+        appendJSONItem( outBuffer, "local time", ( record.localTime == 0 ) ? "set" : (
+                                                 ( record.localTime == 1 ) ? "supported and not set" : (
+                                                 ( record.localTime == 2 ) ? "supported and set"     : C_UNUSED_JSON ) ) );
+
+        appendJSONItem( outBuffer, "utc time", ( record.utcTime == 0 ) ? "set" : (
+                                               ( record.utcTime == 1 ) ? "supported and not set" : (
+                                               ( record.utcTime == 2 ) ? "supported and set"     : C_UNUSED_JSON ) ) );
+
+        appendJSONItem( outBuffer, "transmission rate", ( record.transmissionRate == 0 ) ? "0.5" : (
+                                                        ( record.transmissionRate == 2 ) ? "4.0" : C_UNUSED ) );
+
+        appendJSONItemConditional( outBuffer, "supported pages", record.supportedPages == 0, C_NONE_JSON, getSupportedPages( record.supportedPages ) );
+    }
+}
+
+void antJSONFormatter::formatEnvironmentPage1
+(
+    const antRecordContext          &context,
+    const antEnvironmentPage1Record &record
+)
+{
+    if ( semiCooked )
+    {
+        appendJSONItem( outBuffer, "data page",                     record.dataPage );
+        appendJSONItem( outBuffer, "current temperature times 100", record.currentTemperature );
+        appendJSONItem( outBuffer, "low temperature 24h times 10",  record.lowTemperature24h );
+        appendJSONItem( outBuffer, "high temperature 24h times 10", record.highTemperature24h );
+        appendJSONItem( outBuffer, "event count",                   record.eventCount );
+    }
+    else
+    {
+        appendJSONItem( outBuffer, "current temperature",  record.currentTemp, 2 );
+        appendJSONItem( outBuffer, "low temperature 24h",  record.lowTemp24h,  1 );
+        appendJSONItem( outBuffer, "high temperature 24h", record.highTemp24h, 1 );
+        appendJSONItem( outBuffer, "event count",          record.currentTemperature );   // Sic: written like this by the text version
+    }
+}
+
+void antJSONFormatter::formatCadence
+(
+    const antRecordContext &context,
+    const antCadenceRecord &record
+)
+{
+    int dataPageMod128 = record.dataPage & 0x0F;
+
+    if ( semiCooked )
+    {
+        appendJSONItem( outBuffer, "delta revolution count", record.deltaRevolutionCount );
+        appendJSONItem( outBuffer, "delta event time",       record.deltaEventTime );
+    }
+    else
+    {
+        appendJSONItem( outBuffer, C_CADENCE_JSON, record.cadence );
+        if ( record.isMakeshiftSpeedSensor )
+        {
+            appendJSONItem( outBuffer, "speed",               record.speed,              valuePrecision );
+            appendJSONItem( outBuffer, "wheel circumference", record.wheelCircumference, valuePrecision );
+            appendJSONItem( outBuffer, "gear ratio",          record.gearRatio,          valuePrecision );
+        }
+    }
+    appendJSONItem( outBuffer, C_DATA_PAGE_JSON, record.dataPage );
+    if ( dataPageMod128 == 1 )
+    {
+        if ( semiCooked )
+        {
+            appendJSONItem( outBuffer, "delta operating time", record.additionalData1 );
+        }
+        else
+        {
+            appendJSONItem( outBuffer, "operating time", 2 * record.additionalData1 );
+        }
+    }
+    else if ( dataPageMod128 == 2 )
+    {
+        appendJSONItem( outBuffer, C_MANUFACTURER_JSON,  record.additionalData1 );
+        appendJSONItem( outBuffer, C_SERIAL_NUMBER_JSON, record.additionalData2 );
+    }
+    else if ( dataPageMod128 == 3 )
+    {
+        appendJSONItem( outBuffer, C_HARDWARE_REVISION_JSON, record.additionalData1 );
+        appendJSONItem( outBuffer, C_SOFTWARE_REVISION_JSON, record.additionalData2 );
+        appendJSONItem( outBuffer, C_MODEL_NUMBER_JSON,      record.additionalData3 );
+    }
+}
+
+void antJSONFormatter::formatSpeed
+(
+    const antRecordContext &context,
+    const antSpeedRecord   &record
+)
+{
+    int dataPageMod128 = record.dataPage & 0x0F;
+
+    if ( semiCooked )
+    {
+        appendJSONItem( outBuffer, "delta bike speed event time",  record.deltaEventTime );
+        appendJSONItem( outBuffer, "delta wheel revolution count", record.deltaRevolutionCount );
+    }
+    else
+    {
+        appendJSONItem( outBuffer, C_SPEED_JSON,          record.speed,              valuePrecision );
+        appendJSONItem( outBuffer, "wheel circumference", record.wheelCircumference, valuePrecision );
+        appendJSONItem( outBuffer, "number of magnets",   record.numberOfMagnets );
+    }
+    appendJSONItem( outBuffer, C_DATA_PAGE_JSON, record.dataPage );
+    if ( dataPageMod128 == 1 )
+    {
+        if ( semiCooked )
+        {
+            appendJSONItem( outBuffer, "delta operating time", record.additionalData1 );
+        }
+        else
+        {
+            appendJSONItem( outBuffer, "operating time", 2 * record.additionalData1 );
+        }
+    }
+    else if ( dataPageMod128 == 2 )
+    {
+        appendJSONItem( outBuffer, C_MANUFACTURER_JSON,  record.additionalData1 );
+        appendJSONItem( outBuffer, C_SERIAL_NUMBER_JSON, record.additionalData2 );
+    }
+    else if ( dataPageMod128 == 3 )
+    {
+        appendJSONItem( outBuffer, C_MANUFACTURER_JSON,      record.additionalData1 );
+        appendJSONItem( outBuffer, C_HARDWARE_REVISION_JSON, record.additionalData2 );
+        appendJSONItem( outBuffer, C_MODEL_NUMBER_JSON,      record.additionalData3 );
+    }
+    else
+    {
+        appendJSONItem( outBuffer, "additional data 1", record.additionalData1 );
+        appendJSONItem( outBuffer, "additional data 1", record.additionalData2 );   // Sic
+        appendJSONItem( outBuffer, "additional data 3", record.additionalData3 );
+    }
+}
+
+void antJSONFormatter::formatSpeedCadence
+(
+    const antRecordContext      &context,
+    const antSpeedCadenceRecord &record
+)
+{
+    if ( semiCooked )
+    {
+        appendJSONItem( outBuffer, "delta speed event time",       record.deltaSpeedEventTime );
+        appendJSONItem( outBuffer, "delta wheel revolution count", record.deltaWheelRevolutionCount );
+        appendJSONItem( outBuffer, "delta cadence event time",     record.deltaCadenceEventTime );
+        appendJSONItem( outBuffer, "delta crank revolution count", record.deltaCrankRevolutionCount );
+    }
+    else
+    {
+        appendJSONItem( outBuffer, C_SPEED_JSON,          record.speed,              valuePrecision );
+        appendJSONItem( outBuffer, "wheel circumference", record.wheelCircumference, valuePrecision );
+        appendJSONItem( outBuffer, "number of magnets",   record.numberOfMagnets );
+        appendJSONItem( outBuffer, C_CADENCE_JSON,        record.cadence );
+    }
+}
+
+void antJSONFormatter::formatAero
+(
+    const antRecordContext &context,
+    const antAeroRecord    &record
+)
+{
+    if ( semiCooked )
+    {
+        appendJSONItem( outBuffer, "raw air speed", record.airSpeedRaw );
+        appendJSONItem( outBuffer, "raw yaw angle", record.yawAngleRaw );
+    }
+    else
+    {
+        appendJSONItem( outBuffer, "air speed",               record.airSpeed,           valuePrecision );
+        appendJSONItem( outBuffer, "yaw angle",               record.yawAngle,           valuePrecision );
+        appendJSONItem( outBuffer, "calibration air density", record.calibrationRho,     valuePrecision );
+        appendJSONItem( outBuffer, "air speed multiplier",    record.airSpeedMultiplier, valuePrecision );
+        appendJSONItem( outBuffer, "current air density",     record.currentRho,         valuePrecision );
+    }
+}
+
+void antJSONFormatter::formatWeightScale
+(
+    const antRecordContext     &context,
+    const antWeightScaleRecord &record
+)
+{
+    appendJSONItem( outBuffer, "data page", record.dataPage );
+    appendJSONItemConditional( outBuffer, "user profile", semiCooked || ( record.userProfile != 0xFFFF ), record.userProfile, C_INVALID_JSON );
+    if ( semiCooked )
+    {
+        switch ( record.dataPage )
+        {
+            case  1: appendJSONItem( outBuffer, "capabilities", record.value1 );
+                     appendJSONItem( outBuffer, "body weight",  record.value2 );
+                     break;
+            case  2: appendJSONItem( outBuffer, "hydration", record.value1 );
+                     appendJSONItem( outBuffer, "body fat",  record.value2 );
+                     break;
+            case  3: appendJSONItem( outBuffer, "active metabolic rate", record.value1 );
+                     appendJSONItem( outBuffer, "basal metabolic rate",  record.value2 );
+                     break;
+            case  4: appendJSONItem( outBuffer, "muscle mass", record.value1 );
+                     appendJSONItem( outBuffer, "bone mass",   record.value2 );
+                     break;
+            case 58: appendJSONItem( outBuffer, "capabilities", record.value1 );
+                     appendJSONItem( outBuffer, "gender",       record.value2 );
+                     appendJSONItem( outBuffer, "age",          record.age );
+                     appendJSONItem( outBuffer, "user height",  record.userHeight );
+                     appendJSONItem( outBuffer, "descript bit", record.descriptBit );
+                     break;
+        }
+    }
+    else if ( ( record.dataPage == 1 ) || ( record.dataPage == 58 ) )
+    {
+        // Sic: the capabilities are written as numbers, not as JSON booleans.
+        appendJSONItem( outBuffer, "scale user profile selected",           ( record.value1 &   1        ) ? 1 : 0 );
+        appendJSONItem( outBuffer, "scale user profile exchange capable",   ( record.value1 & ( 1 << 1 ) ) ? 1 : 0 );
+        appendJSONItem( outBuffer, "ant fs channel avaliable",              ( record.value1 & ( 1 << 2 ) ) ? 1 : 0 );
+        appendJSONItem( outBuffer, "display user profile exchange capable", ( record.value1 & ( 1 << 7 ) ) ? 1 : 0 );
+        if ( record.dataPage == 1 )
+        {
+            if ( ( record.value2 == 0xFFFF ) || ( record.value2 == 0xFFFE ) )
+            {
+                appendJSONItem( outBuffer, "body weight", ( record.value2 == 0xFFFF ) ? C_INVALID_JSON : "computing" );
+            }
+            else
+            {
+                appendJSONItem( outBuffer, "body weight", ( double ) record.value2 / 100.0, 2 );
+            }
+        }
+        else
+        {
+            // Sic: the gender is taken from the capabilities and the age from the gender.
+            if ( ( record.value2 == 0 ) && ( record.age == 0 ) )
+            {
+                appendJSONItem( outBuffer, "gender", "not set" );
+                appendJSONItem( outBuffer, "age",    "not set" );
+            }
+            else
+            {
+                appendJSONItem( outBuffer, "gender", ( record.value1 == 0 ) ? "female" : "male" );
+                appendJSONItem( outBuffer, "age",    record.value2 );
+            }
+
+            if ( record.userHeight == 0 )
+            {
+                appendJSONItem( outBuffer, "height", "not set" );
+            }
+            else
+            {
+                appendJSONItem( outBuffer, "height", record.userHeight );
+            }
+
+            appendJSONItem( outBuffer, "athlete type",   ( ( record.descriptBit & ( 1 << 7 ) ) != 0 ) ? "lifetime" : "standard" );
+            appendJSONItem( outBuffer, "activity class", record.descriptBit >> 6 );
+        }
+    }
+    else if ( record.dataPage == 2 )
+    {
+        if ( ( record.value1 == 0xFFFF ) || ( record.value1 == 0xFFFE ) )
+        {
+            appendJSONItem( outBuffer, "hydration percentage", ( record.value1 == 0xFFFF ) ? C_INVALID_JSON : "computing" );
+        }
+        else
+        {
+            appendJSONItem( outBuffer, "hydration percentage", ( double ) record.value1 / 100.0, 2 );
+        }
+
+        if ( ( record.value2 == 0xFFFF ) || ( record.value2 == 0xFFFE ) )
+        {
+            appendJSONItem( outBuffer, "body fat percentage", ( record.value2 == 0xFFFF ) ? C_INVALID_JSON : "computing" );
+        }
+        else
+        {
+            appendJSONItem( outBuffer, "body fat percentage", ( double ) record.value2 / 100.0, 2 );
+        }
+    }
+    else if ( record.dataPage == 3 )
+    {
+        if ( ( record.value1 == 0xFFFF ) || ( record.value1 == 0xFFFE ) )
+        {
+            appendJSONItem( outBuffer, "active metabolic rate", ( record.value1 == 0xFFFF ) ? C_INVALID_JSON : "computing" );
+        }
+        else
+        {
+            appendJSONItem( outBuffer, "active metabolic rate", ( double ) record.value1 / 100.0, 2 );
+        }
+
+        if ( ( record.value2 == 0xFFFF ) || ( record.value2 == 0xFFFE ) )
+        {
+            appendJSONItem( outBuffer, "basal metabolic rate", ( record.value2 == 0xFFFF ) ? C_INVALID_JSON : "computing" );
+        }
+        else
+        {
+            appendJSONItem( outBuffer, "basal metabolic rate", ( double ) record.value2 / 100.0, 2 );
+        }
+    }
+    else if ( record.dataPage == 4 )
+    {
+        if ( ( record.value1 == 0xFFFF ) || ( record.value1 == 0xFFFE ) )
+        {
+            appendJSONItem( outBuffer, "muscle mass", ( record.value1 == 0xFFFF ) ? C_INVALID_JSON : "computing" );
+        }
+        else
+        {
+            appendJSONItem( outBuffer, "muscle mass", ( double ) record.value1 / 100.0, 2 );
+        }
+
+        // Sic: an invalid bone mass (0xFF) is written as "computing".
+        if ( ( record.value2 == 0xFF ) || ( record.value2 == 0xFE ) )
+        {
+            appendJSONItem( outBuffer, "bone mass", "computing" );
+        }
+        else
+        {
+            appendJSONItem( outBuffer, "bone mass", ( double ) record.value2 / 10.0, 1 );
+        }
+    }
+}
+
+void antJSONFormatter::formatAudioPage1
+(
+    const antRecordContext    &context,
+    const antAudioPage1Record &record
+)
+{
+    appendJSONItem( outBuffer, "data page",          record.dataPage );
+    appendJSONItem( outBuffer, "volume",             record.volume );
+    appendJSONItem( outBuffer, "total track time",   record.totalTrackTime );
+    appendJSONItem( outBuffer, "current track time", record.currentTrackTime );
+    if ( semiCooked )
+    {
+        appendJSONItem( outBuffer, "status", record.state );
+    }
+    else
+    {
+        // Sic: the states are taken from the current track time, not from the state byte, and the
+        // repeat state is not shifted.
+        unsigned int audioDeviceState = record.currentTrackTime >> 4;
+        switch ( audioDeviceState )
+        {
+            case  0: appendJSONItem( outBuffer, "status", "off" );
+                     break;
+            case  1: appendJSONItem( outBuffer, "status", "play" );
+                     break;
+            case  2: appendJSONItem( outBuffer, "status", "paused" );
+                     break;
+            case  3: appendJSONItem( outBuffer, "status", "stopped" );
+                     break;
+            case  4: appendJSONItem( outBuffer, "status", "busy" );
+                     break;
+            case 15: appendJSONItem( outBuffer, "status", C_UNKNOWN_JSON );
+                     break;
+            default: appendJSONItem( outBuffer, "status", "reserved" );
+                     break;
+        }
+
+        if ( audioDeviceState != 15 )
+        {
+            switch ( record.currentTrackTime & 0x0C )
+            {
+                case  0: appendJSONItem( outBuffer, "repeat", "off" );
+                         break;
+                case  1: appendJSONItem( outBuffer, "repeat", "current track" );
+                         break;
+                case  2: appendJSONItem( outBuffer, "repeat", "all" );
+                         break;
+                default: appendJSONItem( outBuffer, "repeat", "reserved" );
+                         break;
+            }
+
+            switch ( record.currentTrackTime & 0x03 )
+            {
+                case  0: appendJSONItem( outBuffer, "shuffle", "off" );
+                         break;
+                case  1: appendJSONItem( outBuffer, "shuffle", "track level" );
+                         break;
+                case  2: appendJSONItem( outBuffer, "shuffle", "album level" );
+                         break;
+                default: appendJSONItem( outBuffer, "shuffle", "reserved" );
+                         break;
+            }
+        }
+    }
+}
+
+void antJSONFormatter::formatAudioPage16
+(
+    const antRecordContext     &context,
+    const antAudioPage16Record &record
+)
+{
+    appendJSONItem( outBuffer, "data page", record.dataPage );
+    if ( semiCooked )
+    {
+        appendJSONItem( outBuffer, "serial number",  record.serialNumber );
+        appendJSONItem( outBuffer, "command number", record.commandNumber );
+    }
+    else
+    {
+        appendJSONItemConditional( outBuffer, "serial number", record.serialNumber != 0xFFFF, record.serialNumber, C_UNKNOWN_JSON );
+        appendJSONItem( outBuffer, "command number", record.commandNumber );
+        switch ( record.commandNumber )
+        {
+            case  1: appendJSONItem( outBuffer, "command", "off" );
+                     break;
+            case  2: appendJSONItem( outBuffer, "command", "pause" );
+                     break;
+            case  3: appendJSONItem( outBuffer, "command", "stop" );
+                     break;
+            case  4: appendJSONItem( outBuffer, "command", "volume up" );
+                     break;
+            case  5: appendJSONItem( outBuffer, "command", "volume down" );
+                     break;
+            case  6: appendJSONItem( outBuffer, "command", "mute" );
+                     break;
+            case  7: appendJSONItem( outBuffer, "command", "track ahead" );
+                     break;
+            case  8: appendJSONItem( outBuffer, "command", "track back" );
+                     break;
+            case  9: appendJSONItem( outBuffer, "command", "repeat current track" );
+                     break;
+            case 10: appendJSONItem( outBuffer, "command", "repeat all" );
+                     break;
+            case 11: appendJSONItem( outBuffer, "command", "repeat off" );
+                     break;
+            case 12: appendJSONItem( outBuffer, "command", "shuffle songs" );
+                     break;
+            case 13: appendJSONItem( outBuffer, "command", "shuffle albums" );
+                     break;
+            case 14: appendJSONItem( outBuffer, "command", "shuffle off" );
+                     break;
+            case 15: appendJSONItem( outBuffer, "command", "fast forward through track" );
+                     break;
+            case 16: appendJSONItem( outBuffer, "command", "fast rewind through track" );
+                     break;
+            default: appendJSONItem( outBuffer, "command", "reserved" );
+                     break;
+        }
+    }
+}
+
+void antJSONFormatter::formatStrideSpeedDist
+(
+    const antRecordContext         &context,
+    const antStrideSpeedDistRecord &record
+)
+{
+    appendJSONItem( outBuffer, "data page", record.dataPage );
+    if ( ( record.dataPage >= 1 ) && ( record.dataPage <= 15 ) )
+    {
+        if ( semiCooked )
+        {
+            appendJSONItem( outBuffer, "delta speed integer part", record.value5 );
+            appendJSONItem( outBuffer, "speed fractional part",    record.value6 );
+            if ( record.dataPage == 1 )
+            {
+                appendJSONItem( outBuffer, "delta time integer part",     record.value1 );
+                appendJSONItem( outBuffer, "time fractional part",        record.value2 );
+                appendJSONItem( outBuffer, "delta distance integer part", record.value3 );
+                appendJSONItem( outBuffer, "distance fractional part",    record.value4 );
+                appendJSONItem( outBuffer, "delta stride count",          record.value7 );
+                appendJSONItem( outBuffer, "latency",                     record.value8 );
+            }
+            else
+            {
+                appendJSONItem( outBuffer, "cadence integer part",    record.value3 );
+                appendJSONItem( outBuffer, "cadence fractional part", record.value4 );
+                if ( record.dataPage == 3 )
+                {
+                    appendJSONItem( outBuffer, "calories", record.value7 );
+                }
+                appendJSONItem( outBuffer, "smd status", record.value8 );
+            }
+        }
+        else
+        {
+            if ( ( record.value5 == 0 ) && ( record.value6 == 0 ) )
+            {
+                appendJSONItem( outBuffer, "speed", "off" );
+            }
+            else
+            {
+                appendJSONItem( outBuffer, "speed", ( double ) record.value5 + ( ( double ) record.value6 ) / 256.0, 8 );
+            }
+
+            if ( record.dataPage == 1 )
+            {
+                if ( ( record.value1 == 0 ) && ( record.value2 == 0 ) )
+                {
+                    appendJSONItem( outBuffer, "total time", "off" );
+                }
+                else
+                {
+                    appendJSONItem( outBuffer, "total time", ( double ) record.value1 + ( ( double ) record.value2 ) / 200.0, 3 );
+                }
+
+                if ( ( record.value3 == 0 ) && ( record.value4 == 0 ) )
+                {
+                    appendJSONItem( outBuffer, "total distance", "off" );
+                }
+                else
+                {
+                    appendJSONItem( outBuffer, "total distance", ( double ) record.value3 + ( ( double ) record.value4 ) / 16.0, 4 );
+                }
+
+                if ( record.value8 == 0 )
+                {
+                    appendJSONItem( outBuffer, "latency", "off" );
+                }
+                else
+                {
+                    appendJSONItem( outBuffer, "latency", ( double ) record.value8 / 32.0, 6 );
+                }
+            }
+            else
+            {
+                if ( ( record.value3 == 0 ) && ( record.value4 == 0 ) )
+                {
+                    appendJSONItem( outBuffer, "cadence", "off" );
+                }
+                else
+                {
+                    appendJSONItem( outBuffer, "cadence", ( double ) record.value3 + ( ( double ) record.value4 ) / 16.0, 3 );
+                }
+
+                if ( record.dataPage == 3 )
+                {
+                    if ( record.value7 == 0 )
+                    {
+                        appendJSONItem( outBuffer, "calories", "off" );
+                    }
+                    else
+                    {
+                        appendJSONItem( outBuffer, "calories", record.value7 );
+                    }
+                }
+
+                appendJSONItem( outBuffer, "smd location", ( ( record.value8 & 0x03 ) == 0 ) ? "laces"   : (
+                                                           ( ( record.value8 & 0x03 ) == 1 ) ? "midsole" : (
+                                                           ( ( record.value8 & 0x03 ) == 2 ) ? "other"   : "ankle" ) ) );
+
+                // Sic: the battery status is not shifted, the device health and the use state are not
+                // written at all.
+                appendJSONItem( outBuffer, "battery status", ( ( record.value8 & 0x0C ) == 0 ) ? "new"  : (
+                                                             ( ( record.value8 & 0x0C ) == 1 ) ? "good" : (
+                                                             ( ( record.value8 & 0x0C ) == 2 ) ? "ok"   : "low" ) ) );
+            }
+        }
+    }
+    else if ( record.dataPage == 16 )
+    {
+        appendJSONItem( outBuffer, "strides since reset", record.value1 );
+        if ( semiCooked )
+        {
+            appendJSONItem( outBuffer, "distance since reset", record.value2 );
+        }
+        else
+        {
+            appendJSONItem( outBuffer, "distance since reset", ( double ) record.value2 / 256.0, 8 );
+        }
+    }
+    else if ( record.dataPage == 22 )
+    {
+        if ( semiCooked )
+        {
+            appendJSONItem( outBuffer, "capabilities", record.value1 );
+        }
+        else
+        {
+            appendJSONItem( outBuffer, "time",     ( record.value1 &  1 ) ? "valid" : "invalid" );
+            appendJSONItem( outBuffer, "distance", ( record.value1 &  2 ) ? "valid" : "invalid" );
+            appendJSONItem( outBuffer, "speed",    ( record.value1 &  4 ) ? "valid" : "invalid" );
+            appendJSONItem( outBuffer, "latency",  ( record.value1 &  8 ) ? "valid" : "invalid" );
+            appendJSONItem( outBuffer, "cadence",  ( record.value1 & 16 ) ? "valid" : "invalid" );
+            appendJSONItem( outBuffer, "calories", ( record.value1 & 32 ) ? "valid" : "invalid" );
+        }
+    }
+}
+
+void antJSONFormatter::formatMultiSport
+(
+    const antRecordContext    &context,
+    const antMultiSportRecord &record
+)
+{
+    appendJSONItem( outBuffer, "data page", record.dataPage );
+    if ( semiCooked )
+    {
+        if ( record.dataPage == 1 )
+        {
+            appendJSONItem( outBuffer, "delta event time",     record.value1 );
+            appendJSONItem( outBuffer, "delta event distance", record.value2 );
+            appendJSONItem( outBuffer, "event speed",          record.value3 );
+        }
+        else if ( record.dataPage == 2 )
+        {
+            appendJSONItem( outBuffer, "latitude",  record.value1 );
+            appendJSONItem( outBuffer, "longitude", record.value2 );
+        }
+        else if ( record.dataPage == 3 )
+        {
+            appendJSONItem( outBuffer, "fix type",  record.value1 );
+            appendJSONItem( outBuffer, "heading",   record.value2 );
+            appendJSONItem( outBuffer, "elevation", record.value3 );
+        }
+        else if ( record.dataPage == 48 )
+        {
+            appendJSONItem( outBuffer, "mode",         record.value1 );
+            appendJSONItem( outBuffer, "scale factor", record.value2 );
+        }
+    }
+    else if ( record.dataPage == 1 )
+    {
+        appendJSONItem( outBuffer, "time",     record.totalTime,                 3 );
+        appendJSONItem( outBuffer, "distance", record.totalDistance,             1 );
+        appendJSONItem( outBuffer, "speed",    ( double ) record.value3 / 1000.0, 3 );
+    }
+    else if ( record.dataPage == 2 )
+    {
+        int latitudeSigned  = NEGATE_BINARY_INT( record.value1, 28 );
+        int longitudeSigned = NEGATE_BINARY_INT( record.value2, 28 );
+        appendJSONItem( outBuffer, "latitude",  ( double ) latitudeSigned  * C_SSU_2_DEG, valuePrecision );
+        appendJSONItem( outBuffer, "longitude", ( double ) longitudeSigned * C_SSU_2_DEG, valuePrecision );
+    }
+    else if ( record.dataPage == 3 )
+    {
+        switch ( record.value1 )
+        {
+            case  0: appendJSONItem( outBuffer, "fix type", "no fix" );
+                     break;
+            case  1: appendJSONItem( outBuffer, "fix type", "searching" );
+                     break;
+            case  2: appendJSONItem( outBuffer, "fix type", "propagating" );
+                     break;
+            case  3: appendJSONItem( outBuffer, "fix type", "last known position" );
+                     break;
+            case  4: appendJSONItem( outBuffer, "fix type", "2d" );
+                     break;
+            case  5: appendJSONItem( outBuffer, "fix type", "2d waas" );
+                     break;
+            case  6: appendJSONItem( outBuffer, "fix type", "2d differential" );
+                     break;
+            case  7: appendJSONItem( outBuffer, "fix type", "3d" );
+                     break;
+            case  8: appendJSONItem( outBuffer, "fix type", "3d waas" );
+                     break;
+            case  9: appendJSONItem( outBuffer, "fix type", "3d differential" );
+                     break;
+            case 15: appendJSONItem( outBuffer, "fix type", C_INVALID_JSON );
+                     break;
+            default: appendJSONItem( outBuffer, "fix type", C_UNUSED_JSON );
+                     break;
+        }
+        appendJSONItem( outBuffer, "heading",   record.heading,                        2 );
+        appendJSONItem( outBuffer, "elevation", ( double ) record.value3 / 5.0 - 500.0, 1 );
+    }
+    else if ( record.dataPage == 48 )
+    {
+        if ( record.value1 == 0xFF )
+        {
+            appendJSONItem( outBuffer, "mode", C_INVALID_JSON );
+        }
+        else
+        {
+            appendJSONItem( outBuffer, "mode", record.value1 );
+        }
+
+        if ( record.value2 == 0xFFFF )
+        {
+            // Sic: written as 1, not as true.
+            appendJSONItem( outBuffer, "calibration request", 1 );
+        }
+        else
+        {
+            appendJSONItem( outBuffer, "scale factor", record.value2 / 10000.0, 5 );
+        }
+    }
+}
+
+void antJSONFormatter::formatUnsupportedPage
+(
+    const antRecordContext         &context,
+    const antUnsupportedPageRecord &record
+)
+{
+    appendJSONItem( outBuffer, C_UNSUPPORTED_DATA_PAGE_JSON, record.dataPage );
+    for ( unsigned int counter = 0; counter < C_ANT_PAYLOAD_LENGTH; ++counter )
+    {
+        appendJSONHexItem( outBuffer, "byte", counter, record.payLoad[ counter ] );
+    }
+}
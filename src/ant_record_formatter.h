@@ -0,0 +1,271 @@
+#ifndef __ANT_RECORD_FORMATTER_H__
+#define __ANT_RECORD_FORMATTER_H__
+
+#include "am_string.h"
+#include "ant_records.h"
+
+// Identification of a record: the texts written in front of and behind its values.
+struct antRecordContext
+{
+    const amString &sensorID;
+    const amString &timeStamp;
+    const amString &version;
+
+    antRecordContext( const amString &sensorIDIn, const amString &timeStampIn, const amString &versionIn )
+        : sensorID( sensorIDIn ), timeStamp( timeStampIn ), version( versionIn ) {}
+};
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Back-end writing decoded records (see ant_records.h).
+// antProcessing writes every record with the text formatter selected by the output options and
+// then hands it to the record sinks added with addRecordSink(), so one decode can feed several
+// outputs. By default the typed methods pass the record on to formatRecord() with its record type:
+// a back-end which handles all record types alike (binary output, library callback) only overrides
+// formatRecord(), one which is not interested in a record type leaves it out.
+//
+// -------------------------------------------------------------------------------------------------//
+class antRecordFormatter
+{
+
+    protected:
+
+        virtual void formatRecord( int recordType, const antRecordContext &context, const void *record ) {}
+
+
+    public:
+
+        virtual ~antRecordFormatter( void ) {}
+
+        virtual void formatHRM             ( const antRecordContext &context, const antHRMRecord &record )              { formatRecord( ANT_HRM_RECORD,               context, &record ); }
+        virtual void formatPowerB01        ( const antRecordContext &context, const antPowerB01Record &record )         { formatRecord( ANT_POWER_B01_RECORD,         context, &record ); }
+        virtual void formatPowerB02        ( const antRecordContext &context, const antPowerB02Record &record )         { formatRecord( ANT_POWER_B02_RECORD,         context, &record ); }
+        virtual void formatPowerB03        ( const antRecordContext &context, const antPowerB03Record &record )         { formatRecord( ANT_POWER_B03_RECORD,         context, &record ); }
+        virtual void formatPowerB10        ( const antRecordContext &context, const antPowerB10Record &record )         { formatRecord( ANT_POWER_B10_RECORD,         context, &record ); }
+        virtual void formatPowerB11        ( const antRecordContext &context, const antPowerB11Record &record )         { formatRecord( ANT_POWER_B11_RECORD,         context, &record ); }
+        virtual void formatPowerB12        ( const antRecordContext &context, const antPowerB12Record &record )         { formatRecord( ANT_POWER_B12_RECORD,         context, &record ); }
+        virtual void formatPowerB13        ( const antRecordContext &context, const antPowerB13Record &record )         { formatRecord( ANT_POWER_B13_RECORD,         context, &record ); }
+        virtual void formatPowerB20        ( const antRecordContext &context, const antPowerB20Record &record )         { formatRecord( ANT_POWER_B20_RECORD,         context, &record ); }
+        virtual void formatCommonPage67    ( const antRecordContext &context, const antCommonPage67Record &record )     { formatRecord( ANT_COMMON_PAGE67_RECORD,     context, &record ); }
+        virtual void formatCommonPage68    ( const antRecordContext &context, const antCommonPage68Record &record )     { formatRecord( ANT_COMMON_PAGE68_RECORD,     context, &record ); }
+        virtual void formatCommonPage70    ( const antRecordContext &context, const antCommonPage70Record &record )     { formatRecord( ANT_COMMON_PAGE70_RECORD,     context, &record ); }
+        virtual void formatCommonPage80    ( const antRecordContext &context, const antCommonPage80Record &record )     { formatRecord( ANT_COMMON_PAGE80_RECORD,     context, &record ); }
+        virtual void formatCommonPage81    ( const antRecordContext &context, const antCommonPage81Record &record )     { formatRecord( ANT_COMMON_PAGE81_RECORD,     context, &record ); }
+        virtual void formatCommonPage82    ( const antRecordContext &context, const antCommonPage82Record &record )     { formatRecord( ANT_COMMON_PAGE82_RECORD,     context, &record ); }
+        virtual void formatCommonPage83    ( const antRecordContext &context, const antCommonPage83Record &record )     { formatRecord( ANT_COMMON_PAGE83_RECORD,     context, &record ); }
+        virtual void formatCommonPage84    ( const antRecordContext &context, const antCommonPage84Record &record )     { formatRecord( ANT_COMMON_PAGE84_RECORD,     context, &record ); }
+        virtual void formatEnvironmentPage0( const antRecordContext &context, const antEnvironmentPage0Record &record ) { formatRecord( ANT_ENVIRONMENT_PAGE0_RECORD, context, &record ); }
+        virtual void formatEnvironmentPage1( const antRecordContext &context, const antEnvironmentPage1Record &record ) { formatRecord( ANT_ENVIRONMENT_PAGE1_RECORD, context, &record ); }
+        virtual void formatCadence         ( const antRecordContext &context, const antCadenceRecord &record )          { formatRecord( ANT_CADENCE_RECORD,           context, &record ); }
+        virtual void formatSpeed           ( const antRecordContext &context, const antSpeedRecord &record )            { formatRecord( ANT_SPEED_RECORD,             context, &record ); }
+        virtual void formatSpeedCadence    ( const antRecordContext &context, const antSpeedCadenceRecord &record )     { formatRecord( ANT_SPEED_CADENCE_RECORD,     context, &record ); }
+        virtual void formatAero            ( const antRecordContext &context, const antAeroRecord &record )             { formatRecord( ANT_AERO_RECORD,              context, &record ); }
+        virtual void formatWeightScale     ( const antRecordContext &context, const antWeightScaleRecord &record )      { formatRecord( ANT_WEIGHT_SCALE_RECORD,      context, &record ); }
+        virtual void formatAudioPage1      ( const antRecordContext &context, const antAudioPage1Record &record )       { formatRecord( ANT_AUDIO_PAGE1_RECORD,       context, &record ); }
+        virtual void formatAudioPage16     ( const antRecordContext &context, const antAudioPage16Record &record )      { formatRecord( ANT_AUDIO_PAGE16_RECORD,      context, &record ); }
+        virtual void formatStrideSpeedDist ( const antRecordContext &context, const antStrideSpeedDistRecord &record )  { formatRecord( ANT_STRIDE_SPEED_DIST_RECORD, context, &record ); }
+        virtual void formatMultiSport      ( const antRecordContext &context, const antMultiSportRecord &record )       { formatRecord( ANT_MULTI_SPORT_RECORD,       context, &record ); }
+        virtual void formatUnsupportedPage ( const antRecordContext &context, const antUnsupportedPageRecord &record )  { formatRecord( ANT_UNSUPPORTED_PAGE_RECORD,  context, &record ); }
+
+};
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Text back-ends.
+// They append the values of a record to a text buffer, the sensor ID, time stamp and version
+// around the values are written by antProcessing (createOutputHeader(), appendOutputFooter()).
+// The item functions are shared with antProcessing, which uses them for the profiles that still
+// write their text directly.
+// antTextFormatter itself writes the pages which look the same in semi-cooked and cooked text.
+//
+// -------------------------------------------------------------------------------------------------//
+class antTextFormatter : public antRecordFormatter
+{
+
+    protected:
+
+        amString  &outBuffer;
+        const int &valuePrecision;
+        const int &timePrecision;
+
+        // Data page in front of the values of a common page (see antCommonPage67Record).
+        virtual void appendPageNo( bool outputPageNo, unsigned int dataPage );
+
+        static amString getBatteryStatus ( unsigned int index, bool lowerCase );
+        static amString getWeekDay       ( unsigned int weekDayNo );
+        static amString getSupportedPages( unsigned int supportedPages );
+
+
+    public:
+
+        antTextFormatter( amString &buffer, const int &valuePrecisionIn, const int &timePrecisionIn )
+            : outBuffer( buffer ), valuePrecision( valuePrecisionIn ), timePrecision( timePrecisionIn ) {}
+
+        // Tab separated items
+        static void appendItem( amString &buffer, int itemValue, const amString &unit = "" );
+        static void appendItem( amString &buffer, unsigned int itemValue, const amString &unit = "" );
+        static void appendItem( amString &buffer, double itemValue, unsigned int precision, const amString &unit = "" );
+        static void appendItem( amString &buffer, const amString &itemValue );
+        static void appendHexItem( amString &buffer, unsigned char itemValue );
+        static void appendItemConditional( amString &buffer, bool condition, int             itemValueTrue, const amString &itemValueFalse );
+        static void appendItemConditional( amString &buffer, bool condition, unsigned int    itemValueTrue, const amString &itemValueFalse );
+        static void appendItemConditional( amString &buffer, bool condition, const amString &itemValueTrue, const amString &itemValueFalse );
+        static void appendItem4Way( amString &buffer, int condition, const amString &itemValue0, const amString &itemValue1, const amString &itemValue2, const amString &itemValue3 );
+
+        // Items of a JSON object
+        static void appendJSONItem( amString &buffer, const amString &itemName, int             itemValue );
+        static void appendJSONItem( amString &buffer, const amString &itemName, unsigned int    itemValue );
+        static void appendJSONItem( amString &buffer, const amString &itemName, double          itemValue, int precision );
+        static void appendJSONItem( amString &buffer, const amString &itemName, const amString &itemValue );
+        static void appendJSONItemB( amString &buffer, const amString &itemName, bool itemValue );
+        static void appendJSONHexItem( amString &buffer, const amString &itemName, unsigned char itemValue );
+        static void appendJSONHexItem( amString &buffer, const amString &itemName, unsigned int index, unsigned char itemValue );
+        static void appendJSONItemConditional( amString &buffer, const amString &itemName, bool condition, int             itemValueTrue, const amString &itemValueFalse );
+        static void appendJSONItemConditional( amString &buffer, const amString &itemName, bool condition, unsigned int    itemValueTrue, const amString &itemValueFalse );
+        static void appendJSONItemConditional( amString &buffer, const amString &itemName, bool condition, const amString &itemValueTrue, const amString &itemValueFalse );
+        static void appendJSONItem4Way( amString &buffer, const amString &itemName, int condition, const amString &itemValue0, const amString &itemValue1, const amString &itemValue2, const amString &itemValue3 );
+
+        virtual void formatCommonPage67   ( const antRecordContext &context, const antCommonPage67Record &record );
+        virtual void formatCommonPage68   ( const antRecordContext &context, const antCommonPage68Record &record );
+        virtual void formatCommonPage80   ( const antRecordContext &context, const antCommonPage80Record &record );
+        virtual void formatUnsupportedPage( const antRecordContext &context, const antUnsupportedPageRecord &record );
+
+};
+
+// Semi-cooked text (-s).
+class antSemiCookedFormatter : public antTextFormatter
+{
+
+    public:
+
+        antSemiCookedFormatter( amString &buffer, const int &valuePrecisionIn, const int &timePrecisionIn )
+            : antTextFormatter( buffer, valuePrecisionIn, timePrecisionIn ) {}
+
+        virtual void formatHRM             ( const antRecordContext &context, const antHRMRecord &record );
+        virtual void formatPowerB01        ( const antRecordContext &context, const antPowerB01Record &record );
+        virtual void formatPowerB02        ( const antRecordContext &context, const antPowerB02Record &record );
+        virtual void formatPowerB03        ( const antRecordContext &context, const antPowerB03Record &record );
+        virtual void formatPowerB10        ( const antRecordContext &context, const antPowerB10Record &record );
+        virtual void formatPowerB11        ( const antRecordContext &context, const antPowerB11Record &record );
+        virtual void formatPowerB12        ( const antRecordContext &context, const antPowerB12Record &record );
+        virtual void formatPowerB13        ( const antRecordContext &context, const antPowerB13Record &record );
+        virtual void formatPowerB20        ( const antRecordContext &context, const antPowerB20Record &record );
+        virtual void formatCommonPage70    ( const antRecordContext &context, const antCommonPage70Record &record );
+        virtual void formatCommonPage81    ( const antRecordContext &context, const antCommonPage81Record &record );
+        virtual void formatCommonPage82    ( const antRecordContext &context, const antCommonPage82Record &record );
+        virtual void formatCommonPage83    ( const antRecordContext &context, const antCommonPage83Record &record );
+        virtual void formatCommonPage84    ( const antRecordContext &context, const antCommonPage84Record &record );
+        virtual void formatEnvironmentPage0( const antRecordContext &context, const antEnvironmentPage0Record &record );
+        virtual void formatEnvironmentPage1( const antRecordContext &context, const antEnvironmentPage1Record &record );
+        virtual void formatCadence         ( const antRecordContext &context, const antCadenceRecord &record );
+        virtual void formatSpeed           ( const antRecordContext &context, const antSpeedRecord &record );
+        virtual void formatSpeedCadence    ( const antRecordContext &context, const antSpeedCadenceRecord &record );
+        virtual void formatAero            ( const antRecordContext &context, const antAeroRecord &record );
+        virtual void formatWeightScale     ( const antRecordContext &context, const antWeightScaleRecord &record );
+        virtual void formatAudioPage1      ( const antRecordContext &context, const antAudioPage1Record &record );
+        virtual void formatAudioPage16     ( const antRecordContext &context, const antAudioPage16Record &record );
+        virtual void formatStrideSpeedDist ( const antRecordContext &context, const antStrideSpeedDistRecord &record );
+        virtual void formatMultiSport      ( const antRecordContext &context, const antMultiSportRecord &record );
+
+};
+
+// Fully cooked text (default).
+class antCookedFormatter : public antTextFormatter
+{
+
+    private:
+
+        void appendAutoZeroB01  ( unsigned int autoZeroStatus );
+        void appendPercentageB13( const amString &name, unsigned int value );
+        void appendSubPage84    ( unsigned int subPage, unsigned int dataField );
+
+
+    public:
+
+        antCookedFormatter( amString &buffer, const int &valuePrecisionIn, const int &timePrecisionIn )
+            : antTextFormatter( buffer, valuePrecisionIn, timePrecisionIn ) {}
+
+        virtual void formatHRM             ( const antRecordContext &context, const antHRMRecord &record );
+        virtual void formatPowerB01        ( const antRecordContext &context, const antPowerB01Record &record );
+        virtual void formatPowerB02        ( const antRecordContext &context, const antPowerB02Record &record );
+        virtual void formatPowerB03        ( const antRecordContext &context, const antPowerB03Record &record );
+        virtual void formatPowerB10        ( const antRecordContext &context, const antPowerB10Record &record );
+        virtual void formatPowerB11        ( const antRecordContext &context, const antPowerB11Record &record );
+        virtual void formatPowerB12        ( const antRecordContext &context, const antPowerB12Record &record );
+        virtual void formatPowerB13        ( const antRecordContext &context, const antPowerB13Record &record );
+        virtual void formatPowerB20        ( const antRecordContext &context, const antPowerB20Record &record );
+        virtual void formatCommonPage70    ( const antRecordContext &context, const antCommonPage70Record &record );
+        virtual void formatCommonPage81    ( const antRecordContext &context, const antCommonPage81Record &record );
+        virtual void formatCommonPage82    ( const antRecordContext &context, const antCommonPage82Record &record );
+        virtual void formatCommonPage83    ( const antRecordContext &context, const antCommonPage83Record &record );
+        virtual void formatCommonPage84    ( const antRecordContext &context, const antCommonPage84Record &record );
+        virtual void formatEnvironmentPage0( const antRecordContext &context, const antEnvironmentPage0Record &record );
+        virtual void formatEnvironmentPage1( const antRecordContext &context, const antEnvironmentPage1Record &record );
+        virtual void formatCadence         ( const antRecordContext &context, const antCadenceRecord &record );
+        virtual void formatSpeed           ( const antRecordContext &context, const antSpeedRecord &record );
+        virtual void formatSpeedCadence    ( const antRecordContext &context, const antSpeedCadenceRecord &record );
+        virtual void formatAero            ( const antRecordContext &context, const antAeroRecord &record );
+        virtual void formatWeightScale     ( const antRecordContext &context, const antWeightScaleRecord &record );
+        virtual void formatAudioPage1      ( const antRecordContext &context, const antAudioPage1Record &record );
+        virtual void formatAudioPage16     ( const antRecordContext &context, const antAudioPage16Record &record );
+        virtual void formatStrideSpeedDist ( const antRecordContext &context, const antStrideSpeedDistRecord &record );
+        virtual void formatMultiSport      ( const antRecordContext &context, const antMultiSportRecord &record );
+
+};
+
+// JSON (-J), with the semi-cooked or the cooked values.
+class antJSONFormatter : public antTextFormatter
+{
+
+    private:
+
+        const bool &semiCooked;
+
+        void appendAutoZeroB01  ( unsigned int autoZeroStatus );
+        void appendPercentageB13( const amString &name, unsigned int value );
+        void appendSubPage84    ( unsigned int subPageNo, unsigned int subPage, unsigned int dataField );
+
+
+    protected:
+
+        virtual void appendPageNo( bool outputPageNo, unsigned int dataPage );
+
+
+    public:
+
+        antJSONFormatter( amString &buffer, const int &valuePrecisionIn, const int &timePrecisionIn, const bool &semiCookedIn )
+            : antTextFormatter( buffer, valuePrecisionIn, timePrecisionIn ), semiCooked( semiCookedIn ) {}
+
+        virtual void formatHRM             ( const antRecordContext &context, const antHRMRecord &record );
+        virtual void formatPowerB01        ( const antRecordContext &context, const antPowerB01Record &record );
+        virtual void formatPowerB02        ( const antRecordContext &context, const antPowerB02Record &record );
+        virtual void formatPowerB03        ( const antRecordContext &context, const antPowerB03Record &record );
+        virtual void formatPowerB10        ( const antRecordContext &context, const antPowerB10Record &record );
+        virtual void formatPowerB11        ( const antRecordContext &context, const antPowerB11Record &record );
+        virtual void formatPowerB12        ( const antRecordContext &context, const antPowerB12Record &record );
+        virtual void formatPowerB13        ( const antRecordContext &context, const antPowerB13Record &record );
+        virtual void formatPowerB20        ( const antRecordContext &context, const antPowerB20Record &record );
+        virtual void formatCommonPage67    ( const antRecordContext &context, const antCommonPage67Record &record );
+        virtual void formatCommonPage68    ( const antRecordContext &context, const antCommonPage68Record &record );
+        virtual void formatCommonPage70    ( const antRecordContext &context, const antCommonPage70Record &record );
+        virtual void formatCommonPage80    ( const antRecordContext &context, const antCommonPage80Record &record );
+        virtual void formatCommonPage81    ( const antRecordContext &context, const antCommonPage81Record &record );
+        virtual void formatCommonPage82    ( const antRecordContext &context, const antCommonPage82Record &record );
+        virtual void formatCommonPage83    ( const antRecordContext &context, const antCommonPage83Record &record );
+        virtual void formatCommonPage84    ( const antRecordContext &context, const antCommonPage84Record &record );
+        virtual void formatEnvironmentPage0( const antRecordContext &context, const antEnvironmentPage0Record &record );
+        virtual void formatEnvironmentPage1( const antRecordContext &context, const antEnvironmentPage1Record &record );
+        virtual void formatCadence         ( const antRecordContext &context, const antCadenceRecord &record );
+        virtual void formatSpeed           ( const antRecordContext &context, const antSpeedRecord &record );
+        virtual void formatSpeedCadence    ( const antRecordContext &context, const antSpeedCadenceRecord &record );
+        virtual void formatAero            ( const antRecordContext &context, const antAeroRecord &record );
+        virtual void formatWeightScale     ( const antRecordContext &context, const antWeightScaleRecord &record );
+        virtual void formatAudioPage1      ( const antRecordContext &context, const antAudioPage1Record &record );
+        virtual void formatAudioPage16     ( const antRecordContext &context, const antAudioPage16Record &record );
+        virtual void formatStrideSpeedDist ( const antRecordContext &context, const antStrideSpeedDistRecord &record );
+        virtual void formatMultiSport      ( const antRecordContext &context, const antMultiSportRecord &record );
+        virtual void formatUnsupportedPage ( const antRecordContext &context, const antUnsupportedPageRecord &record );
+
+};
+
+#endif // __ANT_RECORD_FORMATTER_H__
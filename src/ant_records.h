@@ -0,0 +1,517 @@
+#ifndef __ANT_RECORDS_H__
+#define __ANT_RECORDS_H__
+
+#ifndef __cplusplus
+#include <stdbool.h>
+#endif
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Decoded records.
+// The decoders fill one of the plain structs below per data page instead of writing text. A record holds the semi-cooked values (the values written
+// with -s, which can be decoded without the history of the sensor) and the cooked values (computed
+// from the sensor history, only filled in when the output is not semi-cooked).
+// The records are written by the formatters of ant_record_formatter.h and handed to the users of
+// the decoder library (ant_decoder.h), so this header is also read by C compilers.
+//
+// The data pages decoded into records:
+//   - HRM data pages 0 to 4 (antHRMRecord),
+//   - all power meter data pages: the calibration, parameter and measurement pages 0x01 to 0x03
+//     (antPowerB01Record ... antPowerB03Record) and the data pages 0x10 to 0x13 and 0x20
+//     (antPowerB10Record ... antPowerB20Record),
+//   - the environment sensor data pages 0 and 1 (antEnvironmentPage0Record, antEnvironmentPage1Record),
+//   - the bike speed and cadence sensor data pages 0 to 3 (antCadenceRecord, antSpeedRecord) and the
+//     combined speed and cadence sensor (antSpeedCadenceRecord),
+//   - the aerodynamic sensor (antAeroRecord),
+//   - the weight scale data pages 1 to 4 and 58 (antWeightScaleRecord),
+//   - the audio control data pages 1 and 16 (antAudioPage1Record, antAudioPage16Record),
+//   - the stride based speed and distance monitor data pages 1 to 3, 16 and 22 (antStrideSpeedDistRecord),
+//   - the multi-sport speed and distance monitor data pages 1 to 3 and 48 (antMultiSportRecord),
+//   - the common data pages 67, 68, 70 and 80 to 84 of all profiles (antCommonPageXXRecord),
+//   - the data pages the decoders do not know (antUnsupportedPageRecord).
+// The other output (bridge and sequence information, unknown packets, ...) is still written as text
+// and reaches the library users, and the binary format (-E), only as text.
+// A new data page takes a struct here, its method in antRecordFormatter with the text back-ends,
+// and its field layout in ant_binary_format.cpp.
+//
+// -------------------------------------------------------------------------------------------------//
+
+// Record types (antRecordHeader::recordType in ant_decoder.h).
+enum antRecordType
+{
+    ANT_HRM_RECORD               =  1,
+    ANT_POWER_B10_RECORD         =  2,
+    ANT_COMMON_PAGE67_RECORD     =  3,
+    ANT_COMMON_PAGE68_RECORD     =  4,
+    ANT_COMMON_PAGE70_RECORD     =  5,
+    ANT_COMMON_PAGE80_RECORD     =  6,
+    ANT_COMMON_PAGE81_RECORD     =  7,
+    ANT_COMMON_PAGE82_RECORD     =  8,
+    ANT_COMMON_PAGE83_RECORD     =  9,
+    ANT_COMMON_PAGE84_RECORD     = 10,
+    ANT_UNSUPPORTED_PAGE_RECORD  = 11,
+    ANT_POWER_B11_RECORD         = 12,
+    ANT_POWER_B12_RECORD         = 13,
+    ANT_POWER_B13_RECORD         = 14,
+    ANT_POWER_B20_RECORD         = 15,
+    ANT_POWER_B01_RECORD         = 16,
+    ANT_POWER_B02_RECORD         = 17,
+    ANT_POWER_B03_RECORD         = 18,
+    ANT_ENVIRONMENT_PAGE0_RECORD = 19,
+    ANT_ENVIRONMENT_PAGE1_RECORD = 20,
+    ANT_CADENCE_RECORD           = 21,
+    ANT_SPEED_RECORD             = 22,
+    ANT_SPEED_CADENCE_RECORD     = 23,
+    ANT_AERO_RECORD              = 24,
+    ANT_WEIGHT_SCALE_RECORD      = 25,
+    ANT_AUDIO_PAGE1_RECORD       = 26,
+    ANT_AUDIO_PAGE16_RECORD      = 27,
+    ANT_STRIDE_SPEED_DIST_RECORD = 28,
+    ANT_MULTI_SPORT_RECORD       = 29
+};
+
+// HRM: Heart Rate Monitor, data pages 0 to 4 (main data pages).
+typedef struct antHRMRecord
+{
+    unsigned int dataPage;
+    unsigned int heartRate;
+    unsigned int deltaHeartBeatEventTime;
+    unsigned int deltaHeartBeatCount;
+    unsigned int additionalData1;           // Delta operating time (1), manufacturer ID (2), H/W version (3), delta previous heart beat event time (4)
+    unsigned int additionalData2;           // Serial number (2), S/W version (3), manufacturer specific data (4)
+    unsigned int additionalData3;           // Model number (3)
+
+    // Cooked values
+    double       totalHeartBeatEventTime;
+    unsigned int totalHeartBeatCount;
+    double       previousHeartBeatEventTime; // Page 4
+} antHRMRecord;
+
+// PWRB01: Power Meter Calibration Request / Response.
+// The meaning of the two data fields depends on the calibration ID:
+//    16: CTF defined ID (1: offset, 2: slope, 3: serial number, 172: acknowledgement), message value
+//    18: auto zero enable, auto zero status
+//   171: auto zero status
+//   172, 175: auto zero status, message value
+// The other calibration IDs (170, 186 to 189) have no data.
+typedef struct antPowerB01Record
+{
+    unsigned int calibrationID;
+    unsigned int calibrationData1;
+    unsigned int calibrationData2;
+} antPowerB01Record;
+
+// PWRB02: Power Meter Get/Set Parameters, only sub page 1 (crank parameters) is decoded.
+typedef struct antPowerB02Record
+{
+    unsigned int subPage;
+    unsigned int crankLength;               // (length - 110 mm) * 2, 255: undefined
+    unsigned int sensorStatus;
+    unsigned int sensorCapabilities;
+} antPowerB02Record;
+
+// PWRB03: Power Meter Measurement Output.
+typedef struct antPowerB03Record
+{
+    unsigned int nbDataTypes;
+    unsigned int dataType;
+    unsigned int scaleFactor;               // Signed 8 bit: the value is multiplied with 2^scaleFactor
+    unsigned int deltaEventTime;            // 1/2048 s
+    unsigned int value;                     // Signed 16 bit
+
+    // Cooked values
+    double       timeValue;                 // s, sum of the delta event times
+    double       measurementValue;          // Scaled value
+} antPowerB03Record;
+
+// PWRB10: Power Only Power Meter.
+typedef struct antPowerB10Record
+{
+    unsigned int eventCount;
+    unsigned int deltaEventCount;
+    unsigned int deltaAccumulatedPower;
+    unsigned int instantaneousPower;
+    unsigned int instantaneousCadence;
+    unsigned int pedalPower;
+
+    // Cooked values
+    double       power;
+    unsigned int cadence;
+    int          pedalPowerContribution;    // < 0: no pedal power contribution
+    bool         rightPedal;
+    bool         isMakeshiftSpeedSensor;
+    double       speed;
+    double       wheelCircumference;
+    double       gearRatio;
+} antPowerB10Record;
+
+// PWRB11: Wheel Torque Power Meter (hub power meter).
+typedef struct antPowerB11Record
+{
+    unsigned int deltaEventCount;
+    unsigned int deltaWheelPeriod;          // 1/2048 s
+    unsigned int deltaAccumulatedTorque;    // 1/32 Nm
+    unsigned int instantaneousCadence;      // 255: invalid
+    unsigned int wheelTicks;
+
+    // Cooked values
+    double       power;
+    unsigned int cadence;
+    double       torque;
+    bool         isSpeedSensor;
+    double       speed;
+    double       wheelCircumference;
+} antPowerB11Record;
+
+// PWRB12: Crank Torque Power Meter.
+typedef struct antPowerB12Record
+{
+    unsigned int eventCount;
+    unsigned int deltaEventCount;
+    unsigned int deltaCrankPeriod;          // 1/2048 s
+    unsigned int deltaAccumulatedTorque;    // 1/32 Nm
+    unsigned int instantaneousCadence;
+    unsigned int crankTicks;
+
+    // Cooked values
+    double       power;
+    unsigned int cadence;
+    double       torque;
+    bool         isMakeshiftSpeedSensor;
+    double       speed;
+    double       wheelCircumference;
+    double       gearRatio;
+} antPowerB12Record;
+
+// PWRB13: Torque Effectiveness and Pedal Smoothness, in 1/2 %.
+typedef struct antPowerB13Record
+{
+    unsigned int leftTorqueEffectiveness;   // 255: invalid
+    unsigned int rightTorqueEffectiveness;  // 255: invalid
+    unsigned int leftPedalSmoothness;       // Combined pedal smoothness if rightPedalSmoothness is 254, 255: invalid
+    unsigned int rightPedalSmoothness;      // 255: invalid
+    unsigned int deltaEventCount;
+
+    // Cooked values
+    unsigned int totalEventCount;
+} antPowerB13Record;
+
+// PWRB20: Crank Torque Frequency Power Meter.
+typedef struct antPowerB20Record
+{
+    unsigned int deltaEventCount;
+    unsigned int deltaTimeStamp;            // 1/2000 s
+    unsigned int deltaTorqueTicks;
+    unsigned int factorySlope;              // Nm/10Hz
+
+    // Cooked values
+    double       power;
+    unsigned int cadence;
+    double       torque;
+    unsigned int offset;                    // Hz
+    unsigned int slope;                     // Slope used (factory or user-defined slope), Nm/10Hz
+    bool         isFactorySlope;
+    bool         isMakeshiftSpeedSensor;
+    double       speed;
+    double       wheelCircumference;
+    double       gearRatio;
+} antPowerB20Record;
+
+// ENV: Environment Sensor, data page 0 (general information).
+typedef struct antEnvironmentPage0Record
+{
+    unsigned int dataPage;
+    unsigned int localTime;                 // 0: not supported, 1: supported and not set, 2: supported and set
+    unsigned int utcTime;                   // 0: not supported, 1: supported and not set, 2: supported and set
+    unsigned int transmissionRate;          // 0: 0.5 Hz, 2: 4 Hz
+    unsigned int supportedPages;            // Bit n set: data page n is supported
+} antEnvironmentPage0Record;
+
+// ENV: Environment Sensor, data page 1 (temperature).
+typedef struct antEnvironmentPage1Record
+{
+    unsigned int dataPage;
+    unsigned int currentTemperature;        // Signed 16 bit, 1/100 C, 0x8000: invalid
+    unsigned int lowTemperature24h;         // Signed 12 bit, 1/10 C, 0x800: invalid
+    unsigned int highTemperature24h;        // Signed 12 bit, 1/10 C, 0x800: invalid
+    unsigned int eventCount;
+
+    // Cooked values
+    double       currentTemp;               // C
+    double       lowTemp24h;                // C
+    double       highTemp24h;               // C
+} antEnvironmentPage1Record;
+
+// CAD7A: Cadence Only Sensor, data pages 0 to 3 (main data pages).
+typedef struct antCadenceRecord
+{
+    unsigned int dataPage;
+    unsigned int deltaRevolutionCount;
+    unsigned int deltaEventTime;            // 1/1024 s
+    unsigned int additionalData1;           // Delta operating time (1), manufacturer ID (2), H/W version (3)
+    unsigned int additionalData2;           // Serial number (2), S/W version (3)
+    unsigned int additionalData3;           // Model number (3)
+
+    // Cooked values
+    unsigned int cadence;
+    bool         isMakeshiftSpeedSensor;
+    double       speed;
+    double       wheelCircumference;
+    double       gearRatio;
+} antCadenceRecord;
+
+// SPB7: Speed Only Sensor, data pages 0 to 3 (main data pages).
+typedef struct antSpeedRecord
+{
+    unsigned int dataPage;
+    unsigned int deltaEventTime;            // 1/1024 s
+    unsigned int deltaRevolutionCount;
+    unsigned int additionalData1;           // Delta operating time (1), manufacturer ID (2), H/W version (3)
+    unsigned int additionalData2;           // Serial number (2), S/W version (3)
+    unsigned int additionalData3;           // Model number (3)
+
+    // Cooked values
+    double       speed;
+    double       wheelCircumference;
+    unsigned int numberOfMagnets;
+} antSpeedRecord;
+
+// SPCAD790: Speed and Cadence Sensor (no data pages).
+typedef struct antSpeedCadenceRecord
+{
+    unsigned int deltaSpeedEventTime;       // 1/1024 s
+    unsigned int deltaWheelRevolutionCount;
+    unsigned int deltaCadenceEventTime;     // 1/1024 s
+    unsigned int deltaCrankRevolutionCount;
+
+    // Cooked values
+    double       speed;
+    unsigned int cadence;
+    double       wheelCircumference;
+    unsigned int numberOfMagnets;
+} antSpeedCadenceRecord;
+
+// AERO: Aerodynamic sensor (no data pages).
+typedef struct antAeroRecord
+{
+    unsigned int airSpeedRaw;
+    unsigned int yawAngleRaw;               // Signed 16 bit
+
+    // Cooked values
+    double       airSpeed;
+    double       yawAngle;
+    double       calibrationRho;            // Air density of the calibration
+    double       airSpeedMultiplier;
+    double       currentRho;                // Current air density
+} antAeroRecord;
+
+// WEIGHT: Weight scale, data pages 1 to 4 and 58 (user profile).
+// The meaning of 'value1' and 'value2' depends on the data page:
+//   - page  1: capabilities, body weight (1/100 kg),
+//   - page  2: hydration, body fat (1/100 %),
+//   - page  3: active metabolic rate, basal metabolic rate (1/4 kcal),
+//   - page  4: muscle mass (1/100 kg), bone mass (1/10 kg),
+//   - page 58: capabilities, gender.
+typedef struct antWeightScaleRecord
+{
+    unsigned int dataPage;
+    unsigned int userProfile;
+    unsigned int value1;
+    unsigned int value2;
+    unsigned int age;                       // Page 58 only
+    unsigned int userHeight;                // Page 58 only
+    unsigned int descriptBit;               // Page 58 only
+} antWeightScaleRecord;
+
+// AUDIO: Audio control, data page 1 (audio update data).
+typedef struct antAudioPage1Record
+{
+    unsigned int dataPage;
+    unsigned int volume;                    // %, 0xFF: unknown
+    unsigned int totalTrackTime;            // s, 0xFFFF: unknown
+    unsigned int currentTrackTime;          // s, 0xFFFF: unknown
+    unsigned int state;                     // Device state (high nibble), repeat and shuffle state
+} antAudioPage1Record;
+
+// AUDIO: Audio control, data page 16 (audio command from the remote control).
+typedef struct antAudioPage16Record
+{
+    unsigned int dataPage;
+    unsigned int serialNumber;              // 0xFFFF: unknown
+    unsigned int commandNumber;
+} antAudioPage16Record;
+
+// SBSDM: Stride based speed and distance monitor, data pages 1 to 3, 16 and 22.
+// The meaning of the values depends on the data page:
+//   - page  1:      value1/value2 time (s, 1/200 s), value3/value4 distance (m, 1/16 m),
+//                   value5/value6 speed (m/s, 1/256 m/s), value7 stride count, value8 latency (1/32 s),
+//   - pages 2 and 3: value3/value4 cadence (strides/min, 1/16 strides/min), value5/value6 speed,
+//                   value7 calories (page 3 only), value8 status,
+//   - page 16:      value1 strides since reset, value2 distance since reset (1/256 m),
+//   - page 22:      value1 capabilities.
+// Time, distance and stride count are the deltas to the previous page in semi-cooked records and
+// the totals in cooked records.
+typedef struct antStrideSpeedDistRecord
+{
+    unsigned int dataPage;
+    unsigned int value1;
+    unsigned int value2;
+    unsigned int value3;
+    unsigned int value4;
+    unsigned int value5;
+    unsigned int value6;
+    unsigned int value7;
+    unsigned int value8;
+} antStrideSpeedDistRecord;
+
+// MSSDM: Multi-sport speed and distance monitor, data pages 1 to 3 and 48.
+// The meaning of the values depends on the data page:
+//   - page  1: value1 delta event time (1/1024 s), value2 delta distance, value3 speed (1/1000 km/h),
+//   - page  2: value1 latitude, value2 longitude (signed 28 bit, semicircles),
+//   - page  3: value1 fix type, value2 heading (signed 12 bit, 1/10 deg), value3 elevation (1/5 m + 500 m),
+//   - page 48: value1 mode (0xFF: invalid), value2 scale factor (1/10000, 0xFFFF: calibration request).
+typedef struct antMultiSportRecord
+{
+    unsigned int dataPage;
+    unsigned int value1;
+    unsigned int value2;
+    unsigned int value3;
+
+    // Cooked values
+    double       totalTime;                 // s, page 1
+    double       totalDistance;             // m, page 1
+    double       heading;                   // deg, page 3
+} antMultiSportRecord;
+
+// Common data pages, sent by the sensors of all profiles.
+// 'outputPageNo' is false if the data page is already part of the sensor ID (e.g. PWRB50).
+
+// Common data page 67 (0x43): ANT-FS client beacon.
+typedef struct antCommonPage67Record
+{
+    bool         outputPageNo;
+    unsigned int statusByte1;
+    unsigned int statusByte2;
+    unsigned int authentication;
+    unsigned int deviceType;
+    unsigned int manufacturerID;
+} antCommonPage67Record;
+
+// Common data page 68 (0x44): ANT-FS command/response.
+typedef struct antCommonPage68Record
+{
+    bool         outputPageNo;
+    unsigned int commandResponseID;
+    unsigned int channelFrequency;
+    unsigned int channelPeriod;
+    unsigned int hostSerialNumber;
+} antCommonPage68Record;
+
+// Common data page 70 (0x46): request data page.
+typedef struct antCommonPage70Record
+{
+    bool         outputPageNo;
+    unsigned int descriptor1;
+    unsigned int descriptor2;
+    unsigned int requestedResponse;
+    unsigned int requestedPage;
+    unsigned int commandType;
+} antCommonPage70Record;
+
+// Common data page 80 (0x50): manufacturer's identification.
+typedef struct antCommonPage80Record
+{
+    bool         outputPageNo;
+    unsigned int manufacturerID;
+    unsigned int hardwareRevision;
+    unsigned int modelNumber;
+} antCommonPage80Record;
+
+// Common data page 81 (0x51): product information.
+typedef struct antCommonPage81Record
+{
+    bool         outputPageNo;
+    unsigned int serialNumber;
+    unsigned int softwareRevision;
+} antCommonPage81Record;
+
+// Common data page 82 (0x52): battery status.
+typedef struct antCommonPage82Record
+{
+    bool         outputPageNo;
+    unsigned int voltage256;                // Battery voltage * 256
+    unsigned int status;                    // Index of the battery status (new, good, ok, low, ...)
+    unsigned int deltaOperatingTime;        // In units of 'resolution' seconds
+    unsigned int resolution;
+    unsigned int nbBatteries;               // 0: not used
+    unsigned int batteryID;
+
+    // Cooked values
+    double       totalOperatingTime;        // Seconds
+} antCommonPage82Record;
+
+// Common data page 83 (0x53): time and date.
+typedef struct antCommonPage83Record
+{
+    bool         outputPageNo;
+    unsigned int seconds;
+    unsigned int minutes;
+    unsigned int hours;
+    unsigned int weekDayNo;                 // 0: Sunday
+    unsigned int monthDay;
+    unsigned int month;
+    unsigned int year;                      // Years since 2000
+} antCommonPage83Record;
+
+// Common data page 84 (0x54): subfield data (temperature, pressure, humidity, wind).
+typedef struct antCommonPage84Record
+{
+    bool         outputPageNo;
+    unsigned int subPage1;
+    unsigned int subPage2;
+    unsigned int dataField1;
+    unsigned int dataField2;
+} antCommonPage84Record;
+
+// Data page the decoder does not know: its raw payload.
+typedef struct antUnsupportedPageRecord
+{
+    unsigned int  dataPage;
+    unsigned char payLoad[ 8 ];
+} antUnsupportedPageRecord;
+
+// Any of the records above, e.g. to keep the last record of each type.
+typedef union antRecord
+{
+    antHRMRecord              hrm;
+    antPowerB01Record         powerB01;
+    antPowerB02Record         powerB02;
+    antPowerB03Record         powerB03;
+    antPowerB10Record         powerB10;
+    antPowerB11Record         powerB11;
+    antPowerB12Record         powerB12;
+    antPowerB13Record         powerB13;
+    antPowerB20Record         powerB20;
+    antCommonPage67Record     commonPage67;
+    antCommonPage68Record     commonPage68;
+    antCommonPage70Record     commonPage70;
+    antCommonPage80Record     commonPage80;
+    antCommonPage81Record     commonPage81;
+    antCommonPage82Record     commonPage82;
+    antCommonPage83Record     commonPage83;
+    antCommonPage84Record     commonPage84;
+    antEnvironmentPage0Record environmentPage0;
+    antEnvironmentPage1Record environmentPage1;
+    antCadenceRecord          cadence;
+    antSpeedRecord            speed;
+    antSpeedCadenceRecord     speedCadence;
+    antAeroRecord             aero;
+    antWeightScaleRecord      weightScale;
+    antAudioPage1Record       audioPage1;
+    antAudioPage16Record      audioPage16;
+    antStrideSpeedDistRecord  strideSpeedDist;
+    antMultiSportRecord       multiSport;
+    antUnsupportedPageRecord  unsupportedPage;
+} antRecord;
+
+#endif // __ANT_RECORDS_H__
@@ -0,0 +1,616 @@
+#include <string.h>
+#include <algorithm>
+
+#include "ant_sensor_state.h"
+
+// Initial number of slots of the hash tables (must be a power of 2).
+const unsigned int C_SENSOR_STATE_SLOTS = 64;
+const unsigned int C_FAMILY_SLOTS       = 64;
+
+// Keys of sensor IDs which are not of the form <head>_<decimal device ID> (the whole ID is the family).
+const unsigned long long C_NO_DEVICE_ID_KEY = 1ULL << 63;
+
+// Key of the records on the free list (family indices start at 1, so no sensor has this key).
+const unsigned long long C_FREE_KEY = 0;
+
+// Time stamp of the records looked up before the first call to setTime() (e.g. restored from a
+// checkpoint): they are stamped by the next evict().
+const long long C_NOT_SEEN = -1LL - 0x7FFFFFFFFFFFFFFFLL;
+
+static inline unsigned int hashKey
+(
+    unsigned long long key,
+    unsigned int       slotMask
+)
+{
+    key *= 0x9E3779B97F4A7C15ULL;
+    return ( unsigned int ) ( key ^ ( key >> 32 ) ) & slotMask;
+}
+
+antSensorStateTable::antSensorStateTable
+(
+    void
+)
+{
+    lastRecord  = NULL;
+    currentTime = C_NOT_SEEN;
+    pinning     = false;
+    memset( &counters, 0, sizeof( counters ) );
+    slots.assign( C_SENSOR_STATE_SLOTS, 0 );
+    familySlots.assign( C_FAMILY_SLOTS, 0 );
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Return the index of the sensor type head (e.g. "PWRB10"), registering it if create is true.
+// Returns 0 if the head is unknown and create is false (family indices start at 1).
+//
+// -------------------------------------------------------------------------------------------------//
+unsigned int antSensorStateTable::findFamily
+(
+    const char *head,
+    size_t      length,
+    bool        create
+)
+{
+    unsigned int hash     = 2166136261U;
+    unsigned int slotMask = familySlots.size() - 1;
+    unsigned int slotNo   = 0;
+    unsigned int familyNo = 0;
+
+    for ( size_t counter = 0; counter < length; ++counter )
+    {
+        hash ^= ( unsigned char ) head[ counter ];
+        hash *= 16777619U;
+    }
+
+    for ( slotNo = hash & slotMask; familySlots[ slotNo ] != 0; slotNo = ( slotNo + 1 ) & slotMask )
+    {
+        familyNo = familySlots[ slotNo ];
+        if ( families[ familyNo - 1 ].compare( 0, std::string::npos, head, length ) == 0 )
+        {
+            return familyNo;
+        }
+    }
+
+    familyNo = 0;
+    if ( create )
+    {
+        families.push_back( amString( std::string( head, length ) ) );
+        familyNo              = families.size();
+        familySlots[ slotNo ] = familyNo;
+        if ( 2 * families.size() > familySlots.size() )
+        {
+            growFamilies();
+        }
+    }
+    return familyNo;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Convert a sensor ID into its integer key: family index in the upper, device ID in the lower half.
+// Returns false if the sensor type head is unknown and create is false.
+//
+// -------------------------------------------------------------------------------------------------//
+bool antSensorStateTable::makeKey
+(
+    unsigned long long &key,
+    const amString     &sensorID,
+    bool                create
+)
+{
+    const char        *text      = sensorID.c_str();
+    size_t             length    = sensorID.size();
+    size_t             separator = sensorID.rfind( '_' );
+    size_t             nbDigits  = 0;
+    unsigned long long deviceID  = 0;
+    unsigned int       familyNo  = 0;
+    bool               hasID     = false;
+
+    if ( separator != std::string::npos )
+    {
+        // Leading zeros would map different strings onto the same key.
+        nbDigits = length - separator - 1;
+        hasID    = ( nbDigits > 0 ) && ( nbDigits <= 9 ) && ( ( nbDigits == 1 ) || ( text[ separator + 1 ] != '0' ) );
+        for ( size_t counter = separator + 1; hasID && ( counter < length ); ++counter )
+        {
+            hasID    = ( text[ counter ] >= '0' ) && ( text[ counter ] <= '9' );
+            deviceID = 10 * deviceID + ( text[ counter ] - '0' );
+        }
+    }
+
+    if ( hasID )
+    {
+        familyNo = findFamily( text, separator, create );
+        key      = ( ( unsigned long long ) familyNo << 32 ) | deviceID;
+    }
+    else
+    {
+        familyNo = findFamily( text, length, create );
+        key      = ( ( unsigned long long ) familyNo << 32 ) | C_NO_DEVICE_ID_KEY;
+    }
+    return ( familyNo != 0 );
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Return the state record of a sensor, or NULL if there is none.
+//
+// -------------------------------------------------------------------------------------------------//
+antSensorState *antSensorStateTable::find
+(
+    const amString &sensorID
+)
+{
+    unsigned long long key      = 0;
+    unsigned int       slotMask = slots.size() - 1;
+    unsigned int       slotNo   = 0;
+
+    if ( ( lastRecord != NULL ) && ( lastRecord->sensorID == sensorID ) )
+    {
+        return lastRecord;
+    }
+
+    if ( makeKey( key, sensorID, false ) )
+    {
+        for ( slotNo = hashKey( key, slotMask ); slots[ slotNo ] != 0; slotNo = ( slotNo + 1 ) & slotMask )
+        {
+            if ( records[ slots[ slotNo ] - 1 ].key == key )
+            {
+                lastRecord = &records[ slots[ slotNo ] - 1 ];
+                return lastRecord;
+            }
+        }
+    }
+    return NULL;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Return the state record of a sensor, creating an empty one if there is none.
+//
+// -------------------------------------------------------------------------------------------------//
+antSensorState &antSensorStateTable::get
+(
+    const amString &sensorID
+)
+{
+    unsigned long long key      = 0;
+    unsigned int       slotMask = slots.size() - 1;
+    unsigned int       slotNo   = 0;
+
+    if ( ( lastRecord != NULL ) && ( lastRecord->sensorID == sensorID ) )
+    {
+        touch( *lastRecord );
+        return *lastRecord;
+    }
+
+    makeKey( key, sensorID, true );
+    for ( slotNo = hashKey( key, slotMask ); slots[ slotNo ] != 0; slotNo = ( slotNo + 1 ) & slotMask )
+    {
+        if ( records[ slots[ slotNo ] - 1 ].key == key )
+        {
+            lastRecord = &records[ slots[ slotNo ] - 1 ];
+            touch( *lastRecord );
+            return *lastRecord;
+        }
+    }
+
+    addRecord( key, slotNo ).sensorID = sensorID;
+    return *lastRecord;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Return the state record a handle refers to, or NULL if there is none.
+//
+// -------------------------------------------------------------------------------------------------//
+antSensorState *antSensorStateTable::find
+(
+    const antSensorHandle &sensor
+)
+{
+    if ( sensor.record == NULL )
+    {
+        sensor.record = ( sensor.text != NULL ) ? find( *sensor.text ) : findKey( sensor.key, false );
+    }
+    return sensor.record;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Return the state record a handle refers to, creating an empty one if there is none.
+//
+// -------------------------------------------------------------------------------------------------//
+antSensorState &antSensorStateTable::get
+(
+    const antSensorHandle &sensor
+)
+{
+    if ( sensor.record == NULL )
+    {
+        sensor.record = ( sensor.text != NULL ) ? &get( *sensor.text ) : findKey( sensor.key, true );
+    }
+    return *sensor.record;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Return the record of a key, or NULL if there is none and 'create' is false.
+//
+// -------------------------------------------------------------------------------------------------//
+antSensorState *antSensorStateTable::findKey
+(
+    unsigned long long key,
+    bool               create
+)
+{
+    unsigned int slotMask = slots.size() - 1;
+    unsigned int slotNo   = 0;
+
+    if ( ( lastRecord != NULL ) && ( lastRecord->key == key ) )
+    {
+        return lastRecord;
+    }
+
+    for ( slotNo = hashKey( key, slotMask ); slots[ slotNo ] != 0; slotNo = ( slotNo + 1 ) & slotMask )
+    {
+        if ( records[ slots[ slotNo ] - 1 ].key == key )
+        {
+            lastRecord = &records[ slots[ slotNo ] - 1 ];
+            return lastRecord;
+        }
+    }
+    return create ? &addRecord( key, slotNo ) : NULL;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Return the handle of the sensor <head><deviceID> (e.g. "PWRB10_" and 442). No text is built: the
+// key is made from the numbers directly. A sensor without a record gets none yet, its handle holds
+// the key until a value is stored (see get()).
+//
+// -------------------------------------------------------------------------------------------------//
+antSensorHandle antSensorStateTable::intern
+(
+    const char   *head,
+    unsigned int  deviceID
+)
+{
+    unsigned long long  key    = 0;
+    antSensorState     *record = NULL;
+    size_t              length = strlen( head );
+
+    if ( ( length < 2 ) || ( head[ length - 1 ] != '_' ) || ( deviceID > 999999999 ) )
+    {
+        // Not of the form <head>_<device ID>: fall back to the text key.
+        return intern( amString( head ) + amString( deviceID ) );
+    }
+
+    key    = ( ( unsigned long long ) findFamily( head, length - 1, true ) << 32 ) | deviceID;
+    record = findKey( key, false );
+    if ( record == NULL )
+    {
+        return antSensorHandle( *this, key );
+    }
+
+    touch( *record );
+    return antSensorHandle( *this, *record );
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Create the record of a new key in the free slot 'slotNo', re-using an evicted record if there is
+// one. The new record becomes the last record.
+//
+// -------------------------------------------------------------------------------------------------//
+antSensorState &antSensorStateTable::addRecord
+(
+    unsigned long long key,
+    unsigned int       slotNo
+)
+{
+    unsigned int recordNo = 0;
+
+    if ( freeRecords.empty() )
+    {
+        recordNo = records.size();
+        records.push_back( antSensorState() );
+    }
+    else
+    {
+        recordNo = freeRecords.back();
+        freeRecords.pop_back();
+        records[ recordNo ] = antSensorState();
+    }
+
+    lastRecord          = &records[ recordNo ];
+    lastRecord->key     = key;
+    lastRecord->present = 0;
+    lastRecord->pinned  = false;
+    touch( *lastRecord );
+    slots[ slotNo ]     = recordNo + 1;
+    ++counters.nbCreated;
+
+    if ( 2 * size() > slots.size() )
+    {
+        growSlots();
+    }
+    return *lastRecord;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Remove a record from the slots and put it on the free list. The slots following it are shifted
+// back, so no lookup runs into a hole.
+//
+// -------------------------------------------------------------------------------------------------//
+void antSensorStateTable::removeRecord
+(
+    unsigned int recordNo
+)
+{
+    antSensorState &record   = records[ recordNo ];
+    unsigned int    slotMask = slots.size() - 1;
+    unsigned int    slotNo   = 0;
+    unsigned int    nextNo   = 0;
+    unsigned int    homeNo   = 0;
+
+    for ( slotNo = hashKey( record.key, slotMask ); slots[ slotNo ] != recordNo + 1; slotNo = ( slotNo + 1 ) & slotMask )
+    {
+    }
+
+    for ( nextNo = ( slotNo + 1 ) & slotMask; slots[ nextNo ] != 0; nextNo = ( nextNo + 1 ) & slotMask )
+    {
+        // A record may move into the hole unless its home slot lies between the hole and itself.
+        homeNo = hashKey( records[ slots[ nextNo ] - 1 ].key, slotMask );
+        if ( ( ( nextNo - homeNo ) & slotMask ) >= ( ( nextNo - slotNo ) & slotMask ) )
+        {
+            slots[ slotNo ] = slots[ nextNo ];
+            slotNo          = nextNo;
+        }
+    }
+    slots[ slotNo ] = 0;
+
+    if ( lastRecord == &record )
+    {
+        lastRecord = NULL;
+    }
+    record.key     = C_FREE_KEY;
+    record.present = 0;
+    record.pinned  = false;
+    record.sensorID.clear();
+    freeRecords.push_back( recordNo );
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Evict the records of the sensors which are not pinned and
+//   - were not looked up for more than 'idleTime' (if not 0), or
+//   - were looked up least recently, while there are more than 'maxRecords' records (if not 0).
+// Over the limit the table is brought down to 15/16 of it, so a stream of new sensors does not make
+// every lookup run an eviction.
+//
+// -------------------------------------------------------------------------------------------------//
+void antSensorStateTable::evict
+(
+    long long idleTime,
+    size_t    maxRecords
+)
+{
+    std::vector< std::pair<long long, unsigned int> > candidates;
+    bool                                              overLimit = ( maxRecords > 0 ) && ( size() > maxRecords );
+    size_t                                            nbEvicted = 0;
+
+    for ( unsigned int recordNo = 0; recordNo < records.size(); ++recordNo )
+    {
+        antSensorState &record = records[ recordNo ];
+        if ( ( record.key == C_FREE_KEY ) || record.pinned )
+        {
+            continue;
+        }
+        if ( record.lastSeen == C_NOT_SEEN )
+        {
+            record.lastSeen = currentTime;
+        }
+        if ( ( idleTime > 0 ) && ( currentTime - record.lastSeen > idleTime ) )
+        {
+            removeRecord( recordNo );
+            ++counters.nbEvictedIdle;
+        }
+        else if ( overLimit )
+        {
+            candidates.push_back( std::make_pair( record.lastSeen, recordNo ) );
+        }
+    }
+
+    if ( ( maxRecords > 0 ) && ( size() > maxRecords ) )
+    {
+        nbEvicted = std::min( size() - ( maxRecords - maxRecords / 16 ), candidates.size() );
+        std::nth_element( candidates.begin(), candidates.begin() + nbEvicted, candidates.end() );
+        for ( size_t counter = 0; counter < nbEvicted; ++counter )
+        {
+            removeRecord( candidates[ counter ].second );
+        }
+        counters.nbEvictedLimit += nbEvicted;
+    }
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Add the counters of another table to these ones.
+//
+// -------------------------------------------------------------------------------------------------//
+void antSensorStateTable::addCounters
+(
+    const antSensorStateCounters &other
+)
+{
+    counters.nbCreated      += other.nbCreated;
+    counters.nbEvictedIdle  += other.nbEvictedIdle;
+    counters.nbEvictedLimit += other.nbEvictedLimit;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Return the handle of a sensor given by its ID string, creating its record if necessary.
+//
+// -------------------------------------------------------------------------------------------------//
+antSensorHandle antSensorStateTable::intern
+(
+    const amString &sensorID
+)
+{
+    return antSensorHandle( *this, get( sensorID ) );
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Return the text form of a sensor ID (e.g. "PWRB10_442"), building it on first use.
+//
+// -------------------------------------------------------------------------------------------------//
+const amString &antSensorStateTable::getSensorID
+(
+    antSensorState &record
+)
+{
+    if ( record.sensorID.empty() && ( ( record.key & C_NO_DEVICE_ID_KEY ) == 0 ) )
+    {
+        record.sensorID  = families[ ( record.key >> 32 ) - 1 ];
+        record.sensorID += '_';
+        record.sensorID += amString( ( unsigned int ) ( record.key & 0xFFFFFFFF ) );
+    }
+    return record.sensorID;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Return the text form of the sensor ID of a handle.
+//
+// -------------------------------------------------------------------------------------------------//
+const amString &antSensorHandle::toString
+(
+    void
+) const
+{
+    if ( text != NULL )
+    {
+        return *text;
+    }
+    return table->getSensorID( ( record != NULL ) ? *record : table->get( *this ) );
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Remove the value of a field from all records (equivalent to clearing a std::map table).
+//
+// -------------------------------------------------------------------------------------------------//
+void antSensorStateTable::clearField
+(
+    int fieldNo
+)
+{
+    unsigned long long mask = ~( 1ULL << fieldNo );
+    for ( std::deque<antSensorState>::iterator record = records.begin(); record != records.end(); ++record )
+    {
+        record->present &= mask;
+    }
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Remove the values of all fields of 'fieldMask' from all records.
+//
+// -------------------------------------------------------------------------------------------------//
+void antSensorStateTable::clearFields
+(
+    unsigned long long fieldMask
+)
+{
+    for ( std::deque<antSensorState>::iterator record = records.begin(); record != records.end(); ++record )
+    {
+        record->present &= ~fieldMask;
+    }
+}
+
+// Unpin all records (the sensors of the device file are pinned again when it is read).
+void antSensorStateTable::clearPinning
+(
+    void
+)
+{
+    for ( std::deque<antSensorState>::iterator record = records.begin(); record != records.end(); ++record )
+    {
+        record->pinned = false;
+    }
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Append a copy of every record holding one of the fields of 'fieldMask', with its sensor ID.
+//
+// -------------------------------------------------------------------------------------------------//
+void antSensorStateTable::copyRecords
+(
+    std::vector<antSensorState> &copy,
+    unsigned long long           fieldMask
+)
+{
+    for ( std::deque<antSensorState>::iterator record = records.begin(); record != records.end(); ++record )
+    {
+        if ( ( record->present & fieldMask ) != 0 )
+        {
+            getSensorID( *record );
+            copy.push_back( *record );
+        }
+    }
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Double the number of slots and re-insert all records.
+//
+// -------------------------------------------------------------------------------------------------//
+void antSensorStateTable::growSlots
+(
+    void
+)
+{
+    unsigned int slotMask = 2 * slots.size() - 1;
+    unsigned int slotNo   = 0;
+
+    slots.assign( slotMask + 1, 0 );
+    for ( unsigned int recordNo = 0; recordNo < records.size(); ++recordNo )
+    {
+        if ( records[ recordNo ].key == C_FREE_KEY )
+        {
+            continue;
+        }
+        for ( slotNo = hashKey( records[ recordNo ].key, slotMask ); slots[ slotNo ] != 0; slotNo = ( slotNo + 1 ) & slotMask )
+        {
+        }
+        slots[ slotNo ] = recordNo + 1;
+    }
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Double the number of family slots and re-insert all families.
+//
+// -------------------------------------------------------------------------------------------------//
+void antSensorStateTable::growFamilies
+(
+    void
+)
+{
+    std::vector<amString> oldFamilies;
+
+    oldFamilies.swap( families );
+    familySlots.assign( 2 * familySlots.size(), 0 );
+    for ( unsigned int familyNo = 0; familyNo < oldFamilies.size(); ++familyNo )
+    {
+        findFamily( oldFamilies[ familyNo ].c_str(), oldFamilies[ familyNo ].size(), true );
+    }
+}
+
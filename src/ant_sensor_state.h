@@ -0,0 +1,366 @@
+#ifndef __ANT_SENSOR_STATE_H__
+#define __ANT_SENSOR_STATE_H__
+
+#include <stddef.h>
+#include <deque>
+#include <vector>
+
+#include "am_string.h"
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Bit numbers of the fields of antSensorState.
+// A field only holds a value if its bit is set in antSensorState::present.
+//
+// -------------------------------------------------------------------------------------------------//
+enum antSensorStateField
+{
+    // antProcessing
+    SS_REGISTERED,
+    SS_ZERO_TIME_COUNT,
+    SS_EVENT_TIME,
+    SS_EVENT_COUNT,
+    SS_TOTAL_TIME_INT,
+    SS_TOTAL_COUNT,
+    SS_OPERATING_TIME,
+    SS_SAME_EVENT_COUNT,
+    SS_TOTAL_TIME,
+    SS_TOTAL_OPERATING_TIME,
+
+    // antAeroProcessing
+    SS_AIR_SPEED_MULTIPLIER,
+    SS_RHO_CALIBRATION,
+
+    // antCadenceProcessing, antCadenceSpeedProcessing
+    SS_CADENCE,
+    SS_CADENCE_SENSOR,
+    SS_SPEED_CADENCE_SENSOR,
+
+    // antHRMProcessing
+    SS_HEART_RATE_SENSOR,
+    SS_PREVIOUS_HEART_RATE,
+    SS_HEART_RATE_EVENT_TIME,
+    SS_HEART_BEAT_TIME,
+
+    // antMultiSportSpeedDistProcessing
+    SS_MULTI_SPORT_TOTAL_DIST,
+    SS_MULTI_SPORT_EVENT_DIST,
+
+    // antPowerProcessing
+    SS_SLOPE_NM_10HZ,
+    SS_OFFSET,
+    SS_ACCUMULATED_POWER,
+    SS_ACCUMULATED_TORQUE,
+    SS_CRANK_OR_WHEEL_PERIOD,
+    SS_OTHER_EVENT_COUNT,
+    SS_OTHER_ACCUMULATED_POWER,
+    SS_OTHER_TOTAL_COUNT,
+    SS_OTHER_ACCUMULATED_TORQUE,
+    SS_OTHER_CRANK_OR_WHEEL_PERIOD,
+    SS_POWER,
+    SS_TORQUE,
+    SS_SPEED_SENSOR,
+
+    // antSpcadProcessing
+    SS_SPCAD_OPERATING_TIME,
+    SS_CADENCE_TIME,
+    SS_CADENCE_COUNT,
+
+    // antSpeedProcessing
+    SS_NB_MAGNETS,
+    SS_WHEEL_CIRCUMFERENCE,
+    SS_SPEED,
+    SS_USED_AS_SPEED_SENSOR,
+
+    // antStrideSpeedDistProcessing
+    SS_STRIDE_TOTAL_DIST,
+    SS_STRIDE_EVENT_DIST,
+    SS_TOTAL_STRIDE_COUNT,
+    SS_STRIDE_COUNT
+};
+
+// The fields holding values of the device file (option '-d'): parameters, registration ('-R') and
+// the roles of the sensors, as opposed to their running state. They are dropped when the device file
+// is reloaded and then set from the new file.
+const unsigned long long C_DEVICE_FILE_FIELDS = ( 1ULL << SS_AIR_SPEED_MULTIPLIER ) |
+                                                ( 1ULL << SS_RHO_CALIBRATION )      |
+                                                ( 1ULL << SS_SLOPE_NM_10HZ )        |
+                                                ( 1ULL << SS_OFFSET )               |
+                                                ( 1ULL << SS_NB_MAGNETS )           |
+                                                ( 1ULL << SS_WHEEL_CIRCUMFERENCE )  |
+                                                ( 1ULL << SS_REGISTERED )           |
+                                                ( 1ULL << SS_SPEED_SENSOR )         |
+                                                ( 1ULL << SS_USED_AS_SPEED_SENSOR ) |
+                                                ( 1ULL << SS_CADENCE_SENSOR )       |
+                                                ( 1ULL << SS_SPEED_CADENCE_SENSOR ) |
+                                                ( 1ULL << SS_HEART_RATE_SENSOR );
+
+// -------------------------------------------------------------------------------------------------//
+//
+// All counters, totals and configuration values kept for a single sensor (e.g. "PWRB10_442").
+//
+// -------------------------------------------------------------------------------------------------//
+struct antSensorState
+{
+    unsigned long long key;
+    unsigned long long present;
+    amString           sensorID;   // Text form, only built when it is needed (see antSensorStateTable::getSensorID).
+    long long          lastSeen;   // Time of the last lookup (see antSensorStateTable::setTime).
+    bool               pinned;     // Never evicted (sensors of the device file).
+
+    bool               registered;
+    unsigned int       zeroTimeCount;
+    unsigned int       eventTime;
+    unsigned int       eventCount;
+    unsigned int       totalTimeInt;
+    unsigned int       totalCount;
+    unsigned int       operatingTime;
+    unsigned int       sameEventCount;
+    double             totalTime;
+    double             totalOperatingTime;
+
+    double             airSpeedMultiplier;
+    double             rhoCalibration;
+
+    unsigned int       cadence;
+    bool               cadenceSensor;
+    bool               speedCadenceSensor;
+
+    bool               heartRateSensor;
+    unsigned int       previousHeartRate;
+    unsigned int       heartRateEventTime;
+    double             heartBeatTime;
+
+    double             multiSportTotalDist;
+    unsigned int       multiSportEventDist;
+
+    unsigned int       slope_Nm_10Hz;
+    unsigned int       offset;
+    unsigned int       accumulatedPower;
+    unsigned int       accumulatedTorque;
+    unsigned int       crankOrWheelPeriod;
+    unsigned int       otherEventCount;
+    unsigned int       otherAccumulatedPower;
+    unsigned int       otherTotalCount;
+    unsigned int       otherAccumulatedTorque;
+    unsigned int       otherCrankOrWheelPeriod;
+    double             power;
+    double             torque;
+    bool               speedSensor;
+
+    unsigned int       spcadOperatingTime;
+    unsigned int       cadenceTime;
+    unsigned int       cadenceCount;
+
+    double             nbMagnets;
+    double             wheelCircumference;
+    double             speed;
+    bool               usedAsSpeedSensor;
+
+    double             strideTotalDist;
+    unsigned int       strideEventDist;
+    unsigned int       totalStrideCount;
+    unsigned int       strideCount;
+};
+
+// Counters of the records of an antSensorStateTable.
+struct antSensorStateCounters
+{
+    unsigned long long nbCreated;
+    unsigned long long nbEvictedIdle;
+    unsigned long long nbEvictedLimit;
+};
+
+class antSensorStateTable;
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Compact reference to a sensor. Handles made by antSensorStateTable::intern() point straight at
+// the sensor's record, or hold its key if the sensor has no record yet: the record is only created
+// when the handle is first written through (so packets which are rejected, e.g. of unregistered
+// sensors, leave no record behind). Handles made from a sensor ID string (e.g. in semi-cooked
+// input) are resolved by the table when they are used.
+//
+// -------------------------------------------------------------------------------------------------//
+class antSensorHandle
+{
+
+    friend class antSensorStateTable;
+
+    private:
+
+        antSensorStateTable    *table;
+        mutable antSensorState *record;
+        const amString         *text;
+        unsigned long long      key;
+
+
+    public:
+
+        antSensorHandle( void ) : table( NULL ), record( NULL ), text( NULL ), key( 0 ) {}
+        antSensorHandle( antSensorStateTable &stateTable, antSensorState &stateRecord ) : table( &stateTable ), record( &stateRecord ), text( NULL ), key( 0 ) {}
+        antSensorHandle( antSensorStateTable &stateTable, unsigned long long stateKey ) : table( &stateTable ), record( NULL ), text( NULL ), key( stateKey ) {}
+        antSensorHandle( const amString &sensorID ) : table( NULL ), record( NULL ), text( &sensorID ), key( 0 ) {}
+
+        inline antSensorState *getRecord( void ) const { return record; }
+        inline const amString *getText( void ) const   { return text; }
+
+        const amString &toString( void ) const;
+        inline operator const amString &( void ) const { return toString(); }
+
+};
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Open addressing hash table of antSensorState records.
+// The key is built from the sensor type head (e.g. "PWRB10", which encodes device type and data
+// page family) and the numerical device ID, so lookups compare integers instead of strings.
+// The record found last is cached: the repeated lookups made while decoding one packet are free.
+// Every record remembers when it was last looked up, so the records of sensors which went away can be
+// evicted (see evict()). Evicted records are re-used for new sensors.
+//
+// -------------------------------------------------------------------------------------------------//
+class antSensorStateTable
+{
+
+    private:
+
+        std::deque<antSensorState> records;
+        std::vector<unsigned int>  slots;
+        std::vector<unsigned int>  freeRecords;
+        std::vector<amString>      families;
+        std::vector<unsigned int>  familySlots;
+        antSensorState            *lastRecord;
+        long long                  currentTime;
+        bool                       pinning;
+        antSensorStateCounters     counters;
+
+        bool            makeKey     ( unsigned long long &key, const amString &sensorID, bool create );
+        unsigned int    findFamily  ( const char *head, size_t length, bool create );
+        antSensorState *findKey     ( unsigned long long key, bool create );
+        antSensorState &addRecord   ( unsigned long long key, unsigned int slotNo );
+        void            removeRecord( unsigned int recordNo );
+        void            growSlots   ( void );
+        void            growFamilies( void );
+
+        inline void touch( antSensorState &record )
+        {
+            record.lastSeen = currentTime;
+            record.pinned   = record.pinned || pinning;
+        }
+
+
+    public:
+
+        antSensorStateTable( void );
+        ~antSensorStateTable( void ) {};
+
+        antSensorState *find( const amString &sensorID );
+        antSensorState &get ( const amString &sensorID );
+
+        antSensorState *find( const antSensorHandle &sensor );
+        antSensorState &get ( const antSensorHandle &sensor );
+
+        antSensorHandle intern( const char *head, unsigned int deviceID );
+        antSensorHandle intern( const amString &sensorID );
+
+        const amString &getSensorID( antSensorState &record );
+
+        void clearField ( int fieldNo );
+        void clearFields( unsigned long long fieldMask );
+        void clearPinning( void );
+
+        void copyRecords( std::vector<antSensorState> &copy, unsigned long long fieldMask );
+
+        // Time stamp given to the records looked up from now on.
+        inline void setTime( long long now ) { currentTime = now; }
+
+        // While pinning, the records looked up are pinned (e.g. while reading the device file).
+        inline void setPinning( bool value ) { pinning = value; }
+
+        void evict( long long idleTime, size_t maxRecords );
+
+        inline size_t                        size       ( void ) const { return records.size() - freeRecords.size(); }
+        inline const antSensorStateCounters &getCounters( void ) const { return counters; }
+
+        // Add the counters of another table (e.g. of a decode thread) to these ones.
+        void addCounters( const antSensorStateCounters &other );
+
+};
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Owner of the state table, shared as a virtual base by antProcessing and the speed and cadence
+// helper classes so all of them keep their per-sensor values in the same records.
+//
+// -------------------------------------------------------------------------------------------------//
+class antSensorStateStore
+{
+
+    protected:
+
+        antSensorStateTable sensorStates;
+
+
+    public:
+
+        antSensorStateStore( void ) {};
+        ~antSensorStateStore( void ) {};
+
+};
+
+// -------------------------------------------------------------------------------------------------//
+//
+// A single field of antSensorState seen through a std::map like interface (count, operator[],
+// insert and clear) indexed by sensor.
+//
+// -------------------------------------------------------------------------------------------------//
+template <class T> class antSensorField
+{
+
+    private:
+
+        antSensorStateTable &table;
+        T antSensorState::  *member;
+        int                  field;
+        unsigned long long   mask;
+
+
+    public:
+
+        antSensorField( antSensorStateTable &stateTable, T antSensorState::*stateMember, int fieldNo )
+            : table( stateTable ), member( stateMember ), field( fieldNo ), mask( 1ULL << fieldNo ) {}
+
+        size_t count( const antSensorHandle &sensor )
+        {
+            antSensorState *record = table.find( sensor );
+            return ( ( record != NULL ) && ( ( record->present & mask ) != 0 ) ) ? 1 : 0;
+        }
+
+        T &operator[]( const antSensorHandle &sensor )
+        {
+            antSensorState &record = table.get( sensor );
+            if ( ( record.present & mask ) == 0 )
+            {
+                record.*member  = T();
+                record.present |= mask;
+            }
+            return record.*member;
+        }
+
+        void insert( const antSensorHandle &sensor, T value )
+        {
+            antSensorState &record = table.get( sensor );
+            if ( ( record.present & mask ) == 0 )
+            {
+                record.*member  = value;
+                record.present |= mask;
+            }
+        }
+
+        inline void clear( void ) { table.clearField( field ); }
+
+};
+
+#endif // __ANT_SENSOR_STATE_H__
+
@@ -0,0 +1,230 @@
+#include <cstdio>
+#include <cstring>
+
+#include "ant_sequence_tracker.h"
+
+const unsigned int C_MAX_SEQUENCE_STREAMS = 8;    // Sources per sender address of files and stdin.
+const unsigned int C_SEQUENCE_MATCH_AHEAD = 32;   // A packet continues a source if it is at most this far ahead ...
+const unsigned int C_SEQUENCE_LATE_WINDOW = 16;   // Packets at most this far behind came late (1 behind: duplicate).
+
+// -------------------------------------------------------------------------------------------------//
+//
+// The packet with sequence number 'sequence' is shortly behind the one expected from 'source'.
+//
+// -------------------------------------------------------------------------------------------------//
+static inline bool isLate
+(
+    const antSequenceSource &source,
+    BYTE                     sequence
+)
+{
+    unsigned int behind = ( BYTE ) ( source.nextSequence - sequence );
+    return ( source.nbPackets > 0 ) && ( behind > 0 ) && ( behind <= C_SEQUENCE_LATE_WINDOW );
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Return the number of the source of a packet with sequence number 'sequence' of the sender
+// 'address', add a source if needed.
+// Multicast senders have a single source. Files and stdin (address 0) may interleave several
+// bridges: the packet goes to the source it continues (the one it is closest to, ahead or shortly
+// behind), a new source is started for it if none fits. Query responses ('macAddress' not NULL)
+// only go to sources of their bridge or of a bridge not known yet.
+//
+// -------------------------------------------------------------------------------------------------//
+unsigned int antSequenceTracker::findSource
+(
+    unsigned int  address,
+    BYTE          sequence,
+    const BYTE   *macAddress
+)
+{
+    unsigned int maxStreams = ( address == 0 ) ? C_MAX_SEQUENCE_STREAMS : 1;
+    unsigned int nbStreams  = 0;
+    unsigned int freeSource = sources.size();
+    unsigned int bestSource = sources.size();
+    unsigned int bestAhead  = 256;
+    unsigned int ahead      = 0;
+
+    for ( unsigned int counter = 0; counter < sources.size(); ++counter )
+    {
+        const antSequenceSource &source = sources[ counter ];
+        if ( !source.used )
+        {
+            freeSource = ( freeSource < sources.size() ) ? freeSource : counter;
+            continue;
+        }
+        if ( source.address != address )
+        {
+            continue;
+        }
+        ++nbStreams;
+        if ( ( macAddress != NULL ) && source.hasMACAddress && ( memcmp( source.macAddress, macAddress, C_BRIDGE_MAC_LENGTH ) != 0 ) )
+        {
+            continue;
+        }
+        ahead = ( BYTE ) ( sequence - source.nextSequence );
+        if ( isLate( source, sequence ) )
+        {
+            // Rank by the distance behind.
+            ahead = ( BYTE ) ( source.nextSequence - sequence );
+        }
+        if ( ahead < bestAhead )
+        {
+            bestAhead  = ahead;
+            bestSource = counter;
+        }
+    }
+
+    // Without a fitting source, start another one while there is room, else take the closest.
+    if ( ( bestSource == sources.size() ) || ( ( bestAhead > C_SEQUENCE_MATCH_AHEAD ) && ( nbStreams < maxStreams ) ) )
+    {
+        antSequenceSource source;
+        memset( &source, 0, sizeof( source ) );
+        source.used         = true;
+        source.address      = address;
+        source.nextSequence = sequence;
+        bestSource          = freeSource;
+        if ( freeSource == sources.size() )
+        {
+            sources.push_back( source );
+        }
+        else
+        {
+            sources[ freeSource ] = source;
+        }
+    }
+    return bestSource;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Source 'sourceNo' turned out to be bridge 'macAddress': if another source of the sender is this
+// bridge (e.g. before the bridge restarted or a capture was cut), continue that one. Returns the
+// number of the source to count on.
+//
+// -------------------------------------------------------------------------------------------------//
+unsigned int antSequenceTracker::joinSource
+(
+    unsigned int  sourceNo,
+    const BYTE   *macAddress
+)
+{
+    antSequenceSource &source = sources[ sourceNo ];
+
+    for ( unsigned int counter = 0; counter < sources.size(); ++counter )
+    {
+        antSequenceSource &other = sources[ counter ];
+        if ( ( counter != sourceNo ) && other.used && other.hasMACAddress && ( other.address == source.address ) &&
+             ( memcmp( other.macAddress, macAddress, C_BRIDGE_MAC_LENGTH ) == 0 ) )
+        {
+            other.nextSequence     = source.nextSequence;
+            other.lastSeen         = ( source.lastSeen > other.lastSeen ) ? source.lastSeen : other.lastSeen;
+            other.nbPackets       += source.nbPackets;
+            other.nbGaps          += source.nbGaps;
+            other.nbLost          += source.nbLost;
+            other.nbReordered     += source.nbReordered;
+            other.nbDuplicates    += source.nbDuplicates;
+            other.reportedPackets += source.reportedPackets;
+            other.reportedLost    += source.reportedLost;
+            source.used            = false;
+            return counter;
+        }
+    }
+    memcpy( source.macAddress, macAddress, C_BRIDGE_MAC_LENGTH );
+    source.hasMACAddress = true;
+    return sourceNo;
+}
+
+unsigned int antSequenceTracker::track
+(
+    unsigned int  address,
+    BYTE          sequence,
+    long long     now,
+    const BYTE   *macAddress
+)
+{
+    unsigned int sourceNo = findSource( address, sequence, macAddress );
+
+    if ( ( macAddress != NULL ) && !sources[ sourceNo ].hasMACAddress )
+    {
+        sourceNo = joinSource( sourceNo, macAddress );
+    }
+
+    antSequenceSource &source = sources[ sourceNo ];
+    if ( isLate( source, sequence ) )
+    {
+        if ( ( BYTE ) ( source.nextSequence - sequence ) == 1 )
+        {
+            ++source.nbDuplicates;
+        }
+        else
+        {
+            // It was counted as lost when the gap it left was seen.
+            ++source.nbReordered;
+            if ( source.nbLost > 0 )
+            {
+                --source.nbLost;
+            }
+        }
+    }
+    else
+    {
+        if ( sequence != source.nextSequence )
+        {
+            ++source.nbGaps;
+            source.nbLost += ( BYTE ) ( sequence - source.nextSequence );
+        }
+        source.nextSequence = sequence + 1;
+    }
+    ++source.nbPackets;
+    source.lastSeen = now;
+
+    return sourceNo;
+}
+
+// Time of the last packet of any source.
+long long antSequenceTracker::getLastSeen
+(
+    void
+) const
+{
+    long long result = 0;
+    for ( unsigned int counter = 0; counter < sources.size(); ++counter )
+    {
+        if ( sources[ counter ].lastSeen > result )
+        {
+            result = sources[ counter ].lastSeen;
+        }
+    }
+    return result;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Name of a source: the end of the MAC address of its bridge (like the bridge records) once it is
+// known, else the address of the sender, else the number of the source.
+//
+// -------------------------------------------------------------------------------------------------//
+amString antSequenceTracker::getSourceID
+(
+    unsigned int sourceNo
+) const
+{
+    const antSequenceSource &source = sources[ sourceNo ];
+    char                     buffer[ C_TINY_BUFFER_SIZE ];
+
+    if ( source.hasMACAddress )
+    {
+        sprintf( buffer, "%02X%02X%02X", source.macAddress[ 3 ], source.macAddress[ 4 ], source.macAddress[ 5 ] );
+    }
+    else if ( source.address != 0 )
+    {
+        sprintf( buffer, "%u.%u.%u.%u", source.address >> 24, ( source.address >> 16 ) & 0xFF, ( source.address >> 8 ) & 0xFF, source.address & 0xFF );
+    }
+    else
+    {
+        sprintf( buffer, "%u", sourceNo + 1 );
+    }
+    return amString( buffer );
+}
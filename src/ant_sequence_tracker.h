@@ -0,0 +1,84 @@
+#ifndef __ANT_SEQUENCE_TRACKER_H__
+#define __ANT_SEQUENCE_TRACKER_H__
+
+#include <vector>
+
+#include "am_string.h"
+#include "ant_constants.h"
+
+const int C_BRIDGE_MAC_LENGTH = 6;   // Bytes of the MAC address of a bridge.
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Counters of the packets of a single bridge (source of ANT messages).
+//
+// -------------------------------------------------------------------------------------------------//
+struct antSequenceSource
+{
+    bool               used;            // Else free for another source.
+    unsigned int       address;         // IPv4 address of the sender (multicast input), 0: file or stdin.
+    bool               hasMACAddress;   // The bridge has sent a query response (C_QUERY_RESP).
+    BYTE               macAddress[ C_BRIDGE_MAC_LENGTH ];
+    BYTE               nextSequence;    // Sequence number expected next.
+    long long          lastSeen;
+    unsigned long long nbPackets;
+    unsigned long long nbGaps;          // Number of times packets were missing.
+    unsigned long long nbLost;          // Number of packets missing (less the ones which came late).
+    unsigned long long nbReordered;     // Packets which came after packets sent after them.
+    unsigned long long nbDuplicates;
+    unsigned long long reportedPackets; // Counts at the last report, for the loss rate since then.
+    unsigned long long reportedLost;
+};
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Sequence gap and loss detection (option '-G').
+// Every message of a bridge (ANT messages and query responses alike) carries the next number of a
+// sequence counter of a byte. A number ahead of the one expected is a gap: the packets in between
+// were lost on the way from the bridge. A number shortly behind is a packet which came late (it was
+// counted as lost when the gap was seen) or a duplicate of the previous packet.
+//
+// Multicast input is split into sources by the address of the sender. Files and stdin have no
+// sender addresses, but may hold the packets of several bridges: every packet goes to the source
+// whose sequence it continues best, up to C_MAX_SEQUENCE_STREAMS sources per address. Once the query
+// response of a source tells its bridge, an older source of the same bridge is continued instead.
+//
+// -------------------------------------------------------------------------------------------------//
+class antSequenceTracker
+{
+
+    private:
+
+        std::vector<antSequenceSource> sources;
+
+        unsigned int findSource( unsigned int address, BYTE sequence, const BYTE *macAddress );
+        unsigned int joinSource( unsigned int sourceNo, const BYTE *macAddress );
+
+
+    public:
+
+        antSequenceTracker( void ) {};
+        ~antSequenceTracker( void ) {};
+
+        // Count a packet with sequence number 'sequence' of the sender 'address' and, for query
+        // responses, the MAC address of the bridge. Returns the number of its source.
+        unsigned int track( unsigned int address, BYTE sequence, long long now, const BYTE *macAddress = NULL );
+
+        // Changes whenever a gap is seen in the sequence of the source.
+        inline unsigned long long getGapTag( unsigned int sourceNo ) const
+        {
+            return ( ( unsigned long long ) ( sourceNo + 1 ) << 32 ) | ( sources[ sourceNo ].nbGaps & 0xFFFFFFFFULL );
+        }
+
+        amString  getSourceID( unsigned int sourceNo ) const;
+        long long getLastSeen( void ) const;
+
+        inline size_t                   size      ( void ) const            { return sources.size(); }
+        inline antSequenceSource       &operator[]( unsigned int sourceNo )       { return sources[ sourceNo ]; }
+        inline const antSequenceSource &operator[]( unsigned int sourceNo ) const { return sources[ sourceNo ]; }
+
+        inline void clear( void ) { sources.clear(); }
+
+};
+
+#endif // __ANT_SEQUENCE_TRACKER_H__
@@ -23,7 +23,10 @@ antSpcadProcessing::antSpcadProcessing
     void
 ) : antProcessing(),
     antSpeedProcessing(),
-    antCadenceProcessing()
+    antCadenceProcessing(),
+    operatingTimeTable( sensorStates, &antSensorState::spcadOperatingTime, SS_SPCAD_OPERATING_TIME ),
+    cadenceTimeTable( sensorStates, &antSensorState::cadenceTime, SS_CADENCE_TIME ),
+    cadenceCountTable( sensorStates, &antSensorState::cadenceCount, SS_CADENCE_COUNT )
 {
     reset();
     setCurrentDeviceType( "SPCAD790" );
@@ -70,7 +73,7 @@ bool antSpcadProcessing::appendSpeedSensor
 //
 // Parameters:
 //    int             deviceType        IN   Device type (SPCAD, SPEED, CADENCE, HRM, AERO, POWER).
-//    const amString &deviceID          IN   Device ID (number).
+//    unsigned int    deviceID          IN   Device ID (number).
 //    const amString &timeStampBuffer   IN   Time stamp.
 //    BYTE            payLoad[]         IN   Array of bytes with the data to be converted.
 //
@@ -82,7 +85,7 @@ bool antSpcadProcessing::appendSpeedSensor
 amDeviceType antSpcadProcessing::processSensor
 (
     int             deviceType,
-    const amString &deviceIDNo,
+    unsigned int    deviceIDNo,
     const amString &timeStampBuffer,
     BYTE            payLoad[]
 )
@@ -99,7 +102,7 @@ amDeviceType antSpcadProcessing::processSensor
         resetOutBuffer();
         if ( outputUnknown )
         {
-            int deviceIDNoAsInt = deviceIDNo.toInt();
+            int deviceIDNoAsInt = ( int ) deviceIDNo;
             createUnknownDeviceTypeString( deviceType, deviceIDNoAsInt, timeStampBuffer, payLoad );
         }
     }
@@ -210,24 +213,21 @@ void antSpcadProcessing::readDeviceFileLine
 //-------------------------------------------------------------------------------------------------//
 amDeviceType antSpcadProcessing::processSpeedAndCadenceSensor
 (
-    const amString &deviceIDNo,
+    unsigned int    deviceIDNo,
     const amString &timeStampBuffer,
     BYTE            payLoad[]
 )
 {
-    char         auxBuffer[ C_MEDIUM_BUFFER_SIZE ] = { 0 };
-    unsigned int bikeCadenceEventTime              = 0;
-    unsigned int cumCadenceRevCount                = 0;
-    unsigned int bikeSpeedEventTime                = 0;
-    unsigned int wheelRevolutionCount              = 0;
-    unsigned int deltaSpeedEventTime               = 0;
-    unsigned int deltaWheelRevolutionCount         = 0;
-    unsigned int deltaCadenceEventTime             = 0;
-    unsigned int deltaCrankRevolutionCount         = 0;
-    unsigned int rollOver                          = 0;
-    bool         rollOverHappened                  = false;
-    amDeviceType result                            = OTHER_DEVICE;
-    amString     sensorID                          = amString( C_SPCAD_DEVICE_HEAD ) + deviceIDNo;
+    char                  auxBuffer[ C_MEDIUM_BUFFER_SIZE ] = { 0 };
+    unsigned int          bikeCadenceEventTime              = 0;
+    unsigned int          cumCadenceRevCount                = 0;
+    unsigned int          bikeSpeedEventTime                = 0;
+    unsigned int          wheelRevolutionCount              = 0;
+    unsigned int          rollOver                          = 0;
+    bool                  rollOverHappened                  = false;
+    amDeviceType          result                            = OTHER_DEVICE;
+    antSensorHandle       sensorID                          = sensorStates.intern( C_SPCAD_DEVICE_HEAD, deviceIDNo );
+    antSpeedCadenceRecord record                            = antSpeedCadenceRecord();
 
     if ( isRegisteredDevice( sensorID ) )
     {
@@ -237,9 +237,9 @@ amDeviceType antSpcadProcessing::processSpeedAndCadenceSensor
 
         // - - - - - - - - - - - - - - - - - - - - -
         // Cadence Event Time
-        bikeCadenceEventTime  = byte2UInt( payLoad[ 1 ], payLoad[ 0 ] );
-        rollOver              = 65536;  // 256^2
-        deltaCadenceEventTime = getDeltaInt( rollOverHappened, sensorID, rollOver, cadenceTimeTable, bikeCadenceEventTime );
+        bikeCadenceEventTime         = byte2UInt( payLoad[ 1 ], payLoad[ 0 ] );
+        rollOver                     = 65536;  // 256^2
+        record.deltaCadenceEventTime = getDeltaInt( rollOverHappened, sensorID, rollOver, cadenceTimeTable, bikeCadenceEventTime );
         if ( diagnostics )
         {
             appendDiagnosticsLine( "\"Cadence Event Time", payLoad[ 1 ], payLoad[ 0 ], bikeCadenceEventTime );
@@ -248,15 +248,15 @@ amDeviceType antSpcadProcessing::processSpeedAndCadenceSensor
             {
                 sprintf( auxBuffer, " (Rollover [%d] occurred)", rollOver );
             }
-            appendDiagnosticsLine( "Delta Cadence Event Time", deltaCadenceEventTime, auxBuffer );
+            appendDiagnosticsLine( "Delta Cadence Event Time", record.deltaCadenceEventTime, auxBuffer );
         }
 
 
         // - - - - - - - - - - - - - - - - - - - - -
         // Cadence Revolution Count
-        cumCadenceRevCount        = byte2UInt( payLoad[ 3 ], payLoad[ 2 ] );
-        rollOver                  = 65536;  // 256^2
-        deltaCrankRevolutionCount = getDeltaInt( rollOverHappened, sensorID, rollOver, cadenceCountTable, cumCadenceRevCount );
+        cumCadenceRevCount               = byte2UInt( payLoad[ 3 ], payLoad[ 2 ] );
+        rollOver                         = 65536;  // 256^2
+        record.deltaCrankRevolutionCount = getDeltaInt( rollOverHappened, sensorID, rollOver, cadenceCountTable, cumCadenceRevCount );
         if ( diagnostics )
         {
             appendDiagnosticsLine( "Cadence Revolution Count", payLoad[ 3 ], payLoad[ 2 ], cumCadenceRevCount );
@@ -265,15 +265,15 @@ amDeviceType antSpcadProcessing::processSpeedAndCadenceSensor
             {
                 sprintf( auxBuffer, " (Rollover [%d] occurred)", rollOver );
             }
-            appendDiagnosticsLine( "Delta Cadence Revolution Count", deltaCrankRevolutionCount, auxBuffer );
+            appendDiagnosticsLine( "Delta Cadence Revolution Count", record.deltaCrankRevolutionCount, auxBuffer );
         }
 
 
         // - - - - - - - - - - - - - - - - - - - - -
         // Speed Event Time
-        bikeSpeedEventTime  = byte2UInt( payLoad[ 5 ], payLoad[ 4 ] );
-        rollOver            = 65536;  // 256^2
-        deltaSpeedEventTime = getDeltaInt( rollOverHappened, sensorID, rollOver, eventTimeTable, bikeSpeedEventTime );
+        bikeSpeedEventTime         = byte2UInt( payLoad[ 5 ], payLoad[ 4 ] );
+        rollOver                   = 65536;  // 256^2
+        record.deltaSpeedEventTime = getDeltaInt( rollOverHappened, sensorID, rollOver, eventTimeTable, bikeSpeedEventTime );
         if ( diagnostics )
         {
             appendDiagnosticsLine( "Bike Speed Event Time", payLoad[ 5 ], payLoad[ 4 ], bikeSpeedEventTime );
@@ -282,51 +282,30 @@ amDeviceType antSpcadProcessing::processSpeedAndCadenceSensor
             {
                 sprintf( auxBuffer, " (Rollover [%d] occurred)", rollOver );
             }
-            appendDiagnosticsLine( "Delta Bike Speed Event Time", deltaSpeedEventTime, auxBuffer );
+            appendDiagnosticsLine( "Delta Bike Speed Event Time", record.deltaSpeedEventTime, auxBuffer );
         }
 
 
         // - - - - - - - - - - - - - - - - - - - - -
         // Cumulated Wheel Count
-        wheelRevolutionCount      = byte2UInt( payLoad[ 7 ], payLoad[ 6 ] );
-        rollOver                  = 65536;  // 256^2
-        deltaWheelRevolutionCount = getDeltaInt( rollOverHappened, sensorID, rollOver, eventCountTable, wheelRevolutionCount );
+        wheelRevolutionCount             = byte2UInt( payLoad[ 7 ], payLoad[ 6 ] );
+        rollOver                         = 65536;  // 256^2
+        record.deltaWheelRevolutionCount = getDeltaInt( rollOverHappened, sensorID, rollOver, eventCountTable, wheelRevolutionCount );
         if ( diagnostics )
         {
-            appendDiagnosticsLine( "Cumulative Wheel Revolution Count", payLoad[ 7 ], payLoad[ 6 ], deltaWheelRevolutionCount );
+            appendDiagnosticsLine( "Cumulative Wheel Revolution Count", payLoad[ 7 ], payLoad[ 6 ], record.deltaWheelRevolutionCount );
             *auxBuffer = 0;
             if ( rollOverHappened )
             {
                 sprintf( auxBuffer, " (Rollover [%d] occurred)", rollOver );
             }
-            appendDiagnosticsLine( "Delta Cumulative Wheel Revolution Count", deltaWheelRevolutionCount, auxBuffer );
+            appendDiagnosticsLine( "Delta Cumulative Wheel Revolution Count", record.deltaWheelRevolutionCount, auxBuffer );
         }
     }
 
     if ( result == SPEED_SENSOR )
     {
-        unsigned int zeroTime           = getZeroTimeCount( sensorID );
-        unsigned int nbMagnets          = ( unsigned int) round( getNbMagnets( sensorID ) );
-        double       wheelCircumference = getWheelCircumference( sensorID );
-        double       speed              = getSpeed( sensorID );
-        unsigned int cadence            = getCadence( sensorID );
-        createOutputHeader( sensorID, timeStampBuffer );
-        createSPCADResultString
-        (
-            speed,
-            cadence,
-            deltaWheelRevolutionCount,
-            deltaSpeedEventTime,
-            deltaCrankRevolutionCount,
-            deltaCadenceEventTime,
-            wheelCircumference,
-            nbMagnets,
-            zeroTime
-        );
-        setSpeed( sensorID, speed );
-        setCadence( sensorID, cadence );
-        setZeroTimeCount( sensorID, zeroTime );
-        appendOutputFooter( getVersion() );
+        outputSpeedCadenceRecord( sensorID, timeStampBuffer, getVersion(), record );
     }
 
     if ( result == OTHER_DEVICE )
@@ -334,7 +313,7 @@ amDeviceType antSpcadProcessing::processSpeedAndCadenceSensor
         resetOutBuffer();
         if ( outputUnknown )
         {
-            int deviceIDNoAsInt = deviceIDNo.toInt();
+            int deviceIDNoAsInt = ( int ) deviceIDNo;
             createUnknownDeviceTypeString( C_SPCAD_TYPE, deviceIDNoAsInt, timeStampBuffer, payLoad );
         }
     }
@@ -359,17 +338,14 @@ amDeviceType antSpcadProcessing::processSpeedAndCadenceSensorSemiCooked
     amDeviceType result = OTHER_DEVICE;
     if ( !inputBuffer.empty() )
     {
-        amString      curVersion                = getVersion();
-        amString      sensorID;
-        amString      semiCookedString;
-        amString      timeStampBuffer;
-        amSplitString words;
-        unsigned int  nbWords                   = words.split( inputBuffer );
-        unsigned int  counter                   = 0;
-        unsigned int  deltaSpeedEventTime       = 0;
-        unsigned int  deltaWheelRevolutionCount = 0;
-        unsigned int  deltaCadenceEventTime     = 0;
-        unsigned int  deltaCrankRevolutionCount = 0;
+        amString              curVersion = getVersion();
+        amString              sensorID;
+        amString              semiCookedString;
+        amString              timeStampBuffer;
+        amSplitString         words;
+        unsigned int          nbWords    = words.split( inputBuffer );
+        unsigned int          counter    = 0;
+        antSpeedCadenceRecord record     = antSpeedCadenceRecord();
 
         if ( nbWords > 6 )
         {
@@ -384,46 +360,24 @@ amDeviceType antSpcadProcessing::processSpeedAndCadenceSensorSemiCooked
             }
             if ( isRegisteredDevice( sensorID ) && ( semiCookedString == C_SEMI_COOKED_SYMBOL_AS_STRING ) && isSpeedAndCadenceSensor( sensorID ) )
             {
-                result                    = SPEED_SENSOR;
-                deltaSpeedEventTime       = words[ counter++ ].toUInt();      // 3
-                deltaWheelRevolutionCount = words[ counter++ ].toUInt();      // 4
-                deltaCadenceEventTime     = words[ counter++ ].toUInt();      // 5
-                deltaCrankRevolutionCount = words[ counter++ ].toUInt();      // 6
+                result                           = SPEED_SENSOR;
+                record.deltaSpeedEventTime       = words[ counter++ ].toUInt();      // 3
+                record.deltaWheelRevolutionCount = words[ counter++ ].toUInt();      // 4
+                record.deltaCadenceEventTime     = words[ counter++ ].toUInt();      // 5
+                record.deltaCrankRevolutionCount = words[ counter++ ].toUInt();      // 6
                 if ( diagnostics )
                 {
-                    appendDiagnosticsLine( "Delta Speed Event Time", deltaSpeedEventTime );
-                    appendDiagnosticsLine( "Delta Cumulative Wheel Revolution Count", deltaWheelRevolutionCount );
-                    appendDiagnosticsLine( "Delta Cadence Event Time", deltaCadenceEventTime );
-                    appendDiagnosticsLine( "Delta Cadence Revolution Count", deltaCrankRevolutionCount );
+                    appendDiagnosticsLine( "Delta Speed Event Time", record.deltaSpeedEventTime );
+                    appendDiagnosticsLine( "Delta Cumulative Wheel Revolution Count", record.deltaWheelRevolutionCount );
+                    appendDiagnosticsLine( "Delta Cadence Event Time", record.deltaCadenceEventTime );
+                    appendDiagnosticsLine( "Delta Cadence Revolution Count", record.deltaCrankRevolutionCount );
                 }
             }
         }
 
         if ( result == SPEED_SENSOR )
         {
-            unsigned int zeroTime           = getZeroTimeCount( sensorID );
-            unsigned int nbMagnets          = ( unsigned int) round( getNbMagnets( sensorID ) );
-            double       wheelCircumference = getWheelCircumference( sensorID );
-            double       speed              = getSpeed( sensorID );
-            unsigned int cadence            = getCadence( sensorID );
-            createOutputHeader( sensorID, timeStampBuffer );
-            createSPCADResultString
-            (
-                speed,
-                cadence,
-                deltaWheelRevolutionCount,
-                deltaSpeedEventTime,
-                deltaCrankRevolutionCount,
-                deltaCadenceEventTime,
-                wheelCircumference,
-                nbMagnets,
-                zeroTime
-            );
-
-            setSpeed( sensorID, speed );
-            setCadence( sensorID, cadence );
-            setZeroTimeCount( sensorID, zeroTime );
-            appendOutputFooter( curVersion );
+            outputSpeedCadenceRecord( sensorID, timeStampBuffer, curVersion, record );
         }
         else
         {
@@ -438,58 +392,29 @@ amDeviceType antSpcadProcessing::processSpeedAndCadenceSensorSemiCooked
     return result;
 }
 
-void antSpcadProcessing::createSPCADResultString
+void antSpcadProcessing::outputSpeedCadenceRecord
 (
-    double       &speed,
-    unsigned int &cadence,
-    unsigned int  deltaWheelRevolutionCount,
-    unsigned int  deltaBikeSpeedEventTime,
-    unsigned int  deltaCrankRevolutionCount,
-    unsigned int  deltaCadenceEventTime,
-    double        wheelCircumference,
-    unsigned int  numberOfMagnets,
-    unsigned int &zeroTime
+    const antSensorHandle &sensorID,
+    const amString        &timeStampBuffer,
+    const amString        &versionString,
+    antSpeedCadenceRecord &record
 )
 {
+    unsigned int zeroTime = getZeroTimeCount( sensorID );
+
+    record.numberOfMagnets    = ( unsigned int) round( getNbMagnets( sensorID ) );
+    record.wheelCircumference = getWheelCircumference( sensorID );
+    record.speed              = getSpeed( sensorID );
+    record.cadence            = getCadence( sensorID );
     if ( !semiCookedOut )
     {
-        cadence = computeCadence( cadence, deltaCrankRevolutionCount, deltaCadenceEventTime );
-        speed   = computeSpeed( speed, deltaWheelRevolutionCount, deltaBikeSpeedEventTime, wheelCircumference, numberOfMagnets, zeroTime, maxZeroTime );
+        record.cadence = computeCadence( record.cadence, record.deltaCrankRevolutionCount, record.deltaCadenceEventTime );
+        record.speed   = computeSpeed( record.speed, record.deltaWheelRevolutionCount, record.deltaSpeedEventTime, record.wheelCircumference, record.numberOfMagnets, zeroTime, maxZeroTime );
     }
 
-    if ( outputAsJSON )
-    {
-        if ( semiCookedOut )
-        {
-            appendJSONItem( "delta speed event time",       deltaBikeSpeedEventTime );
-            appendJSONItem( "delta wheel revolution count", deltaWheelRevolutionCount );
-            appendJSONItem( "delta cadence event time",     deltaCadenceEventTime );
-            appendJSONItem( "delta crank revolution count", deltaCrankRevolutionCount );
-        }
-        else
-        {
-            appendJSONItem( C_SPEED_JSON,          speed,              getValuePrecision() );
-            appendJSONItem( "wheel circumference", wheelCircumference, getValuePrecision() );
-            appendJSONItem( "number of magnets",   numberOfMagnets );
-            appendJSONItem( C_CADENCE_JSON,        cadence  );
-        }
-    }
-    else
-    {
-        if ( semiCookedOut )
-        {
-            appendOutput( deltaBikeSpeedEventTime );
-            appendOutput( deltaWheelRevolutionCount );
-            appendOutput( deltaCadenceEventTime );
-            appendOutput( deltaCrankRevolutionCount );
-        }
-        else
-        {
-            appendOutput( speed, getValuePrecision() );
-            appendOutput( cadence );
-            appendOutput( wheelCircumference, getValuePrecision() );
-            appendOutput( numberOfMagnets );
-        }
-    }
-}
+    outputRecord( antRecordContext( sensorID, timeStampBuffer, versionString ), record );
 
+    setSpeed( sensorID, record.speed );
+    setCadence( sensorID, record.cadence );
+    setZeroTimeCount( sensorID, zeroTime );
+}
@@ -12,25 +12,14 @@ class antSpcadProcessing : virtual public antProcessing,
 
     private:
 
-        std::map<amString, unsigned int> operatingTimeTable;
-        std::map<amString, unsigned int> cadenceTimeTable;
-        std::map<amString, unsigned int> cadenceCountTable;
+        antSensorField<unsigned int> operatingTimeTable;
+        antSensorField<unsigned int> cadenceTimeTable;
+        antSensorField<unsigned int> cadenceCountTable;
 
-        amDeviceType processSpeedAndCadenceSensor( const amString &deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
+        amDeviceType processSpeedAndCadenceSensor( unsigned int deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
         amDeviceType processSpeedAndCadenceSensorSemiCooked( const amString &inputBuffer );
 
-        void createSPCADResultString
-             (
-                 double       &speed,
-                 unsigned int &cadence,
-                 unsigned int  deltaSpeedEventTime,
-                 unsigned int  deltaWheelRevolutionCount,
-                 unsigned int  deltaCadenceEventTime,
-                 unsigned int  deltaCrankRevolutionCount,
-                 double        wheelCircumference,
-                 unsigned int  numberOfMagnets,
-                 unsigned int &zeroCountTime
-             );
+        void outputSpeedCadenceRecord( const antSensorHandle &sensorID, const amString &timeStampBuffer, const amString &versionString, antSpeedCadenceRecord &record );
 
     protected:
 
@@ -46,10 +35,11 @@ class antSpcadProcessing : virtual public antProcessing,
 
         bool isSpeedAndCadenceSensor( const amString &sensorID );
 
-        virtual amDeviceType processSensor( int deviceType, const amString &deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
+        virtual amDeviceType processSensor( int deviceType, unsigned int deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
         virtual amDeviceType processSensorSemiCooked( const amString &inputBuffer );
 
         virtual void reset( void );
+        virtual antProcessing *createWorker( void ) const { return new antSpcadProcessing; }
 
 };
 
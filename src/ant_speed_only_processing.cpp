@@ -78,7 +78,7 @@ bool antSpeedOnlyProcessing::appendSpeedSensor
 //
 // Parameters:
 //    int             deviceType        IN   Device type (SPCAD, SPEED, CADENCE, HRM, AERO, POWER).
-//    const amString &deviceID          IN   Device ID (number).
+//    unsigned int    deviceID          IN   Device ID (number).
 //    const amString &timeStampBuffer   IN   Time stamp.
 //    BYTE            payLoad[]         IN   Array of bytes with the data to be converted.
 //
@@ -90,7 +90,7 @@ bool antSpeedOnlyProcessing::appendSpeedSensor
 amDeviceType antSpeedOnlyProcessing::processSensor
 (
     int             deviceType,
-    const amString &deviceIDNo,
+    unsigned int    deviceIDNo,
     const amString &timeStampBuffer,
     BYTE            payLoad[]
 )
@@ -107,7 +107,7 @@ amDeviceType antSpeedOnlyProcessing::processSensor
         resetOutBuffer();
         if ( outputUnknown )
         {
-            int deviceIDNoAsInt = deviceIDNo.toInt();
+            int deviceIDNoAsInt = ( int ) deviceIDNo;
             createUnknownDeviceTypeString( deviceType, deviceIDNoAsInt, timeStampBuffer, payLoad );
         }
     }
@@ -208,26 +208,22 @@ void antSpeedOnlyProcessing::readDeviceFileLine
 //-------------------------------------------------------------------------------------------------//
 amDeviceType antSpeedOnlyProcessing::processBikeSpeedSensor
 (
-    const amString &deviceIDNo,
+    unsigned int    deviceIDNo,
     const amString &timeStampBuffer,
     BYTE            payLoad[]
 )
 {
-    char         auxBuffer[ C_MEDIUM_BUFFER_SIZE ] = { 0 };
-    unsigned int dataPage                          = 0;
-    unsigned int bikeSpeedEventTime                = 0;
-    unsigned int deltaBikeSpeedEventTime           = 0;
-    unsigned int wheelRevolutionCount              = 0;
-    unsigned int deltaWheelRevolutionCount         = 0;
-    unsigned int additionalData1                   = 0;
-    unsigned int additionalData2                   = 0;
-    unsigned int additionalData3                   = 0;
-    unsigned int rollOver                          = 0;
-    bool         rollOverHappened                  = false;
-    bool         commonPage                        = false;
-    bool         outputPageNo                      = true;
-    amDeviceType result                            = OTHER_DEVICE;
-    amString     sensorID                          = amString( C_SPEED_DEVICE_HEAD ) + deviceIDNo;
+    char            auxBuffer[ C_MEDIUM_BUFFER_SIZE ] = { 0 };
+    unsigned int    bikeSpeedEventTime                = 0;
+    unsigned int    wheelRevolutionCount              = 0;
+    unsigned int    operatingTime                     = 0;
+    unsigned int    rollOver                          = 0;
+    bool            rollOverHappened                  = false;
+    bool            commonPage                        = false;
+    bool            outputPageNo                      = true;
+    amDeviceType    result                            = OTHER_DEVICE;
+    antSensorHandle sensorID                          = sensorStates.intern( C_SPEED_DEVICE_HEAD, deviceIDNo );
+    antSpeedRecord  record                            = antSpeedRecord();
 
     if ( isRegisteredDevice( sensorID ) )
     {
@@ -235,21 +231,21 @@ amDeviceType antSpeedOnlyProcessing::processBikeSpeedSensor
              ( eventCountTable.count   ( sensorID ) == 0 ) ||
              ( operatingTimeTable.count( sensorID ) == 0 ) )
         {
-            eventTimeTable.insert    ( std::pair<amString, unsigned int>( sensorID, 0 ) );
-            eventCountTable.insert   ( std::pair<amString, unsigned int>( sensorID, 0 ) );
-            operatingTimeTable.insert( std::pair<amString, unsigned int>( sensorID, 0 ) );
+            eventTimeTable.insert    ( sensorID, 0 );
+            eventCountTable.insert   ( sensorID, 0 );
+            operatingTimeTable.insert( sensorID, 0 );
             setSpeed( sensorID, 0 );
         }
 
-        dataPage = byte2UInt( payLoad[ 0 ] );
+        record.dataPage = byte2UInt( payLoad[ 0 ] );
         if ( diagnostics )
         {
-            appendDiagnosticsLine( "Data Page", payLoad[ 0 ], dataPage );
+            appendDiagnosticsLine( "Data Page", payLoad[ 0 ], record.dataPage );
         }
 
-        bikeSpeedEventTime      = byte2UInt( payLoad[ 5 ], payLoad[ 4 ] );
-        rollOver                = 65536;  // 256^2
-        deltaBikeSpeedEventTime = getDeltaInt( rollOverHappened, sensorID, rollOver, eventTimeTable, bikeSpeedEventTime );
+        bikeSpeedEventTime    = byte2UInt( payLoad[ 5 ], payLoad[ 4 ] );
+        rollOver              = 65536;  // 256^2
+        record.deltaEventTime = getDeltaInt( rollOverHappened, sensorID, rollOver, eventTimeTable, bikeSpeedEventTime );
         if ( diagnostics )
         {
             appendDiagnosticsLine( "Bike Speed Event Time", payLoad[ 5 ], payLoad[ 4 ], bikeSpeedEventTime );
@@ -258,12 +254,12 @@ amDeviceType antSpeedOnlyProcessing::processBikeSpeedSensor
             {
                 sprintf( auxBuffer, " (Rollover [%d] occurred)", rollOver );
             }
-            appendDiagnosticsLine( "Delta Bike Speed Event Time", deltaBikeSpeedEventTime, auxBuffer );
+            appendDiagnosticsLine( "Delta Bike Speed Event Time", record.deltaEventTime, auxBuffer );
         }
 
-        wheelRevolutionCount      = byte2UInt( payLoad[ 7 ], payLoad[ 6 ] );
-        rollOver                  = 65536;  // 256^2
-        deltaWheelRevolutionCount = getDeltaInt( rollOverHappened, sensorID, rollOver, eventCountTable, wheelRevolutionCount );
+        wheelRevolutionCount        = byte2UInt( payLoad[ 7 ], payLoad[ 6 ] );
+        rollOver                    = 65536;  // 256^2
+        record.deltaRevolutionCount = getDeltaInt( rollOverHappened, sensorID, rollOver, eventCountTable, wheelRevolutionCount );
         if ( diagnostics )
         {
             appendDiagnosticsLine( "Cumulative Wheel Revolution Count", payLoad[ 7 ], payLoad[ 6 ], wheelRevolutionCount );
@@ -272,56 +268,56 @@ amDeviceType antSpeedOnlyProcessing::processBikeSpeedSensor
             {
                 sprintf( auxBuffer, " (Rollover [%d] occurred)", rollOver );
             }
-            appendDiagnosticsLine( "Delta Cumulative Wheel Revolution Count", deltaWheelRevolutionCount, auxBuffer );
+            appendDiagnosticsLine( "Delta Cumulative Wheel Revolution Count", record.deltaRevolutionCount, auxBuffer );
         }
 
-        switch ( dataPage & 0x0F )
+        switch ( record.dataPage & 0x0F )
         {
             case  0: // - - Page 0: No Additional Data - - - - - - - - - - - - - - -
                      result = SPEED_SENSOR;
                      break;
 
             case  1: // - - Page 1: Operating Time - - - - - - - - - - - - - - - - -
-                     result          = SPEED_SENSOR;
-                     additionalData2 = byte2UInt( payLoad[ 3 ], payLoad[ 2 ], payLoad[ 1 ] ); // Operating Time
-                     rollOver        = 16777216;  // 256^3
-                     additionalData1 = getDeltaInt( rollOverHappened, sensorID, rollOver, operatingTimeTable, additionalData2 );
-                                   // deltaOperatingTime
+                     result                 = SPEED_SENSOR;
+                     operatingTime          = byte2UInt( payLoad[ 3 ], payLoad[ 2 ], payLoad[ 1 ] );
+                     rollOver               = 16777216;  // 256^3
+                     record.additionalData1 = getDeltaInt( rollOverHappened, sensorID, rollOver, operatingTimeTable, operatingTime );
+                                              // deltaOperatingTime
                      if ( diagnostics )
                      {
-                         double cumOperatingTimeH = ( double ) additionalData2 / 3600.0;
+                         double cumOperatingTimeH = ( double ) operatingTime / 3600.0;
                          sprintf( auxBuffer, " (%2.2lfh)", cumOperatingTimeH );
-                         appendDiagnosticsLine( "Cumulative Operating Time", payLoad[ 3 ], payLoad[ 2 ], payLoad[ 1 ], additionalData2, auxBuffer );
+                         appendDiagnosticsLine( "Cumulative Operating Time", payLoad[ 3 ], payLoad[ 2 ], payLoad[ 1 ], operatingTime, auxBuffer );
                          *auxBuffer = 0;
                          if ( rollOverHappened )
                          {
                              sprintf( auxBuffer, " (Rollover [%d] occurred)", rollOver );
                          }
-                         appendDiagnosticsLine( "Delta Cumulative Operating Time", additionalData1, auxBuffer );
+                         appendDiagnosticsLine( "Delta Cumulative Operating Time", record.additionalData1, auxBuffer );
                      }
                      break;
 
             case  2: // - - Page 2: Manufacturer Information - - - - - - - - - - - -
-                     result          = SPEED_SENSOR;
-                     additionalData1 = byte2UInt( payLoad[ 1 ] );                // Manufacturer ID
-                     additionalData2 = byte2UInt( payLoad[ 3 ], payLoad[ 2 ] );  // Serial Number
+                     result                 = SPEED_SENSOR;
+                     record.additionalData1 = byte2UInt( payLoad[ 1 ] );                // Manufacturer ID
+                     record.additionalData2 = byte2UInt( payLoad[ 3 ], payLoad[ 2 ] );  // Serial Number
                      if ( diagnostics )
                      {
-                         appendDiagnosticsLine( "Manufacturer ID", payLoad[ 1 ], additionalData1 );
-                         appendDiagnosticsLine( "Serial Number", payLoad[ 3 ], payLoad[ 2 ], additionalData2 );
+                         appendDiagnosticsLine( "Manufacturer ID", payLoad[ 1 ], record.additionalData1 );
+                         appendDiagnosticsLine( "Serial Number", payLoad[ 3 ], payLoad[ 2 ], record.additionalData2 );
                      }
                      break;
 
             case  3: // - - Page 3: Product Information  - - - - - - - - - - - - - -
-                     result          = SPEED_SENSOR;
-                     additionalData1 = byte2UInt( payLoad[ 1 ] );   // H/W Version
-                     additionalData2 = byte2UInt( payLoad[ 2 ] );   // S/W Version
-                     additionalData3 = byte2UInt( payLoad[ 3 ] );   // Model Number
+                     result                 = SPEED_SENSOR;
+                     record.additionalData1 = byte2UInt( payLoad[ 1 ] );   // H/W Version
+                     record.additionalData2 = byte2UInt( payLoad[ 2 ] );   // S/W Version
+                     record.additionalData3 = byte2UInt( payLoad[ 3 ] );   // Model Number
                      if ( diagnostics )
                      {
-                         appendDiagnosticsLine( "Hardware Version", payLoad[ 1 ], additionalData1 );
-                         appendDiagnosticsLine( "Software Version", payLoad[ 2 ], additionalData2 );
-                         appendDiagnosticsLine( "Model Number", payLoad[ 3 ], additionalData3 );
+                         appendDiagnosticsLine( "Hardware Version", payLoad[ 1 ], record.additionalData1 );
+                         appendDiagnosticsLine( "Software Version", payLoad[ 2 ], record.additionalData2 );
+                         appendDiagnosticsLine( "Model Number", payLoad[ 3 ], record.additionalData3 );
                      }
                      break;
 
@@ -333,10 +329,9 @@ amDeviceType antSpeedOnlyProcessing::processBikeSpeedSensor
 
     if ( result == SPEED_SENSOR )
     {
-        createOutputHeader( sensorID, timeStampBuffer );
         if ( commonPage )
         {
-            commonPage = processCommonPages( sensorID, payLoad, outputPageNo );
+            commonPage = processCommonPages( sensorID, timeStampBuffer, getVersion(), payLoad, outputPageNo );
             if ( !commonPage )
             {
                 result = OTHER_DEVICE;
@@ -344,27 +339,8 @@ amDeviceType antSpeedOnlyProcessing::processBikeSpeedSensor
         }
         else
         {
-            unsigned int nbMagnets          = ( unsigned int) round( getNbMagnets( sensorID ) );
-            unsigned int zeroTime           = getZeroTimeCount( sensorID );
-            double       wheelCircumference = getWheelCircumference( sensorID );
-            double       speed              = getSpeed( sensorID );
-            createSPB7ResultString
-            (
-                speed,
-                dataPage,
-                deltaBikeSpeedEventTime,
-                deltaWheelRevolutionCount,
-                additionalData1,
-                additionalData2,
-                additionalData3,
-                wheelCircumference,
-                nbMagnets,
-                zeroTime
-            );
-            setZeroTimeCount( sensorID, zeroTime );
-            setSpeed( sensorID, speed );
+            outputSpeedRecord( sensorID, timeStampBuffer, getVersion(), record );
         }
-        appendOutputFooter( getVersion() );
     }
 
     if ( result == OTHER_DEVICE )
@@ -372,7 +348,7 @@ amDeviceType antSpeedOnlyProcessing::processBikeSpeedSensor
         resetOutBuffer();
         if ( outputUnknown )
         {
-            int deviceIDNoAsInt = deviceIDNo.toInt();
+            int deviceIDNoAsInt = ( int ) deviceIDNo;
             createUnknownDeviceTypeString( C_SPEED_TYPE, deviceIDNoAsInt, timeStampBuffer, payLoad );
         }
     }
@@ -382,15 +358,16 @@ amDeviceType antSpeedOnlyProcessing::processBikeSpeedSensor
 
 unsigned int antSpeedOnlyProcessing::splitFormat137_SPB7
 (
-    const amString &inputBuffer,
     amSplitString &outWords
 )
 {
     unsigned int nbWords = 0;
-    if ( !inputBuffer.empty() )
+    if ( outWords.size() > 0 )
     {
         amSplitString inWords;
-        nbWords = inWords.split( inputBuffer );
+        // The words of the line become the input, the result replaces them.
+        inWords.swap( outWords );
+        nbWords = inWords.size();
 
         // Convert Version 1.37:
         //     <sensor_id>  <time_stamp>    <S>   <dataPage>                   <deltaBikeSpeedEventTime>     <deltaWheelRevolutionCount>   ...
@@ -416,7 +393,7 @@ unsigned int antSpeedOnlyProcessing::splitFormat137_SPB7
             outWords.push_back( deltaEventTime );
             outWords.push_back( deltaRevolutionCount );
 
-            if ( ( ( dataPage == "2" ) || ( dataPage == "3" ) ) && ( nbWords > 6 ) && ( inWords[ counter ].find_first_of( "=" ) != amString::npos ) )
+            if ( ( ( dataPage == "2" ) || ( dataPage == "3" ) ) && ( nbWords > 6 ) && ( inWords[ counter ].contains( '=' ) ) )
             {
                 amSplitString additionalWords;
                 additionalWords.removeAllSeparators();
@@ -458,31 +435,23 @@ amDeviceType antSpeedOnlyProcessing::processBikeSpeedSensorSemiCooked
     const amString &inputBuffer
 )
 {
-    amDeviceType  result = OTHER_DEVICE;
-    amString      curVersion                = getVersion();
-    amString      semiCookedString;
-    amString      sensorID;
-    amString      timeStampBuffer;
-    amSplitString words;
-    unsigned int  nbWords                   = 0;
-    unsigned int  counter                   = 0;
-    unsigned int  startCounter              = 0;
-    unsigned int  dataPage                  = 0;
-    unsigned int  deltaBikeSpeedEventTime   = 0;
-    unsigned int  deltaWheelRevolutionCount = 0;
-    unsigned int  additionalData1           = 0;
-    unsigned int  additionalData2           = 0;
-    unsigned int  additionalData3           = 0;
-    bool          commonPage                = false;
-    bool          outputPageNo              = true;
-
-    if ( isSemiCookedFormat137( inputBuffer ) )
-    {
-        nbWords = splitFormat137_SPB7( inputBuffer, words );
-    }
-    else
+    amDeviceType   result       = OTHER_DEVICE;
+    amString       curVersion   = getVersion();
+    amString       semiCookedString;
+    amString       sensorID;
+    amString       timeStampBuffer;
+    amSplitString  words;
+    unsigned int   nbWords      = 0;
+    unsigned int   counter      = 0;
+    unsigned int   startCounter = 0;
+    antSpeedRecord record       = antSpeedRecord();
+    bool           commonPage   = false;
+    bool           outputPageNo = true;
+
+    nbWords = words.split( inputBuffer );
+    if ( isSemiCookedFormat137( words ) )
     {
-        nbWords = words.split( inputBuffer );
+        nbWords = splitFormat137_SPB7( words );
     }
 
     if ( nbWords > 5 )
@@ -499,24 +468,24 @@ amDeviceType antSpeedOnlyProcessing::processBikeSpeedSensorSemiCooked
         }
         if ( isRegisteredDevice( sensorID ) && ( semiCookedString == C_SEMI_COOKED_SYMBOL_AS_STRING ) && isSpeedOnlySensor( sensorID ) )
         {
-            startCounter = counter;
-            dataPage     = words[ counter++ ].toUInt();                   // 3
+            startCounter    = counter;
+            record.dataPage = words[ counter++ ].toUInt();                // 3
             if ( words[ counter ] == C_UNSUPPORTED_DATA_PAGE )
             {
                 result = UNKNOWN_DEVICE;
             }
             else
             {
-                deltaBikeSpeedEventTime   = words[ counter++ ].toUInt();  // 4
-                deltaWheelRevolutionCount = words[ counter++ ].toUInt();  // 5
+                record.deltaEventTime       = words[ counter++ ].toUInt();  // 4
+                record.deltaRevolutionCount = words[ counter++ ].toUInt();  // 5
                 if ( diagnostics )
                 {
-                    appendDiagnosticsLine( "Data Page", dataPage );
-                    appendDiagnosticsLine( "Delta Bike Speed Event Time", deltaBikeSpeedEventTime );
-                    appendDiagnosticsLine( "Delta Cumulative Wheel Count", deltaWheelRevolutionCount );
+                    appendDiagnosticsLine( "Data Page", record.dataPage );
+                    appendDiagnosticsLine( "Delta Bike Speed Event Time", record.deltaEventTime );
+                    appendDiagnosticsLine( "Delta Cumulative Wheel Count", record.deltaRevolutionCount );
                 }
 
-                int dataPageMod128 = dataPage & 0x0F;
+                int dataPageMod128 = record.dataPage & 0x0F;
                 switch ( dataPageMod128 )
                 {
                     case  0: // - - Page 0: No Additional Data - - - - - - - - - - - - - - -
@@ -526,11 +495,11 @@ amDeviceType antSpeedOnlyProcessing::processBikeSpeedSensorSemiCooked
                     case  1: // - - Page 1: Operating Time - - - - - - - - - - - - - - - - -
                              if ( nbWords > 6 )
                              {
-                                 result          = SPEED_SENSOR;
-                                 additionalData1 = words[ counter++ ].toUInt();   // 6 -deltaOperatingTime
+                                 result                 = SPEED_SENSOR;
+                                 record.additionalData1 = words[ counter++ ].toUInt();   // 6 -deltaOperatingTime
                                  if ( diagnostics )
                                  {
-                                     appendDiagnosticsLine( "Delta Cumulative Operating Time", additionalData1 );
+                                     appendDiagnosticsLine( "Delta Cumulative Operating Time", record.additionalData1 );
                                  }
                              }
                              break;
@@ -538,13 +507,13 @@ amDeviceType antSpeedOnlyProcessing::processBikeSpeedSensorSemiCooked
                     case  2: // - - Page 2: Manufacturer Information - - - - - - - - - - - -
                              if ( nbWords > 7 )
                              {
-                                 result          = SPEED_SENSOR;
-                                 additionalData1 = words[ counter++ ].toUInt();   // 7 - manufacturerID
-                                 additionalData2 = words[ counter++ ].toUInt();   // 8 - serialNumber
+                                 result                 = SPEED_SENSOR;
+                                 record.additionalData1 = words[ counter++ ].toUInt();   // 7 - manufacturerID
+                                 record.additionalData2 = words[ counter++ ].toUInt();   // 8 - serialNumber
                                  if ( diagnostics )
                                  {
-                                     appendDiagnosticsLine( "Manufacturer ID", additionalData1 );
-                                     appendDiagnosticsLine( "Serial Number", additionalData2 );
+                                     appendDiagnosticsLine( "Manufacturer ID", record.additionalData1 );
+                                     appendDiagnosticsLine( "Serial Number", record.additionalData2 );
                                  }
                              }
                              break;
@@ -552,15 +521,15 @@ amDeviceType antSpeedOnlyProcessing::processBikeSpeedSensorSemiCooked
                     case  3: // - - Page 3: Product Information  - - - - - - - - - - - - - -
                              if ( nbWords > 8 )
                              {
-                                 result          = SPEED_SENSOR;
-                                 additionalData1 = words[ counter++ ].toUInt();   //  9 - hwVersion
-                                 additionalData2 = words[ counter++ ].toUInt();   // 10 - swVersion
-                                 additionalData3 = words[ counter++ ].toUInt();   // 11 - modelNumber
+                                 result                 = SPEED_SENSOR;
+                                 record.additionalData1 = words[ counter++ ].toUInt();   //  9 - hwVersion
+                                 record.additionalData2 = words[ counter++ ].toUInt();   // 10 - swVersion
+                                 record.additionalData3 = words[ counter++ ].toUInt();   // 11 - modelNumber
                                  if ( diagnostics )
                                  {
-                                     appendDiagnosticsLine( "Model Number", additionalData1 );
-                                     appendDiagnosticsLine( "Software Version", additionalData2 );
-                                     appendDiagnosticsLine( "Hardware Version", additionalData3 );
+                                     appendDiagnosticsLine( "Model Number", record.additionalData1 );
+                                     appendDiagnosticsLine( "Software Version", record.additionalData2 );
+                                     appendDiagnosticsLine( "Hardware Version", record.additionalData3 );
                                  }
                              }
                              break;
@@ -583,10 +552,9 @@ amDeviceType antSpeedOnlyProcessing::processBikeSpeedSensorSemiCooked
                     appendDiagnosticsLine( "Version", curVersion );
                 }
             }
-            createOutputHeader( sensorID, timeStampBuffer );
             if ( commonPage )
             {
-                commonPage = processCommonPagesSemiCooked( words, startCounter, outputPageNo );
+                commonPage = processCommonPagesSemiCooked( words, startCounter, curVersion, outputPageNo );
                 if ( !commonPage )
                 {
                     result = OTHER_DEVICE;
@@ -594,27 +562,8 @@ amDeviceType antSpeedOnlyProcessing::processBikeSpeedSensorSemiCooked
             }
             else
             {
-                unsigned int nbMagnets          = ( unsigned int) round( getNbMagnets( sensorID ) );
-                unsigned int zeroTime           = getZeroTimeCount( sensorID );
-                double       wheelCircumference = getWheelCircumference( sensorID );
-                double       speed              = getSpeed( sensorID );
-                createSPB7ResultString
-                (
-                    speed,
-                    dataPage,
-                    deltaBikeSpeedEventTime,
-                    deltaWheelRevolutionCount,
-                    additionalData1,
-                    additionalData2,
-                    additionalData3,
-                    wheelCircumference,
-                    nbMagnets,
-                    zeroTime
-                );
-                setZeroTimeCount( sensorID, zeroTime );
-                setSpeed( sensorID, speed );
+                outputSpeedRecord( sensorID, timeStampBuffer, curVersion, record );
             }
-            appendOutputFooter( curVersion );
         }
     }
 
@@ -635,121 +584,35 @@ amDeviceType antSpeedOnlyProcessing::processBikeSpeedSensorSemiCooked
     return result;
 }
 
-void antSpeedOnlyProcessing::createSPB7ResultString
+void antSpeedOnlyProcessing::outputSpeedRecord
 (
-    double       &speed,
-    unsigned int  dataPage,
-    unsigned int  deltaBikeSpeedEventTime,
-    unsigned int  deltaWheelRevolutionCount,
-    unsigned int  additionalData1,
-    unsigned int  additionalData2,
-    unsigned int  additionalData3,
-    double        wheelCircumference,
-    unsigned int  numberOfMagnets,
-    unsigned int &zeroTime
+    const antSensorHandle &sensorID,
+    const amString        &timeStampBuffer,
+    const amString        &versionString,
+    antSpeedRecord        &record
 )
 {
+    unsigned int zeroTime = getZeroTimeCount( sensorID );
+
+    record.numberOfMagnets    = ( unsigned int) round( getNbMagnets( sensorID ) );
+    record.wheelCircumference = getWheelCircumference( sensorID );
+    record.speed              = getSpeed( sensorID );
     if ( !semiCookedOut )
     {
-        speed = computeSpeed
-                (
-                    speed,
-                    deltaWheelRevolutionCount,
-                    deltaBikeSpeedEventTime,
-                    wheelCircumference,
-                    numberOfMagnets,
-                    zeroTime,
-                    maxZeroTime
-                );
+        record.speed = computeSpeed
+                       (
+                           record.speed,
+                           record.deltaRevolutionCount,
+                           record.deltaEventTime,
+                           record.wheelCircumference,
+                           record.numberOfMagnets,
+                           zeroTime,
+                           maxZeroTime
+                       );
     }
 
-    if ( outputAsJSON )
-    {
-        if ( semiCookedOut )
-        {
-            appendJSONItem( "delta bike speed event time",  deltaBikeSpeedEventTime );
-            appendJSONItem( "delta wheel revolution count", deltaWheelRevolutionCount );
-        }
-        else
-        {
-            appendJSONItem( C_SPEED_JSON,          speed,              getValuePrecision() );
-            appendJSONItem( "wheel circumference", wheelCircumference, getValuePrecision() );
-            appendJSONItem( "number of magnets",   numberOfMagnets );
-        }
-        appendJSONItem( C_DATA_PAGE_JSON, dataPage );
-        if ( ( dataPage & 0x0F ) == 1 )
-        {
-            if ( semiCookedOut )
-            {
-                appendJSONItem( "delta operating time", additionalData1 );
-            }
-            else
-            {
-                appendJSONItem( "operating time", 2 * additionalData1 );
-            }
-        }
-        else if ( ( dataPage & 0x0F ) == 2 )
-        {
-            appendJSONItem( C_MANUFACTURER_JSON,  additionalData1 );
-            appendJSONItem( C_SERIAL_NUMBER_JSON, additionalData2 );
-        }
-        else if ( ( dataPage & 0x0F ) == 3 )
-        {
-            appendJSONItem( C_MANUFACTURER_JSON,      additionalData1 );
-            appendJSONItem( C_HARDWARE_REVISION_JSON, additionalData2 );
-            appendJSONItem( C_MODEL_NUMBER_JSON,      additionalData3 );
-        }
-        else
-        {
-            appendJSONItem( "additional data 1", additionalData1 );
-            appendJSONItem( "additional data 1", additionalData2 );
-            appendJSONItem( "additional data 3", additionalData3 );
-        }
-    }
-    else
-    {
-        if ( semiCookedOut )
-        {
-            appendOutput( ( unsigned int ) dataPage );
-            appendOutput( deltaBikeSpeedEventTime );
-            appendOutput( deltaWheelRevolutionCount );
-            if ( ( dataPage & 0x0F ) != 0 )
-            {
-                appendOutput( additionalData1 );             // deltaOperatingTime (1) / manufacturerID (2) / hwVersion (3)
-                if ( ( dataPage & 0x0F ) != 1 )
-                {
-                    appendOutput( additionalData2 );         // serialNumber (2) / swVersion (3)
-                    if ( ( dataPage & 0x0F ) != 2 )
-                    {
-                        appendOutput( additionalData3 );     // modelNumber (3)
-                    }
-                }
-            }
-        }
-        else
-        {
-            appendOutput( speed,              getValuePrecision() );
-            appendOutput( wheelCircumference, getValuePrecision() );
-            appendOutput( numberOfMagnets );
-            appendOutput( dataPage );
-            if ( ( dataPage & 0x0F ) != 0 )
-            {
-                if ( ( dataPage & 0x0F ) == 1 )
-                {
-                    //                          operatingTimeSeconds
-                    appendOutput( 2 * additionalData1 );
-                }
-                else
-                {
-                    appendOutput( additionalData1 );                             // manufacturerID (2) / hwVersion (3)
-                    appendOutput( additionalData2 );                             // serialNumber (2)   / swVersion (3)
-                    if ( ( dataPage & 0x0F ) != 2 )
-                    {
-                        appendOutput( additionalData3 );                         // modelNumber (3)
-                    }
-                }
-            }
-        }
-    }
-}
+    outputRecord( antRecordContext( sensorID, timeStampBuffer, versionString ), record );
 
+    setZeroTimeCount( sensorID, zeroTime );
+    setSpeed( sensorID, record.speed );
+}
@@ -11,28 +11,16 @@ class antSpeedOnlyProcessing : virtual public antProcessing,
 
     private:
 
-        unsigned int splitFormat137_SPB7( const amString &inputBuffer, amSplitString &outWords );
+        unsigned int splitFormat137_SPB7( amSplitString &outWords );
         void replaceObsoleteHeader( amString &sensorID );
 
 
     protected:
 
-        amDeviceType processBikeSpeedSensor( const amString &deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
+        amDeviceType processBikeSpeedSensor( unsigned int deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
         amDeviceType processBikeSpeedSensorSemiCooked( const amString &inputBuffer );
 
-        void createSPB7ResultString
-             (
-                 double       &speed,
-                 unsigned int  dataPage,
-                 unsigned int  deltaWheelRevolutionCount,
-                 unsigned int  deltaBikeSpeedEventTime,
-                 unsigned int  additionalData1,
-                 unsigned int  additionalData2,
-                 unsigned int  additionalData3,
-                 double        wheelCircumference,
-                 unsigned int  numberOfMagnets,
-                 unsigned int &zeroTime
-             );
+        void outputSpeedRecord( const antSensorHandle &sensorID, const amString &timeStampBuffer, const amString &versionString, antSpeedRecord &record );
 
         bool appendSpeedSensor( const amString &sensorID, double wheelCircumference, double nbMagnets );
 
@@ -46,10 +34,11 @@ class antSpeedOnlyProcessing : virtual public antProcessing,
 
         bool isSpeedOnlySensor( const amString &sensorID );
 
-        virtual amDeviceType processSensor( int deviceType, const amString &deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
+        virtual amDeviceType processSensor( int deviceType, unsigned int deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
         virtual amDeviceType processSensorSemiCooked( const amString &inputBuffer );
 
         virtual void reset( void );
+        virtual antProcessing *createWorker( void ) const { return new antSpeedOnlyProcessing; }
 
 };
 
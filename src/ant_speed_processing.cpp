@@ -18,7 +18,10 @@
 antSpeedProcessing::antSpeedProcessing
 (
     void
-)
+) : nbMagnetsTable( sensorStates, &antSensorState::nbMagnets, SS_NB_MAGNETS ),
+    wheelCircumferenceTable( sensorStates, &antSensorState::wheelCircumference, SS_WHEEL_CIRCUMFERENCE ),
+    speedTable( sensorStates, &antSensorState::speed, SS_SPEED ),
+    usedAsSpeedSensorTable( sensorStates, &antSensorState::usedAsSpeedSensor, SS_USED_AS_SPEED_SENSOR )
 {
     nbMagnetsDefault          = C_NB_MAGNETS_DEFAULT;
     wheelCircumferenceDefault = C_WHEEL_CIRCUMFERENCE_DEFAULT;
@@ -27,7 +30,7 @@ antSpeedProcessing::antSpeedProcessing
 
 double antSpeedProcessing::getNbMagnets
 (
-    const amString &sensorID
+    const antSensorHandle &sensorID
 )
 {
     double nbMagnets = ( nbMagnetsTable.count( sensorID ) == 0 ) ? nbMagnetsDefault : nbMagnetsTable[ sensorID ];
@@ -36,13 +39,13 @@ double antSpeedProcessing::getNbMagnets
 
 void antSpeedProcessing::setNbMagnets
 (
-    const amString &sensorID,
-    double          value
+    const antSensorHandle &sensorID,
+    double                 value
 )
 {
     if ( nbMagnetsTable.count( sensorID ) == 0 )
     {
-        nbMagnetsTable.insert( std::pair<amString, double>( sensorID, nbMagnetsDefault ) );
+        nbMagnetsTable.insert( sensorID, nbMagnetsDefault );
     }
     nbMagnetsTable[ sensorID ] = value;
 }
@@ -83,7 +86,7 @@ bool antSpeedProcessing::isSpeedSensor
 
 double antSpeedProcessing::getWheelCircumference
 (
-    const amString &sensorID
+    const antSensorHandle &sensorID
 )
 {
     double wheelCircumference = ( wheelCircumferenceTable.count( sensorID ) == 0 ) ? wheelCircumferenceDefault : wheelCircumferenceTable[ sensorID ];
@@ -92,40 +95,32 @@ double antSpeedProcessing::getWheelCircumference
 
 void antSpeedProcessing::setWheelCircumference
 (
-    const amString &sensorID,
-    double          value
+    const antSensorHandle &sensorID,
+    double                 value
 )
 {
     if ( wheelCircumferenceTable.count( sensorID ) == 0 )
     {
-        wheelCircumferenceTable.insert( std::pair<amString, double>( sensorID, wheelCircumferenceDefault ) );
+        wheelCircumferenceTable.insert( sensorID, wheelCircumferenceDefault );
     }
     wheelCircumferenceTable[ sensorID ] = value;
 }
 
 double antSpeedProcessing::getSpeed
 (
-    const amString &sensorID
+    const antSensorHandle &sensorID
 )
 {
-    if ( speedTable.count( sensorID ) == 0 )
-    {
-        speedTable.insert( std::pair<amString, double>( sensorID, 0 ) );
-    }
     double speed = speedTable[ sensorID ];
     return speed;
 }
 
 void antSpeedProcessing::setSpeed
 (
-    const amString &sensorID,
-    double          value
+    const antSensorHandle &sensorID,
+    double                 value
 )
 {
-    if ( speedTable.count( sensorID ) == 0 )
-    {
-        speedTable.insert( std::pair<amString, double>( sensorID, 0 ) );
-    }
     speedTable[ sensorID ] = value;
 }
 
@@ -142,11 +137,11 @@ bool antSpeedProcessing::appendSpeedSensor
     {
         if ( wheelCircumferenceTable.count( sensorID ) == 0 )
         {
-            wheelCircumferenceTable.insert( std::pair<amString, double>( sensorID, wheelCircumference ) );
+            wheelCircumferenceTable.insert( sensorID, wheelCircumference );
         }
         if ( nbMagnetsTable.count( sensorID ) == 0 )
         {
-            nbMagnetsTable.insert         ( std::pair<amString, double>( sensorID, nbMagnets ) );
+            nbMagnetsTable.insert         ( sensorID, nbMagnets );
         }
         setUseAsSpeedSensor( sensorID, true );
     }
@@ -169,26 +164,26 @@ void antSpeedProcessing::reset
 
 void antSpeedProcessing::setUseAsSpeedSensor
 (
-    const amString &sensorID,
-    bool            value
+    const antSensorHandle &sensorID,
+    bool                   value
 )
 {
     if ( usedAsSpeedSensorTable.count( sensorID ) == 0 )
     {
-        usedAsSpeedSensorTable.insert( std::pair<amString, double>( sensorID, value ) );
+        usedAsSpeedSensorTable.insert( sensorID, value );
     }
     usedAsSpeedSensorTable[ sensorID ] = value;
 }
 
 bool antSpeedProcessing::isUsedAsSpeedSensor
 (
-    const amString &sensorID
+    const antSensorHandle &sensorID
 )
 {
     bool result = false;
     if ( usedAsSpeedSensorTable.count( sensorID ) == 0 )
     {
-        usedAsSpeedSensorTable.insert( std::pair<amString, double>( sensorID, result ) );
+        usedAsSpeedSensorTable.insert( sensorID, result );
     }
     result = usedAsSpeedSensorTable[ sensorID ];
     return result;
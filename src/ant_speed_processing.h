@@ -1,13 +1,13 @@
 #ifndef __ANT_SPEED_PROCESSING_H__
 #define __ANT_SPEED_PROCESSING_H__
 
-#include <map>
+#include "ant_sensor_state.h"
 #include "ant_constants.h"
 
 class amString;
 class amSplitString;
 
-class antSpeedProcessing
+class antSpeedProcessing : virtual public antSensorStateStore
 {
 
     private:
@@ -15,10 +15,10 @@ class antSpeedProcessing
         void resetNbMagnetsDefault         ( void ) { nbMagnetsDefault          = C_NB_MAGNETS_DEFAULT; }
         void resetWheelCircumferenceDefault( void ) { wheelCircumferenceDefault = C_WHEEL_CIRCUMFERENCE_DEFAULT; }
 
-        std::map<amString, double> nbMagnetsTable;
-        std::map<amString, double> wheelCircumferenceTable;
-        std::map<amString, double> speedTable;
-        std::map<amString, bool>   usedAsSpeedSensorTable;
+        antSensorField<double> nbMagnetsTable;
+        antSensorField<double> wheelCircumferenceTable;
+        antSensorField<double> speedTable;
+        antSensorField<bool>   usedAsSpeedSensorTable;
 
 
     protected:
@@ -28,12 +28,12 @@ class antSpeedProcessing
 
         unsigned int maxZeroTime;
 
-        double getSpeed             ( const amString &sensorID );
-        double getWheelCircumference( const amString &sensorID );
-        double getNbMagnets         ( const amString &sensorID );
-        void setSpeed             ( const amString &sensorID, double value );
-        void setWheelCircumference( const amString &sensorID, double value );
-        void setNbMagnets         ( const amString &sensorID, double value );
+        double getSpeed             ( const antSensorHandle &sensorID );
+        double getWheelCircumference( const antSensorHandle &sensorID );
+        double getNbMagnets         ( const antSensorHandle &sensorID );
+        void setSpeed             ( const antSensorHandle &sensorID, double value );
+        void setWheelCircumference( const antSensorHandle &sensorID, double value );
+        void setNbMagnets         ( const antSensorHandle &sensorID, double value );
 
         bool isPureSpeedSensor( const amString &sensorID );
         bool isMakeshiftSpeedSensor( const amString &sensorID );
@@ -58,8 +58,8 @@ class antSpeedProcessing
 
         virtual void reset( void );
 
-        void setUseAsSpeedSensor( const amString &sensorID, bool value );
-        bool isUsedAsSpeedSensor( const amString &sensorID );
+        void setUseAsSpeedSensor( const antSensorHandle &sensorID, bool value );
+        bool isUsedAsSpeedSensor( const antSensorHandle &sensorID );
 
     public:
 
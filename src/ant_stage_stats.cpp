@@ -0,0 +1,465 @@
+#include <cstring>
+#include <iostream>
+#include <unistd.h>
+
+#include "ant_stage_stats.h"
+
+const int    C_STATS_POLL_MS      = 200;
+const char  *C_STAGE_NAMES[]      = { "read", "frame", "decode", "format", "output", "packet" };
+const char  *C_COUNTER_NAMES[]    = { "unknownDeviceTypes", "unknownPages", "unregisteredDrops", "rollOvers" };
+const double C_STATS_PERCENTILES[] = { 0.5, 0.9, 0.99, 0.999 };
+const char  *C_PERCENTILE_NAMES[]  = { "p50Ns", "p90Ns", "p99Ns", "p999Ns" };
+const size_t C_NB_STATS_PERCENTILES = sizeof( C_STATS_PERCENTILES ) / sizeof( C_STATS_PERCENTILES[ 0 ] );
+
+volatile sig_atomic_t antStageStatsDump::userSignalReceived = 0;
+
+antStageStats::antStageStats
+(
+    void
+)
+{
+    memset( stages, 0, sizeof( stages ) );
+    memset( counters, 0, sizeof( counters ) );
+    memset( pageCounts, 0, sizeof( pageCounts ) );
+    packetStart = 0;
+    stageStart  = 0;
+    stagesTime  = 0;
+}
+
+antStageStats::~antStageStats
+(
+    void
+)
+{
+    for ( int deviceType = 0; deviceType < C_NB_DEVICE_TYPES; ++deviceType )
+    {
+        delete [] pageCounts[ deviceType ];
+    }
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Histogram bucket of 'value': values below C_STATS_SUB_BUCKETS have a bucket each, above the
+// highest C_STATS_SUB_BUCKET_BITS + 1 bits of the value select the bucket.
+//
+// -------------------------------------------------------------------------------------------------//
+unsigned int antStageStats::getBucket
+(
+    unsigned long long value
+)
+{
+    unsigned int bucket = ( unsigned int ) value;
+
+    if ( value >= C_STATS_SUB_BUCKETS )
+    {
+        unsigned int shift = 63 - __builtin_clzll( value ) - C_STATS_SUB_BUCKET_BITS;
+        bucket = ( shift + 1 ) * C_STATS_SUB_BUCKETS + ( unsigned int ) ( ( value >> shift ) & ( C_STATS_SUB_BUCKETS - 1 ) );
+    }
+    return bucket;
+}
+
+unsigned long long antStageStats::getBucketStart
+(
+    unsigned int bucket
+)
+{
+    unsigned long long start = bucket;
+
+    if ( bucket >= C_STATS_SUB_BUCKETS )
+    {
+        start = ( unsigned long long ) ( C_STATS_SUB_BUCKETS + bucket % C_STATS_SUB_BUCKETS ) << ( bucket / C_STATS_SUB_BUCKETS - 1 );
+    }
+    return start;
+}
+
+void antStageStats::addTime
+(
+    int       stage,
+    long long nanoseconds
+)
+{
+    histogram          &histo = stages[ stage ];
+    unsigned long long  value = ( nanoseconds > 0 ) ? ( unsigned long long ) nanoseconds : 0;
+
+    add( histo.count, 1 );
+    add( histo.total, value );
+    add( histo.buckets[ getBucket( value ) ], 1 );
+    if ( value > histo.maximum )
+    {
+        __atomic_store_n( &( histo.maximum ), value, __ATOMIC_RELAXED );
+    }
+}
+
+unsigned long long *antStageStats::addPageCounts
+(
+    int deviceType
+)
+{
+    unsigned long long *row = new unsigned long long[ C_STATS_NB_PAGES ];
+
+    memset( row, 0, C_STATS_NB_PAGES * sizeof( unsigned long long ) );
+    __atomic_store_n( &( pageCounts[ deviceType ] ), row, __ATOMIC_RELEASE );
+    return row;
+}
+
+void antStageStats::countPacket
+(
+    int  deviceType,
+    BYTE firstPayloadByte
+)
+{
+    unsigned int        page = firstPayloadByte;
+    unsigned long long *row  = NULL;
+
+    deviceType &= C_NB_DEVICE_TYPES - 1;
+    if ( ( deviceType == C_HRM_TYPE ) || ( deviceType == C_SPEED_TYPE ) || ( deviceType == C_CAD_TYPE ) )
+    {
+        page &= 0x7F;
+    }
+    else if ( deviceType == C_SPCAD_TYPE )
+    {
+        page = 0;
+    }
+
+    row = pageCounts[ deviceType ];
+    if ( row == NULL )
+    {
+        row = addPageCounts( deviceType );
+    }
+    add( row[ page ], 1 );
+}
+
+void antStageStats::addCounts
+(
+    const antStageStats &part
+)
+{
+    unsigned long long  value   = 0;
+    unsigned long long *partRow = NULL;
+
+    for ( int stage = 0; stage < NB_STAGES; ++stage )
+    {
+        histogram       &histo     = stages[ stage ];
+        const histogram &partHisto = part.stages[ stage ];
+
+        histo.count += load( partHisto.count );
+        histo.total += load( partHisto.total );
+        value        = load( partHisto.maximum );
+        if ( value > histo.maximum )
+        {
+            histo.maximum = value;
+        }
+        for ( unsigned int bucket = 0; bucket < C_STATS_NB_BUCKETS; ++bucket )
+        {
+            histo.buckets[ bucket ] += load( partHisto.buckets[ bucket ] );
+        }
+    }
+
+    for ( int counter = 0; counter < NB_STATS_COUNTERS; ++counter )
+    {
+        counters[ counter ] += load( part.counters[ counter ] );
+    }
+
+    for ( int deviceType = 0; deviceType < C_NB_DEVICE_TYPES; ++deviceType )
+    {
+        partRow = __atomic_load_n( &( part.pageCounts[ deviceType ] ), __ATOMIC_ACQUIRE );
+        if ( partRow != NULL )
+        {
+            if ( pageCounts[ deviceType ] == NULL )
+            {
+                addPageCounts( deviceType );
+            }
+            for ( unsigned int page = 0; page < C_STATS_NB_PAGES; ++page )
+            {
+                pageCounts[ deviceType ][ page ] += load( partRow[ page ] );
+            }
+        }
+    }
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Write a histogram as a JSON object. A percentile is given as the end of its bucket (at most the
+// maximum), the buckets as [ <start>, <count> ] pairs, empty ones left out.
+//
+// -------------------------------------------------------------------------------------------------//
+void antStageStats::writeHistogram
+(
+    std::ostream    &outStream,
+    const histogram &stage
+) const
+{
+    unsigned long long sum     = 0;
+    unsigned long long needed  = 0;
+    unsigned long long value   = 0;
+    unsigned int       bucket  = 0;
+    bool               isFirst = true;
+
+    outStream << "{\"count\":" << stage.count << ",\"totalNs\":" << stage.total << ",\"maxNs\":" << stage.maximum;
+    for ( size_t percentile = 0; percentile < C_NB_STATS_PERCENTILES; ++percentile )
+    {
+        needed = ( unsigned long long ) ( C_STATS_PERCENTILES[ percentile ] * stage.count + 0.999999 );
+        for ( sum = 0, bucket = 0; ( bucket < C_STATS_NB_BUCKETS - 1 ) && ( sum + stage.buckets[ bucket ] < needed ); ++bucket )
+        {
+            sum += stage.buckets[ bucket ];
+        }
+        value = ( stage.count == 0 ) ? 0 : getBucketStart( bucket + 1 ) - 1;
+        if ( value > stage.maximum )
+        {
+            value = stage.maximum;
+        }
+        outStream << ",\"" << C_PERCENTILE_NAMES[ percentile ] << "\":" << value;
+    }
+    outStream << ",\"buckets\":[";
+    for ( bucket = 0; bucket < C_STATS_NB_BUCKETS; ++bucket )
+    {
+        if ( stage.buckets[ bucket ] > 0 )
+        {
+            outStream << ( isFirst ? "[" : ",[" ) << getBucketStart( bucket ) << "," << stage.buckets[ bucket ] << "]";
+            isFirst = false;
+        }
+    }
+    outStream << "]}";
+}
+
+void antStageStats::write
+(
+    std::ostream &outStream,
+    const char   *reason,
+    unsigned int  dumpNo,
+    double        unixTime,
+    double        upTime
+) const
+{
+    unsigned long long nbPackets = 0;
+    bool               isFirst   = true;
+
+    outStream.setf( std::ios::fixed );
+    outStream.precision( 6 );
+    outStream << "{\"reason\":\"" << reason << "\",\"dump\":" << dumpNo << ",\"time\":" << unixTime << ",\"upTime\":" << upTime;
+    outStream << ",\"packets\":" << stages[ STAGE_PACKET ].count;
+    for ( int counter = 0; counter < NB_STATS_COUNTERS; ++counter )
+    {
+        outStream << ",\"" << C_COUNTER_NAMES[ counter ] << "\":" << counters[ counter ];
+    }
+
+    outStream << ",\"stages\":{";
+    for ( int stage = 0; stage < NB_STAGES; ++stage )
+    {
+        outStream << ( ( stage == 0 ) ? "\"" : ",\"" ) << C_STAGE_NAMES[ stage ] << "\":";
+        writeHistogram( outStream, stages[ stage ] );
+    }
+
+    outStream << "},\"deviceTypes\":{";
+    for ( int deviceType = 0; deviceType < C_NB_DEVICE_TYPES; ++deviceType )
+    {
+        if ( pageCounts[ deviceType ] != NULL )
+        {
+            nbPackets = 0;
+            for ( unsigned int page = 0; page < C_STATS_NB_PAGES; ++page )
+            {
+                nbPackets += pageCounts[ deviceType ][ page ];
+            }
+            outStream << ( isFirst ? "\"" : ",\"" ) << deviceType << "\":{\"packets\":" << nbPackets << ",\"pages\":{";
+            isFirst = true;
+            for ( unsigned int page = 0; page < C_STATS_NB_PAGES; ++page )
+            {
+                if ( pageCounts[ deviceType ][ page ] > 0 )
+                {
+                    outStream << ( isFirst ? "\"" : ",\"" ) << page << "\":" << pageCounts[ deviceType ][ page ];
+                    isFirst = false;
+                }
+            }
+            outStream << "}}";
+            isFirst = false;
+        }
+    }
+    outStream << "}}" << std::endl;
+}
+
+antStageStatsDump::antStageStatsDump
+(
+    void
+)
+{
+    threadRunning   = false;
+    stopping        = 0;
+    intervalSeconds = 0;
+    nbDumps         = 0;
+    startTime       = 0;
+    pthread_mutex_init( &mutex, NULL );
+}
+
+antStageStatsDump::~antStageStatsDump
+(
+    void
+)
+{
+    amString message;
+
+    stop( message );
+    for ( size_t counter = 0; counter < parts.size(); ++counter )
+    {
+        delete parts[ counter ];
+    }
+    pthread_mutex_destroy( &mutex );
+}
+
+void antStageStatsDump::onUserSignal
+(
+    int signalNo
+)
+{
+    userSignalReceived = 1;
+}
+
+antStageStats *antStageStatsDump::newPart
+(
+    void
+)
+{
+    antStageStats *part = new antStageStats;
+
+    pthread_mutex_lock( &mutex );
+    parts.push_back( part );
+    pthread_mutex_unlock( &mutex );
+    return part;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Open the statistics file (the statistics are appended) and start the thread writing it.
+//
+// -------------------------------------------------------------------------------------------------//
+int antStageStatsDump::start
+(
+    const amString &fileNameIn,
+    int             intervalSecondsIn,
+    amString       &message
+)
+{
+    struct sigaction userAction;
+    int              result = 0;
+
+    fileName        = fileNameIn;
+    intervalSeconds = intervalSecondsIn;
+    stopping        = 0;
+    startTime       = antStageStats::now();
+
+    outStream.open( fileName.c_str(), std::ios::out | std::ios::app );
+    if ( outStream.fail() )
+    {
+        message += "Could not open statistics file \"";
+        message += fileName;
+        message += "\" for writing.\n";
+        return E_WRITE_FILE_NOT_OPEN;
+    }
+
+    memset( &userAction, 0, sizeof( userAction ) );
+    userAction.sa_handler = onUserSignal;
+    userAction.sa_flags   = SA_RESTART;
+    sigemptyset( &userAction.sa_mask );
+    sigaction( SIGUSR1, &userAction, &previousUserAction );
+
+    if ( pthread_create( &thread, NULL, threadMain, this ) != 0 )
+    {
+        sigaction( SIGUSR1, &previousUserAction, NULL );
+        outStream.close();
+        message += "Creating the statistics thread failed.\n";
+        result   = E_THREAD_CREATE_FAIL;
+    }
+    else
+    {
+        threadRunning = true;
+    }
+    return result;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Stop the thread, write the final statistics and give SIGUSR1 its previous meaning.
+//
+// -------------------------------------------------------------------------------------------------//
+int antStageStatsDump::stop
+(
+    amString &message
+)
+{
+    int result = 0;
+
+    if ( threadRunning )
+    {
+        __atomic_store_n( &stopping, 1, __ATOMIC_RELEASE );
+        pthread_join( thread, NULL );
+        threadRunning = false;
+        sigaction( SIGUSR1, &previousUserAction, NULL );
+
+        if ( !dump( "end" ) )
+        {
+            message += "Error while writing statistics file \"";
+            message += fileName;
+            message += "\".\n";
+            result   = E_WRITE_ERROR;
+        }
+        outStream.close();
+    }
+    return result;
+}
+
+void *antStageStatsDump::threadMain
+(
+    void *dump
+)
+{
+    ( ( antStageStatsDump * ) dump )->run();
+    return NULL;
+}
+
+void antStageStatsDump::run
+(
+    void
+)
+{
+    long long nextDumpTime = startTime + ( long long ) intervalSeconds * 1000000000LL;
+
+    while ( __atomic_load_n( &stopping, __ATOMIC_ACQUIRE ) == 0 )
+    {
+        usleep( C_STATS_POLL_MS * 1000 );
+        if ( userSignalReceived )
+        {
+            userSignalReceived = 0;
+            dump( "signal" );
+        }
+        if ( ( intervalSeconds > 0 ) && ( antStageStats::now() >= nextDumpTime ) )
+        {
+            dump( "interval" );
+            nextDumpTime += ( long long ) intervalSeconds * 1000000000LL;
+        }
+    }
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Add up the counts of all threads and append them to the statistics file.
+//
+// -------------------------------------------------------------------------------------------------//
+bool antStageStatsDump::dump
+(
+    const char *reason
+)
+{
+    antStageStats   total;
+    struct timespec unixTime;
+
+    pthread_mutex_lock( &mutex );
+    for ( size_t counter = 0; counter < parts.size(); ++counter )
+    {
+        total.addCounts( *( parts[ counter ] ) );
+    }
+    pthread_mutex_unlock( &mutex );
+
+    clock_gettime( CLOCK_REALTIME, &unixTime );
+    ++nbDumps;
+    total.write( outStream, reason, nbDumps, unixTime.tv_sec + unixTime.tv_nsec * 1.0E-9, ( antStageStats::now() - startTime ) * 1.0E-9 );
+    return !outStream.fail();
+}
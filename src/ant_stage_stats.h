@@ -0,0 +1,205 @@
+#ifndef __ANT_STAGE_STATS_H__
+#define __ANT_STAGE_STATS_H__
+
+#include <fstream>
+#include <pthread.h>
+#include <signal.h>
+#include <time.h>
+#include <vector>
+
+#include "am_string.h"
+#include "ant_constants.h"
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Run time statistics (option '-Y'): how long the stages of the packet path take and what was
+// decoded.
+//
+// Stages (times in ns, taken with clock_gettime( CLOCK_MONOTONIC ), which the vDSO serves without
+// a system call):
+//     read    multicast: from the kernel receive time stamp of a packet to the return of the read
+//             call (time spent queued in the socket and reading it), stdin: the read call (files
+//             are mapped into memory, there is no read call)
+//     frame   the packet path without 'decode' and 'output': framing, time stamps, raw and
+//             diagnostics bytes, sensor eviction and device file reload
+//     decode  processSensor() (decoding and formatting of the text output)
+//     format  the record formatters (outputRecord()), part of 'decode'
+//     output  outputData() (with decode threads: handing the output over to the output thread)
+//     packet  all of it, without 'read'
+// Every stage has an HDR style histogram: values below 16 ns have a bucket each, above there are 16
+// buckets per power of two, i.e. a bucket is at most 1/16 of its lower bound wide.
+//
+// Counters: packets per device type and data page (the page toggle bit of heart rate monitors and
+// speed or cadence sensors is masked, speed and cadence sensors have no data pages: page 0),
+// packets of unknown device types, unsupported data pages, packets dropped because their sensor is
+// not registered (option '-R') and roll overs of event counts and times (getDeltaInt()).
+//
+// Every decode thread counts into an antStageStats of its own. The counters are only written by
+// their thread, with relaxed atomic stores, and read by the statistics thread with relaxed atomic
+// loads: counting costs no more than a plain increment, without the statistics nothing is counted
+// and no clock is read.
+//
+// -------------------------------------------------------------------------------------------------//
+enum antStage
+{
+    STAGE_READ,
+    STAGE_FRAME,
+    STAGE_DECODE,
+    STAGE_FORMAT,
+    STAGE_OUTPUT,
+    STAGE_PACKET,
+    NB_STAGES
+};
+
+enum antStageCounter
+{
+    STATS_UNKNOWN_DEVICE_TYPES,
+    STATS_UNKNOWN_PAGES,
+    STATS_UNREGISTERED_DROPS,
+    STATS_ROLL_OVERS,
+    NB_STATS_COUNTERS
+};
+
+const unsigned int C_STATS_SUB_BUCKET_BITS = 4;
+const unsigned int C_STATS_SUB_BUCKETS     = 1 << C_STATS_SUB_BUCKET_BITS;
+const unsigned int C_STATS_NB_BUCKETS      = ( 64 - C_STATS_SUB_BUCKET_BITS + 1 ) * C_STATS_SUB_BUCKETS;
+const unsigned int C_STATS_NB_PAGES        = 256;
+
+class antStageStats
+{
+
+    private:
+
+        struct histogram
+        {
+            unsigned long long count;
+            unsigned long long total;
+            unsigned long long maximum;
+            unsigned long long buckets[ C_STATS_NB_BUCKETS ];
+        };
+
+        histogram           stages[ NB_STAGES ];
+        unsigned long long  counters[ NB_STATS_COUNTERS ];
+        unsigned long long *pageCounts[ C_NB_DEVICE_TYPES ];   // Allocated with the first packet of the device type.
+        long long           packetStart;
+        long long           stageStart;
+        long long           stagesTime;                        // Time of the stages of the current packet so far.
+
+        static inline void add( unsigned long long &counter, unsigned long long value )
+        {
+            __atomic_store_n( &counter, __atomic_load_n( &counter, __ATOMIC_RELAXED ) + value, __ATOMIC_RELAXED );
+        }
+
+        static inline unsigned long long load( const unsigned long long &counter ) { return __atomic_load_n( &counter, __ATOMIC_RELAXED ); }
+
+        unsigned long long *addPageCounts( int deviceType );
+        void writeHistogram( std::ostream &outStream, const histogram &stage ) const;
+
+        antStageStats( const antStageStats & );
+        antStageStats &operator=( const antStageStats & );
+
+
+    public:
+
+        antStageStats( void );
+        ~antStageStats( void );
+
+        static inline long long now( void )
+        {
+            struct timespec time;
+            clock_gettime( CLOCK_MONOTONIC, &time );
+            return ( long long ) time.tv_sec * 1000000000LL + time.tv_nsec;
+        }
+
+        static unsigned int       getBucket     ( unsigned long long value );
+        static unsigned long long getBucketStart( unsigned int bucket );
+
+        void addTime( int stage, long long nanoseconds );
+
+        // Time a stage which started at 'start' (see now()). Returns the end of the stage.
+        inline long long addTimeSince( int stage, long long start )
+        {
+            long long end = now();
+            addTime( stage, end - start );
+            return end;
+        }
+
+        // Time the stages of a packet: the time of the packet not spent in the stages between
+        // beginStage() and endStage() goes to 'frame'.
+        inline void beginPacket( void ) { packetStart = now(); stagesTime = 0; }
+        inline void beginStage ( void ) { stageStart = now(); }
+        inline void endStage( int stage )
+        {
+            long long time = now() - stageStart;
+            addTime( stage, time );
+            stagesTime += time;
+        }
+        inline void endPacket( void )
+        {
+            long long time = now() - packetStart;
+            addTime( STAGE_PACKET, time );
+            addTime( STAGE_FRAME, time - stagesTime );
+        }
+
+        void countPacket( int deviceType, BYTE firstPayloadByte );
+        inline void count( int counter ) { add( counters[ counter ], 1 ); }
+
+        // Add the counts of 'part' (of another thread) to these.
+        void addCounts( const antStageStats &part );
+
+        // Write the statistics as a JSON object on a single line.
+        void write( std::ostream &outStream, const char *reason, unsigned int dumpNo, double unixTime, double upTime ) const;
+
+};
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Writes the statistics of all decode threads (see newPart()) to the statistics file: every
+// 'intervalSeconds' seconds, when the program receives SIGUSR1 and when it stops. Every write
+// appends a line holding a JSON object, the counts are totals since the start.
+// The file is written by a thread of its own, which adds up the counts of the threads.
+//
+// -------------------------------------------------------------------------------------------------//
+class antStageStatsDump
+{
+
+    private:
+
+        amString                      fileName;
+        std::ofstream                 outStream;
+        pthread_t                     thread;
+        pthread_mutex_t               mutex;
+        bool                          threadRunning;
+        int                           stopping;
+        int                           intervalSeconds;
+        unsigned int                  nbDumps;
+        long long                     startTime;
+        std::vector<antStageStats *>  parts;
+        struct sigaction              previousUserAction;
+
+        static volatile sig_atomic_t userSignalReceived;
+
+        static void  onUserSignal( int signalNo );
+        static void *threadMain( void *dump );
+        void run ( void );
+        bool dump( const char *reason );
+
+
+    public:
+
+        antStageStatsDump( void );
+        ~antStageStatsDump( void );
+
+        inline bool         isRunning  ( void ) const { return threadRunning; }
+        inline unsigned int getNbDumps ( void ) const { return nbDumps; }
+
+        int start( const amString &fileNameIn, int intervalSecondsIn, amString &message );
+        int stop ( amString &message );
+
+        // Counters for a decode thread, owned by the dump (they are still written at the end, after the
+        // decode thread is gone).
+        antStageStats *newPart( void );
+
+};
+
+#endif // __ANT_STAGE_STATS_H__
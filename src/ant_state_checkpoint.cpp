@@ -0,0 +1,485 @@
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iterator>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "am_little_endian.h"
+#include "ant_constants.h"
+#include "ant_state_checkpoint.h"
+#include "ant_decode_pipeline.h"
+
+const char         C_CHECKPOINT_MAGIC[]         = "ANTS";
+const char         C_CHECKPOINT_END_MAGIC[]     = "ANSE";
+const size_t       C_CHECKPOINT_MAGIC_LENGTH    = 4;
+const unsigned int C_CHECKPOINT_FORMAT_VERSION  = 1;
+const size_t       C_CHECKPOINT_HEADER_SIZE     = 8;
+const char         C_CHECKPOINT_TEMP_SUFFIX[]   = ".tmp";
+const size_t       C_MAX_SENSOR_ID_LENGTH       = 255;
+
+// The fields saved in a checkpoint: the running state of the sensors. Fields which only hold the
+// configuration of a sensor (registered, wheel circumference, slope, calibration, ...) are left out.
+struct checkpointCount
+{
+    int                          fieldNo;
+    unsigned int antSensorState::*member;
+};
+
+struct checkpointValue
+{
+    int                    fieldNo;
+    double antSensorState::*member;
+};
+
+static const checkpointCount C_CHECKPOINT_COUNTS[] =
+{
+    { SS_ZERO_TIME_COUNT,             &antSensorState::zeroTimeCount },
+    { SS_EVENT_TIME,                  &antSensorState::eventTime },
+    { SS_EVENT_COUNT,                 &antSensorState::eventCount },
+    { SS_TOTAL_TIME_INT,              &antSensorState::totalTimeInt },
+    { SS_TOTAL_COUNT,                 &antSensorState::totalCount },
+    { SS_OPERATING_TIME,              &antSensorState::operatingTime },
+    { SS_SAME_EVENT_COUNT,            &antSensorState::sameEventCount },
+    { SS_CADENCE,                     &antSensorState::cadence },
+    { SS_PREVIOUS_HEART_RATE,         &antSensorState::previousHeartRate },
+    { SS_HEART_RATE_EVENT_TIME,       &antSensorState::heartRateEventTime },
+    { SS_MULTI_SPORT_EVENT_DIST,      &antSensorState::multiSportEventDist },
+    { SS_ACCUMULATED_POWER,           &antSensorState::accumulatedPower },
+    { SS_ACCUMULATED_TORQUE,          &antSensorState::accumulatedTorque },
+    { SS_CRANK_OR_WHEEL_PERIOD,       &antSensorState::crankOrWheelPeriod },
+    { SS_OTHER_EVENT_COUNT,           &antSensorState::otherEventCount },
+    { SS_OTHER_ACCUMULATED_POWER,     &antSensorState::otherAccumulatedPower },
+    { SS_OTHER_TOTAL_COUNT,           &antSensorState::otherTotalCount },
+    { SS_OTHER_ACCUMULATED_TORQUE,    &antSensorState::otherAccumulatedTorque },
+    { SS_OTHER_CRANK_OR_WHEEL_PERIOD, &antSensorState::otherCrankOrWheelPeriod },
+    { SS_SPCAD_OPERATING_TIME,        &antSensorState::spcadOperatingTime },
+    { SS_CADENCE_TIME,                &antSensorState::cadenceTime },
+    { SS_CADENCE_COUNT,               &antSensorState::cadenceCount },
+    { SS_STRIDE_EVENT_DIST,           &antSensorState::strideEventDist },
+    { SS_TOTAL_STRIDE_COUNT,          &antSensorState::totalStrideCount },
+    { SS_STRIDE_COUNT,                &antSensorState::strideCount }
+};
+
+static const checkpointValue C_CHECKPOINT_VALUES[] =
+{
+    { SS_TOTAL_TIME,                  &antSensorState::totalTime },
+    { SS_TOTAL_OPERATING_TIME,        &antSensorState::totalOperatingTime },
+    { SS_HEART_BEAT_TIME,             &antSensorState::heartBeatTime },
+    { SS_MULTI_SPORT_TOTAL_DIST,      &antSensorState::multiSportTotalDist },
+    { SS_POWER,                       &antSensorState::power },
+    { SS_TORQUE,                      &antSensorState::torque },
+    { SS_SPEED,                       &antSensorState::speed },
+    { SS_STRIDE_TOTAL_DIST,           &antSensorState::strideTotalDist }
+};
+
+const size_t C_NB_CHECKPOINT_COUNTS = sizeof( C_CHECKPOINT_COUNTS ) / sizeof( C_CHECKPOINT_COUNTS[ 0 ] );
+const size_t C_NB_CHECKPOINT_VALUES = sizeof( C_CHECKPOINT_VALUES ) / sizeof( C_CHECKPOINT_VALUES[ 0 ] );
+
+static unsigned long long getCheckpointMask
+(
+    void
+)
+{
+    unsigned long long mask = 0;
+    for ( size_t counter = 0; counter < C_NB_CHECKPOINT_COUNTS; ++counter )
+    {
+        mask |= 1ULL << C_CHECKPOINT_COUNTS[ counter ].fieldNo;
+    }
+    for ( size_t counter = 0; counter < C_NB_CHECKPOINT_VALUES; ++counter )
+    {
+        mask |= 1ULL << C_CHECKPOINT_VALUES[ counter ].fieldNo;
+    }
+    return mask;
+}
+
+antStateCheckpoint::antStateCheckpoint
+(
+    void
+)
+{
+    threadRunning = false;
+    stopping      = false;
+    snapshotNo    = 0;
+    nbParts       = 0;
+    nbPartsIn     = 0;
+    hasComplete   = false;
+    nbWritten     = 0;
+    errorCode     = 0;
+    pthread_mutex_init( &mutex, NULL );
+    pthread_cond_init( &condition, NULL );
+}
+
+antStateCheckpoint::~antStateCheckpoint
+(
+    void
+)
+{
+    amString message;
+    stop( message );
+    pthread_cond_destroy( &condition );
+    pthread_mutex_destroy( &mutex );
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Start the thread writing the checkpoints to 'fileNameIn'.
+//
+// -------------------------------------------------------------------------------------------------//
+int antStateCheckpoint::start
+(
+    const amString &fileNameIn,
+    amString       &message
+)
+{
+    int result = 0;
+
+    fileName = fileNameIn;
+    stopping = false;
+    if ( pthread_create( &thread, NULL, threadMain, this ) != 0 )
+    {
+        message += "Creating the state checkpoint thread failed.\n";
+        result   = E_THREAD_CREATE_FAIL;
+    }
+    else
+    {
+        threadRunning = true;
+    }
+    return result;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Write the last complete snapshot, if it has not been written yet, and stop the thread.
+// Returns the first error of the thread.
+//
+// -------------------------------------------------------------------------------------------------//
+int antStateCheckpoint::stop
+(
+    amString &message
+)
+{
+    if ( threadRunning )
+    {
+        pthread_mutex_lock( &mutex );
+        stopping = true;
+        pthread_cond_signal( &condition );
+        pthread_mutex_unlock( &mutex );
+
+        pthread_join( thread, NULL );
+        threadRunning = false;
+    }
+    message += errorMessage;
+    errorMessage.clear();
+
+    return errorCode;
+}
+
+unsigned int antStateCheckpoint::begin
+(
+    unsigned int nbSnapshotParts,
+    bool         last
+)
+{
+    unsigned int result = 0;
+
+    pthread_mutex_lock( &mutex );
+    if ( last || ( nbPartsIn == nbParts ) )
+    {
+        ++snapshotNo;
+        nbParts   = nbSnapshotParts;
+        nbPartsIn = 0;
+        collected.clear();
+        result    = snapshotNo;
+    }
+    pthread_mutex_unlock( &mutex );
+
+    return result;
+}
+
+void antStateCheckpoint::submit
+(
+    unsigned int         snapshotNoIn,
+    antSensorStateTable &table
+)
+{
+    pthread_mutex_lock( &mutex );
+    if ( snapshotNoIn == snapshotNo )
+    {
+        table.copyRecords( collected, getCheckpointMask() );
+        ++nbPartsIn;
+        if ( nbPartsIn == nbParts )
+        {
+            // A snapshot the thread has not taken yet is superseded by this one.
+            complete.swap( collected );
+            collected.clear();
+            hasComplete = true;
+            pthread_cond_signal( &condition );
+        }
+    }
+    pthread_mutex_unlock( &mutex );
+}
+
+void *antStateCheckpoint::threadMain
+(
+    void *checkpoint
+)
+{
+    ( ( antStateCheckpoint * ) checkpoint )->run();
+    return NULL;
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Main loop of the checkpoint thread: write every complete snapshot handed over by submit().
+//
+// -------------------------------------------------------------------------------------------------//
+void antStateCheckpoint::run
+(
+    void
+)
+{
+    std::vector<antSensorState> records;
+    amString                    message;
+    bool                        done = false;
+
+    while ( !done )
+    {
+        pthread_mutex_lock( &mutex );
+        while ( !hasComplete && !stopping )
+        {
+            pthread_cond_wait( &condition, &mutex );
+        }
+        records.swap( complete );
+        complete.clear();
+        done        = stopping && !hasComplete;
+        hasComplete = false;
+        pthread_mutex_unlock( &mutex );
+
+        if ( !done && ( write( records, message ) != 0 ) && ( errorCode == 0 ) )
+        {
+            errorCode    = E_WRITE_ERROR;
+            errorMessage = message;
+        }
+        message.clear();
+        records.clear();
+    }
+}
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Write a checkpoint to "<file>.tmp" and rename it to "<file>" once it is on disk.
+//
+// -------------------------------------------------------------------------------------------------//
+int antStateCheckpoint::write
+(
+    const std::vector<antSensorState> &records,
+    amString                          &message
+)
+{
+    int                fileDescriptor = -1;
+    unsigned long long checkpointMask = getCheckpointMask();
+    unsigned long long present        = 0;
+    unsigned long long bits           = 0;
+    unsigned int       nbSensors      = 0;
+    double             value          = 0;
+    amString           tempFileName( fileName + C_CHECKPOINT_TEMP_SUFFIX );
+    amString           directoryName( "." );
+    amString           data( C_CHECKPOINT_MAGIC );
+    size_t             separator      = fileName.rfind( '/' );
+
+    amAppendLittleEndian( data, C_CHECKPOINT_FORMAT_VERSION, 1 );
+    amAppendLittleEndian( data, 0, 3 );
+    amAppendLittleEndian( data, 0, 4 );
+    for ( std::vector<antSensorState>::const_iterator record = records.begin(); record != records.end(); ++record )
+    {
+        if ( record->sensorID.size() > C_MAX_SENSOR_ID_LENGTH )
+        {
+            continue;
+        }
+        present = record->present & checkpointMask;
+        amAppendLittleEndian( data, record->sensorID.size(), 1 );
+        data += record->sensorID;
+        amAppendLittleEndian( data, present, 8 );
+        ++nbSensors;
+        for ( size_t counter = 0; counter < C_NB_CHECKPOINT_COUNTS; ++counter )
+        {
+            if ( ( present & ( 1ULL << C_CHECKPOINT_COUNTS[ counter ].fieldNo ) ) != 0 )
+            {
+                amAppendLittleEndian( data, ( *record ).*( C_CHECKPOINT_COUNTS[ counter ].member ), 4 );
+            }
+        }
+        for ( size_t counter = 0; counter < C_NB_CHECKPOINT_VALUES; ++counter )
+        {
+            if ( ( present & ( 1ULL << C_CHECKPOINT_VALUES[ counter ].fieldNo ) ) != 0 )
+            {
+                value = ( *record ).*( C_CHECKPOINT_VALUES[ counter ].member );
+                memcpy( &bits, &value, sizeof( bits ) );
+                amAppendLittleEndian( data, bits, 8 );
+            }
+        }
+    }
+    for ( size_t counter = 0; counter < 4; ++counter )
+    {
+        data[ C_CHECKPOINT_HEADER_SIZE + counter ] = ( char ) ( ( nbSensors >> ( 8 * counter ) ) & 0xFF );
+    }
+    data += C_CHECKPOINT_END_MAGIC;
+
+    fileDescriptor = ::open( tempFileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+    if ( fileDescriptor < 0 )
+    {
+        message += "Could not open state checkpoint file \"";
+        message += tempFileName;
+        message += "\" for writing.\n";
+        return E_WRITE_FILE_NOT_OPEN;
+    }
+    if ( !amWriteAll( fileDescriptor, data.c_str(), data.size() ) || ( fsync( fileDescriptor ) != 0 ) )
+    {
+        message += "Could not write the state checkpoint file: ";
+        message += strerror( errno );
+        message += "\n";
+        ::close( fileDescriptor );
+        return E_WRITE_ERROR;
+    }
+    ::close( fileDescriptor );
+
+    if ( rename( tempFileName.c_str(), fileName.c_str() ) != 0 )
+    {
+        message += "Could not rename \"";
+        message += tempFileName;
+        message += "\" to \"";
+        message += fileName;
+        message += "\": ";
+        message += strerror( errno );
+        message += "\n";
+        return E_WRITE_ERROR;
+    }
+
+    // Make the rename itself survive a crash.
+    if ( separator != std::string::npos )
+    {
+        directoryName = fileName.substr( 0, ( separator == 0 ) ? 1 : separator );
+    }
+    fileDescriptor = ::open( directoryName.c_str(), O_RDONLY );
+    if ( fileDescriptor >= 0 )
+    {
+        fsync( fileDescriptor );
+        ::close( fileDescriptor );
+    }
+
+    ++nbWritten;
+    return 0;
+}
+
+int antStateCheckpoint::load
+(
+    const amString      &fileNameIn,
+    antSensorStateTable &table,
+    unsigned int         workerNo,
+    unsigned int         nbWorkers,
+    unsigned int        &nbRestored,
+    amString            &message
+)
+{
+    unsigned long long checkpointMask = getCheckpointMask();
+    unsigned long long present        = 0;
+    unsigned long long bits           = 0;
+    unsigned int       nbSensors      = 0;
+    size_t             idLength       = 0;
+    size_t             position       = C_CHECKPOINT_HEADER_SIZE;
+    size_t             recordSize     = 0;
+    double             value          = 0;
+    bool               valid          = true;
+    amString           sensorID;
+    std::string        data;
+    std::ifstream      inStream( fileNameIn.c_str(), std::ios::in | std::ios::binary );
+
+    nbRestored = 0;
+    if ( inStream.fail() )
+    {
+        return 0;
+    }
+    data.assign( std::istreambuf_iterator<char>( inStream ), std::istreambuf_iterator<char>() );
+
+    valid = ( data.size() >= C_CHECKPOINT_HEADER_SIZE + 4 + C_CHECKPOINT_MAGIC_LENGTH ) &&
+            ( data.compare( 0, C_CHECKPOINT_MAGIC_LENGTH, C_CHECKPOINT_MAGIC ) == 0 ) &&
+            ( ( unsigned char ) data[ C_CHECKPOINT_MAGIC_LENGTH ] == C_CHECKPOINT_FORMAT_VERSION ) &&
+            ( data.compare( data.size() - C_CHECKPOINT_MAGIC_LENGTH, C_CHECKPOINT_MAGIC_LENGTH, C_CHECKPOINT_END_MAGIC ) == 0 );
+    if ( valid )
+    {
+        nbSensors = ( unsigned int ) amReadLittleEndian( data.c_str() + position, 4 );
+        position += 4;
+    }
+
+    for ( unsigned int sensorNo = 0; valid && ( sensorNo < nbSensors ); ++sensorNo )
+    {
+        valid = ( position + 1 <= data.size() );
+        if ( valid )
+        {
+            idLength = ( unsigned char ) data[ position ];
+            valid    = ( position + 1 + idLength + 8 <= data.size() );
+        }
+        if ( valid )
+        {
+            sensorID  = data.substr( position + 1, idLength );
+            position += 1 + idLength;
+            present   = amReadLittleEndian( data.c_str() + position, 8 );
+            position += 8;
+
+            // Fields unknown to this version: the size of the record is not known either.
+            valid = ( ( present & ~checkpointMask ) == 0 );
+        }
+        if ( valid )
+        {
+            recordSize = 0;
+            for ( size_t counter = 0; counter < C_NB_CHECKPOINT_COUNTS; ++counter )
+            {
+                recordSize += ( ( present & ( 1ULL << C_CHECKPOINT_COUNTS[ counter ].fieldNo ) ) != 0 ) ? 4 : 0;
+            }
+            for ( size_t counter = 0; counter < C_NB_CHECKPOINT_VALUES; ++counter )
+            {
+                recordSize += ( ( present & ( 1ULL << C_CHECKPOINT_VALUES[ counter ].fieldNo ) ) != 0 ) ? 8 : 0;
+            }
+            valid = ( position + recordSize <= data.size() );
+        }
+        if ( valid && ( antDecodePipeline::getSemiCookedKey( sensorID.c_str(), sensorID.size() ) % nbWorkers == workerNo ) )
+        {
+            antSensorState &record = table.get( sensorID );
+            for ( size_t counter = 0; counter < C_NB_CHECKPOINT_COUNTS; ++counter )
+            {
+                if ( ( present & ( 1ULL << C_CHECKPOINT_COUNTS[ counter ].fieldNo ) ) != 0 )
+                {
+                    record.*( C_CHECKPOINT_COUNTS[ counter ].member ) = ( unsigned int ) amReadLittleEndian( data.c_str() + position, 4 );
+                    position += 4;
+                }
+            }
+            for ( size_t counter = 0; counter < C_NB_CHECKPOINT_VALUES; ++counter )
+            {
+                if ( ( present & ( 1ULL << C_CHECKPOINT_VALUES[ counter ].fieldNo ) ) != 0 )
+                {
+                    bits = amReadLittleEndian( data.c_str() + position, 8 );
+                    memcpy( &value, &bits, sizeof( value ) );
+                    record.*( C_CHECKPOINT_VALUES[ counter ].member ) = value;
+                    position += 8;
+                }
+            }
+            record.present |= present;
+            ++nbRestored;
+        }
+        else if ( valid )
+        {
+            position += recordSize;
+        }
+    }
+
+    if ( !valid || ( position + C_CHECKPOINT_MAGIC_LENGTH != data.size() ) )
+    {
+        message += "The state checkpoint file \"";
+        message += fileNameIn;
+        message += "\" is damaged or was written by another version.\n";
+        return E_READ_ERROR;
+    }
+    return 0;
+}
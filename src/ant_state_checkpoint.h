@@ -0,0 +1,94 @@
+#ifndef __ANT_STATE_CHECKPOINT_H__
+#define __ANT_STATE_CHECKPOINT_H__
+
+#include <pthread.h>
+#include <vector>
+
+#include "am_string.h"
+#include "ant_sensor_state.h"
+
+// -------------------------------------------------------------------------------------------------//
+//
+// Sensor state checkpoint file (option '-k').
+// The running state of the sensors (event counts and times, totals, zero time counts, previous
+// values) is saved every few seconds and restored when the program starts again, so the first
+// packets after a restart are decoded against the values of the last run. The configuration of the
+// sensors (device file, defaults) is not saved: it is read again at start.
+// All numbers are little-endian.
+//
+//     "ANTS", format version (1 byte), 3 bytes reserved
+//     number of sensors (4 bytes), per sensor:
+//         sensor ID length (1 byte), sensor ID, fields present (8 bytes, bits of antSensorStateField),
+//         then the values of the fields present: 4 bytes for counts, 8 bytes (IEEE 754) for doubles
+//     trailer: "ANSE"
+//
+// A checkpoint is written to "<file>.tmp", synced and then renamed to "<file>", so "<file>" always
+// holds a complete checkpoint. The bits of antSensorStateField are part of the format: the format
+// version is raised when they change.
+//
+// The packet path only copies the state records (see submit()); the file is written by a thread of
+// its own. With several decode threads every thread copies the records of its own sensors and the
+// checkpoint is written once all threads have handed in their part.
+//
+// -------------------------------------------------------------------------------------------------//
+class antStateCheckpoint
+{
+
+    private:
+
+        amString                    fileName;
+        pthread_t                   thread;
+        pthread_mutex_t             mutex;
+        pthread_cond_t              condition;
+        bool                        threadRunning;
+        bool                        stopping;
+        unsigned int                snapshotNo;     // Snapshot being collected.
+        unsigned int                nbParts;
+        unsigned int                nbPartsIn;
+        std::vector<antSensorState> collected;
+        std::vector<antSensorState> complete;       // Snapshot waiting for the thread.
+        bool                        hasComplete;
+        unsigned int                nbWritten;
+        int                         errorCode;      // First error of the thread.
+        amString                    errorMessage;
+
+        static void *threadMain( void *checkpoint );
+        void run( void );
+        int  write( const std::vector<antSensorState> &records, amString &message );
+
+
+    public:
+
+        antStateCheckpoint( void );
+        ~antStateCheckpoint( void );
+
+        inline bool         isRunning   ( void ) const { return threadRunning; }
+        inline unsigned int getNbWritten( void ) const { return nbWritten; }
+
+        int start( const amString &fileNameIn, amString &message );
+        int stop ( amString &message );
+
+        // Start a new snapshot made of 'nbSnapshotParts' parts and return its number. While the parts of
+        // the previous snapshot are still coming in no new one is started (returns 0), unless it is the
+        // last one: the previous snapshot is then dropped.
+        unsigned int begin( unsigned int nbSnapshotParts, bool last );
+
+        // Copy the state of all sensors of 'table' into snapshot 'snapshotNoIn'. Parts of a dropped
+        // snapshot are ignored.
+        void submit( unsigned int snapshotNoIn, antSensorStateTable &table );
+
+        // Restore the sensors of a checkpoint whose key (see antDecodePipeline::getSemiCookedKey)
+        // modulo 'nbWorkers' is 'workerNo'. A missing file is not an error.
+        static int load
+                   (
+                       const amString      &fileNameIn,
+                       antSensorStateTable &table,
+                       unsigned int         workerNo,
+                       unsigned int         nbWorkers,
+                       unsigned int        &nbRestored,
+                       amString            &message
+                   );
+
+};
+
+#endif // __ANT_STATE_CHECKPOINT_H__
@@ -20,7 +20,11 @@
 antStrideSpeedDistProcessing::antStrideSpeedDistProcessing
 (
     void
-) : antProcessing()
+) : antProcessing(),
+    totalDistTable( sensorStates, &antSensorState::strideTotalDist, SS_STRIDE_TOTAL_DIST ),
+    eventDistTable( sensorStates, &antSensorState::strideEventDist, SS_STRIDE_EVENT_DIST ),
+    totalStrideCountTable( sensorStates, &antSensorState::totalStrideCount, SS_TOTAL_STRIDE_COUNT ),
+    strideCountTable( sensorStates, &antSensorState::strideCount, SS_STRIDE_COUNT )
 {
     setCurrentDeviceType( "STRIDE" );
     reset();
@@ -62,30 +66,23 @@ bool antStrideSpeedDistProcessing::appendStrideSpeedDistSensor
 //-------------------------------------------------------------------------------------------------//
 amDeviceType antStrideSpeedDistProcessing::processStrideBasedSpeedAndDistanceSensor
 (
-    const amString &deviceIDNo,
+    unsigned int    deviceIDNo,
     const amString &timeStampBuffer,
     BYTE            payLoad[]
 )
 {
-    amDeviceType result                            = OTHER_DEVICE;
-    amString     sensorID                          = amString( C_SBSDM_DEVICE_HEAD ) + deviceIDNo;
-    char         auxBuffer[ C_MEDIUM_BUFFER_SIZE ] = { 0 };
-    unsigned int dataPage                          = 0;
-    unsigned int auxInt1                           = 0;
-    unsigned int auxInt2                           = 0;
-    unsigned int auxInt3                           = 0;
-    unsigned int additionalData1                   = 0;
-    unsigned int additionalData2                   = 0;
-    unsigned int additionalData3                   = 0;
-    unsigned int additionalData4                   = 0;
-    unsigned int additionalData5                   = 0;
-    unsigned int additionalData6                   = 0;
-    unsigned int additionalData7                   = 0;
-    unsigned int additionalData8                   = 0;
-    unsigned int rollOver                          = 0;
-    bool         rollOverHappened                  = false;
-    bool         commonPage                        = false;
-    bool         outputPageNo                      = true;
+    amDeviceType             result                            = OTHER_DEVICE;
+    antSensorHandle          sensorID                          = sensorStates.intern( C_SBSDM_DEVICE_HEAD, deviceIDNo );
+    char                     auxBuffer[ C_MEDIUM_BUFFER_SIZE ] = { 0 };
+    unsigned int             dataPage                          = 0;
+    unsigned int             auxInt1                           = 0;
+    unsigned int             auxInt2                           = 0;
+    unsigned int             auxInt3                           = 0;
+    unsigned int             rollOver                          = 0;
+    bool                     rollOverHappened                  = false;
+    bool                     commonPage                        = false;
+    bool                     outputPageNo                      = true;
+    antStrideSpeedDistRecord record                            = antStrideSpeedDistRecord();
 
     if ( isRegisteredDevice( sensorID ) )
     {
@@ -101,10 +98,10 @@ amDeviceType antStrideSpeedDistProcessing::processStrideBasedSpeedAndDistanceSen
 
                      if ( totalTimeTable.count( sensorID ) > 0 )
                      {
-                         totalTimeTable.insert( std::pair<amString, double>( sensorID, 0 ) );
-                         totalDistTable.insert( std::pair<amString, double>( sensorID, 0 ) );
-                         eventTimeTable.insert( std::pair<amString, unsigned int>( sensorID, 0 ) );
-                         eventCountTable.insert( std::pair<amString, int>( sensorID, 0 ) );
+                         totalTimeTable.insert( sensorID, 0 );
+                         totalDistTable.insert( sensorID, 0 );
+                         eventTimeTable.insert( sensorID, 0 );
+                         eventCountTable.insert( sensorID, 0 );
                      }
 
                      rollOver     = 256;  // 256 (1 byte)
@@ -112,18 +109,18 @@ amDeviceType antStrideSpeedDistProcessing::processStrideBasedSpeedAndDistanceSen
                      auxInt2      = getDeltaInt( rollOverHappened, sensorID, rollOver, eventTimeTable, auxInt1 );
                      if ( semiCookedOut )
                      {
-                         additionalData1 = auxInt2;
+                         record.value1 = auxInt2;
                      }
                      else
                      {
-                         additionalData1               = auxInt2 + totalTimeIntTable[ sensorID ];
-                         totalTimeIntTable[ sensorID ] = additionalData1;
+                         record.value1                 = auxInt2 + totalTimeIntTable[ sensorID ];
+                         totalTimeIntTable[ sensorID ] = record.value1;
                      }
-                     additionalData2 = byte2UInt( payLoad[ 3 ] );  // Time (fractional part)
+                     record.value2   = byte2UInt( payLoad[ 3 ] );  // Time (fractional part)
 
                      if ( diagnostics )
                      {
-                         appendDiagnosticsLine( "Time (fractional part)", payLoad[ 1 ], additionalData2 );
+                         appendDiagnosticsLine( "Time (fractional part)", payLoad[ 1 ], record.value2 );
                          appendDiagnosticsLine( "Time (integer part)", payLoad[ 2 ], auxInt1 );
                          *auxBuffer = 0;
                          if ( rollOverHappened )
@@ -133,7 +130,7 @@ amDeviceType antStrideSpeedDistProcessing::processStrideBasedSpeedAndDistanceSen
                          appendDiagnosticsLine( "Delta Time", auxInt2, auxBuffer );
                          if ( !semiCookedOut )
                          {
-                             appendDiagnosticsLine( "Total Time (int)", additionalData1 );
+                             appendDiagnosticsLine( "Total Time (int)", record.value1 );
                          }
                      }
 
@@ -142,20 +139,20 @@ amDeviceType antStrideSpeedDistProcessing::processStrideBasedSpeedAndDistanceSen
                      auxInt2      = getDeltaInt( rollOverHappened, sensorID, rollOver, eventDistTable, auxInt1 );
                      if ( semiCookedOut )
                      {
-                         additionalData3 = auxInt2;
+                         record.value3 = auxInt2;
                      }
                      else
                      {
-                         additionalData3               = auxInt2 + totalTimeIntTable[ sensorID ];
-                         totalTimeIntTable[ sensorID ] = additionalData3;
+                         record.value3                 = auxInt2 + totalTimeIntTable[ sensorID ];
+                         totalTimeIntTable[ sensorID ] = record.value3;
                      }
 
                      auxInt3         = byte2UInt( payLoad[ 4 ] );
-                     additionalData4 = auxInt3 >> 4;         // Distance (fractional part)
+                     record.value4   = auxInt3 >> 4;         // Distance (fractional part)
 
                      if ( diagnostics )
                      {
-                         appendDiagnosticsLine( "Dist (fractional part)", payLoad[ 4 ], additionalData4, " (upper 4 bits)" );
+                         appendDiagnosticsLine( "Dist (fractional part)", payLoad[ 4 ], record.value4, " (upper 4 bits)" );
                          appendDiagnosticsLine( "Dist (integer part)", payLoad[ 3 ], auxInt1 );
                          *auxBuffer = 0;
                          if ( rollOverHappened )
@@ -165,16 +162,16 @@ amDeviceType antStrideSpeedDistProcessing::processStrideBasedSpeedAndDistanceSen
                          appendDiagnosticsLine( "Delta Dist", auxInt2, auxBuffer );
                          if ( !semiCookedOut )
                          {
-                             appendDiagnosticsLine( "Total Dist (int)", additionalData3 );
+                             appendDiagnosticsLine( "Total Dist (int)", record.value3 );
                          }
                      }
 
-                     additionalData5 = ( auxInt3 << 4 ) >> 4;         // Speed (integer part)
-                     additionalData6 = byte2UInt( payLoad[ 5 ] );           // Speed (fractional part)
+                     record.value5   = ( auxInt3 << 4 ) >> 4;         // Speed (integer part)
+                     record.value6   = byte2UInt( payLoad[ 5 ] );           // Speed (fractional part)
                      if ( diagnostics )
                      {
-                         appendDiagnosticsLine( "Speed (fractional part)", payLoad[ 4 ], additionalData5, " (lower 4 bits)" );
-                         appendDiagnosticsLine( "Speed (integer part)",    payLoad[ 5 ], additionalData6 );
+                         appendDiagnosticsLine( "Speed (fractional part)", payLoad[ 4 ], record.value5, " (lower 4 bits)" );
+                         appendDiagnosticsLine( "Speed (integer part)",    payLoad[ 5 ], record.value6 );
                      }
 
                      auxInt1      = byte2UInt( payLoad[ 6 ] );           // Stride count
@@ -182,12 +179,12 @@ amDeviceType antStrideSpeedDistProcessing::processStrideBasedSpeedAndDistanceSen
                      auxInt2      = getDeltaInt( rollOverHappened, sensorID, rollOver, strideCountTable, auxInt1 );
                      if ( semiCookedOut )
                      {
-                         additionalData7 = auxInt2;
+                         record.value7 = auxInt2;
                      }
                      else
                      {
-                         additionalData7                   = auxInt2 + totalStrideCountTable[ sensorID ];
-                         totalStrideCountTable[ sensorID ] = additionalData7;
+                         record.value7                     = auxInt2 + totalStrideCountTable[ sensorID ];
+                         totalStrideCountTable[ sensorID ] = record.value7;
                      }
                      if ( diagnostics )
                      {
@@ -200,14 +197,14 @@ amDeviceType antStrideSpeedDistProcessing::processStrideBasedSpeedAndDistanceSen
                          appendDiagnosticsLine( "Delta Stride Count", auxInt2, auxBuffer );
                          if ( !semiCookedOut )
                          {
-                             appendDiagnosticsLine( "Total Stride Count", additionalData7 );
+                             appendDiagnosticsLine( "Total Stride Count", record.value7 );
                          }
                      }
 
-                     additionalData8 = byte2UInt( payLoad[ 7 ] );           // Latency
+                     record.value8   = byte2UInt( payLoad[ 7 ] );           // Latency
                      if ( diagnostics )
                      {
-                         appendDiagnosticsLine( "Latency", payLoad[ 7 ], additionalData8 );
+                         appendDiagnosticsLine( "Latency", payLoad[ 7 ], record.value8 );
                      }
 
                      break;
@@ -215,55 +212,55 @@ amDeviceType antStrideSpeedDistProcessing::processStrideBasedSpeedAndDistanceSen
             case  2:
             case  3: result = STRIDE_BASED_SD_SENSOR;
 
-                     additionalData3 = byte2UInt( payLoad[ 3 ] );     // Cadence (integer part)
+                     record.value3   = byte2UInt( payLoad[ 3 ] );     // Cadence (integer part)
                      auxInt3         = byte2UInt( payLoad[ 4 ] );
-                     additionalData4 = auxInt3 >> 4;            // Cadence (fractional part)
+                     record.value4   = auxInt3 >> 4;            // Cadence (fractional part)
 
                      if ( diagnostics )
                      {
-                         appendDiagnosticsLine( "Cadence (fractional part)", payLoad[ 4 ], additionalData4, " (upper 4 bits)" );
+                         appendDiagnosticsLine( "Cadence (fractional part)", payLoad[ 4 ], record.value4, " (upper 4 bits)" );
                          appendDiagnosticsLine( "Cadence (integer part)", payLoad[ 3 ], auxInt1 );
                      }
 
-                     additionalData5 = ( auxInt3 << 4 ) >> 4;         // Speed (integer part)
-                     additionalData6 = byte2UInt( payLoad[ 5 ] );           // Speed (fractional part)
+                     record.value5   = ( auxInt3 << 4 ) >> 4;         // Speed (integer part)
+                     record.value6   = byte2UInt( payLoad[ 5 ] );           // Speed (fractional part)
                      if ( diagnostics )
                      {
-                         appendDiagnosticsLine( "Speed (fractional part)", payLoad[ 4 ], additionalData5, " (lower 4 bits)" );
-                         appendDiagnosticsLine( "Speed (integer part)",    payLoad[ 5 ], additionalData6 );
+                         appendDiagnosticsLine( "Speed (fractional part)", payLoad[ 4 ], record.value5, " (lower 4 bits)" );
+                         appendDiagnosticsLine( "Speed (integer part)",    payLoad[ 5 ], record.value6 );
                      }
 
                      if ( dataPage == 3 )
                      {
-                         additionalData7 = byte2UInt( payLoad[ 6 ] );       // Calories
+                         record.value7   = byte2UInt( payLoad[ 6 ] );       // Calories
                          if ( diagnostics )
                          {
-                             appendDiagnosticsLine( "Calories", payLoad[ 6 ], additionalData7 );
+                             appendDiagnosticsLine( "Calories", payLoad[ 6 ], record.value7 );
                          }
                      }
 
-                     additionalData8 = byte2UInt( payLoad[ 7 ] );           // Status
+                     record.value8   = byte2UInt( payLoad[ 7 ] );           // Status
                      if ( diagnostics )
                      {
-                         appendDiagnosticsLine( "Status", payLoad[ 7 ], additionalData8 );
+                         appendDiagnosticsLine( "Status", payLoad[ 7 ], record.value8 );
                      }
 
                      break;
 
             case 16: result = STRIDE_BASED_SD_SENSOR;
-                     additionalData1 = byte2UInt( payLoad[ 3 ], payLoad[ 2 ], payLoad[ 1 ] );                   // Strides
-                     additionalData2 = byte2UInt( payLoad[ 7 ], payLoad[ 6 ], payLoad[ 5 ], payLoad[ 4 ] );     // Distances
+                     record.value1   = byte2UInt( payLoad[ 3 ], payLoad[ 2 ], payLoad[ 1 ] );                   // Strides
+                     record.value2   = byte2UInt( payLoad[ 7 ], payLoad[ 6 ], payLoad[ 5 ], payLoad[ 4 ] );     // Distances
                      if ( diagnostics )
                      {
-                         appendDiagnosticsLine( "Strides",  payLoad[ 3 ], payLoad[ 2 ], payLoad[ 1 ],               additionalData1 );
-                         appendDiagnosticsLine( "Distance", payLoad[ 7 ], payLoad[ 6 ], payLoad[ 5 ], payLoad[ 4 ], additionalData2 );
+                         appendDiagnosticsLine( "Strides",  payLoad[ 3 ], payLoad[ 2 ], payLoad[ 1 ],               record.value1 );
+                         appendDiagnosticsLine( "Distance", payLoad[ 7 ], payLoad[ 6 ], payLoad[ 5 ], payLoad[ 4 ], record.value2 );
                      }
 
             case 22: result = STRIDE_BASED_SD_SENSOR;
-                     additionalData1 = byte2UInt( payLoad[ 1 ] );                 // Capabilities
+                     record.value1   = byte2UInt( payLoad[ 1 ] );                 // Capabilities
                      if ( diagnostics )
                      {
-                         appendDiagnosticsLine( "Capabilities", payLoad[ 1 ], additionalData1 );
+                         appendDiagnosticsLine( "Capabilities", payLoad[ 1 ], record.value1 );
                      }
 
                      break;
@@ -276,10 +273,9 @@ amDeviceType antStrideSpeedDistProcessing::processStrideBasedSpeedAndDistanceSen
 
     if ( result == STRIDE_BASED_SD_SENSOR )
     {
-        createOutputHeader( sensorID, timeStampBuffer );
         if ( commonPage )
         {
-            commonPage = processCommonPages( sensorID, payLoad, outputPageNo );
+            commonPage = processCommonPages( sensorID, timeStampBuffer, getVersion(), payLoad, outputPageNo );
             if ( !commonPage )
             {
                 result = OTHER_DEVICE;
@@ -287,20 +283,9 @@ amDeviceType antStrideSpeedDistProcessing::processStrideBasedSpeedAndDistanceSen
         }
         else
         {
-            createSBSDMResultString
-            (
-                dataPage,
-                additionalData1,
-                additionalData2,
-                additionalData3,
-                additionalData4,
-                additionalData5,
-                additionalData6,
-                additionalData7,
-                additionalData8
-            );
+            record.dataPage = dataPage;
+            outputRecord( antRecordContext( sensorID, timeStampBuffer, getVersion() ), record );
         }
-        appendOutputFooter( getVersion() );
     }
 
     if ( result == OTHER_DEVICE )
@@ -308,7 +293,7 @@ amDeviceType antStrideSpeedDistProcessing::processStrideBasedSpeedAndDistanceSen
         resetOutBuffer();
         if ( outputUnknown )
         {
-            int deviceIDNoAsInt = deviceIDNo.toInt();
+            int deviceIDNoAsInt = ( int ) deviceIDNo;
             createUnknownDeviceTypeString( C_SBSDM_TYPE, deviceIDNoAsInt, timeStampBuffer, payLoad );
         }
     }
@@ -329,29 +314,22 @@ amDeviceType antStrideSpeedDistProcessing::processStrideBasedSpeedAndDistanceSen
     const amString &inputBuffer
 )
 {
-    amDeviceType  result          = OTHER_DEVICE;
-    amString      sensorID;
-    amString      semiCookedString;
-    amString      timeStampBuffer;
-    amString      curVersion      = getVersion();
-    amSplitString words;
-    unsigned int  nbWords         = words.split( inputBuffer );
-    unsigned int  startCounter    = 0;
-    unsigned int  counter         = 0;
-    unsigned int  dataPage        = 0;
-    unsigned int  auxInt1         = 0;
-    unsigned int  auxInt2         = 0;
-    unsigned int  auxInt3         = 0;
-    unsigned int  additionalData1 = 0;
-    unsigned int  additionalData2 = 0;
-    unsigned int  additionalData3 = 0;
-    unsigned int  additionalData4 = 0;
-    unsigned int  additionalData5 = 0;
-    unsigned int  additionalData6 = 0;
-    unsigned int  additionalData7 = 0;
-    unsigned int  additionalData8 = 0;
-    bool          commonPage      = false;
-    bool          outputPageNo    = true;
+    amDeviceType             result       = OTHER_DEVICE;
+    amString                 sensorID;
+    amString                 semiCookedString;
+    amString                 timeStampBuffer;
+    amString                 curVersion   = getVersion();
+    amSplitString            words;
+    unsigned int             nbWords      = words.split( inputBuffer );
+    unsigned int             startCounter = 0;
+    unsigned int             counter      = 0;
+    unsigned int             dataPage     = 0;
+    unsigned int             auxInt1      = 0;
+    unsigned int             auxInt2      = 0;
+    unsigned int             auxInt3      = 0;
+    bool                     commonPage   = false;
+    bool                     outputPageNo = true;
+    antStrideSpeedDistRecord record       = antStrideSpeedDistRecord();
 
     if ( nbWords > 7 )
     {
@@ -389,60 +367,60 @@ amDeviceType antStrideSpeedDistProcessing::processStrideBasedSpeedAndDistanceSen
                                  auxInt1 = words[ counter++ ].toUInt();                                           //  4 - Delta Time (Integer Part)
                                  if ( semiCookedOut )
                                  {
-                                     additionalData1 = auxInt1;
+                                     record.value1 = auxInt1;
                                  }
                                  else
                                  {
-                                     additionalData1               = auxInt1 + totalTimeIntTable[ sensorID ];
-                                     totalTimeIntTable[ sensorID ] = additionalData1;
+                                     record.value1                 = auxInt1 + totalTimeIntTable[ sensorID ];
+                                     totalTimeIntTable[ sensorID ] = record.value1;
                                  }
-                                 additionalData2 = words[ counter++ ].toUInt();                                   //  5 - Time (Fractional Part)
+                                 record.value2   = words[ counter++ ].toUInt();                                   //  5 - Time (Fractional Part)
                                  auxInt2         = words[ counter++ ].toUInt();                                   //  6 - Delta distance (Integer Part)
                                  if ( semiCookedOut )
                                  {
-                                     additionalData3 = auxInt2;
+                                     record.value3 = auxInt2;
                                  }
                                  else
                                  {
-                                     additionalData3               = auxInt2 + totalTimeIntTable[ sensorID ];
-                                     totalTimeIntTable[ sensorID ] = additionalData3;
+                                     record.value3                 = auxInt2 + totalTimeIntTable[ sensorID ];
+                                     totalTimeIntTable[ sensorID ] = record.value3;
                                  }
-                                 additionalData4 = words[ counter++ ].toUInt();                                   //  7 - Distance (Fractional Part)
-                                 additionalData5 = words[ counter++ ].toUInt();                                   //  8 - Speed (Integer Part)
-                                 additionalData6 = words[ counter++ ].toUInt();                                   //  9 - Speed (Fractional Part)
+                                 record.value4   = words[ counter++ ].toUInt();                                   //  7 - Distance (Fractional Part)
+                                 record.value5   = words[ counter++ ].toUInt();                                   //  8 - Speed (Integer Part)
+                                 record.value6   = words[ counter++ ].toUInt();                                   //  9 - Speed (Fractional Part)
                                  auxInt3         = words[ counter++ ].toUInt();                                   // 10 - Delta Stride Count
                                  if ( semiCookedOut )
                                  {
-                                     additionalData7 = auxInt3;
+                                     record.value7 = auxInt3;
                                  }
                                  else
                                  {
-                                     additionalData7                   = auxInt3 + totalStrideCountTable[ sensorID ];
-                                     totalStrideCountTable[ sensorID ] = additionalData7;
+                                     record.value7                     = auxInt3 + totalStrideCountTable[ sensorID ];
+                                     totalStrideCountTable[ sensorID ] = record.value7;
                                  }
-                                 additionalData8 = words[ counter++ ].toUInt();                                   // 11 - Latency
+                                 record.value8   = words[ counter++ ].toUInt();                                   // 11 - Latency
                                  if ( diagnostics )
                                  {
                                      appendDiagnosticsLine( "delta time integer part",     auxInt1 );
                                      if ( semiCookedOut )
                                      {
-                                         appendDiagnosticsLine( "total time integer part", additionalData1 );
+                                         appendDiagnosticsLine( "total time integer part", record.value1 );
                                      }
-                                     appendDiagnosticsLine( "time fractional part",        additionalData2 );
+                                     appendDiagnosticsLine( "time fractional part",        record.value2 );
                                      appendDiagnosticsLine( "delta distance integer part", auxInt2 );
                                      if ( semiCookedOut )
                                      {
-                                         appendDiagnosticsLine( "total distance integer part", additionalData3 );
+                                         appendDiagnosticsLine( "total distance integer part", record.value3 );
                                      }
-                                     appendDiagnosticsLine( "distance fractional part",    additionalData4 );
-                                     appendDiagnosticsLine( "delta speed integer part",    additionalData5 );
-                                     appendDiagnosticsLine( "speed fractional part",       additionalData6 );
+                                     appendDiagnosticsLine( "distance fractional part",    record.value4 );
+                                     appendDiagnosticsLine( "delta speed integer part",    record.value5 );
+                                     appendDiagnosticsLine( "speed fractional part",       record.value6 );
                                      appendDiagnosticsLine( "delta stride count",          auxInt3 );
                                      if ( semiCookedOut )
                                      {
-                                         appendDiagnosticsLine( "delta stride count",      additionalData7 );
+                                         appendDiagnosticsLine( "delta stride count",      record.value7 );
                                      }
-                                     appendDiagnosticsLine( "latency",                     additionalData8 );
+                                     appendDiagnosticsLine( "latency",                     record.value8 );
                                  }
                              }
                              break;
@@ -450,26 +428,26 @@ amDeviceType antStrideSpeedDistProcessing::processStrideBasedSpeedAndDistanceSen
                     case  3: if ( ( nbWords > 9 ) || ( ( dataPage == 2 ) && ( nbWords > 8 ) ) )
                              {
                                  result          = STRIDE_BASED_SD_SENSOR;
-                                 additionalData3 = words[ counter++ ].toUInt();                                   //  4 - Cadence (Integer Part)
-                                 additionalData4 = words[ counter++ ].toUInt();                                   //  5 - Cadence (Fractional Part)
-                                 additionalData5 = words[ counter++ ].toUInt();                                   //  6 - Speed (Integer Part)
-                                 additionalData6 = words[ counter++ ].toUInt();                                   //  7 - Speed (Fractional Part)
+                                 record.value3   = words[ counter++ ].toUInt();                                   //  4 - Cadence (Integer Part)
+                                 record.value4   = words[ counter++ ].toUInt();                                   //  5 - Cadence (Fractional Part)
+                                 record.value5   = words[ counter++ ].toUInt();                                   //  6 - Speed (Integer Part)
+                                 record.value6   = words[ counter++ ].toUInt();                                   //  7 - Speed (Fractional Part)
                                  if ( dataPage == 3 )
                                  {
-                                     additionalData7 = words[ counter++ ].toUInt();                               //  8 - Calories
+                                     record.value7 = words[ counter++ ].toUInt();                               //  8 - Calories
                                  }
-                                 additionalData8 = words[ counter++ ].toUInt();                                   // 8/9 - SBSDM Status
+                                 record.value8   = words[ counter++ ].toUInt();                                   // 8/9 - SBSDM Status
                                  if ( diagnostics )
                                  {
-                                     appendDiagnosticsLine( "Cadence integer part",     additionalData3 );
-                                     appendDiagnosticsLine( "Cadence fractional part",  additionalData4 );
-                                     appendDiagnosticsLine( "delta speed integer part", additionalData5 );
-                                     appendDiagnosticsLine( "speed fractional part",    additionalData6 );
+                                     appendDiagnosticsLine( "Cadence integer part",     record.value3 );
+                                     appendDiagnosticsLine( "Cadence fractional part",  record.value4 );
+                                     appendDiagnosticsLine( "delta speed integer part", record.value5 );
+                                     appendDiagnosticsLine( "speed fractional part",    record.value6 );
                                      if ( dataPage == 3 )
                                      {
-                                         appendDiagnosticsLine( "Calories",             additionalData7 );
+                                         appendDiagnosticsLine( "Calories",             record.value7 );
                                      }
-                                     appendDiagnosticsLine( "SMD Status",               additionalData8 );
+                                     appendDiagnosticsLine( "SMD Status",               record.value8 );
                                  }
                              }
                              break;
@@ -477,12 +455,12 @@ amDeviceType antStrideSpeedDistProcessing::processStrideBasedSpeedAndDistanceSen
                     case 16: if ( nbWords > 5 )
                              {
                                  result          = STRIDE_BASED_SD_SENSOR;
-                                 additionalData1 = words[ counter++ ].toUInt();                                   // 4 - Strides
-                                 additionalData2 = words[ counter++ ].toUInt();                                   //  5 - Distance
+                                 record.value1   = words[ counter++ ].toUInt();                                   // 4 - Strides
+                                 record.value2   = words[ counter++ ].toUInt();                                   //  5 - Distance
                                  if ( diagnostics )
                                  {
-                                     appendDiagnosticsLine( "Strides",  additionalData1 );
-                                     appendDiagnosticsLine( "Distance", additionalData2 );
+                                     appendDiagnosticsLine( "Strides",  record.value1 );
+                                     appendDiagnosticsLine( "Distance", record.value2 );
                                  }
                              }
                              break;
@@ -490,10 +468,10 @@ amDeviceType antStrideSpeedDistProcessing::processStrideBasedSpeedAndDistanceSen
                     case 22: if ( nbWords > 4 )
                              {
                                  result          = STRIDE_BASED_SD_SENSOR;
-                                 additionalData1 = words[ counter++ ].toUInt();                                   //  4 - Capabilities
+                                 record.value1   = words[ counter++ ].toUInt();                                   //  4 - Capabilities
                                  if ( diagnostics )
                                  {
-                                     appendDiagnosticsLine( "Capabilities", additionalData1 );
+                                     appendDiagnosticsLine( "Capabilities", record.value1 );
                                  }
                              }
                              break;
@@ -516,10 +494,9 @@ amDeviceType antStrideSpeedDistProcessing::processStrideBasedSpeedAndDistanceSen
                 appendDiagnosticsLine( "Version", curVersion );
             }
         }
-        createOutputHeader( sensorID, timeStampBuffer );
         if ( commonPage )
         {
-            commonPage = processCommonPagesSemiCooked( words, startCounter, outputPageNo );
+            commonPage = processCommonPagesSemiCooked( words, startCounter, curVersion, outputPageNo );
             if ( !commonPage )
             {
                 result = OTHER_DEVICE;
@@ -527,20 +504,9 @@ amDeviceType antStrideSpeedDistProcessing::processStrideBasedSpeedAndDistanceSen
         }
         else
         {
-            createSBSDMResultString
-            (
-                dataPage,
-                additionalData1,
-                additionalData2,
-                additionalData3,
-                additionalData4,
-                additionalData5,
-                additionalData6,
-                additionalData7,
-                additionalData8
-            );
+            record.dataPage = dataPage;
+            outputRecord( antRecordContext( sensorID, timeStampBuffer, curVersion ), record );
         }
-        appendOutputFooter( curVersion );
     }
     else if ( result == UNKNOWN_DEVICE )
     {
@@ -568,7 +534,7 @@ amDeviceType antStrideSpeedDistProcessing::processStrideBasedSpeedAndDistanceSen
 //
 // Parameters:
 //    int             deviceType        IN   Device type
-//    const amString &deviceID          IN   Device ID (number).
+//    unsigned int    deviceID          IN   Device ID (number).
 //    const amString &timeStampBuffer   IN   Time stamp.
 //    BYTE            payLoad[]         IN   Array of bytes with the data to be converted.
 //
@@ -580,7 +546,7 @@ amDeviceType antStrideSpeedDistProcessing::processStrideBasedSpeedAndDistanceSen
 amDeviceType antStrideSpeedDistProcessing::processSensor
 (
     int             deviceType,
-    const amString &deviceIDNo,
+    unsigned int    deviceIDNo,
     const amString &timeStampBuffer,
     BYTE            payLoad[]
 )
@@ -596,7 +562,7 @@ amDeviceType antStrideSpeedDistProcessing::processSensor
         resetOutBuffer();
         if ( outputUnknown )
         {
-            int deviceIDNoAsInt = deviceIDNo.toInt();
+            int deviceIDNoAsInt = ( int ) deviceIDNo;
             createUnknownDeviceTypeString( deviceType, deviceIDNoAsInt, timeStampBuffer, payLoad );
         }
     }
@@ -680,369 +646,3 @@ void antStrideSpeedDistProcessing::reset
     strideCountTable.clear();
 }
 
-void antStrideSpeedDistProcessing::createSBSDMResultString
-(
-    unsigned int dataPage,
-    unsigned int additionalData1,
-    unsigned int additionalData2,
-    unsigned int additionalData3,
-    unsigned int additionalData4,
-    unsigned int additionalData5,
-    unsigned int additionalData6,
-    unsigned int additionalData7,
-    unsigned int additionalData8
-)
-{
-    if ( outputAsJSON )
-    {
-        appendJSONItem( "data page", dataPage );
-    }
-
-    if ( semiCookedOut )
-    {
-        if ( ( dataPage >= 1 ) && ( dataPage <= 15 ) )
-        {
-            if ( outputAsJSON )
-            {
-                appendJSONItem( "delta speed integer part", additionalData5 );
-                appendJSONItem( "speed fractional part",    additionalData6 );
-            }
-            else
-            {
-                appendOutput( dataPage );
-            }
-            if ( dataPage == 1 )
-            {
-                if ( outputAsJSON )
-                {
-                    appendJSONItem( "delta time integer part",     additionalData1 );
-                    appendJSONItem( "time fractional part",        additionalData2 );
-                    appendJSONItem( "delta distance integer part", additionalData3 );
-                    appendJSONItem( "distance fractional part",    additionalData4 );
-                    appendJSONItem( "delta stride count",          additionalData7 );
-                    appendJSONItem( "latency",                     additionalData8 );
-                }
-                else
-                {
-                    appendOutput( additionalData1 );
-                    appendOutput( additionalData2 );
-                    appendOutput( additionalData3 );
-                    appendOutput( additionalData4 );
-                    appendOutput( additionalData5 );
-                    appendOutput( additionalData6 );
-                    appendOutput( additionalData7 );
-                    appendOutput( additionalData8 );
-                }
-            }
-            else
-            {
-                if ( outputAsJSON )
-                {
-                    appendJSONItem( "cadence integer part",    additionalData3 );
-                    appendJSONItem( "cadence fractional part", additionalData4 );
-                    if ( dataPage == 3 )
-                    {
-                        appendJSONItem( "calories", additionalData7 );
-                    }
-                    appendJSONItem( "smd status", additionalData8 );
-                }
-                else
-                {
-                    appendOutput( additionalData3 );
-                    appendOutput( additionalData4 );
-                    appendOutput( additionalData5 );
-                    appendOutput( additionalData6 );
-                    if ( dataPage == 3 )
-                    {
-                        appendOutput( additionalData7 );
-                    }
-                    appendOutput( additionalData8 );
-                }
-            }
-        }
-        else if ( dataPage == 16 )
-        {
-            if ( outputAsJSON )
-            {
-                appendJSONItem( "strides since reset",  additionalData1 );
-                appendJSONItem( "distance since reset", additionalData2 );
-            }
-            else
-            {
-                appendOutput( additionalData1 );
-                appendOutput( additionalData2 );
-            }
-        }
-        else if ( dataPage == 22 )
-        {
-            if ( outputAsJSON )
-            {
-                appendJSONItem( "capabilities",  additionalData1 );
-            }
-            else
-            {
-                appendOutput( additionalData1 );
-            }
-        }
-    }
-    else
-    {
-        if ( !outputAsJSON )
-        {
-            appendOutput( "DATA_PAGE" );
-            appendOutput( dataPage );
-        }
-        if ( ( dataPage >= 1 ) && ( dataPage <= 15 ) )
-        {
-            double speed = ( double ) additionalData5 + ( ( double ) additionalData6 ) / 256.0;
-            if ( outputAsJSON )
-            {
-                if ( ( additionalData5 == 0 ) && ( additionalData6 == 0 ) )
-                {
-                    appendJSONItem( "speed", "off" );
-                }
-                else
-                {
-                    appendJSONItem( "speed", speed, 8 );
-                }
-            }
-            else
-            {
-                appendOutput( "SPEED" );
-                if ( ( additionalData5 == 0 ) && ( additionalData6 == 0 ) )
-                {
-                    appendOutput( "OFF" );
-                }
-                else
-                {
-                    appendOutput( speed, 8 );
-                }
-            }
-
-            if ( dataPage == 1 )
-            {
-                double totalTime     = ( double ) additionalData1 + ( ( double ) additionalData2 ) / 200.0;
-                double totalDistance = ( double ) additionalData3 + ( ( double ) additionalData4 ) /  16.0;
-                double latency       = ( double ) additionalData8 / 32.0;
-
-                if ( outputAsJSON )
-                {
-                    if ( ( additionalData1 == 0 ) && ( additionalData2 == 0 ) )
-                    {
-                        appendJSONItem( "total time", "off" );
-                    }
-                    else
-                    {
-                        appendJSONItem( "total time", totalTime, 3 );
-                    }
-
-                    if ( ( additionalData3 == 0 ) && ( additionalData4 == 0 ) )
-                    {
-                        appendJSONItem( "total distance", "off" );
-                    }
-                    else
-                    {
-                        appendJSONItem( "total distance", totalDistance, 4 );
-                    }
-
-                    if ( additionalData8 == 0 )
-                    {
-                        appendJSONItem( "latency", "off" );
-                    }
-                    else
-                    {
-                        appendJSONItem( "latency", latency, 6 );
-                    }
-                }
-                else
-                {
-                    appendOutput( "TOTAL_TIME" );
-                    if ( ( additionalData1 == 0 ) && ( additionalData2 == 0 ) )
-                    {
-                        appendOutput( "OFF" );
-                    }
-                    else
-                    {
-                        appendOutput( totalTime, 3 );
-                    }
-
-                    appendOutput( "TOTAL_DIST" );
-                    if ( ( additionalData3 == 0 ) && ( additionalData4 == 0 ) )
-                    {
-                        appendOutput( "OFF" );
-                    }
-                    else
-                    {
-                        appendOutput( totalDistance, 4 );
-                    }
-
-                    appendOutput( "LATENCY" );
-                    if ( additionalData8 == 0 )
-                    {
-                        appendOutput( "OFF" );
-                    }
-                    else
-                    {
-                        appendOutput( latency, 6 );
-                    }
-
-                    appendOutput( "TOTAL_STRIDE_COUNT" );
-                    appendOutput( additionalData7 );
-                }
-            }
-            else
-            {
-                double cadence = ( double ) additionalData3 + ( ( double ) additionalData4 ) / 16.0;
-
-                if ( outputAsJSON )
-                {
-                    if ( ( additionalData3 == 0 ) && ( additionalData4 == 0 ) )
-                    {
-                        appendJSONItem( "cadence", "off" );
-                    }
-                    else
-                    {
-                        appendJSONItem( "cadence", cadence, 3 );
-                    }
-                }
-                else
-                {
-                    appendOutput( "CADENCE" );
-                    if ( ( additionalData3 == 0 ) && ( additionalData4 == 0 ) )
-                    {
-                        appendOutput( "OFF" );
-                    }
-                    else
-                    {
-                        appendOutput( cadence, 4 );
-                    }
-                }
-
-                if ( dataPage == 3 )
-                {
-                    if ( outputAsJSON )
-                    {
-                        if ( additionalData7 == 0 )
-                        {
-                            appendJSONItem( "calories", "off" );
-                        }
-                        else
-                        {
-                            appendJSONItem( "calories", additionalData7 );
-                        }
-                    }
-                    else
-                    {
-                        appendOutput( "CALORIES" );
-                        if ( ( additionalData1 == 0 ) && ( additionalData2 == 0 ) )
-                        {
-                            appendOutput( "OFF" );
-                        }
-                        else
-                        {
-                            appendOutput( additionalData7 );
-                        }
-                    }
-                }
-
-                if ( outputAsJSON )
-                {
-                    appendJSONItem( "smd location", ( ( additionalData8 & 0x03 ) == 0 ) ? "laces"   : (
-                                                    ( ( additionalData8 & 0x03 ) == 1 ) ? "midsole" : (
-                                                    ( ( additionalData8 & 0x03 ) == 2 ) ? "other"   : "ankle" ) ) );
-                }
-                else
-                {
-                    appendOutput( "DEVICE_LOCATION" );
-                    appendOutput( ( ( additionalData8 & 0x03 ) == 0 ) ? "LACES"   : (
-                                  ( ( additionalData8 & 0x03 ) == 1 ) ? "MIDSOLE" : (
-                                  ( ( additionalData8 & 0x03 ) == 2 ) ? "OTHER"   : "ANKLE" ) ) );
-                }
-
-                if ( outputAsJSON )
-                {
-                    appendJSONItem( "battery status", ( ( additionalData8 & 0x0C ) == 0 ) ? "new"  : (
-                                                      ( ( additionalData8 & 0x0C ) == 1 ) ? "good" : (
-                                                      ( ( additionalData8 & 0x0C ) == 2 ) ? "ok"   : "low" ) ) );
-                }
-                else
-                {
-                    appendOutput( "BATTERY_STATUS" );
-                    appendOutput( ( ( additionalData8 & 0x0C ) == 0 ) ? "NEW"  : (
-                                  ( ( additionalData8 & 0x0C ) == 1 ) ? "GOOD" : (
-                                  ( ( additionalData8 & 0x0C ) == 2 ) ? "OK"   : "LOW" ) ) );
-                }
-
-                switch ( additionalData8 & 0x30 )
-                if ( outputAsJSON )
-                {
-                    appendJSONItem( "smd health", ( ( additionalData8 & 0x30 ) == 0 ) ? "ok"      : (
-                                                  ( ( additionalData8 & 0x30 ) == 1 ) ? "error"   : (
-                                                  ( ( additionalData8 & 0x30 ) == 2 ) ? "warning" : "reserved" ) ) );
-                }
-                else
-                {
-                    appendOutput( "DEVICE_HEALTH" );
-                    appendOutput( ( ( additionalData8 & 0x30 ) == 0 ) ? "OK"      : (
-                                  ( ( additionalData8 & 0x30 ) == 1 ) ? "ERROR"   : (
-                                  ( ( additionalData8 & 0x30 ) == 2 ) ? "WARNING" : "RESERVED" ) ) );
-                }
-
-                switch ( additionalData8 & 0xC0 )
-                if ( outputAsJSON )
-                {
-                    appendJSONItem( "use state", ( ( additionalData8 & 0xC0 ) == 0 ) ? "inactive" : (
-                                                 ( ( additionalData8 & 0xC0 ) == 1 ) ? "active"   : "reserved" ) );
-                }
-                else
-                {
-                    appendOutput( "USE_STATE" );
-                    appendOutput( ( ( additionalData8 & 0xC0 ) == 0 ) ? "INACTIVE" : (
-                                  ( ( additionalData8 & 0xC0 ) == 1 ) ? "ACTIVE"   : "RESERVED" ) );
-                }
-            }
-        }
-        else if ( dataPage == 16 )
-        {
-            double totalDistance = ( double ) additionalData2 / 256.0;
-            if ( outputAsJSON )
-            {
-                appendJSONItem( "strides since reset",  additionalData1 );
-                appendJSONItem( "distance since reset", totalDistance, 8 );
-            }
-            else
-            {
-                appendOutput( additionalData1 );
-                appendOutput( totalDistance, 8 );
-            }
-        }
-        else if ( dataPage == 22 )
-        {
-            if ( outputAsJSON )
-            {
-                appendJSONItem( "time",     ( additionalData1 &  1 ) ? "valid" : "invalid" );
-                appendJSONItem( "distance", ( additionalData1 &  2 ) ? "valid" : "invalid" );
-                appendJSONItem( "speed",    ( additionalData1 &  4 ) ? "valid" : "invalid" );
-                appendJSONItem( "latency",  ( additionalData1 &  8 ) ? "valid" : "invalid" );
-                appendJSONItem( "cadence",  ( additionalData1 & 16 ) ? "valid" : "invalid" );
-                appendJSONItem( "calories", ( additionalData1 & 32 ) ? "valid" : "invalid" );
-            }
-            else
-            {
-                appendOutput( "TIME" );
-                appendOutput( ( additionalData1 &  1 ) ? "VALID" : "INVALID" );
-                appendOutput( "DIST" );
-                appendOutput( ( additionalData1 &  2 ) ? "VALID" : "INVALID" );
-                appendOutput( "SPEED" );
-                appendOutput( ( additionalData1 &  4 ) ? "VALID" : "INVALID" );
-                appendOutput( "LATENCY" );
-                appendOutput( ( additionalData1 &  8 ) ? "VALID" : "INVALID" );
-                appendOutput( "CADENCE" );
-                appendOutput( ( additionalData1 & 16 ) ? "VALID" : "INVALID" );
-                appendOutput( "CALORIES" );
-                appendOutput( ( additionalData1 & 32 ) ? "VALID" : "INVALID" );
-            }
-        }
-    }
-}
-
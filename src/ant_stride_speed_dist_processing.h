@@ -7,27 +7,14 @@ class antStrideSpeedDistProcessing : virtual public antProcessing
 {
     protected:
 
-        std::map<amString, double>       totalDistTable;
-        std::map<amString, unsigned int> eventDistTable;
-        std::map<amString, unsigned int> totalStrideCountTable;
-        std::map<amString, unsigned int> strideCountTable;
+        antSensorField<double>       totalDistTable;
+        antSensorField<unsigned int> eventDistTable;
+        antSensorField<unsigned int> totalStrideCountTable;
+        antSensorField<unsigned int> strideCountTable;
 
-        amDeviceType processStrideBasedSpeedAndDistanceSensor( const amString &deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
+        amDeviceType processStrideBasedSpeedAndDistanceSensor( unsigned int deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
         amDeviceType processStrideBasedSpeedAndDistanceSensorSemiCooked( const amString &inputBuffer );
 
-        void createSBSDMResultString
-             (
-                 unsigned int dataPage,
-                 unsigned int additionalData1,
-                 unsigned int additionalData2,
-                 unsigned int additionalData3,
-                 unsigned int additionalData4,
-                 unsigned int additionalData5,
-                 unsigned int additionalData6,
-                 unsigned int additionalData7,
-                 unsigned int additionalData8
-             );
-
         virtual void readDeviceFileLine( const char *line );
 
         bool appendStrideSpeedDistSensor( const amString & );
@@ -40,10 +27,11 @@ class antStrideSpeedDistProcessing : virtual public antProcessing
 
         bool isStrideSpeedSensor( const amString & );
 
-        virtual amDeviceType processSensor( int deviceType, const amString &deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
+        virtual amDeviceType processSensor( int deviceType, unsigned int deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
         virtual amDeviceType processSensorSemiCooked( const amString &inputBuffer );
 
         virtual void reset( void );
+        virtual antProcessing *createWorker( void ) const { return new antStrideSpeedDistProcessing; }
 };
 
 #endif // __ANT_STRIDE_SPEED_DIST__PROCESSING_H__
@@ -6,18 +6,9 @@
 class antWeightProcessing : virtual public antProcessing
 {
 
-    private:
-
-        void getWeightScaleCapabilities( int capabilities );
-
-
     protected:
 
-        std::map<amString, unsigned int> previousHeartRateTable;
-        std::map<amString, unsigned int> eventTimeTable;
-        std::map<amString, double>       heartBeatTimeTable;
-
-        amDeviceType processWeightScaleSensor( const amString &deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
+        amDeviceType processWeightScaleSensor( unsigned int deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
         amDeviceType processWeightScaleSensorSemiCooked( const amString &inputBuffer );
 
         virtual void readDeviceFileLine( const char *line );
@@ -32,21 +23,11 @@ class antWeightProcessing : virtual public antProcessing
 
         bool isWeightScaleSensor( const amString & );
 
-        virtual amDeviceType processSensor( int deviceType, const amString &deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
+        virtual amDeviceType processSensor( int deviceType, unsigned int deviceIDNo, const amString &timeStampBuffer, BYTE payLoad[] );
         virtual amDeviceType processSensorSemiCooked( const amString &inputBuffer );
 
-        void createWeightScaleString
-             (
-                 unsigned int dataPage,
-                 unsigned int additionalData1,
-                 unsigned int additionalData2,
-                 unsigned int additionalData3,
-                 unsigned int additionalData4,
-                 unsigned int additionalData5,
-                 unsigned int additionalData6
-             );
-
         virtual void reset( void );
+        virtual antProcessing *createWorker( void ) const { return new antWeightProcessing; }
 
 };
 
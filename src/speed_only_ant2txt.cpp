@@ -2,7 +2,7 @@
 
 const char C_PROGRAM_NAME[]  = "speed_only_ant2txt";
 const char C_DEVICE_NAME[]   = "SPB7";
-const char C_OPTION_STRING[] = "12BDd:f:HhI:Jl:M:m:P:p:RrsST:t:UvVwx";
+const char C_OPTION_STRING[] = "12a:A:b:Bc:C:Dd:Eef:G:HhI:iJj:k:K:l:L:M:m:n:o:P:p:Q:RrsST:t:UvVwWxY:z:";
 
 int main
 (
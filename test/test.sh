@@ -18,6 +18,12 @@ DEVICE_FILE_ARG=
 DEVICE_FILE="${DATA_DIRECTORY}/deviceIDs"
 PARAMETERS=""
 HAS_PARAMETERS=
+TEST_FILES=0
+SPLIT_END=1000
+SPLIT_START=1000.1
+RANGE_START=500
+RANGE_END=1500
+SELECT_ID=32897
 
 ${DELETE} "${DATA_DIRECTORY}/*.txt.tmp" "${DATA_DIRECTORY}/*.txt.diff" 2>/dev/null
 
@@ -26,6 +32,10 @@ do
 	case $1 in  
 		-A | A)
 			TEST_ALL=1
+			TEST_FILES=1
+			;;
+		-B | B)
+			TEST_FILES=1
 			;;
 		-d | d)
 			DEVICE_FILE_ARG=" -d ${DEVICE_FILE}"
@@ -36,9 +46,13 @@ do
 			;;
 		-h | h)
 			echo "Usage"
-			echo "    $0 [-D <device_type>] [-h] [-S]"
+			echo "    $0 [-A] [-B] [-D <device_type>] [-h] [-S]"
 			echo "where"
-			echo "    -A              : Test all cominations."
+			echo "    -A              : Test all cominations (includes -B)."
+			echo "    -B              : Run the tests of the capture file (options -C and -i), of the state"
+			echo "                      file (option -k) and of the binary format (options -E and -e): the"
+			echo "                      output read back or split in two runs must be the output of the"
+			echo "                      uninterrupted run."
 			echo "    -D <device_type>: Run test for device <device_type>."
 			echo "                      Supported device types:"
 			echo "                           ALL       : All Sensors."
@@ -243,3 +257,138 @@ if [ "${RUN}" = "1" ]; then
 	done
 fi
 
+# Tests of the capture file, the state file and the binary format. The reference is the output of the
+# uninterrupted run of the same executable: reading the capture or the binary output back, selecting
+# sensors or times from the capture, and splitting the run in two (the second run continuing from the
+# state file of the first) must not change a byte.
+# Only a time range which does not start at the beginning has a golden file of its own.
+checkFileTest()
+{
+	TEST_NAME=$1
+	EXPECTED_FILE=$2
+	OUTPUT_FILE_TMP=$3
+	OUTPUT_FILE_DIFF="${OUTPUT_FILE_TMP%.tmp}.diff"
+
+	${DIFF} "${EXPECTED_FILE}" "${OUTPUT_FILE_TMP}" > "${OUTPUT_FILE_DIFF}"
+	if [ "$?" = "0" ]; then
+		RESULT="OK"
+		${DELETE} "${OUTPUT_FILE_TMP}"
+		${DELETE} "${OUTPUT_FILE_DIFF}"
+	else
+		RESULT="Fail. See files \"${EXPECTED_FILE}\" \"${OUTPUT_FILE_TMP}\" \"${OUTPUT_FILE_DIFF}\""
+	fi
+	echo "Test ${TEST_NAME} ${DEVICE} Result: ${RESULT}"
+}
+
+if [ "${RUN}" = "1" ] && [ "${TEST_FILES}" = "1" ]; then
+
+	FILE_ROOT="${DATA_DIRECTORY}/${OUTPUT_FILE_ROOT}"
+	CAPTURE_FILE="${FILE_ROOT}Capture.antc.tmp"
+	STATE_FILE="${FILE_ROOT}State.tmp"
+	SEMI_FILE="${DATA_DIRECTORY}/${OUTPUT_FILE_ROOT}Semi.txt"
+
+	for JSON_ARG in "" " -J"; do
+		if [ "${JSON_ARG}" = "" ]; then
+			JSON=""
+		else
+			JSON="JSON"
+		fi
+		FULL_OUTPUT="${FILE_ROOT}Uninterrupted${JSON}.txt.tmp"
+
+		# - - - - - - - - - - - - - - - -
+		# Capture file
+		${DELETE} "${CAPTURE_FILE}" 2>/dev/null
+		bin/${EXECUTABLE}${JSON_ARG} -x -f "${DATA_DIRECTORY}/${ANT_FILE}" -C "${CAPTURE_FILE}" > "${FULL_OUTPUT}" 2>/dev/null
+
+		bin/${EXECUTABLE}${JSON_ARG} -x -i -f "${CAPTURE_FILE}" > "${FILE_ROOT}CaptureRead${JSON}.tmp" 2>/dev/null
+		checkFileTest "Capture-Read${JSON:+-}${JSON}" "${FULL_OUTPUT}" "${FILE_ROOT}CaptureRead${JSON}.tmp"
+
+		if [ "${JSON}" = "" ]; then
+			awk -F'\t' -v id="${SELECT_ID}" '$1 ~ ( "_" id "$" )' "${FULL_OUTPUT}" > "${FILE_ROOT}Selected.txt.tmp"
+			bin/${EXECUTABLE} -x -i -n ${SELECT_ID} -f "${CAPTURE_FILE}" > "${FILE_ROOT}CaptureSelect.tmp" 2>/dev/null
+			checkFileTest "Capture-Select" "${FILE_ROOT}Selected.txt.tmp" "${FILE_ROOT}CaptureSelect.tmp"
+
+			awk -F'\t' -v end="${SPLIT_END}" '$2 <= end' "${FULL_OUTPUT}" > "${FILE_ROOT}Until.txt.tmp"
+			bin/${EXECUTABLE} -x -i -z ${SPLIT_END} -f "${CAPTURE_FILE}" > "${FILE_ROOT}CaptureUntil.tmp" 2>/dev/null
+			checkFileTest "Capture-Until" "${FILE_ROOT}Until.txt.tmp" "${FILE_ROOT}CaptureUntil.tmp"
+
+			# A time range starts without the state of the packets before it: compared to a golden file.
+			if [ -f "${FILE_ROOT}CaptureRange.txt" ]; then
+				bin/${EXECUTABLE} -x -i -n ${SELECT_ID} -a ${RANGE_START} -z ${RANGE_END} -f "${CAPTURE_FILE}" > "${FILE_ROOT}CaptureRange.tmp" 2>/dev/null
+				checkFileTest "Capture-Range" "${FILE_ROOT}CaptureRange.txt" "${FILE_ROOT}CaptureRange.tmp"
+			fi
+		fi
+
+		# - - - - - - - - - - - - - - - -
+		# State file: the capture read up to SPLIT_END, then from SPLIT_START on
+		for THREADS in "" "4 3"; do
+			if [ "${THREADS}" = "" ]; then
+				THREAD_ARGS_1=
+				THREAD_ARGS_2=
+				THREAD_NAME=
+			else
+				set -- ${THREADS}
+				THREAD_ARGS_1=" -j $1"
+				THREAD_ARGS_2=" -j $2"
+				THREAD_NAME="-Threads"
+			fi
+
+			${DELETE} "${STATE_FILE}" 2>/dev/null
+			bin/${EXECUTABLE}${JSON_ARG}${THREAD_ARGS_1} -x -i -z ${SPLIT_END} -k "${STATE_FILE}" -f "${CAPTURE_FILE}" > "${FILE_ROOT}StateSplit${JSON}.tmp" 2>/dev/null
+			bin/${EXECUTABLE}${JSON_ARG}${THREAD_ARGS_2} -x -i -a ${SPLIT_START} -k "${STATE_FILE}" -f "${CAPTURE_FILE}" >> "${FILE_ROOT}StateSplit${JSON}.tmp" 2>/dev/null
+			checkFileTest "State-Split${THREAD_NAME}${JSON:+-}${JSON}" "${FULL_OUTPUT}" "${FILE_ROOT}StateSplit${JSON}.tmp"
+
+			if [ "${JSON}" = "" ]; then
+				${DELETE} "${STATE_FILE}" 2>/dev/null
+				bin/${EXECUTABLE}${THREAD_ARGS_1} -x -i -n ${SELECT_ID} -z ${SPLIT_END} -k "${STATE_FILE}" -f "${CAPTURE_FILE}" > "${FILE_ROOT}StateSplitSelect.tmp" 2>/dev/null
+				bin/${EXECUTABLE}${THREAD_ARGS_2} -x -i -n ${SELECT_ID} -a ${SPLIT_START} -k "${STATE_FILE}" -f "${CAPTURE_FILE}" >> "${FILE_ROOT}StateSplitSelect.tmp" 2>/dev/null
+				checkFileTest "State-Split-Select${THREAD_NAME}" "${FILE_ROOT}Selected.txt.tmp" "${FILE_ROOT}StateSplitSelect.tmp"
+			fi
+
+			# Semi-cooked input split in two halves of lines
+			if [ -f "${SEMI_FILE}" ]; then
+				NB_LINES=`wc -l < "${SEMI_FILE}"`
+				let NB_LINES=NB_LINES/2
+				head -n ${NB_LINES} "${SEMI_FILE}" > "${FILE_ROOT}SemiFirst.txt.tmp"
+				tail -n +$((NB_LINES+1)) "${SEMI_FILE}" > "${FILE_ROOT}SemiSecond.txt.tmp"
+				bin/${EXECUTABLE}${JSON_ARG} -x -s -f "${SEMI_FILE}" > "${FILE_ROOT}SemiUninterrupted.txt.tmp" 2>/dev/null
+
+				${DELETE} "${STATE_FILE}" 2>/dev/null
+				bin/${EXECUTABLE}${JSON_ARG}${THREAD_ARGS_1} -x -s -k "${STATE_FILE}" -f "${FILE_ROOT}SemiFirst.txt.tmp" > "${FILE_ROOT}StateSplitSemi${JSON}.tmp" 2>/dev/null
+				bin/${EXECUTABLE}${JSON_ARG}${THREAD_ARGS_2} -x -s -k "${STATE_FILE}" -f "${FILE_ROOT}SemiSecond.txt.tmp" >> "${FILE_ROOT}StateSplitSemi${JSON}.tmp" 2>/dev/null
+				checkFileTest "State-Split-Semi-In${THREAD_NAME}${JSON:+-}${JSON}" "${FILE_ROOT}SemiUninterrupted.txt.tmp" "${FILE_ROOT}StateSplitSemi${JSON}.tmp"
+				${DELETE} "${FILE_ROOT}SemiFirst.txt.tmp" "${FILE_ROOT}SemiSecond.txt.tmp" "${FILE_ROOT}SemiUninterrupted.txt.tmp"
+			fi
+		done
+
+		# - - - - - - - - - - - - - - - -
+		# Binary format: written with -E and read back with -e, in the same output format
+		for SEMI_ARG in "" " -S"; do
+			if [ "${SEMI_ARG}" = "" ]; then
+				SEMI_NAME=
+			else
+				SEMI_NAME="-Semi-Out"
+			fi
+			bin/${EXECUTABLE}${JSON_ARG}${SEMI_ARG} -x -f "${DATA_DIRECTORY}/${ANT_FILE}" > "${FILE_ROOT}BinaryExpected.txt.tmp" 2>/dev/null
+			bin/${EXECUTABLE}${JSON_ARG}${SEMI_ARG} -x -E -f "${DATA_DIRECTORY}/${ANT_FILE}" 2>/dev/null | bin/${EXECUTABLE}${JSON_ARG}${SEMI_ARG} -x -e -1 > "${FILE_ROOT}Binary${JSON}.tmp" 2>/dev/null
+			checkFileTest "Binary${SEMI_NAME}${JSON:+-}${JSON}" "${FILE_ROOT}BinaryExpected.txt.tmp" "${FILE_ROOT}Binary${JSON}.tmp"
+			${DELETE} "${FILE_ROOT}BinaryExpected.txt.tmp"
+		done
+
+		# Read in the other output format (text blocks of JSON objects read as text, or the reverse): refused
+		if [ "${JSON}" = "" ]; then
+			OTHER_JSON_ARG=" -J"
+		else
+			OTHER_JSON_ARG=
+		fi
+		bin/${EXECUTABLE}${JSON_ARG} -x -E -f "${DATA_DIRECTORY}/${ANT_FILE}" 2>/dev/null | bin/${EXECUTABLE}${OTHER_JSON_ARG} -x -e -1 > "${FILE_ROOT}BinaryRefused${JSON}.tmp" 2>/dev/null
+		if [ "${PIPESTATUS[1]}" = "0" ]; then
+			echo "exited without error" >> "${FILE_ROOT}BinaryRefused${JSON}.tmp"
+		fi
+		checkFileTest "Binary-Refused${JSON:+-}${JSON}" /dev/null "${FILE_ROOT}BinaryRefused${JSON}.tmp"
+
+		${DELETE} "${FULL_OUTPUT}" "${FILE_ROOT}Selected.txt.tmp" "${FILE_ROOT}Until.txt.tmp" 2>/dev/null
+	done
+
+	${DELETE} "${CAPTURE_FILE}" "${STATE_FILE}" 2>/dev/null
+fi